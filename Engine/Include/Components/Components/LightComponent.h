@@ -38,7 +38,7 @@ public:
 
 	struct
 	{
-		//The radius.
+		//The radius. Point lights reach at least this far, and further if their intensity makes them visible beyond it.
 		float32 _Radius{ 1.0f };
 
 		//The size.
@@ -72,7 +72,7 @@ public:
 
 	struct
 	{
-		//The radius.
+		//The radius. Point lights reach at least this far, and further if their intensity makes them visible beyond it.
 		float32 _Radius{ 1.0f };
 
 		//The size.
@@ -2,6 +2,7 @@
 
 //Core.
 #include <Core/Essential/CatalystEssential.h>
+#include <Core/Containers/StaticArray.h>
 #include <Core/General/Enumeration.h>
 #include <Core/General/Padding.h>
 
@@ -22,27 +23,105 @@ CATALYST_ENUMERATION
 );
 
 /*
-*	Particle instance class definition.
+*	Particle instances class definition.
+*	Stores the particles of one sub emitter as a structure of arrays, one stream per attribute, so they can be simulated eight at a time.
+*	The streams always have room for one more SIMD iteration past the padded size, so kernels can read and write whole iterations without checking.
 */
-class ParticleInstance final
+class ParticleInstances final
 {
 
 public:
 
-	//The world position.
-	WorldPosition _WorldPosition;
+	//Enumeration covering all streams.
+	enum class Stream : uint8
+	{
+		POSITION_X,
+		POSITION_Y,
+		POSITION_Z,
+		VELOCITY_X,
+		VELOCITY_Y,
+		VELOCITY_Z,
+		SIZE_X,
+		SIZE_Y,
+		AGE,
+		LIFETIME,
+
+		NUMBER_OF_STREAMS
+	};
 
-	//The velocity.
-	Vector3<float32> _Velocity;
+	//The number of particles processed in each SIMD iteration.
+	constexpr static uint32 STRIDE{ 8 };
 
-	//The size.
-	Vector2<float32> _Size;
+	//The cell that all positions are relative to.
+	Vector3<int32> _Cell{ 0, 0, 0 };
+
+	/*
+	*	Returns the number of particles.
+	*/
+	FORCE_INLINE NO_DISCARD uint32 Size() const NOEXCEPT
+	{
+		return _Size;
+	}
+
+	/*
+	*	Returns the padded number of particles, rounded up to a whole number of SIMD iterations.
+	*/
+	FORCE_INLINE NO_DISCARD uint32 PaddedSize() const NOEXCEPT
+	{
+		return (_Size + STRIDE - 1) & ~(STRIDE - 1);
+	}
+
+	/*
+	*	Returns the given stream.
+	*/
+	FORCE_INLINE NO_DISCARD float32 *const RESTRICT Get(const Stream stream) NOEXCEPT
+	{
+		return _Streams[UNDERLYING(stream)].Data();
+	}
+
+	/*
+	*	Resizes all streams. Capacity grows geometrically, so spawning a few particles each frame doesn't reallocate each frame.
+	*/
+	FORCE_INLINE void Resize(const uint32 new_size) NOEXCEPT
+	{
+		const uint64 required_capacity{ ((static_cast<uint64>(new_size) + STRIDE - 1) & ~static_cast<uint64>(STRIDE - 1)) + STRIDE };
+
+		if (required_capacity > _Streams[0].Capacity())
+		{
+			const uint64 new_capacity{ BaseMath::Maximum<uint64>(required_capacity, _Streams[0].Capacity() * 2) };
+
+			for (DynamicArray<float32> &stream : _Streams)
+			{
+				stream.Reserve(new_capacity);
+			}
+		}
+
+		for (DynamicArray<float32> &stream : _Streams)
+		{
+			stream.Resize<false>(new_size);
+		}
+
+		_Size = new_size;
+	}
+
+	/*
+	*	Copies the particle at the source index over the particle at the destination index.
+	*/
+	FORCE_INLINE void Copy(const uint32 destination_index, const uint32 source_index) NOEXCEPT
+	{
+		for (DynamicArray<float32> &stream : _Streams)
+		{
+			stream[destination_index] = stream[source_index];
+		}
+	}
+
+private:
 
-	//The age.
-	float32 _Age;
+	//The streams.
+	StaticArray<DynamicArray<float32>, UNDERLYING(Stream::NUMBER_OF_STREAMS)> _Streams;
 
-	//The lifetime.
-	float32 _Lifetime;
+	//The number of particles.
+	uint32 _Size{ 0 };
 
 };
 
@@ -153,11 +232,17 @@ public:
 	float32 _TimeSinceLastParticleSpawn;
 
 	//The instances.
-	DynamicArray<ParticleInstance> _Instances;
+	ParticleInstances _Instances;
 
-	//The packed instancs.
+	//The packed instances, for the particles that survived this update and passed culling.
 	DynamicArray<ParticlePackedInstance> _PackedInstances;
 
+	//The seed for the counter-based random number generator used when spawning.
+	uint32 _RandomSeed;
+
+	//The counter for the counter-based random number generator, advanced by the number of particles spawned.
+	uint32 _RandomCounter;
+
 	//Denotes if the initial burst has been done.
 	bool _HasDoneInitialBurst;
 
@@ -171,8 +256,11 @@ class ParticleSystemSharedData final
 
 public:
 
-	//The packed instancs.
-	DynamicArray<ParticlePackedInstance> _PackedInstances;
+	/*
+	*	The total number of packed instances across all sub emitters.
+	*	The packed instances themselves stay with the sub emitters, and are written straight into the mapped storage buffer.
+	*/
+	uint64 _NumberOfPackedInstances{ 0 };
 
 };
 
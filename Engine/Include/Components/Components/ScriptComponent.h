@@ -2,6 +2,7 @@
 
 //Core.
 #include <Core/Essential/CatalystEssential.h>
+#include <Core/Containers/DynamicArray.h>
 
 //Components.
 #include <Components/Core/Component.h>
@@ -27,8 +28,8 @@ public:
 	//The script identifier.
 	ScriptIdentifier _ScriptIdentifier;
 
-	//The data.
-	void *RESTRICT _Data;
+	//The index of this instance in the script block of it's script identifier.
+	uint64 _BlockIndex;
 
 };
 
@@ -62,4 +63,71 @@ public:
 	*/
 	void Event(Entity *const RESTRICT entity, const HashString event) NOEXCEPT;
 
+private:
+
+	/*
+	*	Script block class definition.
+	*	Holds all instances of one script identifier contiguously, so that they can be updated in batches.
+	*/
+	class ScriptBlock final
+	{
+
+	public:
+
+		//The entities.
+		DynamicArray<Entity *RESTRICT> _Entities;
+
+		//The data. Each instance has the required data size of the script identifier, laid out back to back.
+		DynamicArray<byte> _Data;
+
+	};
+
+	/*
+	*	Script update batch class definition.
+	*/
+	class ScriptUpdateBatch final
+	{
+
+	public:
+
+		//The script identifier.
+		ScriptIdentifier _ScriptIdentifier;
+
+		//The script block.
+		ScriptBlock *RESTRICT _ScriptBlock;
+
+		//The start index.
+		uint64 _StartIndex;
+
+		//The end index.
+		uint64 _EndIndex;
+
+	};
+
+	//The script blocks, indexed by script identifier.
+	DynamicArray<ScriptBlock> _ScriptBlocks;
+
+	//The update batches.
+	DynamicArray<ScriptUpdateBatch> _UpdateBatches;
+
+	/*
+	*	Returns the data for the given instance.
+	*/
+	NO_DISCARD void *const RESTRICT Data(const ScriptInstanceData &instance_data) NOEXCEPT;
+
+	/*
+	*	Adds the given instance to the script block of it's script identifier, with zeroed data.
+	*/
+	void AddToScriptBlock(Entity *const RESTRICT entity, ScriptInstanceData *const RESTRICT instance_data) NOEXCEPT;
+
+	/*
+	*	Removes the given instance from the script block of it's script identifier.
+	*/
+	void RemoveFromScriptBlock(ScriptInstanceData *const RESTRICT instance_data) NOEXCEPT;
+
+	/*
+	*	Updates all instances in the given update wave.
+	*/
+	void UpdateWave(const uint32 update_wave) NOEXCEPT;
+
 };
\ No newline at end of file
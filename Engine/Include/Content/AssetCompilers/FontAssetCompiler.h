@@ -3,10 +3,16 @@
 //Core.
 #include <Core/Essential/CatalystEssential.h>
 
+//Concurrency.
+#include <Concurrency/Spinlock.h>
+
 //Content.
 #include <Content/Core/AssetCompiler.h>
 #include <Content/Assets/FontAsset.h>
 
+//Rendering.
+#include <Rendering/Native/GlyphCache.h>
+
 //Systems.
 #include <Systems/System.h>
 
@@ -18,7 +24,8 @@ public:
 	//System declaration.
 	CATALYST_SYSTEM
 	(
-		FontAssetCompiler
+		FontAssetCompiler,
+		SYSTEM_TERMINATE()
 	);
 
 	/*
@@ -59,4 +66,13 @@ private:
 	//The asset allocator.
 	PoolAllocator<sizeof(FontAsset)> _AssetAllocator;
 
+	//The lock for the glyph caches, as fonts are loaded on multiple threads at once.
+	Spinlock _GlyphCachesLock;
+
+	//The glyph cache allocator.
+	PoolAllocator<sizeof(GlyphCache)> _GlyphCacheAllocator;
+
+	//The glyph caches that have been created for fonts, destroyed on termination.
+	DynamicArray<GlyphCache *RESTRICT> _GlyphCaches;
+
 };
\ No newline at end of file
@@ -109,9 +109,9 @@ private:
 	void SplitShaderStages(const DynamicArray<DynamicString> &lines, DynamicArray<class ShaderStageLines> *const RESTRICT shader_stages) NOEXCEPT;
 
 	/*
-	*	Compiles GLSL shaders.
+	*	Compiles GLSL shaders. Returns if all shader stages compiled successfully.
 	*/
-	void CompileGLSLShaders
+	NO_DISCARD bool CompileGLSLShaders
 	(
 		const CompileContext &compile_context,
 		class ExtraData *const RESTRICT extra_data,
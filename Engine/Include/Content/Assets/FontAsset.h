@@ -2,6 +2,8 @@
 
 //Core.
 #include <Core/Essential/CatalystEssential.h>
+#include <Core/Containers/DynamicArray.h>
+#include <Core/Containers/StaticArray.h>
 
 //Content.
 #include <Content/Core/Asset.h>
@@ -10,6 +12,9 @@
 #include <Math/General/Vector.h>
 #include <Math/Geometry/AxisAlignedBoundingBox2D.h>
 
+//Forward declarations.
+class GlyphCache;
+
 class FontAsset final : public Asset
 {
 
@@ -19,7 +24,9 @@ public:
 	static HashString TYPE_IDENTIFIER;
 
 	//Constants.
-	constexpr static uint8 NUMBER_OF_CHARACTER_DESCRIPTIONS{ 127 };
+	constexpr static uint32 NUMBER_OF_ASCII_CHARACTERS{ 128 };
+	constexpr static uint32 INVALID_INDEX{ UINT32_MAXIMUM };
+	constexpr static uint32 PAGE_RESOLUTION{ 2'048 };
 
 	/*
 	*	Character description definition.
@@ -41,15 +48,125 @@ public:
 		//The advance.
 		float32 _Advance;
 
+		//The index of the page that this character is on.
+		uint32 _PageIndex;
+
 	};
 
-	//Container for all character descriptions.
-	StaticArray<CharacterDescription, NUMBER_OF_CHARACTER_DESCRIPTIONS> _CharacterDescriptions;
+	/*
+	*	Kerning pair class definition.
+	*/
+	class KerningPair final
+	{
+
+	public:
+
+		//The key, with the first codepoint in the upper 32 bits and the second codepoint in the lower 32 bits.
+		uint64 _Key;
+
+		//The adjustment to the advance of the first character.
+		float32 _Adjustment;
+
+	};
 
-	//The master texture index.
-	uint32 _MasterTextureIndex;
+	//The codepoints of all compiled characters, sorted.
+	DynamicArray<uint32> _Codepoints;
+
+	//Container for all compiled character descriptions, in the same order as the codepoints.
+	DynamicArray<CharacterDescription> _CharacterDescriptions;
+
+	//The character description indices of all ASCII characters, for fast lookups of the most common characters.
+	StaticArray<uint32, NUMBER_OF_ASCII_CHARACTERS> _ASCIIIndices;
+
+	//The kerning pairs, sorted by key.
+	DynamicArray<KerningPair> _KerningPairs;
+
+	//The texture indices of all pages. Compiled pages come first, followed by the pages owned by the glyph cache.
+	DynamicArray<uint32> _PageTextureIndices;
 
 	//The default height.
 	float32 _DefaultHeight;
 
+	//The pixel height that characters are rasterized at.
+	uint32 _PixelHeight;
+
+	//The padding around characters, in pixels, that the signed distance field spreads out over.
+	uint32 _Padding;
+
+	//The font data. Only kept around if the font has a glyph cache.
+	DynamicArray<byte> _FontData;
+
+	//The glyph cache, which rasterizes characters that were not compiled on demand. Only set if the font was compiled with dynamic glyphs.
+	GlyphCache *RESTRICT _GlyphCache{ nullptr };
+
+	/*
+	*	Returns the scale from pixel distances to signed distance field values for the given padding.
+	*	The signed distance field spreads out over the padding minus two pixels, which is kept at least one pixel so paddings of two or less don't divide by zero or wrap around.
+	*/
+	FORCE_INLINE static NO_DISCARD float32 SignedDistanceFieldPixelDistanceScale(const uint32 padding) NOEXCEPT
+	{
+		return 127.0f / static_cast<float32>(padding > 2 ? padding - 2 : 1);
+	}
+
+	/*
+	*	Returns the compiled character description for the given codepoint, or nullptr if it was not compiled.
+	*/
+	FORCE_INLINE RESTRICTED NO_DISCARD const CharacterDescription *const RESTRICT FindCharacterDescription(const uint32 codepoint) const NOEXCEPT
+	{
+		if (codepoint < NUMBER_OF_ASCII_CHARACTERS)
+		{
+			const uint32 index{ _ASCIIIndices[codepoint] };
+
+			return index != INVALID_INDEX ? &_CharacterDescriptions[index] : nullptr;
+		}
+
+		uint64 first{ 0 };
+		uint64 last{ _Codepoints.Size() };
+
+		while (first < last)
+		{
+			const uint64 middle{ first + ((last - first) >> 1) };
+
+			if (_Codepoints[middle] < codepoint)
+			{
+				first = middle + 1;
+			}
+
+			else
+			{
+				last = middle;
+			}
+		}
+
+		return first < _Codepoints.Size() && _Codepoints[first] == codepoint ? &_CharacterDescriptions[first] : nullptr;
+	}
+
+	/*
+	*	Returns the kerning adjustment between the given codepoints.
+	*/
+	FORCE_INLINE NO_DISCARD float32 GetKerningAdjustment(const uint32 first_codepoint, const uint32 second_codepoint) const NOEXCEPT
+	{
+		const uint64 key{ (static_cast<uint64>(first_codepoint) << 32) | second_codepoint };
+
+		uint64 first{ 0 };
+		uint64 last{ _KerningPairs.Size() };
+
+		while (first < last)
+		{
+			const uint64 middle{ first + ((last - first) >> 1) };
+
+			if (_KerningPairs[middle]._Key < key)
+			{
+				first = middle + 1;
+			}
+
+			else
+			{
+				last = middle;
+			}
+		}
+
+		return first < _KerningPairs.Size() && _KerningPairs[first]._Key == key ? _KerningPairs[first]._Adjustment : 0.0f;
+	}
+
 };
\ No newline at end of file
@@ -2,11 +2,15 @@
 
 //Core.
 #include <Core/Essential/CatalystEssential.h>
+#include <Core/Containers/DynamicArray.h>
 #include <Core/Containers/StreamArchive.h>
 
 //Content.
 #include <Content/Core/Asset.h>
 
+//Math.
+#include <Math/General/Vector.h>
+
 //World.
 #include <World/Level/LevelStatistics.h>
 
@@ -15,12 +19,47 @@ class LevelAsset final : public Asset
 
 public:
 
+	/*
+	*	Cell class definition.
+	*	The entities of a level are grouped by the world grid cell they're in, so that they can be streamed in and out cell by cell.
+	*/
+	class Cell final
+	{
+
+	public:
+
+		//The cell, relative to the level.
+		Vector3<int32> _Cell;
+
+		//Denotes whether or not this cell holds the entities without a world transform, which are resident as long as the level is.
+		bool _AlwaysResident;
+
+		//The number of entities.
+		uint64 _NumberOfEntities;
+
+		//The position in the stream archive where the entities start.
+		uint64 _StreamArchivePosition;
+
+		//The size of the entities in the stream archive, in bytes.
+		uint64 _StreamArchiveSize;
+
+		//The position in the stream archive where the entity links within this cell start, stored as pairs of indices into the cell's entities.
+		uint64 _EntityLinksPosition;
+
+		//The number of entity links within this cell.
+		uint64 _NumberOfEntityLinks;
+
+	};
+
 	//The type identifier.
 	static HashString TYPE_IDENTIFIER;
 
 	//The level statistics.
 	LevelStatistics _LevelStatistics;
 
+	//The cells, in the order their entities appear in the stream archive.
+	DynamicArray<Cell> _Cells;
+
 	//The stream archive.
 	StreamArchive _StreamArchive;
 
@@ -74,6 +74,12 @@ public:
 		//The dependencies.
 		mutable DynamicArray<StaticString<MAXIMUM_FILE_PATH_LENGTH>> _Dependencies;
 
+		//The outputs. Asset compilers report the files they write here, so they can be cached in the content store.
+		mutable DynamicArray<StaticString<MAXIMUM_FILE_PATH_LENGTH>> _Outputs;
+
+		//Denotes whether or not compiling failed. Asset compilers set this when they couldn't write their outputs, so the asset is compiled again next time.
+		mutable bool _Failed{ false };
+
 	};
 
 	/*
@@ -2,23 +2,43 @@
 
 //Core.
 #include <Core/Essential/CatalystEssential.h>
+#include <Core/Algorithms/HashAlgorithms.h>
 #include <Core/Containers/DynamicArray.h>
 #include <Core/General/StaticString.h>
 
 //File.
 #include <File/Core/File.h>
+#include <File/Core/BinaryInputFile.h>
+
+//Math.
+#include <Math/Core/BaseMath.h>
 
 //Third party.
 #include <ThirdParty/json/json.hpp>
 
 //STD.
 #include <fstream>
+#include <unordered_map>
 
+/*
+*	Content cache class definition.
+*	Keeps track of what was compiled from what, keyed on the contents of the source files rather than their timestamps.
+*	Timestamps are only used to skip rehashing files that haven't been touched since they were last hashed.
+*/
 class ContentCache final
 {
 
 public:
 
+	//Denotes an invalid key.
+	constexpr static uint64 INVALID_KEY{ UINT64_MAXIMUM };
+
+	//The maximum depth when following dependencies of dependencies, which also protects against cycles.
+	constexpr static uint8 MAXIMUM_DEPENDENCY_DEPTH{ 8 };
+
+	//The size of the chunks that files are hashed in.
+	constexpr static uint64 HASH_CHUNK_SIZE{ 1'024 * 1'024 };
+
 	/*
 	*	Entry class definition.
 	*/
@@ -28,9 +48,9 @@ public:
 	public:
 
 		/*
-		*	Dependency class definition.
+		*	Output class definition.
 		*/
-		class Dependency final
+		class Output final
 		{
 
 		public:
@@ -38,8 +58,8 @@ public:
 			//The file path.
 			StaticString<MAXIMUM_FILE_PATH_LENGTH> _FilePath;
 
-			//The last changed time.
-			uint64 _LastChangedTime;
+			//The hash of the contents.
+			uint64 _Hash;
 
 		};
 
@@ -49,48 +69,30 @@ public:
 		//The identifier.
 		uint64 _Identifier;
 
-		//The version.
-		uint64 _Version;
-
-		//The last changed time.
-		uint64 _LastChangedTime;
+		//The key that the outputs were compiled with.
+		uint64 _Key;
 
 		//The dependencies.
-		DynamicArray<Dependency> _Dependencies;
+		DynamicArray<StaticString<MAXIMUM_FILE_PATH_LENGTH>> _Dependencies;
+
+		//The outputs.
+		DynamicArray<Output> _Outputs;
 
 		/*
-		*	Returns if this entry needs a compile.
+		*	Returns if this entry needs a compile, given the current key.
 		*/
-		FORCE_INLINE NO_DISCARD bool NeedsCompile(const uint64 current_version) const NOEXCEPT
+		FORCE_INLINE NO_DISCARD bool NeedsCompile(const uint64 current_key) const NOEXCEPT
 		{
-			//If the identifier is invalid, it needs a compile.
-			if (_Version == UINT64_MAXIMUM)
-			{
-				return true;
-			}
-
-			//If the last changed time is invalid, it needs a compile.
-			if (_LastChangedTime == UINT64_MAXIMUM)
-			{
-				return true;
-			}
-
-			//If the stored version differs, it needs a compile.
-			if (_Version != current_version)
-			{
-				return true;
-			}
-
-			//If the last changed time version differs, it needs a compile.
-			if (_LastChangedTime != File::LastChangedTime(_FilePath.Data()))
+			//If the key is invalid or differs, it needs a compile.
+			if (_Key == INVALID_KEY || _Key != current_key)
 			{
 				return true;
 			}
 
-			//If any of the dependencies last changed time differs, it needs a compile.
-			for (const Dependency &dependency : _Dependencies)
+			//If any of the outputs has gone missing, it needs a compile.
+			for (const Output &output : _Outputs)
 			{
-				if (dependency._LastChangedTime != File::LastChangedTime(dependency._FilePath.Data()))
+				if (!File::Exists(output._FilePath.Data()))
 				{
 					return true;
 				}
@@ -100,31 +102,6 @@ public:
 			return false;
 		}
 
-		/*
-		*	Updates this entry.
-		*/
-		FORCE_INLINE void Update(const uint64 current_version, const DynamicArray<StaticString<MAXIMUM_FILE_PATH_LENGTH>> &dependencies) NOEXCEPT
-		{
-			//Set the version.
-			_Version = current_version;
-
-			//Set the last changed time.
-			_LastChangedTime = File::LastChangedTime(_FilePath.Data());
-
-			//Set the dependencies.
-			_Dependencies.Clear();
-			_Dependencies.Reserve(dependencies.Size());
-
-			for (const StaticString<MAXIMUM_FILE_PATH_LENGTH> &dependency : dependencies)
-			{
-				_Dependencies.Emplace();
-				Dependency &new_dependency{ _Dependencies.Back() };
-
-				new_dependency._FilePath = dependency;
-				new_dependency._LastChangedTime = File::LastChangedTime(dependency.Data());
-			}
-		}
-
 	};
 
 	/*
@@ -167,60 +144,66 @@ public:
 		for (const nlohmann::ordered_json &entry_entry : entries_entry)
 		{
 			//Add the new entry.
-			_Entries.Emplace();
-			Entry &new_entry{ _Entries.Back() };
-
-			//Read the file path.
-			new_entry._FilePath = entry_entry["FilePath"].get<std::string>().c_str();
-
-			//Read the identifier.
-			new_entry._Identifier = entry_entry["Identifier"].get<uint64>();
-
-			//Read the version.
-			new_entry._Version = entry_entry["Version"].get<uint64>();
+			Entry &new_entry{ *GetEntry(entry_entry["FilePath"].get<std::string>().c_str()) };
 
-			//Read the last changed time.
-			new_entry._LastChangedTime = entry_entry["LastChangedTime"].get<uint64>();
+			//Read the key.
+			new_entry._Key = entry_entry["Key"].get<uint64>();
 
 			//Read the dependencies.
 			if (entry_entry.contains("Dependencies"))
 			{
-				const nlohmann::ordered_json &dependencies_entry{ entry_entry["Dependencies"] };
-
-				for (const nlohmann::ordered_json &dependency_entry : dependencies_entry)
+				for (const nlohmann::ordered_json &dependency_entry : entry_entry["Dependencies"])
 				{
-					//Add the new dependency.
-					new_entry._Dependencies.Emplace();
-					Entry::Dependency &new_dependency{ new_entry._Dependencies.Back() };
+					new_entry._Dependencies.Emplace(dependency_entry.get<std::string>().c_str());
+				}
+			}
 
-					//Read the file path.
-					new_dependency._FilePath = dependency_entry["FilePath"].get<std::string>().c_str();
+			//Read the outputs.
+			if (entry_entry.contains("Outputs"))
+			{
+				for (const nlohmann::ordered_json &output_entry : entry_entry["Outputs"])
+				{
+					new_entry._Outputs.Emplace();
+					Entry::Output &new_output{ new_entry._Outputs.Back() };
 
-					//Read the last changed time.
-					new_dependency._LastChangedTime = dependency_entry["LastChangedTime"].get<uint64>();
+					new_output._FilePath = output_entry["FilePath"].get<std::string>().c_str();
+					new_output._Hash = output_entry["Hash"].get<uint64>();
 				}
 			}
 		}
+
+		//Read the file hashes.
+		if (json.contains("Files"))
+		{
+			for (const nlohmann::ordered_json &file_entry : json["Files"])
+			{
+				const std::string file_path_string{ file_entry["FilePath"].get<std::string>() };
+
+				FileRecord &file_record{ _FileRecords[HashAlgorithms::MurmurHash64(file_path_string.c_str(), file_path_string.length())] };
+
+				file_record._FilePath = file_path_string.c_str();
+				file_record._LastChangedTime = file_entry["LastChangedTime"].get<uint64>();
+				file_record._Hash = file_entry["Hash"].get<uint64>();
+			}
+		}
 	}
 
 	/*
-	*	Returns the entry with the given file path.
+	*	Returns the entry with the given file path, creating it if it doesn't exist.
 	*/
 	FORCE_INLINE NO_DISCARD Entry *const RESTRICT GetEntry(const char *const RESTRICT file_path) NOEXCEPT
 	{
-		//Calculate the identifier.
-		const uint64 identifier{ HashAlgorithms::MurmurHash64(file_path, StringUtilities::StringLength(file_path)) };
-
 		//Check if we have an already existing entry.
-		for (Entry &entry : _Entries)
+		if (Entry *const RESTRICT entry{ FindEntry(file_path) })
 		{
-			if (entry._Identifier == identifier)
-			{
-				return &entry;
-			}
+			return entry;
 		}
 
 		//Otherwise, add a new one and return that one.
+		const uint64 identifier{ HashAlgorithms::MurmurHash64(file_path, StringUtilities::StringLength(file_path)) };
+
+		_EntryIndices[identifier] = _Entries.Size();
+
 		_Entries.Emplace();
 		Entry &entry{ _Entries.Back() };
 
@@ -230,18 +213,101 @@ public:
 		//Set the identifier.
 		entry._Identifier = identifier;
 
-		//Set the version.
-		entry._Version = UINT64_MAXIMUM;
-
-		//Set the last changed time.
-		entry._LastChangedTime = UINT64_MAXIMUM;
+		//Set the key.
+		entry._Key = INVALID_KEY;
 
 		//Return the new entry!
 		return &entry;
 	}
 
 	/*
-	*	Writes this shader cache.
+	*	Returns the entry with the given file path, or nullptr if there is none.
+	*/
+	FORCE_INLINE NO_DISCARD Entry *const RESTRICT FindEntry(const char *const RESTRICT file_path) NOEXCEPT
+	{
+		const uint64 identifier{ HashAlgorithms::MurmurHash64(file_path, StringUtilities::StringLength(file_path)) };
+		const std::unordered_map<uint64, uint64>::const_iterator iterator{ _EntryIndices.find(identifier) };
+
+		return iterator != _EntryIndices.end() ? &_Entries[iterator->second] : nullptr;
+	}
+
+	/*
+	*	Returns the hash of the contents of the file at the given file path, or 0 if it doesn't exist.
+	*	Files that haven't changed since they were last hashed aren't read again.
+	*/
+	FORCE_INLINE NO_DISCARD uint64 FileHash(const char *const RESTRICT file_path) NOEXCEPT
+	{
+		if (!File::Exists(file_path))
+		{
+			return 0;
+		}
+
+		const uint64 last_changed_time{ File::LastChangedTime(file_path) };
+
+		FileRecord &file_record{ _FileRecords[HashAlgorithms::MurmurHash64(file_path, StringUtilities::StringLength(file_path))] };
+
+		if (file_record._FilePath && file_record._LastChangedTime == last_changed_time)
+		{
+			return file_record._Hash;
+		}
+
+		//Hash the contents in chunks, chaining the hash of each chunk into the next.
+		BinaryInputFile file{ file_path };
+
+		const uint64 file_size{ file.Size() };
+		DynamicArray<byte> buffer;
+		buffer.Upsize<false>(BaseMath::Minimum<uint64>(file_size, HASH_CHUNK_SIZE) + 1);
+
+		uint64 hash{ file_size };
+
+		for (uint64 offset{ 0 }; offset < file_size; offset += HASH_CHUNK_SIZE)
+		{
+			const uint64 chunk_size{ BaseMath::Minimum<uint64>(file_size - offset, HASH_CHUNK_SIZE) };
+
+			file.Read(buffer.Data(), chunk_size);
+			hash = HashAlgorithms::MurmurHash64(static_cast<const void *const RESTRICT>(buffer.Data()), chunk_size, hash);
+		}
+
+		file.Close();
+
+		file_record._FilePath = file_path;
+		file_record._LastChangedTime = last_changed_time;
+		file_record._Hash = hash;
+
+		return hash;
+	}
+
+	/*
+	*	Returns the source key for the given file path; the hash of it's contents combined with the given settings hash.
+	*	Identifies what an asset is, before knowing what it depends on.
+	*/
+	FORCE_INLINE NO_DISCARD uint64 SourceKey(const char *const RESTRICT file_path, const uint64 settings_hash) NOEXCEPT
+	{
+		const uint64 file_hash{ FileHash(file_path) };
+
+		return HashAlgorithms::MurmurHash64(static_cast<const void *const RESTRICT>(&file_hash), sizeof(uint64), settings_hash);
+	}
+
+	/*
+	*	Returns the key for the given source key and dependencies.
+	*	Dependencies that are themselves compiled with dependencies of their own contribute those as well.
+	*/
+	FORCE_INLINE NO_DISCARD uint64 Key(const uint64 source_key, const DynamicArray<StaticString<MAXIMUM_FILE_PATH_LENGTH>> &dependencies) NOEXCEPT
+	{
+		uint64 key{ source_key };
+
+		for (const StaticString<MAXIMUM_FILE_PATH_LENGTH> &dependency : dependencies)
+		{
+			const uint64 dependency_hash{ TransitiveHash(dependency.Data(), 0) };
+
+			key = HashAlgorithms::MurmurHash64(static_cast<const void *const RESTRICT>(&dependency_hash), sizeof(uint64), key);
+		}
+
+		return key;
+	}
+
+	/*
+	*	Writes this content cache.
 	*/
 	FORCE_INLINE void Write(const char* const RESTRICT file_path) NOEXCEPT
 	{
@@ -256,39 +322,45 @@ public:
 
 		for (const Entry &entry : _Entries)
 		{
+			//Entries that were never compiled aren't worth remembering.
+			if (entry._Key == INVALID_KEY)
+			{
+				continue;
+			}
+
 			//Set up the entry entry.
 			nlohmann::ordered_json entry_entry;
 
 			//Set the file path.
 			entry_entry["FilePath"] = entry._FilePath.Data();
 
-			//Set the identifier.
-			entry_entry["Identifier"] = entry._Identifier;
-
-			//Set the version.
-			entry_entry["Version"] = entry._Version;
-
-			//Set the last changed time.
-			entry_entry["LastChangedTime"] = entry._LastChangedTime;
+			//Set the key.
+			entry_entry["Key"] = entry._Key;
 
 			//Write the dependencies.
 			if (!entry._Dependencies.Empty())
 			{
 				nlohmann::ordered_json &dependencies_entry{ entry_entry["Dependencies"] };
 
-				for (const Entry::Dependency &dependency : entry._Dependencies)
+				for (const StaticString<MAXIMUM_FILE_PATH_LENGTH> &dependency : entry._Dependencies)
 				{
-					//Set up the dependency entry.
-					nlohmann::ordered_json dependency_entry;
+					dependencies_entry.emplace_back(dependency.Data());
+				}
+			}
+
+			//Write the outputs.
+			if (!entry._Outputs.Empty())
+			{
+				nlohmann::ordered_json &outputs_entry{ entry_entry["Outputs"] };
 
-					//Set the file path.
-					dependency_entry["FilePath"] = dependency._FilePath.Data();
+				for (const Entry::Output &output : entry._Outputs)
+				{
+					nlohmann::ordered_json output_entry;
 
-					//Set the last changed time.
-					dependency_entry["LastChangedTime"] = dependency._LastChangedTime;
+					output_entry["FilePath"] = output._FilePath.Data();
+					output_entry["Hash"] = output._Hash;
 
-					//Add the dependency entry.
-					dependencies_entry.emplace_back(dependency_entry);
+					outputs_entry.emplace_back(output_entry);
 				}
 			}
 
@@ -296,6 +368,20 @@ public:
 			entries_entry.emplace_back(entry_entry);
 		}
 
+		//Write the file hashes.
+		nlohmann::ordered_json &files_entry{ json["Files"] };
+
+		for (const std::pair<const uint64, FileRecord> &file_record : _FileRecords)
+		{
+			nlohmann::ordered_json file_entry;
+
+			file_entry["FilePath"] = file_record.second._FilePath.Data();
+			file_entry["LastChangedTime"] = file_record.second._LastChangedTime;
+			file_entry["Hash"] = file_record.second._Hash;
+
+			files_entry.emplace_back(file_entry);
+		}
+
 		//Write the JSON!
 		{
 			//Open the file.
@@ -315,11 +401,60 @@ private:
 	enum class Version : uint64
 	{
 		BASE,
+		CONTENT_HASH,
 
 		CURRENT_VERSION
 	};
 
+	/*
+	*	File record class definition.
+	*/
+	class FileRecord final
+	{
+
+	public:
+
+		//The file path.
+		StaticString<MAXIMUM_FILE_PATH_LENGTH> _FilePath;
+
+		//The last changed time when the file was hashed.
+		uint64 _LastChangedTime;
+
+		//The hash of the contents.
+		uint64 _Hash;
+
+	};
+
 	//The entries.
 	DynamicArray<Entry> _Entries;
 
+	//Maps the identifier of each entry to it's index.
+	std::unordered_map<uint64, uint64> _EntryIndices;
+
+	//The file records, mapped by the hash of their file path.
+	std::unordered_map<uint64, FileRecord> _FileRecords;
+
+	/*
+	*	Returns the hash of the given dependency, including the dependencies it was compiled with, if it was compiled itself.
+	*/
+	FORCE_INLINE NO_DISCARD uint64 TransitiveHash(const char *const RESTRICT file_path, const uint8 depth) NOEXCEPT
+	{
+		uint64 hash{ FileHash(file_path) };
+
+		if (depth < MAXIMUM_DEPENDENCY_DEPTH)
+		{
+			if (const Entry *const RESTRICT entry{ FindEntry(file_path) })
+			{
+				for (const StaticString<MAXIMUM_FILE_PATH_LENGTH> &dependency : entry->_Dependencies)
+				{
+					const uint64 dependency_hash{ TransitiveHash(dependency.Data(), depth + 1) };
+
+					hash = HashAlgorithms::MurmurHash64(static_cast<const void *const RESTRICT>(&dependency_hash), sizeof(uint64), hash);
+				}
+			}
+		}
+
+		return hash;
+	}
+
 };
\ No newline at end of file
@@ -0,0 +1,43 @@
+#pragma once
+
+//Core.
+#include <Core/Essential/CatalystEssential.h>
+#include <Core/General/StaticString.h>
+
+//Content.
+#include <Content/Core/ContentCache.h>
+
+/*
+*	Content store class definition.
+*	A content addressed store of compiled outputs, that can be shared between checkouts and machines as a plain directory.
+*
+*	Objects\<hash>		- The contents of a compiled output, named by the hash of it's contents.
+*	Manifests\<key>		- Which dependencies an asset was compiled with, and which outputs it produced, named by it's source key.
+*/
+class ContentStore final
+{
+
+public:
+
+	/*
+	*	Initializes this content store in the given directory.
+	*/
+	void Initialize(const char *const RESTRICT directory_path) NOEXCEPT;
+
+	/*
+	*	Tries to restore the outputs for the given source key into the given entry.
+	*	Returns if it succeeded, which only happens if the manifest was compiled with the same dependencies.
+	*/
+	NO_DISCARD bool Restore(const uint64 source_key, ContentCache *const RESTRICT content_cache, ContentCache::Entry *const RESTRICT entry) NOEXCEPT;
+
+	/*
+	*	Stores the outputs of the given entry under the given source key.
+	*/
+	void Store(const uint64 source_key, const ContentCache::Entry &entry) NOEXCEPT;
+
+private:
+
+	//The directory path.
+	StaticString<MAXIMUM_FILE_PATH_LENGTH> _DirectoryPath;
+
+};
\ No newline at end of file
@@ -148,4 +148,14 @@ public:
 		std::sort(begin, end, Comparator(user_data, comparison_function));
 	}
 
+	/*
+	*	Radix sort.
+	*
+	*	Time complexity: O(n * k), where k is the number of 8-bit digits that actually differ between the keys.
+	*	Sorting in place: No. Writes the indices of the keys in sorted order to 'order', the keys themselves are left untouched.
+	*	Stable: Yes.
+	*	Uses: Sorting large amounts of 64-bit keys, for example draw keys. Large inputs are split across multiple tasks.
+	*/
+	static void RadixSort(const uint64 *const RESTRICT keys, const uint64 number_of_keys, uint32 *const RESTRICT order) NOEXCEPT;
+
 };
\ No newline at end of file
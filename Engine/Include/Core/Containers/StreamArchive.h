@@ -109,6 +109,23 @@ public:
 		*position += size;
 	}
 
+	/*
+	*	Returns a view of the given number of bytes at the given position, without copying them.
+	*	The view is only valid for as long as the underlying data is, which for mapped files means until they are closed.
+	*	Updates the position.
+	*/
+	FORCE_INLINE NO_DISCARD const byte *const RESTRICT View(const uint64 size, uint64 *const RESTRICT position) const NOEXCEPT
+	{
+		ASSERT(_Mode == Mode::READ || _Mode == Mode::READ_WRITE, "Invalid mode!");
+		ASSERT(*position + size <= _Size, "Viewing past the end of the stream archive!");
+
+		const byte *const RESTRICT view{ &_Data[*position] };
+
+		*position += size;
+
+		return view;
+	}
+
 	/*
 	*	Writes to this stream archive.
 	*/
@@ -4,18 +4,27 @@
 #include <Core/Essential/CatalystEssential.h>
 #include <Core/Utilities/StringUtilities.h>
 
+/*
+*	Dynamic string class definition.
+*	Strings of up to LOCAL_CAPACITY characters are stored inline, which covers most names, arguments and short lines without touching the heap.
+*	Longer strings live on the heap, with the capacity growing geometrically so that repeated appends don't copy the whole string every time.
+*	The inline storage doesn't point into itself, so dynamic strings can still be relocated with a plain memory copy, which dynamic arrays rely on.
+*/
 class DynamicString final
 {
 
 public:
 
+	//The number of characters that can be stored inline, not counting the null terminator.
+	constexpr static uint64 LOCAL_CAPACITY{ 23 };
+
 	/*
 	*	Default constructor.
 	*/
 	FORCE_INLINE DynamicString() NOEXCEPT
 		:
-		_String(nullptr),
-		_Length(0)
+		_Length(0),
+		_Capacity(0)
 	{
 
 	}
@@ -24,23 +33,13 @@ public:
 	*	Copy constructor.
 	*/
 	FORCE_INLINE DynamicString(const DynamicString &other) NOEXCEPT
+		:
+		_Length(0),
+		_Capacity(0)
 	{
-		if (other._String)
+		if (other)
 		{
-			//Set the length of this string.
-			_Length = other.Length();
-
-			//Allocate sufficient memory for the underlying string.
-			_String = static_cast<char *RESTRICT>(Memory::Allocate(_Length + 1));
-
-			//Copy the contents of the other string.
-			Memory::Copy(_String, other._String, _Length + 1);
-		}
-
-		else
-		{
-			_String = nullptr;
-			_Length = 0;
+			Assign(other.Data(), other._Length);
 		}
 	}
 
@@ -49,27 +48,33 @@ public:
 	*/
 	FORCE_INLINE DynamicString(DynamicString &&other) NOEXCEPT
 	{
-		//Steal the other string's underlying string and set it to nullptr!
-		_String = other._String;
-		other._String = nullptr;
+		//Steal the other string's storage, whether it's inline or on the heap, and reset it.
+		Memory::Copy(this, &other, sizeof(DynamicString));
 
-		//Steal the other string's length!
-		_Length = other._Length;
+		other._Length = 0;
+		other._Capacity = 0;
 	}
 
 	/*
 	*	Constructor taking a C string.
 	*/
 	FORCE_INLINE DynamicString(const char *const RESTRICT new_string) NOEXCEPT
+		:
+		_Length(0),
+		_Capacity(0)
 	{
-		//Determine how long the C string is.
-		_Length = StringUtilities::StringLength(new_string);
-
-		//Allocate sufficient memory to host the string.
-		_String = static_cast<char *RESTRICT>(Memory::Allocate(_Length + 1));
+		Assign(new_string, StringUtilities::StringLength(new_string));
+	}
 
-		//Copy the string to the memory.
-		Memory::Copy(static_cast<void *RESTRICT>(_String), static_cast<const void *const RESTRICT>(new_string), _Length + 1);
+	/*
+	*	Constructor taking a string and it's length, which doesn't need to be null terminated.
+	*/
+	FORCE_INLINE DynamicString(const char *const RESTRICT new_string, const uint64 length) NOEXCEPT
+		:
+		_Length(0),
+		_Capacity(0)
+	{
+		Assign(new_string, length);
 	}
 
 	/*
@@ -78,9 +83,9 @@ public:
 	FORCE_INLINE ~DynamicString() NOEXCEPT
 	{
 		//Free the underlying string.
-		if (_String)
+		if (_Capacity > LOCAL_CAPACITY)
 		{
-			Memory::Free(_String);
+			Memory::Free(_HeapString);
 		}
 	}
 
@@ -89,7 +94,7 @@ public:
 	*/
 	FORCE_INLINE constexpr operator bool() const NOEXCEPT
 	{
-		return _String != nullptr;
+		return _Capacity != 0;
 	}
 
 	/*
@@ -97,28 +102,19 @@ public:
 	*/
 	FORCE_INLINE void operator=(const DynamicString &other) NOEXCEPT
 	{
-		if (other._String)
+		if (this == &other)
 		{
-			//Update the length of this string.
-			_Length = other.Length();
-
-			//Reallocate sufficient memory for the underlying string.
-			_String = static_cast<char *RESTRICT>(Memory::Reallocate(static_cast<void *RESTRICT>(_String), _Length + 1));
+			return;
+		}
 
-			//Copy the contents of the other string.
-			Memory::Copy(_String, other._String, _Length + 1);
+		if (other)
+		{
+			Assign(other.Data(), other._Length);
 		}
 
 		else
 		{
-			//Free the underlying string.
-			Memory::Free(_String);
-
-			//Reset the string.
-			_String = nullptr;
-
-			//Reset the length.
-			_Length = 0;
+			Release();
 		}
 	}
 
@@ -127,49 +123,14 @@ public:
 	*/
 	FORCE_INLINE void operator=(const char *const RESTRICT new_string) NOEXCEPT
 	{
-		//Check for nullptr.
 		if (new_string)
 		{
-			//Calculate the length of the new string.
-			const uint64 new_string_length{ StringUtilities::StringLength(new_string) };
-
-			//It's possible the string hasn't been constructed yet - if so, allocate the required memory.
-			if (!_String)
-			{
-				_String = static_cast<char *RESTRICT>(Memory::Allocate(new_string_length + 1));
-				Memory::Copy(_String, new_string, new_string_length + 1);
-
-				_Length = new_string_length;
-			}
-
-			else
-			{
-				//If the current length matches the new string's length, just copy the data over directly.
-				if (_Length == new_string_length)
-				{
-					Memory::Copy(_String, new_string, _Length + 1);
-				}
-
-				//Otherwise, allocate sufficient data to hold the new string.
-				else
-				{
-					_String = static_cast<char *RESTRICT>(Memory::Reallocate(static_cast<void *RESTRICT>(_String), new_string_length + 1));
-					Memory::Copy(_String, new_string, new_string_length + 1);
-
-					_Length = new_string_length;
-				}
-			}
+			Assign(new_string, StringUtilities::StringLength(new_string));
 		}
 
 		else
 		{
-			//Since the new string is nullptr, free the current string.
-			if (_String)
-			{
-				Memory::Free(_String);
-
-				_Length = 0;
-			}
+			Release();
 		}
 	}
 
@@ -178,12 +139,18 @@ public:
 	*/
 	FORCE_INLINE void operator=(DynamicString &&other) NOEXCEPT
 	{
-		//Steal the other string's underlying string and set it to nullptr!
-		_String = other._String;
-		other._String = nullptr;
+		if (this == &other)
+		{
+			return;
+		}
+
+		Release();
 
-		//Steal the other string's length!
-		_Length = other._Length;
+		//Steal the other string's storage, whether it's inline or on the heap, and reset it.
+		Memory::Copy(this, &other, sizeof(DynamicString));
+
+		other._Length = 0;
+		other._Capacity = 0;
 	}
 
 	/*
@@ -191,26 +158,15 @@ public:
 	*/
 	FORCE_INLINE NO_DISCARD DynamicString operator+(const char *const RESTRICT new_string) const NOEXCEPT
 	{
-		//Construct the new dynamic string.
-		DynamicString new_dynamic_string;
-
-		//Determine how long the new dynamic string will be.
-		uint64 new_string_length{ StringUtilities::StringLength(new_string) };
-		uint64 new_length{ this->_Length + new_string_length };
+		const uint64 new_string_length{ StringUtilities::StringLength(new_string) };
 
-		//Allocate sufficient memory to host the string.
-		new_dynamic_string._String = static_cast<char *RESTRICT>(Memory::Allocate(new_length + 1));
-
-		//Copy the original string to the memory.
-		Memory::Copy(static_cast<void *RESTRICT>(new_dynamic_string._String), static_cast<const void *const RESTRICT>(this->_String), this->_Length);
-
-		//Copy the new string to the memory.
-		Memory::Copy(static_cast<void *RESTRICT>(new_dynamic_string._String + this->_Length), static_cast<const void *const RESTRICT>(new_string), new_string_length + 1);
+		//Construct the new dynamic string, reserving the memory for both strings up front.
+		DynamicString new_dynamic_string;
 
-		//Write the length to the new dynamic string.
-		new_dynamic_string._Length = new_length;
+		new_dynamic_string.Reserve(_Length + new_string_length);
+		new_dynamic_string.Append(Data(), _Length);
+		new_dynamic_string.Append(new_string, new_string_length);
 
-		//Return the newly constructed dynamic string.
 		return new_dynamic_string;
 	}
 
@@ -219,45 +175,15 @@ public:
 	*/
 	FORCE_INLINE void operator+=(const char *const RESTRICT new_string) NOEXCEPT
 	{
-		//Calculate the new length.
-		const uint64 new_string_length = StringUtilities::StringLength(new_string) + 1;
-		const uint64 new_length = _Length + new_string_length - 1;
-
-		//Allocate sufficient memory to host the concatenated string.
-		_String = static_cast<char *RESTRICT>(Memory::Reallocate(static_cast<void *RESTRICT>(_String), new_length + 1));
-
-		//Copy the new string.
-		Memory::Copy(_String + _Length, new_string, new_string_length);
-
-		//Update the length of the string.
-		_Length = new_length;
+		Append(new_string, StringUtilities::StringLength(new_string));
 	}
 
 	/*
-	*	Addition assignment operator overload for charrs.
+	*	Addition assignment operator overload for characters.
 	*/
 	FORCE_INLINE void operator+=(const char new_character) NOEXCEPT
 	{
-		//Calculate the new length.
-		const uint64 new_length = _Length + 1;
-
-		//Allocate sufficient memory to host the concatenated string.
-		if (!_String)
-		{
-			_String = static_cast<char *RESTRICT>(Memory::Allocate( new_length + 1));
-		}
-
-		else
-		{
-			_String = static_cast<char *RESTRICT>(Memory::Reallocate(static_cast<void *RESTRICT>(_String), new_length + 1));
-		}
-
-		//Copy the new string.
-		Memory::Copy(_String + _Length, &new_character, sizeof(char));
-		_String[_Length + 1] = '\0';
-
-		//Update the length of the string.
-		_Length = new_length;
+		Append(&new_character, 1);
 	}
 
 	/*
@@ -265,7 +191,7 @@ public:
 	*/
 	FORCE_INLINE NO_DISCARD bool operator==(const DynamicString &other) const NOEXCEPT
 	{
-		return StringUtilities::IsEqual(_String, other._String);
+		return _Length == other._Length && StringUtilities::IsEqual(Data(), other.Data(), _Length);
 	}
 
 	/*
@@ -273,7 +199,7 @@ public:
 	*/
 	FORCE_INLINE NO_DISCARD bool operator==(const char *const RESTRICT string) const NOEXCEPT
 	{
-		return StringUtilities::IsEqual(_String, string);
+		return StringUtilities::IsEqual(Data(), string);
 	}
 
 	/*
@@ -281,7 +207,7 @@ public:
 	*/
 	FORCE_INLINE NO_DISCARD bool operator!=(const DynamicString &other) const NOEXCEPT
 	{
-		return !StringUtilities::IsEqual(_String, other._String);
+		return !(*this == other);
 	}
 
 	/*
@@ -289,7 +215,7 @@ public:
 	*/
 	FORCE_INLINE NO_DISCARD bool operator!=(const char *const RESTRICT string) const NOEXCEPT
 	{
-		return !StringUtilities::IsEqual(_String, string);
+		return !StringUtilities::IsEqual(Data(), string);
 	}
 
 	/*
@@ -297,7 +223,7 @@ public:
 	*/
 	FORCE_INLINE NO_DISCARD const char &operator[](const uint64 index) const NOEXCEPT
 	{
-		return _String[index];
+		return Data()[index];
 	}
 
 	/*
@@ -305,7 +231,7 @@ public:
 	*/
 	FORCE_INLINE NO_DISCARD char &operator[](const uint64 index) NOEXCEPT
 	{
-		return _String[index];
+		return Data()[index];
 	}
 
 	/*
@@ -313,7 +239,7 @@ public:
 	*/
 	FORCE_INLINE RESTRICTED NO_DISCARD const char *const RESTRICT Begin() const  NOEXCEPT
 	{
-		return _String;
+		return Data();
 	}
 
 	/*
@@ -321,7 +247,7 @@ public:
 	*/
 	FORCE_INLINE RESTRICTED NO_DISCARD char *const RESTRICT Begin()  NOEXCEPT
 	{
-		return _String;
+		return Data();
 	}
 
 	/*
@@ -329,7 +255,7 @@ public:
 	*/
 	FORCE_INLINE RESTRICTED NO_DISCARD const char *const RESTRICT End() const NOEXCEPT
 	{
-		return _String + _Length;
+		return Data() + _Length;
 	}
 
 	/*
@@ -337,7 +263,7 @@ public:
 	*/
 	FORCE_INLINE RESTRICTED NO_DISCARD char *const RESTRICT End() NOEXCEPT
 	{
-		return _String + _Length;
+		return Data() + _Length;
 	}
 
 	/*
@@ -377,7 +303,7 @@ public:
 	*/
 	FORCE_INLINE RESTRICTED NO_DISCARD const char *const RESTRICT Data() const NOEXCEPT
 	{
-		return _String;
+		return _Capacity == 0 ? nullptr : (_Capacity <= LOCAL_CAPACITY ? _LocalString : _HeapString);
 	}
 
 	/*
@@ -385,7 +311,7 @@ public:
 	*/
 	FORCE_INLINE RESTRICTED NO_DISCARD char *const RESTRICT Data() NOEXCEPT
 	{
-		return _String;
+		return _Capacity == 0 ? nullptr : (_Capacity <= LOCAL_CAPACITY ? _LocalString : _HeapString);
 	}
 
 	/*
@@ -396,28 +322,84 @@ public:
 		return _Length;
 	}
 
+	/*
+	*	Returns the number of characters this string can hold without reallocating, not counting the null terminator.
+	*/
+	FORCE_INLINE NO_DISCARD uint64 Capacity() const NOEXCEPT
+	{
+		return _Capacity;
+	}
+
 	/*
 	*	Sets the length of the string, reserving the required memory.
 	*/
 	FORCE_INLINE void SetLength(const uint64 new_length) NOEXCEPT
 	{
-		//Allocate the new array.
-		char *const RESTRICT new_string{ static_cast<char *const RESTRICT>(Memory::Allocate(sizeof(char) * new_length + 1)) };
-
-		//Move over the old string to the new string.
-		Memory::Copy(new_string, _String, sizeof(char) * (_Length < new_length ? _Length : new_length));
+		Reserve(new_length);
 
 		//Add the terminating character at the end.
-		new_string[new_length] = '\0';
-
-		//Free the old string
-		Memory::Free(_String);
+		Data()[new_length] = '\0';
 
-		//Update the string and the length.
-		_String = new_string;
 		_Length = new_length;
 	}
 
+	/*
+	*	Reserves memory for at least the given number of characters, not counting the null terminator.
+	*	Grows the capacity geometrically, so a string built up by repeated appends is only copied a logarithmic number of times.
+	*/
+	FORCE_INLINE void Reserve(const uint64 capacity) NOEXCEPT
+	{
+		if (_Capacity != 0 && capacity <= _Capacity)
+		{
+			return;
+		}
+
+		//Strings without storage that fit inline only need their inline storage initialized.
+		if (capacity <= LOCAL_CAPACITY)
+		{
+			_LocalString[0] = '\0';
+			_Length = 0;
+			_Capacity = LOCAL_CAPACITY;
+
+			return;
+		}
+
+		const uint64 new_capacity{ capacity > _Capacity * 2 ? capacity : _Capacity * 2 };
+		char *const RESTRICT new_string{ static_cast<char *const RESTRICT>(Memory::Allocate(new_capacity + 1)) };
+
+		if (_Capacity == 0)
+		{
+			new_string[0] = '\0';
+		}
+
+		else
+		{
+			Memory::Copy(new_string, Data(), _Length + 1);
+
+			if (_Capacity > LOCAL_CAPACITY)
+			{
+				Memory::Free(_HeapString);
+			}
+		}
+
+		_HeapString = new_string;
+		_Capacity = new_capacity;
+	}
+
+	/*
+	*	Appends the given string of the given length, which doesn't need to be null terminated.
+	*/
+	FORCE_INLINE void Append(const char *const RESTRICT string, const uint64 length) NOEXCEPT
+	{
+		Reserve(_Length + length);
+
+		char *const RESTRICT data{ Data() };
+
+		Memory::Copy(data + _Length, string, length);
+		_Length += length;
+		data[_Length] = '\0';
+	}
+
 	/*
 	*	Tries to find the given substring. If it exists, a pointer to the beginning of the substring is returned, otherwise nullptr. Const version.
 	*/
@@ -431,18 +413,19 @@ public:
 	*/
 	FORCE_INLINE RESTRICTED NO_DISCARD char *const RESTRICT Find(const char *const RESTRICT substring) NOEXCEPT
 	{
+		char *const RESTRICT data{ Data() };
 		const uint64 substring_length{ StringUtilities::StringLength(substring) };
 		uint64 matching_characters{ 0 };
 
 		for (uint64 i{ 0 }; i < _Length; ++i)
 		{
-			if (_String[i] == substring[matching_characters])
+			if (data[i] == substring[matching_characters])
 			{
 				++matching_characters;
 
 				if (matching_characters == substring_length)
 				{
-					return &_String[i - matching_characters + 1];
+					return &data[i - matching_characters + 1];
 				}
 			}
 
@@ -460,11 +443,13 @@ public:
 	*/
 	FORCE_INLINE RESTRICTED NO_DISCARD char *const RESTRICT FindLastOfCharacter(const char character) NOEXCEPT
 	{
+		char *const RESTRICT data{ Data() };
+
 		for (int64 i{ static_cast<int64>(_Length) - 1 }; i >= 0; --i)
 		{
-			if (_String[i] == character)
+			if (data[i] == character)
 			{
-				return &_String[i];
+				return &data[i];
 			}
 		}
 
@@ -473,10 +458,43 @@ public:
 
 private:
 
-	//The underlying C string.
-	char *RESTRICT _String;
+	union
+	{
+		//The heap string, used when the capacity exceeds the local capacity.
+		char *RESTRICT _HeapString;
+
+		//The local string, used when the capacity fits within the local capacity.
+		char _LocalString[LOCAL_CAPACITY + 1];
+	};
 
 	//The length of the string.
 	uint64 _Length;
 
+	//The capacity of the string, not counting the null terminator. Zero means the string has no storage at all, like a nullptr C string.
+	uint64 _Capacity;
+
+	/*
+	*	Replaces the contents of this string with the given string of the given length.
+	*/
+	FORCE_INLINE void Assign(const char *const RESTRICT string, const uint64 length) NOEXCEPT
+	{
+		_Length = 0;
+
+		Append(string, length);
+	}
+
+	/*
+	*	Releases the storage of this string, leaving it without storage at all.
+	*/
+	FORCE_INLINE void Release() NOEXCEPT
+	{
+		if (_Capacity > LOCAL_CAPACITY)
+		{
+			Memory::Free(_HeapString);
+		}
+
+		_Length = 0;
+		_Capacity = 0;
+	}
+
 };
\ No newline at end of file
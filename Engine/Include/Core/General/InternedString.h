@@ -0,0 +1,121 @@
+#pragma once
+
+//Core.
+#include <Core/Essential/CatalystEssential.h>
+#include <Core/General/HashString.h>
+
+/*
+*	Interned string class definition.
+*	Every distinct string is stored exactly once, immutable and alongside it's hash string, for the lifetime of the program.
+*	Interned strings are just a pointer, so copying and comparing them is as cheap as it gets, and the hash string never needs to be recomputed.
+*	Interning itself hashes the string and takes a lock, so it is best done once up front, for names that are compared or looked up often.
+*/
+class InternedString final
+{
+
+public:
+
+	/*
+	*	Entry class definition.
+	*	The characters follow directly after the entry in memory.
+	*/
+	class Entry final
+	{
+
+	public:
+
+		//The hash.
+		HashString _Hash;
+
+		//The length.
+		uint64 _Length;
+
+		/*
+		*	Returns the characters.
+		*/
+		FORCE_INLINE RESTRICTED NO_DISCARD const char *const RESTRICT GetCharacters() const NOEXCEPT
+		{
+			return reinterpret_cast<const char *const RESTRICT>(this + 1);
+		}
+
+	};
+
+	/*
+	*	Default constructor.
+	*/
+	FORCE_INLINE InternedString() NOEXCEPT
+		:
+		_Entry(nullptr)
+	{
+
+	}
+
+	/*
+	*	Constructor taking a C string, interning it if it hasn't been already.
+	*/
+	FORCE_INLINE InternedString(const char *const RESTRICT string) NOEXCEPT
+		:
+		_Entry(Intern(string))
+	{
+
+	}
+
+	/*
+	*	Bool operator overload.
+	*/
+	FORCE_INLINE operator bool() const NOEXCEPT
+	{
+		return _Entry != nullptr;
+	}
+
+	/*
+	*	Equality operator overload. Since every distinct string is only stored once, this only needs to compare pointers.
+	*/
+	FORCE_INLINE NO_DISCARD bool operator==(const InternedString other) const NOEXCEPT
+	{
+		return _Entry == other._Entry;
+	}
+
+	/*
+	*	Inequality operator overload.
+	*/
+	FORCE_INLINE NO_DISCARD bool operator!=(const InternedString other) const NOEXCEPT
+	{
+		return _Entry != other._Entry;
+	}
+
+	/*
+	*	Returns the hash string.
+	*/
+	FORCE_INLINE NO_DISCARD HashString GetHash() const NOEXCEPT
+	{
+		return _Entry ? _Entry->_Hash : HashString();
+	}
+
+	/*
+	*	Returns the underlying data.
+	*/
+	FORCE_INLINE RESTRICTED NO_DISCARD const char *const RESTRICT Data() const NOEXCEPT
+	{
+		return _Entry ? _Entry->GetCharacters() : nullptr;
+	}
+
+	/*
+	*	Returns the length of the string.
+	*/
+	FORCE_INLINE NO_DISCARD uint64 Length() const NOEXCEPT
+	{
+		return _Entry ? _Entry->_Length : 0;
+	}
+
+private:
+
+	//The entry.
+	const Entry *RESTRICT _Entry;
+
+	/*
+	*	Interns the given string, returning the entry for it.
+	*/
+	RESTRICTED static NO_DISCARD const Entry *const RESTRICT Intern(const char *const RESTRICT string) NOEXCEPT;
+
+};
\ No newline at end of file
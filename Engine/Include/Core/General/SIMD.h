@@ -9,7 +9,7 @@
 
 /*
 *	This file contains SIMD operations.
-*	Dynamically checks for AVX2 support, otherwise falls back to SSE2.
+*	Dynamically checks for AVX2 support, along with the FMA, F16C and BMI1 instructions that go with it, otherwise falls back to SSE2.
 */
 namespace SIMD
 {
@@ -29,18 +29,31 @@ namespace SIMD
 	*/
 	FORCE_INLINE NO_DISCARD Backend _GetBackend() NOEXCEPT
 	{
-		//Check check support for the AVX modes.
+		/*
+		*	Check check support for the AVX modes.
+		*	The AVX2 code paths also use FMA, F16C and BMI1 instructions, so those need to be there as well,
+		*	and the operating system needs to save the AVX registers across context switches.
+		*/
 		bool AVX2_supported{ false };
 
 		{
 			int32 cpu_info[4];
 			__cpuid(cpu_info, 0);
 
-			if (cpu_info[0] >= 7)
+			const int32 highest_function{ cpu_info[0] };
+
+			__cpuid(cpu_info, 1);
+
+			const bool FMA_supported{ (cpu_info[2] & (1 << 12)) != 0 };
+			const bool OSXSAVE_supported{ (cpu_info[2] & (1 << 27)) != 0 };
+			const bool F16C_supported{ (cpu_info[2] & (1 << 29)) != 0 };
+			const bool AVX_state_enabled{ OSXSAVE_supported && (_xgetbv(0) & 0x6) == 0x6 };
+
+			if (highest_function >= 7 && FMA_supported && F16C_supported && AVX_state_enabled)
 			{
 				__cpuidex(cpu_info, 7, 0);
 
-				AVX2_supported = (cpu_info[1] & (1 << 5)) != 0;
+				AVX2_supported = (cpu_info[1] & (1 << 5)) != 0 && (cpu_info[1] & (1 << 3)) != 0;
 			}
 		}
 
@@ -57,6 +70,57 @@ namespace SIMD
 		return BACKEND;
 	}
 
+	/*
+	*	Returns if the popcnt instruction is supported.
+	*/
+	FORCE_INLINE NO_DISCARD bool _IsPOPCNTSupported() NOEXCEPT
+	{
+		int32 cpu_info[4];
+		__cpuid(cpu_info, 1);
+
+		return (cpu_info[2] & (1 << 23)) != 0;
+	}
+
+	/*
+	*	Returns if the popcnt instruction is supported.
+	*/
+	FORCE_INLINE NO_DISCARD bool IsPOPCNTSupported() NOEXCEPT
+	{
+		static bool SUPPORTED{ _IsPOPCNTSupported() };
+		return SUPPORTED;
+	}
+
+	/*
+	*	Returns the number of set bits in the given mask.
+	*/
+	FORCE_INLINE NO_DISCARD uint32 CountSetBits(const uint64 mask) NOEXCEPT
+	{
+		if (IsPOPCNTSupported())
+		{
+			return static_cast<uint32>(_mm_popcnt_u64(mask));
+		}
+
+		//Fall back to counting the bits in parallel within the word.
+		uint64 count{ mask - ((mask >> 1) & 0x5555555555555555ull) };
+
+		count = (count & 0x3333333333333333ull) + ((count >> 2) & 0x3333333333333333ull);
+		count = (count + (count >> 4)) & 0x0f0f0f0f0f0f0f0full;
+
+		return static_cast<uint32>((count * 0x0101010101010101ull) >> 56);
+	}
+
+	/*
+	*	Returns the index of the lowest set bit in the given mask, which can't be zero.
+	*	Uses bsf, which every x64 processor has, instead of tzcnt, which needs BMI1.
+	*/
+	FORCE_INLINE NO_DISCARD uint32 LowestSetBitIndex(const uint64 mask) NOEXCEPT
+	{
+		unsigned long index;
+		_BitScanForward64(&index, mask);
+
+		return static_cast<uint32>(index);
+	}
+
 	/*
 	*	Adds Y into X.
 	*/
@@ -445,4 +509,65 @@ namespace SIMD
 		}
 	}
 
+	/*
+	*	Multiplies the column major 4x4 matrices A and B, writing A * B into C.
+	*	A single 4x4 matrix fits four SSE registers, so AVX2 doesn't add anything here and shares the SSE2 path.
+	*/
+	FORCE_INLINE void MultiplyMatrix4x4(const float32 *const RESTRICT A, const float32 *const RESTRICT B, float32 *const RESTRICT C) NOEXCEPT
+	{
+		switch (GetBackend())
+		{
+			case Backend::UNKNOWN:
+			{
+				ASSERT(false, "SIMD backend is somehow not initialized!");
+
+				break;
+			}
+
+			case Backend::NONE:
+			{
+				for (uint64 column{ 0 }; column < 4; ++column)
+				{
+					for (uint64 row{ 0 }; row < 4; ++row)
+					{
+						C[column * 4 + row] =	A[0 * 4 + row] * B[column * 4 + 0]
+												+ A[1 * 4 + row] * B[column * 4 + 1]
+												+ A[2 * 4 + row] * B[column * 4 + 2]
+												+ A[3 * 4 + row] * B[column * 4 + 3];
+					}
+				}
+
+				break;
+			}
+
+			case Backend::SSE2:
+			case Backend::AVX2:
+			{
+				const __m128 _A0{ _mm_loadu_ps(&A[0]) };
+				const __m128 _A1{ _mm_loadu_ps(&A[4]) };
+				const __m128 _A2{ _mm_loadu_ps(&A[8]) };
+				const __m128 _A3{ _mm_loadu_ps(&A[12]) };
+
+				//Each column of C is the columns of A weighted by the matching column of B.
+				for (uint64 column{ 0 }; column < 4; ++column)
+				{
+					__m128 _C{ _mm_mul_ps(_A0, _mm_set1_ps(B[column * 4 + 0])) };
+					_C = _mm_add_ps(_C, _mm_mul_ps(_A1, _mm_set1_ps(B[column * 4 + 1])));
+					_C = _mm_add_ps(_C, _mm_mul_ps(_A2, _mm_set1_ps(B[column * 4 + 2])));
+					_C = _mm_add_ps(_C, _mm_mul_ps(_A3, _mm_set1_ps(B[column * 4 + 3])));
+					_mm_storeu_ps(&C[column * 4], _C);
+				}
+
+				break;
+			}
+
+			default:
+			{
+				ASSERT(false, "Invalid case!");
+
+				break;
+			}
+		}
+	}
+
 }
\ No newline at end of file
@@ -0,0 +1,213 @@
+#pragma once
+
+//Core.
+#include <Core/Essential/CatalystEssential.h>
+#include <Core/General/DynamicString.h>
+#include <Core/Utilities/StringUtilities.h>
+
+//STL.
+#include <stdarg.h>
+#include <stdio.h>
+
+/*
+*	String builder class definition.
+*	Builds up a string in memory provided by the caller, typically a stack buffer or memory from the frame allocator,
+*	so that assembling paths and lines piece by piece doesn't allocate at all in the common case.
+*	If the string outgrows the provided memory, it spills over to the heap, growing it's capacity geometrically from there.
+*	The string builder doesn't own the provided memory, so it must not outlive it.
+*/
+class StringBuilder final
+{
+
+public:
+
+	/*
+	*	Constructor taking a fixed size buffer.
+	*/
+	template <uint64 SIZE>
+	FORCE_INLINE StringBuilder(char (&buffer)[SIZE]) NOEXCEPT
+		:
+		StringBuilder(buffer, SIZE)
+	{
+
+	}
+
+	/*
+	*	Constructor taking a buffer and it's size, including the null terminator.
+	*/
+	FORCE_INLINE StringBuilder(char *const RESTRICT buffer, const uint64 buffer_size) NOEXCEPT
+		:
+		_Buffer(buffer),
+		_Length(0),
+		_Capacity(buffer_size - 1),
+		_OwnsBuffer(false)
+	{
+		ASSERT(buffer_size > 0, "String builders need room for at least the null terminator!");
+
+		_Buffer[0] = '\0';
+	}
+
+	/*
+	*	Copy constructor - prohibited, the buffer can't be shared.
+	*/
+	StringBuilder(const StringBuilder &other) NOEXCEPT = delete;
+
+	/*
+	*	Copy operator overload - prohibited, the buffer can't be shared.
+	*/
+	void operator=(const StringBuilder &other) NOEXCEPT = delete;
+
+	/*
+	*	Default destructor.
+	*/
+	FORCE_INLINE ~StringBuilder() NOEXCEPT
+	{
+		if (_OwnsBuffer)
+		{
+			Memory::Free(_Buffer);
+		}
+	}
+
+	/*
+	*	Appends the given string of the given length, which doesn't need to be null terminated.
+	*/
+	FORCE_INLINE void Append(const char *const RESTRICT string, const uint64 length) NOEXCEPT
+	{
+		Reserve(_Length + length);
+
+		Memory::Copy(_Buffer + _Length, string, length);
+		_Length += length;
+		_Buffer[_Length] = '\0';
+	}
+
+	/*
+	*	Appends the given C string.
+	*/
+	FORCE_INLINE void Append(const char *const RESTRICT string) NOEXCEPT
+	{
+		Append(string, StringUtilities::StringLength(string));
+	}
+
+	/*
+	*	Appends the given character.
+	*/
+	FORCE_INLINE void Append(const char character) NOEXCEPT
+	{
+		Append(&character, 1);
+	}
+
+	/*
+	*	Appends the given dynamic string.
+	*/
+	FORCE_INLINE void Append(const DynamicString &string) NOEXCEPT
+	{
+		Append(string.Data(), string.Length());
+	}
+
+	/*
+	*	Appends a string formatted like printf.
+	*/
+	FORCE_INLINE void AppendFormat(const char *const RESTRICT format, ...) NOEXCEPT
+	{
+		va_list variadic_arguments;
+		va_start(variadic_arguments, format);
+
+		//Try to format directly into the remaining space first, keeping the arguments around in case it doesn't fit.
+		va_list retry_variadic_arguments;
+		va_copy(retry_variadic_arguments, variadic_arguments);
+
+		const int32 formatted_length{ vsnprintf(_Buffer + _Length, _Capacity - _Length + 1, format, variadic_arguments) };
+
+		va_end(variadic_arguments);
+
+		if (formatted_length > 0)
+		{
+			if (static_cast<uint64>(formatted_length) > _Capacity - _Length)
+			{
+				Reserve(_Length + formatted_length);
+
+				vsnprintf(_Buffer + _Length, _Capacity - _Length + 1, format, retry_variadic_arguments);
+			}
+
+			_Length += formatted_length;
+		}
+
+		//vsnprintf might have written a partial string before failing, so make sure the terminator is where it should be.
+		_Buffer[_Length] = '\0';
+
+		va_end(retry_variadic_arguments);
+	}
+
+	/*
+	*	Clears the string, keeping it's memory around.
+	*/
+	FORCE_INLINE void Clear() NOEXCEPT
+	{
+		_Length = 0;
+		_Buffer[0] = '\0';
+	}
+
+	/*
+	*	Returns the underlying data.
+	*/
+	FORCE_INLINE RESTRICTED NO_DISCARD const char *const RESTRICT Data() const NOEXCEPT
+	{
+		return _Buffer;
+	}
+
+	/*
+	*	Returns the length of the string.
+	*/
+	FORCE_INLINE NO_DISCARD uint64 Length() const NOEXCEPT
+	{
+		return _Length;
+	}
+
+	/*
+	*	Copies the string into a dynamic string.
+	*/
+	FORCE_INLINE NO_DISCARD DynamicString ToDynamicString() const NOEXCEPT
+	{
+		return DynamicString(_Buffer, _Length);
+	}
+
+private:
+
+	//The buffer.
+	char *RESTRICT _Buffer;
+
+	//The length of the string.
+	uint64 _Length;
+
+	//The capacity of the buffer, not counting the null terminator.
+	uint64 _Capacity;
+
+	//Denotes whether or not this string builder has spilled over to the heap and owns it's buffer.
+	bool _OwnsBuffer;
+
+	/*
+	*	Reserves memory for at least the given number of characters, not counting the null terminator.
+	*/
+	FORCE_INLINE void Reserve(const uint64 capacity) NOEXCEPT
+	{
+		if (capacity <= _Capacity)
+		{
+			return;
+		}
+
+		const uint64 new_capacity{ capacity > _Capacity * 2 ? capacity : _Capacity * 2 };
+		char *const RESTRICT new_buffer{ static_cast<char *const RESTRICT>(Memory::Allocate(new_capacity + 1)) };
+
+		Memory::Copy(new_buffer, _Buffer, _Length + 1);
+
+		if (_OwnsBuffer)
+		{
+			Memory::Free(_Buffer);
+		}
+
+		_Buffer = new_buffer;
+		_Capacity = new_capacity;
+		_OwnsBuffer = true;
+	}
+
+};
\ No newline at end of file
@@ -21,6 +21,11 @@ public:
 	*/
 	BinaryOutputFile(const char *const RESTRICT file_path) NOEXCEPT;
 
+	/*
+	*	Bool operator overload. Returns if this file was opened and every write to it so far has succeeded.
+	*/
+	NO_DISCARD operator bool() const NOEXCEPT;
+
 	/*
 	*	Returns the file path.
 	*/
@@ -0,0 +1,123 @@
+#pragma once
+
+//Core.
+#include <Core/Essential/CatalystEssential.h>
+#include <Core/General/StaticString.h>
+#include <Core/General/Time.h>
+
+//Concurrency.
+#include <Concurrency/AtomicFlag.h>
+#include <Concurrency/Task.h>
+
+/*
+*	I/O request class definition.
+*	Describes a single read or write for the I/O system to carry out in the background.
+*	The request must stay alive, and must not be modified, from when it is submitted until it is completed.
+*/
+class IORequest final
+{
+
+public:
+
+	//Enumeration covering all types.
+	enum class Type : uint8
+	{
+		/*
+		*	Reads '_Size' bytes from '_Offset' in the file into '_Buffer'.
+		*/
+		READ,
+
+		/*
+		*	Writes '_Size' bytes from '_Buffer' to the file, replacing it.
+		*/
+		WRITE
+	};
+
+	//Enumeration covering all priorities.
+	enum class Priority : uint8
+	{
+		LOW,
+		NORMAL,
+		HIGH
+	};
+
+	//Type aliases.
+	using Callback = void(*)(IORequest *const RESTRICT request);
+
+	//Constant denoting that a read should read everything from the offset to the end of the file.
+	constexpr static uint64 WHOLE_FILE{ UINT64_MAXIMUM };
+
+	//The type.
+	Type _Type{ Type::READ };
+
+	//The priority.
+	Priority _Priority{ Priority::NORMAL };
+
+	//The file path.
+	StaticString<MAXIMUM_FILE_PATH_LENGTH> _FilePath;
+
+	//The offset into the file, in bytes. Only used for reads.
+	uint64 _Offset{ 0 };
+
+	//The size, in bytes.
+	uint64 _Size{ WHOLE_FILE };
+
+	/*
+	*	The buffer.
+	*	For reads, if this is nullptr, a buffer of the read size is allocated with Memory::Allocate(), and the caller takes ownership of it.
+	*/
+	void *RESTRICT _Buffer{ nullptr };
+
+	/*
+	*	The deadline, in seconds after the request was submitted. Zero means there's no deadline.
+	*	Requests that have missed their deadline are served before anything else, regardless of priority.
+	*/
+	float32 _Deadline{ 0.0f };
+
+	//The callback, called on the I/O thread when the request is completed. Optional.
+	Callback _Callback{ nullptr };
+
+	//The user data, for the callback to use as it sees fit.
+	void *RESTRICT _UserData{ nullptr };
+
+	//The continuation, handed to the task system when the request is completed. Optional.
+	Task *RESTRICT _Continuation{ nullptr };
+
+	//The number of bytes transferred.
+	uint64 _BytesTransferred{ 0 };
+
+	//Denotes whether or not the request succeeded.
+	bool _Succeeded{ false };
+
+	//The time point when the request was submitted.
+	TimePoint _SubmissionTime;
+
+	//Atomic flag denoting if this request is completed.
+	AtomicFlag _IsCompleted{ true };
+
+	/*
+	*	Returns if this request is completed.
+	*/
+	FORCE_INLINE NO_DISCARD bool IsCompleted() const NOEXCEPT
+	{
+		return _IsCompleted.IsSet();
+	}
+
+	/*
+	*	Waits for this request to be completed.
+	*/
+	template <WaitMode MODE>
+	FORCE_INLINE void Wait() const NOEXCEPT
+	{
+		_IsCompleted.Wait<MODE>();
+	}
+
+	/*
+	*	Returns the end of this request in the file, in bytes.
+	*/
+	FORCE_INLINE NO_DISCARD uint64 End() const NOEXCEPT
+	{
+		return _Offset + _Size;
+	}
+
+};
\ No newline at end of file
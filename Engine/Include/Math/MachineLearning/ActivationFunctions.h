@@ -6,6 +6,15 @@
 //Math.
 #include <Math/Core/BaseMath.h>
 
+//Enumeration covering all activation functions.
+enum class ActivationFunction : uint8
+{
+	LINEAR,
+	SIGMOID,
+	HYPERBOLIC_TANGENT,
+	RELU
+};
+
 namespace ActivationFunctions
 {
 
@@ -63,4 +72,92 @@ namespace ActivationFunctions
 		return BaseMath::Maximum<float32>(0.0f, X);
 	}
 
+	/*
+	*	Evaluates the given activation function.
+	*/
+	FORCE_INLINE NO_DISCARD float32 Evaluate(const ActivationFunction function, const float32 X) NOEXCEPT
+	{
+		switch (function)
+		{
+			case ActivationFunction::LINEAR:
+			{
+				return Linear(X);
+			}
+
+			case ActivationFunction::SIGMOID:
+			{
+				return Sigmoid(X);
+			}
+
+			case ActivationFunction::HYPERBOLIC_TANGENT:
+			{
+				return HyperbolicTangent(X);
+			}
+
+			case ActivationFunction::RELU:
+			{
+				return ReLU(X);
+			}
+
+			default:
+			{
+				ASSERT(false, "Invalid case!");
+
+				return X;
+			}
+		}
+	}
+
+	/*
+	*	Evaluates the given activation function for an array of values, in place.
+	*	Having the switch outside of the loop lets the compiler vectorize the cheap cases.
+	*/
+	FORCE_INLINE void Evaluate(const ActivationFunction function, float32 *const RESTRICT X, const uint64 length) NOEXCEPT
+	{
+		switch (function)
+		{
+			case ActivationFunction::LINEAR:
+			{
+				break;
+			}
+
+			case ActivationFunction::SIGMOID:
+			{
+				for (uint64 i{ 0 }; i < length; ++i)
+				{
+					X[i] = Sigmoid(X[i]);
+				}
+
+				break;
+			}
+
+			case ActivationFunction::HYPERBOLIC_TANGENT:
+			{
+				for (uint64 i{ 0 }; i < length; ++i)
+				{
+					X[i] = HyperbolicTangent(X[i]);
+				}
+
+				break;
+			}
+
+			case ActivationFunction::RELU:
+			{
+				for (uint64 i{ 0 }; i < length; ++i)
+				{
+					X[i] = ReLU(X[i]);
+				}
+
+				break;
+			}
+
+			default:
+			{
+				ASSERT(false, "Invalid case!");
+
+				break;
+			}
+		}
+	}
+
 }
\ No newline at end of file
@@ -12,124 +12,11 @@
 //Math.
 #include <Math/MachineLearning/ActivationFunctions.h>
 #include <Math/MachineLearning/NeuralNetwork.h>
-
-/*
-*	Class representing a single neuron.
-*/
-class Neuron final
-{
-
-public:
-
-	//The neuron index.
-	uint64 _NeuronIndex;
-
-	//The weights.
-	DynamicArray<float32> _Weights;
-
-	//The deltas.
-	DynamicArray<float32> _Deltas;
-
-	//The output value.
-	float32 _OutputValue;
-
-	//The gradient.
-	float32 _Gradient;
-
-	/*
-	*	Sets the number of outputs.
-	*/
-	FORCE_INLINE void SetNumberOfOutputs(const uint64 number_of_outputs) NOEXCEPT
-	{
-		//Initialize the weights.
-		_Weights.Upsize<false>(number_of_outputs);
-
-		for (float32 &weight : _Weights)
-		{
-			weight = 0.5f;
-		}
-
-		//Initialize the deltas.
-		_Deltas.Upsize<false>(number_of_outputs);
-
-		for (float32 &delta : _Deltas)
-		{
-			delta = 0.0f;
-		}
-	}
-
-	/*
-	*	Feeds forward.
-	*/
-	FORCE_INLINE void FeedForward(const DynamicArray<Neuron> &previous_layer_neurons, const NeuralNetworkActivationFunction activation_function) NOEXCEPT
-	{
-		//Calculate the sum.
-		float32 sum{ 0.0f };
-
-		for (const Neuron &neuron : previous_layer_neurons)
-		{
-			sum += neuron._OutputValue * neuron._Weights[_NeuronIndex];
-		}
-
-		//Calculate the output value.
-		_OutputValue = activation_function(sum);
-	}
-
-	/*
-	*	Calculates the output gradient.
-	*/
-	FORCE_INLINE void CalculateOutputGradient(const float32 target_value) NOEXCEPT
-	{
-		//Calculate the gradient.
-		_Gradient = (target_value - _OutputValue) * Derivative(_OutputValue);
-	}
-
-	/*
-	*	Calculates the hidden gradient.
-	*/
-	FORCE_INLINE void CalculateHiddenGradient(const DynamicArray<Neuron> &next_layer_neurons) NOEXCEPT
-	{
-		//Calculate the DOW.
-		float32 DOW{ 0.0f };
-
-		for (uint64 i{ 0 }, size{ next_layer_neurons.Size() }; i < size; ++i)
-		{
-			DOW += _Weights[i] * next_layer_neurons[i]._Gradient;
-		}
-
-		//Calculate the gradient.
-		_Gradient = DOW * Derivative(_OutputValue);
-	}
-
-	/*
-	*	Updates the input weights.
-	*/
-	FORCE_INLINE void UpdateInputWeights(const float32 learning_rate, const float32 momentum, DynamicArray<Neuron> &previous_layer_neurons) NOEXCEPT
-	{
-		for (uint64 i{ 0 }, size{ previous_layer_neurons.Size() }; i < size; ++i)
-		{
-			Neuron &neuron{ previous_layer_neurons[i] };
-
-			const float32 old_delta{ neuron._Deltas[_NeuronIndex] };
-			const float32 new_delta{ learning_rate * neuron._OutputValue * _Gradient + momentum * old_delta };
-
-			neuron._Deltas[_NeuronIndex] = new_delta;
-			neuron._Weights[_NeuronIndex] += new_delta;
-		}
-	}
-
-	/*
-	*	Calculates the derivative.
-	*/
-	FORCE_INLINE NO_DISCARD float32 Derivative(const float32 value) NOEXCEPT
-	{
-		return 1.0f - (value * value);
-	}
-
-};
+#include <Math/MachineLearning/NeuralNetworkKernels.h>
 
 /*
 *	Class representing a fully connected (or dense) neural network, with as many input/intermediate/output neurons as the user specifies.
+*	Each layer is stored as a contiguous weight matrix, and inference can be run on a whole batch of inputs at once.
 *	Can also load/save training data to disk, to be able to load this data in when needed.
 */
 class FullyConnectedNeuralNetwork final : public NeuralNetwork
@@ -138,7 +25,7 @@ class FullyConnectedNeuralNetwork final : public NeuralNetwork
 public:
 
 	//Constants.
-	constexpr static float32 BIAS_VALUE{ 1.0f };
+	constexpr static float32 INITIAL_WEIGHT{ 0.5f };
 
 	/*
 	*	Initialization parameters class definition.
@@ -167,10 +54,10 @@ public:
 		uint32 _NumberOfOutputs{ 1 };
 
 		//The hidden layers activation function.
-		NeuralNetworkActivationFunction _HiddenLayersActivationFunction{ ActivationFunctions::HyperbolicTangent };
+		NeuralNetworkActivationFunction _HiddenLayersActivationFunction{ NeuralNetworkActivationFunction::HYPERBOLIC_TANGENT };
 
 		//The output layer activation function.
-		NeuralNetworkActivationFunction _OutputLayerActivationFunction{ ActivationFunctions::HyperbolicTangent };
+		NeuralNetworkActivationFunction _OutputLayerActivationFunction{ NeuralNetworkActivationFunction::HYPERBOLIC_TANGENT };
 
 	};
 
@@ -185,59 +72,23 @@ public:
 		//Set the momentum.
 		_Momentum = parameters._Momentum;
 
-		//Add the input neurons.
-		for (uint32 i{ 0 }; i <= parameters._NumberOfInputs; ++i)
-		{
-			_InputLayer._Neurons.Emplace();
-			Neuron &neuron{ _InputLayer._Neurons.Back() };
+		//Add the layers. Each layer takes the outputs of the previous layer as inputs.
+		_Layers.Clear();
+		_Layers.Resize<true>(parameters._NumberOfHiddenLayers + 1);
 
-			neuron._NeuronIndex = _InputLayer._Neurons.LastIndex();
-		}
+		uint32 number_of_inputs{ parameters._NumberOfInputs };
 
-		//Add the hidden layers.
 		for (uint32 i{ 0 }; i < parameters._NumberOfHiddenLayers; ++i)
 		{
-			_HiddenLayers.Emplace();
-			Layer &hidden_layer{ _HiddenLayers.Back() };
+			_Layers[i].Initialize(number_of_inputs, parameters._NumberOfNeuronsPerHiddenLayer, parameters._HiddenLayersActivationFunction, INITIAL_WEIGHT);
 
-			for (uint32 j{ 0 }; j <= parameters._NumberOfNeuronsPerHiddenLayer; ++j)
-			{
-				hidden_layer._Neurons.Emplace();
-				Neuron &neuron{ hidden_layer._Neurons.Back() };
-
-				neuron._NeuronIndex = hidden_layer._Neurons.LastIndex();
-			}
+			number_of_inputs = parameters._NumberOfNeuronsPerHiddenLayer;
 		}
 
-		//Add the output neurons.
-		for (uint32 i{ 0 }; i < parameters._NumberOfOutputs; ++i)
-		{
-			_OutputLayer._Neurons.Emplace();
-			Neuron &neuron{ _OutputLayer._Neurons.Back() };
-
-			neuron._NeuronIndex = _OutputLayer._Neurons.LastIndex();
-		}
+		_Layers.Back().Initialize(number_of_inputs, parameters._NumberOfOutputs, parameters._OutputLayerActivationFunction, INITIAL_WEIGHT);
 
-		//Set the hidden layers activation function.
-		_HiddenLayersActivationFunction = parameters._HiddenLayersActivationFunction;
-
-		//Set the output layer activation function.
-		_OutputLayerActivationFunction = parameters._OutputLayerActivationFunction;
-
-		//Prepare the input layer.
-		for (Neuron &neuron : _InputLayer._Neurons)
-		{
-			neuron.SetNumberOfOutputs(_HiddenLayers.Empty() ? _OutputLayer._Neurons.Size() : _HiddenLayers[0]._Neurons.Size());
-		}
-
-		//Prepare the hidden layers.
-		for (uint64 i{ 0 }, size{ _HiddenLayers.Size() }; i < size; ++i)
-		{
-			for (Neuron &neuron : _HiddenLayers[i]._Neurons)
-			{
-				neuron.SetNumberOfOutputs(i == size - 1 ? _OutputLayer._Neurons.Size() : _HiddenLayers[i + 1]._Neurons.Size());
-			}
-		}
+		//Prepare the layer values for a single sample.
+		ReserveBatch(1);
 	}
 
 	/*
@@ -245,7 +96,7 @@ public:
 	*/
 	FORCE_INLINE NO_DISCARD uint32 GetNumberOfInputs() const NOEXCEPT override
 	{
-		return static_cast<uint32>(_InputLayer._Neurons.Size());
+		return _Layers[0]._NumberOfInputs;
 	}
 
 	/*
@@ -253,50 +104,48 @@ public:
 	*/
 	FORCE_INLINE NO_DISCARD uint32 GetNumberOfOutputs() const NOEXCEPT override
 	{
-		return static_cast<uint32>(_InputLayer._Neurons.Size());
+		return _Layers.Back()._NumberOfOutputs;
 	}
 
 	/*
-	*	Runs the neural network with the given input values.
+	*	Sets the precision of the weights used for inference.
+	*	Reduced precision weights are rebuilt from the float32 weights, so call this again after training/importing.
 	*/
-	FORCE_INLINE void Run(const ArrayProxy<float32> &input_values) NOEXCEPT override
+	FORCE_INLINE void SetPrecision(const NeuralNetworkKernels::Precision precision) NOEXCEPT
 	{
-		//Set the output value on all neurons in the input layer.
-		for (uint64 i{ 0 }, size{ _InputLayer._Neurons.Size() }; i < size; ++i)
+		for (NeuralNetworkKernels::DenseLayer &layer : _Layers)
 		{
-			_InputLayer._Neurons[i]._OutputValue = i < _InputLayer._Neurons.LastIndex() ? input_values[i] : BIAS_VALUE;
+			layer.SetPrecision(precision);
 		}
+	}
 
-		//Feed forward into all hidden layers.
-		for (uint64 layer_index{ 0 }, size{ _HiddenLayers.Size() }; layer_index < size; ++layer_index)
-		{
-			//Cache the previous layer neurons.
-			const DynamicArray<Neuron> &previous_layer_neurons{ layer_index == 0 ? _InputLayer._Neurons : _HiddenLayers[layer_index - 1]._Neurons };
+	/*
+	*	Runs the neural network with the given input values.
+	*/
+	FORCE_INLINE void Run(const ArrayProxy<float32> &input_values) NOEXCEPT override
+	{
+		ReserveBatch(1);
 
-			for (uint64 neuron_index{ 0 }; neuron_index < _HiddenLayers[layer_index]._Neurons.Size(); ++neuron_index)
-			{
-				if (neuron_index == _HiddenLayers[layer_index]._Neurons.LastIndex())
-				{
-					_HiddenLayers[layer_index]._Neurons[neuron_index]._OutputValue = BIAS_VALUE;
-				}
-				
-				else
-				{
-					_HiddenLayers[layer_index]._Neurons[neuron_index].FeedForward(previous_layer_neurons, _HiddenLayersActivationFunction);
-				}
-			}
-		}
+		Memory::Copy(_LayerValues[0].Data(), input_values.Data(), sizeof(float32) * GetNumberOfInputs());
 
-		//Feed forward into the output layer.
-		{
-			//Cache the previous layer neurons.
-			const DynamicArray<Neuron> &previous_layer_neurons{ _HiddenLayers.Empty() ? _InputLayer._Neurons : _HiddenLayers.Back()._Neurons };
+		Forward(1);
+	}
 
-			for (Neuron &neuron : _OutputLayer._Neurons)
-			{
-				neuron.FeedForward(previous_layer_neurons, _OutputLayerActivationFunction);
-			}
-		}
+	/*
+	*	Runs the neural network for a batch of samples at once, where the inputs are laid out as [batch_size x number_of_inputs]
+	*	and the outputs are written as [batch_size x number_of_outputs].
+	*	Much faster than calling Run() for each sample, since each weight is only loaded once per block of samples.
+	*	Note that this overwrites the state used by Correct(), so a batch run can't be followed by a Correct() call.
+	*/
+	FORCE_INLINE void RunBatch(const float32 *const RESTRICT inputs, const uint32 batch_size, float32 *const RESTRICT outputs) NOEXCEPT
+	{
+		ReserveBatch(batch_size);
+
+		Memory::Copy(_LayerValues[0].Data(), inputs, sizeof(float32) * GetNumberOfInputs() * batch_size);
+
+		Forward(batch_size);
+
+		Memory::Copy(outputs, _LayerValues.Back().Data(), sizeof(float32) * GetNumberOfOutputs() * batch_size);
 	}
 
 	/*
@@ -304,64 +153,47 @@ public:
 	*/
 	FORCE_INLINE void Correct(const ArrayProxy<float32> &expected_output_values) NOEXCEPT override
 	{
+		const DynamicArray<float32> &outputs{ _LayerValues.Back() };
+
 		//Calculate the error.
 		_Error = 0.0f;
 
-		for (uint64 i{ 0 }, size{ _OutputLayer._Neurons.Size() }; i < size; ++i)
+		for (uint32 i{ 0 }, size{ GetNumberOfOutputs() }; i < size; ++i)
 		{
-			const float32 delta{ expected_output_values[i] - _OutputLayer._Neurons[i]._OutputValue };
+			const float32 delta{ expected_output_values[i] - outputs[i] };
 
 			_Error += delta * delta;
 		}
 
-		_Error /= static_cast<float32>(_OutputLayer._Neurons.Size());
+		_Error /= static_cast<float32>(GetNumberOfOutputs());
 		_Error = sqrt(_Error);
 
-		//Calculate the output gradients for the output layer.
-		for (uint64 i{ 0 }, size{ _OutputLayer._Neurons.Size() }; i < size; ++i)
+		//Calculate the gradients for the output layer.
+		for (uint32 i{ 0 }, size{ GetNumberOfOutputs() }; i < size; ++i)
 		{
-			_OutputLayer._Neurons[i].CalculateOutputGradient(expected_output_values[i]);
+			_LayerGradients.Back()[i] = (expected_output_values[i] - outputs[i]) * Derivative(outputs[i]);
 		}
 
-		//Calculate the output gradients for the hidden layers.
-		if (!_HiddenLayers.Empty())
+		//Calculate the gradients for the hidden layers, by propagating the gradients backwards through the (not yet updated) weights.
+		for (int64 i{ static_cast<int64>(_Layers.LastIndex()) }; i > 0; --i)
 		{
-			for (int64 i{ static_cast<int64>(_HiddenLayers.LastIndex()) }; i >= 0; --i)
-			{
-				//Cache the next layer neurons.
-				const DynamicArray<Neuron> &next_layer_neurons{ i == _HiddenLayers.LastIndex() ? _OutputLayer._Neurons : _HiddenLayers[i + 1]._Neurons };
+			DynamicArray<float32> &gradients{ _LayerGradients[i - 1] };
+			const DynamicArray<float32> &values{ _LayerValues[i] };
 
-				for (Neuron &neuron : _HiddenLayers[i]._Neurons)
-				{
-					neuron.CalculateHiddenGradient(next_layer_neurons);
-				}
-			}
-		}
+			Memory::Set(gradients.Data(), 0, sizeof(float32) * _Layers[i]._NumberOfInputs);
 
-		//Update the input weights for the output layer.
-		{
-			//Cache the previous layer neurons.
-			DynamicArray<Neuron> &previous_layer_neurons{ _HiddenLayers.Empty() ? _InputLayer._Neurons : _HiddenLayers.Back()._Neurons };
+			_Layers[i].Backward(_LayerGradients[i].Data(), gradients.Data());
 
-			for (Neuron &neuron : _OutputLayer._Neurons)
+			for (uint32 j{ 0 }; j < _Layers[i]._NumberOfInputs; ++j)
 			{
-				neuron.UpdateInputWeights(_LearningRate, _Momentum, previous_layer_neurons);
+				gradients[j] *= Derivative(values[j]);
 			}
 		}
 
-		//Update the input weights for all hidden layers.
-		if (!_HiddenLayers.Empty())
+		//Update the weights for all layers.
+		for (uint64 i{ 0 }; i < _Layers.Size(); ++i)
 		{
-			for (int64 i{ static_cast<int64>(_HiddenLayers.LastIndex()) }; i >= 0; --i)
-			{
-				//Cache the previous layer neurons.
-				DynamicArray<Neuron> &previous_layer_neurons{ i == 0 ? _InputLayer._Neurons : _HiddenLayers[i - 1]._Neurons };
-
-				for (Neuron &neuron : _HiddenLayers[i]._Neurons)
-				{
-					neuron.UpdateInputWeights(_LearningRate, _Momentum, previous_layer_neurons);
-				}
-			}
+			_Layers[i].UpdateWeights(_LayerValues[i].Data(), _LayerGradients[i].Data(), _LearningRate, _Momentum);
 		}
 	}
 
@@ -373,43 +205,40 @@ public:
 		//Retrieve the output values.
 		for (uint64 i{ 0 }, size{ outputs->Size() }; i < size; ++i)
 		{
-			outputs->At(i) = _OutputLayer._Neurons[i]._OutputValue;
+			outputs->At(i) = _LayerValues.Back()[i];
 		}
 	}
 
 	/*
 	*	Exports the training data to the given file path.
+	*	The file layout is kept compatible with the previous per-neuron layout;
+	*	For each layer, for each input neuron (with the bias neuron last), the weights to each output neuron.
+	*	Hidden layers used to have a bias neuron that had incoming weights that were never used, those are written as the initial weight.
 	*/
 	FORCE_INLINE void ExportTrainingData(const char *const RESTRICT file_path) NOEXCEPT
 	{
 		//Open the output file.
 		BinaryOutputFile output_file{ file_path };
 
-		//Write all weights for all neurons.
-		for (const Neuron &neuron : _InputLayer._Neurons)
+		//Write all weights for all layers.
+		for (uint64 layer_index{ 0 }; layer_index < _Layers.Size(); ++layer_index)
 		{
-			for (const float32 weight : neuron._Weights)
-			{
-				output_file.Write(&weight, sizeof(float32));
-			}
-		}
+			NeuralNetworkKernels::DenseLayer &layer{ _Layers[layer_index] };
+			const bool has_unused_bias_weight{ layer_index < _Layers.LastIndex() };
 
-		for (const Layer &hidden_layer : _HiddenLayers)
-		{
-			for (const Neuron &neuron : hidden_layer._Neurons)
+			for (uint32 input_index{ 0 }; input_index <= layer._NumberOfInputs; ++input_index)
 			{
-				for (const float32 weight : neuron._Weights)
+				for (uint32 output_index{ 0 }; output_index < layer._NumberOfOutputs; ++output_index)
 				{
+					const float32 weight{ input_index < layer._NumberOfInputs ? layer.Weight(output_index, input_index) : layer._Biases[output_index] };
+
 					output_file.Write(&weight, sizeof(float32));
 				}
-			}
-		}
 
-		for (const Neuron &neuron : _OutputLayer._Neurons)
-		{
-			for (const float32 weight : neuron._Weights)
-			{
-				output_file.Write(&weight, sizeof(float32));
+				if (has_unused_bias_weight)
+				{
+					output_file.Write(&INITIAL_WEIGHT, sizeof(float32));
+				}
 			}
 		}
 
@@ -425,41 +254,39 @@ public:
 		//Open the input file.
 		BinaryInputFile input_file{ file_path };
 
-		//Write all weights for all neurons.
-		for (Neuron &neuron : _InputLayer._Neurons)
+		//Read all weights for all layers.
+		for (uint64 layer_index{ 0 }; layer_index < _Layers.Size(); ++layer_index)
 		{
-			for (float32 &weight : neuron._Weights)
-			{
-				float32 imported_weight{ 0.0f };
-				input_file.Read(&imported_weight, sizeof(float32));
+			NeuralNetworkKernels::DenseLayer &layer{ _Layers[layer_index] };
+			const bool has_unused_bias_weight{ layer_index < _Layers.LastIndex() };
 
-				weight = imported_weight;
-			}
-		}
-
-		for (Layer &hidden_layer : _HiddenLayers)
-		{
-			for (Neuron &neuron : hidden_layer._Neurons)
+			for (uint32 input_index{ 0 }; input_index <= layer._NumberOfInputs; ++input_index)
 			{
-				for (float32 &weight : neuron._Weights)
+				for (uint32 output_index{ 0 }; output_index < layer._NumberOfOutputs; ++output_index)
 				{
 					float32 imported_weight{ 0.0f };
 					input_file.Read(&imported_weight, sizeof(float32));
 
-					weight = imported_weight;
-				}
-			}
-		}
+					if (input_index < layer._NumberOfInputs)
+					{
+						layer.Weight(output_index, input_index) = imported_weight;
+					}
 
-		for (Neuron &neuron : _OutputLayer._Neurons)
-		{
-			for (float32 &weight : neuron._Weights)
-			{
-				float32 imported_weight{ 0.0f };
-				input_file.Read(&imported_weight, sizeof(float32));
+					else
+					{
+						layer._Biases[output_index] = imported_weight;
+					}
+				}
 
-				weight = imported_weight;
+				if (has_unused_bias_weight)
+				{
+					float32 unused_weight{ 0.0f };
+					input_file.Read(&unused_weight, sizeof(float32));
+				}
 			}
+
+			//Rebuild the reduced precision weights, if any.
+			layer.SetPrecision(layer._Precision);
 		}
 
 		//Close the input file.
@@ -468,41 +295,68 @@ public:
 
 private:
 
-	/*
-	*	Layer class definition.
-	*/
-	class Layer final
-	{
-
-	public:
-
-		//The neurons.
-		DynamicArray<Neuron> _Neurons;
-
-	};
-
 	//The learning rate.
 	float32 _LearningRate{ 0.5f };
 
 	//The momentum.
 	float32 _Momentum{ 0.5f };
 
-	//The input layer.
-	Layer _InputLayer;
+	//The layers.
+	DynamicArray<NeuralNetworkKernels::DenseLayer> _Layers;
 
-	//The hidden layers.
-	DynamicArray<Layer> _HiddenLayers;
+	//The values flowing between layers, [number_of_layers + 1][batch_size x layer width]. The first entry is the inputs.
+	DynamicArray<DynamicArray<float32>> _LayerValues;
 
-	//The output layer.
-	Layer _OutputLayer;
+	//The gradients for each layer's outputs.
+	DynamicArray<DynamicArray<float32>> _LayerGradients;
+
+	//The batch size the layer values are currently allocated for.
+	uint32 _BatchCapacity{ 0 };
 
 	//The error.
 	float32 _Error;
 
-	//The hidden layers activation function.
-	NeuralNetworkActivationFunction _HiddenLayersActivationFunction{ ActivationFunctions::HyperbolicTangent };
+	/*
+	*	Makes sure the layer values can hold the given batch size.
+	*/
+	FORCE_INLINE void ReserveBatch(const uint32 batch_size) NOEXCEPT
+	{
+		if (_LayerValues.Size() == _Layers.Size() + 1 && _BatchCapacity >= batch_size)
+		{
+			return;
+		}
+
+		_BatchCapacity = BaseMath::Maximum<uint32>(_BatchCapacity, batch_size);
+
+		_LayerValues.Resize<true>(_Layers.Size() + 1);
+		_LayerGradients.Resize<true>(_Layers.Size());
+
+		_LayerValues[0].Resize<false>(static_cast<uint64>(_Layers[0]._NumberOfInputs) * _BatchCapacity);
+
+		for (uint64 i{ 0 }; i < _Layers.Size(); ++i)
+		{
+			_LayerValues[i + 1].Resize<false>(static_cast<uint64>(_Layers[i]._NumberOfOutputs) * _BatchCapacity);
+			_LayerGradients[i].Resize<false>(_Layers[i]._NumberOfOutputs);
+		}
+	}
+
+	/*
+	*	Feeds the current inputs forward through all layers.
+	*/
+	FORCE_INLINE void Forward(const uint32 batch_size) NOEXCEPT
+	{
+		for (uint64 i{ 0 }; i < _Layers.Size(); ++i)
+		{
+			_Layers[i].Forward(_LayerValues[i].Data(), batch_size, _LayerValues[i + 1].Data());
+		}
+	}
 
-	//The output layer activation function.
-	NeuralNetworkActivationFunction _OutputLayerActivationFunction{ ActivationFunctions::HyperbolicTangent };
+	/*
+	*	Calculates the derivative.
+	*/
+	FORCE_INLINE NO_DISCARD float32 Derivative(const float32 value) NOEXCEPT
+	{
+		return 1.0f - (value * value);
+	}
 
 };
\ No newline at end of file
@@ -8,11 +8,14 @@
 //Math.
 #include <Math/MachineLearning/ActivationFunctions.h>
 #include <Math/MachineLearning/NeuralNetwork.h>
+#include <Math/MachineLearning/NeuralNetworkKernels.h>
 
 #define LSTM_USE_FINAL_LAYER (0)
 
 /*
 *	Class representing a long shot term memory.
+*	The weights for all four gates are stored in one contiguous [4 * hidden_size x (number_of_inputs + hidden_size)] matrix,
+*	so that all gates are calculated with a single matrix multiply over the concatenated input and previous hidden state.
 */
 class LongShortTermMemoryNeuralNetwork final : public NeuralNetwork
 {
@@ -55,152 +58,61 @@ public:
 		//Set the momentum.
 		_Momentum = parameters._Momentum;
 
+		//Set the sizes.
+		_NumberOfInputs = parameters._NumberOfInputs;
+		_HiddenSize = parameters._HiddenSize;
+
 		//Set the initial cell states.
-		_PreviousCellStates.Upsize<false>(parameters._HiddenSize);
-		_CurrentCellStates.Upsize<false>(parameters._HiddenSize);
-		
-		for (uint32 i{ 0 }; i < parameters._HiddenSize; ++i)
+		_PreviousCellStates.Resize<false>(_HiddenSize);
+		_CurrentCellStates.Resize<false>(_HiddenSize);
+
+		for (uint32 i{ 0 }; i < _HiddenSize; ++i)
 		{
 			_PreviousCellStates[i] = _CurrentCellStates[i] = 0.0f;
 		}
 
 		//Set the initial hidden states.
-		_PreviousHiddenStates.Upsize<false>(parameters._HiddenSize);
-		_CurrentHiddenStates.Upsize<false>(parameters._HiddenSize);
+		_PreviousHiddenStates.Resize<false>(_HiddenSize);
+		_CurrentHiddenStates.Resize<false>(_HiddenSize);
 
-		for (uint32 i{ 0 }; i < parameters._HiddenSize; ++i)
+		for (uint32 i{ 0 }; i < _HiddenSize; ++i)
 		{
 			_PreviousHiddenStates[i] = _CurrentHiddenStates[i] = 0.0f;
 		}
 
-		//Initialize the input samples.
-		_InputSamples.Upsize<false>(parameters._NumberOfInputs);
-
-		//Initialize the forget input weights.
-		_ForgetInputWeights.Upsize<true>(parameters._HiddenSize);
-
-		for (DynamicArray<float32> &weights : _ForgetInputWeights)
-		{
-			weights.Upsize<false>(parameters._NumberOfInputs);
-
-			for (float32 &value : weights)
-			{
-				value = 0.0f;
-			}
-		}
-
-		//Initialize the forget hidden weights.
-		_ForgetHiddenWeights.Upsize<true>(parameters._HiddenSize);
-
-		for (DynamicArray<float32> &weights : _ForgetHiddenWeights)
-		{
-			weights.Upsize<false>(parameters._HiddenSize);
-
-			for (float32 &value : weights)
-			{
-				value = 0.0f;
-			}
-		}
-
-		//Initialize the input input weights.
-		_InputInputWeights.Upsize<true>(parameters._HiddenSize);
-
-		for (DynamicArray<float32> &weights : _InputInputWeights)
-		{
-			weights.Upsize<false>(parameters._NumberOfInputs);
-
-			for (float32 &value : weights)
-			{
-				value = 0.0f;
-			}
-		}
+		//Initialize the input samples, which is the concatenation of the inputs and the previous hidden states.
+		_InputSamples.Resize<false>(GetNumberOfColumns());
 
-		//Initialize the input hidden weights.
-		_InputHiddenWeights.Upsize<true>(parameters._HiddenSize);
+		//Initialize the gate weights.
+		_GateWeights.Resize<false>(static_cast<uint64>(Gate::NUMBER_OF_GATES) * _HiddenSize * GetNumberOfColumns());
 
-		for (DynamicArray<float32> &weights : _InputHiddenWeights)
+		for (float32 &value : _GateWeights)
 		{
-			weights.Upsize<false>(parameters._HiddenSize);
-
-			for (float32 &value : weights)
-			{
-				value = 0.0f;
-			}
-		}
-
-		//Initialize the candidate input weights.
-		_CandidateInputWeights.Upsize<true>(parameters._HiddenSize);
-
-		for (DynamicArray<float32> &weights : _CandidateInputWeights)
-		{
-			weights.Upsize<false>(parameters._NumberOfInputs);
-
-			for (float32 &value : weights)
-			{
-				value = 0.0f;
-			}
-		}
-
-		//Initialize the candidate hidden weights.
-		_CandidateHiddenWeights.Upsize<true>(parameters._HiddenSize);
-
-		for (DynamicArray<float32> &weights : _CandidateHiddenWeights)
-		{
-			weights.Upsize<false>(parameters._HiddenSize);
-
-			for (float32 &value : weights)
-			{
-				value = 0.0f;
-			}
-		}
-
-		//Initialize the output input weights.
-		_OutputInputWeights.Upsize<true>(parameters._HiddenSize);
-
-		for (DynamicArray<float32> &weights : _OutputInputWeights)
-		{
-			weights.Upsize<false>(parameters._NumberOfInputs);
-
-			for (float32 &value : weights)
-			{
-				value = 0.0f;
-			}
+			value = 0.0f;
 		}
 
-		//Initialize the output hidden weights.
-		_OutputHiddenWeights.Upsize<true>(parameters._HiddenSize);
+		//Initialize the gate biases. These are always zero, but the kernels expect a bias vector.
+		_GateBiases.Resize<false>(static_cast<uint64>(Gate::NUMBER_OF_GATES) * _HiddenSize);
 
-		for (DynamicArray<float32> &weights : _OutputHiddenWeights)
+		for (float32 &value : _GateBiases)
 		{
-			weights.Upsize<false>(parameters._HiddenSize);
-
-			for (float32 &value : weights)
-			{
-				value = 0.0f;
-			}
+			value = 0.0f;
 		}
 
 #if LSTM_USE_FINAL_LAYER
 		//Initialize the final weights.
-		_FinalWeights.Upsize<true>(parameters._NumberOfOutputs);
+		_NumberOfOutputs = parameters._NumberOfOutputs;
+		_FinalWeights.Resize<false>(static_cast<uint64>(_NumberOfOutputs) * _HiddenSize);
 
-		for (DynamicArray<float32> &weights : _FinalWeights)
+		for (float32 &value : _FinalWeights)
 		{
-			weights.Upsize<false>(parameters._HiddenSize);
-
-			for (float32 &value : weights)
-			{
-				value = 0.0f;
-			}
+			value = 0.0f;
 		}
 #endif
 
 		//Initialize the values.
-		_ForgetValues.Upsize<false>(parameters._HiddenSize);
-		_InputValues.Upsize<false>(parameters._HiddenSize);
-		_CandidateValues.Upsize<false>(parameters._HiddenSize);
-		_OutputValues.Upsize<false>(parameters._HiddenSize);
-		_DeltaValues.Upsize<false>(parameters._HiddenSize);
+		_GateValues.Resize<false>(static_cast<uint64>(Gate::NUMBER_OF_GATES) * _HiddenSize);
+		_DeltaValues.Resize<false>(_HiddenSize);
 
 		for (float32 &value : _DeltaValues)
 		{
@@ -209,8 +121,8 @@ public:
 
 #if LSTM_USE_FINAL_LAYER
 		//Initialize the final stuff.
-		_FinalOutputs.Upsize<false>(parameters._NumberOfOutputs);
-		_FinalGradients.Upsize<false>(parameters._NumberOfOutputs);
+		_FinalOutputs.Resize<false>(_NumberOfOutputs);
+		_FinalGradients.Resize<false>(_NumberOfOutputs);
 #endif
 	}
 
@@ -219,7 +131,7 @@ public:
 	*/
 	FORCE_INLINE NO_DISCARD uint32 GetNumberOfInputs() const NOEXCEPT override
 	{
-		return static_cast<uint32>(_ForgetInputWeights.Size());
+		return _NumberOfInputs;
 	}
 
 	/*
@@ -227,7 +139,7 @@ public:
 	*/
 	FORCE_INLINE NO_DISCARD uint32 GetNumberOfOutputs() const NOEXCEPT override
 	{
-		return static_cast<uint32>(_ForgetHiddenWeights.Size());
+		return _HiddenSize;
 	}
 
 	/*
@@ -236,118 +148,67 @@ public:
 	FORCE_INLINE void Run(const ArrayProxy<float32> &input_values) NOEXCEPT override
 	{
 		//Set the previous cell/hidden states.
-		for (uint64 i{ 0 }; i < _PreviousCellStates.Size(); ++i)
-		{
-			_PreviousCellStates[i] = _CurrentCellStates[i];
-		}
-
-		for (uint64 i{ 0 }; i < _PreviousHiddenStates.Size(); ++i)
-		{
-			_PreviousHiddenStates[i] = _CurrentHiddenStates[i];
-		}
+		Memory::Copy(_PreviousCellStates.Data(), _CurrentCellStates.Data(), sizeof(float32) * _HiddenSize);
+		Memory::Copy(_PreviousHiddenStates.Data(), _CurrentHiddenStates.Data(), sizeof(float32) * _HiddenSize);
 
 		//Set the input samples.
-		for (uint64 i{ 0 }; i < _InputSamples.Size(); ++i)
-		{
-			_InputSamples[i] = input_values[i];
-		}
-
-		//Calculate the forget value.
-		for (uint64 i{ 0 }; i < _ForgetValues.Size(); ++i)
-		{
-			float32 sum{ 0.0f };
+		Memory::Copy(_InputSamples.Data(), input_values.Data(), sizeof(float32) * _NumberOfInputs);
+		Memory::Copy(&_InputSamples[_NumberOfInputs], _PreviousHiddenStates.Data(), sizeof(float32) * _HiddenSize);
 
-			for (uint64 j{ 0 }; j < _ForgetInputWeights[i].Size(); ++j)
-			{
-				sum += _ForgetInputWeights[i][j] * _InputSamples[j];
-			}
-
-			for (uint64 j{ 0 }; j < _ForgetHiddenWeights[i].Size(); ++j)
-			{
-				sum += _ForgetHiddenWeights[i][j] * _PreviousHiddenStates[j];
-			}
+		//Calculate all gates.
+		CalculateGates(_InputSamples.Data(), 1, _GateValues.Data());
 
-			_ForgetValues[i] = ActivationFunctions::Sigmoid(sum);
-		}
+		//Update the states.
+		UpdateStates(_GateValues.Data(), _PreviousCellStates.Data(), _CurrentCellStates.Data(), _CurrentHiddenStates.Data());
 
-		//Calculate the input values.
-		for (uint64 i{ 0 }; i < _InputValues.Size(); ++i)
-		{
-			float32 sum{ 0.0f };
+#if LSTM_USE_FINAL_LAYER
+		//Calculate the final outputs. The final layer has no biases.
+		NeuralNetworkKernels::MatrixMultiply(_CurrentHiddenStates.Data(), _FinalWeights.Data(), nullptr, nullptr, 1, _HiddenSize, _NumberOfOutputs, ActivationFunction::LINEAR, _FinalOutputs.Data());
+#endif
+	}
 
-			for (uint64 j{ 0 }; j < _InputInputWeights[i].Size(); ++j)
-			{
-				sum += _InputInputWeights[i][j] * _InputSamples[j];
-			}
+	/*
+	*	Runs the neural network for a batch of independent sequences at once, for example one per agent.
+	*	Since each sequence has it's own state, the states are owned by the caller;
+	*	'inputs' is [batch_size x number_of_inputs].
+	*	'cell_states' and 'hidden_states' are [batch_size x hidden_size], read as the previous states and overwritten with the new states.
+	*	This doesn't touch the internal state used by Run()/Correct().
+	*/
+	FORCE_INLINE void RunBatch
+	(
+		const float32 *const RESTRICT inputs,
+		const uint32 batch_size,
+		float32 *const RESTRICT cell_states,
+		float32 *const RESTRICT hidden_states
+	) NOEXCEPT
+	{
+		const uint64 number_of_columns{ GetNumberOfColumns() };
+		const uint64 number_of_gate_values{ static_cast<uint64>(Gate::NUMBER_OF_GATES) * _HiddenSize };
 
-			for (uint64 j{ 0 }; j < _InputHiddenWeights[i].Size(); ++j)
-			{
-				sum += _InputHiddenWeights[i][j] * _PreviousHiddenStates[j];
-			}
+		//Concatenate the inputs and the previous hidden states for each sequence.
+		_BatchInputSamples.Resize<false>(number_of_columns * batch_size);
 
-			_InputValues[i] = ActivationFunctions::Sigmoid(sum);
-		}
-
-		//Calculate the candidate values.
-		for (uint64 i{ 0 }; i < _CandidateValues.Size(); ++i)
+		for (uint32 i{ 0 }; i < batch_size; ++i)
 		{
-			float32 sum{ 0.0f };
-
-			for (uint64 j{ 0 }; j < _CandidateInputWeights[i].Size(); ++j)
-			{
-				sum += _CandidateInputWeights[i][j] * _InputSamples[j];
-			}
-
-			for (uint64 j{ 0 }; j < _CandidateHiddenWeights[i].Size(); ++j)
-			{
-				sum += _CandidateHiddenWeights[i][j] * _PreviousHiddenStates[j];
-			}
-
-			_CandidateValues[i] = ActivationFunctions::HyperbolicTangent(sum);
+			Memory::Copy(&_BatchInputSamples[i * number_of_columns], &inputs[static_cast<uint64>(i) * _NumberOfInputs], sizeof(float32) * _NumberOfInputs);
+			Memory::Copy(&_BatchInputSamples[i * number_of_columns + _NumberOfInputs], &hidden_states[static_cast<uint64>(i) * _HiddenSize], sizeof(float32) * _HiddenSize);
 		}
 
-		//Calculate the output values.
-		for (uint64 i{ 0 }; i < _OutputValues.Size(); ++i)
-		{
-			float32 sum{ 0.0f };
+		//Calculate all gates for all sequences.
+		_BatchGateValues.Resize<false>(number_of_gate_values * batch_size);
 
-			for (uint64 j{ 0 }; j < _OutputInputWeights[i].Size(); ++j)
-			{
-				sum += _OutputInputWeights[i][j] * _InputSamples[j];
-			}
+		CalculateGates(_BatchInputSamples.Data(), batch_size, _BatchGateValues.Data());
 
-			for (uint64 j{ 0 }; j < _OutputHiddenWeights[i].Size(); ++j)
-			{
-				sum += _OutputHiddenWeights[i][j] * _PreviousHiddenStates[j];
-			}
-
-			_OutputValues[i] = ActivationFunctions::Sigmoid(sum);
-		}
-
-		//Update the current cell states.
-		for (uint64 i{ 0 }; i < _CurrentCellStates.Size(); ++i)
-		{
-			_CurrentCellStates[i] = (_PreviousCellStates[i] * _ForgetValues[i]) + (_InputValues[i] * _CandidateValues[i]);
-		}
-		
-		//Update the current hidden states.
-		for (uint64 i{ 0 }; i < _CurrentHiddenStates.Size(); ++i)
-		{
-			_CurrentHiddenStates[i] = _OutputValues[i] * ActivationFunctions::HyperbolicTangent(_PreviousCellStates[i]);
-		}
+		//Update the states. The previous cell states are needed while updating, so keep a copy around.
+		_BatchPreviousCellStates.Resize<false>(static_cast<uint64>(_HiddenSize) * batch_size);
+		Memory::Copy(_BatchPreviousCellStates.Data(), cell_states, sizeof(float32) * _HiddenSize * batch_size);
 
-#if LSTM_USE_FINAL_LAYER
-		//Calculate the final outputs.
-		for (uint64 i{ 0 }; i < _FinalOutputs.Size(); ++i)
+		for (uint32 i{ 0 }; i < batch_size; ++i)
 		{
-			_FinalOutputs[i] = 0.0f;
+			const uint64 state_offset{ static_cast<uint64>(i) * _HiddenSize };
 
-			for (uint64 j{ 0 }; j < _FinalWeights[i].Size(); ++j)
-			{
-				_FinalOutputs[i] += _CurrentHiddenStates[j] * _FinalWeights[i][j];
-			}
+			UpdateStates(&_BatchGateValues[i * number_of_gate_values], &_BatchPreviousCellStates[state_offset], &cell_states[state_offset], &hidden_states[state_offset]);
 		}
-#endif
 	}
 
 	/*
@@ -355,114 +216,75 @@ public:
 	*/
 	FORCE_INLINE void Correct(const ArrayProxy<float32> &expected_output_values) NOEXCEPT override
 	{
+		const float32 *const RESTRICT forget_values{ GateValues(Gate::FORGET) };
+		const float32 *const RESTRICT input_values{ GateValues(Gate::INPUT) };
+		const float32 *const RESTRICT candidate_values{ GateValues(Gate::CANDIDATE) };
+		const float32 *const RESTRICT output_values{ GateValues(Gate::OUTPUT) };
+
 #if LSTM_USE_FINAL_LAYER
 		//Calculate the final gradients.
-		for (uint64 i{ 0 }; i < _FinalGradients.Size(); ++i)
+		for (uint32 i{ 0 }; i < _NumberOfOutputs; ++i)
 		{
 			_FinalGradients[i] = (expected_output_values[i] - _FinalOutputs[i]) * Derivative(_FinalOutputs[i]);
-		
 		}
 
 		//Calculate the delta values.
-		for (uint64 i{ 0 }; i < _DeltaValues.Size(); ++i)
+		for (uint32 i{ 0 }; i < _HiddenSize; ++i)
 		{
-			for (uint64 j{ 0 }; j < _FinalGradients.Size(); ++j)
+			for (uint32 j{ 0 }; j < _NumberOfOutputs; ++j)
 			{
 				const float32 old_delta{ _DeltaValues[i] };
 				const float32 new_delta{ _LearningRate * _CurrentHiddenStates[i] * _FinalGradients[j] + _Momentum * old_delta };
 
 				_DeltaValues[i] = new_delta;
-				_FinalWeights[j][i] += new_delta;
+				_FinalWeights[static_cast<uint64>(j) * _HiddenSize + i] += new_delta;
 			}
 		}
 #else
-		for (uint64 i{ 0 }; i < _DeltaValues.Size(); ++i)
+		for (uint32 i{ 0 }; i < _HiddenSize; ++i)
 		{
 			_DeltaValues[i] = _LearningRate * (expected_output_values[i] - _CurrentHiddenStates[i]);
 		}
 #endif
 
-		//Update the output weights.
-		for (uint64 i{ 0 }; i < _OutputInputWeights.Size(); ++i)
+		/*
+		*	For every gate row, the gradient is a per-row factor times either the input samples (for the input columns),
+		*	or the previous hidden state of that row (for the hidden columns), so each row is updated with one multiply-add.
+		*/
+		for (uint32 i{ 0 }; i < _HiddenSize; ++i)
 		{
-			for (uint64 j{ 0 }; j < _OutputInputWeights[i].Size(); ++j)
-			{
-				const float32 gradient{ _DeltaValues[i] * ActivationFunctions::HyperbolicTangent(_CurrentCellStates[i]) * _OutputValues[i] * (1.0f - _OutputValues[i]) * _InputSamples[j] };
-				
-				_OutputInputWeights[i][j] += gradient;
-			}
-		}
+			const float32 cell_tanh{ ActivationFunctions::HyperbolicTangent(_CurrentCellStates[i]) };
+			const float32 cell_tanh_derivative{ 1.0f - (cell_tanh * cell_tanh) };
+			const float32 previous_hidden_state{ _PreviousHiddenStates[i] };
 
-		for (uint64 i{ 0 }; i < _OutputHiddenWeights.Size(); ++i)
-		{
-			for (uint64 j{ 0 }; j < _OutputHiddenWeights[i].Size(); ++j)
+			//Update the output weights. Note that the hidden weights are scaled by the delta of the column, not the row.
 			{
-				const float32 gradient{ _DeltaValues[j] * ActivationFunctions::HyperbolicTangent(_CurrentCellStates[i]) * _OutputValues[i] * (1.0f - _OutputValues[i]) * _PreviousHiddenStates[i] };
+				const float32 factor{ cell_tanh * output_values[i] * (1.0f - output_values[i]) };
+				float32 *const RESTRICT row{ GateRow(Gate::OUTPUT, i) };
 
-				_OutputHiddenWeights[i][j] += gradient;
+				NeuralNetworkKernels::MultiplyAdd(row, _InputSamples.Data(), _DeltaValues[i] * factor, _NumberOfInputs);
+				NeuralNetworkKernels::MultiplyAdd(&row[_NumberOfInputs], _DeltaValues.Data(), factor * previous_hidden_state, _HiddenSize);
 			}
-		}
-		
-		//Update the forget weights.
-		for (uint64 i{ 0 }; i < _ForgetInputWeights.Size(); ++i)
-		{
-			for (uint64 j{ 0 }; j < _ForgetInputWeights[i].Size(); ++j)
-			{
-				const float32 gradient{ _DeltaValues[i] * _OutputValues[i] * (1.0f - (ActivationFunctions::HyperbolicTangent(_CurrentCellStates[i]) * ActivationFunctions::HyperbolicTangent(_CurrentCellStates[i]))) * _PreviousCellStates[i] * _ForgetValues[i] * (1.0f - _ForgetValues[i]) * _InputSamples[j] };
-				
-				_ForgetInputWeights[i][j] += gradient;
-			}
-		}
 
-		for (uint64 i{ 0 }; i < _ForgetHiddenWeights.Size(); ++i)
-		{
-			for (uint64 j{ 0 }; j < _ForgetHiddenWeights[i].Size(); ++j)
+			//Update the forget weights.
 			{
-				const float32 gradient{ _DeltaValues[i] * _OutputValues[i] * (1.0f - (ActivationFunctions::HyperbolicTangent(_CurrentCellStates[i]) * ActivationFunctions::HyperbolicTangent(_CurrentCellStates[i]))) * _PreviousCellStates[i] * _ForgetValues[i] * (1.0f - _ForgetValues[i]) * _PreviousHiddenStates[i] };
+				const float32 factor{ _DeltaValues[i] * output_values[i] * cell_tanh_derivative * _PreviousCellStates[i] * forget_values[i] * (1.0f - forget_values[i]) };
 
-				_ForgetHiddenWeights[i][j] += gradient;
+				UpdateGateRow(GateRow(Gate::FORGET, i), factor, factor * previous_hidden_state);
 			}
-		}
-	
-		//Update the input weights.
-		for (uint64 i{ 0 }; i < _InputInputWeights.Size(); ++i)
-		{
-			for (uint64 j{ 0 }; j < _InputInputWeights[i].Size(); ++j)
-			{
-				const float32 gradient{ _DeltaValues[i] * _OutputValues[i] * (1.0f - (ActivationFunctions::HyperbolicTangent(_CurrentCellStates[i]) * ActivationFunctions::HyperbolicTangent(_CurrentCellStates[i]))) * _CandidateValues[i] * _InputValues[i] * (1.0f - _InputValues[i]) * _InputSamples[j] };
-				
-				_InputInputWeights[i][j] += gradient;
-			}
-		}
 
-		for (uint64 i{ 0 }; i < _InputHiddenWeights.Size(); ++i)
-		{
-			for (uint64 j{ 0 }; j < _InputHiddenWeights[i].Size(); ++j)
+			//Update the input weights.
 			{
-				const float32 gradient{ _DeltaValues[i] * _OutputValues[i] * (1.0f - (ActivationFunctions::HyperbolicTangent(_CurrentCellStates[i]) * ActivationFunctions::HyperbolicTangent(_CurrentCellStates[i]))) * _CandidateValues[i] * _InputValues[i] * (1.0f - _InputValues[i]) * _PreviousHiddenStates[i] };
-				
-				_InputHiddenWeights[i][j] += gradient;
-			}
-		}
+				const float32 factor{ _DeltaValues[i] * output_values[i] * cell_tanh_derivative * candidate_values[i] * input_values[i] * (1.0f - input_values[i]) };
 
-		//Update the candidate weights.
-		for (uint64 i{ 0 }; i < _CandidateInputWeights.Size(); ++i)
-		{
-			for (uint64 j{ 0 }; j < _CandidateInputWeights[i].Size(); ++j)
-			{
-				const float32 gradient{ _DeltaValues[i] * _OutputValues[i] * (1.0f - (ActivationFunctions::HyperbolicTangent(_CurrentCellStates[i]) * ActivationFunctions::HyperbolicTangent(_CurrentCellStates[i]))) * _InputValues[i] * (1.0f - (_CandidateValues[i] * _CandidateValues[i])) * _InputSamples[j] };
-				
-				_CandidateInputWeights[i][j] += gradient;
+				UpdateGateRow(GateRow(Gate::INPUT, i), factor, factor * previous_hidden_state);
 			}
-		}
 
-		for (uint64 i{ 0 }; i < _CandidateHiddenWeights.Size(); ++i)
-		{
-			for (uint64 j{ 0 }; j < _CandidateHiddenWeights[i].Size(); ++j)
+			//Update the candidate weights.
 			{
-				const float32 gradient{ _DeltaValues[i] * _OutputValues[i] * (1.0f - (ActivationFunctions::HyperbolicTangent(_CurrentCellStates[i]) * ActivationFunctions::HyperbolicTangent(_CurrentCellStates[i]))) * _InputValues[i] * (1.0f - (_CandidateValues[i] * _CandidateValues[i])) * _PreviousHiddenStates[i] };
-				
-				_CandidateHiddenWeights[i][j] += gradient;
+				const float32 factor{ _DeltaValues[i] * output_values[i] * cell_tanh_derivative * input_values[i] * (1.0f - (candidate_values[i] * candidate_values[i])) };
+
+				UpdateGateRow(GateRow(Gate::CANDIDATE, i), factor, factor * previous_hidden_state);
 			}
 		}
 	}
@@ -488,12 +310,34 @@ public:
 
 private:
 
+	//Enumeration covering all gates, in the order they are stored in the gate weights.
+	enum class Gate : uint8
+	{
+		FORGET,
+		INPUT,
+		CANDIDATE,
+		OUTPUT,
+
+		NUMBER_OF_GATES
+	};
+
 	//The learning rate.
 	float32 _LearningRate{ 0.01f };
 
 	//The momentum.
 	float32 _Momentum{ 0.01f };
 
+	//The number of inputs.
+	uint32 _NumberOfInputs{ 0 };
+
+	//The hidden size.
+	uint32 _HiddenSize{ 0 };
+
+#if LSTM_USE_FINAL_LAYER
+	//The number of outputs.
+	uint32 _NumberOfOutputs{ 0 };
+#endif
+
 	//The previous cell states.
 	DynamicArray<float32> _PreviousCellStates;
 
@@ -506,58 +350,132 @@ private:
 	//The current hidden states.
 	DynamicArray<float32> _CurrentHiddenStates;
 
-	//The input samples.
+	//The input samples, followed by the previous hidden states.
 	DynamicArray<float32> _InputSamples;
 
-	//The forget input weights.
-	DynamicArray<DynamicArray<float32>> _ForgetInputWeights;
+	//The gate weights, [NUMBER_OF_GATES * hidden_size x (number_of_inputs + hidden_size)].
+	DynamicArray<float32> _GateWeights;
 
-	//The forget hidden weights.
-	DynamicArray<DynamicArray<float32>> _ForgetHiddenWeights;
+	//The gate biases.
+	DynamicArray<float32> _GateBiases;
 
-	//The input input weights.
-	DynamicArray<DynamicArray<float32>> _InputInputWeights;
+	//The gate values, [NUMBER_OF_GATES * hidden_size].
+	DynamicArray<float32> _GateValues;
 
-	//The input hidden weights.
-	DynamicArray<DynamicArray<float32>> _InputHiddenWeights;
+#if LSTM_USE_FINAL_LAYER
+	//The final weights, [number_of_outputs x hidden_size].
+	DynamicArray<float32> _FinalWeights;
 
-	//The candidate input weights.
-	DynamicArray<DynamicArray<float32>> _CandidateInputWeights;
+	//The final outputs.
+	DynamicArray<float32> _FinalOutputs;
 
-	//The candidate hidden weights.
-	DynamicArray<DynamicArray<float32>> _CandidateHiddenWeights;
+	//The final gradients.
+	DynamicArray<float32> _FinalGradients;
+#endif
 
-	//The output input weights.
-	DynamicArray<DynamicArray<float32>> _OutputInputWeights;
+	//The delta values.
+	DynamicArray<float32> _DeltaValues;
 
-	//The output hidden weights.
-	DynamicArray<DynamicArray<float32>> _OutputHiddenWeights;
+	//The batch input samples, used by RunBatch().
+	DynamicArray<float32> _BatchInputSamples;
 
-	//The forget values.
-	DynamicArray<float32> _ForgetValues;
+	//The batch gate values, used by RunBatch().
+	DynamicArray<float32> _BatchGateValues;
 
-	//The input values.
-	DynamicArray<float32> _InputValues;
+	//The batch previous cell states, used by RunBatch().
+	DynamicArray<float32> _BatchPreviousCellStates;
 
-	//The candidate values.
-	DynamicArray<float32> _CandidateValues;
+	/*
+	*	Returns the number of columns in the gate weights.
+	*/
+	FORCE_INLINE NO_DISCARD uint64 GetNumberOfColumns() const NOEXCEPT
+	{
+		return static_cast<uint64>(_NumberOfInputs) + _HiddenSize;
+	}
 
-	//The output values.
-	DynamicArray<float32> _OutputValues;
+	/*
+	*	Returns the weight row for the given gate and hidden index.
+	*/
+	FORCE_INLINE NO_DISCARD float32 *const RESTRICT GateRow(const Gate gate, const uint32 index) NOEXCEPT
+	{
+		return &_GateWeights[(static_cast<uint64>(gate) * _HiddenSize + index) * GetNumberOfColumns()];
+	}
 
-#if LSTM_USE_FINAL_LAYER
-	//The final weights.
-	DynamicArray<DynamicArray<float32>> _FinalWeights;
+	/*
+	*	Returns the values for the given gate from the last Run().
+	*/
+	FORCE_INLINE NO_DISCARD const float32 *const RESTRICT GateValues(const Gate gate) const NOEXCEPT
+	{
+		return &_GateValues[static_cast<uint64>(gate) * _HiddenSize];
+	}
 
-	//The final outputs.
-	DynamicArray<float32> _FinalOutputs;
+	/*
+	*	Calculates the gate values for a batch of concatenated input samples.
+	*/
+	FORCE_INLINE void CalculateGates(const float32 *const RESTRICT input_samples, const uint32 batch_size, float32 *const RESTRICT gate_values) const NOEXCEPT
+	{
+		const uint64 number_of_gate_values{ static_cast<uint64>(Gate::NUMBER_OF_GATES) * _HiddenSize };
+
+		NeuralNetworkKernels::MatrixMultiply
+		(
+			input_samples,
+			_GateWeights.Data(),
+			nullptr,
+			_GateBiases.Data(),
+			batch_size,
+			GetNumberOfColumns(),
+			number_of_gate_values,
+			ActivationFunction::LINEAR,
+			gate_values
+		);
+
+		//Apply the activation functions for each gate.
+		for (uint32 i{ 0 }; i < batch_size; ++i)
+		{
+			float32 *const RESTRICT sample_gate_values{ &gate_values[i * number_of_gate_values] };
+
+			ActivationFunctions::Evaluate(ActivationFunction::SIGMOID, &sample_gate_values[static_cast<uint64>(Gate::FORGET) * _HiddenSize], _HiddenSize);
+			ActivationFunctions::Evaluate(ActivationFunction::SIGMOID, &sample_gate_values[static_cast<uint64>(Gate::INPUT) * _HiddenSize], _HiddenSize);
+			ActivationFunctions::Evaluate(ActivationFunction::HYPERBOLIC_TANGENT, &sample_gate_values[static_cast<uint64>(Gate::CANDIDATE) * _HiddenSize], _HiddenSize);
+			ActivationFunctions::Evaluate(ActivationFunction::SIGMOID, &sample_gate_values[static_cast<uint64>(Gate::OUTPUT) * _HiddenSize], _HiddenSize);
+		}
+	}
 
-	//The final gradients.
-	DynamicArray<float32> _FinalGradients;
-#endif
+	/*
+	*	Updates the cell/hidden states for one sequence from it's gate values.
+	*/
+	FORCE_INLINE void UpdateStates
+	(
+		const float32 *const RESTRICT gate_values,
+		const float32 *const RESTRICT previous_cell_states,
+		float32 *const RESTRICT current_cell_states,
+		float32 *const RESTRICT current_hidden_states
+	) const NOEXCEPT
+	{
+		const float32 *const RESTRICT forget_values{ &gate_values[static_cast<uint64>(Gate::FORGET) * _HiddenSize] };
+		const float32 *const RESTRICT input_values{ &gate_values[static_cast<uint64>(Gate::INPUT) * _HiddenSize] };
+		const float32 *const RESTRICT candidate_values{ &gate_values[static_cast<uint64>(Gate::CANDIDATE) * _HiddenSize] };
+		const float32 *const RESTRICT output_values{ &gate_values[static_cast<uint64>(Gate::OUTPUT) * _HiddenSize] };
 
-	//The delta values.
-	DynamicArray<float32> _DeltaValues;
+		for (uint32 i{ 0 }; i < _HiddenSize; ++i)
+		{
+			current_cell_states[i] = (previous_cell_states[i] * forget_values[i]) + (input_values[i] * candidate_values[i]);
+			current_hidden_states[i] = output_values[i] * ActivationFunctions::HyperbolicTangent(previous_cell_states[i]);
+		}
+	}
+
+	/*
+	*	Updates one gate row, where the input columns are scaled by the input samples and the hidden columns get a constant gradient.
+	*/
+	FORCE_INLINE void UpdateGateRow(float32 *const RESTRICT row, const float32 input_factor, const float32 hidden_gradient) NOEXCEPT
+	{
+		NeuralNetworkKernels::MultiplyAdd(row, _InputSamples.Data(), input_factor, _NumberOfInputs);
+
+		for (uint32 j{ 0 }; j < _HiddenSize; ++j)
+		{
+			row[_NumberOfInputs + j] += hidden_gradient;
+		}
+	}
 
 	/*
 	*	Calculates the derivative for the given value.
@@ -4,8 +4,11 @@
 #include <Core/Essential/CatalystEssential.h>
 #include <Core/Containers/ArrayProxy.h>
 
+//Math.
+#include <Math/MachineLearning/ActivationFunctions.h>
+
 //Type aliases.
-using NeuralNetworkActivationFunction = float32(*)(const float32 X);
+using NeuralNetworkActivationFunction = ActivationFunction;
 
 /*
 *	Base class for a neural network.
@@ -0,0 +1,803 @@
+#pragma once
+
+//Core.
+#include <Core/Essential/CatalystEssential.h>
+#include <Core/Containers/DynamicArray.h>
+#include <Core/General/SIMD.h>
+
+//Math.
+#include <Math/Core/BaseMath.h>
+#include <Math/MachineLearning/ActivationFunctions.h>
+
+/*
+*	This file contains the kernels shared by the neural networks, both for inference and for training.
+*	All matrices are stored contiguously in row-major order, with one row per output and one column per input.
+*	Like the functions in SIMD.h, the kernels dynamically pick the AVX2 or SSE2 path.
+*/
+namespace NeuralNetworkKernels
+{
+
+	//Enumeration covering all weight precisions.
+	enum class Precision : uint8
+	{
+		FLOAT32,
+		FLOAT16,
+		INT8
+	};
+
+	//The number of batch rows processed together in the matrix multiply, so that each weight row is loaded once per block.
+	constexpr uint64 BATCH_BLOCK_SIZE{ 4 };
+
+	/*
+	*	Converts a float32 to a IEEE 754 half precision float, with round-to-nearest-even.
+	*	Note that this differs from the Float16 class, which doesn't use the IEEE bit layout, so that the weights can be converted by the hardware.
+	*/
+	FORCE_INLINE NO_DISCARD uint16 Float32ToFloat16(const float32 value) NOEXCEPT
+	{
+		uint32 bits;
+		Memory::Copy(&bits, &value, sizeof(uint32));
+
+		const uint32 sign{ (bits >> 16) & 0x8000 };
+		const int32 exponent{ static_cast<int32>((bits >> 23) & 0xff) - 127 + 15 };
+		uint32 mantissa{ bits & 0x007fffff };
+
+		//NaN/infinity.
+		if (((bits >> 23) & 0xff) == 0xff)
+		{
+			return static_cast<uint16>(sign | 0x7c00 | (mantissa ? 0x200 : 0));
+		}
+
+		//Overflow, clamp to infinity.
+		if (exponent >= 31)
+		{
+			return static_cast<uint16>(sign | 0x7c00);
+		}
+
+		//Underflow, produce a denormal or zero.
+		if (exponent <= 0)
+		{
+			if (exponent < -10)
+			{
+				return static_cast<uint16>(sign);
+			}
+
+			mantissa |= 0x00800000;
+
+			const uint32 shift{ static_cast<uint32>(14 - exponent) };
+			uint32 half_mantissa{ mantissa >> shift };
+			const uint32 remainder{ mantissa & ((1u << shift) - 1) };
+			const uint32 halfway{ 1u << (shift - 1) };
+
+			if (remainder > halfway || (remainder == halfway && (half_mantissa & 1)))
+			{
+				++half_mantissa;
+			}
+
+			return static_cast<uint16>(sign | half_mantissa);
+		}
+
+		uint32 half{ sign | (static_cast<uint32>(exponent) << 10) | (mantissa >> 13) };
+		const uint32 remainder{ mantissa & 0x1fff };
+
+		//Rounding might carry into the exponent, which correctly rounds up to the next power of two or infinity.
+		if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1)))
+		{
+			++half;
+		}
+
+		return static_cast<uint16>(half);
+	}
+
+	/*
+	*	Converts a IEEE 754 half precision float to a float32.
+	*/
+	FORCE_INLINE NO_DISCARD float32 Float16ToFloat32(const uint16 value) NOEXCEPT
+	{
+		const uint32 sign{ static_cast<uint32>(value & 0x8000) << 16 };
+		uint32 exponent{ static_cast<uint32>(value >> 10) & 0x1f };
+		uint32 mantissa{ static_cast<uint32>(value) & 0x03ff };
+		uint32 bits;
+
+		if (exponent == 0)
+		{
+			if (mantissa == 0)
+			{
+				bits = sign;
+			}
+
+			else
+			{
+				//Normalize the denormal.
+				exponent = 127 - 15 + 1;
+
+				while ((mantissa & 0x0400) == 0)
+				{
+					mantissa <<= 1;
+					--exponent;
+				}
+
+				mantissa &= 0x03ff;
+				bits = sign | (exponent << 23) | (mantissa << 13);
+			}
+		}
+
+		else if (exponent == 31)
+		{
+			bits = sign | 0x7f800000 | (mantissa << 13);
+		}
+
+		else
+		{
+			bits = sign | ((exponent - 15 + 127) << 23) | (mantissa << 13);
+		}
+
+		float32 result;
+		Memory::Copy(&result, &bits, sizeof(float32));
+
+		return result;
+	}
+
+	/*
+	*	Loads four weights as floats for the SSE2 path.
+	*/
+	FORCE_INLINE NO_DISCARD __m128 LoadWeights4(const float32 *const RESTRICT weights) NOEXCEPT
+	{
+		return _mm_loadu_ps(weights);
+	}
+
+	/*
+	*	Loads four weights as floats for the SSE2 path.
+	*/
+	FORCE_INLINE NO_DISCARD __m128 LoadWeights4(const uint16 *const RESTRICT weights) NOEXCEPT
+	{
+		return _mm_set_ps(Float16ToFloat32(weights[3]), Float16ToFloat32(weights[2]), Float16ToFloat32(weights[1]), Float16ToFloat32(weights[0]));
+	}
+
+	/*
+	*	Loads four weights as floats for the SSE2 path.
+	*/
+	FORCE_INLINE NO_DISCARD __m128 LoadWeights4(const int8 *const RESTRICT weights) NOEXCEPT
+	{
+		return _mm_cvtepi32_ps(_mm_set_epi32(weights[3], weights[2], weights[1], weights[0]));
+	}
+
+	/*
+	*	Loads eight weights as floats for the AVX2 path.
+	*/
+	FORCE_INLINE NO_DISCARD __m256 LoadWeights8(const float32 *const RESTRICT weights) NOEXCEPT
+	{
+		return _mm256_loadu_ps(weights);
+	}
+
+	/*
+	*	Loads eight weights as floats for the AVX2 path.
+	*	The AVX2 backend is only picked when F16C is supported, so the conversion is done in hardware.
+	*/
+	FORCE_INLINE NO_DISCARD __m256 LoadWeights8(const uint16 *const RESTRICT weights) NOEXCEPT
+	{
+		return _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i *const RESTRICT>(weights)));
+	}
+
+	/*
+	*	Loads eight weights as floats for the AVX2 path.
+	*/
+	FORCE_INLINE NO_DISCARD __m256 LoadWeights8(const int8 *const RESTRICT weights) NOEXCEPT
+	{
+		return _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *const RESTRICT>(weights))));
+	}
+
+	/*
+	*	Loads a single weight as a float for the tails.
+	*/
+	FORCE_INLINE NO_DISCARD float32 LoadWeight(const float32 weight) NOEXCEPT
+	{
+		return weight;
+	}
+
+	/*
+	*	Loads a single weight as a float for the tails.
+	*/
+	FORCE_INLINE NO_DISCARD float32 LoadWeight(const uint16 weight) NOEXCEPT
+	{
+		return Float16ToFloat32(weight);
+	}
+
+	/*
+	*	Loads a single weight as a float for the tails.
+	*/
+	FORCE_INLINE NO_DISCARD float32 LoadWeight(const int8 weight) NOEXCEPT
+	{
+		return static_cast<float32>(weight);
+	}
+
+	/*
+	*	Horizontally adds all lanes of the given register.
+	*/
+	FORCE_INLINE NO_DISCARD float32 HorizontalAdd(const __m128 value) NOEXCEPT
+	{
+		__m128 shuffled{ _mm_shuffle_ps(value, value, _MM_SHUFFLE(2, 3, 0, 1)) };
+		__m128 sums{ _mm_add_ps(value, shuffled) };
+		shuffled = _mm_movehl_ps(shuffled, sums);
+		sums = _mm_add_ss(sums, shuffled);
+
+		return _mm_cvtss_f32(sums);
+	}
+
+	/*
+	*	Horizontally adds all lanes of the given register.
+	*/
+	FORCE_INLINE NO_DISCARD float32 HorizontalAdd(const __m256 value) NOEXCEPT
+	{
+		return HorizontalAdd(_mm_add_ps(_mm256_castps256_ps128(value), _mm256_extractf128_ps(value, 1)));
+	}
+
+	/*
+	*	Computes the dot products of one weight row against a block of BATCH_BLOCK_SIZE input rows.
+	*/
+	template <typename WEIGHT_TYPE>
+	FORCE_INLINE void DotProductBlock
+	(
+		const WEIGHT_TYPE *const RESTRICT weights,
+		const float32 *const RESTRICT inputs,
+		const uint64 input_stride,
+		const uint64 length,
+		float32 *const RESTRICT results
+	) NOEXCEPT
+	{
+		const float32 *const RESTRICT input_0{ inputs };
+		const float32 *const RESTRICT input_1{ inputs + input_stride };
+		const float32 *const RESTRICT input_2{ inputs + input_stride * 2 };
+		const float32 *const RESTRICT input_3{ inputs + input_stride * 3 };
+
+		uint64 i{ 0 };
+
+		switch (SIMD::GetBackend())
+		{
+			case SIMD::Backend::SSE2:
+			{
+				__m128 accumulator_0{ _mm_setzero_ps() };
+				__m128 accumulator_1{ _mm_setzero_ps() };
+				__m128 accumulator_2{ _mm_setzero_ps() };
+				__m128 accumulator_3{ _mm_setzero_ps() };
+
+				for (; (i + 4) <= length; i += 4)
+				{
+					const __m128 weight{ LoadWeights4(&weights[i]) };
+
+					accumulator_0 = _mm_add_ps(accumulator_0, _mm_mul_ps(weight, _mm_loadu_ps(&input_0[i])));
+					accumulator_1 = _mm_add_ps(accumulator_1, _mm_mul_ps(weight, _mm_loadu_ps(&input_1[i])));
+					accumulator_2 = _mm_add_ps(accumulator_2, _mm_mul_ps(weight, _mm_loadu_ps(&input_2[i])));
+					accumulator_3 = _mm_add_ps(accumulator_3, _mm_mul_ps(weight, _mm_loadu_ps(&input_3[i])));
+				}
+
+				results[0] = HorizontalAdd(accumulator_0);
+				results[1] = HorizontalAdd(accumulator_1);
+				results[2] = HorizontalAdd(accumulator_2);
+				results[3] = HorizontalAdd(accumulator_3);
+
+				break;
+			}
+
+			case SIMD::Backend::AVX2:
+			{
+				__m256 accumulator_0{ _mm256_setzero_ps() };
+				__m256 accumulator_1{ _mm256_setzero_ps() };
+				__m256 accumulator_2{ _mm256_setzero_ps() };
+				__m256 accumulator_3{ _mm256_setzero_ps() };
+
+				for (; (i + 8) <= length; i += 8)
+				{
+					const __m256 weight{ LoadWeights8(&weights[i]) };
+
+					accumulator_0 = _mm256_fmadd_ps(weight, _mm256_loadu_ps(&input_0[i]), accumulator_0);
+					accumulator_1 = _mm256_fmadd_ps(weight, _mm256_loadu_ps(&input_1[i]), accumulator_1);
+					accumulator_2 = _mm256_fmadd_ps(weight, _mm256_loadu_ps(&input_2[i]), accumulator_2);
+					accumulator_3 = _mm256_fmadd_ps(weight, _mm256_loadu_ps(&input_3[i]), accumulator_3);
+				}
+
+				results[0] = HorizontalAdd(accumulator_0);
+				results[1] = HorizontalAdd(accumulator_1);
+				results[2] = HorizontalAdd(accumulator_2);
+				results[3] = HorizontalAdd(accumulator_3);
+
+				break;
+			}
+
+			default:
+			{
+				results[0] = results[1] = results[2] = results[3] = 0.0f;
+
+				break;
+			}
+		}
+
+		for (; i < length; ++i)
+		{
+			const float32 weight{ LoadWeight(weights[i]) };
+
+			results[0] += weight * input_0[i];
+			results[1] += weight * input_1[i];
+			results[2] += weight * input_2[i];
+			results[3] += weight * input_3[i];
+		}
+	}
+
+	/*
+	*	Computes the dot product of one weight row against a single input row.
+	*/
+	template <typename WEIGHT_TYPE>
+	FORCE_INLINE NO_DISCARD float32 DotProduct
+	(
+		const WEIGHT_TYPE *const RESTRICT weights,
+		const float32 *const RESTRICT inputs,
+		const uint64 length
+	) NOEXCEPT
+	{
+		float32 result{ 0.0f };
+		uint64 i{ 0 };
+
+		switch (SIMD::GetBackend())
+		{
+			case SIMD::Backend::SSE2:
+			{
+				__m128 accumulator{ _mm_setzero_ps() };
+
+				for (; (i + 4) <= length; i += 4)
+				{
+					accumulator = _mm_add_ps(accumulator, _mm_mul_ps(LoadWeights4(&weights[i]), _mm_loadu_ps(&inputs[i])));
+				}
+
+				result = HorizontalAdd(accumulator);
+
+				break;
+			}
+
+			case SIMD::Backend::AVX2:
+			{
+				__m256 accumulator{ _mm256_setzero_ps() };
+
+				for (; (i + 8) <= length; i += 8)
+				{
+					accumulator = _mm256_fmadd_ps(LoadWeights8(&weights[i]), _mm256_loadu_ps(&inputs[i]), accumulator);
+				}
+
+				result = HorizontalAdd(accumulator);
+
+				break;
+			}
+
+			default:
+			{
+				break;
+			}
+		}
+
+		for (; i < length; ++i)
+		{
+			result += LoadWeight(weights[i]) * inputs[i];
+		}
+
+		return result;
+	}
+
+	/*
+	*	Computes outputs = activation(inputs * transpose(weights) * scales + biases), where;
+	*	'inputs' is a [batch_size x number_of_inputs] matrix.
+	*	'weights' is a [number_of_outputs x number_of_inputs] matrix.
+	*	'scales' is an optional per-row dequantization scale, can be nullptr.
+	*	'biases' is an optional per-row bias, can be nullptr.
+	*	'outputs' is a [batch_size x number_of_outputs] matrix.
+	*
+	*	The batch is processed in blocks of BATCH_BLOCK_SIZE rows, and the weights in blocks of rows that fit in the L1 cache,
+	*	so that each weight is streamed from memory once per batch block rather than once per sample.
+	*/
+	template <typename WEIGHT_TYPE>
+	FORCE_INLINE void MatrixMultiply
+	(
+		const float32 *const RESTRICT inputs,
+		const WEIGHT_TYPE *const RESTRICT weights,
+		const float32 *const RESTRICT scales,
+		const float32 *const RESTRICT biases,
+		const uint64 batch_size,
+		const uint64 number_of_inputs,
+		const uint64 number_of_outputs,
+		const ActivationFunction activation_function,
+		float32 *const RESTRICT outputs
+	) NOEXCEPT
+	{
+		//Figure out how many weight rows fit in (roughly half of) a 32KB L1 cache.
+		const uint64 row_block_size{ BaseMath::Maximum<uint64>((16 * 1'024) / BaseMath::Maximum<uint64>(number_of_inputs * sizeof(WEIGHT_TYPE), 1), 1) };
+
+		for (uint64 row_start{ 0 }; row_start < number_of_outputs; row_start += row_block_size)
+		{
+			const uint64 row_end{ BaseMath::Minimum<uint64>(row_start + row_block_size, number_of_outputs) };
+
+			uint64 batch_index{ 0 };
+
+			for (; (batch_index + BATCH_BLOCK_SIZE) <= batch_size; batch_index += BATCH_BLOCK_SIZE)
+			{
+				const float32 *const RESTRICT input_block{ &inputs[batch_index * number_of_inputs] };
+				float32 *const RESTRICT output_block{ &outputs[batch_index * number_of_outputs] };
+
+				for (uint64 row{ row_start }; row < row_end; ++row)
+				{
+					float32 results[BATCH_BLOCK_SIZE];
+
+					DotProductBlock(&weights[row * number_of_inputs], input_block, number_of_inputs, number_of_inputs, results);
+
+					const float32 scale{ scales ? scales[row] : 1.0f };
+					const float32 bias{ biases ? biases[row] : 0.0f };
+
+					for (uint64 i{ 0 }; i < BATCH_BLOCK_SIZE; ++i)
+					{
+						output_block[i * number_of_outputs + row] = results[i] * scale + bias;
+					}
+				}
+			}
+
+			for (; batch_index < batch_size; ++batch_index)
+			{
+				const float32 *const RESTRICT input_row{ &inputs[batch_index * number_of_inputs] };
+				float32 *const RESTRICT output_row{ &outputs[batch_index * number_of_outputs] };
+
+				for (uint64 row{ row_start }; row < row_end; ++row)
+				{
+					const float32 scale{ scales ? scales[row] : 1.0f };
+					const float32 bias{ biases ? biases[row] : 0.0f };
+
+					output_row[row] = DotProduct(&weights[row * number_of_inputs], input_row, number_of_inputs) * scale + bias;
+				}
+			}
+		}
+
+		//Apply the activation function while the outputs are still hot in the cache.
+		ActivationFunctions::Evaluate(activation_function, outputs, batch_size * number_of_outputs);
+	}
+
+	/*
+	*	Computes Y += X * scalar.
+	*	Used for propagating gradients backwards through the transposed weight matrix, one row at a time.
+	*/
+	FORCE_INLINE void MultiplyAdd(float32 *const RESTRICT Y, const float32 *const RESTRICT X, const float32 scalar, const uint64 length) NOEXCEPT
+	{
+		uint64 i{ 0 };
+
+		switch (SIMD::GetBackend())
+		{
+			case SIMD::Backend::SSE2:
+			{
+				const __m128 _scalar{ _mm_set1_ps(scalar) };
+
+				for (; (i + 4) <= length; i += 4)
+				{
+					_mm_storeu_ps(&Y[i], _mm_add_ps(_mm_loadu_ps(&Y[i]), _mm_mul_ps(_mm_loadu_ps(&X[i]), _scalar)));
+				}
+
+				break;
+			}
+
+			case SIMD::Backend::AVX2:
+			{
+				const __m256 _scalar{ _mm256_set1_ps(scalar) };
+
+				for (; (i + 8) <= length; i += 8)
+				{
+					_mm256_storeu_ps(&Y[i], _mm256_fmadd_ps(_mm256_loadu_ps(&X[i]), _scalar, _mm256_loadu_ps(&Y[i])));
+				}
+
+				break;
+			}
+
+			default:
+			{
+				break;
+			}
+		}
+
+		for (; i < length; ++i)
+		{
+			Y[i] += X[i] * scalar;
+		}
+	}
+
+	/*
+	*	Updates one weight row with momentum;
+	*	deltas = inputs * (learning_rate * gradient) + deltas * momentum
+	*	weights += deltas
+	*/
+	FORCE_INLINE void UpdateWeights
+	(
+		float32 *const RESTRICT weights,
+		float32 *const RESTRICT deltas,
+		const float32 *const RESTRICT inputs,
+		const float32 learning_rate_gradient,
+		const float32 momentum,
+		const uint64 length
+	) NOEXCEPT
+	{
+		uint64 i{ 0 };
+
+		switch (SIMD::GetBackend())
+		{
+			case SIMD::Backend::SSE2:
+			{
+				const __m128 _learning_rate_gradient{ _mm_set1_ps(learning_rate_gradient) };
+				const __m128 _momentum{ _mm_set1_ps(momentum) };
+
+				for (; (i + 4) <= length; i += 4)
+				{
+					const __m128 delta{ _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&inputs[i]), _learning_rate_gradient), _mm_mul_ps(_mm_loadu_ps(&deltas[i]), _momentum)) };
+
+					_mm_storeu_ps(&deltas[i], delta);
+					_mm_storeu_ps(&weights[i], _mm_add_ps(_mm_loadu_ps(&weights[i]), delta));
+				}
+
+				break;
+			}
+
+			case SIMD::Backend::AVX2:
+			{
+				const __m256 _learning_rate_gradient{ _mm256_set1_ps(learning_rate_gradient) };
+				const __m256 _momentum{ _mm256_set1_ps(momentum) };
+
+				for (; (i + 8) <= length; i += 8)
+				{
+					const __m256 delta{ _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(&inputs[i]), _learning_rate_gradient), _mm256_mul_ps(_mm256_loadu_ps(&deltas[i]), _momentum)) };
+
+					_mm256_storeu_ps(&deltas[i], delta);
+					_mm256_storeu_ps(&weights[i], _mm256_add_ps(_mm256_loadu_ps(&weights[i]), delta));
+				}
+
+				break;
+			}
+
+			default:
+			{
+				break;
+			}
+		}
+
+		for (; i < length; ++i)
+		{
+			const float32 delta{ inputs[i] * learning_rate_gradient + deltas[i] * momentum };
+
+			deltas[i] = delta;
+			weights[i] += delta;
+		}
+	}
+
+	/*
+	*	Dense layer class definition.
+	*	Holds a contiguous row-major weight matrix, with optional reduced precision copies for inference.
+	*/
+	class DenseLayer final
+	{
+
+	public:
+
+		//The number of inputs.
+		uint32 _NumberOfInputs{ 0 };
+
+		//The number of outputs.
+		uint32 _NumberOfOutputs{ 0 };
+
+		//The activation function.
+		ActivationFunction _ActivationFunction{ ActivationFunction::HYPERBOLIC_TANGENT };
+
+		//The precision used for inference.
+		Precision _Precision{ Precision::FLOAT32 };
+
+		//The weights, [number_of_outputs x number_of_inputs].
+		DynamicArray<float32> _Weights;
+
+		//The biases, one per output.
+		DynamicArray<float32> _Biases;
+
+		//The weight deltas, used for momentum during training.
+		DynamicArray<float32> _WeightDeltas;
+
+		//The bias deltas, used for momentum during training.
+		DynamicArray<float32> _BiasDeltas;
+
+		//The half precision weights.
+		DynamicArray<uint16> _HalfWeights;
+
+		//The quantized weights.
+		DynamicArray<int8> _QuantizedWeights;
+
+		//The quantization scales, one per output.
+		DynamicArray<float32> _QuantizationScales;
+
+		/*
+		*	Initializes this dense layer.
+		*/
+		FORCE_INLINE void Initialize
+		(
+			const uint32 number_of_inputs,
+			const uint32 number_of_outputs,
+			const ActivationFunction activation_function,
+			const float32 initial_weight
+		) NOEXCEPT
+		{
+			_NumberOfInputs = number_of_inputs;
+			_NumberOfOutputs = number_of_outputs;
+			_ActivationFunction = activation_function;
+			_Precision = Precision::FLOAT32;
+
+			_Weights.Resize<false>(static_cast<uint64>(number_of_inputs) * number_of_outputs);
+			_WeightDeltas.Resize<false>(static_cast<uint64>(number_of_inputs) * number_of_outputs);
+
+			for (uint64 i{ 0 }, size{ _Weights.Size() }; i < size; ++i)
+			{
+				_Weights[i] = initial_weight;
+				_WeightDeltas[i] = 0.0f;
+			}
+
+			_Biases.Resize<false>(number_of_outputs);
+			_BiasDeltas.Resize<false>(number_of_outputs);
+
+			for (uint32 i{ 0 }; i < number_of_outputs; ++i)
+			{
+				_Biases[i] = initial_weight;
+				_BiasDeltas[i] = 0.0f;
+			}
+
+			_HalfWeights.Clear();
+			_QuantizedWeights.Clear();
+			_QuantizationScales.Clear();
+		}
+
+		/*
+		*	Returns the weight at the given output/input.
+		*/
+		FORCE_INLINE NO_DISCARD float32 &Weight(const uint32 output_index, const uint32 input_index) NOEXCEPT
+		{
+			return _Weights[static_cast<uint64>(output_index) * _NumberOfInputs + input_index];
+		}
+
+		/*
+		*	Sets the precision used for inference, building the reduced precision weights from the float32 weights.
+		*	Training always operates on the float32 weights, so this needs to be called again after training to pick up the changes.
+		*/
+		FORCE_INLINE void SetPrecision(const Precision precision) NOEXCEPT
+		{
+			_Precision = precision;
+
+			switch (precision)
+			{
+				case Precision::FLOAT32:
+				{
+					_HalfWeights.Clear();
+					_QuantizedWeights.Clear();
+					_QuantizationScales.Clear();
+
+					break;
+				}
+
+				case Precision::FLOAT16:
+				{
+					_HalfWeights.Resize<false>(_Weights.Size());
+
+					for (uint64 i{ 0 }, size{ _Weights.Size() }; i < size; ++i)
+					{
+						_HalfWeights[i] = Float32ToFloat16(_Weights[i]);
+					}
+
+					break;
+				}
+
+				case Precision::INT8:
+				{
+					//Use symmetric per-row quantization, so that large rows don't destroy the precision of small rows.
+					_QuantizedWeights.Resize<false>(_Weights.Size());
+					_QuantizationScales.Resize<false>(_NumberOfOutputs);
+
+					for (uint32 row{ 0 }; row < _NumberOfOutputs; ++row)
+					{
+						const float32 *const RESTRICT row_weights{ &_Weights[static_cast<uint64>(row) * _NumberOfInputs] };
+						float32 maximum{ 0.0f };
+
+						for (uint32 i{ 0 }; i < _NumberOfInputs; ++i)
+						{
+							maximum = BaseMath::Maximum<float32>(maximum, BaseMath::Absolute<float32>(row_weights[i]));
+						}
+
+						const float32 scale{ maximum > 0.0f ? maximum / static_cast<float32>(INT8_MAXIMUM) : 1.0f };
+						const float32 inverse_scale{ 1.0f / scale };
+
+						_QuantizationScales[row] = scale;
+
+						for (uint32 i{ 0 }; i < _NumberOfInputs; ++i)
+						{
+							_QuantizedWeights[static_cast<uint64>(row) * _NumberOfInputs + i] = static_cast<int8>(BaseMath::Clamp<int32>(BaseMath::Round<int32>(row_weights[i] * inverse_scale), -INT8_MAXIMUM, INT8_MAXIMUM));
+						}
+					}
+
+					break;
+				}
+
+				default:
+				{
+					ASSERT(false, "Invalid case!");
+
+					break;
+				}
+			}
+		}
+
+		/*
+		*	Runs this dense layer for a batch of inputs.
+		*	'inputs' is [batch_size x number_of_inputs], 'outputs' is [batch_size x number_of_outputs].
+		*/
+		FORCE_INLINE void Forward(const float32 *const RESTRICT inputs, const uint64 batch_size, float32 *const RESTRICT outputs) const NOEXCEPT
+		{
+			switch (_Precision)
+			{
+				case Precision::FLOAT32:
+				{
+					MatrixMultiply(inputs, _Weights.Data(), nullptr, _Biases.Data(), batch_size, _NumberOfInputs, _NumberOfOutputs, _ActivationFunction, outputs);
+
+					break;
+				}
+
+				case Precision::FLOAT16:
+				{
+					MatrixMultiply(inputs, _HalfWeights.Data(), nullptr, _Biases.Data(), batch_size, _NumberOfInputs, _NumberOfOutputs, _ActivationFunction, outputs);
+
+					break;
+				}
+
+				case Precision::INT8:
+				{
+					MatrixMultiply(inputs, _QuantizedWeights.Data(), _QuantizationScales.Data(), _Biases.Data(), batch_size, _NumberOfInputs, _NumberOfOutputs, _ActivationFunction, outputs);
+
+					break;
+				}
+
+				default:
+				{
+					ASSERT(false, "Invalid case!");
+
+					break;
+				}
+			}
+		}
+
+		/*
+		*	Propagates the given output gradients backwards, accumulating into the input gradients.
+		*	The input gradients are expected to be zeroed by the caller.
+		*/
+		FORCE_INLINE void Backward(const float32 *const RESTRICT output_gradients, float32 *const RESTRICT input_gradients) const NOEXCEPT
+		{
+			for (uint32 row{ 0 }; row < _NumberOfOutputs; ++row)
+			{
+				MultiplyAdd(input_gradients, &_Weights[static_cast<uint64>(row) * _NumberOfInputs], output_gradients[row], _NumberOfInputs);
+			}
+		}
+
+		/*
+		*	Updates the weights and biases from the given inputs and output gradients, with momentum.
+		*/
+		FORCE_INLINE void UpdateWeights
+		(
+			const float32 *const RESTRICT inputs,
+			const float32 *const RESTRICT output_gradients,
+			const float32 learning_rate,
+			const float32 momentum
+		) NOEXCEPT
+		{
+			for (uint32 row{ 0 }; row < _NumberOfOutputs; ++row)
+			{
+				const uint64 offset{ static_cast<uint64>(row) * _NumberOfInputs };
+
+				NeuralNetworkKernels::UpdateWeights(&_Weights[offset], &_WeightDeltas[offset], inputs, learning_rate * output_gradients[row], momentum, _NumberOfInputs);
+
+				//The bias acts as a weight on a constant input of 1.0f.
+				_BiasDeltas[row] = learning_rate * output_gradients[row] + momentum * _BiasDeltas[row];
+				_Biases[row] += _BiasDeltas[row];
+			}
+		}
+
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,181 @@
+#pragma once
+
+//Core.
+#include <Core/Essential/CatalystEssential.h>
+#include <Core/Containers/StaticArray.h>
+
+//Math.
+#include <Math/General/Vector.h>
+
+/*
+*	Generates noise for many points per call, instead of one point per call.
+*	Points are processed eight at a time on the AVX2 backend, and grids are split across the task system.
+*	All results are bit-compatible with the scalar functions in PerlinNoise, SimplexNoise, ValueNoise and DerivativeNoise,
+*	given the same coordinates, so switching a scalar loop over to this doesn't change existing content.
+*/
+class BatchNoise final
+{
+
+public:
+
+	//Constants.
+	constexpr static uint8 MAXIMUM_NUMBER_OF_OCTAVES{ 16 };
+
+	//Enumeration covering all noise types.
+	enum class Type : uint8
+	{
+		/*
+		*	Matches PerlinNoise::Generate() for single octaves, PerlinNoise::GenerateOctaved() for STANDARD fractals.
+		*	Uses X, Y and Z.
+		*/
+		PERLIN,
+
+		/*
+		*	Matches SimplexNoise::Generate2D() for single octaves,
+		*	SimplexNoise::GenerateNormalizedOctaves2D() for STANDARD fractals and SimplexNoise::GenerateRidgedOctaves2D() for RIDGED fractals.
+		*	Uses X and Y.
+		*/
+		SIMPLEX,
+
+		/*
+		*	Matches ValueNoise::Generate() for single octaves. Uses X and Y.
+		*/
+		VALUE,
+
+		/*
+		*	Matches DerivativeNoise::Generate(). This is inherently fractal, so the fractal mode is ignored. Uses X and Y.
+		*/
+		DERIVATIVE
+	};
+
+	//Enumeration covering all fractal modes.
+	enum class Fractal : uint8
+	{
+		STANDARD,
+		RIDGED,
+		BILLOWED
+	};
+
+	/*
+	*	Fractal parameters class definition.
+	*/
+	class FractalParameters final
+	{
+
+	public:
+
+		//The noise type.
+		Type _Type{ Type::SIMPLEX };
+
+		//The fractal mode.
+		Fractal _Fractal{ Fractal::STANDARD };
+
+		//The number of octaves.
+		uint8 _NumberOfOctaves{ 1 };
+
+		//The multiplier for the coordinate at each octave.
+		float32 _Lacunarity{ 2.0f };
+
+		//The multiplier for the amplitude at each octave.
+		float32 _Gain{ 0.5f };
+
+		//The offsets for each octave. Only used by SIMPLEX, to match the scalar API.
+		StaticArray<Vector2<float32>, MAXIMUM_NUMBER_OF_OCTAVES> _Offsets;
+
+		//The derivative weight. Only used by DERIVATIVE.
+		float32 _DerivativeWeight{ 1.0f };
+
+		//The seed. Used by VALUE (as a float offset, like the scalar version) and DERIVATIVE.
+		uint64 _Seed{ 0 };
+
+	};
+
+	/*
+	*	Domain warp parameters class definition.
+	*	Before sampling, the X and Y coordinates are offset by a single octave of the same noise type,
+	*	sampled at (coordinate * frequency + offset) once for X and once for Y, and scaled by the strength.
+	*/
+	class DomainWarpParameters final
+	{
+
+	public:
+
+		//The strength. Zero disables domain warping.
+		float32 _Strength{ 0.0f };
+
+		//The frequency.
+		float32 _Frequency{ 1.0f };
+
+		//The offset used for the X warp.
+		Vector2<float32> _XOffset{ 0.0f, 0.0f };
+
+		//The offset used for the Y warp.
+		Vector2<float32> _YOffset{ 5.2f, 1.3f };
+
+	};
+
+	/*
+	*	Grid parameters class definition.
+	*	Point (X, Y) in the grid is sampled at (origin.X + X * step.X, origin.Y + Y * step.Y, origin.Z).
+	*/
+	class GridParameters final
+	{
+
+	public:
+
+		//The origin.
+		Vector3<float32> _Origin{ 0.0f, 0.0f, 0.0f };
+
+		//The step between each grid point.
+		Vector2<float32> _Step{ 1.0f, 1.0f };
+
+		//The width.
+		uint32 _Width{ 0 };
+
+		//The height.
+		uint32 _Height{ 0 };
+
+	};
+
+	/*
+	*	Generates a single octave of noise for each point.
+	*	'Z' is only read for PERLIN noise and can be nullptr otherwise.
+	*/
+	static void Generate
+	(
+		const Type type,
+		const float32 *const RESTRICT X,
+		const float32 *const RESTRICT Y,
+		const float32 *const RESTRICT Z,
+		const uint64 number_of_points,
+		float32 *const RESTRICT output
+	) NOEXCEPT;
+
+	/*
+	*	Generates fractal noise for each point.
+	*	'Z' is only read for PERLIN noise and can be nullptr otherwise.
+	*/
+	static void GenerateFractal
+	(
+		const FractalParameters &parameters,
+		const float32 *const RESTRICT X,
+		const float32 *const RESTRICT Y,
+		const float32 *const RESTRICT Z,
+		const uint64 number_of_points,
+		float32 *const RESTRICT output
+	) NOEXCEPT;
+
+	/*
+	*	Fills a grid with fractal noise, with optional domain warping.
+	*	'output' needs to hold width * height values, laid out row by row.
+	*	Rows are split across the task system, and this function returns when the whole grid is filled.
+	*/
+	static void GenerateGrid
+	(
+		const GridParameters &grid_parameters,
+		const FractalParameters &fractal_parameters,
+		const DomainWarpParameters &domain_warp_parameters,
+		float32 *const RESTRICT output
+	) NOEXCEPT;
+
+};
\ No newline at end of file
@@ -4,7 +4,7 @@
 #include <Core/Essential/CatalystEssential.h>
 
 //Math.
-#include <Math/BaseMath.h>
+#include <Math/Core/BaseMath.h>
 
 namespace PerlinNoiseConstants
 {
@@ -34,6 +34,11 @@ public:
 	*/
 	void Update(const void *RESTRICT const *RESTRICT texture_data) NOEXCEPT; 
 
+	/*
+	*	Updates a region of the first mip level of this texture, copying the given rectangle from the given texture data, which covers the whole first mip level.
+	*/
+	void UpdateRegion(const void *const RESTRICT texture_data, const uint32 X, const uint32 Y, const uint32 width, const uint32 height) NOEXCEPT;
+
 	/*
 	*	Releases this texture.
 	*/
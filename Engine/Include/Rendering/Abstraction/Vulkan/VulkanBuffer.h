@@ -48,6 +48,12 @@ public:
 	*/
 	void UploadData(const void *const RESTRICT *const RESTRICT data, const uint64 *const RESTRICT data_sizes, const uint32 data_chunks) NOEXCEPT;
 
+	/*
+	*	Maps the memory of this Vulkan buffer persistently, and returns a pointer to it.
+	*	Only valid for buffers created with VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT. The memory stays mapped until this buffer is released.
+	*/
+	RESTRICTED NO_DISCARD void *const RESTRICT MapMemory() NOEXCEPT;
+
 private:
 
 	//The underlying Vulkan buffer.
@@ -62,5 +68,8 @@ private:
 	//The memory properties.
 	VkMemoryPropertyFlags _MemoryProperties;
 
+	//The persistently mapped memory, if this buffer has been mapped.
+	void *RESTRICT _MappedMemory{ nullptr };
+
 };
 #endif
\ No newline at end of file
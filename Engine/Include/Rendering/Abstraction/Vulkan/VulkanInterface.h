@@ -152,6 +152,11 @@ public:
 	*/
 	void Update2DTexture(const void *RESTRICT const *RESTRICT texture_data, Vulkan2DTexture *const RESTRICT texture) NOEXCEPT;
 
+	/*
+	*	Updates a region of a 2D texture.
+	*/
+	void Update2DTextureRegion(const void *const RESTRICT texture_data, const uint32 X, const uint32 Y, const uint32 width, const uint32 height, Vulkan2DTexture *const RESTRICT texture) NOEXCEPT;
+
 	/*
 	*	Destroys a 2D texture.
 	*/
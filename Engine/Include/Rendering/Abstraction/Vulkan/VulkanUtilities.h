@@ -114,6 +114,24 @@ public:
 		commandPool->FreeCommandBuffer(copyCommandBuffer);
 	}
 
+	/*
+	*	Calculates the size of a mip level of a texture.
+	*	Block compressed textures (with a compression ratio above one) are padded to whole 4x4 blocks.
+	*/
+	FORCE_INLINE static NO_DISCARD VkDeviceSize CalculateMipSize(const uint32 width, const uint32 height, const uint32 depth, const uint32 mip_level, const uint32 texture_channels, const VkDeviceSize texel_size, const uint32 compression_ratio) NOEXCEPT
+	{
+		VkDeviceSize mip_width{ BaseMath::Maximum<uint32>(width >> mip_level, 1) };
+		VkDeviceSize mip_height{ BaseMath::Maximum<uint32>(height >> mip_level, 1) };
+
+		if (compression_ratio > 1)
+		{
+			mip_width = (mip_width + 3) & ~static_cast<VkDeviceSize>(3);
+			mip_height = (mip_height + 3) & ~static_cast<VkDeviceSize>(3);
+		}
+
+		return mip_width * mip_height * BaseMath::Maximum<uint32>(depth >> mip_level, 1) * texture_channels * texel_size / compression_ratio;
+	}
+
 	/*
 	*	Copies a Vulkan buffer to a Vulkan image.
 	*/
@@ -148,7 +166,7 @@ public:
 
 			bufferImageCopies.Emplace(bufferImageCopy);
 
-			currentOffset += (width >> i) * (height >> i) * BaseMath::Maximum<uint32>(depth >> i, 1) * texture_channels * texel_size * layerCount / compression_ratio;
+			currentOffset += CalculateMipSize(width, height, depth, i, texture_channels, texel_size, compression_ratio) * layerCount;
 		}
 
 		//Begin the transfer ommand buffer.
@@ -202,7 +220,7 @@ public:
 
 			bufferImageCopies.Emplace(bufferImageCopy);
 
-			currentOffset += (width >> i) * (height >> i) * BaseMath::Maximum<uint32>(depth >> i, 1) * texture_channels * texel_size * layerCount / compression_ratio;
+			currentOffset += CalculateMipSize(width, height, depth, i, texture_channels, texel_size, compression_ratio) * layerCount;
 		}
 
 		//Record the copy command to the transfer command buffer.
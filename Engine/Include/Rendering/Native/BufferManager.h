@@ -8,8 +8,67 @@
 //Rendering.
 #include <Rendering/Native/RenderingCore.h>
 
+/*
+*	Upload span class definition.
+*	A span of memory to write into, covering the start of the storage buffer for the frame it was reserved in.
+*/
+class UploadSpan final
+{
+
+public:
+
+	//The buffer this span lives in.
+	BufferHandle _Buffer{ EMPTY_HANDLE };
+
+	//The memory to write into.
+	byte *RESTRICT _Data{ nullptr };
+
+	//The size, in bytes.
+	uint64 _Size{ 0 };
+
+};
+
+/*
+*	Storage buffer writer class definition.
+*	Handed to storage buffer functions on the render update thread, which reserve the space they need and write straight into the persistently mapped storage buffer for the current frame.
+*	Every frame in flight has it's own storage buffer, so nothing the GPU might still be reading is overwritten.
+*	On backends that can't map buffers, the space is reserved in staging data instead, which is uploaded once the storage buffer function returns.
+*/
+class StorageBufferWriter final
+{
+
+public:
+
+	/*
+	*	Reserves the given number of bytes, and returns a span of memory to write into.
+	*	Should be called at most once per update. Grows the storage buffer geometrically if needed, which re-creates it, so the span's buffer can change between updates.
+	*/
+	NO_DISCARD UploadSpan Reserve(const uint64 size) NOEXCEPT;
+
+private:
+
+	//Friend declaration.
+	friend class BufferManager;
+
+	//The buffer.
+	BufferHandle *RESTRICT _Buffer;
+
+	//The buffer capacity.
+	uint64 *RESTRICT _BufferCapacity;
+
+	//The mapped memory.
+	byte **RESTRICT _MappedMemory;
+
+	//The staging data, used when the buffer couldn't be mapped.
+	DynamicArray<byte> *RESTRICT _StagingData;
+
+	//The reserved size.
+	uint64 _ReservedSize;
+
+};
+
 //Type aliases.
-using StorageBufferFunction = void(*)(DynamicArray<byte> *const RESTRICT data, void *const RESTRICT /*arguments*/);
+using StorageBufferFunction = void(*)(StorageBufferWriter *const RESTRICT writer, void *const RESTRICT /*arguments*/);
 
 class BufferManager final
 {
@@ -90,6 +149,12 @@ private:
 		//The buffer capacities.
 		DynamicArray<uint64> _BufferCapacities;
 
+		//The persistently mapped memory of the buffers. nullptr for buffers that couldn't be mapped.
+		DynamicArray<byte *RESTRICT> _MappedMemory;
+
+		//The staging data, written into instead of the buffer when it couldn't be mapped.
+		DynamicArray<byte> _StagingData;
+
 		//The identifier.
 		HashString _Identifier;
 
@@ -99,9 +164,6 @@ private:
 		//The arguments.
 		void *RESTRICT _Arguments;
 
-		//The data.
-		DynamicArray<byte> _Data;
-
 	};
 
 	//The registered uniform buffers.
@@ -95,10 +95,18 @@ namespace GLSLCompilation
 		//The output data.
 		DynamicArray<uint8> *RESTRICT _OutputData;
 
+		//The directory of the SPIR-V cache. If set, shaders that have been compiled before with the same source and options are read from the cache.
+		const char *RESTRICT _CacheDirectoryPath{ nullptr };
+
+		//If set, receives whether or not the shader was read from the cache.
+		bool *RESTRICT _CacheHit{ nullptr };
+
 	};
 
 	/*
 	*	Compiles a GLSL shader of the given shader stage with the given lines.
+	*	Can be called from multiple threads at once.
+	*	Returns false and logs the errors if the shader failed to compile, in which case the output data is left empty and nothing is cached.
 	*/
 	NO_DISCARD bool Compile(const CompileParameters &parameters) NOEXCEPT;
 
@@ -0,0 +1,63 @@
+#pragma once
+
+//Core.
+#include <Core/Essential/CatalystEssential.h>
+#include <Core/Containers/DynamicArray.h>
+#include <Core/Containers/StaticArray.h>
+
+//Math.
+#include <Math/General/Vector.h>
+
+//Rendering.
+#include <Rendering/Native/Texture2D.h>
+#include <Rendering/Native/TextureCube.h>
+
+/*
+*	Cubemap filtering class definition.
+*	Converts and prefilters cubemaps for image based lighting, in the face layout texture cube assets are compiled with.
+*	All work is split up per face row over the task system, and is deterministic, since all sampling uses the Hammersley sequence.
+*/
+class CubemapFiltering final
+{
+
+public:
+
+	/*
+	*	Returns the direction of the given normalized coordinate on the given face.
+	*/
+	static NO_DISCARD Vector3<float32> FaceDirection(const uint8 face_index, const Vector2<float32> &normalized_coordinate) NOEXCEPT;
+
+	/*
+	*	Samples the given mip chain in the given direction at the given, possibly fractional, mip level.
+	*	Filters linearly within each face and between mip levels.
+	*/
+	static NO_DISCARD Vector4<float32> Sample(const DynamicArray<TextureCube> &mip_chain, const Vector3<float32> &direction, const float32 mip_level) NOEXCEPT;
+
+	/*
+	*	Projects the given equirectangular texture onto the given texture cube, which is expected to be initialized.
+	*/
+	static void FromEquirectangular(const Texture2D<Vector4<float32>> &texture, TextureCube *const RESTRICT output) NOEXCEPT;
+
+	/*
+	*	Builds a box filtered mip chain from the given texture cube, down to a resolution of 1.
+	*	This is what the prefiltering samples from, to keep the number of samples needed low.
+	*/
+	static void BuildMipChain(const TextureCube &texture, DynamicArray<TextureCube> *const RESTRICT mip_chain) NOEXCEPT;
+
+	/*
+	*	Prefilters the given mip chain with the GGX distribution of the given roughness into the given texture cube, which is expected to be initialized.
+	*	Importance samples the distribution, picking the source mip level of each sample from it's probability density.
+	*/
+	static void PrefilterSpecular(const DynamicArray<TextureCube> &mip_chain, const float32 roughness, const uint32 number_of_samples, TextureCube *const RESTRICT output) NOEXCEPT;
+
+	/*
+	*	Projects the given texture cube onto the first nine spherical harmonics coefficients.
+	*/
+	static void ProjectSphericalHarmonics(const TextureCube &texture, StaticArray<Vector3<float32>, 9> *const RESTRICT coefficients) NOEXCEPT;
+
+	/*
+	*	Writes the cosine convolved irradiance of the given spherical harmonics coefficients, divided by pi, into the given texture cube, which is expected to be initialized.
+	*/
+	static void ConvolveDiffuse(const StaticArray<Vector3<float32>, 9> &coefficients, TextureCube *const RESTRICT output) NOEXCEPT;
+
+};
\ No newline at end of file
@@ -0,0 +1,106 @@
+#pragma once
+
+//Core.
+#include <Core/Essential/CatalystEssential.h>
+
+//Rendering.
+#include <Rendering/Native/RenderingCore.h>
+
+/*
+*	Draw key class definition.
+*	Packs everything that decides the draw order into a single 64-bit key, so render input streams can be sorted with a radix sort.
+*
+*	Opaque layout, from the most significant bit:
+*	[63] Translucent (0) | [62..56] Pipeline | [55..40] Material | [39..24] Mesh | [23..0] Depth, front to back.
+*
+*	Translucent layout, from the most significant bit:
+*	[63] Translucent (1) | [62..56] Pipeline | [55..32] Depth, back to front | [31..16] Material | [15..0] Mesh.
+*/
+class DrawKey final
+{
+
+public:
+
+	//The number of bits for each field.
+	constexpr static uint64 PIPELINE_BITS{ 7 };
+	constexpr static uint64 MATERIAL_BITS{ 16 };
+	constexpr static uint64 MESH_BITS{ 16 };
+	constexpr static uint64 DEPTH_BITS{ 24 };
+
+	/*
+	*	Returns the draw key for an opaque draw.
+	*	Draws are grouped by pipeline, material and mesh to cut down on state changes, and then drawn front to back.
+	*/
+	FORCE_INLINE NO_DISCARD static uint64 Opaque(const uint8 pipeline, const uint32 material, const uint32 mesh, const float32 depth) NOEXCEPT
+	{
+		return	(static_cast<uint64>(pipeline & Mask(PIPELINE_BITS)) << 56)
+				| (static_cast<uint64>(material & Mask(MATERIAL_BITS)) << 40)
+				| (static_cast<uint64>(mesh & Mask(MESH_BITS)) << 24)
+				| static_cast<uint64>(DepthBucket(depth));
+	}
+
+	/*
+	*	Returns the draw key for a translucent draw.
+	*	Translucent draws always come after opaque draws, and are drawn back to front for correct blending.
+	*/
+	FORCE_INLINE NO_DISCARD static uint64 Translucent(const uint8 pipeline, const uint32 material, const uint32 mesh, const float32 depth) NOEXCEPT
+	{
+		return	BIT(63)
+				| (static_cast<uint64>(pipeline & Mask(PIPELINE_BITS)) << 56)
+				| (static_cast<uint64>(Mask(DEPTH_BITS) - DepthBucket(depth)) << 32)
+				| (static_cast<uint64>(material & Mask(MATERIAL_BITS)) << 16)
+				| static_cast<uint64>(mesh & Mask(MESH_BITS));
+	}
+
+	/*
+	*	Returns the draw key for a draw that should only be sorted on depth, front to back.
+	*/
+	FORCE_INLINE NO_DISCARD static uint64 Depth(const float32 depth) NOEXCEPT
+	{
+		return static_cast<uint64>(DepthBucket(depth));
+	}
+
+	/*
+	*	Returns a mesh identifier for the given vertex buffer.
+	*	Draws of the same mesh get the same identifier, so they end up next to each other and can skip rebinding buffers.
+	*	Different meshes might collide, which only costs a few rebinds.
+	*/
+	FORCE_INLINE NO_DISCARD static uint32 MeshIdentifier(const BufferHandle vertex_buffer) NOEXCEPT
+	{
+		uint64 value{ reinterpret_cast<uint64>(vertex_buffer) };
+
+		value ^= value >> 33;
+		value *= 0xff51afd7ed558ccdULL;
+		value ^= value >> 33;
+
+		return static_cast<uint32>(value & Mask(MESH_BITS));
+	}
+
+private:
+
+	/*
+	*	Returns a mask with the given number of lower bits set.
+	*/
+	FORCE_INLINE constexpr NO_DISCARD static uint64 Mask(const uint64 number_of_bits) NOEXCEPT
+	{
+		return (1ULL << number_of_bits) - 1;
+	}
+
+	/*
+	*	Returns the depth bucket for the given depth.
+	*	The bit pattern of a positive float is ordered the same as it's value, so the upper bits are used directly, which gives finer buckets close to the camera.
+	*/
+	FORCE_INLINE NO_DISCARD static uint32 DepthBucket(const float32 depth) NOEXCEPT
+	{
+		if (!(depth > 0.0f))
+		{
+			return 0;
+		}
+
+		uint32 bits;
+		Memory::Copy(&bits, &depth, sizeof(uint32));
+
+		return bits >> (32 - DEPTH_BITS);
+	}
+
+};
\ No newline at end of file
@@ -0,0 +1,162 @@
+#pragma once
+
+//Core.
+#include <Core/Essential/CatalystEssential.h>
+#include <Core/Containers/DynamicArray.h>
+
+//Concurrency.
+#include <Concurrency/Atomic.h>
+
+//Content.
+#include <Content/Assets/FontAsset.h>
+
+//Rendering.
+#include <Rendering/Native/RenderingCore.h>
+#include <Rendering/Native/Texture2D.h>
+
+//Third party.
+#include <ThirdParty/stb_truetype/stb_truetype.h>
+
+//STL.
+#include <unordered_map>
+
+/*
+*	Glyph cache class definition.
+*	Rasterizes characters that were not compiled into a font on demand, into uniformly sized cells on pages owned by the cache.
+*	When all cells are in use, the least recently used character is evicted to make room for the new one.
+*	Render commands referencing an evicted character are stale, so users keep track of the number of evictions and recreate them when it changes.
+*/
+class GlyphCache final
+{
+
+public:
+
+	/*
+	*	Returns the character description for the given codepoint in the given font.
+	*	Looks in the compiled characters first, and then in the font's glyph cache, if it has one.
+	*/
+	FORCE_INLINE static RESTRICTED NO_DISCARD const FontAsset::CharacterDescription *const RESTRICT FindCharacterDescription(FontAsset *const RESTRICT font, const uint32 codepoint) NOEXCEPT
+	{
+		if (const FontAsset::CharacterDescription *const RESTRICT character_description{ font->FindCharacterDescription(codepoint) })
+		{
+			return character_description;
+		}
+
+		return font->_GlyphCache ? font->_GlyphCache->Find(codepoint) : nullptr;
+	}
+
+	/*
+	*	Initializes this glyph cache for the given font, which is expected to have it's font data loaded.
+	*/
+	void Initialize(FontAsset *const RESTRICT font, const uint32 number_of_pages) NOEXCEPT;
+
+	/*
+	*	Returns the character description for the given codepoint, rasterizing it if it isn't cached.
+	*	Returns nullptr if the font has no glyph for the given codepoint.
+	*/
+	RESTRICTED NO_DISCARD const FontAsset::CharacterDescription *const RESTRICT Find(const uint32 codepoint) NOEXCEPT;
+
+	/*
+	*	Uploads the regions of the pages that characters were rasterized into since the last upload.
+	*/
+	void Upload() NOEXCEPT;
+
+	/*
+	*	Returns the number of characters evicted by all glyph caches.
+	*/
+	FORCE_INLINE static NO_DISCARD uint64 GetNumberOfEvictions() NOEXCEPT
+	{
+		return NUMBER_OF_EVICTIONS.Load();
+	}
+
+private:
+
+	/*
+	*	Cell class definition.
+	*/
+	class Cell final
+	{
+
+	public:
+
+		//The codepoint of the character in this cell.
+		uint32 _Codepoint;
+
+		//When this cell was last used.
+		uint64 _LastUsed;
+
+		//The character description.
+		FontAsset::CharacterDescription _CharacterDescription;
+
+	};
+
+	/*
+	*	Page class definition.
+	*/
+	class Page final
+	{
+
+	public:
+
+		//The texture.
+		Texture2D<uint8> _Texture;
+
+		//The texture handle.
+		Texture2DHandle _Handle;
+
+		/*
+		*	The region of this page that has changed since the last upload, in texels.
+		*	The minimum is inclusive and the maximum is exclusive, so the region is empty when the minimum isn't below the maximum.
+		*/
+		uint32 _DirtyMinimumX;
+		uint32 _DirtyMinimumY;
+		uint32 _DirtyMaximumX;
+		uint32 _DirtyMaximumY;
+
+	};
+
+	//The number of characters evicted by all glyph caches. Glyph caches of different fonts can be used from different threads, so this is atomic.
+	static Atomic<uint64> NUMBER_OF_EVICTIONS;
+
+	//The font info.
+	stbtt_fontinfo _FontInfo;
+
+	//The scale to rasterize characters with.
+	float32 _Scale;
+
+	//The pixel height that characters are rasterized at.
+	uint32 _PixelHeight;
+
+	//The padding around characters.
+	uint32 _Padding;
+
+	//The resolution of each cell.
+	uint32 _CellResolution;
+
+	//The number of cells in each row of a page.
+	uint32 _CellsPerRow;
+
+	//The index of the first page of this glyph cache in the font's pages.
+	uint32 _FirstPageIndex;
+
+	//The pages.
+	DynamicArray<Page> _Pages;
+
+	//The cells.
+	DynamicArray<Cell> _Cells;
+
+	//The number of cells that have been used so far. Cells beyond this are free.
+	uint32 _NumberOfUsedCells;
+
+	//The cell indices, mapped by codepoint. Codepoints without a glyph map to FontAsset::INVALID_INDEX, to not look them up again.
+	std::unordered_map<uint32, uint32> _CellIndices;
+
+	//The counter used to order cells by when they were last used.
+	uint64 _UseCounter;
+
+	/*
+	*	Rasterizes the given glyph into the given cell.
+	*/
+	void Rasterize(const int32 glyph_index, const uint32 cell_index) NOEXCEPT;
+
+};
\ No newline at end of file
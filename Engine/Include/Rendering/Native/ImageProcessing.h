@@ -0,0 +1,105 @@
+#pragma once
+
+//Core.
+#include <Core/Essential/CatalystEssential.h>
+#include <Core/Containers/DynamicArray.h>
+
+//Math.
+#include <Math/General/Vector.h>
+
+//Rendering.
+#include <Rendering/Native/RenderingCore.h>
+#include <Rendering/Native/Texture2D.h>
+
+/*
+*	Image processing class definition.
+*	Runs image operations as tile parallel passes over the task system, where a tile is a band of rows.
+*	Operations that depend on each other should be fused into the same pass where possible, to go over memory once.
+*/
+class ImageProcessing final
+{
+
+public:
+
+	//Type aliases.
+	using TileFunction = void(*)(const void *const RESTRICT context, const uint32 first_row, const uint32 last_row);
+
+	//Enumeration covering all mip filters.
+	enum class MipFilter : uint8
+	{
+		//Averages 2x2 texels. Blurry, but cheap.
+		BOX,
+
+		//Kaiser windowed sinc. Sharp, with little ringing.
+		KAISER,
+
+		//Lanczos windowed sinc, three lobes. Sharpest, but rings the most.
+		LANCZOS
+	};
+
+	/*
+	*	Mip chain parameters class definition.
+	*/
+	class MipChainParameters final
+	{
+
+	public:
+
+		//The mipmap generation mode.
+		MipmapGenerationMode _Mode{ MipmapGenerationMode::DEFAULT };
+
+		//The filter. Not used by the MAXIMUM mode.
+		MipFilter _Filter{ MipFilter::KAISER };
+
+		//Bit mask of the channels whose coverage should be preserved across mip levels, for alpha testing.
+		uint8 _CoverageChannels{ 0 };
+
+		//The reference value that coverage is measured against.
+		float32 _CoverageReference{ 0.5f };
+
+		//The lowest resolution generated.
+		uint32 _LowestResolution{ 8 };
+
+	};
+
+	/*
+	*	Statistics class definition.
+	*/
+	class Statistics final
+	{
+
+	public:
+
+		//The minimum.
+		Vector4<float32> _Minimum;
+
+		//The maximum.
+		Vector4<float32> _Maximum;
+
+		//The average.
+		Vector4<float32> _Average;
+
+	};
+
+	/*
+	*	Runs the given function over all tiles of an image with the given height, spread out over tasks.
+	*	Runs at low priority, as this is only done when compiling assets.
+	*/
+	static void ForEachTile(const uint32 height, const TileFunction function, const void *const RESTRICT context) NOEXCEPT;
+
+	/*
+	*	Calculates the statistics of the given texture.
+	*/
+	static void CalculateStatistics(const Texture2D<Vector4<float32>> &texture, Statistics *const RESTRICT statistics) NOEXCEPT;
+
+	/*
+	*	Generates the mip chain from the first texture in the given array, appending the new mip levels to it.
+	*/
+	static void GenerateMipChain(const MipChainParameters &parameters, DynamicArray<Texture2D<Vector4<float32>>> *const RESTRICT mip_chain) NOEXCEPT;
+
+	/*
+	*	Converts the given texture to 8 bit unsigned normalized values, clamping and rounding to nearest.
+	*/
+	static void ConvertToUNorm8(const Texture2D<Vector4<float32>> &input, Texture2D<Vector4<uint8>> *const RESTRICT output) NOEXCEPT;
+
+};
\ No newline at end of file
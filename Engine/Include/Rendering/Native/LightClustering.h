@@ -0,0 +1,190 @@
+#pragma once
+
+//Core.
+#include <Core/Essential/CatalystEssential.h>
+#include <Core/Containers/DynamicArray.h>
+
+//Math.
+#include <Math/General/Matrix.h>
+#include <Math/General/Vector.h>
+
+//Rendering.
+#include <Rendering/Native/ShaderLightComponent.h>
+
+//Light clustering constants.
+namespace LightClusteringConstants
+{
+	constexpr uint32 GRID_WIDTH{ 16 };
+	constexpr uint32 GRID_HEIGHT{ 9 };
+	constexpr uint32 GRID_DEPTH{ 24 };
+	constexpr uint32 CLUSTERS_PER_SLICE{ GRID_WIDTH * GRID_HEIGHT };
+	constexpr uint32 NUMBER_OF_CLUSTERS{ CLUSTERS_PER_SLICE * GRID_DEPTH };
+
+	static_assert((CLUSTERS_PER_SLICE % 8) == 0, "The clusters of a depth slice are tested eight at a time!");
+}
+
+/*
+*	Light clusters header class definition.
+*	Mirrors the header of the "LightClusters" storage buffer.
+*/
+class LightClustersHeader final
+{
+
+public:
+
+	//The grid width.
+	uint32 _GridWidth;
+
+	//The grid height.
+	uint32 _GridHeight;
+
+	//The grid depth.
+	uint32 _GridDepth;
+
+	//The number of global lights, which affect every cluster.
+	uint32 _NumberOfGlobalLights;
+
+	//The depth scale. The depth slice of a linearized depth is floor(log(depth) * _DepthScale + _DepthBias).
+	float32 _DepthScale;
+
+	//The depth bias.
+	float32 _DepthBias;
+
+};
+
+static_assert(sizeof(LightClustersHeader) == 24, "LightClustersHeader must match the shader side layout!");
+
+/*
+*	Light clustering class definition.
+*	Bins lights into a froxel grid (screen tiles times exponential depth slices) on the CPU,
+*	so that shading only has to consider the lights that can actually reach a pixel.
+*
+*	The result is one array of indices, laid out as:
+*	[0, number of global lights)	- Lights that affect every cluster, like directional lights.
+*	[.., + number of clusters * 2)	- The offset into this array and the number of lights of each cluster.
+*	[.., end)						- The light indices of all clusters, compacted.
+*/
+class LightClustering final
+{
+
+public:
+
+	/*
+	*	Builds the cluster bounds from the given camera properties.
+	*	The bounds are in camera space, and only need to be rebuilt when the projection changes.
+	*/
+	void BuildGrid(const Matrix4x4 &inverse_camera_to_clip_matrix, const float32 near_plane, const float32 far_plane) NOEXCEPT;
+
+	/*
+	*	Assigns the given lights to the clusters. Tests lights in parallel on the task system when there are enough of them.
+	*/
+	void AssignLights(const Matrix4x4 &world_to_camera_matrix, const ShaderLightComponent *const RESTRICT lights, const uint32 number_of_lights) NOEXCEPT;
+
+	/*
+	*	Returns the header.
+	*/
+	FORCE_INLINE NO_DISCARD const LightClustersHeader &GetHeader() const NOEXCEPT
+	{
+		return _Header;
+	}
+
+	/*
+	*	Returns the data.
+	*/
+	FORCE_INLINE NO_DISCARD const DynamicArray<uint32> &GetData() const NOEXCEPT
+	{
+		return _Data;
+	}
+
+	/*
+	*	Returns the index of the cluster at the given coordinates.
+	*/
+	FORCE_INLINE NO_DISCARD static uint32 ClusterIndex(const uint32 X, const uint32 Y, const uint32 Z) NOEXCEPT
+	{
+		return (Z * LightClusteringConstants::GRID_HEIGHT + Y) * LightClusteringConstants::GRID_WIDTH + X;
+	}
+
+	/*
+	*	Returns the number of lights in the given cluster, excluding global lights.
+	*/
+	FORCE_INLINE NO_DISCARD uint32 NumberOfClusterLights(const uint32 cluster_index) const NOEXCEPT
+	{
+		return _Data[_Header._NumberOfGlobalLights + cluster_index * 2 + 1];
+	}
+
+	/*
+	*	Returns the light indices of the given cluster, excluding global lights.
+	*/
+	FORCE_INLINE NO_DISCARD const uint32 *const RESTRICT ClusterLights(const uint32 cluster_index) const NOEXCEPT
+	{
+		return &_Data[_Data[_Header._NumberOfGlobalLights + cluster_index * 2 + 0]];
+	}
+
+private:
+
+	//The header.
+	LightClustersHeader _Header;
+
+	//The minimum X of each cluster, in camera space.
+	DynamicArray<float32> _MinimumX;
+
+	//The minimum Y of each cluster, in camera space.
+	DynamicArray<float32> _MinimumY;
+
+	//The minimum Z of each cluster, in camera space.
+	DynamicArray<float32> _MinimumZ;
+
+	//The maximum X of each cluster, in camera space.
+	DynamicArray<float32> _MaximumX;
+
+	//The maximum Y of each cluster, in camera space.
+	DynamicArray<float32> _MaximumY;
+
+	//The maximum Z of each cluster, in camera space.
+	DynamicArray<float32> _MaximumZ;
+
+	//The forward vector, in camera space.
+	Vector3<float32> _ForwardVector;
+
+	//The near plane.
+	float32 _NearPlane;
+
+	//The bounding spheres of the bounded lights, in camera space. The radius is stored in W.
+	DynamicArray<Vector4<float32>> _Spheres;
+
+	//The light indices of the bounded lights.
+	DynamicArray<uint32> _BoundedLightIndices;
+
+	//The light indices of the global lights.
+	DynamicArray<uint32> _GlobalLightIndices;
+
+	//The cluster masks. One 64 bit word per cluster per 64 bounded lights, word major.
+	DynamicArray<uint64> _Masks;
+
+	//The number of lights in each cluster.
+	DynamicArray<uint32> _ClusterCounts;
+
+	//The data.
+	DynamicArray<uint32> _Data;
+
+	/*
+	*	Returns the depth slice of the given linearized depth.
+	*/
+	NO_DISCARD uint32 DepthSlice(const float32 depth) const NOEXCEPT;
+
+	/*
+	*	Tests the bounded lights of the given mask word against the clusters.
+	*/
+	void TestLights(const uint32 word_index) NOEXCEPT;
+
+	/*
+	*	Counts the lights of the clusters in the given depth slice.
+	*/
+	void CountLights(const uint32 slice_index) NOEXCEPT;
+
+	/*
+	*	Writes the light indices of the clusters in the given depth slice.
+	*/
+	void WriteLights(const uint32 slice_index) NOEXCEPT;
+
+};
\ No newline at end of file
@@ -8,6 +8,7 @@
 #include <Lighting/LightingCore.h>
 
 //Rendering.
+#include <Rendering/Native/LightClustering.h>
 #include <Rendering/Native/RenderingCore.h>
 #include <Rendering/Native/ShaderLightComponent.h>
 
@@ -56,6 +57,9 @@ private:
 	//The shader light components.
 	DynamicArray<ShaderLightComponent> _ShaderLightComponents;
 
+	//The light clustering.
+	LightClustering _LightClustering;
+
 	/*
 	*	Creates the render data table layout.
 	*/
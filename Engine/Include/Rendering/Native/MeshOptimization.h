@@ -0,0 +1,135 @@
+#pragma once
+
+//Core.
+#include <Core/Essential/CatalystEssential.h>
+#include <Core/Containers/DynamicArray.h>
+#include <Core/Containers/StaticArray.h>
+
+//Math.
+#include <Math/Geometry/AxisAlignedBoundingBox3D.h>
+
+//Rendering.
+#include <Rendering/Native/Vertex.h>
+
+/*
+*	Quantized vertex class definition.
+*	Compact, 20 byte version of 'Vertex', used to store vertices on disk.
+*	Vertices are dequantized back into 'Vertex' when loaded, so this only saves disk space and streaming I/O, not GPU memory or bandwidth.
+*/
+class QuantizedVertex final
+{
+
+public:
+
+	//The position, normalized within the position bounds. The fourth component is padding.
+	StaticArray<uint16, 4> _Position;
+
+	//The normal, octahedral encoded.
+	StaticArray<int16, 2> _Normal;
+
+	//The tangent, octahedral encoded.
+	StaticArray<int16, 2> _Tangent;
+
+	//The texture coordinate, normalized within the texture coordinate bounds of the mesh.
+	StaticArray<uint16, 2> _TextureCoordinate;
+
+};
+
+static_assert(sizeof(QuantizedVertex) == 20, "QuantizedVertex is expected to be 20 bytes!");
+
+/*
+*	Quantization bounds class definition.
+*	The bounds needed to dequantize vertices.
+*	Should cover every mesh of a model, so that vertices shared between meshes quantize to the same values and the seams don't crack.
+*/
+class QuantizationBounds final
+{
+
+public:
+
+	//The minimum position.
+	Vector3<float32> _MinimumPosition{ FLOAT32_MAXIMUM, FLOAT32_MAXIMUM, FLOAT32_MAXIMUM };
+
+	//The maximum position.
+	Vector3<float32> _MaximumPosition{ -FLOAT32_MAXIMUM, -FLOAT32_MAXIMUM, -FLOAT32_MAXIMUM };
+
+	//The minimum texture coordinate.
+	Vector2<float32> _MinimumTextureCoordinate{ FLOAT32_MAXIMUM, FLOAT32_MAXIMUM };
+
+	//The maximum texture coordinate.
+	Vector2<float32> _MaximumTextureCoordinate{ -FLOAT32_MAXIMUM, -FLOAT32_MAXIMUM };
+
+};
+
+/*
+*	Mesh optimization class definition.
+*	Offline processing of triangle meshes; deduplication, reordering for the post-transform vertex cache, overdraw and vertex fetch,
+*	simplification for automatic level of details, and quantization.
+*	All functions work on indexed triangle lists.
+*/
+class MeshOptimization final
+{
+
+public:
+
+	//The cache size used when measuring the average cache miss ratio.
+	constexpr static uint32 DEFAULT_CACHE_SIZE{ 16 };
+
+	/*
+	*	Merges vertices that are exactly equal, and remaps the indices accordingly.
+	*/
+	static void DeduplicateVertices(DynamicArray<Vertex> *const RESTRICT vertices, DynamicArray<uint32> *const RESTRICT indices) NOEXCEPT;
+
+	/*
+	*	Reorders the triangles for the post-transform vertex cache, using Tom Forsyth's linear-speed vertex cache optimization.
+	*/
+	static void OptimizeVertexCache(DynamicArray<uint32> *const RESTRICT indices, const uint64 number_of_vertices) NOEXCEPT;
+
+	/*
+	*	Reorders clusters of triangles to reduce overdraw, drawing outward facing clusters first.
+	*	Should be run after OptimizeVertexCache(). The threshold is how much the average cache miss ratio is allowed to get worse, 1.05f allows 5%.
+	*/
+	static void OptimizeOverdraw(const DynamicArray<Vertex> &vertices, DynamicArray<uint32> *const RESTRICT indices, const float32 threshold) NOEXCEPT;
+
+	/*
+	*	Reorders the vertices in the order they are first referenced by the indices, and removes vertices that aren't referenced at all.
+	*	Should be run last.
+	*/
+	static void OptimizeVertexFetch(DynamicArray<Vertex> *const RESTRICT vertices, DynamicArray<uint32> *const RESTRICT indices) NOEXCEPT;
+
+	/*
+	*	Returns the average cache miss ratio (the number of vertex shader invocations per triangle) for a FIFO cache of the given size.
+	*/
+	NO_DISCARD static float32 AverageCacheMissRatio(const DynamicArray<uint32> &indices, const uint64 number_of_vertices, const uint32 cache_size = DEFAULT_CACHE_SIZE) NOEXCEPT;
+
+	/*
+	*	Simplifies the given mesh with quadric error metrics, until either the target number of indices or the target error is reached.
+	*	The error is relative to the extent of the mesh, so 0.01f means one percent of the mesh size.
+	*	Attribute seams and borders are kept intact. The resulting indices reference the original vertices.
+	*	Returns the error that was actually reached.
+	*/
+	static float32 Simplify
+	(
+		const DynamicArray<Vertex> &vertices,
+		const DynamicArray<uint32> &indices,
+		const uint64 target_number_of_indices,
+		const float32 target_error,
+		DynamicArray<uint32> *const RESTRICT output_indices
+	) NOEXCEPT;
+
+	/*
+	*	Expands the given quantization bounds to cover the given vertices.
+	*/
+	static void ExpandQuantizationBounds(const DynamicArray<Vertex> &vertices, QuantizationBounds *const RESTRICT bounds) NOEXCEPT;
+
+	/*
+	*	Quantizes the given vertices within the given bounds.
+	*/
+	static void Quantize(const DynamicArray<Vertex> &vertices, const QuantizationBounds &bounds, DynamicArray<QuantizedVertex> *const RESTRICT quantized_vertices) NOEXCEPT;
+
+	/*
+	*	Dequantizes the given vertices.
+	*/
+	static void Dequantize(const QuantizedVertex *const RESTRICT quantized_vertices, const uint64 number_of_vertices, const QuantizationBounds &bounds, Vertex *const RESTRICT vertices) NOEXCEPT;
+
+};
\ No newline at end of file
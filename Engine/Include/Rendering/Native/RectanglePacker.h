@@ -0,0 +1,77 @@
+#pragma once
+
+//Core.
+#include <Core/Essential/CatalystEssential.h>
+#include <Core/Containers/DynamicArray.h>
+
+//Math.
+#include <Math/General/Vector.h>
+
+/*
+*	Rectangle packer class definition.
+*	Packs rectangles into a fixed size area with the skyline bottom-left heuristic.
+*	The skyline only tracks the top edge of what has been packed so far, so gaps below it are lost,
+*	but packing stays fast and tight for similarly sized rectangles when they are packed tallest first, like glyphs.
+*/
+class RectanglePacker final
+{
+
+public:
+
+	/*
+	*	Initializes this rectangle packer.
+	*/
+	void Initialize(const uint32 width, const uint32 height) NOEXCEPT;
+
+	/*
+	*	Packs a rectangle with the given dimensions. Returns if it fit, and if so, writes where it was put.
+	*/
+	NO_DISCARD bool Pack(const uint32 width, const uint32 height, Vector2<uint32> *const RESTRICT position) NOEXCEPT;
+
+	/*
+	*	Returns the fraction of the area that is occupied by packed rectangles.
+	*/
+	FORCE_INLINE NO_DISCARD float32 GetOccupancy() const NOEXCEPT
+	{
+		return static_cast<float32>(_OccupiedArea) / static_cast<float32>(static_cast<uint64>(_Width) * _Height);
+	}
+
+private:
+
+	/*
+	*	Skyline node class definition.
+	*/
+	class SkylineNode final
+	{
+
+	public:
+
+		//The X position.
+		uint32 _X;
+
+		//The Y position.
+		uint32 _Y;
+
+		//The width.
+		uint32 _Width;
+
+	};
+
+	//The width.
+	uint32 _Width;
+
+	//The height.
+	uint32 _Height;
+
+	//The occupied area.
+	uint64 _OccupiedArea;
+
+	//The skyline, sorted left to right.
+	DynamicArray<SkylineNode> _Skyline;
+
+	/*
+	*	Returns if a rectangle with the given dimensions fits with it's left edge at the given skyline node, and if so, writes at which Y.
+	*/
+	NO_DISCARD bool Fits(const uint64 node_index, const uint32 width, const uint32 height, uint32 *const RESTRICT Y) const NOEXCEPT;
+
+};
\ No newline at end of file
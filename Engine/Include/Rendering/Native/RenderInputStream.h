@@ -2,6 +2,7 @@
 
 //Core.
 #include <Core/Essential/CatalystEssential.h>
+#include <Core/Algorithms/SortingAlgorithms.h>
 #include <Core/Containers/DynamicArray.h>
 #include <Core/General/HashString.h>
 
@@ -75,9 +76,9 @@ public:
 		};
 	};
 
-	//The sort value.
-	float32 _SortValue;
-	
+	//The draw key. Only used if the input stream is sorted, see 'DrawKey'.
+	uint64 _DrawKey;
+
 };
 
 /*
@@ -155,7 +156,49 @@ public:
 	//The push constant data memory.
 	DynamicArray<byte> _PushConstantDataMemory;
 
+	/*
+	*	The order to process the entries in, as indices into the entries.
+	*	Empty means the entries are processed in the order they were gathered.
+	*/
+	DynamicArray<uint32> _DrawOrder;
+
+	//The draw keys, kept around to avoid reallocating them every sort.
+	DynamicArray<uint64> _DrawKeys;
+
 	//The task.
 	Task _Task;
 
+	/*
+	*	Returns the entry at the given position in the draw order.
+	*/
+	FORCE_INLINE NO_DISCARD const RenderInputStreamEntry &GetEntry(const uint64 index) const NOEXCEPT
+	{
+		return _DrawOrder.Empty() ? _Entries[index] : _Entries[_DrawOrder[index]];
+	}
+
+	/*
+	*	Sorts the entries on their draw keys.
+	*	The entries and their push constant data stay where they are, only the draw order is updated.
+	*/
+	FORCE_INLINE void SortEntries() NOEXCEPT
+	{
+		_DrawOrder.Clear();
+
+		if (_Entries.Size() < 2)
+		{
+			return;
+		}
+
+		_DrawKeys.Resize<false>(_Entries.Size());
+
+		for (uint64 i{ 0 }; i < _Entries.Size(); ++i)
+		{
+			_DrawKeys[i] = _Entries[i]._DrawKey;
+		}
+
+		_DrawOrder.Resize<false>(_Entries.Size());
+
+		SortingAlgorithms::RadixSort(_DrawKeys.Data(), _Entries.Size(), _DrawOrder.Data());
+	}
+
 };
\ No newline at end of file
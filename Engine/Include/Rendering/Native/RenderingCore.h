@@ -600,6 +600,13 @@ enum class TextureFormat : uint8
 	//Depth formats.
 	D_UINT16,
 	D_UINT24_S_UINT8,
+
+	//Block compressed formats.
+	RGB_BC1,
+	RGBA_BC3,
+	R_BC4,
+	RG_BC5,
+	RGB_BC6H
 };
 
 //Enumeration covering all texture usages.
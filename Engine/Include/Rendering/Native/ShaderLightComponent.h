@@ -51,7 +51,7 @@ public:
 	//The intensity.
 	float32 _Intensity;
 
-	//The radius.
+	//The radius. For point lights, this is their range of influence.
 	float32 _Radius;
 
 	//The size.
@@ -3,6 +3,16 @@
 //Core.
 #include <Core/Essential/CatalystEssential.h>
 #include <Core/Containers/DynamicArray.h>
+#include <Core/General/Pair.h>
+
+//Concurrency.
+#include <Concurrency/Spinlock.h>
+
+//Content.
+#include <Content/Assets/MaterialAsset.h>
+
+//Entities.
+#include <Entities/Core/Entity.h>
 
 //Math.
 #include <Math/General/Matrix.h>
@@ -12,6 +22,9 @@
 #include <Rendering/Native/Frustum.h>
 #include <Rendering/Native/RenderInputStream.h>
 
+//World.
+#include <World/Core/WorldSpaceAxisAlignedBoundingBox3D.h>
+
 class ShadowsSystem final
 {
 
@@ -82,27 +95,158 @@ public:
 		return _ShadowMapData[index];
 	}
 
+	/*
+	*	Callback for when a static model instance is created.
+	*/
+	void OnStaticModelInstanceCreated(Entity *const RESTRICT entity, const WorldSpaceAxisAlignedBoundingBox3D &box) NOEXCEPT;
+
+	/*
+	*	Callback for when a static model instance is destroyed.
+	*/
+	void OnStaticModelInstanceDestroyed(Entity *const RESTRICT entity, const WorldSpaceAxisAlignedBoundingBox3D &box) NOEXCEPT;
+
+	/*
+	*	Callback for when a static model instance has moved, or otherwise changed how it casts shadows.
+	*	Can be called from multiple threads at once.
+	*/
+	void OnStaticModelInstanceMoved(Entity *const RESTRICT entity, const WorldSpaceAxisAlignedBoundingBox3D &previous_box, const WorldSpaceAxisAlignedBoundingBox3D &current_box) NOEXCEPT;
+
 private:
 
+	/*
+	*	Shadow caster cache class definition.
+	*	The static shadow casters of one shadow map, gathered against a region somewhat larger than the shadow map.
+	*	They are reused until the shadow map moves out of that region, the light changes, or a static model inside the region changes.
+	*/
+	class ShadowCasterCache final
+	{
+
+	public:
+
+		/*
+		*	Cached casters class definition.
+		*/
+		class CachedCasters final
+		{
+
+		public:
+
+			//The entries.
+			DynamicArray<RenderInputStreamEntry> _Entries;
+
+			//The push constant data memory.
+			DynamicArray<byte> _PushConstantDataMemory;
+
+			//The draw order of the input stream as of the last time it was rebuilt, as the render input manager clears it before every gather.
+			DynamicArray<uint32> _DrawOrder;
+
+			//The generation these casters were gathered for.
+			uint64 _Generation{ UINT64_MAXIMUM };
+
+			//Denotes whether or not dynamic casters were added to the input stream last time it was gathered.
+			bool _HadDynamicCasters{ false };
+
+		};
+
+		//The light matrix of the region.
+		Matrix4x4 _LightMatrix;
+
+		//The minimum of the region, in light space.
+		Vector3<float32> _Minimum;
+
+		//The maximum of the region, in light space.
+		Vector3<float32> _Maximum;
+
+		//The world to light matrix of the region.
+		Matrix4x4 _WorldToLightMatrix;
+
+		//The frustum of the region.
+		Frustum _Frustum;
+
+		//The light direction the region was created for.
+		Vector3<float32> _Direction;
+
+		//The camera cell the region was created in.
+		Vector3<int32> _CameraCell;
+
+		//The world grid cell the cached push constant data is relative to.
+		Vector3<int32> _WorldGridCell;
+
+		//The generation. Incremented whenever the cache is invalidated.
+		uint64 _Generation{ 0 };
+
+		//Denotes whether or not the region is valid.
+		bool _RegionValid{ false };
+
+		//The opaque casters.
+		CachedCasters _OpaqueCasters;
+
+		//The masked casters.
+		CachedCasters _MaskedCasters;
+
+	};
+
+	/*
+	*	Dynamic shadow caster class definition.
+	*	A static model that has moved recently. These are left out of the caches, and gathered every frame instead.
+	*/
+	class DynamicShadowCaster final
+	{
+
+	public:
+
+		//The entity.
+		Entity *RESTRICT _Entity;
+
+		//The number of frames since this caster last moved.
+		uint32 _FramesSinceMoved;
+
+	};
+
 	//The shadow map data.
 	DynamicArray<ShadowMapData> _ShadowMapData;
 
+	//The shadow caster caches, one per shadow map data.
+	DynamicArray<ShadowCasterCache> _ShadowCasterCaches;
+
+	//The dynamic shadow casters.
+	DynamicArray<DynamicShadowCaster> _DynamicShadowCasters;
+
+	//Flags for which entities are dynamic shadow casters, indexed by entity identifier.
+	DynamicArray<bool> _DynamicShadowCasterFlags;
+
+	//The lock for the pending changes.
+	Spinlock _PendingChangesLock;
+
+	//The regions that were changed since the last update, and invalidates any cache they touch.
+	DynamicArray<WorldSpaceAxisAlignedBoundingBox3D> _PendingInvalidationRegions;
+
+	//The static models that have moved since the last update, with the box they moved from.
+	DynamicArray<Pair<Entity *RESTRICT, WorldSpaceAxisAlignedBoundingBox3D>> _PendingMovedEntities;
+
 	/*
-	*	Gathers an opaque model input stream.
+	*	Updates the shadow caster caches.
 	*/
-	void GatherOpaqueModelInputStream
-	(
-		const uint8 shadow_map_data_index,
-		RenderInputStream *const RESTRICT input_stream
-	) NOEXCEPT;
+	void UpdateShadowCasterCaches() NOEXCEPT;
+
+	/*
+	*	Returns if the given entity is a dynamic shadow caster.
+	*/
+	NO_DISCARD bool IsDynamicShadowCaster(const Entity *const RESTRICT entity) const NOEXCEPT;
 
 	/*
-	*	Gathers a masked model input stream.
+	*	Sets whether or not the given entity is a dynamic shadow caster.
 	*/
-	void GatherMaskedModelInputStream
+	void SetDynamicShadowCaster(const Entity *const RESTRICT entity, const bool value) NOEXCEPT;
+
+	/*
+	*	Gathers a model input stream with the given material type.
+	*/
+	void GatherModelInputStream
 	(
-		const uint8 shadow_map_data_index,
-		RenderInputStream* const RESTRICT input_stream
+		const uint8 shadow_map_index,
+		const MaterialAsset::Type material_type,
+		RenderInputStream *const RESTRICT input_stream
 	) NOEXCEPT;
 
 };
\ No newline at end of file
@@ -137,6 +137,13 @@ public:
 	*/
 	virtual void UploadDataToBuffer(const void *const RESTRICT *const RESTRICT data, const uint64 *const RESTRICT data_sizes, const uint8 data_chunks, BufferHandle *const RESTRICT handle) const NOEXCEPT = 0;
 
+	/*
+	*	Maps a host visible buffer and returns a pointer to it's memory.
+	*	The mapping is persistent, and stays valid until the buffer is destroyed.
+	*	Returns nullptr if the backend can't map buffers, in which case data needs to go through UploadDataToBuffer() instead.
+	*/
+	virtual RESTRICTED NO_DISCARD void *const RESTRICT MapBuffer(const BufferHandle handle) const NOEXCEPT = 0;
+
 	/*
 	*	Destroys a buffer.
 	*/
@@ -290,6 +297,19 @@ public:
 	*/
 	virtual void UpdateTexture2D(const TextureDataContainer &texture_data_container, Texture2DHandle *const RESTRICT handle) const NOEXCEPT = 0;
 
+	/*
+	*	Updates a region of a texture 2D, copying the given rectangle of the first mip level from the given texture data, which covers the whole texture.
+	*/
+	virtual void UpdateTexture2DRegion
+	(
+		const TextureDataContainer &texture_data_container,
+		const uint32 X,
+		const uint32 Y,
+		const uint32 width,
+		const uint32 height,
+		Texture2DHandle *const RESTRICT handle
+	) const NOEXCEPT = 0;
+
 	/*
 	*	Destroys a texture 2D.
 	*/
@@ -18,8 +18,59 @@ public:
 
 		/*
 		*	Applies BC7 texture compression.
+		*	Four channels, 16 bytes per 4x4 block. Highest quality, good for color textures with alpha.
 		*/
-		BC7
+		BC7,
+
+		/*
+		*	Applies BC1 texture compression.
+		*	Three channels, 8 bytes per 4x4 block. Alpha always reads as 1.0f, so this is meant for opaque textures.
+		*/
+		BC1,
+
+		/*
+		*	Applies BC3 texture compression.
+		*	Four channels, 16 bytes per 4x4 block. BC1 color with a separately compressed alpha channel.
+		*/
+		BC3,
+
+		/*
+		*	Applies BC4 texture compression.
+		*	One channel (red), 8 bytes per 4x4 block. Good for masks, roughness, height maps etc.
+		*/
+		BC4,
+
+		/*
+		*	Applies BC5 texture compression.
+		*	Two channels (red and green), 16 bytes per 4x4 block. Good for tangent space normal maps, where blue is reconstructed.
+		*/
+		BC5,
+
+		/*
+		*	Applies BC6H texture compression.
+		*	Three channels of unsigned half precision floating point data, 16 bytes per 4x4 block. Meant for HDR textures.
+		*	Compresses from 32-bit floating point data instead of 8-bit data.
+		*/
+		BC6H
+	};
+
+	//Enumeration covering all qualities.
+	enum class Quality : uint8
+	{
+		/*
+		*	Picks endpoints from the bounding box of each block. Fast, but lower quality.
+		*/
+		FAST,
+
+		/*
+		*	Fits endpoints along the principal axis of each block.
+		*/
+		NORMAL,
+
+		/*
+		*	Like NORMAL, but also refines the endpoints iteratively. Slowest, but highest quality.
+		*/
+		HIGH
 	};
 
 	//The mode.
@@ -28,36 +79,41 @@ public:
 	//Denotes whether or not the compression should be perceptual (good for color images) or not (linear, good for stuff like roughness maps).
 	bool _Perceptual{ false };
 
+	//The quality.
+	Quality _Quality{ Quality::NORMAL };
+
 	/*
-	*	Returns the compression ratio for a 2D texture.
+	*	Returns the compression ratio for a 2D texture, compared to uncompressed 8-bit RGBA.
 	*/
 	NO_DISCARD uint32 CompressionRatio() const NOEXCEPT;
 
 	/*
-	*	Returns the size required for compression for a 2D texture.
+	*	Returns the size, in bytes, of each compressed 4x4 block.
 	*/
-	NO_DISCARD uint64 Size2D(const uint32 width, const uint32 height) const NOEXCEPT;
+	NO_DISCARD uint32 BlockSize() const NOEXCEPT;
 
 	/*
-	*	Compresses a 2D texture.
+	*	Returns the size required for compression for a 2D texture.
+	*	Textures that aren't a multiple of four in either dimension are padded to whole blocks.
 	*/
-	void Compress2D(const byte *const RESTRICT input_data, const uint32 width, const uint32 height, byte *const RESTRICT output_data) const NOEXCEPT;
+	NO_DISCARD uint64 Size2D(const uint32 width, const uint32 height) const NOEXCEPT;
 
 	/*
-	*	Decompresses a 2D texture.
+	*	Compresses a 2D texture from 8-bit RGBA data.
+	*	The blocks are split across the task system, and this function returns when all are done.
 	*/
-	void Decompress2D(const byte *const RESTRICT input_data, const uint32 width, const uint32 height, byte *const RESTRICT output_data) NOEXCEPT;
-
-private:
+	void Compress2D(const byte *const RESTRICT input_data, const uint32 width, const uint32 height, byte *const RESTRICT output_data) const NOEXCEPT;
 
 	/*
-	*	Compresses a 2D texture with the BC7 mode.
+	*	Compresses a 2D texture from 32-bit floating point RGBA data. Only valid for BC6H.
+	*	The blocks are split across the task system, and this function returns when all are done.
 	*/
-	void Compress2DBC7(const byte *const RESTRICT input_data, const uint32 width, const uint32 height, byte *const RESTRICT output_data) const NOEXCEPT;
+	void Compress2D(const float32 *const RESTRICT input_data, const uint32 width, const uint32 height, byte *const RESTRICT output_data) const NOEXCEPT;
 
 	/*
-	*	Decompresses a 2D texture with the BC7 mode.
+	*	Decompresses a 2D texture into 8-bit RGBA data.
+	*	Channels that aren't stored by the mode are decoded the way the GPU does it (zero for color channels, one for alpha).
 	*/
-	void Decompress2DBC7(const byte *const RESTRICT input_data, const uint32 width, const uint32 height, byte *const RESTRICT output_data) NOEXCEPT;
+	void Decompress2D(const byte *const RESTRICT input_data, const uint32 width, const uint32 height, byte *const RESTRICT output_data) NOEXCEPT;
 
 };
\ No newline at end of file
@@ -188,6 +188,25 @@ public:
 		_TextureTexelSize = sizeof(byte);
 	}
 
+	/*
+	*	Constructor taking pointers to the data of each mip level, for example views into a mapped file.
+	*/
+	FORCE_INLINE TextureDataContainer(const DynamicArray<const byte *RESTRICT> &initialTextureData, const uint32 initialTextureWidth, const uint32 initialTextureHeight, const uint8 initilTextureChannels) NOEXCEPT
+	{
+		_TextureData.Reserve(initialTextureData.Size());
+
+		for (const byte *const RESTRICT initialTextureDataChunk : initialTextureData)
+		{
+			_TextureData.Emplace(initialTextureDataChunk);
+		}
+
+		_TextureWidth = initialTextureWidth;
+		_TextureHeight = initialTextureHeight;
+		_TextureDepth = 1;
+		_TextureChannels = initilTextureChannels;
+		_TextureTexelSize = sizeof(byte);
+	}
+
 	/*
 	*	Constructor taking a double dynamic array of floats.
 	*/
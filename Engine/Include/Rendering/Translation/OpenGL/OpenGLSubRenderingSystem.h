@@ -102,6 +102,11 @@ public:
 	*/
 	void UploadDataToBuffer(const void *const RESTRICT *const RESTRICT data, const uint64 *const RESTRICT data_sizes, const uint8 data_chunks, BufferHandle *const RESTRICT handle) const NOEXCEPT override;
 
+	/*
+	*	Maps a host visible buffer and returns a pointer to it's memory.
+	*/
+	RESTRICTED NO_DISCARD void *const RESTRICT MapBuffer(const BufferHandle handle) const NOEXCEPT override;
+
 	/*
 	*	Destroys a buffer.
 	*/
@@ -255,6 +260,19 @@ public:
 	*/
 	void UpdateTexture2D(const TextureDataContainer &texture_data_container, Texture2DHandle *const RESTRICT handle) const NOEXCEPT override;
 
+	/*
+	*	Updates a region of a texture 2D, copying the given rectangle of the first mip level from the given texture data, which covers the whole texture.
+	*/
+	void UpdateTexture2DRegion
+	(
+		const TextureDataContainer &texture_data_container,
+		const uint32 X,
+		const uint32 Y,
+		const uint32 width,
+		const uint32 height,
+		Texture2DHandle *const RESTRICT handle
+	) const NOEXCEPT override;
+
 	/*
 	*	Destroys a texture 2D.
 	*/
@@ -308,6 +308,11 @@ public:
 			case TextureFormat::RGBA_FLOAT32: return VkFormat::VK_FORMAT_R32G32B32A32_SFLOAT;
 			case TextureFormat::D_UINT24_S_UINT8: return VkFormat::VK_FORMAT_D24_UNORM_S8_UINT;
 			case TextureFormat::D_UINT16: return VkFormat::VK_FORMAT_D16_UNORM;
+			case TextureFormat::RGB_BC1: return VkFormat::VK_FORMAT_BC1_RGB_UNORM_BLOCK;
+			case TextureFormat::RGBA_BC3: return VkFormat::VK_FORMAT_BC3_UNORM_BLOCK;
+			case TextureFormat::R_BC4: return VkFormat::VK_FORMAT_BC4_UNORM_BLOCK;
+			case TextureFormat::RG_BC5: return VkFormat::VK_FORMAT_BC5_UNORM_BLOCK;
+			case TextureFormat::RGB_BC6H: return VkFormat::VK_FORMAT_BC6H_UFLOAT_BLOCK;
 
 			default:
 			{
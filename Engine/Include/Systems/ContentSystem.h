@@ -24,6 +24,7 @@
 class BinaryInputFile;
 class BinaryOutputFile;
 class ContentCache;
+class ContentStore;
 
 //Type aliases.
 using OnAssetCompiledCallback = bool(*)(const HashString asset_type_identifier, const char *const RESTRICT file_path);
@@ -124,6 +125,9 @@ private:
 		//The context.
 		AssetCompiler::CompileContext _Context;
 
+		//The source key.
+		uint64 _SourceKey;
+
 		//The task.
 		Task _Task;
 
@@ -162,6 +166,15 @@ private:
 		//Denotes if a recompile should be triggered.
 		bool _TriggerRecompile{ false };
 
+		//The number of assets that were up to date.
+		uint64 _NumberOfUpToDateAssets{ 0 };
+
+		//The number of assets that were restored from the content store.
+		uint64 _NumberOfRestoredAssets{ 0 };
+
+		//The number of assets that were compiled.
+		uint64 _NumberOfCompiledAssets{ 0 };
+
 	};
 
 	//The asset compilers.
@@ -198,15 +211,16 @@ private:
 	(
 		const CompilationDomain compilation_domain,
 		ContentCache *const RESTRICT content_cache,
+		ContentStore *const RESTRICT content_store,
 		const char *const RESTRICT directory_path,
 		const char *const RESTRICT collection,
 		CompileResult *const RESTRICT compile_result
 	) NOEXCEPT;
 
 	/*
-	*	Creates asset collections from the given directory path.
+	*	Creates asset collections from the given directory path, keeping track of the current position in the given file.
 	*/
-	void CreateAssetCollections(const char *const RESTRICT directory_path, BinaryOutputFile *const RESTRICT file) NOEXCEPT;
+	void CreateAssetCollections(const char *const RESTRICT directory_path, BinaryOutputFile *const RESTRICT file, uint64 *const RESTRICT file_position) NOEXCEPT;
 
 #if !defined(CATALYST_CONFIGURATION_FINAL)
 	/*
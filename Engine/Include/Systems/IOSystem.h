@@ -0,0 +1,122 @@
+#pragma once
+
+//Core.
+#include <Core/Essential/CatalystEssential.h>
+#include <Core/Containers/DynamicArray.h>
+#include <Core/Containers/StaticArray.h>
+#include <Core/General/StaticString.h>
+
+//Concurrency.
+#include <Concurrency/AtomicFlag.h>
+#include <Concurrency/Spinlock.h>
+#include <Concurrency/Thread.h>
+
+//File.
+#include <File/Core/IORequest.h>
+
+//Systems.
+#include <Systems/System.h>
+
+/*
+*	The I/O system carries out file reads and writes on a small, fixed set of I/O threads, which bounds the number of operations in flight at any time.
+*	Pending requests are served by missed deadline first, then by priority, then by deadline, then in the order they were submitted.
+*	Reads of the same file that pick up where another read leaves off are coalesced, so they're served with a single open and seek.
+*	When the I/O threads aren't running, such as before the I/O system is initialized or after it is terminated, requests are carried out right away on the submitting thread.
+*/
+class IOSystem final
+{
+
+public:
+
+	//System declaration.
+	CATALYST_SYSTEM
+	(
+		IOSystem,
+		SYSTEM_INITIALIZE()
+		SYSTEM_TERMINATE()
+	);
+
+	/*
+	*	Default constructor.
+	*/
+	FORCE_INLINE IOSystem() NOEXCEPT
+	{
+
+	}
+
+	/*
+	*	Submits a request.
+	*/
+	void Submit(IORequest *const RESTRICT request) NOEXCEPT;
+
+private:
+
+	/*
+	*	Busy file class definition.
+	*/
+	class BusyFile final
+	{
+
+	public:
+
+		//The file path.
+		StaticString<MAXIMUM_FILE_PATH_LENGTH> _FilePath;
+
+		//Denotes whether or not the file is being written.
+		bool _IsBeingWritten;
+
+	};
+
+	//The number of I/O threads, which is also the maximum number of operations in flight.
+	constexpr static uint64 NUMBER_OF_THREADS{ 2 };
+
+	//The I/O threads.
+	StaticArray<Thread, NUMBER_OF_THREADS> _Threads;
+
+	//Denotes whether or not the I/O threads are running.
+	AtomicFlag _IsRunning{ false };
+
+	//The pending requests lock.
+	Spinlock _PendingRequestsLock;
+
+	//The pending requests.
+	DynamicArray<IORequest *RESTRICT> _PendingRequests;
+
+	/*
+	*	The files the I/O threads are busy with, guarded by the pending requests lock.
+	*	Requests that conflict with these are held back, so that a write never overlaps other reads or writes of the same file.
+	*/
+	DynamicArray<BusyFile> _BusyFiles;
+
+	/*
+	*	Executes on an I/O thread.
+	*/
+	void Execute() NOEXCEPT;
+
+	/*
+	*	Takes the next requests out of the pending requests and carries them out. Returns if there were any.
+	*/
+	NO_DISCARD bool ProcessNextRequests(DynamicArray<IORequest *RESTRICT> *const RESTRICT requests) NOEXCEPT;
+
+	/*
+	*	Returns if the given request conflicts with any of the busy files.
+	*/
+	NO_DISCARD bool IsBlocked(const IORequest *const RESTRICT request) const NOEXCEPT;
+
+	/*
+	*	Takes the next requests to carry out out of the pending requests. Returns if there were any.
+	*	The first request is the most urgent one, followed by any reads it could be coalesced with, in file order.
+	*/
+	NO_DISCARD bool TakeRequests(DynamicArray<IORequest *RESTRICT> *const RESTRICT requests) NOEXCEPT;
+
+	/*
+	*	Carries out the given requests.
+	*/
+	void Process(const DynamicArray<IORequest *RESTRICT> &requests) NOEXCEPT;
+
+	/*
+	*	Completes the given request.
+	*/
+	void Complete(IORequest *const RESTRICT request) NOEXCEPT;
+
+};
\ No newline at end of file
@@ -3,6 +3,10 @@
 //Core.
 #include <Core/Essential/CatalystEssential.h>
 #include <Core/Containers/DynamicArray.h>
+#include <Core/General/Time.h>
+
+//Concurrency.
+#include <Concurrency/Task.h>
 
 //Content.
 #include <Content/Core/AssetPointer.h>
@@ -14,9 +18,7 @@
 //World.
 #include <World/Core/WorldTransform.h>
 #include <World/Level/Level.h>
-
-//Forward declarations.
-class ComponentInitializationData;
+#include <World/Level/StreamedLevel.h>
 
 class LevelSystem final
 {
@@ -26,16 +28,41 @@ public:
 	//System declaration.
 	CATALYST_SYSTEM
 	(
-		LevelSystem
+		LevelSystem,
+		SYSTEM_INITIALIZE()
+		SYSTEM_UPDATE(RANGE(PRE, ENTITY))
 	);
 
 	//Type aliases.
-	using SpawnFunction = void(*)
-	(
-		ComponentInitializationData *const RESTRICT initialization_data,
-		const uint64 entity_identifier,
-		void *const RESTRICT user_data
-	);
+	using SpawnFunction = LevelSpawnFunction;
+
+	/*
+	*	Streaming statistics class definition.
+	*/
+	class StreamingStatistics final
+	{
+
+	public:
+
+		//The number of resident cells.
+		uint64 _NumberOfResidentCells{ 0 };
+
+		//The number of resident entities.
+		uint64 _NumberOfResidentEntities{ 0 };
+
+		//The memory held by resident cells, measured as the size of their serialized entities, in bytes.
+		uint64 _ResidentMemory{ 0 };
+
+		//The number of cells that are waiting to be spawned or despawned.
+		uint64 _NumberOfPendingCells{ 0 };
+
+		//The duration of the last streaming batch, in seconds.
+		float32 _LastBatchDuration{ 0.0f };
+
+		//The duration of the longest streaming batch so far, in seconds.
+		float32 _LongestBatchDuration{ 0.0f };
+
+	};
 
 	/*
 	*	Default constructor.
@@ -62,4 +89,121 @@ public:
 	*/
 	void DespawnLevel(Level *const RESTRICT level) NOEXCEPT;
 
+	/*
+	*	Starts streaming a level.
+	*	Instead of spawning everything at once, the level's cells are spawned when the camera comes within the load radius of them,
+	*	and despawned when it moves beyond the unload radius, in time budgeted batches on a background task.
+	*/
+	void StartStreamingLevel
+	(
+		const WorldTransform &world_transform,
+		const AssetPointer<LevelAsset> level_asset,
+		StreamedLevel *const RESTRICT level,
+		SpawnFunction spawn_function = nullptr,
+		void *const RESTRICT spawn_function_user_data = nullptr
+	) NOEXCEPT;
+
+	/*
+	*	Stops streaming the given level, despawning all of it.
+	*/
+	void StopStreamingLevel(StreamedLevel *const RESTRICT level) NOEXCEPT;
+
+	/*
+	*	Sets the streaming radii, in cells.
+	*	The unload radius should be larger than the load radius, so that cells near the edge don't keep getting spawned and despawned.
+	*/
+	FORCE_INLINE void SetStreamingRadii(const uint32 load_radius, const uint32 unload_radius) NOEXCEPT
+	{
+		ASSERT(unload_radius > load_radius, "The unload radius should be larger than the load radius!");
+
+		_LoadRadius = load_radius;
+		_UnloadRadius = unload_radius;
+	}
+
+	/*
+	*	Sets the streaming time budget, in seconds. This is how long a single streaming batch is allowed to run.
+	*/
+	FORCE_INLINE void SetStreamingTimeBudget(const float32 value) NOEXCEPT
+	{
+		_StreamingTimeBudget = value;
+	}
+
+	/*
+	*	Returns the streaming statistics, as of the last update.
+	*/
+	FORCE_INLINE NO_DISCARD const StreamingStatistics &GetStreamingStatistics() const NOEXCEPT
+	{
+		return _StreamingStatistics;
+	}
+
+private:
+
+	/*
+	*	Streaming work class definition.
+	*/
+	class StreamingWork final
+	{
+
+	public:
+
+		//The level.
+		StreamedLevel *RESTRICT _Level;
+
+		//The cell index.
+		uint64 _CellIndex;
+
+		//The distance, in cells, from the camera.
+		uint32 _Distance;
+
+	};
+
+	//The streamed levels.
+	DynamicArray<StreamedLevel *RESTRICT> _StreamedLevels;
+
+	//The load radius, in cells.
+	uint32 _LoadRadius{ 2 };
+
+	//The unload radius, in cells.
+	uint32 _UnloadRadius{ 3 };
+
+	//The streaming time budget, in seconds.
+	float32 _StreamingTimeBudget{ 0.002f };
+
+	//The streaming work, carried out by the streaming task.
+	DynamicArray<StreamingWork> _StreamingWork;
+
+	//The streaming task.
+	Task _StreamingTask;
+
+	//The streaming statistics.
+	StreamingStatistics _StreamingStatistics;
+
+	/*
+	*	Spawns the next entity from the given level asset, advancing the stream archive position past it.
+	*/
+	NO_DISCARD Entity *const RESTRICT SpawnEntity
+	(
+		const WorldTransform &world_transform,
+		const LevelAsset &level_asset,
+		uint64 *const RESTRICT stream_archive_position,
+		uint64 *const RESTRICT entity_identifier,
+		SpawnFunction spawn_function,
+		void *const RESTRICT spawn_function_user_data
+	) NOEXCEPT;
+
+	/*
+	*	Carries out the streaming work, until it's done or the time budget runs out.
+	*/
+	void ProcessStreamingWork() NOEXCEPT;
+
+	/*
+	*	Continues spawning the given cell. Returns if it is done.
+	*/
+	NO_DISCARD bool ContinueSpawningCell(StreamedLevel *const RESTRICT level, const uint64 cell_index, const TimePoint &start_time) NOEXCEPT;
+
+	/*
+	*	Continues despawning the given cell. Returns if it is done.
+	*/
+	NO_DISCARD bool ContinueDespawningCell(StreamedLevel *const RESTRICT level, const uint64 cell_index, const TimePoint &start_time) NOEXCEPT;
+
 };
\ No newline at end of file
@@ -339,6 +339,13 @@ public:
 	*/
 	void UploadDataToBuffer(const void *const RESTRICT *const RESTRICT data, const uint64 *const RESTRICT data_sizes, const uint8 data_chunks, BufferHandle *const RESTRICT handle) const NOEXCEPT;
 
+	/*
+	*	Maps a host visible buffer and returns a pointer to it's memory.
+	*	The mapping is persistent, and stays valid until the buffer is destroyed.
+	*	Returns nullptr if the backend can't map buffers, in which case data needs to go through UploadDataToBuffer() instead.
+	*/
+	RESTRICTED NO_DISCARD void *const RESTRICT MapBuffer(const BufferHandle handle) const NOEXCEPT;
+
 	/*
 	*	Destroys a buffer.
 	*/
@@ -497,6 +504,19 @@ public:
 	*/
 	void UpdateTexture2D(const TextureDataContainer &texture_data_container, Texture2DHandle *const RESTRICT handle) NOEXCEPT;
 
+	/*
+	*	Updates a region of a texture 2D, copying the given rectangle of the first mip level from the given texture data, which covers the whole texture.
+	*/
+	void UpdateTexture2DRegion
+	(
+		const TextureDataContainer &texture_data_container,
+		const uint32 X,
+		const uint32 Y,
+		const uint32 width,
+		const uint32 height,
+		Texture2DHandle *const RESTRICT handle
+	) NOEXCEPT;
+
 	/*
 	*	Destroys a texture 2D.
 	*/
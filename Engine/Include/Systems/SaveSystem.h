@@ -7,6 +7,9 @@
 //Concurrency.
 #include <Concurrency/Task.h>
 
+//File.
+#include <File/Core/IORequest.h>
+
 //Save.
 #include <Save/SaveCore.h>
 #include <Save/SaveEntry.h>
@@ -83,11 +86,19 @@ private:
 	//The process saves task.
 	Task _ProcessSavesTask;
 
+	//The write requests that have been submitted to the I/O system, which are freed once they're completed.
+	DynamicArray<IORequest *RESTRICT> _WriteRequests;
+
 	/*
 	*	Processes the saves.
 	*/
 	void ProcessSaves() NOEXCEPT;
 
+	/*
+	*	Frees the write requests that are completed. Optionally waits for all of them to be completed first.
+	*/
+	void FreeWriteRequests(const bool wait) NOEXCEPT;
+
 	/*
 	*	Loads a single entry.
 	*/
@@ -0,0 +1,303 @@
+#pragma once
+
+//Core.
+#include <Core/Essential/CatalystEssential.h>
+#include <Core/Containers/DynamicArray.h>
+#include <Core/Algorithms/HashAlgorithms.h>
+
+//Concurrency.
+#include <Concurrency/ReadWriteSpinlock.h>
+
+//Entities.
+#include <Entities/Core/Entity.h>
+
+//Math.
+#include <Math/Geometry/AxisAlignedBoundingBox3D.h>
+
+//Systems.
+#include <Systems/System.h>
+
+//World.
+#include <World/Core/SpatialIndexQuery.h>
+
+//STL.
+#include <unordered_map>
+
+/*
+*	The spatial index system keeps track of where every entity with a world transform is, so that nearby entities can be found without scanning component instance arrays.
+*	Entities are kept in a hierarchical, loose hashed grid, where each level has buckets four times as large as the level below it.
+*	An entity goes into the smallest level whose buckets are at least as large as it's bounds, in the bucket containing the center of it's bounds,
+*	so every bucket only needs to be expanded by half it's size to cover everything in it.
+*	Bucket coordinates are derived from world cells and local positions together, so the index covers the whole world without losing precision.
+*	The index is updated incrementally after transforms and bounds are final for the frame, only touching entities that were added or moved.
+*	Queries can be made from any thread at any time, and are answered against the index as of the end of the last update.
+*/
+class SpatialIndexSystem final
+{
+
+public:
+
+	//System declaration.
+	CATALYST_SYSTEM
+	(
+		SpatialIndexSystem,
+		SYSTEM_UPDATE(RANGE(RENDER, POST))
+	);
+
+	/*
+	*	Default constructor.
+	*/
+	FORCE_INLINE SpatialIndexSystem() NOEXCEPT
+	{
+
+	}
+
+	/*
+	*	Removes the given entity from the index right away, so that queries stop returning it.
+	*	The entity system calls this when an entity is destroyed, before it's memory and identifier are freed.
+	*	Entities are destroyed outside of the update range of this system, so this never runs alongside an update.
+	*/
+	void RemoveEntity(Entity *const RESTRICT entity) NOEXCEPT;
+
+	/*
+	*	Returns if the given entity is in the index.
+	*/
+	NO_DISCARD bool IsInIndex(Entity *const RESTRICT entity) const NOEXCEPT;
+
+	/*
+	*	Executes the given query.
+	*/
+	void ExecuteQuery(SpatialIndexQuery *const RESTRICT query) NOEXCEPT;
+
+	/*
+	*	Executes the given queries. Large batches are split across the task system, and this function returns when all queries are answered.
+	*/
+	void ExecuteQueries(SpatialIndexQuery *const RESTRICT queries, const uint64 number_of_queries) NOEXCEPT;
+
+	/*
+	*	Returns the number of entities in the index.
+	*/
+	FORCE_INLINE NO_DISCARD uint64 GetNumberOfEntities() const NOEXCEPT
+	{
+		return _EntryEntities.Size();
+	}
+
+private:
+
+	/*
+	*	Bucket key class definition.
+	*	Holds the full level and coordinates, so distinct buckets never share a key.
+	*/
+	class BucketKey final
+	{
+
+	public:
+
+		//The level.
+		uint8 _Level;
+
+		//The coordinates, in multiples of the bucket size of the level.
+		Vector3<int64> _Coordinates;
+
+		/*
+		*	Equality operator overload.
+		*/
+		FORCE_INLINE NO_DISCARD bool operator==(const BucketKey &other) const NOEXCEPT
+		{
+			return _Level == other._Level && _Coordinates == other._Coordinates;
+		}
+
+	};
+
+	/*
+	*	Bucket key hash class definition.
+	*/
+	class BucketKeyHash final
+	{
+
+	public:
+
+		/*
+		*	Function call operator overload.
+		*/
+		FORCE_INLINE NO_DISCARD size_t operator()(const BucketKey &key) const NOEXCEPT
+		{
+			return static_cast<size_t>(HashAlgorithms::MurmurHash64(&key._Coordinates, sizeof(Vector3<int64>), key._Level));
+		}
+
+	};
+
+	/*
+	*	Bucket class definition.
+	*/
+	class Bucket final
+	{
+
+	public:
+
+		//The level.
+		uint8 _Level;
+
+		//The coordinates, in multiples of the bucket size of the level.
+		Vector3<int64> _Coordinates;
+
+		//The entry indices.
+		DynamicArray<uint32> _EntryIndices;
+
+	};
+
+	/*
+	*	Pending update class definition.
+	*/
+	class PendingUpdate final
+	{
+
+	public:
+
+		//The entity.
+		Entity *RESTRICT _Entity;
+
+		//The cell.
+		Vector3<int32> _Cell;
+
+		//The box, relative to the cell.
+		AxisAlignedBoundingBox3D _Box;
+
+	};
+
+	/*
+	*	Gather range class definition.
+	*/
+	class GatherRange final
+	{
+
+	public:
+
+		//The first instance index.
+		uint64 _FirstInstanceIndex;
+
+		//The last instance index, exclusive.
+		uint64 _LastInstanceIndex;
+
+		//The pending updates.
+		DynamicArray<PendingUpdate> _PendingUpdates;
+
+	};
+
+	/*
+	*	Query batch class definition.
+	*/
+	class QueryBatch final
+	{
+
+	public:
+
+		//The queries.
+		SpatialIndexQuery *RESTRICT _Queries;
+
+		//The number of queries.
+		uint64 _NumberOfQueries;
+
+	};
+
+	//The number of levels, not counting the oversized level.
+	constexpr static uint8 NUMBER_OF_LEVELS{ 6 };
+
+	//The oversized level, holding the entities that are too large for any other level. It only has a single bucket, which every query goes through.
+	constexpr static uint8 OVERSIZED_LEVEL{ NUMBER_OF_LEVELS };
+
+	//Constant denoting an invalid entry index.
+	constexpr static uint32 INVALID_ENTRY_INDEX{ UINT32_MAXIMUM };
+
+	//The lock, taken for reading by queries and for writing while the index is updated.
+	mutable ReadWriteSpinlock _Lock;
+
+	//The entity to entry mappings, indexed by entity identifier.
+	DynamicArray<uint32> _EntityToEntryMappings;
+
+	//The entities of all entries.
+	DynamicArray<Entity *RESTRICT> _EntryEntities;
+
+	//The cells of all entries.
+	DynamicArray<Vector3<int32>> _EntryCells;
+
+	//The boxes of all entries, relative to their cell.
+	DynamicArray<AxisAlignedBoundingBox3D> _EntryBoxes;
+
+	//The bucket indices of all entries.
+	DynamicArray<uint32> _EntryBucketIndices;
+
+	//The slot of each entry in it's bucket's entry indices.
+	DynamicArray<uint32> _EntryBucketSlots;
+
+	//The buckets.
+	DynamicArray<Bucket> _Buckets;
+
+	//The key to bucket mappings.
+	std::unordered_map<BucketKey, uint32, BucketKeyHash> _KeyToBucketMappings;
+
+	//The number of non-empty buckets per level.
+	uint64 _NumberOfBucketsPerLevel[NUMBER_OF_LEVELS + 1]{ };
+
+	//The number of empty buckets, which are compacted away once they start piling up.
+	uint64 _NumberOfEmptyBuckets{ 0 };
+
+	//The gather ranges.
+	DynamicArray<GatherRange> _GatherRanges;
+
+	/*
+	*	Returns the entry index for the given entity, or an invalid entry index if it isn't in the index.
+	*/
+	NO_DISCARD uint32 GetEntryIndex(Entity *const RESTRICT entity) const NOEXCEPT;
+
+	/*
+	*	Gathers the pending updates for the given range of world transform instances.
+	*/
+	void GatherPendingUpdates(GatherRange *const RESTRICT gather_range) const NOEXCEPT;
+
+	/*
+	*	Applies the given pending update.
+	*/
+	void ApplyPendingUpdate(const PendingUpdate &pending_update) NOEXCEPT;
+
+	/*
+	*	Finds or creates the bucket with the given level and coordinates, returning it's index.
+	*/
+	NO_DISCARD uint32 FindOrCreateBucket(const uint8 level, const Vector3<int64> &coordinates) NOEXCEPT;
+
+	/*
+	*	Removes the given entry from it's bucket.
+	*/
+	void RemoveFromBucket(const uint32 entry_index) NOEXCEPT;
+
+	/*
+	*	Removes the given entry.
+	*/
+	void RemoveEntry(const uint32 entry_index) NOEXCEPT;
+
+	/*
+	*	Rebuilds the buckets, dropping the empty ones.
+	*/
+	void CompactBuckets() NOEXCEPT;
+
+	/*
+	*	Executes the given query, assuming the lock is held for reading.
+	*/
+	void ExecuteQueryInternal(SpatialIndexQuery *const RESTRICT query) const NOEXCEPT;
+
+	/*
+	*	Gathers the entries that pass the given test into the given results.
+	*	The test is given an entry box relative to the given cell, and the result to fill in, and returns if the entry should be added.
+	*	Buckets are tested with their loose box first, so the test needs to be conservative.
+	*	If a box is given, relative to the given cell as well, only buckets that overlap it are visited. Otherwise, every bucket is.
+	*/
+	template <typename TEST>
+	void GatherEntries
+	(
+		const Vector3<int32> &cell,
+		const AxisAlignedBoundingBox3D *const RESTRICT box,
+		const TEST &test,
+		DynamicArray<SpatialIndexQuery::Result> *const RESTRICT results
+	) const NOEXCEPT;
+
+};
\ No newline at end of file
@@ -20,6 +20,9 @@ class TaskSystem final
 
 public:
 
+	//Type aliases.
+	using ParallelForFunction = void(*)(void *const RESTRICT context, const uint32 index);
+
 	//System declaration.
 	CATALYST_SYSTEM
 	(
@@ -68,11 +71,46 @@ public:
 	*/
 	void WaitForAllTasksToFinish() NOEXCEPT;
 
+	/*
+	*	Runs the given function for all indices up to the given count on tasks with the given priority, and returns when all of them are done.
+	*	Tasks pick up indices one at a time, so splitting work into a few more indices than there are task executors evens out uneven work.
+	*	The calling thread does work of the given priority or higher while waiting, and runs everything itself if there is no task system or only a single index.
+	*/
+	static void ParallelFor(const Task::Priority priority, const uint32 count, const ParallelForFunction function, void *const RESTRICT context) NOEXCEPT;
+
 private:
 
+	/*
+	*	Parallel for task class definition.
+	*/
+	class ParallelForTask final
+	{
+
+	public:
+
+		//The task.
+		Task _Task;
+
+		//The function.
+		ParallelForFunction _Function;
+
+		//The context.
+		void *RESTRICT _Context;
+
+		//The next index to pick up, shared between all tasks.
+		Atomic<uint32> *RESTRICT _NextIndex;
+
+		//The number of indices.
+		uint32 _Count;
+
+	};
+
 	//The maximum number of tasks.
 	static constexpr uint64 MAXIMUM_NUMBER_OF_TASKS{ 4'096 };
 
+	//The maximum number of tasks a parallel for is split into.
+	static constexpr uint32 MAXIMUM_NUMBER_OF_PARALLEL_FOR_TASKS{ 64 };
+
 	//Container for all atomic queues in which to put tasks in.
 	StaticArray<AtomicQueue<Task *RESTRICT, MAXIMUM_NUMBER_OF_TASKS, AtomicQueueMode::MULTIPLE, AtomicQueueMode::MULTIPLE>, UNDERLYING(Task::Priority::NUMBER_OF_TASK_PRIORITIES)> _TaskQueues;
 
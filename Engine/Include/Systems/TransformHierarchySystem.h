@@ -0,0 +1,299 @@
+#pragma once
+
+//Core.
+#include <Core/Essential/CatalystEssential.h>
+#include <Core/Containers/DynamicArray.h>
+
+//Concurrency.
+#include <Concurrency/AtomicQueue.h>
+
+//Entities.
+#include <Entities/Core/Entity.h>
+
+//Math.
+#include <Math/General/Matrix.h>
+#include <Math/General/Quaternion.h>
+#include <Math/General/Vector.h>
+
+//Systems.
+#include <Systems/System.h>
+
+/*
+*	The transform hierarchy system parents entities to each other, so that a child follows it's parent around.
+*	Roots own their world transform like any other entity, while the world transforms of children are owned by the hierarchy,
+*	which derives them from the world transform of their parent and their local transform every frame.
+*	Nodes are kept in structure of arrays, sorted by depth, so that propagation can go through the hierarchy one depth at a time,
+*	with every node in a depth being independent of the others and processed in parallel.
+*	World matrices are kept relative to the cell of each node, so that deep hierarchies far away from the origin keep their precision.
+*	Requests are queued and carried out at the start of the next update, so they are safe to make from any thread.
+*/
+class TransformHierarchySystem final
+{
+
+public:
+
+	//System declaration.
+	CATALYST_SYSTEM
+	(
+		TransformHierarchySystem,
+		SYSTEM_UPDATE(RANGE(USER_INTERFACE, PHYSICS))
+	);
+
+	//Type aliases.
+	using ChangeCallback = void(*)(const DynamicArray<Entity *RESTRICT> &changed_entities, void *const RESTRICT user_data);
+
+	/*
+	*	Default constructor.
+	*/
+	FORCE_INLINE TransformHierarchySystem() NOEXCEPT
+	{
+
+	}
+
+	/*
+	*	Sets the parent of the given child. Passing nullptr as the parent detaches the child from it's parent.
+	*	The child keeps it's current world transform, and it's local transform is derived from that.
+	*	Both entities need a world transform component.
+	*/
+	void SetParent(Entity *const RESTRICT child, Entity *const RESTRICT parent) NOEXCEPT;
+
+	/*
+	*	Sets the local transform of the given entity, relative to it's parent.
+	*	For entities without a parent, this is relative to the cell the entity is in.
+	*/
+	void SetLocalTransform(Entity *const RESTRICT entity, const Vector3<float32> &position, const Quaternion &rotation, const Vector3<float32> &scale) NOEXCEPT;
+
+	/*
+	*	Removes the given entity from the hierarchy. It's children are detached and keep their current world transform.
+	*/
+	void RemoveNode(Entity *const RESTRICT entity) NOEXCEPT;
+
+	/*
+	*	Called by the entity system when the given entity is destroyed, before it's memory and identifier are freed.
+	*	Drops all requests referencing the entity and removes it from the hierarchy right away, so nothing refers to it once it's gone.
+	*	Entities are destroyed outside of the update range of this system, so this never runs alongside an update.
+	*/
+	void OnEntityDestroyed(Entity *const RESTRICT entity) NOEXCEPT;
+
+	/*
+	*	Returns if the given entity is in the hierarchy.
+	*/
+	NO_DISCARD bool IsInHierarchy(Entity *const RESTRICT entity) const NOEXCEPT;
+
+	/*
+	*	Returns the parent of the given entity, or nullptr if it doesn't have one.
+	*/
+	RESTRICTED NO_DISCARD Entity *const RESTRICT GetParent(Entity *const RESTRICT entity) const NOEXCEPT;
+
+	/*
+	*	Returns the entities whose world transform was changed by the hierarchy during the last update.
+	*/
+	FORCE_INLINE NO_DISCARD const DynamicArray<Entity *RESTRICT> &GetChangedEntities() const NOEXCEPT
+	{
+		return _ChangedEntities;
+	}
+
+	/*
+	*	Registers a change callback, called at the end of every update where world transforms in the hierarchy changed.
+	*/
+	void RegisterChangeCallback(const ChangeCallback callback, void *const RESTRICT user_data) NOEXCEPT;
+
+	/*
+	*	Deregisters a change callback.
+	*/
+	void DeregisterChangeCallback(const ChangeCallback callback, void *const RESTRICT user_data) NOEXCEPT;
+
+private:
+
+	/*
+	*	Set parent request class definition.
+	*/
+	class SetParentRequest final
+	{
+
+	public:
+
+		//The child.
+		Entity *RESTRICT _Child;
+
+		//The parent.
+		Entity *RESTRICT _Parent;
+
+	};
+
+	/*
+	*	Set local transform request class definition.
+	*/
+	class SetLocalTransformRequest final
+	{
+
+	public:
+
+		//The entity.
+		Entity *RESTRICT _Entity;
+
+		//The position.
+		Vector3<float32> _Position;
+
+		//The rotation.
+		Quaternion _Rotation;
+
+		//The scale.
+		Vector3<float32> _Scale;
+
+	};
+
+	/*
+	*	Remove node request class definition.
+	*/
+	class RemoveNodeRequest final
+	{
+
+	public:
+
+		//The entity identifier.
+		EntityIdentifier _EntityIdentifier;
+
+		//The entity. Only ever compared against, as it might have been destroyed by the time the request is processed.
+		Entity *RESTRICT _Entity;
+
+	};
+
+	/*
+	*	Change callback data class definition.
+	*/
+	class ChangeCallbackData final
+	{
+
+	public:
+
+		//The callback.
+		ChangeCallback _Callback;
+
+		//The user data.
+		void *RESTRICT _UserData;
+
+	};
+
+	/*
+	*	Propagation range class definition.
+	*	The nodes of one depth, split up into chunks that are propagated in parallel.
+	*/
+	class PropagationRange final
+	{
+
+	public:
+
+		//The first node index.
+		uint32 _FirstNodeIndex;
+
+		//The last node index, exclusive.
+		uint32 _LastNodeIndex;
+
+	};
+
+	//Constant denoting an invalid node index.
+	constexpr static uint32 INVALID_NODE_INDEX{ UINT32_MAXIMUM };
+
+	//The set parent queue.
+	AtomicQueue<SetParentRequest, 4'096, AtomicQueueMode::MULTIPLE, AtomicQueueMode::SINGLE> _SetParentQueue;
+
+	//The set local transform queue.
+	AtomicQueue<SetLocalTransformRequest, 4'096, AtomicQueueMode::MULTIPLE, AtomicQueueMode::SINGLE> _SetLocalTransformQueue;
+
+	//The remove node queue.
+	AtomicQueue<RemoveNodeRequest, 4'096, AtomicQueueMode::MULTIPLE, AtomicQueueMode::SINGLE> _RemoveNodeQueue;
+
+	//The set parent requests that have been taken off the queue but not carried out yet, including the ones waiting for their entities to be initialized.
+	DynamicArray<SetParentRequest> _SetParentRequests;
+
+	//The set local transform requests that have been taken off the queue but not carried out yet.
+	DynamicArray<SetLocalTransformRequest> _SetLocalTransformRequests;
+
+	//The entity to node mappings, indexed by entity identifier.
+	DynamicArray<uint32> _EntityToNodeMappings;
+
+	//The entities of all nodes. Entities that were removed are nullptr until the nodes are rebuilt.
+	DynamicArray<Entity *RESTRICT> _Entities;
+
+	//The parent indices of all nodes. Roots have an invalid parent index.
+	DynamicArray<uint32> _ParentIndices;
+
+	//The local matrices of all nodes, relative to their parent. Unused for roots.
+	DynamicArray<Matrix4x4> _LocalMatrices;
+
+	//The world matrices of all nodes, relative to their world cell.
+	DynamicArray<Matrix4x4> _WorldMatrices;
+
+	//The world cells of all nodes.
+	DynamicArray<Vector3<int32>> _WorldCells;
+
+	//The dirty flags of all nodes, denoting whether or not their world transform needs to be recalculated.
+	DynamicArray<uint8> _DirtyFlags;
+
+	/*
+	*	The start index of each depth, followed by the total number of nodes.
+	*	Only valid while the topology isn't dirty.
+	*/
+	DynamicArray<uint32> _DepthStarts;
+
+	//Denotes whether or not the topology is dirty, meaning that the nodes needs to be rebuilt before propagating.
+	bool _TopologyDirty{ false };
+
+	//The changed entities.
+	DynamicArray<Entity *RESTRICT> _ChangedEntities;
+
+	//The change callbacks.
+	DynamicArray<ChangeCallbackData> _ChangeCallbacks;
+
+	/*
+	*	Returns the node index for the given entity, or an invalid node index if it isn't in the hierarchy.
+	*/
+	NO_DISCARD uint32 GetNodeIndex(Entity *const RESTRICT entity) const NOEXCEPT;
+
+	/*
+	*	Adds a node for the given entity, returning the node index.
+	*/
+	NO_DISCARD uint32 AddNode(Entity *const RESTRICT entity) NOEXCEPT;
+
+	/*
+	*	Sets the parent of the given child internally. Returns false if the entities aren't ready yet and the request should be tried again later.
+	*/
+	NO_DISCARD bool SetParentInternal(Entity *const RESTRICT child, Entity *const RESTRICT parent) NOEXCEPT;
+
+	/*
+	*	Sets the local transform of the given entity internally.
+	*/
+	void SetLocalTransformInternal(const SetLocalTransformRequest &request) NOEXCEPT;
+
+	/*
+	*	Takes all requests off the set parent and set local transform queues, appending them to the requests that haven't been carried out yet.
+	*/
+	void DrainRequestQueues() NOEXCEPT;
+
+	/*
+	*	Removes the given entity from the hierarchy internally. The entity is only compared against, never dereferenced.
+	*/
+	void RemoveNodeInternal(const EntityIdentifier entity_identifier, const Entity *const RESTRICT entity) NOEXCEPT;
+
+	/*
+	*	Rebuilds the nodes, removing unused ones and sorting the rest by depth.
+	*/
+	void RebuildNodes() NOEXCEPT;
+
+	/*
+	*	Updates the roots from their world transform components.
+	*/
+	void UpdateRoots() NOEXCEPT;
+
+	/*
+	*	Propagates world transforms from the roots down to the leaves.
+	*/
+	void Propagate() NOEXCEPT;
+
+	/*
+	*	Propagates world transforms for the given range of nodes, which all need to be of the same depth.
+	*/
+	void PropagateRange(const uint32 first_node_index, const uint32 last_node_index) NOEXCEPT;
+
+};
\ No newline at end of file
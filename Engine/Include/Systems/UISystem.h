@@ -3,14 +3,18 @@
 //Core.
 #include <Core/Essential/CatalystEssential.h>
 #include <Core/Containers/DynamicArray.h>
+#include <Core/General/Pair.h>
 
 //Concurrency.
 #include <Concurrency/AtomicQueue.h>
 
+//Rendering.
+#include <Rendering/Native/RenderingCore.h>
+
 //UI.
 #include <UI/Core/RenderCommand.h>
 #include <UI/Core/Scene.h>
-#include <UI/Core/WidgetAllocator.h>
+#include <UI/Core/TextLayout.h>
 
 //Systems.
 #include <Systems/System.h>
@@ -55,10 +59,15 @@ public:
 		_RemoveSceneRequests.Push(scene);
 	}
 
-private:
+	/*
+	*	Returns the text layout cache.
+	*/
+	FORCE_INLINE NO_DISCARD UI::TextLayoutCache *const RESTRICT GetTextLayoutCache() NOEXCEPT
+	{
+		return &_TextLayoutCache;
+	}
 
-	//The widget allocator.
-	UI::WidgetAllocator _WidgetAllocator;
+private:
 
 	//The add scene requests.
 	AtomicQueue<UI::Scene *RESTRICT, 64, AtomicQueueMode::MULTIPLE, AtomicQueueMode::SINGLE> _AddSceneRequests;
@@ -72,6 +81,32 @@ private:
 	//The render commands.
 	DynamicArray<UI::RenderCommand> _RenderCommands;
 
+	//The range of render commands that still needs to be uploaded, for each framebuffer.
+	DynamicArray<Pair<uint64, uint64>> _PendingUploadRanges;
+
+	//The buffer that the render commands were last uploaded to, for each framebuffer.
+	DynamicArray<BufferHandle> _UploadedBuffers;
+
+	//The enabled widgets of all scenes, in the order they are rendered. Indexed into by the hit test grid.
+	DynamicArray<UI::Widget *RESTRICT> _HitTestWidgets;
+
+	//The offsets into the hit test grid entries for each hit test grid cell, with one extra offset at the end.
+	DynamicArray<uint32> _HitTestGridOffsets;
+
+	//The hit test grid entries, in the order they are rendered within each hit test grid cell.
+	DynamicArray<uint32> _HitTestGridEntries;
+
+	//The clickable interfaces that were not idle after the last update, along with their widgets.
+	DynamicArray<Pair<UI::Widget *RESTRICT, UI::ClickableInterface *RESTRICT>> _ActiveClickableInterfaces;
+
+	//The text layout cache.
+	UI::TextLayoutCache _TextLayoutCache;
+
+	/*
+	*	Rebuilds the hit test grid.
+	*/
+	void RebuildHitTestGrid() NOEXCEPT;
+
 	/*
 	*	Updates widgets.
 	*/
@@ -87,9 +122,4 @@ private:
 	*/
 	void UpdatePreRender() NOEXCEPT;
 
-	/*
-	*	Returns if any widget is blocking the given position for the given widget.
-	*/
-	NO_DISCARD bool AnyWidgetBlockingPosition(const Vector2<float32> position, const UI::Widget *const RESTRICT widget) NOEXCEPT;
-
 };
\ No newline at end of file
@@ -2,16 +2,118 @@
 
 //Core.
 #include <Core/Essential/CatalystEssential.h>
+#include <Core/Containers/DynamicArray.h>
+
+//Rendering.
+#include <Rendering/Native/Frustum.h>
 
 //Terrain.
 #include <Terrain/TerrainQuadTreeNode.h>
 
+/*
+*	Quad tree used by terrain and water.
+*	All nodes live in one flat pool, with the root node at index zero and child nodes allocated in contiguous blocks of four.
+*	The leaf nodes are kept in a separate list in Morton order, which is what updates, culling and rendering walk.
+*/
 class TerrainQuadTree final
 {
 
 public:
 
-	//The root node.
-	TerrainQuadTreeNode _RootNode;
+	//The node pool.
+	DynamicArray<TerrainQuadTreeNode> _Nodes;
+
+	//The leaf nodes, as indices into the node pool, in Morton order.
+	DynamicArray<uint32> _LeafNodes;
+
+	/*
+	*	Initializes this quad tree with just the root node.
+	*/
+	void Initialize
+	(
+		const Vector2<float32> &position,
+		const uint32 patch_size,
+		const uint8 maximum_subdivision_steps,
+		const AxisAlignedBoundingBox3D &axis_aligned_bounding_box,
+		const float32 height_map_coordinate_padding
+	) NOEXCEPT;
+
+	/*
+	*	Updates this quad tree for the given camera position, combining and subdividing leaf nodes incrementally and recalculating borders if anything changed.
+	*	Returns if the leaf nodes changed.
+	*/
+	bool Update(const Vector3<float32> &camera_position) NOEXCEPT;
+
+	/*
+	*	Culls all leaf nodes against the given frustum.
+	*/
+	void Cull(const Vector3<float32> &world_grid_delta, const Frustum &frustum) NOEXCEPT;
+
+	/*
+	*	Returns the root node.
+	*/
+	FORCE_INLINE NO_DISCARD const TerrainQuadTreeNode &GetRootNode() const NOEXCEPT
+	{
+		return _Nodes[0];
+	}
+
+	/*
+	*	Returns the memory usage of this quad tree.
+	*/
+	NO_DISCARD uint64 MemoryUsage() const NOEXCEPT;
+
+private:
+
+	//The patch size.
+	uint32 _PatchSize;
+
+	//The maximum subdivision steps.
+	uint8 _MaximumSubdivisionSteps;
+
+	//The height map coordinate padding.
+	float32 _HeightMapCoordinatePadding;
+
+	//The free child node blocks, as indices to the first node of each block.
+	DynamicArray<uint32> _FreeChildNodeBlocks;
+
+	//The leaf nodes being built during an update, swapped with the leaf nodes when done.
+	DynamicArray<uint32> _ScratchLeafNodes;
+
+	//The Morton codes of the minimum corner of each leaf node, at the maximum depth.
+	DynamicArray<uint64> _LeafMortonCodes;
+
+	//The camera position at the last update.
+	Vector3<float32> _LastCameraPosition;
+
+	/*
+	*	Allocates a block of four child nodes for the given node and initializes them.
+	*/
+	void Subdivide(const uint32 node_index) NOEXCEPT;
+
+	/*
+	*	Subdivides the given leaf node as many times as needed, adding the resulting leaf nodes to the scratch leaf nodes.
+	*	Returns if anything was subdivided.
+	*/
+	bool SubdivideLeafNode(const uint32 node_index, const Vector3<float32> &camera_position) NOEXCEPT;
+
+	/*
+	*	Runs one combination pass over the leaf nodes. Returns if anything was combined.
+	*/
+	bool CombinationPass(const Vector3<float32> &camera_position) NOEXCEPT;
+
+	/*
+	*	Runs one subdivision pass over the leaf nodes. Returns if anything was subdivided.
+	*/
+	bool SubdivisionPass(const Vector3<float32> &camera_position) NOEXCEPT;
+
+	/*
+	*	Calculates the borders of all leaf nodes.
+	*/
+	void CalculateBorders() NOEXCEPT;
+
+	/*
+	*	Finds the leaf node containing the given Morton code at the maximum depth. Returns the index into the leaf nodes.
+	*/
+	NO_DISCARD uint64 FindLeafNode(const uint64 morton_code) const NOEXCEPT;
 
 };
\ No newline at end of file
@@ -2,7 +2,6 @@
 
 //Core.
 #include <Core/Essential/CatalystEssential.h>
-#include <Core/Containers/DynamicArray.h>
 
 //Math.
 #include <Math/Geometry/AxisAlignedBoundingBox3D.h>
@@ -16,14 +15,26 @@ class TerrainQuadTreeNode final
 
 public:
 
+	//Constant denoting an invalid node index.
+	constexpr static uint32 INVALID_INDEX{ UINT32_MAXIMUM };
+
 	//The depth.
 	uint8 _Depth{ 0 };
 
 	//The borders.
-	uint32 _Borders;
+	uint32 _Borders{ 0 };
+
+	//The index of the parent node in the node pool.
+	uint32 _ParentNodeIndex{ INVALID_INDEX };
+
+	/*
+	*	The index of the first child node in the node pool.
+	*	The four child nodes are stored contiguously, in Morton order, so child node N is at _ChildNodesIndex + N.
+	*/
+	uint32 _ChildNodesIndex{ INVALID_INDEX };
 
-	//The child nodes.
-	DynamicArray<TerrainQuadTreeNode> _ChildNodes;
+	//The grid coordinate of this node, at it's depth.
+	Vector2<uint32> _GridCoordinate{ 0, 0 };
 
 	//The minimum world position of this node.
 	Vector2<float32> _Minimum;
@@ -35,7 +46,7 @@ public:
 	AxisAlignedBoundingBox3D _AxisAlignedBoundingBox;
 
 	//Denotes if this node is visible.
-	bool _Visible;
+	bool _Visible{ false };
 
 	//The position.
 	Vector2<float32> _Position;
@@ -62,7 +73,7 @@ public:
 	*/
 	FORCE_INLINE NO_DISCARD bool IsSubdivided() const NOEXCEPT
 	{
-		return !_ChildNodes.Empty();
+		return _ChildNodesIndex != INVALID_INDEX;
 	}
 
 	/*
@@ -3,9 +3,6 @@
 //Core.
 #include <Core/Essential/CatalystEssential.h>
 
-//Components.
-#include <Components/Components/TerrainComponent.h>
-
 //Math.
 #include <Math/General/Vector.h>
 
@@ -36,22 +33,15 @@ public:
 
 	/*
 	*	Given a node and a position, returns if the node should be combined.
+	*	Only called for nodes where all child nodes are leaf nodes.
 	*/
 	FORCE_INLINE static NO_DISCARD bool ShouldBeCombined(const uint32 patch_size, const uint8 maximum_subdivision_steps, const TerrainQuadTreeNode& node, const Vector3<float32>& position) NOEXCEPT
 	{
-		if (node.IsSubdivided() && node._ChildNodes.Data()->IsSubdivided())
-		{
-			return false;
-		}
-
-		else
-		{
-			const Vector2<float32> middle_point{ MiddlePoint(node) };
-			const float32 length{ BaseMath::Maximum<float32>(BaseMath::Absolute(middle_point._X - position._X), BaseMath::Absolute(middle_point._Y - position._Z)) };
-
-			return	node._Depth > maximum_subdivision_steps
-					|| length > static_cast<float32>(patch_size) * PatchSizeMultiplier(node);
-		}
+		const Vector2<float32> middle_point{ MiddlePoint(node) };
+		const float32 length{ BaseMath::Maximum<float32>(BaseMath::Absolute(middle_point._X - position._X), BaseMath::Absolute(middle_point._Y - position._Z)) };
+
+		return	node._Depth > maximum_subdivision_steps
+				|| length > static_cast<float32>(patch_size) * PatchSizeMultiplier(node);
 	}
 
 	/*
@@ -67,57 +57,29 @@ public:
 	}
 
 	/*
-	*	Given a terrain component and a node, returning the neighboring nodes in the order upper, right, lower, left.
+	*	Given a grid coordinate, returns it's Morton code, interleaving the bits of X (even bits) and Y (odd bits).
 	*/
-	FORCE_INLINE static void NeighboringNodes(const uint32 patch_size, const TerrainQuadTreeNode &root_node, const TerrainQuadTreeNode &node, StaticArray<const TerrainQuadTreeNode *RESTRICT, 4> *const RESTRICT neighboring_nodes) NOEXCEPT
+	FORCE_INLINE static NO_DISCARD uint64 MortonCode(const uint32 X, const uint32 Y) NOEXCEPT
 	{
-		//Calculate the middle point of the node.
-		const Vector2<float32> middle_point{ MiddlePoint(node) };
-
-		//Calculate the patch size multiplier.
-		const float32 patch_size_multiplier{ PatchSizeMultiplier(node) };
-
-		//Calculate the positions.
-		const StaticArray<const Vector2<float32>, 4> positions
-		{
-			middle_point + Vector2<float32>(-static_cast<float32>(patch_size) * patch_size_multiplier, 0.0f),
-			middle_point + Vector2<float32>(0.0f, -static_cast<float32>(patch_size) * patch_size_multiplier),
-			middle_point + Vector2<float32>(static_cast<float32>(patch_size) * patch_size_multiplier, 0.0f),
-			middle_point + Vector2<float32>(0.0f, static_cast<float32>(patch_size) * patch_size_multiplier),
-		};
-
-		//Find the node with the highest depth for each position.
-		for (uint8 i{ 0 }; i < 4; ++i)
-		{
-			neighboring_nodes->At(i) = FindHighestNode(root_node, positions[i]);
-		}
+		return SpreadBits(X) | (SpreadBits(Y) << 1);
 	}
 
+private:
+
 	/*
-	*	Given a node and a position, find the node with the highest depth within the node.
+	*	Spreads the bits of the given value out so that there's one zero bit between each.
 	*/
-	RESTRICTED static const TerrainQuadTreeNode *const RESTRICT FindHighestNode(const TerrainQuadTreeNode &node, const Vector2<float32> &position) NOEXCEPT
+	FORCE_INLINE static NO_DISCARD uint64 SpreadBits(const uint32 value) NOEXCEPT
 	{
-		if (node.IsSubdivided())
-		{
-			for (uint8 i{ 0 }; i < 4; ++i)
-			{
-				if (const TerrainQuadTreeNode *const RESTRICT child_node{ FindHighestNode(node._ChildNodes[i], position) })
-				{
-					return child_node;
-				}
-			}
-		}
-
-		if (node.IsWithin(position))
-		{
-			return &node;
-		}
-
-		else
-		{
-			return nullptr;
-		}
+		uint64 result{ value };
+
+		result = (result | (result << 16)) & 0x0000FFFF0000FFFFull;
+		result = (result | (result << 8)) & 0x00FF00FF00FF00FFull;
+		result = (result | (result << 4)) & 0x0F0F0F0F0F0F0F0Full;
+		result = (result | (result << 2)) & 0x3333333333333333ull;
+		result = (result | (result << 1)) & 0x5555555555555555ull;
+
+		return result;
 	}
 
 };
\ No newline at end of file
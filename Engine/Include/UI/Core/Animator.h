@@ -33,6 +33,14 @@ namespace UI
 			_Speed = value;
 		}
 
+		/*
+		*	Returns whether or not this animator is still animating.
+		*/
+		FORCE_INLINE NO_DISCARD bool IsAnimating() const NOEXCEPT
+		{
+			return _CurrentValue < 1.0f;
+		}
+
 		/*
 		*	Updates this animator and returns the current value.
 		*/
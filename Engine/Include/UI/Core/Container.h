@@ -2,6 +2,7 @@
 
 //Core.
 #include <Core/Essential/CatalystEssential.h>
+#include <Core/Containers/DynamicArray.h>
 #include <Core/General/Optional.h>
 
 //Math.
@@ -10,6 +11,7 @@
 //UI.
 #include <UI/Core/UI.h>
 #include <UI/Core/Identifier.h>
+#include <UI/Core/RenderCommand.h>
 
 namespace UI
 {
@@ -76,6 +78,21 @@ namespace UI
 		//Denotes whether or not this container wants scroll.
 		bool _WantsScroll;
 
+		//Denotes whether or not the render commands of this container needs to be recreated.
+		bool _RenderDirty{ true };
+
+		//Denotes whether or not the render commands of this container reference characters from a glyph cache.
+		bool _UsesGlyphCache{ false };
+
+		//The number of glyph cache evictions when the render commands of this container were created. If it changes, those characters might be gone.
+		uint64 _NumberOfGlyphEvictions{ 0 };
+
+		//The render commands of this container, kept around between frames.
+		DynamicArray<UI::RenderCommand> _RenderCommands;
+
+		//The offset of the render commands of this container in the render commands uploaded last frame.
+		uint64 _RenderCommandsOffset{ UINT64_MAXIMUM };
+
 	};
 
 }
\ No newline at end of file
@@ -90,6 +90,14 @@ namespace UI
 
 		}
 
+		/*
+		*	Returns the value.
+		*/
+		FORCE_INLINE constexpr NO_DISCARD uint64 GetValue() const NOEXCEPT
+		{
+			return _Value;
+		}
+
 		/*
 		*	Equality operator overload.
 		*/
@@ -110,4 +118,4 @@ namespace UI
 
 	};
 
-}
+}
\ No newline at end of file
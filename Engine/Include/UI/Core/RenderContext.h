@@ -24,6 +24,15 @@ namespace UI
 		//The render commands.
 		DynamicArray<RenderCommand> *RESTRICT _RenderCommands;
 
+		//The start of the render commands that have changed since last frame. Updated by scenes as they render.
+		uint64 *RESTRICT _ChangedRenderCommandsStart;
+
+		//The end of the render commands that have changed since last frame. Updated by scenes as they render.
+		uint64 *RESTRICT _ChangedRenderCommandsEnd;
+
+		//Set by widgets that render characters from a glyph cache, as those can be evicted later on. Optional.
+		bool *RESTRICT _UsesGlyphCache{ nullptr };
+
 	};
 
 }
\ No newline at end of file
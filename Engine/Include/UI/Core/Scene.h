@@ -8,12 +8,16 @@
 #include <UI/Core/BuildContext.h>
 #include <UI/Core/Style.h>
 #include <UI/Core/Widget.h>
+#include <UI/Core/WidgetAllocator.h>
 
 namespace UI
 {
 
 	/*
 	*	Base class for all UI scenes.
+	*	By default, scenes are rebuilt every frame.
+	*	Retained scenes are only rebuilt when marked dirty, and keep their widgets, layout and render commands around in the meantime.
+	*	Containers only recreate their render commands when something in them has changed, like a widget changing state or animating.
 	*/
 	class Scene
 	{
@@ -57,6 +61,42 @@ namespace UI
 			return _TextScale;
 		}
 
+		/*
+		*	Marks this scene as dirty, so that a retained scene is rebuilt.
+		*	Retained scenes should call this whenever anything that the scene builds from changes.
+		*/
+		FORCE_INLINE void MarkDirty() NOEXCEPT
+		{
+			_Dirty = true;
+		}
+
+		/*
+		*	Marks all containers in this scene as needing to recreate their render commands, without rebuilding the scene.
+		*/
+		FORCE_INLINE void MarkRenderDirty() NOEXCEPT
+		{
+			for (UI::Container &container : _Containers)
+			{
+				container._RenderDirty = true;
+			}
+		}
+
+		/*
+		*	Returns whether or not this scene needs to be built.
+		*/
+		FORCE_INLINE NO_DISCARD bool NeedsBuild() const NOEXCEPT
+		{
+			return !_Retained || _Dirty;
+		}
+
+		/*
+		*	Returns the widget allocator.
+		*/
+		FORCE_INLINE NO_DISCARD UI::WidgetAllocator *const RESTRICT GetWidgetAllocator() NOEXCEPT
+		{
+			return &_WidgetAllocator;
+		}
+
 		/*
 		*	Prepares this scene for building.
 		*/
@@ -67,6 +107,11 @@ namespace UI
 		*/
 		FORCE_INLINE virtual void Build(const UI::BuildContext &context) NOEXCEPT = 0;
 
+		/*
+		*	Finishes building this scene.
+		*/
+		void FinishBuild() NOEXCEPT;
+
 		/*
 		*	Returns the widgets for this scene.
 		*/
@@ -78,21 +123,18 @@ namespace UI
 		/*
 		*	Renders this scene.
 		*/
-		FORCE_INLINE void Render(const UI::RenderContext &context) NOEXCEPT
-		{
-			for (UI::Widget *const RESTRICT widget : _Widgets)
-			{
-				if (!widget->IsEnabled())
-				{
-					continue;
-				}
-
-				widget->Render(context);
-			}
-		}
+		void Render(const UI::RenderContext &context) NOEXCEPT;
 
 	protected:
 
+		/*
+		*	Sets whether or not this scene is retained.
+		*/
+		FORCE_INLINE void SetRetained(const bool value) NOEXCEPT
+		{
+			_Retained = value;
+		}
+
 		/*
 		*	Sets the font for this scene.
 		*/
@@ -220,6 +262,15 @@ namespace UI
 		//The text scale.
 		float32 _TextScale;
 
+		//The widget allocator.
+		UI::WidgetAllocator _WidgetAllocator;
+
+		//Denotes whether or not this scene is retained.
+		bool _Retained{ false };
+
+		//Denotes whether or not this scene is dirty.
+		bool _Dirty{ true };
+
 	};
 
 }
\ No newline at end of file
@@ -0,0 +1,95 @@
+#pragma once
+
+//Core.
+#include <Core/Essential/CatalystEssential.h>
+#include <Core/Containers/DynamicArray.h>
+
+//Content.
+#include <Content/Assets/FontAsset.h>
+
+//STL.
+#include <unordered_map>
+
+namespace UI
+{
+
+	/*
+	*	Text layout class definition.
+	*	Holds the characters of a piece of text along with their offsets along the baseline, in units of the font height, so it can be rendered at any scale.
+	*/
+	class TextLayout final
+	{
+
+	public:
+
+		/*
+		*	Character class definition.
+		*/
+		class Character final
+		{
+
+		public:
+
+			//The codepoint.
+			uint32 _Codepoint;
+
+			//The offset along the baseline.
+			float32 _Offset;
+
+		};
+
+		//The characters.
+		DynamicArray<Character> _Characters;
+
+		//The width.
+		float32 _Width;
+
+	};
+
+	/*
+	*	Text layout cache class definition.
+	*	Laying out text means decoding UTF-8, looking up characters and applying kerning, which adds up for text that rarely changes between frames.
+	*	Layouts are cached by font and text. When the cache grows too large it is cleared, which is much simpler than tracking what is still in use.
+	*/
+	class TextLayoutCache final
+	{
+
+	public:
+
+		/*
+		*	Returns the layout of the given UTF-8 text in the given font. The returned layout is valid until the next call.
+		*/
+		NO_DISCARD const UI::TextLayout &GetLayout(FontAsset *const RESTRICT font, const char *const RESTRICT text, const uint64 text_length) NOEXCEPT;
+
+	private:
+
+		/*
+		*	Entry class definition.
+		*/
+		class Entry final
+		{
+
+		public:
+
+			//The font.
+			const FontAsset *RESTRICT _Font;
+
+			//The text.
+			DynamicArray<char> _Text;
+
+			//The layout.
+			UI::TextLayout _Layout;
+
+		};
+
+		//The entries, mapped by the hash of their font and text.
+		std::unordered_map<uint64, Entry> _Entries;
+
+		/*
+		*	Lays out the given UTF-8 text in the given font.
+		*/
+		static void LayOut(FontAsset *const RESTRICT font, const char *const RESTRICT text, const uint64 text_length, UI::TextLayout *const RESTRICT layout) NOEXCEPT;
+
+	};
+
+}
\ No newline at end of file
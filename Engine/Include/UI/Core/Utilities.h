@@ -14,6 +14,7 @@
 #include <Systems/RenderingSystem.h>
 
 //UI.
+#include <UI/Core/TextLayout.h>
 #include <UI/Core/UI.h>
 
 namespace UI
@@ -21,15 +22,14 @@ namespace UI
 	namespace Utilities
 	{
 		/*
-		*	Calculates an aligned bounding box for text.
+		*	Calculates an aligned bounding box for text with the given layout.
 		*/
 		FORCE_INLINE static void CalculateTextAlignedBoundingBox
 		(
 			const Vector2<float32> &original_minimum,
 			const Vector2<float32> &original_maximum,
 			AssetPointer<FontAsset> font,
-			const char *const RESTRICT text,
-			const uint64 text_length,
+			const UI::TextLayout &layout,
 			const float32 scale,
 			const UI::HorizontalAlignment horizontal_alignment,
 			const UI::VerticalAlignment vertical_alignment,
@@ -39,8 +39,9 @@ namespace UI
 			*new_minimum = original_minimum;
 			*new_maximum = original_maximum;
 
-			//Use the character 'A' as a baseline height.
-			const float32 baseline_height{ font->_CharacterDescriptions['A']._Size._Y * scale };
+			//Use the character 'A' as a baseline height, if the font has it.
+			const FontAsset::CharacterDescription *const RESTRICT baseline_character_description{ font->FindCharacterDescription('A') };
+			const float32 baseline_height{ (baseline_character_description ? baseline_character_description->_Size._Y : font->_DefaultHeight) * scale };
 
 			//Calculate the original center.
 			const Vector2<float32> original_center{ BaseMath::LinearlyInterpolate(original_minimum, original_maximum, 0.5f) };
@@ -53,19 +54,8 @@ namespace UI
 			Vector2<float32> text_minimum{ 0.0f, original_center._Y - (baseline_height * 0.5f) };
 			Vector2<float32> text_maximum{ 0.0f, original_center._Y + (baseline_height * 0.5f) };
 
-			for (uint64 i{ 0 }, length{ text_length }; i < length; ++i)
-			{
-				//Cache the chartacter.
-				const char character{ text[i] };
-
-				if (character < 0)
-				{
-					continue;
-				}
-
-				//Advance the maximum on the X axis..
-				text_maximum._X += font->_CharacterDescriptions[character]._Advance * scale;
-			}
+			//Advance the maximum on the X axis by the width of the text.
+			text_maximum._X += layout._Width * scale;
 
 			//Calculate the text horizontal/vertical extent.
 			const float32 text_horizontal_extent{ text_maximum._X - text_minimum._X };
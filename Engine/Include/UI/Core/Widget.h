@@ -148,6 +148,14 @@ namespace UI
 			return nullptr;
 		}
 
+		/*
+		*	Returns whether or not this widget is animating, and needs to be rendered again the next frame even if nothing else has changed.
+		*/
+		FORCE_INLINE virtual NO_DISCARD bool IsAnimating() const NOEXCEPT
+		{
+			return false;
+		}
+
 		/*
 		*	Renders this widget.
 		*/
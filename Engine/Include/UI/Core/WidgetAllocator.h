@@ -2,11 +2,12 @@
 
 //Core.
 #include <Core/Essential/CatalystEssential.h>
-#include <Core/Containers/HashTable.h>
+#include <Core/Containers/DynamicArray.h>
 
 //UI.
 #include <UI/Core/Container.h>
 #include <UI/Core/Identifier.h>
+#include <UI/Core/Widget.h>
 
 namespace UI
 {
@@ -14,38 +15,63 @@ namespace UI
 	/*
 	*	Simple allocator for widget memory.
 	*	Each widget is tied to a unique identifier, and kept around in case any widget keeps state.
-	*	Keeps track of alive widgets this frame, so dead widgets can be cleaned up at the end of the frame.
+	*	Keeps track of alive widgets this build, so dead widgets can be cleaned up at the end of the build.
+	*	Widgets are looked up through an open addressing hash table, since identifiers are already hashes.
 	*/
 	class WidgetAllocator final
 	{
 
 	public:
 
+		/*
+		*	Default destructor.
+		*/
+		FORCE_INLINE ~WidgetAllocator() NOEXCEPT
+		{
+			for (WidgetAllocation &allocation : _Allocations)
+			{
+				delete allocation._Widget;
+			}
+		}
+
 		/*
 		*	Allocates a widget (or returns an active one if it exists.
 		*/
 		template <typename TYPE>
 		FORCE_INLINE TYPE *const Allocate(const UI::Identifier identifier) NOEXCEPT
 		{
-			WidgetAllocation *const RESTRICT allocation{ _Allocations.Find(identifier) };
+			const uint32 allocation_index{ FindAllocationIndex(identifier.GetValue()) };
 
-			if (allocation)
+			if (allocation_index != INVALID_INDEX)
 			{
-				allocation->_Alive = true;
+				WidgetAllocation &allocation{ _Allocations[allocation_index] };
+
+				allocation._Alive = true;
 
-				return static_cast<TYPE *const RESTRICT>(allocation->_Data);
+				return static_cast<TYPE *const RESTRICT>(allocation._Widget);
 			}
 
 			else
 			{
-				WidgetAllocation new_allocation;
+				_Allocations.Emplace();
+				WidgetAllocation &new_allocation{ _Allocations.Back() };
 
+				new_allocation._Identifier = identifier.GetValue();
 				new_allocation._Alive = true;
-				new_allocation._Data = new TYPE();
+				new_allocation._Widget = new TYPE();
 
-				_Allocations.Add(identifier, new_allocation);
+				//Keep the table at most half full.
+				if (_Allocations.Size() * 2 > _Table.Size())
+				{
+					RebuildTable();
+				}
 
-				return static_cast<TYPE *const RESTRICT>(new_allocation._Data);
+				else
+				{
+					InsertIntoTable(static_cast<uint32>(_Allocations.Size() - 1));
+				}
+
+				return static_cast<TYPE *const RESTRICT>(new_allocation._Widget);
 			}
 		}
 
@@ -55,11 +81,11 @@ namespace UI
 		template <typename TYPE>
 		FORCE_INLINE TYPE *const Find(const UI::Identifier identifier) NOEXCEPT
 		{
-			WidgetAllocation *const RESTRICT allocation{ _Allocations.Find(identifier) };
+			const uint32 allocation_index{ FindAllocationIndex(identifier.GetValue()) };
 
-			if (allocation)
+			if (allocation_index != INVALID_INDEX)
 			{
-				return static_cast<TYPE *const RESTRICT>(allocation->_Data);
+				return static_cast<TYPE *const RESTRICT>(_Allocations[allocation_index]._Widget);
 			}
 
 			else
@@ -69,26 +95,31 @@ namespace UI
 		}
 
 		/*
-		*	Prepares this widget allocator for the coming frame.
+		*	Prepares this widget allocator for the coming build.
 		*/
 		FORCE_INLINE void Prepare() NOEXCEPT
 		{
-			for (WidgetAllocation &allocation : _Allocations.ValueIterator())
+			for (WidgetAllocation &allocation : _Allocations)
 			{
 				allocation._Alive = false;
 			}
 		}
 
 		/*
-		*	Cleans this widget allocator after the frame.
+		*	Cleans this widget allocator after the build, destroying all widgets that weren't allocated during it.
 		*/
 		FORCE_INLINE void Clean() NOEXCEPT
 		{
+			bool removed_any{ false };
+
 			for (uint64 i{ 0 }; i < _Allocations.Size();)
 			{
-				if (!_Allocations.ValueAt(i)._Alive)
+				if (!_Allocations[i]._Alive)
 				{
-					_Allocations.Remove(_Allocations.KeyAt(i));
+					delete _Allocations[i]._Widget;
+					_Allocations.EraseAt<false>(i);
+
+					removed_any = true;
 				}
 
 				else
@@ -96,10 +127,18 @@ namespace UI
 					++i;
 				}
 			}
+
+			if (removed_any)
+			{
+				RebuildTable();
+			}
 		}
 
 	private:
 
+		//Denotes an invalid index.
+		static constexpr uint32 INVALID_INDEX{ UINT32_MAXIMUM };
+
 		/*
 		*	Widget allocation class definition.
 		*/
@@ -108,16 +147,84 @@ namespace UI
 
 		public:
 
+			//The identifier.
+			uint64 _Identifier;
+
 			//Denotes whether or not this widget is alive.
 			bool _Alive;
 
-			//The data.
-			void *RESTRICT _Data;
+			//The widget.
+			UI::Widget *RESTRICT _Widget;
 
 		};
 
 		//The allocations.
-		HashTable<UI::Identifier, WidgetAllocation> _Allocations;
+		DynamicArray<WidgetAllocation> _Allocations;
+
+		//The table, mapping identifiers to allocation indices. Always a power of two in size.
+		DynamicArray<uint32> _Table;
+
+		/*
+		*	Finds the index of the allocation with the given identifier, or INVALID_INDEX if none exists.
+		*/
+		FORCE_INLINE NO_DISCARD uint32 FindAllocationIndex(const uint64 identifier) const NOEXCEPT
+		{
+			if (_Table.Empty())
+			{
+				return INVALID_INDEX;
+			}
+
+			const uint64 mask{ _Table.Size() - 1 };
+
+			for (uint64 slot{ identifier & mask };; slot = (slot + 1) & mask)
+			{
+				if (_Table[slot] == INVALID_INDEX || _Allocations[_Table[slot]]._Identifier == identifier)
+				{
+					return _Table[slot];
+				}
+			}
+		}
+
+		/*
+		*	Inserts the given allocation index into the table.
+		*/
+		FORCE_INLINE void InsertIntoTable(const uint32 allocation_index) NOEXCEPT
+		{
+			const uint64 mask{ _Table.Size() - 1 };
+			uint64 slot{ _Allocations[allocation_index]._Identifier & mask };
+
+			while (_Table[slot] != INVALID_INDEX)
+			{
+				slot = (slot + 1) & mask;
+			}
+
+			_Table[slot] = allocation_index;
+		}
+
+		/*
+		*	Rebuilds the table from the allocations.
+		*/
+		FORCE_INLINE void RebuildTable() NOEXCEPT
+		{
+			uint64 size{ 64 };
+
+			while (size < _Allocations.Size() * 4)
+			{
+				size <<= 1;
+			}
+
+			_Table.Resize<false>(size);
+
+			for (uint32 &slot : _Table)
+			{
+				slot = INVALID_INDEX;
+			}
+
+			for (uint32 i{ 0 }, allocation_count{ static_cast<uint32>(_Allocations.Size()) }; i < allocation_count; ++i)
+			{
+				InsertIntoTable(i);
+			}
+		}
 
 	};
 
@@ -155,6 +155,14 @@ namespace UI
 			return this;
 		}
 
+		/*
+		*	Returns whether or not this widget is animating, and needs to be rendered again the next frame even if nothing else has changed.
+		*/
+		FORCE_INLINE NO_DISCARD bool IsAnimating() const NOEXCEPT override
+		{
+			return _Animator.IsAnimating();
+		}
+
 		/*
 		*	Renders this widget.
 		*/
@@ -111,6 +111,15 @@ namespace UI
 			return this;
 		}
 
+		/*
+		*	Returns whether or not this widget is animating, and needs to be rendered again the next frame even if nothing else has changed.
+		*	The value follows the mouse while this slider is pressed, so it needs to be rendered every frame then.
+		*/
+		FORCE_INLINE NO_DISCARD bool IsAnimating() const NOEXCEPT override
+		{
+			return _Animator.IsAnimating() || _ClickableInterface.GetState() == UI::ClickableInterface::State::PRESSED;
+		}
+
 		/*
 		*	Renders this widget.
 		*/
@@ -0,0 +1,110 @@
+#pragma once
+
+//Core.
+#include <Core/Essential/CatalystEssential.h>
+#include <Core/Containers/DynamicArray.h>
+
+//Entities.
+#include <Entities/Core/Entity.h>
+
+//Math.
+#include <Math/General/Vector.h>
+
+//Rendering.
+#include <Rendering/Native/Frustum.h>
+
+//World.
+#include <World/Core/WorldPosition.h>
+#include <World/Core/WorldSpaceAxisAlignedBoundingBox3D.h>
+
+/*
+*	Spatial index query class definition.
+*	Describes a single query for the spatial index system to answer, and receives the results.
+*	Which of the parameters are used depends on the type.
+*/
+class SpatialIndexQuery final
+{
+
+public:
+
+	//Enumeration covering all types.
+	enum class Type : uint8
+	{
+		/*
+		*	Finds all entities whose bounds overlap the sphere at '_Position' with radius '_Distance'.
+		*/
+		SPHERE,
+
+		/*
+		*	Finds all entities whose bounds overlap '_Box'.
+		*/
+		BOX,
+
+		/*
+		*	Finds all entities whose bounds are within '_Frustum', which is relative to '_Cell'.
+		*/
+		FRUSTUM,
+
+		/*
+		*	Finds the '_MaximumNumberOfResults' entities whose bounds are closest to '_Position', no further away than '_Distance'.
+		*/
+		NEAREST,
+
+		/*
+		*	Finds all entities whose bounds are hit by the ray from '_Position' along '_Direction', no further away than '_Distance'.
+		*/
+		RAY
+	};
+
+	/*
+	*	Result class definition.
+	*/
+	class Result final
+	{
+
+	public:
+
+		//The entity.
+		Entity *RESTRICT _Entity;
+
+		/*
+		*	The distance.
+		*	For sphere and nearest queries, this is the distance from the position to the entity's bounds.
+		*	For ray queries, this is the distance along the ray to where it enters the entity's bounds.
+		*	For box and frustum queries, this is always zero.
+		*/
+		float32 _Distance;
+
+	};
+
+	//The type.
+	Type _Type{ Type::SPHERE };
+
+	//The position. Used by sphere, nearest and ray queries.
+	WorldPosition _Position;
+
+	//The direction, normalized. Used by ray queries.
+	Vector3<float32> _Direction{ 0.0f, 0.0f, 1.0f };
+
+	//The distance. Used as the radius for sphere queries, and as the maximum distance for nearest and ray queries.
+	float32 _Distance{ 0.0f };
+
+	//The box. Used by box queries.
+	WorldSpaceAxisAlignedBoundingBox3D _Box;
+
+	//The frustum. Used by frustum queries.
+	Frustum _Frustum;
+
+	//The cell the frustum is relative to. Used by frustum queries.
+	Vector3<int32> _Cell{ 0, 0, 0 };
+
+	//The maximum number of results. Used by nearest queries.
+	uint32 _MaximumNumberOfResults{ 1 };
+
+	/*
+	*	The results.
+	*	Results of nearest and ray queries are sorted by distance, closest first. Results of other queries are in no particular order.
+	*/
+	DynamicArray<Result> _Results;
+
+};
\ No newline at end of file
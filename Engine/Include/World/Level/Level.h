@@ -7,6 +7,17 @@
 //Entities.
 #include <Entities/Core/Entity.h>
 
+//Forward declarations.
+class ComponentInitializationData;
+
+//Type aliases.
+using LevelSpawnFunction = void(*)
+(
+	ComponentInitializationData *const RESTRICT initialization_data,
+	const uint64 entity_identifier,
+	void *const RESTRICT user_data
+);
+
 class Level final
 {
 
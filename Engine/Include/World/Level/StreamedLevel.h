@@ -0,0 +1,74 @@
+#pragma once
+
+//Core.
+#include <Core/Essential/CatalystEssential.h>
+#include <Core/Containers/DynamicArray.h>
+
+//Content.
+#include <Content/Core/AssetPointer.h>
+#include <Content/Assets/LevelAsset.h>
+
+//Entities.
+#include <Entities/Core/Entity.h>
+
+//World.
+#include <World/Core/WorldTransform.h>
+#include <World/Level/Level.h>
+
+/*
+*	Streamed level class definition.
+*	A level that the level system spawns and despawns cell by cell, as the camera moves through the world.
+*	Owned by the caller, but otherwise managed by the level system from when streaming starts until it stops.
+*/
+class StreamedLevel final
+{
+
+public:
+
+	//Enumeration covering all cell states.
+	enum class CellState : uint8
+	{
+		UNLOADED,
+		SPAWNING,
+		RESIDENT,
+		DESPAWNING
+	};
+
+	/*
+	*	Cell class definition.
+	*/
+	class Cell final
+	{
+
+	public:
+
+		//The world grid cell.
+		Vector3<int32> _WorldCell;
+
+		//The state.
+		CellState _State;
+
+		//The position in the level's stream archive of the next entity to spawn.
+		uint64 _StreamArchivePosition;
+
+		//The entities that are spawned.
+		DynamicArray<Entity *RESTRICT> _Entities;
+
+	};
+
+	//The world transform.
+	WorldTransform _WorldTransform;
+
+	//The level asset.
+	AssetPointer<LevelAsset> _LevelAsset;
+
+	//The spawn function.
+	LevelSpawnFunction _SpawnFunction;
+
+	//The spawn function user data.
+	void *RESTRICT _SpawnFunctionUserData;
+
+	//The cells, in the same order as the level asset's cells.
+	DynamicArray<Cell> _Cells;
+
+};
\ No newline at end of file
@@ -95,7 +95,7 @@ void AnimatedModelComponent::PostInitialize() NOEXCEPT
 	(
 		HashString("AnimationBoneTransforms"),
 		sizeof(Matrix4x4) * 1'024,
-		[](DynamicArray<byte> *const RESTRICT data, void *const RESTRICT arguments)
+		[](StorageBufferWriter *const RESTRICT writer, void *const RESTRICT arguments)
 		{
 			const DynamicArray<Matrix4x4> *const RESTRICT final_bone_transforms{ static_cast<const DynamicArray<Matrix4x4> *const RESTRICT>(arguments) };
 
@@ -104,8 +104,9 @@ void AnimatedModelComponent::PostInitialize() NOEXCEPT
 				return;
 			}
 
-			data->Resize<false>(sizeof(Matrix4x4) * final_bone_transforms->Size());
-			Memory::Copy(data->Data(), final_bone_transforms->Data(), sizeof(Matrix4x4) * final_bone_transforms->Size());
+			const UploadSpan span{ writer->Reserve(sizeof(Matrix4x4) * final_bone_transforms->Size()) };
+
+			Memory::Copy(span._Data, final_bone_transforms->Data(), span._Size);
 		},
 		&_FinalBoneTransforms
 	);
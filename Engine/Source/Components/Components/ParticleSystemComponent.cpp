@@ -1,6 +1,9 @@
 //Header file.
 #include <Components/Components/ParticleSystemComponent.h>
 
+//Core.
+#include <Core/General/SIMD.h>
+
 //Components.
 #include <Components/Components/WorldTransformComponent.h>
 
@@ -86,6 +89,529 @@ void GatherParticlesInputStream(RenderInputStream *const RESTRICT input_stream)
 	}
 }
 
+/*
+*	Counter-based random number generation for particles.
+*	Particle N of a sub emitter always gets the same random numbers, however spawning is batched, so eight particles can be generated at once.
+*/
+namespace ParticleRandom
+{
+	//Enumeration covering all random streams.
+	enum class Stream : uint32
+	{
+		ANGLE,
+		HEIGHT,
+		RADIUS_1,
+		RADIUS_2,
+		RADIUS_3,
+		VELOCITY_X,
+		VELOCITY_Y,
+		VELOCITY_Z,
+		SIZE,
+		LIFETIME,
+
+		NUMBER_OF_STREAMS
+	};
+
+	/*
+	*	Hashes the given value.
+	*/
+	FORCE_INLINE NO_DISCARD uint32 Hash(uint32 X) NOEXCEPT
+	{
+		X ^= X >> 16;
+		X *= 0x7feb352dU;
+		X ^= X >> 15;
+		X *= 0x846ca68bU;
+		X ^= X >> 16;
+
+		return X;
+	}
+
+	/*
+	*	Hashes the given values.
+	*/
+	FORCE_INLINE NO_DISCARD __m256i HashAVX2(__m256i X) NOEXCEPT
+	{
+		X = _mm256_xor_si256(X, _mm256_srli_epi32(X, 16));
+		X = _mm256_mullo_epi32(X, _mm256_set1_epi32(0x7feb352d));
+		X = _mm256_xor_si256(X, _mm256_srli_epi32(X, 15));
+		X = _mm256_mullo_epi32(X, _mm256_set1_epi32(static_cast<int32>(0x846ca68bU)));
+		X = _mm256_xor_si256(X, _mm256_srli_epi32(X, 16));
+
+		return X;
+	}
+
+	/*
+	*	Returns the key for the given seed and stream.
+	*/
+	FORCE_INLINE NO_DISCARD uint32 Key(const uint32 seed, const Stream stream) NOEXCEPT
+	{
+		return Hash(seed + UNDERLYING(stream) * 0x9e3779b9U);
+	}
+
+	/*
+	*	Returns a random float in the range [0.0f, 1.0f) for the given key and counter.
+	*/
+	FORCE_INLINE NO_DISCARD float32 Float(const uint32 key, const uint32 counter) NOEXCEPT
+	{
+		return static_cast<float32>(Hash(counter ^ key) >> 8) * (1.0f / 16'777'216.0f);
+	}
+
+	/*
+	*	Returns random floats in the range [0.0f, 1.0f) for the given key and counters.
+	*/
+	FORCE_INLINE NO_DISCARD __m256 FloatAVX2(const uint32 key, const __m256i counters) NOEXCEPT
+	{
+		const __m256i hash{ HashAVX2(_mm256_xor_si256(counters, _mm256_set1_epi32(static_cast<int32>(key)))) };
+
+		return _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(hash, 8)), _mm256_set1_ps(1.0f / 16'777'216.0f));
+	}
+}
+
+/*
+*	Returns the sine of the given angle, which must be in the range [-PI / 2, PI / 2].
+*/
+FORCE_INLINE NO_DISCARD float32 ParticleSine(const float32 X) NOEXCEPT
+{
+	const float32 X2{ X * X };
+
+	return X * (1.0f + X2 * (-1.0f / 6.0f + X2 * (1.0f / 120.0f + X2 * (-1.0f / 5'040.0f + X2 * (1.0f / 362'880.0f)))));
+}
+
+/*
+*	Returns the sine of the given angles, which must be in the range [-PI / 2, PI / 2].
+*/
+FORCE_INLINE NO_DISCARD __m256 ParticleSineAVX2(const __m256 X) NOEXCEPT
+{
+	const __m256 X2{ _mm256_mul_ps(X, X) };
+
+	__m256 result{ _mm256_set1_ps(1.0f / 362'880.0f) };
+
+	result = _mm256_add_ps(_mm256_set1_ps(-1.0f / 5'040.0f), _mm256_mul_ps(X2, result));
+	result = _mm256_add_ps(_mm256_set1_ps(1.0f / 120.0f), _mm256_mul_ps(X2, result));
+	result = _mm256_add_ps(_mm256_set1_ps(-1.0f / 6.0f), _mm256_mul_ps(X2, result));
+	result = _mm256_add_ps(_mm256_set1_ps(1.0f), _mm256_mul_ps(X2, result));
+
+	return _mm256_mul_ps(X, result);
+}
+
+/*
+*	Spawns particles into the given range of the instances.
+*	Positions are uniformly distributed within the emitter sphere, without any trigonometry calls or rejection sampling:
+*	The azimuth is built from the sine/cosine of half the angle, and the radius is the maximum of three uniform numbers, which has the same distribution as the cube root of one.
+*/
+FORCE_INLINE void SpawnParticles
+(
+	const ParticleEmitter &emitter,
+	const Vector3<float32> &spawn_position,
+	const uint32 random_seed,
+	const uint32 random_counter,
+	const uint32 first_index,
+	const uint32 number_of_particles,
+	ParticleInstances *const RESTRICT instances
+) NOEXCEPT
+{
+	//Cache the keys.
+	StaticArray<uint32, UNDERLYING(ParticleRandom::Stream::NUMBER_OF_STREAMS)> keys;
+
+	for (uint32 stream_index{ 0 }; stream_index < UNDERLYING(ParticleRandom::Stream::NUMBER_OF_STREAMS); ++stream_index)
+	{
+		keys[stream_index] = ParticleRandom::Key(random_seed, static_cast<ParticleRandom::Stream>(stream_index));
+	}
+
+	//Cache the streams.
+	float32 *const RESTRICT positions_x{ instances->Get(ParticleInstances::Stream::POSITION_X) + first_index };
+	float32 *const RESTRICT positions_y{ instances->Get(ParticleInstances::Stream::POSITION_Y) + first_index };
+	float32 *const RESTRICT positions_z{ instances->Get(ParticleInstances::Stream::POSITION_Z) + first_index };
+	float32 *const RESTRICT velocities_x{ instances->Get(ParticleInstances::Stream::VELOCITY_X) + first_index };
+	float32 *const RESTRICT velocities_y{ instances->Get(ParticleInstances::Stream::VELOCITY_Y) + first_index };
+	float32 *const RESTRICT velocities_z{ instances->Get(ParticleInstances::Stream::VELOCITY_Z) + first_index };
+	float32 *const RESTRICT sizes_x{ instances->Get(ParticleInstances::Stream::SIZE_X) + first_index };
+	float32 *const RESTRICT sizes_y{ instances->Get(ParticleInstances::Stream::SIZE_Y) + first_index };
+	float32 *const RESTRICT ages{ instances->Get(ParticleInstances::Stream::AGE) + first_index };
+	float32 *const RESTRICT lifetimes{ instances->Get(ParticleInstances::Stream::LIFETIME) + first_index };
+
+	//Only spheres are supported for now.
+	ASSERT(emitter._ParticleEmitterMode == ParticleEmitterMode::SPHERE, "Invalid case!");
+
+	if (SIMD::GetBackend() == SIMD::Backend::AVX2)
+	{
+		//Whole iterations are written, the streams have room for it.
+		for (uint32 i{ 0 }; i < number_of_particles; i += ParticleInstances::STRIDE)
+		{
+			const __m256i counters{ _mm256_add_epi32(_mm256_set1_epi32(static_cast<int32>(random_counter + i)), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7)) };
+
+			//Randomize the position.
+			{
+				const __m256 half_angle{ _mm256_mul_ps(_mm256_sub_ps(ParticleRandom::FloatAVX2(keys[UNDERLYING(ParticleRandom::Stream::ANGLE)], counters), _mm256_set1_ps(0.5f)), _mm256_set1_ps(BaseMathConstants::PI)) };
+				const __m256 half_sine{ ParticleSineAVX2(half_angle) };
+				const __m256 half_cosine{ _mm256_sqrt_ps(_mm256_max_ps(_mm256_sub_ps(_mm256_set1_ps(1.0f), _mm256_mul_ps(half_sine, half_sine)), _mm256_setzero_ps())) };
+				const __m256 sine{ _mm256_mul_ps(_mm256_set1_ps(2.0f), _mm256_mul_ps(half_sine, half_cosine)) };
+				const __m256 cosine{ _mm256_sub_ps(_mm256_set1_ps(1.0f), _mm256_mul_ps(_mm256_set1_ps(2.0f), _mm256_mul_ps(half_sine, half_sine))) };
+
+				const __m256 height{ _mm256_sub_ps(_mm256_mul_ps(ParticleRandom::FloatAVX2(keys[UNDERLYING(ParticleRandom::Stream::HEIGHT)], counters), _mm256_set1_ps(2.0f)), _mm256_set1_ps(1.0f)) };
+				const __m256 ring{ _mm256_sqrt_ps(_mm256_max_ps(_mm256_sub_ps(_mm256_set1_ps(1.0f), _mm256_mul_ps(height, height)), _mm256_setzero_ps())) };
+
+				__m256 radius{ ParticleRandom::FloatAVX2(keys[UNDERLYING(ParticleRandom::Stream::RADIUS_1)], counters) };
+				radius = _mm256_max_ps(radius, ParticleRandom::FloatAVX2(keys[UNDERLYING(ParticleRandom::Stream::RADIUS_2)], counters));
+				radius = _mm256_max_ps(radius, ParticleRandom::FloatAVX2(keys[UNDERLYING(ParticleRandom::Stream::RADIUS_3)], counters));
+				radius = _mm256_mul_ps(radius, _mm256_set1_ps(emitter._SphereMode._Radius));
+
+				const __m256 ring_radius{ _mm256_mul_ps(radius, ring) };
+
+				_mm256_storeu_ps(&positions_x[i], _mm256_add_ps(_mm256_set1_ps(spawn_position._X), _mm256_mul_ps(ring_radius, cosine)));
+				_mm256_storeu_ps(&positions_y[i], _mm256_add_ps(_mm256_set1_ps(spawn_position._Y), _mm256_mul_ps(ring_radius, sine)));
+				_mm256_storeu_ps(&positions_z[i], _mm256_add_ps(_mm256_set1_ps(spawn_position._Z), _mm256_mul_ps(radius, height)));
+			}
+
+			//Randomize the velocity.
+			_mm256_storeu_ps(&velocities_x[i], _mm256_add_ps(_mm256_set1_ps(emitter._MinimumVelocity._X), _mm256_mul_ps(_mm256_set1_ps(emitter._MaximumVelocity._X - emitter._MinimumVelocity._X), ParticleRandom::FloatAVX2(keys[UNDERLYING(ParticleRandom::Stream::VELOCITY_X)], counters))));
+			_mm256_storeu_ps(&velocities_y[i], _mm256_add_ps(_mm256_set1_ps(emitter._MinimumVelocity._Y), _mm256_mul_ps(_mm256_set1_ps(emitter._MaximumVelocity._Y - emitter._MinimumVelocity._Y), ParticleRandom::FloatAVX2(keys[UNDERLYING(ParticleRandom::Stream::VELOCITY_Y)], counters))));
+			_mm256_storeu_ps(&velocities_z[i], _mm256_add_ps(_mm256_set1_ps(emitter._MinimumVelocity._Z), _mm256_mul_ps(_mm256_set1_ps(emitter._MaximumVelocity._Z - emitter._MinimumVelocity._Z), ParticleRandom::FloatAVX2(keys[UNDERLYING(ParticleRandom::Stream::VELOCITY_Z)], counters))));
+
+			//Randomize the size.
+			{
+				const __m256 alpha{ ParticleRandom::FloatAVX2(keys[UNDERLYING(ParticleRandom::Stream::SIZE)], counters) };
+
+				_mm256_storeu_ps(&sizes_x[i], _mm256_add_ps(_mm256_set1_ps(emitter._MinimumSize._X), _mm256_mul_ps(_mm256_set1_ps(emitter._MaximumSize._X - emitter._MinimumSize._X), alpha)));
+				_mm256_storeu_ps(&sizes_y[i], _mm256_add_ps(_mm256_set1_ps(emitter._MinimumSize._Y), _mm256_mul_ps(_mm256_set1_ps(emitter._MaximumSize._Y - emitter._MinimumSize._Y), alpha)));
+			}
+
+			//Set the age.
+			_mm256_storeu_ps(&ages[i], _mm256_setzero_ps());
+
+			//Randomize the lifetime.
+			_mm256_storeu_ps(&lifetimes[i], _mm256_add_ps(_mm256_set1_ps(emitter._MinimumLifetime), _mm256_mul_ps(_mm256_set1_ps(emitter._MaximumLifetime - emitter._MinimumLifetime), ParticleRandom::FloatAVX2(keys[UNDERLYING(ParticleRandom::Stream::LIFETIME)], counters))));
+		}
+	}
+
+	else
+	{
+		for (uint32 i{ 0 }; i < number_of_particles; ++i)
+		{
+			const uint32 counter{ random_counter + i };
+
+			//Randomize the position.
+			{
+				const float32 half_angle{ (ParticleRandom::Float(keys[UNDERLYING(ParticleRandom::Stream::ANGLE)], counter) - 0.5f) * BaseMathConstants::PI };
+				const float32 half_sine{ ParticleSine(half_angle) };
+				const float32 half_cosine{ BaseMath::SquareRoot(BaseMath::Maximum<float32>(1.0f - half_sine * half_sine, 0.0f)) };
+				const float32 sine{ 2.0f * (half_sine * half_cosine) };
+				const float32 cosine{ 1.0f - 2.0f * (half_sine * half_sine) };
+
+				const float32 height{ ParticleRandom::Float(keys[UNDERLYING(ParticleRandom::Stream::HEIGHT)], counter) * 2.0f - 1.0f };
+				const float32 ring{ BaseMath::SquareRoot(BaseMath::Maximum<float32>(1.0f - height * height, 0.0f)) };
+
+				float32 radius{ ParticleRandom::Float(keys[UNDERLYING(ParticleRandom::Stream::RADIUS_1)], counter) };
+				radius = BaseMath::Maximum<float32>(radius, ParticleRandom::Float(keys[UNDERLYING(ParticleRandom::Stream::RADIUS_2)], counter));
+				radius = BaseMath::Maximum<float32>(radius, ParticleRandom::Float(keys[UNDERLYING(ParticleRandom::Stream::RADIUS_3)], counter));
+				radius *= emitter._SphereMode._Radius;
+
+				const float32 ring_radius{ radius * ring };
+
+				positions_x[i] = spawn_position._X + ring_radius * cosine;
+				positions_y[i] = spawn_position._Y + ring_radius * sine;
+				positions_z[i] = spawn_position._Z + radius * height;
+			}
+
+			//Randomize the velocity.
+			velocities_x[i] = emitter._MinimumVelocity._X + (emitter._MaximumVelocity._X - emitter._MinimumVelocity._X) * ParticleRandom::Float(keys[UNDERLYING(ParticleRandom::Stream::VELOCITY_X)], counter);
+			velocities_y[i] = emitter._MinimumVelocity._Y + (emitter._MaximumVelocity._Y - emitter._MinimumVelocity._Y) * ParticleRandom::Float(keys[UNDERLYING(ParticleRandom::Stream::VELOCITY_Y)], counter);
+			velocities_z[i] = emitter._MinimumVelocity._Z + (emitter._MaximumVelocity._Z - emitter._MinimumVelocity._Z) * ParticleRandom::Float(keys[UNDERLYING(ParticleRandom::Stream::VELOCITY_Z)], counter);
+
+			//Randomize the size.
+			{
+				const float32 alpha{ ParticleRandom::Float(keys[UNDERLYING(ParticleRandom::Stream::SIZE)], counter) };
+
+				sizes_x[i] = emitter._MinimumSize._X + (emitter._MaximumSize._X - emitter._MinimumSize._X) * alpha;
+				sizes_y[i] = emitter._MinimumSize._Y + (emitter._MaximumSize._Y - emitter._MinimumSize._Y) * alpha;
+			}
+
+			//Set the age.
+			ages[i] = 0.0f;
+
+			//Randomize the lifetime.
+			lifetimes[i] = emitter._MinimumLifetime + (emitter._MaximumLifetime - emitter._MinimumLifetime) * ParticleRandom::Float(keys[UNDERLYING(ParticleRandom::Stream::LIFETIME)], counter);
+		}
+	}
+}
+
+/*
+*	Particle simulation parameters class definition.
+*	Everything that is constant across one sub emitter for one update.
+*/
+class ParticleSimulationParameters final
+{
+
+public:
+
+	//The delta time.
+	float32 _DeltaTime;
+
+	//The factor to multiply the velocity with each update, to apply drag.
+	float32 _DragFactor;
+
+	//The value to subtract from the vertical velocity each update, to apply gravity.
+	float32 _GravityDelta;
+
+	//The offset to add to the position each update, to apply wind.
+	Vector3<float32> _WindOffset;
+
+	//The offset to add to positions to make them relative to the current world grid cell.
+	Vector3<float32> _CellOffset;
+
+	//The camera local position.
+	Vector3<float32> _CameraLocalPosition;
+
+	//The camera forward vector.
+	Vector3<float32> _CameraForwardVector;
+
+	//The fade in time.
+	float32 _FadeInTime;
+
+	//The fade out time.
+	float32 _FadeOutTime;
+
+	//Denotes whether or not to shrink near the camera.
+	bool _ShrinkNearCamera;
+
+};
+
+/*
+*	Simulates all particles.
+*	Writes one bit per particle into the alive masks, denoting whether or not it survived this update,
+*	and writes the particles that survived and passed culling into the packed instances. Returns the number of packed instances.
+*/
+FORCE_INLINE NO_DISCARD uint32 SimulateParticles
+(
+	const ParticleSimulationParameters &parameters,
+	ParticleInstances *const RESTRICT instances,
+	uint8 *const RESTRICT alive_masks,
+	ParticlePackedInstance *const RESTRICT packed_instances
+) NOEXCEPT
+{
+	//Cache the streams.
+	float32 *const RESTRICT positions_x{ instances->Get(ParticleInstances::Stream::POSITION_X) };
+	float32 *const RESTRICT positions_y{ instances->Get(ParticleInstances::Stream::POSITION_Y) };
+	float32 *const RESTRICT positions_z{ instances->Get(ParticleInstances::Stream::POSITION_Z) };
+	float32 *const RESTRICT velocities_x{ instances->Get(ParticleInstances::Stream::VELOCITY_X) };
+	float32 *const RESTRICT velocities_y{ instances->Get(ParticleInstances::Stream::VELOCITY_Y) };
+	float32 *const RESTRICT velocities_z{ instances->Get(ParticleInstances::Stream::VELOCITY_Z) };
+	const float32 *const RESTRICT sizes_x{ instances->Get(ParticleInstances::Stream::SIZE_X) };
+	const float32 *const RESTRICT sizes_y{ instances->Get(ParticleInstances::Stream::SIZE_Y) };
+	float32 *const RESTRICT ages{ instances->Get(ParticleInstances::Stream::AGE) };
+	const float32 *const RESTRICT lifetimes{ instances->Get(ParticleInstances::Stream::LIFETIME) };
+
+	const uint32 number_of_particles{ instances->Size() };
+	uint32 number_of_packed_instances{ 0 };
+
+	if (SIMD::GetBackend() == SIMD::Backend::AVX2)
+	{
+		const __m256 delta_time{ _mm256_set1_ps(parameters._DeltaTime) };
+		const __m256 drag_factor{ _mm256_set1_ps(parameters._DragFactor) };
+		const __m256 gravity_delta{ _mm256_set1_ps(parameters._GravityDelta) };
+		const __m256 wind_offset_x{ _mm256_set1_ps(parameters._WindOffset._X) };
+		const __m256 wind_offset_y{ _mm256_set1_ps(parameters._WindOffset._Y) };
+		const __m256 wind_offset_z{ _mm256_set1_ps(parameters._WindOffset._Z) };
+		const __m256 cell_offset_x{ _mm256_set1_ps(parameters._CellOffset._X) };
+		const __m256 cell_offset_y{ _mm256_set1_ps(parameters._CellOffset._Y) };
+		const __m256 cell_offset_z{ _mm256_set1_ps(parameters._CellOffset._Z) };
+		const __m256 camera_position_x{ _mm256_set1_ps(parameters._CameraLocalPosition._X) };
+		const __m256 camera_position_y{ _mm256_set1_ps(parameters._CameraLocalPosition._Y) };
+		const __m256 camera_position_z{ _mm256_set1_ps(parameters._CameraLocalPosition._Z) };
+		const __m256 camera_forward_x{ _mm256_set1_ps(parameters._CameraForwardVector._X) };
+		const __m256 camera_forward_y{ _mm256_set1_ps(parameters._CameraForwardVector._Y) };
+		const __m256 camera_forward_z{ _mm256_set1_ps(parameters._CameraForwardVector._Z) };
+		const __m256i lane_indices{ _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7) };
+
+		ALIGN(32) float32 relative_positions_x[ParticleInstances::STRIDE];
+		ALIGN(32) float32 relative_positions_y[ParticleInstances::STRIDE];
+		ALIGN(32) float32 relative_positions_z[ParticleInstances::STRIDE];
+		ALIGN(32) float32 size_modifiers[ParticleInstances::STRIDE];
+		ALIGN(32) float32 normalized_ages[ParticleInstances::STRIDE];
+
+		for (uint32 i{ 0 }; i < number_of_particles; i += ParticleInstances::STRIDE)
+		{
+			//Update the age.
+			const __m256 age{ _mm256_add_ps(_mm256_loadu_ps(&ages[i]), delta_time) };
+			const __m256 lifetime{ _mm256_loadu_ps(&lifetimes[i]) };
+
+			_mm256_storeu_ps(&ages[i], age);
+
+			//Particles past the end are never alive.
+			const __m256 in_range{ _mm256_castsi256_ps(_mm256_cmpgt_epi32(_mm256_set1_epi32(static_cast<int32>(number_of_particles - i)), lane_indices)) };
+			const __m256 alive{ _mm256_and_ps(_mm256_cmp_ps(age, lifetime, _CMP_LT_OQ), in_range) };
+			const uint32 alive_mask{ static_cast<uint32>(_mm256_movemask_ps(alive)) };
+
+			alive_masks[i / ParticleInstances::STRIDE] = static_cast<uint8>(alive_mask);
+
+			if (alive_mask == 0)
+			{
+				continue;
+			}
+
+			//Apply drag and gravity.
+			const __m256 velocity_x{ _mm256_mul_ps(_mm256_loadu_ps(&velocities_x[i]), drag_factor) };
+			const __m256 velocity_y{ _mm256_sub_ps(_mm256_mul_ps(_mm256_loadu_ps(&velocities_y[i]), drag_factor), gravity_delta) };
+			const __m256 velocity_z{ _mm256_mul_ps(_mm256_loadu_ps(&velocities_z[i]), drag_factor) };
+
+			_mm256_storeu_ps(&velocities_x[i], velocity_x);
+			_mm256_storeu_ps(&velocities_y[i], velocity_y);
+			_mm256_storeu_ps(&velocities_z[i], velocity_z);
+
+			//Update the position based on the velocity, and apply wind.
+			const __m256 position_x{ _mm256_add_ps(_mm256_add_ps(_mm256_loadu_ps(&positions_x[i]), _mm256_mul_ps(velocity_x, delta_time)), wind_offset_x) };
+			const __m256 position_y{ _mm256_add_ps(_mm256_add_ps(_mm256_loadu_ps(&positions_y[i]), _mm256_mul_ps(velocity_y, delta_time)), wind_offset_y) };
+			const __m256 position_z{ _mm256_add_ps(_mm256_add_ps(_mm256_loadu_ps(&positions_z[i]), _mm256_mul_ps(velocity_z, delta_time)), wind_offset_z) };
+
+			_mm256_storeu_ps(&positions_x[i], position_x);
+			_mm256_storeu_ps(&positions_y[i], position_y);
+			_mm256_storeu_ps(&positions_z[i], position_z);
+
+			//Calculate the camera relative position.
+			const __m256 relative_position_x{ _mm256_add_ps(position_x, cell_offset_x) };
+			const __m256 relative_position_y{ _mm256_add_ps(position_y, cell_offset_y) };
+			const __m256 relative_position_z{ _mm256_add_ps(position_z, cell_offset_z) };
+
+			const __m256 to_particle_x{ _mm256_sub_ps(relative_position_x, camera_position_x) };
+			const __m256 to_particle_y{ _mm256_sub_ps(relative_position_y, camera_position_y) };
+			const __m256 to_particle_z{ _mm256_sub_ps(relative_position_z, camera_position_z) };
+
+			//Do _very_ simple culling.
+			const __m256 forward_distance{ _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(camera_forward_x, to_particle_x), _mm256_mul_ps(camera_forward_y, to_particle_y)), _mm256_mul_ps(camera_forward_z, to_particle_z)) };
+			uint32 visible_mask{ alive_mask & static_cast<uint32>(_mm256_movemask_ps(_mm256_cmp_ps(forward_distance, _mm256_setzero_ps(), _CMP_GT_OQ))) };
+
+			if (visible_mask == 0)
+			{
+				continue;
+			}
+
+			//Shrink near camera.
+			if (parameters._ShrinkNearCamera)
+			{
+				const __m256 distance_squared{ _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(to_particle_x, to_particle_x), _mm256_mul_ps(to_particle_y, to_particle_y)), _mm256_mul_ps(to_particle_z, to_particle_z)) };
+
+				_mm256_store_ps(size_modifiers, _mm256_min_ps(_mm256_mul_ps(_mm256_sqrt_ps(distance_squared), _mm256_set1_ps(1.0f / 16.0f)), _mm256_set1_ps(1.0f)));
+			}
+
+			else
+			{
+				_mm256_store_ps(size_modifiers, _mm256_set1_ps(1.0f));
+			}
+
+			_mm256_store_ps(relative_positions_x, relative_position_x);
+			_mm256_store_ps(relative_positions_y, relative_position_y);
+			_mm256_store_ps(relative_positions_z, relative_position_z);
+			_mm256_store_ps(normalized_ages, _mm256_div_ps(age, lifetime));
+
+			//Write out the visible particles.
+			while (visible_mask != 0)
+			{
+				const uint32 lane_index{ static_cast<uint32>(_tzcnt_u32(visible_mask)) };
+
+				visible_mask &= visible_mask - 1;
+
+				ParticlePackedInstance &packed_instance{ packed_instances[number_of_packed_instances++] };
+
+				packed_instance._WorldPosition = Vector3<float32>(relative_positions_x[lane_index], relative_positions_y[lane_index], relative_positions_z[lane_index]);
+				packed_instance._Size = Vector2<float32>(sizes_x[i + lane_index], sizes_y[i + lane_index]) * size_modifiers[lane_index];
+				packed_instance._NormalizedAge = normalized_ages[lane_index];
+				packed_instance._FadeInTime = parameters._FadeInTime;
+				packed_instance._FadeOutTime = parameters._FadeOutTime;
+			}
+		}
+	}
+
+	else
+	{
+		Memory::Set(alive_masks, 0, instances->PaddedSize() / ParticleInstances::STRIDE);
+
+		for (uint32 i{ 0 }; i < number_of_particles; ++i)
+		{
+			//Update the age.
+			ages[i] += parameters._DeltaTime;
+
+			if (ages[i] >= lifetimes[i])
+			{
+				continue;
+			}
+
+			alive_masks[i / ParticleInstances::STRIDE] |= static_cast<uint8>(BIT(i & (ParticleInstances::STRIDE - 1)));
+
+			//Apply drag and gravity.
+			velocities_x[i] = velocities_x[i] * parameters._DragFactor;
+			velocities_y[i] = velocities_y[i] * parameters._DragFactor - parameters._GravityDelta;
+			velocities_z[i] = velocities_z[i] * parameters._DragFactor;
+
+			//Update the position based on the velocity, and apply wind.
+			positions_x[i] = positions_x[i] + velocities_x[i] * parameters._DeltaTime + parameters._WindOffset._X;
+			positions_y[i] = positions_y[i] + velocities_y[i] * parameters._DeltaTime + parameters._WindOffset._Y;
+			positions_z[i] = positions_z[i] + velocities_z[i] * parameters._DeltaTime + parameters._WindOffset._Z;
+
+			//Calculate the camera relative position.
+			const Vector3<float32> relative_position{ Vector3<float32>(positions_x[i], positions_y[i], positions_z[i]) + parameters._CellOffset };
+			const Vector3<float32> to_particle{ relative_position - parameters._CameraLocalPosition };
+
+			//Do _very_ simple culling.
+			if (Vector3<float32>::DotProduct(parameters._CameraForwardVector, to_particle) <= 0.0f)
+			{
+				continue;
+			}
+
+			//Shrink near camera.
+			const float32 size_modifier{ parameters._ShrinkNearCamera ? BaseMath::Minimum<float32>(Vector3<float32>::Length(to_particle) * (1.0f / 16.0f), 1.0f) : 1.0f };
+
+			ParticlePackedInstance &packed_instance{ packed_instances[number_of_packed_instances++] };
+
+			packed_instance._WorldPosition = relative_position;
+			packed_instance._Size = Vector2<float32>(sizes_x[i], sizes_y[i]) * size_modifier;
+			packed_instance._NormalizedAge = ages[i] / lifetimes[i];
+			packed_instance._FadeInTime = parameters._FadeInTime;
+			packed_instance._FadeOutTime = parameters._FadeOutTime;
+		}
+	}
+
+	return number_of_packed_instances;
+}
+
+/*
+*	Removes all dead particles in one pass, by moving alive particles from the back into the holes left by dead ones.
+*/
+FORCE_INLINE void CompactParticles(const uint8 *const RESTRICT alive_masks, ParticleInstances *const RESTRICT instances) NOEXCEPT
+{
+	const auto is_alive{ [alive_masks](const uint32 index)
+	{
+		return TEST_BIT(alive_masks[index / ParticleInstances::STRIDE], BIT(index & (ParticleInstances::STRIDE - 1)));
+	} };
+
+	uint32 number_of_particles{ instances->Size() };
+	uint32 index{ 0 };
+
+	while (index < number_of_particles)
+	{
+		if (is_alive(index))
+		{
+			++index;
+
+			continue;
+		}
+
+		//Find the last alive particle.
+		do
+		{
+			--number_of_particles;
+		} while (number_of_particles > index && !is_alive(number_of_particles));
+
+		if (number_of_particles > index)
+		{
+			instances->Copy(index, number_of_particles);
+
+			++index;
+		}
+	}
+
+	instances->Resize(number_of_particles);
+}
+
 /*
 *	Splits one emitter into X sub emitters.
 */
@@ -121,6 +647,10 @@ FORCE_INLINE void SplitIntoSubEmitters(const ParticleEmitter &master_emitter, Dy
 
 		//Reset if the initial burst has been done.
 		new_sub_emitter._HasDoneInitialBurst = false;
+
+		//Reset the random number generator.
+		new_sub_emitter._RandomSeed = CatalystRandomMath::RandomIntegerInRange<uint32>(0, UINT32_MAXIMUM);
+		new_sub_emitter._RandomCounter = 0;
 	}
 
 	//Add the spawn rate sub emitters.
@@ -142,6 +672,10 @@ FORCE_INLINE void SplitIntoSubEmitters(const ParticleEmitter &master_emitter, Dy
 
 		//Reset if the initial burst has been done.
 		new_sub_emitter._HasDoneInitialBurst = false;
+
+		//Reset the random number generator.
+		new_sub_emitter._RandomSeed = CatalystRandomMath::RandomIntegerInRange<uint32>(0, UINT32_MAXIMUM);
+		new_sub_emitter._RandomCounter = 0;
 	}
 }
 
@@ -303,17 +837,32 @@ void ParticleSystemComponent::PostInitialize() NOEXCEPT
 	(
 		HashString("Particles"),
 		sizeof(ParticlePackedInstance) * 4'096,
-		[](DynamicArray<byte> *const RESTRICT data, void *const RESTRICT arguments)
+		[](StorageBufferWriter *const RESTRICT writer, void *const RESTRICT arguments)
 		{
 			ParticleSystemComponent *const RESTRICT particle_system_component{ static_cast<ParticleSystemComponent* const RESTRICT>(arguments) };
 
-			if (particle_system_component->_SharedData._PackedInstances.Empty())
+			if (particle_system_component->_SharedData._NumberOfPackedInstances == 0)
 			{
 				return;
 			}
 
-			data->Resize<false>(sizeof(ParticlePackedInstance) * particle_system_component->_SharedData._PackedInstances.Size());
-			Memory::Copy(data->Data(), particle_system_component->_SharedData._PackedInstances.Data(), sizeof(ParticlePackedInstance) * particle_system_component->_SharedData._PackedInstances.Size());
+			//Write the packed instances of all sub emitters straight into the mapped storage buffer, in the order the start instance indices were assigned.
+			const UploadSpan span{ writer->Reserve(sizeof(ParticlePackedInstance) * particle_system_component->_SharedData._NumberOfPackedInstances) };
+
+			ParticlePackedInstance *RESTRICT destination{ reinterpret_cast<ParticlePackedInstance *RESTRICT>(span._Data) };
+
+			for (const ParticleSystemInstanceData &instance_data : particle_system_component->InstanceData())
+			{
+				for (const ParticleSubEmitter &sub_emitter : instance_data._SubEmitters)
+				{
+					if (!sub_emitter._PackedInstances.Empty())
+					{
+						Memory::Copy(destination, sub_emitter._PackedInstances.Data(), sizeof(ParticlePackedInstance) * sub_emitter._PackedInstances.Size());
+
+						destination += sub_emitter._PackedInstances.Size();
+					}
+				}
+			}
 		},
 		this
 	);
@@ -361,6 +910,33 @@ void ParticleSystemComponent::ParallelSubInstanceUpdate(const UpdatePhase update
 			//Apply the position offset.
 			current_world_position.SetLocalPosition(current_world_position.GetLocalPosition() + rotated_position_offset);
 
+			//Cache the instances.
+			ParticleInstances &instances{ sub_emitter._Instances };
+
+			//Keep the instances relative to the cell the emitter is in, moving them over if the emitter crossed into another cell.
+			if (instances.Size() == 0)
+			{
+				instances._Cell = current_world_position.GetCell();
+			}
+
+			else if (instances._Cell != current_world_position.GetCell())
+			{
+				const Vector3<int32> cell_delta{ instances._Cell - current_world_position.GetCell() };
+				const Vector3<float32> offset{ Vector3<float32>(static_cast<float32>(cell_delta._X), static_cast<float32>(cell_delta._Y), static_cast<float32>(cell_delta._Z)) * WorldSystem::Instance->GetWorldGridSize() };
+
+				for (uint8 axis_index{ 0 }; axis_index < 3; ++axis_index)
+				{
+					float32 *const RESTRICT positions{ instances.Get(static_cast<ParticleInstances::Stream>(UNDERLYING(ParticleInstances::Stream::POSITION_X) + axis_index)) };
+
+					for (uint32 i{ 0 }; i < instances.Size(); ++i)
+					{
+						positions[i] += offset[axis_index];
+					}
+				}
+
+				instances._Cell = current_world_position.GetCell();
+			}
+
 			//Check spawning of new particles.
 			{
 				PROFILING_SCOPE("Spawn New Particles");
@@ -385,136 +961,70 @@ void ParticleSystemComponent::ParallelSubInstanceUpdate(const UpdatePhase update
 					sub_emitter._TimeSinceLastParticleSpawn -= spawn_rate_reciprocal;
 				}
 
-				for (uint32 particle_to_spawn_index{ 0 }; particle_to_spawn_index < number_of_particles_to_spawn; ++particle_to_spawn_index)
+				if (number_of_particles_to_spawn > 0)
 				{
-					//Create the new particle instance.
-					sub_emitter._Instances.Emplace();
-					ParticleInstance &new_particle_instance{ sub_emitter._Instances.Back() };
+					const uint32 first_index{ instances.Size() };
 
-					//Randomize the world position.
-					switch (sub_emitter._Emitter._ParticleEmitterMode)
-					{
-						case ParticleEmitterMode::SPHERE:
-						{
-							new_particle_instance._WorldPosition = WorldPosition
-							(
-								current_world_position.GetCell(),
-								current_world_position.GetLocalPosition() + CatalystRandomMath::RandomPointInSphere(sub_emitter._Emitter._SphereMode._Radius)
-							);
-
-							break;
-						}
-
-						default:
-						{
-							ASSERT(false, "Invalid case!");
-
-							break;
-						}
-					}
+					instances.Resize(first_index + number_of_particles_to_spawn);
 
-					//Randomize the velocity.
-					new_particle_instance._Velocity = Vector3<float32>
+					SpawnParticles
 					(
-						CatalystRandomMath::RandomFloatInRange(sub_emitter._Emitter._MinimumVelocity._X, sub_emitter._Emitter._MaximumVelocity._X),
-						CatalystRandomMath::RandomFloatInRange(sub_emitter._Emitter._MinimumVelocity._Y, sub_emitter._Emitter._MaximumVelocity._Y),
-						CatalystRandomMath::RandomFloatInRange(sub_emitter._Emitter._MinimumVelocity._Z, sub_emitter._Emitter._MaximumVelocity._Z)
+						sub_emitter._Emitter,
+						current_world_position.GetLocalPosition(),
+						sub_emitter._RandomSeed,
+						sub_emitter._RandomCounter,
+						first_index,
+						number_of_particles_to_spawn,
+						&instances
 					);
 
-					//Randomize the size.
-					new_particle_instance._Size = BaseMath::LinearlyInterpolate(sub_emitter._Emitter._MinimumSize, sub_emitter._Emitter._MaximumSize, CatalystRandomMath::RandomFloat());
-
-					//Set the age.
-					new_particle_instance._Age = 0.0f;
-
-					//Randomize the lifetime.
-					new_particle_instance._Lifetime = CatalystRandomMath::RandomFloatInRange(sub_emitter._Emitter._MinimumLifetime, sub_emitter._Emitter._MaximumLifetime);
+					sub_emitter._RandomCounter += number_of_particles_to_spawn;
 				}
 			}
 
 			//Update all instances.
-			sub_emitter._PackedInstances.Clear();
-
 			{
 				PROFILING_SCOPE("Simulate Particles");
 
-				for (uint64 _instance_index{ 0 }; _instance_index < sub_emitter._Instances.Size();)
-				{
-					ParticleInstance &instance{ sub_emitter._Instances[_instance_index] };
-
-					//Update the age.
-					instance._Age += delta_time;
-
-					if (instance._Age < instance._Lifetime)
-					{
-						//Apply drag.
-						if (sub_emitter._Emitter._Drag > 0.0f)
-						{
-							instance._Velocity -= instance._Velocity * sub_emitter._Emitter._Drag * delta_time;
-						}
-
-						//Apply gravity.
-						if (sub_emitter._Emitter._GravityAffection != 0.0f)
-						{
-							instance._Velocity._Y -= PhysicsConstants::GRAVITY * delta_time * sub_emitter._Emitter._GravityAffection;
-						}
+				//Set up the parameters.
+				ParticleSimulationParameters parameters;
 
-						//Update the position based on the velocity.
-						{
-							Vector3<float32> local_position{ instance._WorldPosition.GetLocalPosition() };
+				parameters._DeltaTime = delta_time;
+				parameters._DragFactor = sub_emitter._Emitter._Drag > 0.0f ? 1.0f - sub_emitter._Emitter._Drag * delta_time : 1.0f;
+				parameters._GravityDelta = PhysicsConstants::GRAVITY * delta_time * sub_emitter._Emitter._GravityAffection;
+				parameters._WindOffset = sub_emitter._Emitter._WindAffection > 0.0f ? WorldSystem::Instance->GetWindSystem()->GetWindDirection() * WorldSystem::Instance->GetWindSystem()->GetWindSpeed() * delta_time * sub_emitter._Emitter._WindAffection : Vector3<float32>(0.0f, 0.0f, 0.0f);
 
-							local_position += instance._Velocity * delta_time;
-
-							instance._WorldPosition.SetLocalPosition(local_position);
-						}
-
-						//Apply wind.
-						if (sub_emitter._Emitter._WindAffection > 0.0f)
-						{
-							Vector3<float32> local_position{ instance._WorldPosition.GetLocalPosition() };
-
-							local_position += WorldSystem::Instance->GetWindSystem()->GetWindDirection() * WorldSystem::Instance->GetWindSystem()->GetWindSpeed() * delta_time * sub_emitter._Emitter._WindAffection;
-
-							instance._WorldPosition.SetLocalPosition(local_position);
-						}
+				{
+					const Vector3<int32> cell_delta{ instances._Cell - WorldSystem::Instance->GetCurrentWorldGridCell() };
 
-						//Calculate the camera relative position.
-						const Vector3<float32> camera_relative_position{ instance._WorldPosition.GetRelativePosition(WorldSystem::Instance->GetCurrentWorldGridCell()) };
+					parameters._CellOffset = Vector3<float32>(static_cast<float32>(cell_delta._X), static_cast<float32>(cell_delta._Y), static_cast<float32>(cell_delta._Z)) * WorldSystem::Instance->GetWorldGridSize();
+				}
 
-						//Calculate modifiers.
-						float32 size_modifier{ 1.0f };
+				parameters._CameraLocalPosition = camera_local_position;
+				parameters._CameraForwardVector = camera_forward_vector;
+				parameters._FadeInTime = sub_emitter._Emitter._FadeInTime;
+				parameters._FadeOutTime = sub_emitter._Emitter._FadeOutTime;
+				parameters._ShrinkNearCamera = sub_emitter._Emitter._ShrinkNearCamera;
 
-						//Shrink near camera.
-						if (sub_emitter._Emitter._ShrinkNearCamera)
-						{
-							const float32 distance_to_camera{ Vector3<float32>::Length(camera_relative_position - camera_local_position) };
+				//Make room for one packed instance per particle, that's the most that can be visible.
+				sub_emitter._PackedInstances.Clear();
 
-							size_modifier = BaseMath::Minimum<float32>(distance_to_camera / 16.0f, 1.0f);
-						}
+				if (sub_emitter._PackedInstances.Capacity() < instances.Size())
+				{
+					sub_emitter._PackedInstances.Reserve(BaseMath::Maximum<uint64>(instances.Size(), sub_emitter._PackedInstances.Capacity() * 2));
+				}
 
-						//Do _very_ simple culling.
-						if (Vector3<float32>::DotProduct(camera_forward_vector, camera_relative_position - camera_local_position) > 0.0f)
-						{
-							sub_emitter._PackedInstances.Emplace();
-							ParticlePackedInstance &packed_instance{ sub_emitter._PackedInstances.Back() };
+				//The alive masks are scratch memory, reused across updates on the same thread.
+				static thread_local DynamicArray<uint8> ALIVE_MASKS;
 
-							packed_instance._WorldPosition = camera_relative_position;
-							packed_instance._Size = instance._Size * size_modifier;
-							packed_instance._NormalizedAge = instance._Age / instance._Lifetime;
-							packed_instance._FadeInTime = sub_emitter._Emitter._FadeInTime;
-							packed_instance._FadeOutTime = sub_emitter._Emitter._FadeOutTime;
-						}
+				ALIVE_MASKS.Resize<false>(instances.PaddedSize() / ParticleInstances::STRIDE);
 
-						++_instance_index;
-					}
+				const uint32 number_of_packed_instances{ SimulateParticles(parameters, &instances, ALIVE_MASKS.Data(), sub_emitter._PackedInstances.Data()) };
 
-					else
-					{
-						PROFILING_SCOPE("Remove Particle");
+				sub_emitter._PackedInstances.Resize<false>(number_of_packed_instances);
 
-						sub_emitter._Instances.EraseAt<false>(_instance_index);
-					}
-				}
+				//Remove dead particles.
+				CompactParticles(ALIVE_MASKS.Data(), &instances);
 			}
 
 			break;
@@ -553,7 +1063,7 @@ void ParticleSystemComponent::PostUpdate(const UpdatePhase update_phase) NOEXCEP
 
 			for (const ParticleSubEmitter& sub_emitter : instance_data._SubEmitters)
 			{
-				all_sub_emitters_dead &= (sub_emitter._Emitter._InitialBurst == 0 || sub_emitter._HasDoneInitialBurst) && sub_emitter._Emitter._SpawnRate == 0 && sub_emitter._PackedInstances.Empty();
+				all_sub_emitters_dead &= (sub_emitter._Emitter._InitialBurst == 0 || sub_emitter._HasDoneInitialBurst) && sub_emitter._Emitter._SpawnRate == 0 && sub_emitter._Instances.Size() == 0;
 			}
 
 			if (all_sub_emitters_dead)
@@ -563,53 +1073,22 @@ void ParticleSystemComponent::PostUpdate(const UpdatePhase update_phase) NOEXCEP
 		}
 	}
 
-	//Gather all packed instances.
-	_SharedData._PackedInstances.Clear();
-
-	//Calculate the number of shared instances.
-	uint64 number_of_packed_instances{ 0 };
-
-	for (const ParticleSystemInstanceData &instance_data : InstanceData())
-	{
-		for (const ParticleSubEmitter &sub_emitter : instance_data._SubEmitters)
-		{
-			number_of_packed_instances += sub_emitter._PackedInstances.Size();
-		}
-	}
-
-	//Don't do anything if there's nothing to do. (:
-	if (number_of_packed_instances == 0)
-	{
-		for (ParticleSystemInstanceData &instance_data : InstanceData())
-		{
-			instance_data._NumberOfInstances = 0;
-		}
-
-		return;
-	}
-
-	//Resize to fit the number of packed instances.
-	_SharedData._PackedInstances.Resize<false>(number_of_packed_instances);
-
-	//Copy over the packed instances.
+	//Assign start instance indices, the packed instances are written to the storage buffer in the same order.
 	uint32 instance_counter{ 0 };
 
 	for (ParticleSystemInstanceData &instance_data : InstanceData())
 	{
-		instance_data._StartInstanceIndex = static_cast<uint32>(instance_counter);
+		instance_data._StartInstanceIndex = instance_counter;
 
 		for (const ParticleSubEmitter &sub_emitter : instance_data._SubEmitters)
 		{
-			if (!sub_emitter._PackedInstances.Empty())
-			{
-				Memory::Copy(&_SharedData._PackedInstances[instance_counter], sub_emitter._PackedInstances.Data(), sizeof(ParticlePackedInstance) * sub_emitter._PackedInstances.Size());
-
-				instance_counter += static_cast<uint32>(sub_emitter._PackedInstances.Size());
-			}
+			instance_counter += static_cast<uint32>(sub_emitter._PackedInstances.Size());
 		}
 
 		instance_data._NumberOfInstances = instance_counter - instance_data._StartInstanceIndex;
 	}
+
+	_SharedData._NumberOfPackedInstances = instance_counter;
 }
 
 /*
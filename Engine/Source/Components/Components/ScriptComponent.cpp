@@ -4,6 +4,18 @@
 //Generated
 #include <Generated/Script.Generated.h>
 
+//Math.
+#include <Math/Core/BaseMath.h>
+
+//Systems.
+#include <Systems/TaskSystem.h>
+
+//Script component constants.
+namespace ScriptComponentConstants
+{
+	constexpr uint64 BATCH_SIZE{ 256 };
+}
+
 /*
 *	Initializes this component.
 */
@@ -27,20 +39,10 @@ void ScriptComponent::SerialUpdate(const UpdatePhase update_phase) NOEXCEPT
 	{
 		case UpdatePhase::GAMEPLAY:
 		{
-			//Iterate over the instances.
-			for (uint64 instance_index{ 0 }; instance_index < NumberOfInstances(); ++instance_index)
+			//Update the waves in order, which keeps the order scripts see each other's changes in deterministic.
+			for (uint32 update_wave{ 0 }; update_wave < Script::NUMBER_OF_UPDATE_WAVES; ++update_wave)
 			{
-				//Cache the instance data.
-				ScriptInstanceData &instance_data{ _InstanceData[instance_index] };
-
-				//Set up the script context.
-				ScriptContext script_context;
-
-				script_context._Entity = InstanceToEntity(instance_index);
-				script_context._Data = instance_data._Data;
-
-				//Update!
-				Script::Update(instance_data._ScriptIdentifier, script_context);
+				UpdateWave(update_wave);
 			}
 
 			break;
@@ -73,25 +75,14 @@ void ScriptComponent::PostCreateInstance(Entity *const RESTRICT entity) NOEXCEPT
 	//Cache the instance data.
 	ScriptInstanceData &instance_data{ InstanceData(entity) };
 
-	//Allocate the required data.
-	const uint64 required_data_size{ Script::RequiredDataSize(instance_data._ScriptIdentifier) };
-
-	if (required_data_size > 0)
-	{
-		instance_data._Data = Memory::Allocate(required_data_size);
-		Memory::Set(instance_data._Data, 0, required_data_size);
-	}
-
-	else
-	{
-		instance_data._Data = nullptr;
-	}
+	//Add it to it's script block.
+	AddToScriptBlock(entity, &instance_data);
 
 	//Set up the script context.
 	ScriptContext script_context;
 
 	script_context._Entity = entity;
-	script_context._Data = instance_data._Data;
+	script_context._Data = Data(instance_data);
 
 	//Initialize the script.
 	Script::Initialize(instance_data._ScriptIdentifier, script_context);
@@ -112,13 +103,13 @@ void ScriptComponent::DestroyInstance(Entity *const RESTRICT entity) NOEXCEPT
 	ScriptContext script_context;
 
 	script_context._Entity = entity;
-	script_context._Data = instance_data._Data;
+	script_context._Data = Data(instance_data);
 
 	//Terminate the script.
 	Script::Terminate(instance_data._ScriptIdentifier, script_context);
 
-	//Free the data.
-	Memory::Free(instance_data._Data);
+	//Remove it from it's script block.
+	RemoveFromScriptBlock(&instance_data);
 
 	//Remove the instance.
 	RemoveInstance(entity);
@@ -138,13 +129,13 @@ void ScriptComponent::PreEditableFieldChange(Entity *const RESTRICT entity, cons
 		ScriptContext script_context;
 
 		script_context._Entity = entity;
-		script_context._Data = instance_data._Data;
+		script_context._Data = Data(instance_data);
 
 		//Terminate the current script.
 		Script::Terminate(instance_data._ScriptIdentifier, script_context);
 
-		//Free the data.
-		Memory::Free(instance_data._Data);
+		//Remove it from it's script block.
+		RemoveFromScriptBlock(&instance_data);
 	}
 }
 
@@ -158,25 +149,14 @@ void ScriptComponent::PostEditableFieldChange(Entity *const RESTRICT entity, con
 
 	if (editable_field._Identifier == HashString("Script"))
 	{
-		//Allocate the required data.
-		const uint64 required_data_size{ Script::RequiredDataSize(instance_data._ScriptIdentifier) };
-
-		if (required_data_size > 0)
-		{
-			instance_data._Data = Memory::Allocate(required_data_size);
-			Memory::Set(instance_data._Data, 0, required_data_size);
-		}
-
-		else
-		{
-			instance_data._Data = nullptr;
-		}
+		//Add it to the script block of the new script.
+		AddToScriptBlock(entity, &instance_data);
 
 		//Set up the script context.
 		ScriptContext script_context;
 
 		script_context._Entity = entity;
-		script_context._Data = instance_data._Data;
+		script_context._Data = Data(instance_data);
 
 		//Initialize the script.
 		Script::Initialize(instance_data._ScriptIdentifier, script_context);
@@ -195,7 +175,7 @@ void ScriptComponent::Event(Entity *const RESTRICT entity, const HashString even
 	ScriptContext script_context;
 
 	script_context._Entity = entity;
-	script_context._Data = instance_data._Data;
+	script_context._Data = Data(instance_data);
 
 	//Send the event!
 	Script::Event(instance_data._ScriptIdentifier, event, script_context);
@@ -210,8 +190,185 @@ void ScriptComponent::Statistics(ComponentStatistics *const RESTRICT statistics)
 	for (const ScriptInstanceData &instance_data : _InstanceData)
 	{
 		statistics->_CPUMemoryUsage += sizeof(instance_data._ScriptIdentifier);
-		statistics->_CPUMemoryUsage += sizeof(instance_data._Data);
+		statistics->_CPUMemoryUsage += sizeof(instance_data._BlockIndex);
+		statistics->_CPUMemoryUsage += sizeof(Entity *);
 		statistics->_CPUMemoryUsage += Script::RequiredDataSize(instance_data._ScriptIdentifier);
 	}
 }
-#endif
\ No newline at end of file
+#endif
+
+/*
+*	Returns the data for the given instance.
+*/
+NO_DISCARD void *const RESTRICT ScriptComponent::Data(const ScriptInstanceData &instance_data) NOEXCEPT
+{
+	const uint64 required_data_size{ Script::RequiredDataSize(instance_data._ScriptIdentifier) };
+
+	if (required_data_size == 0)
+	{
+		return nullptr;
+	}
+
+	return &_ScriptBlocks[static_cast<uint32>(instance_data._ScriptIdentifier)]._Data[instance_data._BlockIndex * required_data_size];
+}
+
+/*
+*	Adds the given instance to the script block of it's script identifier, with zeroed data.
+*/
+void ScriptComponent::AddToScriptBlock(Entity *const RESTRICT entity, ScriptInstanceData *const RESTRICT instance_data) NOEXCEPT
+{
+	const uint32 script_block_index{ static_cast<uint32>(instance_data->_ScriptIdentifier) };
+
+	while (_ScriptBlocks.Size() <= script_block_index)
+	{
+		_ScriptBlocks.Emplace();
+	}
+
+	ScriptBlock &script_block{ _ScriptBlocks[script_block_index] };
+
+	instance_data->_BlockIndex = script_block._Entities.Size();
+	script_block._Entities.Emplace(entity);
+
+	const uint64 required_data_size{ Script::RequiredDataSize(instance_data->_ScriptIdentifier) };
+
+	if (required_data_size > 0)
+	{
+		const uint64 data_offset{ script_block._Data.Size() };
+
+		//Grow geometrically, since instances are usually added one at a time.
+		if (data_offset + required_data_size > script_block._Data.Capacity())
+		{
+			script_block._Data.Reserve(BaseMath::Maximum<uint64>(script_block._Data.Capacity() * 2, data_offset + required_data_size));
+		}
+
+		script_block._Data.Resize<false>(data_offset + required_data_size);
+		Memory::Set(&script_block._Data[data_offset], 0, required_data_size);
+	}
+}
+
+/*
+*	Removes the given instance from the script block of it's script identifier.
+*/
+void ScriptComponent::RemoveFromScriptBlock(ScriptInstanceData *const RESTRICT instance_data) NOEXCEPT
+{
+	ScriptBlock &script_block{ _ScriptBlocks[static_cast<uint32>(instance_data->_ScriptIdentifier)] };
+
+	const uint64 block_index{ instance_data->_BlockIndex };
+	const uint64 last_block_index{ script_block._Entities.LastIndex() };
+	const uint64 required_data_size{ Script::RequiredDataSize(instance_data->_ScriptIdentifier) };
+
+	//Move the last instance into the freed slot.
+	if (block_index != last_block_index)
+	{
+		Entity *const RESTRICT last_entity{ script_block._Entities[last_block_index] };
+
+		script_block._Entities[block_index] = last_entity;
+		InstanceData(last_entity)._BlockIndex = block_index;
+
+		if (required_data_size > 0)
+		{
+			Memory::Copy(&script_block._Data[block_index * required_data_size], &script_block._Data[last_block_index * required_data_size], required_data_size);
+		}
+	}
+
+	script_block._Entities.Pop();
+
+	if (required_data_size > 0)
+	{
+		script_block._Data.Resize<false>(script_block._Data.Size() - required_data_size);
+	}
+}
+
+/*
+*	Updates all instances in the given update wave.
+*/
+void ScriptComponent::UpdateWave(const uint32 update_wave) NOEXCEPT
+{
+	//Figure out how many batches this wave has. Serial scripts run right away, as they have a wave of their own.
+	uint64 number_of_batches{ 0 };
+
+	for (uint32 script_block_index{ 0 }; script_block_index < _ScriptBlocks.Size(); ++script_block_index)
+	{
+		ScriptBlock &script_block{ _ScriptBlocks[script_block_index] };
+		const ScriptIdentifier script_identifier{ script_block_index };
+
+		if (script_block._Entities.Empty() || Script::UpdateWave(script_identifier) != update_wave)
+		{
+			continue;
+		}
+
+		if (!Script::IsParallel(script_identifier))
+		{
+			Script::UpdateBatch(script_identifier, script_block._Entities.Data(), script_block._Data.Data(), 0, script_block._Entities.Size());
+
+			return;
+		}
+
+		number_of_batches += (script_block._Entities.Size() + ScriptComponentConstants::BATCH_SIZE - 1) / ScriptComponentConstants::BATCH_SIZE;
+	}
+
+	if (number_of_batches == 0)
+	{
+		return;
+	}
+
+	//Not worth going wide for a single batch.
+	if (number_of_batches == 1 || !TaskSystem::Instance)
+	{
+		for (uint32 script_block_index{ 0 }; script_block_index < _ScriptBlocks.Size(); ++script_block_index)
+		{
+			ScriptBlock &script_block{ _ScriptBlocks[script_block_index] };
+			const ScriptIdentifier script_identifier{ script_block_index };
+
+			if (!script_block._Entities.Empty() && Script::UpdateWave(script_identifier) == update_wave)
+			{
+				Script::UpdateBatch(script_identifier, script_block._Entities.Data(), script_block._Data.Data(), 0, script_block._Entities.Size());
+			}
+		}
+
+		return;
+	}
+
+	if (_UpdateBatches.Size() < number_of_batches)
+	{
+		_UpdateBatches.Resize<true>(number_of_batches);
+	}
+
+	//Gather the batches.
+	uint64 batch_index{ 0 };
+
+	for (uint32 script_block_index{ 0 }; script_block_index < _ScriptBlocks.Size(); ++script_block_index)
+	{
+		ScriptBlock &script_block{ _ScriptBlocks[script_block_index] };
+		const ScriptIdentifier script_identifier{ script_block_index };
+
+		if (script_block._Entities.Empty() || Script::UpdateWave(script_identifier) != update_wave)
+		{
+			continue;
+		}
+
+		for (uint64 start_index{ 0 }; start_index < script_block._Entities.Size(); start_index += ScriptComponentConstants::BATCH_SIZE)
+		{
+			ScriptUpdateBatch &batch{ _UpdateBatches[batch_index++] };
+
+			batch._ScriptIdentifier = script_identifier;
+			batch._ScriptBlock = &script_block;
+			batch._StartIndex = start_index;
+			batch._EndIndex = BaseMath::Minimum<uint64>(start_index + ScriptComponentConstants::BATCH_SIZE, script_block._Entities.Size());
+		}
+	}
+
+	//Update the batches.
+	TaskSystem::ParallelFor
+	(
+		Task::Priority::HIGH,
+		static_cast<uint32>(number_of_batches),
+		[](void *const RESTRICT arguments, const uint32 index)
+		{
+			const ScriptUpdateBatch &batch{ static_cast<const ScriptUpdateBatch *const RESTRICT>(arguments)[index] };
+
+			Script::UpdateBatch(batch._ScriptIdentifier, batch._ScriptBlock->_Entities.Data(), batch._ScriptBlock->_Data.Data(), batch._StartIndex, batch._EndIndex);
+		},
+		_UpdateBatches.Data()
+	);
+}
\ No newline at end of file
@@ -284,11 +284,19 @@ void StaticModelComponent::ParallelBatchUpdate(const UpdatePhase update_phase, c
 				}
 
 				//Update the world space axis aligned bounding box.
+				const WorldSpaceAxisAlignedBoundingBox3D previous_world_space_axis_aligned_bounding_box{ instance_data._WorldSpaceAxisAlignedBoundingBox };
+
 				AxisAlignedBoundingBox3D local_axis_aligned_bounding_box;
 				RenderingUtilities::TransformAxisAlignedBoundingBox(instance_data._Model->_ModelSpaceAxisAlignedBoundingBox, world_transform_instance_data._CurrentWorldTransform.ToLocalMatrix4x4(), &local_axis_aligned_bounding_box);
 				instance_data._WorldSpaceAxisAlignedBoundingBox._Minimum = WorldPosition(world_transform_instance_data._CurrentWorldTransform.GetCell(), local_axis_aligned_bounding_box._Minimum);
 				instance_data._WorldSpaceAxisAlignedBoundingBox._Maximum = WorldPosition(world_transform_instance_data._CurrentWorldTransform.GetCell(), local_axis_aligned_bounding_box._Maximum);
 
+				//Let the shadows system know if the world transform has updated, so that it can invalidate it's cached shadow casters.
+				if (world_transform_instance_data._PreviousWorldTransform != world_transform_instance_data._CurrentWorldTransform)
+				{
+					RenderingSystem::Instance->GetShadowsSystem()->OnStaticModelInstanceMoved(entity, previous_world_space_axis_aligned_bounding_box, instance_data._WorldSpaceAxisAlignedBoundingBox);
+				}
+
 				//Retrieve the relative axis aligned bounding box.
 				const AxisAlignedBoundingBox3D relative_axis_aligned_bounding_box{ instance_data._WorldSpaceAxisAlignedBoundingBox.GetRelativeAxisAlignedBoundingBox(camera_world_transform.GetCell()) };
 
@@ -494,6 +502,9 @@ void StaticModelComponent::PostCreateInstance(Entity *const RESTRICT entity) NOE
 	//Tell the ray tracing system.
 	RenderingSystem::Instance->GetRayTracingSystem()->OnStaticModelInstanceCreated(entity, _InstanceData.Back());
 
+	//Tell the shadows system.
+	RenderingSystem::Instance->GetShadowsSystem()->OnStaticModelInstanceCreated(entity, static_model_instance_data._WorldSpaceAxisAlignedBoundingBox);
+
 	//Create the physics actor.
 	if (static_model_instance_data._CollisionType != ModelCollisionType::NONE)
 	{
@@ -537,6 +548,9 @@ void StaticModelComponent::DestroyInstance(Entity *const RESTRICT entity) NOEXCE
 	//Tell the ray tracing system.
 	RenderingSystem::Instance->GetRayTracingSystem()->OnStaticModelInstanceDestroyed(entity, instance_data);
 
+	//Tell the shadows system.
+	RenderingSystem::Instance->GetShadowsSystem()->OnStaticModelInstanceDestroyed(entity, instance_data._WorldSpaceAxisAlignedBoundingBox);
+
 	//Remove the instance.
 	RemoveInstance(entity);
 }
@@ -594,6 +608,12 @@ void StaticModelComponent::PostEditableFieldChange(Entity *const RESTRICT entity
 			instance_data._PhysicsActorHandle = nullptr;
 		}
 	}
+
+	//Changing the model or the materials changes how this instance casts shadows.
+	if (editable_field._Identifier == HashString("Model") || editable_field._Identifier == HashString("Material 1") || editable_field._Identifier == HashString("Material 2"))
+	{
+		RenderingSystem::Instance->GetShadowsSystem()->OnStaticModelInstanceMoved(entity, instance_data._WorldSpaceAxisAlignedBoundingBox, instance_data._WorldSpaceAxisAlignedBoundingBox);
+	}
 }
 
 /*
@@ -21,7 +21,6 @@
 //Terrain.
 #include <Terrain/TerrainGeneralUtilities.h>
 #include <Terrain/TerrainVertex.h>
-#include <Terrain/TerrainQuadTreeUtilities.h>
 
 #if !defined(CATALYST_CONFIGURATION_FINAL)
 //Denotes whether or not terrain wireframe is enabled.
@@ -62,57 +61,46 @@ FORCE_INLINE void GatherTerrainWireframeQuadTreeNode
 	RenderInputStream *const RESTRICT input_stream
 ) NOEXCEPT
 {
-	if (node.IsSubdivided())
+	//Ignore this node if it not visible.
+	if (!node._Visible)
 	{
-		for (const TerrainQuadTreeNode &child_node : node._ChildNodes)
-		{
-			GatherTerrainWireframeQuadTreeNode(instance_data, child_node, input_stream);
-		}
+		return;
 	}
 
-	else
+	//Add a new entry.
+	input_stream->_Entries.Emplace();
+	RenderInputStreamEntry &new_entry{ input_stream->_Entries.Back() };
+
+	new_entry._PushConstantDataOffset = input_stream->_PushConstantDataMemory.Size();
+	new_entry._VertexBuffer = instance_data._Buffer;
+	new_entry._IndexBuffer = instance_data._Buffer;
+	new_entry._IndexBufferOffset = instance_data._IndexOffset;
+	new_entry._InstanceBuffer = EMPTY_HANDLE;
+	new_entry._VertexCount = 0;
+	new_entry._IndexCount = instance_data._IndexCount;
+	new_entry._InstanceCount = 0;
+
+	//Set up the push constant data.
+	TerrainWireframePushConstantData push_constant_data;
+
+	push_constant_data._Color = Vector3<float32>(1.0f, 1.0f, 1.0f);
+	const Vector3<float32> component_world_position{ instance_data._WorldPosition.GetRelativePosition(WorldSystem::Instance->GetCurrentWorldGridCell()) };
+	push_constant_data._WorldPosition = Vector2<float32>(component_world_position._X, component_world_position._Z) + node._Position;
+	push_constant_data._MinimumHeightMapCoordinate = node._MinimumHeightMapCoordinate;
+	push_constant_data._MaximumHeightMapCoordinate = node._MaximumHeightMapCoordinate;
+	push_constant_data._Borders = node._Borders;
+	push_constant_data._PatchResolutionReciprocal = 1.0f / static_cast<float32>(instance_data._BaseResolution);
+	push_constant_data._PatchSize = node._PatchSize;
+	push_constant_data._HeightMapTextureIndex = instance_data._HeightMapTextureIndex;
+	push_constant_data._NormalMapTextureIndex = instance_data._NormalMapTextureIndex;
+	push_constant_data._IndexMapTextureIndex = instance_data._IndexMapTextureIndex;
+	push_constant_data._BlendMapTextureIndex = instance_data._BlendMapTextureIndex;
+	push_constant_data._MapResolution = static_cast<float32>(instance_data._HeightMap.GetResolution());
+	push_constant_data._MapResolutionReciprocal = 1.0f / push_constant_data._MapResolution;
+
+	for (uint64 i{ 0 }; i < sizeof(TerrainWireframePushConstantData); ++i)
 	{
-		//Ignore this node if it not visible.
-		if (!node._Visible)
-		{
-			return;
-		}
-
-		//Add a new entry.
-		input_stream->_Entries.Emplace();
-		RenderInputStreamEntry &new_entry{ input_stream->_Entries.Back() };
-
-		new_entry._PushConstantDataOffset = input_stream->_PushConstantDataMemory.Size();
-		new_entry._VertexBuffer = instance_data._Buffer;
-		new_entry._IndexBuffer = instance_data._Buffer;
-		new_entry._IndexBufferOffset = instance_data._IndexOffset;
-		new_entry._InstanceBuffer = EMPTY_HANDLE;
-		new_entry._VertexCount = 0;
-		new_entry._IndexCount = instance_data._IndexCount;
-		new_entry._InstanceCount = 0;
-
-		//Set up the push constant data.
-		TerrainWireframePushConstantData push_constant_data;
-
-		push_constant_data._Color = Vector3<float32>(1.0f, 1.0f, 1.0f);
-		const Vector3<float32> component_world_position{ instance_data._WorldPosition.GetRelativePosition(WorldSystem::Instance->GetCurrentWorldGridCell()) };
-		push_constant_data._WorldPosition = Vector2<float32>(component_world_position._X, component_world_position._Z) + node._Position;
-		push_constant_data._MinimumHeightMapCoordinate = node._MinimumHeightMapCoordinate;
-		push_constant_data._MaximumHeightMapCoordinate = node._MaximumHeightMapCoordinate;
-		push_constant_data._Borders = node._Borders;
-		push_constant_data._PatchResolutionReciprocal = 1.0f / static_cast<float32>(instance_data._BaseResolution);
-		push_constant_data._PatchSize = node._PatchSize;
-		push_constant_data._HeightMapTextureIndex = instance_data._HeightMapTextureIndex;
-		push_constant_data._NormalMapTextureIndex = instance_data._NormalMapTextureIndex;
-		push_constant_data._IndexMapTextureIndex = instance_data._IndexMapTextureIndex;
-		push_constant_data._BlendMapTextureIndex = instance_data._BlendMapTextureIndex;
-		push_constant_data._MapResolution = static_cast<float32>(instance_data._HeightMap.GetResolution());
-		push_constant_data._MapResolutionReciprocal = 1.0f / push_constant_data._MapResolution;
-
-		for (uint64 i{ 0 }; i < sizeof(TerrainWireframePushConstantData); ++i)
-		{
-			input_stream->_PushConstantDataMemory.Emplace(((const byte *const RESTRICT)&push_constant_data)[i]);
-		}
+		input_stream->_PushConstantDataMemory.Emplace(((const byte *const RESTRICT)&push_constant_data)[i]);
 	}
 }
 
@@ -138,274 +126,15 @@ void GatherTerrainWireframeRenderInputStream(RenderInputStream *const RESTRICT i
 				continue;
 			}
 
-			//Walk the quad tree.
-			GatherTerrainWireframeQuadTreeNode(instance_data, instance_data._QuadTree._RootNode, input_stream);
-		}
-	}
-}
-#endif
-
-/*
-*	Checks combination of a node.
-*/
-void CheckCombination(TerrainInstanceData &instance_data, const Vector3<float32> &camera_position, TerrainQuadTreeNode *const RESTRICT node) NOEXCEPT
-{
-	//If this node is already subdivided, check all of it's child nodes.
-	if (node->IsSubdivided())
-	{
-		if (TerrainQuadTreeUtilities::ShouldBeCombined(instance_data._PatchSize, instance_data._MaximumSubdivisionSteps, *node, camera_position))
-		{
-			node->_ChildNodes.Clear();
-		}
-
-		else
-		{
-			for (uint8 i{ 0 }; i < 4; ++i)
-			{
-				CheckCombination(instance_data, camera_position, &node->_ChildNodes[i]);
-			}
-		}
-	}
-}
-
-/*
-*	Checks subdivisions of a node.
-*/
-void CheckSubdivision(TerrainInstanceData &instance_data, const Vector3<float32> &camera_position, TerrainQuadTreeNode *const RESTRICT node) NOEXCEPT
-{
-	//If this node is already subdivided, check all of it's child nodes.
-	if (node->IsSubdivided())
-	{
-		for (uint8 i{ 0 }; i < 4; ++i)
-		{
-			CheckSubdivision(instance_data, camera_position, &node->_ChildNodes[i]);
-		}
-	}
-
-	//Else, check if this node should be subdivided.
-	else
-	{
-		if (TerrainQuadTreeUtilities::ShouldBeSubdivided(instance_data._PatchSize, instance_data._MaximumSubdivisionSteps, *node, camera_position))
-		{
-			//Calculate the patch size multiplier.
-			const float32 patch_size_multiplier{ TerrainQuadTreeUtilities::PatchSizeMultiplier(*node) * 0.5f };
-
-			//Set up the new nodes.
-			node->_ChildNodes.Upsize<true>(4);
-
-			for (uint64 current_node_index{ 0 }; current_node_index < 4; ++current_node_index)
+			//Walk the leaf nodes of the quad tree.
+			for (const uint32 node_index : instance_data._QuadTree._LeafNodes)
 			{
-				TerrainQuadTreeNode &child_node{ node->_ChildNodes[current_node_index] };
-
-				child_node._Depth = node->_Depth + 1;
-				child_node._Borders = 0;
-
-				switch (current_node_index)
-				{
-					case 0:
-					{
-						child_node._Minimum = child_node._Maximum = Vector2<float32>
-						(
-							node->_Minimum._X + static_cast<float32>(instance_data._PatchSize) * patch_size_multiplier * 1.5f,
-							node->_Minimum._Y + static_cast<float32>(instance_data._PatchSize) * patch_size_multiplier * 0.5f
-						);
-
-						break;
-					}
-
-					case 1:
-					{
-						child_node._Minimum = child_node._Maximum = Vector2<float32>
-						(
-							node->_Minimum._X + static_cast<float32>(instance_data._PatchSize) * patch_size_multiplier * 1.5f,
-							node->_Minimum._Y + static_cast<float32>(instance_data._PatchSize) * patch_size_multiplier * 1.5f
-						);
-
-						break;
-					}
-
-					case 2:
-					{
-						child_node._Minimum = child_node._Maximum = Vector2<float32>
-						(
-							node->_Minimum._X + static_cast<float32>(instance_data._PatchSize) * patch_size_multiplier * 0.5f,
-							node->_Minimum._Y + static_cast<float32>(instance_data._PatchSize) * patch_size_multiplier * 1.5f
-						);
-
-						break;
-					}
-
-					case 3:
-					{
-						child_node._Minimum = child_node._Maximum = Vector2<float32>
-						(
-							node->_Minimum._X + static_cast<float32>(instance_data._PatchSize) * patch_size_multiplier * 0.5f,
-							node->_Minimum._Y + static_cast<float32>(instance_data._PatchSize) * patch_size_multiplier * 0.5f
-						);
-
-						break;
-					}
-
-					default:
-					{
-						ASSERT(false, "Invalid case!");
-
-						break;
-					}
-				}
-
-				child_node._Minimum -= Vector2<float32>(static_cast<float32>(instance_data._PatchSize) * patch_size_multiplier * 0.5f);
-				child_node._Maximum += Vector2<float32>(static_cast<float32>(instance_data._PatchSize) * patch_size_multiplier * 0.5f);
-
-				/*
-				*	Use the parent node's min/max height, as it would be too time-consuming to compute for each individual node.
-				*	Should be a good enough approximation.
-				*/
-				child_node._AxisAlignedBoundingBox._Minimum = Vector3<float32>(child_node._Minimum._X, node->_AxisAlignedBoundingBox._Minimum._Y, child_node._Minimum._Y);
-				child_node._AxisAlignedBoundingBox._Maximum = Vector3<float32>(child_node._Maximum._X, node->_AxisAlignedBoundingBox._Maximum._Y, child_node._Maximum._Y);
-
-				child_node._Position = TerrainQuadTreeUtilities::MiddlePoint(child_node);
-				const Vector2<float32> heightmap_coordinate_offset{ static_cast<float32>(instance_data._PatchSize) * 0.5f };
-				child_node._MinimumHeightMapCoordinate = (child_node._Minimum + heightmap_coordinate_offset) / static_cast<float32>(instance_data._PatchSize);
-				child_node._MaximumHeightMapCoordinate = (child_node._Maximum + heightmap_coordinate_offset) / static_cast<float32>(instance_data._PatchSize);
-
-				const float32 heightmap_coordinate_padding{ 1.0f / static_cast<float32>(instance_data._HeightMapResolution) };
-
-				child_node._MinimumHeightMapCoordinate *= 1.0f - heightmap_coordinate_padding;
-				child_node._MaximumHeightMapCoordinate *= 1.0f - heightmap_coordinate_padding;
-
-				child_node._PatchSize = static_cast<float32>(instance_data._PatchSize) * patch_size_multiplier;
+				GatherTerrainWireframeQuadTreeNode(instance_data, instance_data._QuadTree._Nodes[node_index], input_stream);
 			}
 		}
 	}
 }
-
-/*
-*	Calculates borders for the given node.
-*/
-void CalculateBorders(TerrainInstanceData &instance_data, TerrainQuadTreeNode *const RESTRICT node) NOEXCEPT
-{
-	//If this node is subdivided, calculate new borders for it's child nodes.
-	if (node->IsSubdivided())
-	{
-		for (uint8 i{ 0 }; i < 4; ++i)
-		{
-			CalculateBorders(instance_data, &node->_ChildNodes[i]);
-		}
-	}
-
-	else
-	{
-		/*
-		*	TODO: When we can't find a neighboring node, put up a request to find one on other terrain components,
-		*	and process them real quick in the post update.
-		*	For now, assume that there's a depth difference of 1, should be right most of the time.
-		*/
-
-		//Retrieve the neighboring nodes.
-		StaticArray<const TerrainQuadTreeNode *RESTRICT, 4> neighboring_nodes;
-		TerrainQuadTreeUtilities::NeighboringNodes(instance_data._PatchSize, instance_data._QuadTree._RootNode, *node, &neighboring_nodes);
-
-		//Calculate new borders.
-		uint32 borders{ 0 };
-
-		//Left.
-		{
-			const int32 delta{ neighboring_nodes[0] ? static_cast<int32>(node->_Depth) - static_cast<int32>(neighboring_nodes[0]->_Depth) : 1 };
-
-			if (delta >= 1)
-			{
-				borders |= BIT(0);
-			}
-
-			if (delta >= 2)
-			{
-				borders |= BIT(1);
-			}
-		}
-
-		//Right.
-		{
-			const int32 delta{ neighboring_nodes[2] ? static_cast<int32>(node->_Depth) - static_cast<int32>(neighboring_nodes[2]->_Depth) : 1 };
-
-			if (delta >= 1)
-			{
-				borders |= BIT(2);
-			}
-
-			if (delta >= 2)
-			{
-				borders |= BIT(3);
-			}
-		}
-
-		//Down.
-		{
-			const int32 delta{ neighboring_nodes[1] ? static_cast<int32>(node->_Depth) - static_cast<int32>(neighboring_nodes[1]->_Depth) : 1 };
-
-			if (delta >= 1)
-			{
-				borders |= BIT(4);
-			}
-
-			if (delta >= 2)
-			{
-				borders |= BIT(5);
-			}
-		}
-
-		//Up.
-		{
-			const int32 delta{ neighboring_nodes[3] ? static_cast<int32>(node->_Depth) - static_cast<int32>(neighboring_nodes[3]->_Depth) : 1 };
-
-			if (delta >= 1)
-			{
-				borders |= BIT(6);
-			}
-
-			if (delta >= 2)
-			{
-				borders |= BIT(7);
-			}
-		}
-
-		//Update the node with the borders.
-		node->_Borders = borders;
-	}
-}
-
-/*
-*	Culls a single terrain quad tree node.
-*/
-void CullTerrainQuadTreeNode
-(
-	const Vector3<float32> &world_grid_delta,
-	const Frustum *const RESTRICT frustum,
-	TerrainQuadTreeNode *const RESTRICT node
-) NOEXCEPT
-{
-	//If this node is subdivided, cull each child node.
-	if (node->IsSubdivided())
-	{
-		for (TerrainQuadTreeNode &child_node : node->_ChildNodes)
-		{
-			CullTerrainQuadTreeNode(world_grid_delta, frustum, &child_node);
-		}
-	}
-
-	else
-	{
-		//Transform the axis aligned bounding box into the camera's cell.
-		AxisAlignedBoundingBox3D transformed_axis_aligned_bounding_box
-		{
-			node->_AxisAlignedBoundingBox._Minimum + world_grid_delta,
-			node->_AxisAlignedBoundingBox._Maximum + world_grid_delta
-		};
-
-		//Cull!
-		node->_Visible = Culling::IsWithinFrustum(transformed_axis_aligned_bounding_box, *frustum);
-	}
-}
+#endif
 
 /*
 *	Initializes this component.
@@ -482,14 +211,8 @@ void TerrainComponent::ParallelBatchUpdate(const UpdatePhase update_phase, const
 					const Vector3<float32> camera_relative_position{ camera_world_position.GetRelativePosition(instance_data._WorldPosition.GetCell()) };
 	#endif
 
-					//Check combination.
-					CheckCombination(instance_data, camera_relative_position, &instance_data._QuadTree._RootNode);
-
-					//Check subdivision.
-					CheckSubdivision(instance_data, camera_relative_position, &instance_data._QuadTree._RootNode);
-
-					//Calculate the borders.
-					CalculateBorders(instance_data, &instance_data._QuadTree._RootNode);
+					//Update the quad tree.
+					instance_data._QuadTree.Update(camera_relative_position);
 				}
 
 				//Do culling.
@@ -497,7 +220,7 @@ void TerrainComponent::ParallelBatchUpdate(const UpdatePhase update_phase, const
 					//Cull the instance.
 					instance_data._Visibility = Culling::IsWithinFrustum(instance_data._WorldSpaceAxisAlignedBoundingBox.GetRelativeAxisAlignedBoundingBox(camera_cell), *frustum);
 
-					//If this instance is visible, walk through the quad tree and determine the visibility of each node.
+					//If this instance is visible, determine the visibility of each leaf node of the quad tree.
 					if (instance_data._Visibility)
 					{
 						//Calculate the cell delta.
@@ -509,8 +232,8 @@ void TerrainComponent::ParallelBatchUpdate(const UpdatePhase update_phase, const
 							world_grid_delta[i] = static_cast<float32>(delta[i]) * WorldSystem::Instance->GetWorldGridSize();
 						}
 
-						//Start at the root node.
-						CullTerrainQuadTreeNode(world_grid_delta, frustum, &instance_data._QuadTree._RootNode);
+						//Cull the leaf nodes.
+						instance_data._QuadTree.Cull(world_grid_delta, *frustum);
 					}
 				}
 			}
@@ -678,16 +401,14 @@ void TerrainComponent::CreateInstance(Entity *const RESTRICT entity, TerrainInit
 	instance_data->_BlendMapTexture = initialization_data->_PreprocessedData._BlendMapTexture;
 	instance_data->_BlendMapTextureIndex = initialization_data->_PreprocessedData._BlendMapTextureIndex;
 
-	instance_data->_QuadTree._RootNode._Depth = 0;
-	instance_data->_QuadTree._RootNode._Borders = 0;
-	instance_data->_QuadTree._RootNode._Minimum = instance_data->_QuadTree._RootNode._Maximum = Vector2<float32>(instance_data->_WorldPosition.GetLocalPosition()._X, instance_data->_WorldPosition.GetLocalPosition()._Z);
-	instance_data->_QuadTree._RootNode._Minimum -= Vector2<float32>(static_cast<float32>(instance_data->_PatchSize) * 0.5f);
-	instance_data->_QuadTree._RootNode._Maximum = Vector2<float32>(static_cast<float32>(instance_data->_PatchSize) * 0.5f);
-	instance_data->_QuadTree._RootNode._AxisAlignedBoundingBox = instance_data->_WorldSpaceAxisAlignedBoundingBox.GetLocalAxisAlignedBoundingBox();
-	instance_data->_QuadTree._RootNode._Position = Vector2<float32>(instance_data->_WorldPosition.GetLocalPosition()._X, instance_data->_WorldPosition.GetLocalPosition()._Z);
-	instance_data->_QuadTree._RootNode._MinimumHeightMapCoordinate = Vector2<float32>(0.0f);
-	instance_data->_QuadTree._RootNode._MaximumHeightMapCoordinate = Vector2<float32>(1.0f);
-	instance_data->_QuadTree._RootNode._PatchSize = static_cast<float32>(instance_data->_PatchSize);
+	instance_data->_QuadTree.Initialize
+	(
+		Vector2<float32>(instance_data->_WorldPosition.GetLocalPosition()._X, instance_data->_WorldPosition.GetLocalPosition()._Z),
+		instance_data->_PatchSize,
+		instance_data->_MaximumSubdivisionSteps,
+		instance_data->_WorldSpaceAxisAlignedBoundingBox.GetLocalAxisAlignedBoundingBox(),
+		1.0f / static_cast<float32>(instance_data->_HeightMapResolution)
+	);
 
 	instance_data->_PhysicsActorHandle = initialization_data->_PreprocessedData._PhysicsActorHandle;
 
@@ -1165,33 +886,6 @@ void TerrainComponent::GatherPathTracingTriangles(DynamicArray<Vertex> *const RE
 }
 
 #if !defined(CATALYST_CONFIGURATION_FINAL)
-/*
-*	Gathers  memory usage for the given terrain quad tree node.
-*/
-FORCE_INLINE NO_DISCARD uint64 TerrainQuadTreeNodeMemoryUsage(const TerrainQuadTreeNode &node) NOEXCEPT
-{
-	uint64 memory_usage{ 0 };
-
-	memory_usage += sizeof(node._Depth);
-	memory_usage += sizeof(node._Borders);
-	memory_usage += sizeof(node._ChildNodes);
-	memory_usage += sizeof(node._Minimum);
-	memory_usage += sizeof(node._Maximum);
-	memory_usage += sizeof(node._AxisAlignedBoundingBox);
-	memory_usage += sizeof(node._Visible);
-	memory_usage += sizeof(node._Position);
-	memory_usage += sizeof(node._MinimumHeightMapCoordinate);
-	memory_usage += sizeof(node._MaximumHeightMapCoordinate);
-	memory_usage += sizeof(node._PatchSize);
-
-	for (const TerrainQuadTreeNode &child : node._ChildNodes)
-	{
-		memory_usage += TerrainQuadTreeNodeMemoryUsage(child);
-	}
-
-	return memory_usage;
-}
-
 /*
 *	Gathers statistics.
 */
@@ -1226,7 +920,7 @@ void TerrainComponent::Statistics(ComponentStatistics *const RESTRICT statistics
 		statistics->_CPUMemoryUsage += sizeof(instance_data._BlendMapTexture);
 		statistics->_CPUMemoryUsage += sizeof(instance_data._BlendMapTextureIndex);
 		statistics->_CPUMemoryUsage += sizeof(instance_data._Visibility);
-		statistics->_CPUMemoryUsage += TerrainQuadTreeNodeMemoryUsage(instance_data._QuadTree._RootNode);
+		statistics->_CPUMemoryUsage += instance_data._QuadTree.MemoryUsage();
 		statistics->_CPUMemoryUsage += sizeof(instance_data._PhysicsActorHandle);
 
 		statistics->_GPUMemoryUsage += sizeof(float32) * instance_data._HeightMap.GetWidth() * instance_data._HeightMap.GetHeight();
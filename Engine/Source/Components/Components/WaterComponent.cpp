@@ -11,261 +11,6 @@
 //Terrain.
 #include <Terrain/TerrainGeneralUtilities.h>
 #include <Terrain/TerrainVertex.h>
-#include <Terrain/TerrainQuadTreeUtilities.h>
-
-/*
-*	Checks combination of a node.
-*/
-void CheckCombination(WaterInstanceData &instance_data, const Vector3<float32> &camera_position, TerrainQuadTreeNode *const RESTRICT node) NOEXCEPT
-{
-	//If this node is already subdivided, check all of it's child nodes.
-	if (node->IsSubdivided())
-	{
-		if (TerrainQuadTreeUtilities::ShouldBeCombined(instance_data._PatchSize, instance_data._MaximumSubdivisionSteps, *node, camera_position))
-		{
-			node->_ChildNodes.Clear();
-		}
-
-		else
-		{
-			for (uint8 i{ 0 }; i < 4; ++i)
-			{
-				CheckCombination(instance_data, camera_position, &node->_ChildNodes[i]);
-			}
-		}
-	}
-}
-
-/*
-*	Checks subdivisions of a node.
-*/
-void CheckSubdivision(WaterInstanceData &instance_data, const Vector3<float32> &camera_position, TerrainQuadTreeNode *const RESTRICT node) NOEXCEPT
-{
-	//If this node is already subdivided, check all of it's child nodes.
-	if (node->IsSubdivided())
-	{
-		for (uint8 i{ 0 }; i < 4; ++i)
-		{
-			CheckSubdivision(instance_data, camera_position, &node->_ChildNodes[i]);
-		}
-	}
-
-	//Else, check if this node should be subdivided.
-	else
-	{
-		if (TerrainQuadTreeUtilities::ShouldBeSubdivided(instance_data._PatchSize, instance_data._MaximumSubdivisionSteps, *node, camera_position))
-		{
-			//Calculate the patch size multiplier.
-			const float32 patch_size_multiplier{ TerrainQuadTreeUtilities::PatchSizeMultiplier(*node) * 0.5f };
-
-			//Set up the new nodes.
-			node->_ChildNodes.Upsize<true>(4);
-
-			for (uint64 current_node_index{ 0 }; current_node_index < 4; ++current_node_index)
-			{
-				TerrainQuadTreeNode& child_node{ node->_ChildNodes[current_node_index] };
-
-				child_node._Depth = node->_Depth + 1;
-				child_node._Borders = 0;
-
-				switch (current_node_index)
-				{
-					case 0:
-					{
-						child_node._Minimum = child_node._Maximum = Vector2<float32>
-						(
-							node->_Minimum._X + static_cast<float32>(instance_data._PatchSize) * patch_size_multiplier * 1.5f,
-							node->_Minimum._Y + static_cast<float32>(instance_data._PatchSize) * patch_size_multiplier * 0.5f
-						);
-
-						break;
-					}
-
-					case 1:
-					{
-						child_node._Minimum = child_node._Maximum = Vector2<float32>
-						(
-							node->_Minimum._X + static_cast<float32>(instance_data._PatchSize) * patch_size_multiplier * 1.5f,
-							node->_Minimum._Y + static_cast<float32>(instance_data._PatchSize) * patch_size_multiplier * 1.5f
-						);
-
-						break;
-					}
-
-					case 2:
-					{
-						child_node._Minimum = child_node._Maximum = Vector2<float32>
-						(
-							node->_Minimum._X + static_cast<float32>(instance_data._PatchSize) * patch_size_multiplier * 0.5f,
-							node->_Minimum._Y + static_cast<float32>(instance_data._PatchSize) * patch_size_multiplier * 1.5f
-						);
-
-						break;
-					}
-
-					case 3:
-					{
-						child_node._Minimum = child_node._Maximum = Vector2<float32>
-						(
-							node->_Minimum._X + static_cast<float32>(instance_data._PatchSize) * patch_size_multiplier * 0.5f,
-							node->_Minimum._Y + static_cast<float32>(instance_data._PatchSize) * patch_size_multiplier * 0.5f
-						);
-
-						break;
-					}
-
-					default:
-					{
-						ASSERT(false, "Invalid case!");
-
-						break;
-					}
-				}
-
-				child_node._Minimum -= Vector2<float32>(static_cast<float32>(instance_data._PatchSize) * patch_size_multiplier * 0.5f);
-				child_node._Maximum += Vector2<float32>(static_cast<float32>(instance_data._PatchSize) * patch_size_multiplier * 0.5f);
-
-				/*
-				*	Use the parent node's min/max height, as it would be too time-consuming to compute for each individual node.
-				*	Should be a good enough approximation.
-				*/
-				child_node._AxisAlignedBoundingBox._Minimum = Vector3<float32>(child_node._Minimum._X, node->_AxisAlignedBoundingBox._Minimum._Y, child_node._Minimum._Y);
-				child_node._AxisAlignedBoundingBox._Maximum = Vector3<float32>(child_node._Maximum._X, node->_AxisAlignedBoundingBox._Maximum._Y, child_node._Maximum._Y);
-
-				child_node._Position = TerrainQuadTreeUtilities::MiddlePoint(child_node);
-				const Vector2<float32> heightmap_coordinate_offset{ static_cast<float32>(instance_data._PatchSize) * 0.5f };
-				child_node._MinimumHeightMapCoordinate = (child_node._Minimum + heightmap_coordinate_offset) / static_cast<float32>(instance_data._PatchSize);
-				child_node._MaximumHeightMapCoordinate = (child_node._Maximum + heightmap_coordinate_offset) / static_cast<float32>(instance_data._PatchSize);
-
-				child_node._MinimumHeightMapCoordinate *= 1.0f - (1.0f / static_cast<float32>(instance_data._PatchSize));
-				child_node._MaximumHeightMapCoordinate *= 1.0f - (1.0f / static_cast<float32>(instance_data._PatchSize));
-
-				child_node._PatchSize = static_cast<float32>(instance_data._PatchSize) * patch_size_multiplier;
-			}
-		}
-	}
-}
-
-/*
-*	Calculates borders for the given node.
-*/
-void CalculateBorders(WaterInstanceData& instance_data, TerrainQuadTreeNode* const RESTRICT node) NOEXCEPT
-{
-	//If this node is subdivided, calculate new borders for it's child nodes.
-	if (node->IsSubdivided())
-	{
-		for (uint8 i{ 0 }; i < 4; ++i)
-		{
-			CalculateBorders(instance_data, &node->_ChildNodes[i]);
-		}
-	}
-
-	else
-	{
-		//Retrieve the neighboring nodes.
-		StaticArray<const TerrainQuadTreeNode *RESTRICT, 4> neighboring_nodes;
-		TerrainQuadTreeUtilities::NeighboringNodes(instance_data._PatchSize, instance_data._QuadTree._RootNode, *node, &neighboring_nodes);
-
-		//Calculate new borders.
-		uint32 borders{ 0 };
-
-		//Left.
-		{
-			const int32 delta{ neighboring_nodes[0] ? static_cast<int32>(node->_Depth) - static_cast<int32>(neighboring_nodes[0]->_Depth) : 0 };
-
-			if (delta >= 1)
-			{
-				borders |= BIT(0);
-			}
-
-			if (delta >= 2)
-			{
-				borders |= BIT(1);
-			}
-		}
-
-		//Right.
-		{
-			const int32 delta{ neighboring_nodes[2] ? static_cast<int32>(node->_Depth) - static_cast<int32>(neighboring_nodes[2]->_Depth) : 0 };
-
-			if (delta >= 1)
-			{
-				borders |= BIT(2);
-			}
-
-			if (delta >= 2)
-			{
-				borders |= BIT(3);
-			}
-		}
-
-		//Down.
-		{
-			const int32 delta{ neighboring_nodes[1] ? static_cast<int32>(node->_Depth) - static_cast<int32>(neighboring_nodes[1]->_Depth) : 0 };
-
-			if (delta >= 1)
-			{
-				borders |= BIT(4);
-			}
-
-			if (delta >= 2)
-			{
-				borders |= BIT(5);
-			}
-		}
-
-		//Up.
-		{
-			const int32 delta{ neighboring_nodes[3] ? static_cast<int32>(node->_Depth) - static_cast<int32>(neighboring_nodes[3]->_Depth) : 0 };
-
-			if (delta >= 1)
-			{
-				borders |= BIT(6);
-			}
-
-			if (delta >= 2)
-			{
-				borders |= BIT(7);
-			}
-		}
-
-		//Update the node with the borders.
-		node->_Borders = borders;
-	}
-}
-
-/*
-*	Culls a single water quad tree node.
-*/
-void CullWaterQuadTreeNode
-(
-	const Vector3<float32> &world_grid_delta,
-	const Frustum *const RESTRICT frustum,
-	TerrainQuadTreeNode *const RESTRICT node
-) NOEXCEPT
-{
-	//If this node is subdivided, cull each child node.
-	if (node->IsSubdivided())
-	{
-		for (TerrainQuadTreeNode &child_node : node->_ChildNodes)
-		{
-			CullWaterQuadTreeNode(world_grid_delta, frustum, &child_node);
-		}
-	}
-
-	else
-	{
-		//Transform the axis aligned bounding box into the camera's cell.
-		AxisAlignedBoundingBox3D transformed_axis_aligned_bounding_box
-		{
-			node->_AxisAlignedBoundingBox._Minimum + world_grid_delta,
-			node->_AxisAlignedBoundingBox._Maximum + world_grid_delta
-		};
-
-		//Cull!
-		node->_Visible = Culling::IsWithinFrustum(transformed_axis_aligned_bounding_box, *frustum);
-	}
-}
 
 /*
 *	Updates this component.
@@ -292,14 +37,8 @@ void WaterComponent::ParallelBatchUpdate(const UpdatePhase update_phase, const u
 					//Calculate the camera relative position.
 					const Vector3<float32> camera_relative_position{ camera_world_position.GetRelativePosition(instance_data._WorldPosition.GetCell()) };
 
-					//Check combination.
-					CheckCombination(instance_data, camera_relative_position, &instance_data._QuadTree._RootNode);
-
-					//Check subdivision.
-					CheckSubdivision(instance_data, camera_relative_position, &instance_data._QuadTree._RootNode);
-
-					//Calculate the borders.
-					CalculateBorders(instance_data, &instance_data._QuadTree._RootNode);
+					//Update the quad tree.
+					instance_data._QuadTree.Update(camera_relative_position);
 				}
 
 				//Do culling.
@@ -307,7 +46,7 @@ void WaterComponent::ParallelBatchUpdate(const UpdatePhase update_phase, const u
 					//Cull the instance.
 					instance_data._Visibility = Culling::IsWithinFrustum(instance_data._WorldSpaceAxisAlignedBoundingBox.GetRelativeAxisAlignedBoundingBox(camera_cell), *frustum);
 
-					//If this instance is visible, walk through the quad tree and determine the visibility of each node.
+					//If this instance is visible, determine the visibility of each leaf node of the quad tree.
 					if (instance_data._Visibility)
 					{
 						//Calculate the cell delta.
@@ -319,8 +58,8 @@ void WaterComponent::ParallelBatchUpdate(const UpdatePhase update_phase, const u
 							world_grid_delta[i] = static_cast<float32>(delta[i]) * WorldSystem::Instance->GetWorldGridSize();
 						}
 
-						//Start at the root node.
-						CullWaterQuadTreeNode(world_grid_delta, frustum, &instance_data._QuadTree._RootNode);
+						//Cull the leaf nodes.
+						instance_data._QuadTree.Cull(world_grid_delta, *frustum);
 					}
 				}
 			}
@@ -401,16 +140,14 @@ void WaterComponent::CreateInstance(Entity *const RESTRICT entity, WaterInitiali
 	instance_data->_IndexCount = initialization_data->_PreprocessedData._IndexCount;
 	instance_data->_Texture = initialization_data->_Texture;
 
-	instance_data->_QuadTree._RootNode._Depth = 0;
-	instance_data->_QuadTree._RootNode._Borders = 0;
-	instance_data->_QuadTree._RootNode._Minimum = instance_data->_QuadTree._RootNode._Maximum = Vector2<float32>(instance_data->_WorldPosition.GetLocalPosition()._X, instance_data->_WorldPosition.GetLocalPosition()._Z);
-	instance_data->_QuadTree._RootNode._Minimum -= Vector2<float32>(static_cast<float32>(instance_data->_PatchSize) * 0.5f);
-	instance_data->_QuadTree._RootNode._Maximum = Vector2<float32>(static_cast<float32>(instance_data->_PatchSize) * 0.5f);
-	instance_data->_QuadTree._RootNode._AxisAlignedBoundingBox = instance_data->_WorldSpaceAxisAlignedBoundingBox.GetLocalAxisAlignedBoundingBox();
-	instance_data->_QuadTree._RootNode._Position = Vector2<float32>(instance_data->_WorldPosition.GetLocalPosition()._X, instance_data->_WorldPosition.GetLocalPosition()._Z);
-	instance_data->_QuadTree._RootNode._MinimumHeightMapCoordinate = Vector2<float32>(0.0f);
-	instance_data->_QuadTree._RootNode._MaximumHeightMapCoordinate = Vector2<float32>(1.0f);
-	instance_data->_QuadTree._RootNode._PatchSize = static_cast<float32>(instance_data->_PatchSize);
+	instance_data->_QuadTree.Initialize
+	(
+		Vector2<float32>(instance_data->_WorldPosition.GetLocalPosition()._X, instance_data->_WorldPosition.GetLocalPosition()._Z),
+		instance_data->_PatchSize,
+		instance_data->_MaximumSubdivisionSteps,
+		instance_data->_WorldSpaceAxisAlignedBoundingBox.GetLocalAxisAlignedBoundingBox(),
+		1.0f / static_cast<float32>(instance_data->_PatchSize)
+	);
 }
 
 /*
@@ -230,6 +230,9 @@ void AnimatedModelAssetCompiler::Compile(const CompileContext &compile_context)
 
 	//Close the output file.
 	output_file.Close();
+
+	//Report the output.
+	compile_context._Outputs.Emplace(output_file_path);
 }
 
 /*
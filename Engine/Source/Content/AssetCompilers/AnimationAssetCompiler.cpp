@@ -179,6 +179,9 @@ void AnimationAssetCompiler::Compile(const CompileContext &compile_context) NOEX
 
 	//Close the output file.
 	output_file.Close();
+
+	//Report the output.
+	compile_context._Outputs.Emplace(output_file_path);
 }
 
 /*
@@ -176,6 +176,9 @@ void AudioAssetCompiler::Compile(const CompileContext &compile_context) NOEXCEPT
 	//Close the output file.
 	output_file.Close();
 
+	//Report the output.
+	compile_context._Outputs.Emplace(output_file_path);
+
 	//Add the dependency to the file.
 	compile_context._Dependencies.Emplace(parameters._File.Data());
 }
@@ -138,6 +138,9 @@ void EntityAssetCompiler::Compile(const CompileContext &compile_context) NOEXCEP
 
 	//Close the output file.
 	output_file.Close();
+
+	//Report the output.
+	compile_context._Outputs.Emplace(output_file_path);
 }
 
 /*
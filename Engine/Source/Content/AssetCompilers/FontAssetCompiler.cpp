@@ -1,6 +1,14 @@
 //Header file.
 #include <Content/AssetCompilers/FontAssetCompiler.h>
 
+//Concurrency.
+#include <Concurrency/ScopedLock.h>
+
+//Core.
+#include <Core/Algorithms/SortingAlgorithms.h>
+#include <Core/General/Pair.h>
+#include <Core/General/Time.h>
+
 //File.
 #include <File/Core/File.h>
 #include <File/Core/BinaryOutputFile.h>
@@ -11,10 +19,13 @@
 #include <Profiling/Profiling.h>
 
 //Rendering.
+#include <Rendering/Native/RectanglePacker.h>
 #include <Rendering/Native/Texture2D.h>
 
 //Systems.
+#include <Systems/LogSystem.h>
 #include <Systems/RenderingSystem.h>
+#include <Systems/TaskSystem.h>
 
 //Third party.
 #include <ThirdParty/stb_truetype/stb_truetype.h>
@@ -22,6 +33,7 @@
 //STL.
 #include <fstream>
 #include <string>
+#include <unordered_map>
 
 /*
 *	Font parameters class definition.
@@ -34,8 +46,130 @@ public:
 	//The file.
 	StaticString<MAXIMUM_FILE_PATH_LENGTH> _File;
 
+	//The ranges of codepoints to compile, inclusive. Defaults to ASCII if none are specified.
+	DynamicArray<Pair<uint32, uint32>> _Ranges;
+
+	//The pixel height that characters are rasterized at.
+	uint32 _PixelHeight{ 128 };
+
+	//The number of pages reserved for characters rasterized on demand. Zero means no characters are rasterized on demand.
+	uint32 _NumberOfDynamicPages{ 0 };
+
+};
+
+/*
+*	Rasterized character class definition.
+*/
+class RasterizedCharacter final
+{
+
+public:
+
+	//The signed distance field. Can be nullptr for characters without an outline, like space.
+	uint8 *RESTRICT _SDF;
+
+	//The width of the signed distance field.
+	uint32 _SDFWidth;
+
+	//The height of the signed distance field.
+	uint32 _SDFHeight;
+
+	//The width in the page, which is the width of the signed distance field clamped to the page resolution.
+	uint32 _Width;
+
+	//The height in the page, which is the height of the signed distance field clamped to the page resolution.
+	uint32 _Height;
+
+	//The position in the page.
+	Vector2<uint32> _Position;
+
+	//The character description.
+	FontAsset::CharacterDescription _CharacterDescription;
+
+};
+
+/*
+*	Font rasterization context class definition.
+*/
+class FontRasterizationContext final
+{
+
+public:
+
+	//The font info.
+	const stbtt_fontinfo *RESTRICT _FontInfo;
+
+	//The scale.
+	float32 _Scale;
+
+	//The pixel height.
+	uint32 _PixelHeight;
+
+	//The padding.
+	uint32 _Padding;
+
+	//The codepoints.
+	const uint32 *RESTRICT _Codepoints;
+
+	//The rasterized characters.
+	RasterizedCharacter *RESTRICT _Characters;
+
 };
 
+/*
+*	Rasterizes the character at the given index.
+*	stb_truetype only reads from the font info, so this is safe to run for many characters at once.
+*/
+static void RasterizeCharacter(const FontRasterizationContext &context, const uint32 index) NOEXCEPT
+{
+	const uint32 codepoint{ context._Codepoints[index] };
+	RasterizedCharacter &character{ context._Characters[index] };
+
+	//Retrieve the glyph SDF.
+	int32 width{ 0 };
+	int32 height{ 0 };
+	int32 x_offset{ 0 };
+	int32 y_offset{ 0 };
+
+	character._SDF = stbtt_GetCodepointSDF
+	(
+		context._FontInfo,
+		context._Scale,
+		static_cast<int32>(codepoint),
+		static_cast<int32>(context._Padding),
+		127,
+		FontAsset::SignedDistanceFieldPixelDistanceScale(context._Padding),
+		&width,
+		&height,
+		&x_offset,
+		&y_offset
+	);
+
+	//Not really sure how to handle characters larger than a page, but just clamping for now should work decently-ish. :x
+	character._SDFWidth = static_cast<uint32>(width);
+	character._SDFHeight = static_cast<uint32>(height);
+	character._Width = BaseMath::Minimum<uint32>(static_cast<uint32>(width), FontAsset::PAGE_RESOLUTION);
+	character._Height = BaseMath::Minimum<uint32>(static_cast<uint32>(height), FontAsset::PAGE_RESOLUTION);
+
+	//Retrieve the bounding box for the glyph.
+	Vector2<int32> glyph_minimum;
+	Vector2<int32> glyph_maximum;
+	stbtt_GetCodepointBox(context._FontInfo, static_cast<int32>(codepoint), &glyph_minimum._X, &glyph_minimum._Y, &glyph_maximum._X, &glyph_maximum._Y);
+
+	//Retrieve the advance.
+	int32 advance;
+	stbtt_GetCodepointHMetrics(context._FontInfo, static_cast<int32>(codepoint), &advance, nullptr);
+
+	//Fill in the character description. The texture bounds are filled in when packing.
+	const float32 pixel_height{ static_cast<float32>(context._PixelHeight) };
+
+	character._CharacterDescription._Size._X = static_cast<float32>(character._Width) / pixel_height;
+	character._CharacterDescription._Size._Y = static_cast<float32>(character._Height) / pixel_height;
+	character._CharacterDescription._Offset._X = static_cast<float32>(glyph_minimum._X) * context._Scale / pixel_height;
+	character._CharacterDescription._Offset._Y = static_cast<float32>(glyph_minimum._Y) * context._Scale / pixel_height;
+	character._CharacterDescription._Advance = static_cast<float32>(advance) * context._Scale / pixel_height;
+}
+
 /*
 *	Default constructor.
 */
@@ -58,7 +192,7 @@ NO_DISCARD HashString FontAssetCompiler::AssetTypeIdentifier() const NOEXCEPT
 */
 NO_DISCARD uint64 FontAssetCompiler::CurrentVersion() const NOEXCEPT
 {
-	return 1;
+	return 2;
 }
 
 /*
@@ -68,10 +202,6 @@ void FontAssetCompiler::Compile(const CompileContext &compile_context) NOEXCEPT
 {
 	PROFILING_SCOPE("FontAssetCompiler::Compile");
 
-	//Define constants.
-	constexpr uint32 PADDING{ 8 };
-	constexpr uint32 PIXEL_HEIGHT{ 128 };
-
 	//Set up the parameters.
 	FontParameters parameters;
 
@@ -109,6 +239,79 @@ void FontAssetCompiler::Compile(const CompileContext &compile_context) NOEXCEPT
 				}
 			}
 
+			//Is this a range declaration?
+			{
+				const size_t position{ current_line.find("Range(") };
+
+				if (position != std::string::npos)
+				{
+					const uint64 number_of_arguments
+					{
+						TextParsingUtilities::ParseFunctionArguments
+						(
+							current_line.c_str(),
+							current_line.length(),
+							arguments.Data()
+						)
+					};
+
+					ASSERT(number_of_arguments == 2, "Range() needs two arguments!");
+
+					//Base 0, so that codepoints can be given in hexadecimal, like 0x0400.
+					parameters._Ranges.Emplace(static_cast<uint32>(std::stoul(arguments[0].Data(), nullptr, 0)), static_cast<uint32>(std::stoul(arguments[1].Data(), nullptr, 0)));
+
+					continue;
+				}
+			}
+
+			//Is this a pixel height declaration?
+			{
+				const size_t position{ current_line.find("PixelHeight(") };
+
+				if (position != std::string::npos)
+				{
+					const uint64 number_of_arguments
+					{
+						TextParsingUtilities::ParseFunctionArguments
+						(
+							current_line.c_str(),
+							current_line.length(),
+							arguments.Data()
+						)
+					};
+
+					ASSERT(number_of_arguments == 1, "PixelHeight() needs one argument!");
+
+					parameters._PixelHeight = std::stoul(arguments[0].Data());
+
+					continue;
+				}
+			}
+
+			//Is this a dynamic glyphs declaration?
+			{
+				const size_t position{ current_line.find("DynamicGlyphs(") };
+
+				if (position != std::string::npos)
+				{
+					const uint64 number_of_arguments
+					{
+						TextParsingUtilities::ParseFunctionArguments
+						(
+							current_line.c_str(),
+							current_line.length(),
+							arguments.Data()
+						)
+					};
+
+					ASSERT(number_of_arguments == 1, "DynamicGlyphs() needs one argument!");
+
+					parameters._NumberOfDynamicPages = std::stoul(arguments[0].Data());
+
+					continue;
+				}
+			}
+
 			//Couldn't figure out what this line is?
 			ASSERT(false, "Unknown line %s", current_line.c_str());
 		}
@@ -117,6 +320,12 @@ void FontAssetCompiler::Compile(const CompileContext &compile_context) NOEXCEPT
 	//Close the input file.
 	input_file.close();
 
+	//Default to ASCII.
+	if (parameters._Ranges.Empty())
+	{
+		parameters._Ranges.Emplace(0, FontAsset::NUMBER_OF_ASCII_CHARACTERS - 1);
+	}
+
 	//Determine the collection directory.
 	char collection_directory_path[MAXIMUM_FILE_PATH_LENGTH];
 
@@ -154,192 +363,309 @@ void FontAssetCompiler::Compile(const CompileContext &compile_context) NOEXCEPT
 	//Open the font file.
 	BinaryInputFile font_file{ parameters._File.Data() };
 
-	//Create the buffer.
-	byte *const RESTRICT buffer{ static_cast<byte *const RESTRICT>(Memory::Allocate(font_file.Size())) };
-	font_file.Read(buffer, font_file.Size());
+	//Read the font data.
+	DynamicArray<byte> font_data;
+	font_data.Upsize<false>(font_file.Size());
+	font_file.Read(font_data.Data(), font_file.Size());
 
 	//Close the font file.
 	font_file.Close();
 
 	//Initialize the font.
 	stbtt_fontinfo font_info;
-	stbtt_InitFont(&font_info, buffer, stbtt_GetFontOffsetForIndex(buffer, 0));
+	stbtt_InitFont(&font_info, font_data.Data(), stbtt_GetFontOffsetForIndex(font_data.Data(), 0));
 
-	//Calculate the pixel height scale.
-	const float32 pixel_height_scale{ stbtt_ScaleForPixelHeight(&font_info, PIXEL_HEIGHT) };
+	//Calculate the padding and pixel height scale. The padding scales with the pixel height, so that the signed distance fields have the same spread at any pixel height.
+	const uint32 padding{ BaseMath::Maximum<uint32>(parameters._PixelHeight / 16, 4) };
+	const float32 pixel_height_scale{ stbtt_ScaleForPixelHeight(&font_info, static_cast<float32>(parameters._PixelHeight)) };
 
-	//Calculate the bitmap width/height.
-	uint32 bitmap_width;
-	uint32 bitmap_height;
+	//Gather the codepoints that the font has glyphs for, sorted and without duplicates.
+	DynamicArray<uint32> codepoints;
 
+	for (const Pair<uint32, uint32> &range : parameters._Ranges)
 	{
-		//Do a run to calculate the needed width of the bitmap.
-		uint32 needed_width{ 0 };
-
-		for (uint8 i{ 0 }; i < FontAsset::NUMBER_OF_CHARACTER_DESCRIPTIONS; ++i)
+		for (uint32 codepoint{ range._First }; codepoint <= range._Second; ++codepoint)
 		{
-			//Retrieve the glyph SDF.
-			int32 width;
-			int32 height;
-			int32 x_offset;
-			int32 y_offset;
-
-			uint8 *const RESTRICT glyph_sdf
-			{
-				stbtt_GetCodepointSDF
-				(
-					&font_info,
-					pixel_height_scale,
-					i,
-					PADDING,
-					127,
-					127.0f / static_cast<float32>(PADDING - 2),
-					&width,
-					&height,
-					&x_offset,
-					&y_offset
-				)
-			};
-
-			//Guess this can happen. :x
-			if (!glyph_sdf)
+			if (stbtt_FindGlyphIndex(&font_info, static_cast<int32>(codepoint)) != 0)
 			{
-				continue;
+				codepoints.Emplace(codepoint);
 			}
+		}
+	}
 
-			//Update the needed width.
-			needed_width += width;
+	SortingAlgorithms::StandardSort<uint32>(codepoints.Begin(), codepoints.End(), nullptr);
 
-			//Free the glyph data.
-			stbtt_FreeSDF(glyph_sdf, nullptr);
+	for (uint64 i{ 1 }; i < codepoints.Size();)
+	{
+		if (codepoints[i] == codepoints[i - 1])
+		{
+			codepoints.EraseAt<true>(i);
 		}
 
-		//Set the bitmap width/height.
-		bitmap_width = needed_width;
-		bitmap_height = PIXEL_HEIGHT;
+		else
+		{
+			++i;
+		}
 	}
 
-	//Set up the bitmap.
-	Texture2D<uint8> bitmap{ bitmap_width, bitmap_height };
+	const uint32 number_of_characters{ static_cast<uint32>(codepoints.Size()) };
 
-	//Clear it. Feels safer. :x
-	Memory::Set(bitmap.Data(), 0, bitmap.GetWidth() * bitmap.GetHeight());
+	//Rasterize all characters.
+	DynamicArray<RasterizedCharacter> characters;
+	characters.Upsize<false>(number_of_characters);
+
+	float64 rasterization_time;
 
 	{
-		//The current X.
-		uint32 current_x{ 0 };
+		const TimePoint start_time;
+
+		FontRasterizationContext context;
 
-		//Writes all the glyphs for the bitmap.
-		for (uint8 i{ 0 }; i < FontAsset::NUMBER_OF_CHARACTER_DESCRIPTIONS; ++i)
+		context._FontInfo = &font_info;
+		context._Scale = pixel_height_scale;
+		context._PixelHeight = parameters._PixelHeight;
+		context._Padding = padding;
+		context._Codepoints = codepoints.Data();
+		context._Characters = characters.Data();
+
+		TaskSystem::ParallelFor(Task::Priority::LOW, number_of_characters, [](void *const RESTRICT arguments, const uint32 index)
 		{
-			//Retrieve the glyph SDF.
-			int32 width{ 0 };
-			int32 height{ 0 };
-			int32 x_offset{ 0 };
-			int32 y_offset{ 0 };
+			RasterizeCharacter(*static_cast<const FontRasterizationContext *const RESTRICT>(arguments), index);
+		}, &context);
 
-			uint8 *const RESTRICT glyph_sdf
+		rasterization_time = start_time.GetSecondsSince();
+	}
+
+	//Pack the characters into pages, tallest first, which is what the skyline packer works best with.
+	DynamicArray<Texture2D<uint8>> pages;
+	float64 packing_time;
+	float32 average_occupancy{ 0.0f };
+
+	{
+		const TimePoint start_time;
+
+		DynamicArray<uint32> packing_order;
+		packing_order.Reserve(number_of_characters);
+
+		for (uint32 i{ 0 }; i < number_of_characters; ++i)
+		{
+			//Characters without an outline, like space, only need their metrics.
+			if (characters[i]._SDF)
 			{
-				stbtt_GetCodepointSDF
-				(
-					&font_info,
-					pixel_height_scale,
-					i,
-					PADDING,
-					127,
-					127.0f / static_cast<float32>(PADDING - 2),
-					&width,
-					&height,
-					&x_offset,
-					&y_offset
-				)
-			};
-
-			//Not really sure how to handle when this happens, but just clamping for now should work decently-ish. :x
-			height = BaseMath::Minimum<int32>(height, bitmap_height);
-
-			//Retrieve the bounding box for the glyph.
-			Vector2<int32> glyph_minimum;
-			Vector2<int32> glyph_maximum;
-			stbtt_GetCodepointBox(&font_info, i, &glyph_minimum._X, &glyph_minimum._Y, &glyph_maximum._X, &glyph_maximum._Y);
-
-			//Retrieve the advance.
-			int32 advance;
-			stbtt_GetCodepointHMetrics(&font_info, i, &advance, nullptr);
-
-			//Write the character description to the file.
-			FontAsset::CharacterDescription character_description;
-
-			character_description._Size._X = static_cast<float32>(width) / static_cast<float32>(PIXEL_HEIGHT);
-			character_description._Size._Y = static_cast<float32>(height) / static_cast<float32>(PIXEL_HEIGHT);
-			character_description._Offset._X = static_cast<float32>(glyph_minimum._X) * pixel_height_scale / static_cast<float32>(PIXEL_HEIGHT);
-			character_description._Offset._Y = static_cast<float32>(glyph_minimum._Y) * pixel_height_scale / static_cast<float32>(PIXEL_HEIGHT);
-			character_description._TextureBounds._Minimum._X = static_cast<float32>(current_x) / static_cast<float32>(bitmap_width);
-			character_description._TextureBounds._Minimum._Y = static_cast<float32>(0) / static_cast<float32>(bitmap_width);
-			character_description._TextureBounds._Maximum._X = static_cast<float32>(current_x + width) / static_cast<float32>(bitmap_width);
-			character_description._TextureBounds._Maximum._Y = static_cast<float32>(height) / static_cast<float32>(bitmap_height);
-			character_description._Advance = static_cast<float32>(advance) * pixel_height_scale / static_cast<float32>(PIXEL_HEIGHT);
-
-			output_file.Write(&character_description, sizeof(FontAsset::CharacterDescription));
-
-			//Guess this can happen. :x
-			if (!glyph_sdf)
+				packing_order.Emplace(i);
+			}
+
+			else
 			{
-				continue;
+				characters[i]._CharacterDescription._TextureBounds._Minimum = Vector2<float32>(0.0f, 0.0f);
+				characters[i]._CharacterDescription._TextureBounds._Maximum = Vector2<float32>(0.0f, 0.0f);
+				characters[i]._CharacterDescription._PageIndex = 0;
 			}
+		}
 
-			//Write into the bitmap.
-			for (uint32 Y{ 0 }; Y < static_cast<uint32>(height); ++Y)
+		SortingAlgorithms::StandardSort<uint32>
+		(
+			packing_order.Begin(),
+			packing_order.End(),
+			characters.Data(),
+			[](const void *const RESTRICT user_data, const uint32 *const RESTRICT first, const uint32 *const RESTRICT second)
 			{
-				for (uint32 X{ 0 }; X < static_cast<uint32>(width); ++X)
+				const RasterizedCharacter *const RESTRICT characters{ static_cast<const RasterizedCharacter *const RESTRICT>(user_data) };
+
+				if (characters[*first]._Height != characters[*second]._Height)
 				{
-					bitmap.At(current_x + X, Y) = glyph_sdf[X + ((height - 1 - Y) * width)];
+					return characters[*first]._Height > characters[*second]._Height;
 				}
+
+				return characters[*first]._Width > characters[*second]._Width;
 			}
+		);
+
+		RectanglePacker packer;
+		packer.Initialize(FontAsset::PAGE_RESOLUTION, FontAsset::PAGE_RESOLUTION);
+
+		DynamicArray<uint32> page_heights;
+		uint32 current_page_index{ 0 };
 
-			//Update the current X.
-			current_x += width;
+		if (!packing_order.Empty())
+		{
+			page_heights.Emplace(0);
+		}
+
+		for (const uint32 character_index : packing_order)
+		{
+			RasterizedCharacter &character{ characters[character_index] };
+
+			//Start a new page if this character doesn't fit on the current one.
+			if (!packer.Pack(character._Width, character._Height, &character._Position))
+			{
+				average_occupancy += packer.GetOccupancy();
+
+				packer.Initialize(FontAsset::PAGE_RESOLUTION, FontAsset::PAGE_RESOLUTION);
+				page_heights.Emplace(0);
+				++current_page_index;
+
+				const bool fits{ packer.Pack(character._Width, character._Height, &character._Position) };
+
+				ASSERT(fits, "Characters are clamped to the page resolution, so this shouldn't happen...");
+			}
+
+			character._CharacterDescription._PageIndex = current_page_index;
+			page_heights[current_page_index] = BaseMath::Maximum<uint32>(page_heights[current_page_index], character._Position._Y + character._Height);
+		}
+
+		if (!packing_order.Empty())
+		{
+			average_occupancy = (average_occupancy + packer.GetOccupancy()) / static_cast<float32>(page_heights.Size());
+		}
+
+		//Set up the pages. Every page is as tall as it needs to be, which mostly trims the last one.
+		pages.Upsize<true>(page_heights.Size());
+
+		for (uint64 i{ 0 }; i < pages.Size(); ++i)
+		{
+			pages[i].Initialize(FontAsset::PAGE_RESOLUTION, BaseMath::Maximum<uint32>(page_heights[i], 1));
+
+			//Clear it. Feels safer. :x
+			Memory::Set(pages[i].Data(), 0, pages[i].GetWidth() * pages[i].GetHeight());
+		}
+
+		//Write all characters into their pages.
+		for (const uint32 character_index : packing_order)
+		{
+			RasterizedCharacter &character{ characters[character_index] };
+			Texture2D<uint8> &page{ pages[character._CharacterDescription._PageIndex] };
+
+			for (uint32 Y{ 0 }; Y < character._Height; ++Y)
+			{
+				for (uint32 X{ 0 }; X < character._Width; ++X)
+				{
+					page.At(character._Position._X + X, character._Position._Y + Y) = character._SDF[X + ((character._SDFHeight - 1 - Y) * character._SDFWidth)];
+				}
+			}
+
+			character._CharacterDescription._TextureBounds._Minimum._X = static_cast<float32>(character._Position._X) / static_cast<float32>(page.GetWidth());
+			character._CharacterDescription._TextureBounds._Minimum._Y = static_cast<float32>(character._Position._Y) / static_cast<float32>(page.GetHeight());
+			character._CharacterDescription._TextureBounds._Maximum._X = static_cast<float32>(character._Position._X + character._Width) / static_cast<float32>(page.GetWidth());
+			character._CharacterDescription._TextureBounds._Maximum._Y = static_cast<float32>(character._Position._Y + character._Height) / static_cast<float32>(page.GetHeight());
 
 			//Free the glyph data.
-			stbtt_FreeSDF(glyph_sdf, nullptr);
+			stbtt_FreeSDF(character._SDF, nullptr);
 		}
+
+		packing_time = start_time.GetSecondsSince();
 	}
 
-#if 0
-	//Write it out, for debug purposes.
+	//Gather the kerning pairs between the compiled characters.
+	DynamicArray<FontAsset::KerningPair> kerning_pairs;
+
 	{
-		Texture2D<Vector4<float32>> debug_texture{ bitmap.GetWidth(), bitmap.GetHeight() };
+		const int32 kerning_table_length{ stbtt_GetKerningTableLength(&font_info) };
 
-		for (uint32 Y{ 0 }; Y < bitmap.GetHeight(); ++Y)
+		if (kerning_table_length > 0)
 		{
-			for (uint32 X{ 0 }; X < bitmap.GetWidth(); ++X)
+			//The kerning table is in glyph indices, so map them back to codepoints.
+			std::unordered_map<int32, uint32> glyph_codepoints;
+
+			for (const uint32 codepoint : codepoints)
 			{
-				const float32 value{ static_cast<float32>(bitmap.At(X, Y)) / static_cast<float32>(UINT8_MAXIMUM) };
-				debug_texture.At(X, Y) = Vector4<float32>(value, value, value, 1.0f);
+				glyph_codepoints.emplace(stbtt_FindGlyphIndex(&font_info, static_cast<int32>(codepoint)), codepoint);
+			}
+
+			DynamicArray<stbtt_kerningentry> kerning_table;
+			kerning_table.Upsize<false>(kerning_table_length);
+			stbtt_GetKerningTable(&font_info, kerning_table.Data(), kerning_table_length);
+
+			for (const stbtt_kerningentry &entry : kerning_table)
+			{
+				const std::unordered_map<int32, uint32>::const_iterator first{ glyph_codepoints.find(entry.glyph1) };
+				const std::unordered_map<int32, uint32>::const_iterator second{ glyph_codepoints.find(entry.glyph2) };
+
+				if (first == glyph_codepoints.end() || second == glyph_codepoints.end())
+				{
+					continue;
+				}
+
+				kerning_pairs.Emplace();
+				FontAsset::KerningPair &kerning_pair{ kerning_pairs.Back() };
+
+				kerning_pair._Key = (static_cast<uint64>(first->second) << 32) | second->second;
+				kerning_pair._Adjustment = static_cast<float32>(entry.advance) * pixel_height_scale / static_cast<float32>(parameters._PixelHeight);
 			}
+
+			SortingAlgorithms::StandardSort<FontAsset::KerningPair>
+			(
+				kerning_pairs.Begin(),
+				kerning_pairs.End(),
+				nullptr,
+				[](const void *const RESTRICT user_data, const FontAsset::KerningPair *const RESTRICT first, const FontAsset::KerningPair *const RESTRICT second)
+				{
+					return first->_Key < second->_Key;
+				}
+			);
 		}
+	}
+
+	//Write the rasterization parameters to the file.
+	output_file.Write(&parameters._PixelHeight, sizeof(uint32));
+	output_file.Write(&padding, sizeof(uint32));
+
+	//Write the characters to the file.
+	output_file.Write(&number_of_characters, sizeof(uint32));
+	output_file.Write(codepoints.Data(), sizeof(uint32) * number_of_characters);
 
-		PNGWriter::Write(debug_texture, "Font_Debug.png");
+	for (const RasterizedCharacter &character : characters)
+	{
+		output_file.Write(&character._CharacterDescription, sizeof(FontAsset::CharacterDescription));
 	}
-#endif
 
-	//Write the bitmap dimensions to the file.
-	output_file.Write(&bitmap_width, sizeof(uint32));
-	output_file.Write(&bitmap_height, sizeof(uint32));
+	//Write the kerning pairs to the file.
+	const uint32 number_of_kerning_pairs{ static_cast<uint32>(kerning_pairs.Size()) };
+	output_file.Write(&number_of_kerning_pairs, sizeof(uint32));
+	output_file.Write(kerning_pairs.Data(), sizeof(FontAsset::KerningPair) * number_of_kerning_pairs);
 
-	//Write the number of mipmap levels to the file.
-	constexpr uint8 NUMBER_OF_MIPMAP_LEVELS{ 1 };
-	output_file.Write(&NUMBER_OF_MIPMAP_LEVELS, sizeof(uint8));
+	//Write the pages to the file.
+	const uint32 number_of_pages{ static_cast<uint32>(pages.Size()) };
+	output_file.Write(&number_of_pages, sizeof(uint32));
 
-	//Write all the mip levels of the bitmap to the file.
-	for (uint8 i{ 0 }; i < NUMBER_OF_MIPMAP_LEVELS; ++i)
+	for (const Texture2D<uint8> &page : pages)
 	{
-		//Write the master texture data to the file.
-		output_file.Write(bitmap.Data(), bitmap.GetWidth() * bitmap.GetHeight());
+		const uint32 page_width{ page.GetWidth() };
+		const uint32 page_height{ page.GetHeight() };
+
+		output_file.Write(&page_width, sizeof(uint32));
+		output_file.Write(&page_height, sizeof(uint32));
+		output_file.Write(page.Data(), page_width * page_height);
+	}
+
+	//Write the dynamic pages to the file, along with the font data that the glyph cache rasterizes from.
+	output_file.Write(&parameters._NumberOfDynamicPages, sizeof(uint32));
+
+	if (parameters._NumberOfDynamicPages > 0)
+	{
+		const uint64 font_data_size{ font_data.Size() };
+
+		output_file.Write(&font_data_size, sizeof(uint64));
+		output_file.Write(font_data.Data(), font_data_size);
 	}
 
 	//Close the output file.
 	output_file.Close();
+
+	LOG_INFORMATION
+	(
+		"%s: Rasterized %u characters in %.3f seconds, packed them into %u pages with %.1f%% occupancy in %.3f seconds, %u kerning pairs",
+		compile_context._Name.Data(),
+		number_of_characters,
+		rasterization_time,
+		number_of_pages,
+		average_occupancy * 100.0f,
+		packing_time,
+		number_of_kerning_pairs
+	);
+
+	//Report the output.
+	compile_context._Outputs.Emplace(output_file_path);
 }
 
 /*
@@ -355,71 +681,114 @@ void FontAssetCompiler::Load(const LoadContext &load_context) NOEXCEPT
 	//Read the data.
 	uint64 stream_archive_position{ load_context._StreamArchivePosition };
 
+	//Read the rasterization parameters.
+	load_context._StreamArchive->Read(&new_asset->_PixelHeight, sizeof(uint32), &stream_archive_position);
+	load_context._StreamArchive->Read(&new_asset->_Padding, sizeof(uint32), &stream_archive_position);
+
 	//Read all characters.
-	for (int8 i{ 0 }; i < FontAsset::NUMBER_OF_CHARACTER_DESCRIPTIONS; ++i)
+	uint32 number_of_characters;
+	load_context._StreamArchive->Read(&number_of_characters, sizeof(uint32), &stream_archive_position);
+
+	new_asset->_Codepoints.Upsize<false>(number_of_characters);
+	load_context._StreamArchive->Read(new_asset->_Codepoints.Data(), sizeof(uint32) * number_of_characters, &stream_archive_position);
+
+	new_asset->_CharacterDescriptions.Upsize<false>(number_of_characters);
+	load_context._StreamArchive->Read(new_asset->_CharacterDescriptions.Data(), sizeof(FontAsset::CharacterDescription) * number_of_characters, &stream_archive_position);
+
+	//Set up the ASCII indices. Codepoints are sorted, so the ASCII characters all come first.
+	for (uint32 &ascii_index : new_asset->_ASCIIIndices)
 	{
-		//Read the character description.
-		load_context._StreamArchive->Read(&new_asset->_CharacterDescriptions[i], sizeof(FontAsset::CharacterDescription), &stream_archive_position);
+		ascii_index = FontAsset::INVALID_INDEX;
 	}
 
-	//Read the texture width.
-	uint32 texture_width;
-	load_context._StreamArchive->Read(&texture_width, sizeof(uint32), &stream_archive_position);
+	for (uint32 i{ 0 }; i < number_of_characters && new_asset->_Codepoints[i] < FontAsset::NUMBER_OF_ASCII_CHARACTERS; ++i)
+	{
+		new_asset->_ASCIIIndices[new_asset->_Codepoints[i]] = i;
+	}
+
+	//Read the kerning pairs.
+	uint32 number_of_kerning_pairs;
+	load_context._StreamArchive->Read(&number_of_kerning_pairs, sizeof(uint32), &stream_archive_position);
 
-	//Read the master texture height.
-	uint32 texture_height;
-	load_context._StreamArchive->Read(&texture_height, sizeof(uint32), &stream_archive_position);
+	new_asset->_KerningPairs.Upsize<false>(number_of_kerning_pairs);
+	load_context._StreamArchive->Read(new_asset->_KerningPairs.Data(), sizeof(FontAsset::KerningPair) * number_of_kerning_pairs, &stream_archive_position);
 
-	//Read the number of mipmap levels.
-	uint8 number_of_mipmap_levels;
-	load_context._StreamArchive->Read(&number_of_mipmap_levels, sizeof(uint8), &stream_archive_position);
+	//Read the pages.
+	uint32 number_of_pages;
+	load_context._StreamArchive->Read(&number_of_pages, sizeof(uint32), &stream_archive_position);
 
-	//Read the texture data.
-	DynamicArray<DynamicArray<byte>> texture_data;
-	texture_data.Upsize<true>(number_of_mipmap_levels);
+	new_asset->_PageTextureIndices.Reserve(number_of_pages);
 
-	for (uint8 i{ 0 }; i < number_of_mipmap_levels; ++i)
+	for (uint32 page_index{ 0 }; page_index < number_of_pages; ++page_index)
 	{
-		const uint32 mip_width{ texture_width >> i };
-		const uint32 mip_height{ texture_height >> i };
+		//Read the page width.
+		uint32 page_width;
+		load_context._StreamArchive->Read(&page_width, sizeof(uint32), &stream_archive_position);
+
+		//Read the page height.
+		uint32 page_height;
+		load_context._StreamArchive->Read(&page_height, sizeof(uint32), &stream_archive_position);
 
-		texture_data[i].Upsize<false>(mip_width * mip_height);
+		//Retrieve a view of the page data, the texture is created straight from it.
+		DynamicArray<const byte *RESTRICT> texture_data;
+		texture_data.Emplace(load_context._StreamArchive->View(page_width * page_height, &stream_archive_position));
 
-		load_context._StreamArchive->Read(texture_data[i].Data(), mip_width * mip_height, &stream_archive_position);
+		//Create the texture.
+		Texture2DHandle texture;
+		RenderingSystem::Instance->CreateTexture2D(TextureData(TextureDataContainer(texture_data, page_width, page_height, 1), TextureFormat::R_UINT8, TextureUsage::NONE, false), &texture);
+
+		new_asset->_PageTextureIndices.Emplace(RenderingSystem::Instance->AddTextureToGlobalRenderData(texture));
 	}
 
-	//Create the texture.
-	Texture2DHandle texture;
-	RenderingSystem::Instance->CreateTexture2D(TextureData(TextureDataContainer(texture_data, texture_width, texture_height, 1), TextureFormat::R_UINT8, TextureUsage::NONE, false), &texture);
+	//Read the dynamic pages, and set up the glyph cache if there are any.
+	uint32 number_of_dynamic_pages;
+	load_context._StreamArchive->Read(&number_of_dynamic_pages, sizeof(uint32), &stream_archive_position);
+
+	if (number_of_dynamic_pages > 0)
+	{
+		uint64 font_data_size;
+		load_context._StreamArchive->Read(&font_data_size, sizeof(uint64), &stream_archive_position);
+
+		new_asset->_FontData.Upsize<false>(font_data_size);
+		load_context._StreamArchive->Read(new_asset->_FontData.Data(), font_data_size, &stream_archive_position);
+
+		{
+			SCOPED_LOCK(_GlyphCachesLock);
+
+			new_asset->_GlyphCache = new (_GlyphCacheAllocator.Allocate()) GlyphCache();
+			_GlyphCaches.Emplace(new_asset->_GlyphCache);
+		}
 
-	new_asset->_MasterTextureIndex = RenderingSystem::Instance->AddTextureToGlobalRenderData(texture);
+		new_asset->_GlyphCache->Initialize(new_asset, number_of_dynamic_pages);
+	}
 
 	//Calculate the default height.
 	new_asset->_DefaultHeight = FLOAT32_MAXIMUM;
 
-	for (uint8 i{ 0 }; i < FontAsset::NUMBER_OF_CHARACTER_DESCRIPTIONS; ++i)
+	for (uint32 i{ 0 }; i < number_of_characters; ++i)
 	{
+		const uint32 codepoint{ new_asset->_Codepoints[i] };
+
 		if (new_asset->_CharacterDescriptions[i]._Size._Y != 0.0f
-			&& ((i >= 'A' && i <= 'Z')
-			|| (i >= 'a' && i <= 'z')))
+			&& ((codepoint >= 'A' && codepoint <= 'Z')
+			|| (codepoint >= 'a' && codepoint <= 'z')))
 		{
 			new_asset->_DefaultHeight = BaseMath::Minimum<float32>(new_asset->_DefaultHeight, new_asset->_CharacterDescriptions[i]._Size._Y);
 		}
 	}
 
+	//Fonts compiled without latin characters fall back to the average height.
 	if (new_asset->_DefaultHeight == FLOAT32_MAXIMUM)
 	{
-		ASSERT(false, "This shouldn't happen...");
-
 		new_asset->_DefaultHeight = 0.0f;
 
 		float32 number_of_valid_characters{ 0.0f };
 
-		for (uint8 i{ 0 }; i < FontAsset::NUMBER_OF_CHARACTER_DESCRIPTIONS; ++i)
+		for (const FontAsset::CharacterDescription &character_description : new_asset->_CharacterDescriptions)
 		{
-			if (new_asset->_CharacterDescriptions[i]._Size._Y != 0.0f)
+			if (character_description._Size._Y != 0.0f)
 			{
-				new_asset->_DefaultHeight += new_asset->_CharacterDescriptions[i]._Size._Y;
+				new_asset->_DefaultHeight += character_description._Size._Y;
 
 				++number_of_valid_characters;
 			}
@@ -437,4 +806,19 @@ void FontAssetCompiler::Load(const LoadContext &load_context) NOEXCEPT
 			new_asset->_DefaultHeight = 0.1f;
 		}
 	}
+}
+
+/*
+*	Terminates this system.
+*/
+void FontAssetCompiler::Terminate() NOEXCEPT
+{
+	//Destroy the glyph caches.
+	for (GlyphCache *const RESTRICT glyph_cache : _GlyphCaches)
+	{
+		glyph_cache->~GlyphCache();
+		_GlyphCacheAllocator.Free(glyph_cache);
+	}
+
+	_GlyphCaches.Clear();
 }
\ No newline at end of file
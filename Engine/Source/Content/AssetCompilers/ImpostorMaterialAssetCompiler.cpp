@@ -16,6 +16,9 @@
 #include <Math/Core/CatalystGeometryMath.h>
 #include <Math/Geometry/AxisAlignedBoundingBox3D.h>
 
+//Path tracing.
+#include <PathTracing/PathTracingAccelerationStructure.h>
+
 //Profiling.
 #include <Profiling/Profiling.h>
 
@@ -23,7 +26,12 @@
 #include <Rendering/Native/RenderingCore.h>
 #include <Rendering/Native/Resolution.h>
 
+//Systems.
+#include <Systems/LogSystem.h>
+#include <Systems/TaskSystem.h>
+
 //STL.
+#include <chrono>
 #include <fstream>
 
 /*
@@ -58,8 +66,523 @@ public:
 	//The opacity textures.
 	StaticArray<Texture2D<Vector4<float32>>, RenderingConstants::MAXIMUM_NUMBER_OF_MESHES_PER_MODEL> _OpacityTextures;
 
+	//The number of views along each side of the octahedral view atlas. One bakes a single front view.
+	uint32 _NumberOfViews;
+
+};
+
+//Impostor material asset compiler constants.
+namespace ImpostorMaterialAssetCompilerConstants
+{
+	constexpr uint32 TILE_SIZE{ 32 };
+	constexpr uint64 MAXIMUM_TRIANGLES_PER_NODE{ 8 };
+}
+
+/*
+*	Impostor triangle data class definition.
+*	Stored as the user data of each triangle in the acceleration structure.
+*/
+class ImpostorTriangleData final
+{
+
+public:
+
+	//The opacity texture.
+	const Texture2D<Vector4<float32>> *RESTRICT _OpacityTexture;
+
+	//The mesh index.
+	uint32 _MeshIndex;
+
+};
+
+/*
+*	Impostor bake context class definition.
+*/
+class ImpostorBakeContext final
+{
+
+public:
+
+	//The parameters.
+	const ImpostorMaterialParameters *RESTRICT _Parameters;
+
+	//The acceleration structure.
+	const PathTracingAccelerationStructure *RESTRICT _AccelerationStructure;
+
+	//The axis aligned bounding box of the model.
+	AxisAlignedBoundingBox3D _AxisAlignedBoundingBox;
+
+	//The resolution of each view.
+	Resolution _ViewResolution;
+
+	//The number of tiles along the X axis.
+	uint32 _NumberOfTilesX;
+
+	//The number of tiles along the Y axis.
+	uint32 _NumberOfTilesY;
+
+	//The albedo texture.
+	Texture2D<Vector4<float32>> *RESTRICT _AlbedoTexture;
+
+	//The normal map texture.
+	Texture2D<Vector4<float32>> *RESTRICT _NormalMapTexture;
+
+	//The material properties texture.
+	Texture2D<Vector4<float32>> *RESTRICT _MaterialPropertiesTexture;
+
+	//The opacity texture.
+	Texture2D<Vector4<float32>> *RESTRICT _OpacityTexture;
+
 };
 
+/*
+*	The discard function for triangles with an opacity texture.
+*/
+FORCE_INLINE static NO_DISCARD bool ImpostorDiscardFunction(const PathTracingShadingContext &context) NOEXCEPT
+{
+	const ImpostorTriangleData *const RESTRICT triangle_data{ context._UserData.Get<ImpostorTriangleData>() };
+
+	return triangle_data->_OpacityTexture->Sample(context._TextureCoordinate, AddressMode::REPEAT)[0] >= 0.5f;
+}
+
+/*
+*	Calculates the ray for the given texel.
+*	With a single view, the model is viewed from the front along the Z axis.
+*	With multiple views, each view looks at the model from a direction on the upper hemisphere, laid out as a hemi-octahedron.
+*/
+FORCE_INLINE static NO_DISCARD Ray CalculateRay(const ImpostorBakeContext &context, const uint32 X, const uint32 Y) NOEXCEPT
+{
+	const AxisAlignedBoundingBox3D &axis_aligned_bounding_box{ context._AxisAlignedBoundingBox };
+
+	//Calculate the normalized coordinate within the view.
+	const Vector2<float32> normalized_coordinate
+	{
+		(static_cast<float32>(X % context._ViewResolution._Width) + 0.5f) / static_cast<float32>(context._ViewResolution._Width),
+		(static_cast<float32>(Y % context._ViewResolution._Height) + 0.5f) / static_cast<float32>(context._ViewResolution._Height)
+	};
+
+	if (context._Parameters->_NumberOfViews == 1)
+	{
+		//Calculate the minimum/maximum coordinate.
+		Vector2<float32> minimum;
+		Vector2<float32> maximum;
+
+		{
+			minimum._X = axis_aligned_bounding_box._Minimum._X;
+			minimum._Y = axis_aligned_bounding_box._Minimum._Y;
+
+			maximum._X = axis_aligned_bounding_box._Maximum._X;
+			maximum._Y = axis_aligned_bounding_box._Maximum._Y;
+
+			//Center if around the origin on the X axis.
+			const float32 min_distance_from_center{ BaseMath::Absolute(minimum._X) };
+			const float32 max_distance_from_center{ BaseMath::Absolute(maximum._X) };
+
+			if (min_distance_from_center > max_distance_from_center)
+			{
+				maximum._X += (min_distance_from_center - max_distance_from_center);
+			}
+
+			else
+			{
+				minimum._X -= (max_distance_from_center - min_distance_from_center);
+			}
+		}
+
+		//Calculate the camera position.
+		Vector3<float32> camera_position;
+
+		camera_position._X = BaseMath::LinearlyInterpolate(minimum._X, maximum._X, normalized_coordinate._X);
+		camera_position._Y = BaseMath::LinearlyInterpolate(minimum._Y, maximum._Y, normalized_coordinate._Y);
+		camera_position._Z = axis_aligned_bounding_box._Minimum._Z - 1.0f;
+
+		return Ray(camera_position, Vector3<float32>(0.0f, 0.0f, 1.0f));
+	}
+
+	//Decode the view direction from the hemi-octahedron.
+	Vector3<float32> view_direction;
+
+	{
+		const float32 number_of_views{ static_cast<float32>(context._Parameters->_NumberOfViews) };
+
+		const float32 A{ (static_cast<float32>(X / context._ViewResolution._Width) + 0.5f) / number_of_views * 2.0f - 1.0f };
+		const float32 B{ (static_cast<float32>(Y / context._ViewResolution._Height) + 0.5f) / number_of_views * 2.0f - 1.0f };
+
+		view_direction._X = (A + B) * 0.5f;
+		view_direction._Z = (A - B) * 0.5f;
+		view_direction._Y = 1.0f - BaseMath::Absolute(view_direction._X) - BaseMath::Absolute(view_direction._Z);
+
+		view_direction.Normalize();
+	}
+
+	//Calculate the view basis. Looking straight down has no well defined right vector, so just pick one.
+	Vector3<float32> right_vector{ Vector3<float32>::CrossProduct(view_direction, Vector3<float32>(0.0f, 1.0f, 0.0f)) };
+
+	if (Vector3<float32>::LengthSquared(right_vector) < FLOAT32_EPSILON)
+	{
+		right_vector = Vector3<float32>(1.0f, 0.0f, 0.0f);
+	}
+
+	else
+	{
+		right_vector.Normalize();
+	}
+
+	const Vector3<float32> up_vector{ Vector3<float32>::CrossProduct(right_vector, view_direction) };
+
+	//All views share the bounding sphere of the model as their extent, so that they line up when blended.
+	const Vector3<float32> center{ AxisAlignedBoundingBox3D::CalculateCenter(axis_aligned_bounding_box) };
+	const float32 radius{ Vector3<float32>::Length(axis_aligned_bounding_box._Maximum - axis_aligned_bounding_box._Minimum) * 0.5f };
+
+	const Vector3<float32> camera_position
+	{
+		center
+		+ view_direction * (radius + 1.0f)
+		+ right_vector * BaseMath::LinearlyInterpolate(-radius, radius, normalized_coordinate._X)
+		+ up_vector * BaseMath::LinearlyInterpolate(-radius, radius, normalized_coordinate._Y)
+	};
+
+	return Ray(camera_position, -view_direction);
+}
+
+/*
+*	Bakes the given texel.
+*/
+static void BakeTexel(const ImpostorBakeContext &context, const uint32 X, const uint32 Y) NOEXCEPT
+{
+	const ImpostorMaterialParameters &parameters{ *context._Parameters };
+
+	//Construct the ray.
+	const Ray ray{ CalculateRay(context, X, Y) };
+
+	//Trace the ray through the acceleration structure. Triangles masked out by their opacity texture are discarded during the trace.
+	float32 intersection_distance{ FLOAT32_MAXIMUM };
+	const PathTracingTriangle *const RESTRICT intersected_triangle{ context._AccelerationStructure->TraceSurface(ray, &intersection_distance) };
+
+	//Was there a hit?
+	if (intersected_triangle)
+	{
+		//Calculate the vertex properties.
+		const uint32 intersected_mesh_index{ intersected_triangle->_UserData.Get<ImpostorTriangleData>()->_MeshIndex };
+		Vector3<float32> intersected_normal;
+		Vector3<float32> intersected_tangent;
+		Vector2<float32> intersected_texture_coordinate;
+
+		{
+			const Vertex &vertex_1{ context._AccelerationStructure->GetVertex(intersected_triangle->_Indices[0]) };
+			const Vertex &vertex_2{ context._AccelerationStructure->GetVertex(intersected_triangle->_Indices[1]) };
+			const Vertex &vertex_3{ context._AccelerationStructure->GetVertex(intersected_triangle->_Indices[2]) };
+
+			//Calculate the intersection point.
+			const Vector3<float32> intersection_point{ ray._Origin + ray._Direction * intersection_distance };
+
+			//Calculate the barycentric coordinate.
+			Triangle triangle;
+
+			triangle._Vertices[0] = vertex_1._Position;
+			triangle._Vertices[1] = vertex_2._Position;
+			triangle._Vertices[2] = vertex_3._Position;
+
+			const Vector3<float32> barycentric_coordinate{ CatalystGeometryMath::CalculateBarycentricCoordinates(triangle, intersection_point) };
+
+			//Calculate the normal.
+			intersected_normal = vertex_1._Normal * barycentric_coordinate[0] + vertex_2._Normal * barycentric_coordinate[1] + vertex_3._Normal * barycentric_coordinate[2];
+
+			//Calculate the tangent.
+			intersected_tangent = vertex_1._Tangent * barycentric_coordinate[0] + vertex_2._Tangent * barycentric_coordinate[1] + vertex_3._Tangent * barycentric_coordinate[2];
+
+			//Calculate the texture coordinate.
+			intersected_texture_coordinate = vertex_1._TextureCoordinate * barycentric_coordinate[0] + vertex_2._TextureCoordinate * barycentric_coordinate[1] + vertex_3._TextureCoordinate * barycentric_coordinate[2];
+		}
+
+		//Fill in the albedo texture.
+		{
+			Vector4<float32> albedo{ 1.0f, 1.0f, 1.0f, 1.0f };
+
+			if (parameters._AlbedoTextures[intersected_mesh_index].GetWidth() > 0)
+			{
+				const Vector4<float32> texture_sample{ parameters._AlbedoTextures[intersected_mesh_index].Sample(intersected_texture_coordinate, AddressMode::REPEAT) };
+
+				albedo._R = texture_sample._R;
+				albedo._G = texture_sample._G;
+				albedo._B = texture_sample._B;
+			}
+
+			context._AlbedoTexture->At(X, Y) = albedo;
+		}
+
+		//Fill in the normal map/displacement texture.
+		{
+			Vector4<float32> normal_map_displacement{ intersected_normal, 0.5f };
+
+			if (parameters._NormalMapTextures[intersected_mesh_index].GetWidth() > 0)
+			{
+				//Calculate the tangent space matrix.
+				Matrix3x3 tangent_space_matrix{ intersected_tangent, Vector3<float32>::CrossProduct(intersected_normal, intersected_tangent), intersected_normal };
+
+				tangent_space_matrix._Matrix[0] = Vector3<float32>::Normalize(tangent_space_matrix._Matrix[0]);
+				tangent_space_matrix._Matrix[1] = Vector3<float32>::Normalize(tangent_space_matrix._Matrix[1]);
+				tangent_space_matrix._Matrix[2] = Vector3<float32>::Normalize(tangent_space_matrix._Matrix[2]);
+
+				//Sample the normal map.
+				Vector3<float32> normal_map_sample;
+
+				{
+					Vector4<float32> _normal_map_sample{ parameters._NormalMapTextures[intersected_mesh_index].Sample(intersected_texture_coordinate, AddressMode::REPEAT) };
+
+					normal_map_sample._X = _normal_map_sample._X;
+					normal_map_sample._Y = _normal_map_sample._Y;
+					normal_map_sample._Z = _normal_map_sample._Z;
+				}
+
+				//Re-scale the normal map sample.
+				normal_map_sample._X = normal_map_sample._X * 2.0f - 1.0f;
+				normal_map_sample._Y = normal_map_sample._Y * 2.0f - 1.0f;
+				normal_map_sample._Z = normal_map_sample._Z * 2.0f - 1.0f;
+
+				//Normalize, to be safe.
+				normal_map_sample.Normalize();
+
+				//Calculate the surface normal.
+				Vector3<float32> surface_normal{ tangent_space_matrix * normal_map_sample };
+
+				//Flip it.
+				surface_normal *= -1.0f;
+
+				//Normalize, to be safe.
+				surface_normal.Normalize();
+
+				//Flip the normal if we hit the backside.
+				if (Vector3<float32>::DotProduct(ray._Direction, surface_normal) < 0.0f)
+				{
+					surface_normal *= -1.0f;
+				}
+
+				//Re-scale the surface_normal.
+				surface_normal._X = surface_normal._X * 0.5f + 0.5f;
+				surface_normal._Y = surface_normal._Y * 0.5f + 0.5f;
+				surface_normal._Z = surface_normal._Z * 0.5f + 0.5f;
+
+				//Update the normal map/displacement value.
+				normal_map_displacement._X = surface_normal._X;
+				normal_map_displacement._Y = surface_normal._Y;
+				normal_map_displacement._Z = surface_normal._Z;
+			}
+
+			context._NormalMapTexture->At(X, Y) = normal_map_displacement;
+		}
+
+		//Fill in the material properties texture.
+		{
+			Vector4<float32> material_properties{ 1.0f, 0.0f, 1.0f, 0.0 };
+
+			if (parameters._RoughnessTextures[intersected_mesh_index].GetWidth() > 0)
+			{
+				const Vector4<float32> texture_sample{ parameters._RoughnessTextures[intersected_mesh_index].Sample(intersected_texture_coordinate, AddressMode::REPEAT) };
+
+				material_properties._X = texture_sample._X;
+			}
+
+			context._MaterialPropertiesTexture->At(X, Y) = material_properties;
+		}
+
+		//Fill in the opacity texture.
+		context._OpacityTexture->At(X, Y) = Vector4<float32>(1.0f, 1.0f, 1.0f, 1.0f);
+	}
+
+	else
+	{
+		//Fill in the textures.
+		context._AlbedoTexture->At(X, Y) = Vector4<float32>(0.0f, 0.0f, 0.0f, 1.0f);
+		context._NormalMapTexture->At(X, Y) = Vector4<float32>(0.5f, 0.5f, 1.0f, 0.5f);
+		context._MaterialPropertiesTexture->At(X, Y) = Vector4<float32>(1.0f, 0.0f, 1.0f, 0.0f);
+		context._OpacityTexture->At(X, Y) = Vector4<float32>(0.0f, 0.0f, 0.0f, 1.0f);
+	}
+}
+
+/*
+*	Bakes the texels of the given tile.
+*/
+static void BakeTile(const ImpostorBakeContext &context, const uint32 tile_index) NOEXCEPT
+{
+	const uint32 start_X{ (tile_index % context._NumberOfTilesX) * ImpostorMaterialAssetCompilerConstants::TILE_SIZE };
+	const uint32 start_Y{ (tile_index / context._NumberOfTilesX) * ImpostorMaterialAssetCompilerConstants::TILE_SIZE };
+	const uint32 end_X{ BaseMath::Minimum<uint32>(start_X + ImpostorMaterialAssetCompilerConstants::TILE_SIZE, context._OpacityTexture->GetWidth()) };
+	const uint32 end_Y{ BaseMath::Minimum<uint32>(start_Y + ImpostorMaterialAssetCompilerConstants::TILE_SIZE, context._OpacityTexture->GetHeight()) };
+
+	for (uint32 Y{ start_Y }; Y < end_Y; ++Y)
+	{
+		for (uint32 X{ start_X }; X < end_X; ++X)
+		{
+			BakeTexel(context, X, Y);
+		}
+	}
+}
+
+/*
+*	Calculates the exact squared euclidean distance transform of the given samples, as the lower envelope of parabolas rooted at each sample.
+*	Samples with a value of FLOAT32_MAXIMUM are infinitely far away, and don't contribute.
+*	Writes out the distance to, and the index of, the closest sample for each sample, or UINT32_MAXIMUM if there is none. Runs in linear time.
+*/
+static void DistanceTransform
+(
+	const float32 *const RESTRICT values,
+	const uint32 number_of_values,
+	float32 *const RESTRICT distances,
+	uint32 *const RESTRICT closest_indices,
+	uint32 *const RESTRICT parabola_indices,
+	float32 *const RESTRICT parabola_boundaries
+) NOEXCEPT
+{
+	//Build the lower envelope.
+	uint32 number_of_parabolas{ 0 };
+
+	for (uint32 index{ 0 }; index < number_of_values; ++index)
+	{
+		if (values[index] == FLOAT32_MAXIMUM)
+		{
+			continue;
+		}
+
+		const float32 position{ static_cast<float32>(index) };
+
+		if (number_of_parabolas == 0)
+		{
+			parabola_indices[0] = index;
+			parabola_boundaries[0] = -FLOAT32_MAXIMUM;
+			parabola_boundaries[1] = FLOAT32_MAXIMUM;
+			number_of_parabolas = 1;
+
+			continue;
+		}
+
+		//Remove the parabolas that this one hides. The first boundary is negative infinity, so the first parabola is never removed.
+		float32 intersection;
+
+		for (;;)
+		{
+			const uint32 previous_index{ parabola_indices[number_of_parabolas - 1] };
+			const float32 previous_position{ static_cast<float32>(previous_index) };
+
+			intersection = ((values[index] + position * position) - (values[previous_index] + previous_position * previous_position)) / (2.0f * (position - previous_position));
+
+			if (intersection <= parabola_boundaries[number_of_parabolas - 1])
+			{
+				--number_of_parabolas;
+			}
+
+			else
+			{
+				break;
+			}
+		}
+
+		parabola_indices[number_of_parabolas] = index;
+		parabola_boundaries[number_of_parabolas] = intersection;
+		parabola_boundaries[number_of_parabolas + 1] = FLOAT32_MAXIMUM;
+		++number_of_parabolas;
+	}
+
+	//No samples, so nothing is close.
+	if (number_of_parabolas == 0)
+	{
+		for (uint32 index{ 0 }; index < number_of_values; ++index)
+		{
+			distances[index] = FLOAT32_MAXIMUM;
+			closest_indices[index] = UINT32_MAXIMUM;
+		}
+
+		return;
+	}
+
+	//Evaluate the lower envelope.
+	uint32 parabola_index{ 0 };
+
+	for (uint32 index{ 0 }; index < number_of_values; ++index)
+	{
+		const float32 position{ static_cast<float32>(index) };
+
+		while (parabola_boundaries[parabola_index + 1] < position)
+		{
+			++parabola_index;
+		}
+
+		const uint32 closest_index{ parabola_indices[parabola_index] };
+		const float32 offset{ position - static_cast<float32>(closest_index) };
+
+		distances[index] = offset * offset + values[closest_index];
+		closest_indices[index] = closest_index;
+	}
+}
+
+/*
+*	Fills every transparent texel of the given view with the closest opaque texel of the same view, to "stretch out" the textures.
+*	The closest texel is found with an exact euclidean distance transform, first along the columns and then along the rows.
+*/
+static void DilateView(const ImpostorBakeContext &context, const uint32 view_index) NOEXCEPT
+{
+	const uint32 width{ context._ViewResolution._Width };
+	const uint32 height{ context._ViewResolution._Height };
+	const uint32 start_X{ (view_index % context._Parameters->_NumberOfViews) * width };
+	const uint32 start_Y{ (view_index / context._Parameters->_NumberOfViews) * height };
+	const uint32 longest_side{ BaseMath::Maximum<uint32>(width, height) };
+
+	//Set up the scratch memory.
+	DynamicArray<float32> column_distances;
+	DynamicArray<uint32> column_closest_indices;
+	DynamicArray<float32> values;
+	DynamicArray<float32> distances;
+	DynamicArray<uint32> closest_indices;
+	DynamicArray<uint32> parabola_indices;
+	DynamicArray<float32> parabola_boundaries;
+
+	column_distances.Upsize<false>(width * height);
+	column_closest_indices.Upsize<false>(width * height);
+	values.Upsize<false>(longest_side);
+	distances.Upsize<false>(longest_side);
+	closest_indices.Upsize<false>(longest_side);
+	parabola_indices.Upsize<false>(longest_side);
+	parabola_boundaries.Upsize<false>(longest_side + 1);
+
+	//Transform the columns, with the opaque texels as the samples.
+	for (uint32 X{ 0 }; X < width; ++X)
+	{
+		for (uint32 Y{ 0 }; Y < height; ++Y)
+		{
+			values[Y] = context._OpacityTexture->At(start_X + X, start_Y + Y)._X >= 0.5f ? 0.0f : FLOAT32_MAXIMUM;
+		}
+
+		DistanceTransform(values.Data(), height, distances.Data(), closest_indices.Data(), parabola_indices.Data(), parabola_boundaries.Data());
+
+		for (uint32 Y{ 0 }; Y < height; ++Y)
+		{
+			column_distances[Y * width + X] = distances[Y];
+			column_closest_indices[Y * width + X] = closest_indices[Y];
+		}
+	}
+
+	//Transform the rows, with the column distances as the samples, and copy over the closest texels.
+	for (uint32 Y{ 0 }; Y < height; ++Y)
+	{
+		DistanceTransform(&column_distances[Y * width], width, distances.Data(), closest_indices.Data(), parabola_indices.Data(), parabola_boundaries.Data());
+
+		for (uint32 X{ 0 }; X < width; ++X)
+		{
+			if (context._OpacityTexture->At(start_X + X, start_Y + Y)._X >= 0.5f || closest_indices[X] == UINT32_MAXIMUM)
+			{
+				continue;
+			}
+
+			const uint32 closest_X{ start_X + closest_indices[X] };
+			const uint32 closest_Y{ start_Y + column_closest_indices[Y * width + closest_indices[X]] };
+
+			context._AlbedoTexture->At(start_X + X, start_Y + Y) = context._AlbedoTexture->At(closest_X, closest_Y);
+			context._NormalMapTexture->At(start_X + X, start_Y + Y) = context._NormalMapTexture->At(closest_X, closest_Y);
+			context._MaterialPropertiesTexture->At(start_X + X, start_Y + Y) = context._MaterialPropertiesTexture->At(closest_X, closest_Y);
+		}
+	}
+}
+
 /*
 *	Default constructor.
 */
@@ -85,7 +608,7 @@ NO_DISCARD HashString ImpostorMaterialAssetCompiler::AssetTypeIdentifier() const
 */
 NO_DISCARD uint64 ImpostorMaterialAssetCompiler::CurrentVersion() const NOEXCEPT
 {
-	return 1;
+	return 2;
 }
 
 /*
@@ -95,27 +618,12 @@ void ImpostorMaterialAssetCompiler::Compile(const CompileContext &compile_contex
 {
 	PROFILING_SCOPE("ImpostorMaterialAssetCompiler::Compile");
 
-	class SignedDistanceFieldData final
-	{
-
-	public:
-
-		//The closest texel coordinate.
-		Vector2<uint32> _ClosestTexelCoordinate;
-
-		//The closest texel distance.
-		float32 _ClosestTexelDistance;
-
-		//Denotes whether or not this texel is outside.
-		bool _Outside;
-
-	};
-
 	//Set up the parameters.
 	ImpostorMaterialParameters parameters;
 
 	//Set some reasonable defaults.
 	parameters._SuperSample = 0;
+	parameters._NumberOfViews = 1;
 
 	//Open the input file.
 	std::ifstream input_file{ compile_context._FilePath.Data() };
@@ -200,6 +708,30 @@ void ImpostorMaterialAssetCompiler::Compile(const CompileContext &compile_contex
 				}
 			}
 
+			//Is this a views declaration?
+			{
+				const size_t position{ current_line.find("Views(") };
+
+				if (position != std::string::npos)
+				{
+					const uint64 number_of_arguments
+					{
+						TextParsingUtilities::ParseFunctionArguments
+						(
+							current_line.c_str(),
+							current_line.length(),
+							arguments.Data()
+						)
+					};
+
+					ASSERT(number_of_arguments == 1, "Views() needs one argument!");
+
+					parameters._NumberOfViews = std::stoul(arguments[0].Data());
+
+					continue;
+				}
+			}
+
 			//Is this a model declaration?
 			{
 				const size_t position{ current_line.find("Model(") };
@@ -444,302 +976,109 @@ void ImpostorMaterialAssetCompiler::Compile(const CompileContext &compile_contex
 		ASSERT(false, "Couldn't read %s!", parameters._Model.Data());
 	}
 
-	//Set up the axis aligned bounding box.
-	AxisAlignedBoundingBox3D axis_aligned_bounding_box;
+	ASSERT(parameters._NumberOfViews > 0, "Views() needs at least one view!");
+	ASSERT((parameters._Resolution._Width % parameters._NumberOfViews) == 0 && (parameters._Resolution._Height % parameters._NumberOfViews) == 0, "The resolution needs to be divisible by the number of views!");
 
-	for (const ModelFile::Mesh &mesh : model._Meshes)
-	{
-		for (const Vertex &vertex : mesh._Vertices)
-		{
-			axis_aligned_bounding_box.Expand(vertex._Position);
-		}
-	}
+	const std::chrono::steady_clock::time_point bake_start_time{ std::chrono::steady_clock::now() };
 
-	//Create the impostor textures!
-	Texture2D<Vector4<float32>> impostor_albedo_texture{ parameters._Resolution._Width, parameters._Resolution._Height };
-	Texture2D<Vector4<float32>> impostor_normal_map_texture{ parameters._Resolution._Width, parameters._Resolution._Height };
-	Texture2D<Vector4<float32>> impostor_material_properties_texture{ parameters._Resolution._Width, parameters._Resolution._Height };
-	Texture2D<Vector4<float32>> impostor_opacity_texture{ parameters._Resolution._Width, parameters._Resolution._Height };
+	//Build the acceleration structure over the triangles of all meshes.
+	PathTracingAccelerationStructure acceleration_structure;
+	AxisAlignedBoundingBox3D axis_aligned_bounding_box;
 
-	for (uint32 Y{ 0 }; Y < parameters._Resolution._Height; ++Y)
 	{
-		for (uint32 X{ 0 }; X < parameters._Resolution._Width; ++X)
-		{
-			//Calculate the normalized coordinate.
-			const Vector2<float32> normalized_coordinate
-			{
-				(static_cast<float32>(X) + 0.5f) / static_cast<float32>(parameters._Resolution._Width),
-				(static_cast<float32>(Y) + 0.5f) / static_cast<float32>(parameters._Resolution._Height)
-			};
-
-			//Calculate the minimum/maximum coordinate.
-			Vector2<float32> minimum;
-			Vector2<float32> maximum;
-
-			{
-				minimum._X = axis_aligned_bounding_box._Minimum._X;
-				minimum._Y = axis_aligned_bounding_box._Minimum._Y;
-
-				maximum._X = axis_aligned_bounding_box._Maximum._X;
-				maximum._Y = axis_aligned_bounding_box._Maximum._Y;
-
-				//Center if around the origin on the X axis.
-				const float32 min_distance_from_center{ BaseMath::Absolute(minimum._X) };
-				const float32 max_distance_from_center{ BaseMath::Absolute(maximum._X) };
-
-				if (min_distance_from_center > max_distance_from_center)
-				{
-					maximum._X += (min_distance_from_center - max_distance_from_center);
-				}
-
-				else
-				{
-					minimum._X -= (max_distance_from_center - min_distance_from_center);
-				}
-			}
+		DynamicArray<Vertex> *const RESTRICT vertices{ acceleration_structure.GetBuildVerticesPointer() };
+		DynamicArray<PathTracingTriangle> *const RESTRICT triangles{ acceleration_structure.GetBuildTrianglesPointer() };
 
-			//Calculate the camera position.
-			Vector3<float32> camera_position;
-
-			camera_position._X = BaseMath::LinearlyInterpolate(minimum._X, maximum._X, normalized_coordinate._X);
-			camera_position._Y = BaseMath::LinearlyInterpolate(minimum._Y, maximum._Y, normalized_coordinate._Y);
-			camera_position._Z = axis_aligned_bounding_box._Minimum._Z - 1.0f;
-
-			//Construct the ray.
-			Ray ray;
-
-			ray.SetOrigin(camera_position);
-			ray.SetDirection(Vector3<float32>(0.0f, 0.0f, 1.0f));
-
-			//Intersect every triangle and check for hits.
-			float32 intersection_distance{ FLOAT32_MAXIMUM };
-			uint64 intersected_mesh_index{ 0 };
-			Vector3<float32> intersected_normal;
-			Vector3<float32> intersected_tangent;
-			Vector2<float32> intersected_texture_coordinate;
+		for (uint32 mesh_index{ 0 }; mesh_index < model._Meshes.Size(); ++mesh_index)
+		{
+			//Cache the mesh.
+			const ModelFile::Mesh &mesh{ model._Meshes[mesh_index] };
+			const uint64 vertex_offset{ vertices->Size() };
 
-			for (uint64 mesh_index{ 0 }; mesh_index < model._Meshes.Size(); ++mesh_index)
+			for (const Vertex &vertex : mesh._Vertices)
 			{
-				//Cache the mesh.
-				const ModelFile::Mesh &mesh{ model._Meshes[mesh_index] };
-
-				for (uint32 index{ 0 }; index < mesh._Indices.Size(); index += 3)
-				{
-					//Construct the triangle.
-					Triangle triangle;
-
-					triangle._Vertices[0] = mesh._Vertices[mesh._Indices[index + 0]]._Position;
-					triangle._Vertices[1] = mesh._Vertices[mesh._Indices[index + 1]]._Position;
-					triangle._Vertices[2] = mesh._Vertices[mesh._Indices[index + 2]]._Position;
-
-					//Intersect the triangle.
-					float32 temporary_intersection_distance;
-
-					if (CatalystGeometryMath::RayTriangleIntersection(ray, triangle, &temporary_intersection_distance))
-					{
-						if (intersection_distance > temporary_intersection_distance)
-						{
-							//Calculate the vertex properties.
-							Vector3<float32> normal;
-							Vector3<float32> tangent;
-							Vector2<float32> texture_coordinate;
-
-							{
-								//Calculate the intersected texture coordinate.
-								const Vector3<float32> intersection_point{ ray._Origin + ray._Direction * temporary_intersection_distance };
-
-								//Calculate the barycentric coordinate.
-								const Vector3<float32> barycentric_coordinate{ CatalystGeometryMath::CalculateBarycentricCoordinates(triangle, intersection_point) };
-
-								//Calculate the normal.
-								normal = mesh._Vertices[mesh._Indices[index + 0]]._Normal * barycentric_coordinate[0] + mesh._Vertices[mesh._Indices[index + 1]]._Normal * barycentric_coordinate[1] + mesh._Vertices[mesh._Indices[index + 2]]._Normal * barycentric_coordinate[2];
-
-								//Calculate the tangent.
-								tangent = mesh._Vertices[mesh._Indices[index + 0]]._Tangent * barycentric_coordinate[0] + mesh._Vertices[mesh._Indices[index + 1]]._Tangent * barycentric_coordinate[1] + mesh._Vertices[mesh._Indices[index + 2]]._Tangent * barycentric_coordinate[2];
-
-								//Calculate the texture coordinate.
-								texture_coordinate = mesh._Vertices[mesh._Indices[index + 0]]._TextureCoordinate * barycentric_coordinate[0] + mesh._Vertices[mesh._Indices[index + 1]]._TextureCoordinate * barycentric_coordinate[1] + mesh._Vertices[mesh._Indices[index + 2]]._TextureCoordinate * barycentric_coordinate[2];
-							}
-
-							//Check the mask texture if this was really a hit.
-							bool was_really_a_hit{ true };
-
-							if (parameters._OpacityTextures[mesh_index].GetWidth() > 0)
-							{
-								const Vector4<float32> mask_value{ parameters._OpacityTextures[mesh_index].Sample(texture_coordinate, AddressMode::REPEAT) };
-
-								was_really_a_hit = mask_value[0] >= 0.5f;
-							}
-
-							if (was_really_a_hit)
-							{
-								intersection_distance = temporary_intersection_distance;
-								intersected_mesh_index = mesh_index;
-								intersected_normal = normal;
-								intersected_tangent = tangent;
-								intersected_texture_coordinate = texture_coordinate;
-							}
-						}
-					}
-				}
+				vertices->Emplace(vertex);
+				axis_aligned_bounding_box.Expand(vertex._Position);
 			}
 
-			//Was there a hit?
-			if (intersection_distance != FLOAT32_MAXIMUM)
-			{
-				//Fill in the albedo texture.
-				{
-					Vector4<float32> albedo{ 1.0f, 1.0f, 1.0f, 1.0f };
-
-					if (parameters._AlbedoTextures[intersected_mesh_index].GetWidth() > 0)
-					{
-						const Vector4<float32> texture_sample{ parameters._AlbedoTextures[intersected_mesh_index].Sample(intersected_texture_coordinate, AddressMode::REPEAT) };
-
-						albedo._R = texture_sample._R;
-						albedo._G = texture_sample._G;
-						albedo._B = texture_sample._B;
-					}
-
-					impostor_albedo_texture.At(X, Y) = albedo;
-				}
-
-				//Fill in the normal map/displacement texture.
-				{
-					Vector4<float32> normal_map_displacement{ intersected_normal, 0.5f };
-
-					if (parameters._NormalMapTextures[intersected_mesh_index].GetWidth() > 0)
-					{
-						//Calculate the tangent space matrix.
-						Matrix3x3 tangent_space_matrix{ intersected_tangent, Vector3<float32>::CrossProduct(intersected_normal, intersected_tangent), intersected_normal };
-
-						tangent_space_matrix._Matrix[0] = Vector3<float32>::Normalize(tangent_space_matrix._Matrix[0]);
-						tangent_space_matrix._Matrix[1] = Vector3<float32>::Normalize(tangent_space_matrix._Matrix[1]);
-						tangent_space_matrix._Matrix[2] = Vector3<float32>::Normalize(tangent_space_matrix._Matrix[2]);
-
-						//Sample the normal map.
-						Vector3<float32> normal_map_sample;
+			ImpostorTriangleData triangle_data;
 
-						{
-							Vector4<float32> _normal_map_sample{ parameters._NormalMapTextures[intersected_mesh_index].Sample(intersected_texture_coordinate, AddressMode::REPEAT) };
-
-							normal_map_sample._X = _normal_map_sample._X;
-							normal_map_sample._Y = _normal_map_sample._Y;
-							normal_map_sample._Z = _normal_map_sample._Z;
-						}
-
-						//Re-scale the normal map sample.
-						normal_map_sample._X = normal_map_sample._X * 2.0f - 1.0f;
-						normal_map_sample._Y = normal_map_sample._Y * 2.0f - 1.0f;
-						normal_map_sample._Z = normal_map_sample._Z * 2.0f - 1.0f;
-
-						//Normalize, to be safe.
-						normal_map_sample.Normalize();
-
-						//Calculate the surface normal.
-						Vector3<float32> surface_normal{ tangent_space_matrix * normal_map_sample };
-
-						//Flip it.
-						surface_normal *= -1.0f;
-
-						//Normalize, to be safe.
-						surface_normal.Normalize();
-
-						//Flip the normal if we hit the backside.
-						if (Vector3<float32>::DotProduct(ray._Direction, surface_normal) < 0.0f)
-						{
-							surface_normal *= -1.0f;
-						}
+			triangle_data._OpacityTexture = &parameters._OpacityTextures[mesh_index];
+			triangle_data._MeshIndex = mesh_index;
 
-						//Re-scale the surface_normal.
-						surface_normal._X = surface_normal._X * 0.5f + 0.5f;
-						surface_normal._Y = surface_normal._Y * 0.5f + 0.5f;
-						surface_normal._Z = surface_normal._Z * 0.5f + 0.5f;
-
-						//Update the normal map/displacement value.
-						normal_map_displacement._X = surface_normal._X;
-						normal_map_displacement._Y = surface_normal._Y;
-						normal_map_displacement._Z = surface_normal._Z;
-					}
-
-					impostor_normal_map_texture.At(X, Y) = normal_map_displacement;
-				}
-
-				//Fill in the material properties texture.
-				{
-					Vector4<float32> material_properties{ 1.0f, 0.0f, 1.0f, 0.0 };
-
-					if (parameters._RoughnessTextures[intersected_mesh_index].GetWidth() > 0)
-					{
-						const Vector4<float32> texture_sample{ parameters._RoughnessTextures[intersected_mesh_index].Sample(intersected_texture_coordinate, AddressMode::REPEAT) };
-
-						material_properties._X = texture_sample._X;
-					}
-
-					impostor_material_properties_texture.At(X, Y) = material_properties;
-				}
-
-				//Fill in the opacity texture.
-				impostor_opacity_texture.At(X, Y) = Vector4<float32>(1.0f, 1.0f, 1.0f, 1.0f);
-			}
-
-			else
+			for (uint64 index{ 0 }; index < mesh._Indices.Size(); index += 3)
 			{
-				//Fill in the textures.
-				impostor_albedo_texture.At(X, Y) = Vector4<float32>(0.0f, 0.0f, 0.0f, 1.0f);
-				impostor_normal_map_texture.At(X, Y) = Vector4<float32>(0.5f, 0.5f, 1.0f, 0.5f);
-				impostor_material_properties_texture.At(X, Y) = Vector4<float32>(1.0f, 0.0f, 1.0f, 0.0f);
-				impostor_opacity_texture.At(X, Y) = Vector4<float32>(0.0f, 0.0f, 0.0f, 1.0f);
+				triangles->Emplace();
+				PathTracingTriangle &triangle{ triangles->Back() };
+
+				triangle._Indices[0] = vertex_offset + mesh._Indices[index + 0];
+				triangle._Indices[1] = vertex_offset + mesh._Indices[index + 1];
+				triangle._Indices[2] = vertex_offset + mesh._Indices[index + 2];
+				triangle._DiscardFunction = parameters._OpacityTextures[mesh_index].GetWidth() > 0 ? ImpostorDiscardFunction : nullptr;
+				triangle._ShadingFunction = nullptr;
+				triangle._UserData.Set<ImpostorTriangleData>(triangle_data);
 			}
 		}
-	}
 
-	//For each texel that is outside the opacity mask, calculate the closest pixel to it to "stretch out" the textures.
-	for (uint32 Y{ 0 }; Y < impostor_opacity_texture.GetHeight(); ++Y)
-	{
-		for (uint32 X{ 0 }; X < impostor_opacity_texture.GetWidth(); ++X)
-		{
-			if (impostor_opacity_texture.At(X, Y)._X < 0.5f)
-			{
-				Vector2<uint32> closest_texel_coordinate{ UINT32_MAXIMUM, UINT32_MAXIMUM };
-				float32 closest_texel_distance{ FLOAT32_MAXIMUM };
+		acceleration_structure.Build(ImpostorMaterialAssetCompilerConstants::MAXIMUM_TRIANGLES_PER_NODE);
+	}
 
-				const Vector2<float32> normalized_coordinate
-				{
-					(static_cast<float32>(X) + 0.5f) / static_cast<float32>(impostor_opacity_texture.GetWidth()),
-					(static_cast<float32>(Y) + 0.5f) / static_cast<float32>(impostor_opacity_texture.GetHeight())
-				};
+	//Create the impostor textures!
+	Texture2D<Vector4<float32>> impostor_albedo_texture{ parameters._Resolution._Width, parameters._Resolution._Height };
+	Texture2D<Vector4<float32>> impostor_normal_map_texture{ parameters._Resolution._Width, parameters._Resolution._Height };
+	Texture2D<Vector4<float32>> impostor_material_properties_texture{ parameters._Resolution._Width, parameters._Resolution._Height };
+	Texture2D<Vector4<float32>> impostor_opacity_texture{ parameters._Resolution._Width, parameters._Resolution._Height };
 
-				for (uint32 _Y{ 0 }; _Y < impostor_opacity_texture.GetHeight(); ++_Y)
-				{
-					for (uint32 _X{ 0 }; _X < impostor_opacity_texture.GetWidth(); ++_X)
-					{
-						if (impostor_opacity_texture.At(_X, _Y)._X >= 0.5f)
-						{
-							const Vector2<float32> _normalized_coordinate
-							{
-								(static_cast<float32>(_X) + 0.5f) / static_cast<float32>(impostor_opacity_texture.GetWidth()),
-								(static_cast<float32>(_Y) + 0.5f) / static_cast<float32>(impostor_opacity_texture.GetHeight())
-							};
-
-							const float32 distance{ Vector2<float32>::LengthSquared(normalized_coordinate - _normalized_coordinate) };
-
-							if (closest_texel_distance > distance)
-							{
-								closest_texel_coordinate = Vector2<uint32>(_X, _Y);
-								closest_texel_distance = distance;
-							}
-						}
-					}
-				}
+	//Set up the bake context.
+	ImpostorBakeContext bake_context;
+
+	bake_context._Parameters = &parameters;
+	bake_context._AccelerationStructure = &acceleration_structure;
+	bake_context._AxisAlignedBoundingBox = axis_aligned_bounding_box;
+	bake_context._ViewResolution._Width = parameters._Resolution._Width / parameters._NumberOfViews;
+	bake_context._ViewResolution._Height = parameters._Resolution._Height / parameters._NumberOfViews;
+	bake_context._NumberOfTilesX = (parameters._Resolution._Width + ImpostorMaterialAssetCompilerConstants::TILE_SIZE - 1) / ImpostorMaterialAssetCompilerConstants::TILE_SIZE;
+	bake_context._NumberOfTilesY = (parameters._Resolution._Height + ImpostorMaterialAssetCompilerConstants::TILE_SIZE - 1) / ImpostorMaterialAssetCompilerConstants::TILE_SIZE;
+	bake_context._AlbedoTexture = &impostor_albedo_texture;
+	bake_context._NormalMapTexture = &impostor_normal_map_texture;
+	bake_context._MaterialPropertiesTexture = &impostor_material_properties_texture;
+	bake_context._OpacityTexture = &impostor_opacity_texture;
+
+	//Cast the rays, tile by tile.
+	TaskSystem::ParallelFor
+	(
+		Task::Priority::LOW,
+		bake_context._NumberOfTilesX * bake_context._NumberOfTilesY,
+		[](void *const RESTRICT arguments, const uint32 index)
+		{
+			BakeTile(*static_cast<const ImpostorBakeContext *const RESTRICT>(arguments), index);
+		},
+		&bake_context
+	);
+
+	//Stretch out the textures into the transparent texels, view by view.
+	TaskSystem::ParallelFor
+	(
+		Task::Priority::LOW,
+		parameters._NumberOfViews * parameters._NumberOfViews,
+		[](void *const RESTRICT arguments, const uint32 index)
+		{
+			DilateView(*static_cast<const ImpostorBakeContext *const RESTRICT>(arguments), index);
+		},
+		&bake_context
+	);
 
-				if (closest_texel_coordinate != Vector2<uint32>(UINT32_MAXIMUM, UINT32_MAXIMUM))
-				{
-					impostor_albedo_texture.At(X, Y) = impostor_albedo_texture.At(closest_texel_coordinate._X, closest_texel_coordinate._Y);
-					impostor_normal_map_texture.At(X, Y) = impostor_normal_map_texture.At(closest_texel_coordinate._X, closest_texel_coordinate._Y);
-					impostor_material_properties_texture.At(X, Y) = impostor_material_properties_texture.At(closest_texel_coordinate._X, closest_texel_coordinate._Y);
-				}
-			}
-		}
+	{
+		const float64 bake_time{ std::chrono::duration<float64>(std::chrono::steady_clock::now() - bake_start_time).count() };
+
+		LOG_INFORMATION
+		(
+			"%s: Baked %ux%u impostor texels in %.3f seconds.",
+			compile_context._Name.Data(),
+			parameters._Resolution._Width,
+			parameters._Resolution._Height,
+			bake_time
+		);
 	}
 
 	//Write out the impostor texture files.
@@ -774,6 +1113,10 @@ void ImpostorMaterialAssetCompiler::Compile(const CompileContext &compile_contex
 			asset_file << "Compression(BC7, true);";
 
 			asset_file.close();
+
+			//Report the outputs.
+			compile_context._Outputs.Emplace(file_buffer);
+			compile_context._Outputs.Emplace(asset_buffer);
 		}
 
 		//Write the normal map texture.
@@ -797,6 +1140,10 @@ void ImpostorMaterialAssetCompiler::Compile(const CompileContext &compile_contex
 			asset_file << "Compression(BC7, false);";
 
 			asset_file.close();
+
+			//Report the outputs.
+			compile_context._Outputs.Emplace(file_buffer);
+			compile_context._Outputs.Emplace(asset_buffer);
 		}
 
 		//Write the material properties texture.
@@ -820,6 +1167,10 @@ void ImpostorMaterialAssetCompiler::Compile(const CompileContext &compile_contex
 			asset_file << "Compression(BC7, false);";
 
 			asset_file.close();
+
+			//Report the outputs.
+			compile_context._Outputs.Emplace(file_buffer);
+			compile_context._Outputs.Emplace(asset_buffer);
 		}
 
 		//Write the opacity texture.
@@ -844,6 +1195,10 @@ void ImpostorMaterialAssetCompiler::Compile(const CompileContext &compile_contex
 			asset_file << "Compression(BC7, false);";
 
 			asset_file.close();
+
+			//Report the outputs.
+			compile_context._Outputs.Emplace(file_buffer);
+			compile_context._Outputs.Emplace(asset_buffer);
 		}
 	}
 
@@ -861,6 +1216,9 @@ void ImpostorMaterialAssetCompiler::Compile(const CompileContext &compile_contex
 		asset_file << "OpacityTexture(" << compile_context._Name.Data() << "_Opacity);" << std::endl;
 
 		asset_file.close();
+
+		//Report the output.
+		compile_context._Outputs.Emplace(asset_buffer);
 	}
 
 	/*
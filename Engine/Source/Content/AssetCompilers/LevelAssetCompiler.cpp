@@ -3,6 +3,11 @@
 
 //Components.
 #include <Components/Core/Component.h>
+#include <Components/Components/WorldTransformComponent.h>
+
+//Core.
+#include <Core/Algorithms/SortingAlgorithms.h>
+#include <Core/General/Pair.h>
 
 //File.
 #include <File/Core/File.h>
@@ -15,6 +20,7 @@
 #include <Profiling/Profiling.h>
 
 //World.
+#include <World/Core/WorldPosition.h>
 #include <World/Core/WorldTransform.h>
 
 //Third party.
@@ -22,6 +28,69 @@
 
 //STL.
 #include <fstream>
+#include <unordered_map>
+
+/*
+*	Level entity class definition.
+*/
+class LevelEntity final
+{
+
+public:
+
+	//The entry.
+	const nlohmann::json *RESTRICT _Entry;
+
+	//The index in the level.
+	uint64 _Index;
+
+	//The world grid cell the entity is in.
+	Vector3<int32> _Cell;
+
+	//Denotes whether or not the entity has a world transform, and thus a cell.
+	bool _IsPlaced;
+
+};
+
+/*
+*	Finds the world grid cell of the given entity entry. Returns if the entity has a world transform.
+*/
+FORCE_INLINE static NO_DISCARD bool FindCell(const nlohmann::json &entity_entry, Vector3<int32> *const RESTRICT cell) NOEXCEPT
+{
+	const nlohmann::json &components{ entity_entry["Components"] };
+
+	if (!components.contains(WorldTransformComponent::Instance->_Name))
+	{
+		return false;
+	}
+
+	const nlohmann::json &component_entry{ components[WorldTransformComponent::Instance->_Name] };
+
+	for (const ComponentEditableField &editable_field : WorldTransformComponent::Instance->EditableFields())
+	{
+		if (editable_field._Type != ComponentEditableField::Type::WORLD_TRANSFORM || !component_entry.contains(editable_field._Name))
+		{
+			continue;
+		}
+
+		//Place the entity the same way the serialized world transform will be.
+		const nlohmann::json &position_entry{ component_entry[editable_field._Name]["Position"] };
+
+		Vector3<float32> position;
+
+		position._X = position_entry["X"];
+		position._Y = position_entry["Y"];
+		position._Z = position_entry["Z"];
+
+		const WorldPosition world_position{ position };
+
+		*cell = world_position.GetCell();
+
+		return true;
+	}
+
+	return false;
+}
 
 /*
 *	Default constructor.
@@ -45,7 +114,7 @@ NO_DISCARD HashString LevelAssetCompiler::AssetTypeIdentifier() const NOEXCEPT
 */
 NO_DISCARD uint64 LevelAssetCompiler::CurrentVersion() const NOEXCEPT
 {
-	return 1;
+	return 3;
 }
 
 /*
@@ -100,8 +169,8 @@ void LevelAssetCompiler::Compile(const CompileContext &compile_context) NOEXCEPT
 	//Cache the entities JSON object.
 	const nlohmann::json &entities{ JSON["Entities"] };
 
-	//Count the number of entities.
-	uint64 number_of_entities{ 0 };
+	//Gather the entities that should be serialized.
+	DynamicArray<LevelEntity> level_entities;
 
 	for (auto entity_iterator{ entities.begin() }; entity_iterator != entities.end(); ++entity_iterator)
 	{
@@ -121,46 +190,91 @@ void LevelAssetCompiler::Compile(const CompileContext &compile_context) NOEXCEPT
 			}
 		}
 
-		if (serialize)
+		if (!serialize)
 		{
-			++number_of_entities;
+			continue;
 		}
-	}
 
+		level_entities.Emplace();
+		LevelEntity &level_entity{ level_entities.Back() };
 
-	//Write the number of entities.
-	stream_archive.Write(&number_of_entities, sizeof(uint64));
+		level_entity._Entry = &entity_entry;
+		level_entity._Index = level_entities.Size() - 1;
+		level_entity._Cell = Vector3<int32>(0, 0, 0);
+		level_entity._IsPlaced = FindCell(entity_entry, &level_entity._Cell);
+	}
 
-	//Write all the entries!
-	for (auto entity_iterator{ entities.begin() }; entity_iterator != entities.end(); ++entity_iterator)
-	{
-		//Cache the entity entry.
-		const nlohmann::json &entity_entry{ *entity_iterator };
+	//Group the entities by cell, with the entities that aren't placed first. Ties keep the order of the level, so compiles are deterministic.
+	SortingAlgorithms::StandardSort<LevelEntity>
+	(
+		level_entities.Begin(),
+		level_entities.End(),
+		nullptr,
+		[](const void *const RESTRICT, const LevelEntity *const RESTRICT first, const LevelEntity *const RESTRICT second)
+		{
+			if (first->_IsPlaced != second->_IsPlaced)
+			{
+				return !first->_IsPlaced;
+			}
 
-		//Figure out if this entity should be serialized.
-		bool serialize{ true };
+			if (first->_Cell._X != second->_Cell._X)
+			{
+				return first->_Cell._X < second->_Cell._X;
+			}
 
-		if (entity_entry.contains("EditorData"))
-		{
-			const nlohmann::json &editor_data_entry{ entity_entry["EditorData"] };
+			if (first->_Cell._Y != second->_Cell._Y)
+			{
+				return first->_Cell._Y < second->_Cell._Y;
+			}
 
-			if (editor_data_entry.contains("Serialize"))
+			if (first->_Cell._Z != second->_Cell._Z)
 			{
-				serialize = editor_data_entry["Serialize"];
+				return first->_Cell._Z < second->_Cell._Z;
 			}
+
+			return first->_Index < second->_Index;
 		}
+	);
 
-		if (!serialize)
+	//Write the number of entities.
+	const uint64 number_of_entities{ level_entities.Size() };
+	stream_archive.Write(&number_of_entities, sizeof(uint64));
+
+	//Write all the entries, starting a new cell whenever the cell changes. Remembers the cell and the index within the cell of every entity, for grouping the entity links.
+	DynamicArray<LevelAsset::Cell> cells;
+	std::unordered_map<uint64, Pair<uint64, uint64>> entity_locations;
+
+	for (uint64 i{ 0 }; i < level_entities.Size(); ++i)
+	{
+		const LevelEntity &level_entity{ level_entities[i] };
+
+		if (i == 0
+			|| level_entity._IsPlaced != level_entities[i - 1]._IsPlaced
+			|| level_entity._Cell != level_entities[i - 1]._Cell)
 		{
-			continue;
+			cells.Emplace();
+			LevelAsset::Cell &cell{ cells.Back() };
+
+			cell._Cell = level_entity._Cell;
+			cell._AlwaysResident = !level_entity._IsPlaced;
+			cell._NumberOfEntities = 0;
+			cell._StreamArchivePosition = stream_archive.Size();
+			cell._StreamArchiveSize = 0;
+			cell._EntityLinksPosition = 0;
+			cell._NumberOfEntityLinks = 0;
 		}
 
 		//Write the identifier.
-		const uint64 identifier{ entity_entry["Identifier"] };
+		const uint64 identifier{ (*level_entity._Entry)["Identifier"] };
 		stream_archive.Write(&identifier, sizeof(uint64));
 
 		//Serialize to the stream archive.
-		EntitySerialization::SerializeToStreamArchive(entity_entry, &stream_archive);
+		EntitySerialization::SerializeToStreamArchive(*level_entity._Entry, &stream_archive);
+
+		entity_locations[identifier] = Pair<uint64, uint64>(cells.LastIndex(), cells.Back()._NumberOfEntities);
+
+		++cells.Back()._NumberOfEntities;
+		cells.Back()._StreamArchiveSize = stream_archive.Size() - cells.Back()._StreamArchivePosition;
 	}
 
 	//Serialize entity links.
@@ -184,6 +298,50 @@ void LevelAssetCompiler::Compile(const CompileContext &compile_context) NOEXCEPT
 		}
 	}
 
+	/*
+	*	Serialize the entity links again, grouped by cell, as pairs of indices into the cell's entities.
+	*	This lets streaming set up the links of a cell without going through all links of the level.
+	*	Links across cells are left out, as the entities on the other end might not be resident.
+	*/
+	{
+		DynamicArray<DynamicArray<uint64>> cell_entity_links;
+		cell_entity_links.Upsize<true>(cells.Size());
+
+		for (const nlohmann::json &entity_link : JSON["EntityLinks"])
+		{
+			const uint64 from{ entity_link["From"] };
+			const uint64 to{ entity_link["To"] };
+
+			const auto from_iterator{ entity_locations.find(from) };
+			const auto to_iterator{ entity_locations.find(to) };
+
+			if (from_iterator == entity_locations.end()
+				|| to_iterator == entity_locations.end()
+				|| from_iterator->second._First != to_iterator->second._First)
+			{
+				continue;
+			}
+
+			DynamicArray<uint64> &entity_links{ cell_entity_links[from_iterator->second._First] };
+
+			entity_links.Emplace(from_iterator->second._Second);
+			entity_links.Emplace(to_iterator->second._Second);
+		}
+
+		for (uint64 cell_index{ 0 }; cell_index < cells.Size(); ++cell_index)
+		{
+			const DynamicArray<uint64> &entity_links{ cell_entity_links[cell_index] };
+
+			cells[cell_index]._EntityLinksPosition = stream_archive.Size();
+			cells[cell_index]._NumberOfEntityLinks = entity_links.Size() / 2;
+
+			if (!entity_links.Empty())
+			{
+				stream_archive.Write(entity_links.Data(), sizeof(uint64) * entity_links.Size());
+			}
+		}
+	}
+
 	//Determine the collection directory.
 	char collection_directory_path[MAXIMUM_FILE_PATH_LENGTH];
 
@@ -221,6 +379,11 @@ void LevelAssetCompiler::Compile(const CompileContext &compile_context) NOEXCEPT
 	//Write the level statistics.
 	output_file.Write(&level_statistics, sizeof(LevelStatistics));
 
+	//Write the cells.
+	const uint64 number_of_cells{ cells.Size() };
+	output_file.Write(&number_of_cells, sizeof(uint64));
+	output_file.Write(cells.Data(), sizeof(LevelAsset::Cell) * number_of_cells);
+
 	//Write the stream archive size.
 	const uint64 stream_archive_size{ stream_archive.Size() };
 	output_file.Write(&stream_archive_size, sizeof(uint64));
@@ -230,6 +393,9 @@ void LevelAssetCompiler::Compile(const CompileContext &compile_context) NOEXCEPT
 
 	//Close the output file.
 	output_file.Close();
+
+	//Report the output.
+	compile_context._Outputs.Emplace(output_file_path);
 }
 
 /*
@@ -248,6 +414,13 @@ void LevelAssetCompiler::Load(const LoadContext &load_context) NOEXCEPT
 	//Read the level statistics.
 	load_context._StreamArchive->Read(&new_asset->_LevelStatistics, sizeof(LevelStatistics), &stream_archive_position);
 
+	//Read the cells.
+	uint64 number_of_cells;
+	load_context._StreamArchive->Read(&number_of_cells, sizeof(uint64), &stream_archive_position);
+
+	new_asset->_Cells.Upsize<false>(number_of_cells);
+	load_context._StreamArchive->Read(new_asset->_Cells.Data(), sizeof(LevelAsset::Cell) * number_of_cells, &stream_archive_position);
+
 	//Read the stream archive size.
 	uint64 stream_archive_size;
 	load_context._StreamArchive->Read(&stream_archive_size, sizeof(uint64), &stream_archive_position);
@@ -529,6 +529,9 @@ void MaterialAssetCompiler::Compile(const CompileContext &compile_context) NOEXC
 
 	//Close the output file.
 	output_file.Close();
+
+	//Report the output.
+	compile_context._Outputs.Emplace(output_file_path);
 }
 
 /*
@@ -10,6 +10,9 @@
 //Profiling.
 #include <Profiling/Profiling.h>
 
+//Rendering.
+#include <Rendering/Native/MeshOptimization.h>
+
 //Systems.
 #include <Systems/ContentSystem.h>
 #include <Systems/LogSystem.h>
@@ -20,6 +23,32 @@
 #include <fstream>
 #include <string>
 
+//Model asset compiler constants.
+namespace ModelAssetCompilerConstants
+{
+	//How much the average cache miss ratio is allowed to get worse when optimizing for overdraw.
+	constexpr float32 OVERDRAW_THRESHOLD{ 1.05f };
+
+	//The maximum number of vertices for a mesh to use 16-bit indices on disk.
+	constexpr uint64 MAXIMUM_NUMBER_OF_VERTICES_FOR_16_BIT_INDICES{ 65'536 };
+}
+
+/*
+*	Automatic level of detail class definition.
+*/
+class AutomaticLevelOfDetail final
+{
+
+public:
+
+	//The ratio of triangles to keep, relative to the first level of detail.
+	float32 _Ratio;
+
+	//The maximum error, relative to the size of the mesh.
+	float32 _Error;
+
+};
+
 /*
 *	Model parameters class definition.
 */
@@ -31,6 +60,9 @@ public:
 	//The level of details.
 	DynamicArray<StaticString<MAXIMUM_FILE_PATH_LENGTH>> _LevelOfDetails;
 
+	//The automatic level of details, generated from the first level of detail.
+	DynamicArray<AutomaticLevelOfDetail> _AutomaticLevelOfDetails;
+
 	//The default materials.
 	StaticArray<HashString, RenderingConstants::MAXIMUM_NUMBER_OF_MESHES_PER_MODEL> _DefaultMaterials;
 
@@ -43,6 +75,12 @@ public:
 	//Denotes whether or not to apply quixel transformation.
 	bool _QuixelTransformation;
 
+	//Denotes whether or not to optimize the meshes.
+	bool _OptimizeMeshes;
+
+	//Denotes whether or not to quantize the vertices. Off by default, since it's lossy and only saves disk space.
+	bool _QuantizeVertices;
+
 };
 
 /*
@@ -72,6 +110,8 @@ NO_DISCARD uint64 ModelAssetCompiler::CurrentVersion() const NOEXCEPT
 	{
 		DEFAULT,
 		ADD_DEFAULT_MATERIALS,
+		OPTIMIZED_MESHES,
+		MODEL_QUANTIZATION_BOUNDS,
 
 		CURRENT_VERSION
 	};
@@ -93,6 +133,8 @@ void ModelAssetCompiler::Compile(const CompileContext &compile_context) NOEXCEPT
 	Memory::Set(parameters._DefaultMaterials.Data(), 0, sizeof(HashString) * RenderingConstants::MAXIMUM_NUMBER_OF_MESHES_PER_MODEL);
 	parameters._LevelOfDetailMultiplier = 32.0f;
 	parameters._QuixelTransformation = false;
+	parameters._OptimizeMeshes = true;
+	parameters._QuantizeVertices = false;
 
 	//Open the input file.
 	std::ifstream input_file{ compile_context._FilePath.Data() };
@@ -104,6 +146,35 @@ void ModelAssetCompiler::Compile(const CompileContext &compile_context) NOEXCEPT
 
 		while (std::getline(input_file, current_line))
 		{
+			//Is this an automatic level of detail declaration?
+			{
+				const size_t position{ current_line.find("AutomaticLevelOfDetail(") };
+
+				if (position != std::string::npos)
+				{
+					const uint64 number_of_arguments
+					{
+						TextParsingUtilities::ParseFunctionArguments
+						(
+							current_line.c_str(),
+							current_line.length(),
+							arguments.Data()
+						)
+					};
+
+					ASSERT(number_of_arguments == 2, "AutomaticLevelOfDetail() needs two arguments!");
+
+					AutomaticLevelOfDetail automatic_level_of_detail;
+
+					automatic_level_of_detail._Ratio = std::stof(arguments[0].Data());
+					automatic_level_of_detail._Error = std::stof(arguments[1].Data());
+
+					parameters._AutomaticLevelOfDetails.Emplace(automatic_level_of_detail);
+
+					continue;
+				}
+			}
+
 			//Is this a level of detail declaration?
 			{
 				const size_t position{ current_line.find("LevelOfDetail(") };
@@ -212,6 +283,30 @@ void ModelAssetCompiler::Compile(const CompileContext &compile_context) NOEXCEPT
 				}
 			}
 
+			//Is this a disable mesh optimization declaration?
+			{
+				const size_t position{ current_line.find("DisableMeshOptimization()") };
+
+				if (position != std::string::npos)
+				{
+					parameters._OptimizeMeshes = false;
+
+					continue;
+				}
+			}
+
+			//Is this a quantize vertices declaration?
+			{
+				const size_t position{ current_line.find("QuantizeVertices()") };
+
+				if (position != std::string::npos)
+				{
+					parameters._QuantizeVertices = true;
+
+					continue;
+				}
+			}
+
 			//Couldn't figure out what this line is?
 			ASSERT(false, "Unknown line %s", current_line.c_str());
 		}
@@ -280,6 +375,82 @@ void ModelAssetCompiler::Compile(const CompileContext &compile_context) NOEXCEPT
 		}
 	}
 
+	//Generate the automatic level of details and optimize the meshes.
+	uint64 unoptimized_size{ 0 };
+	float32 unoptimized_average_cache_miss_ratio{ 0.0f };
+
+	for (const ModelFile::Mesh &mesh : model_files[0]._Meshes)
+	{
+		unoptimized_average_cache_miss_ratio += MeshOptimization::AverageCacheMissRatio(mesh._Indices, mesh._Vertices.Size()) / static_cast<float32>(model_files[0]._Meshes.Size());
+	}
+
+	for (const ModelFile &model_file : model_files)
+	{
+		for (const ModelFile::Mesh &mesh : model_file._Meshes)
+		{
+			unoptimized_size += sizeof(Vertex) * mesh._Vertices.Size() + sizeof(uint32) * mesh._Indices.Size();
+		}
+	}
+
+	if (parameters._OptimizeMeshes)
+	{
+		for (ModelFile &model_file : model_files)
+		{
+			for (ModelFile::Mesh &mesh : model_file._Meshes)
+			{
+				MeshOptimization::DeduplicateVertices(&mesh._Vertices, &mesh._Indices);
+			}
+		}
+	}
+
+	for (const AutomaticLevelOfDetail &automatic_level_of_detail : parameters._AutomaticLevelOfDetails)
+	{
+		model_files.Emplace();
+		ModelFile &generated_model_file{ model_files.Back() };
+
+		generated_model_file._Meshes.Upsize<true>(model_files[0]._Meshes.Size());
+
+		for (uint64 mesh_index{ 0 }; mesh_index < model_files[0]._Meshes.Size(); ++mesh_index)
+		{
+			const ModelFile::Mesh &source_mesh{ model_files[0]._Meshes[mesh_index] };
+			ModelFile::Mesh &generated_mesh{ generated_model_file._Meshes[mesh_index] };
+
+			const uint64 target_number_of_indices{ static_cast<uint64>(static_cast<float32>(source_mesh._Indices.Size() / 3) * automatic_level_of_detail._Ratio) * 3 };
+
+			const float32 reached_error{ MeshOptimization::Simplify(source_mesh._Vertices, source_mesh._Indices, target_number_of_indices, automatic_level_of_detail._Error, &generated_mesh._Indices) };
+
+			generated_mesh._Name = source_mesh._Name;
+			generated_mesh._Vertices = source_mesh._Vertices;
+
+			//The simplified indices reference the original vertices, so trim away the unused ones.
+			MeshOptimization::OptimizeVertexFetch(&generated_mesh._Vertices, &generated_mesh._Indices);
+
+			LOG_INFORMATION
+			(
+				"Generated level of detail %llu for mesh %llu of %s: %llu -> %llu triangles, error %.4f",
+				model_files.Size() - 1,
+				mesh_index,
+				compile_context._Name.Data(),
+				source_mesh._Indices.Size() / 3,
+				generated_mesh._Indices.Size() / 3,
+				reached_error
+			);
+		}
+	}
+
+	if (parameters._OptimizeMeshes)
+	{
+		for (ModelFile &model_file : model_files)
+		{
+			for (ModelFile::Mesh &mesh : model_file._Meshes)
+			{
+				MeshOptimization::OptimizeVertexCache(&mesh._Indices, mesh._Vertices.Size());
+				MeshOptimization::OptimizeOverdraw(mesh._Vertices, &mesh._Indices, ModelAssetCompilerConstants::OVERDRAW_THRESHOLD);
+				MeshOptimization::OptimizeVertexFetch(&mesh._Vertices, &mesh._Indices);
+			}
+		}
+	}
+
 	//Determine the model space axis aligned bounding box.
 	{
 		//Iterate over all vertices in all meshes and expand the bounding box.
@@ -309,27 +480,106 @@ void ModelAssetCompiler::Compile(const CompileContext &compile_context) NOEXCEPT
 	const uint64 number_of_level_of_details{ model_files.Size() };
 	output_file.Write(&number_of_level_of_details, sizeof(uint64));
 
+	//Write whether or not the vertices are quantized.
+	output_file.Write(&parameters._QuantizeVertices, sizeof(bool));
+
+	//Write the quantization bounds. These cover the whole model, so vertices shared between meshes end up in the same place.
+	QuantizationBounds quantization_bounds;
+
+	if (parameters._QuantizeVertices)
+	{
+		for (const ModelFile &model_file : model_files)
+		{
+			for (const ModelFile::Mesh &mesh : model_file._Meshes)
+			{
+				MeshOptimization::ExpandQuantizationBounds(mesh._Vertices, &quantization_bounds);
+			}
+		}
+
+		output_file.Write(&quantization_bounds, sizeof(QuantizationBounds));
+	}
+
 	//Process each mesh individually.
+	uint64 optimized_size{ 0 };
+
 	for (uint64 mesh_index{ 0 }; mesh_index < number_of_meshes; ++mesh_index)
 	{
 		for (uint64 level_of_detail_index{ 0 }; level_of_detail_index < number_of_level_of_details; ++level_of_detail_index)
 		{
+			const ModelFile::Mesh &mesh{ model_files[level_of_detail_index]._Meshes[mesh_index] };
+
 			//Write the number of vertices to the file.
-			const uint64 number_of_vertices{ model_files[level_of_detail_index]._Meshes[mesh_index]._Vertices.Size() };
+			const uint64 number_of_vertices{ mesh._Vertices.Size() };
 			output_file.Write(&number_of_vertices, sizeof(uint64));
 
 			//Write the vertices to the file.
-			output_file.Write(model_files[level_of_detail_index]._Meshes[mesh_index]._Vertices.Data(), sizeof(Vertex) * number_of_vertices);
+			if (parameters._QuantizeVertices)
+			{
+				DynamicArray<QuantizedVertex> quantized_vertices;
+
+				MeshOptimization::Quantize(mesh._Vertices, quantization_bounds, &quantized_vertices);
+
+				output_file.Write(quantized_vertices.Data(), sizeof(QuantizedVertex) * number_of_vertices);
+
+				optimized_size += sizeof(QuantizedVertex) * number_of_vertices;
+			}
+
+			else
+			{
+				output_file.Write(mesh._Vertices.Data(), sizeof(Vertex) * number_of_vertices);
+
+				optimized_size += sizeof(Vertex) * number_of_vertices;
+			}
 
 			//Write the number of indices to the file.
-			const uint64 number_of_indices{ model_files[level_of_detail_index]._Meshes[mesh_index]._Indices.Size() };
+			const uint64 number_of_indices{ mesh._Indices.Size() };
 			output_file.Write(&number_of_indices, sizeof(uint64));
 
-			//Write the vertices to the file.
-			output_file.Write(model_files[level_of_detail_index]._Meshes[mesh_index]._Indices.Data(), sizeof(uint32) * number_of_indices);
+			//Write the indices to the file. Small meshes store 16-bit indices.
+			if (number_of_vertices <= ModelAssetCompilerConstants::MAXIMUM_NUMBER_OF_VERTICES_FOR_16_BIT_INDICES)
+			{
+				DynamicArray<uint16> narrow_indices;
+				narrow_indices.Upsize<false>(number_of_indices);
+
+				for (uint64 i{ 0 }; i < number_of_indices; ++i)
+				{
+					narrow_indices[i] = static_cast<uint16>(mesh._Indices[i]);
+				}
+
+				output_file.Write(narrow_indices.Data(), sizeof(uint16) * number_of_indices);
+
+				optimized_size += sizeof(uint16) * number_of_indices;
+			}
+
+			else
+			{
+				output_file.Write(mesh._Indices.Data(), sizeof(uint32) * number_of_indices);
+
+				optimized_size += sizeof(uint32) * number_of_indices;
+			}
 		}
 	}
 
+	//Log the results of the optimization.
+	{
+		float32 optimized_average_cache_miss_ratio{ 0.0f };
+
+		for (const ModelFile::Mesh &mesh : model_files[0]._Meshes)
+		{
+			optimized_average_cache_miss_ratio += MeshOptimization::AverageCacheMissRatio(mesh._Indices, mesh._Vertices.Size()) / static_cast<float32>(model_files[0]._Meshes.Size());
+		}
+
+		LOG_INFORMATION
+		(
+			"Compiled model %s: %llu bytes -> %llu bytes of mesh data, average cache miss ratio %.3f -> %.3f",
+			compile_context._Name.Data(),
+			unoptimized_size,
+			optimized_size,
+			unoptimized_average_cache_miss_ratio,
+			optimized_average_cache_miss_ratio
+		);
+	}
+
 	//Write the default materials.
 	output_file.Write(parameters._DefaultMaterials.Data(), sizeof(HashString) * RenderingConstants::MAXIMUM_NUMBER_OF_MESHES_PER_MODEL);
 
@@ -384,6 +634,9 @@ void ModelAssetCompiler::Compile(const CompileContext &compile_context) NOEXCEPT
 
 	//Close the output file.
 	output_file.Close();
+
+	//Report the output.
+	compile_context._Outputs.Emplace(output_file_path);
 }
 
 /*
@@ -415,6 +668,18 @@ void ModelAssetCompiler::Load(const LoadContext &load_context) NOEXCEPT
 	uint64 number_of_level_of_details;
 	load_context._StreamArchive->Read(&number_of_level_of_details, sizeof(uint64), &stream_archive_position);
 
+	//Read whether or not the vertices are quantized.
+	bool quantized_vertices;
+	load_context._StreamArchive->Read(&quantized_vertices, sizeof(bool), &stream_archive_position);
+
+	//Read the quantization bounds.
+	QuantizationBounds quantization_bounds;
+
+	if (quantized_vertices)
+	{
+		load_context._StreamArchive->Read(&quantization_bounds, sizeof(QuantizationBounds), &stream_archive_position);
+	}
+
 	//Set up the vertices/indices.
 	DynamicArray<DynamicArray<DynamicArray<Vertex>>> vertices;
 	DynamicArray<DynamicArray<DynamicArray<uint32>>> indices;
@@ -422,6 +687,9 @@ void ModelAssetCompiler::Load(const LoadContext &load_context) NOEXCEPT
 	vertices.Upsize<true>(number_of_meshes);
 	indices.Upsize<true>(number_of_meshes);
 
+	DynamicArray<QuantizedVertex> quantized_vertex_data;
+	DynamicArray<uint16> narrow_indices;
+
 	for (uint64 mesh_index{ 0 }; mesh_index < number_of_meshes; ++mesh_index)
 	{
 		vertices[mesh_index].Upsize<true>(number_of_level_of_details);
@@ -435,15 +703,42 @@ void ModelAssetCompiler::Load(const LoadContext &load_context) NOEXCEPT
 
 			//Read the vertices.
 			vertices[mesh_index][j].Upsize<false>(number_of_vertices);
-			load_context._StreamArchive->Read(vertices[mesh_index][j].Data(), sizeof(Vertex) * number_of_vertices, &stream_archive_position);
+
+			if (quantized_vertices)
+			{
+				quantized_vertex_data.Resize<false>(number_of_vertices);
+				load_context._StreamArchive->Read(quantized_vertex_data.Data(), sizeof(QuantizedVertex) * number_of_vertices, &stream_archive_position);
+
+				MeshOptimization::Dequantize(quantized_vertex_data.Data(), number_of_vertices, quantization_bounds, vertices[mesh_index][j].Data());
+			}
+
+			else
+			{
+				load_context._StreamArchive->Read(vertices[mesh_index][j].Data(), sizeof(Vertex) * number_of_vertices, &stream_archive_position);
+			}
 
 			//Read the number of indices.
 			uint64 number_of_indices;
 			load_context._StreamArchive->Read(&number_of_indices, sizeof(uint64), &stream_archive_position);
 
-			//Read the indices.
+			//Read the indices. Small meshes store 16-bit indices.
 			indices[mesh_index][j].Upsize<false>(number_of_indices);
-			load_context._StreamArchive->Read(indices[mesh_index][j].Data(), sizeof(uint32) * number_of_indices, &stream_archive_position);
+
+			if (number_of_vertices <= ModelAssetCompilerConstants::MAXIMUM_NUMBER_OF_VERTICES_FOR_16_BIT_INDICES)
+			{
+				narrow_indices.Resize<false>(number_of_indices);
+				load_context._StreamArchive->Read(narrow_indices.Data(), sizeof(uint16) * number_of_indices, &stream_archive_position);
+
+				for (uint64 i{ 0 }; i < number_of_indices; ++i)
+				{
+					indices[mesh_index][j][i] = narrow_indices[i];
+				}
+			}
+
+			else
+			{
+				load_context._StreamArchive->Read(indices[mesh_index][j].Data(), sizeof(uint32) * number_of_indices, &stream_archive_position);
+			}
 		}
 	}
 
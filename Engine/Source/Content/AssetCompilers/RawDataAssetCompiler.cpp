@@ -159,6 +159,9 @@ void RawDataAssetCompiler::Compile(const CompileContext &compile_context) NOEXCE
 
 	//Close the output file.
 	output_file.Close();
+
+	//Report the output.
+	compile_context._Outputs.Emplace(output_file_path);
 }
 
 /*
@@ -3,6 +3,7 @@
 
 //Core.
 #include <Core/General/Pair.h>
+#include <Core/General/StringBuilder.h>
 
 //File.
 #include <File/Core/File.h>
@@ -21,6 +22,7 @@
 #include <Systems/TaskSystem.h>
 
 //STD.
+#include <chrono>
 #include <filesystem>
 #include <fstream>
 #include <string>
@@ -32,6 +34,38 @@
 #define COMPILE_SINGLE_THREADED (0)
 #define LOAD_SINGLE_THREADED (0)
 
+/*
+*	Shader compilation class definition.
+*	Holds everything needed to compile a single shader stage on a task.
+*/
+class ShaderCompilation final
+{
+
+public:
+
+	//The shader stage.
+	ShaderStage _ShaderStage;
+
+	//The GLSL lines.
+	DynamicArray<DynamicString> _Lines;
+
+	//The input file path.
+	StaticString<MAXIMUM_FILE_PATH_LENGTH> _InputFilePath;
+
+	//The cache directory path.
+	StaticString<MAXIMUM_FILE_PATH_LENGTH> _CacheDirectoryPath;
+
+	//The output data.
+	DynamicArray<byte> _OutputData;
+
+	//Denotes whether or not the shader was read from the cache.
+	bool _CacheHit;
+
+	//Denotes whether or not the shader compiled successfully.
+	bool _Succeeded;
+
+};
+
 /*
 *	Extra data class definition.
 */
@@ -571,6 +605,32 @@ FORCE_INLINE NO_DISCARD const char *const RESTRICT ShaderStageString(const Shade
 	return "";
 }
 
+/*
+*	Replaces all occurences of the given pattern in the given line with the given replacement.
+*/
+FORCE_INLINE void ReplaceAll(DynamicString *const RESTRICT line, const char *const RESTRICT pattern, const char *const RESTRICT replacement) NOEXCEPT
+{
+	const uint64 pattern_length{ StringUtilities::StringLength(pattern) };
+
+	//Almost all lines fit on the stack.
+	char buffer[256];
+	StringBuilder builder{ buffer };
+
+	const char *RESTRICT current{ line->Data() };
+
+	for (const char *RESTRICT occurence{ strstr(current, pattern) }; occurence; occurence = strstr(current, pattern))
+	{
+		builder.Append(current, occurence - current);
+		builder.Append(replacement);
+
+		current = occurence + pattern_length;
+	}
+
+	builder.Append(current);
+
+	*line = DynamicString(builder.Data(), builder.Length());
+}
+
 /*
 *	Shader stage lines class definition.
 */
@@ -677,8 +737,13 @@ void RenderPipelineAssetCompiler::Compile(const CompileContext &compile_context)
 	DynamicArray<ShaderStageLines> shader_stages;
 	SplitShaderStages(lines, &shader_stages);
 
-	//Compile the GLSL shaders.
-	CompileGLSLShaders(compile_context, &extra_data, shader_stages);
+	//Compile the GLSL shaders. If any of them failed, don't write the asset, so the previously compiled one stays in place.
+	if (!CompileGLSLShaders(compile_context, &extra_data, shader_stages))
+	{
+		compile_context._Failed = true;
+
+		return;
+	}
 
 	//Determine the collection directory.
 	char collection_directory_path[MAXIMUM_FILE_PATH_LENGTH];
@@ -886,6 +951,9 @@ void RenderPipelineAssetCompiler::Compile(const CompileContext &compile_context)
 
 	//Close the output file.
 	output_file.Close();
+
+	//Report the output.
+	compile_context._Outputs.Emplace(output_file_path);
 }
 
 /*
@@ -1111,7 +1179,7 @@ void RenderPipelineAssetCompiler::RetrieveLines(const char *const RESTRICT file_
 
 	while (std::getline(file, line))
 	{
-		lines->Emplace(line.c_str());
+		lines->Emplace(line.data(), line.size());
 	}
 
 	file.close();
@@ -1252,7 +1320,15 @@ void RenderPipelineAssetCompiler::ResolveInclude
 		lines->At(current_line_index + include_index) = include_lines.At(include_index);
 	}
 
-	//Add the dependency.
+	//Add the dependency, if it's not already added. The same file is usually included from multiple shader stages.
+	for (const StaticString<MAXIMUM_FILE_PATH_LENGTH> &dependency : compile_context._Dependencies)
+	{
+		if (dependency == file_path)
+		{
+			return;
+		}
+	}
+
 	compile_context._Dependencies.Emplace(file_path);
 }
 
@@ -2864,9 +2940,9 @@ void RenderPipelineAssetCompiler::SplitShaderStages(const DynamicArray<DynamicSt
 }
 
 /*
-*	Compiles GLSL shaders.
+*	Compiles GLSL shaders. Returns if all shader stages compiled successfully.
 */
-void RenderPipelineAssetCompiler::CompileGLSLShaders
+NO_DISCARD bool RenderPipelineAssetCompiler::CompileGLSLShaders
 (
 	const CompileContext &compile_context,
 	ExtraData *const RESTRICT extra_data,
@@ -3127,9 +3203,19 @@ void RenderPipelineAssetCompiler::CompileGLSLShaders
 	uint32 current_ray_closest_hit_index{ UINT32_MAXIMUM };
 	uint32 current_ray_miss_index{ UINT32_MAXIMUM };
 
-	//Compile all shader stages.
-	for (const ShaderStageLines &shader_stage : shader_stages)
+	//Retrieve the directory of the SPIR-V cache.
+	char cache_directory_path[MAXIMUM_FILE_PATH_LENGTH];
+	sprintf_s(cache_directory_path, "%s\\..\\ShaderCache", GetCompiledDirectoryPath(compile_context._CompilationDomain));
+
+	//Set up one compilation per shader stage. The GLSL is generated here, the compilations run in parallel below.
+	DynamicArray<ShaderCompilation> compilations;
+	compilations.Upsize<true>(shader_stages.Size());
+
+	for (uint64 shader_stage_index{ 0 }; shader_stage_index < shader_stages.Size(); ++shader_stage_index)
 	{
+		const ShaderStageLines &shader_stage{ shader_stages[shader_stage_index] };
+		ShaderCompilation &compilation{ compilations[shader_stage_index] };
+
 		//Increment the current ray tracing indices.
 		switch (shader_stage._ShaderStage)
 		{
@@ -3156,7 +3242,7 @@ void RenderPipelineAssetCompiler::CompileGLSLShaders
 		}
 
 		//Create a separate set of the GLSL-ified lines.
-		DynamicArray<DynamicString> glsl_lines;
+		DynamicArray<DynamicString> &glsl_lines{ compilation._Lines };
 
 		//Insert the version.
 		glsl_lines.Emplace("#version 460");
@@ -3816,17 +3902,7 @@ void RenderPipelineAssetCompiler::CompileGLSLShaders
 			//Replace "COMPUTE_GLOBAL_ID" with "gl_GlobalInvocationID".
 			if (current_line.Find("COMPUTE_GLOBAL_ID"))
 			{
-				std::string _current_line{ current_line.Data() };
-
-				size_t position{ _current_line.find("COMPUTE_GLOBAL_ID") };
-
-				while (position != std::string::npos)
-				{
-					_current_line.replace(position, strlen("COMPUTE_GLOBAL_ID"), "gl_GlobalInvocationID");
-					position = _current_line.find("COMPUTE_GLOBAL_ID");
-				}
-
-				current_line = _current_line.c_str();
+				ReplaceAll(&current_line, "COMPUTE_GLOBAL_ID", "gl_GlobalInvocationID");
 			}
 
 			//Handle compute render targets.
@@ -3903,81 +3979,31 @@ void RenderPipelineAssetCompiler::CompileGLSLShaders
 			//Replace "FRAGMENT_COORDINATE" with "gl_FragCoord".
 			if (current_line.Find("FRAGMENT_COORDINATE"))
 			{
-				std::string _current_line{ current_line.Data() };
-
-				size_t position{ _current_line.find("FRAGMENT_COORDINATE") };
-
-				while (position != std::string::npos)
-				{
-					_current_line.replace(position, strlen("FRAGMENT_COORDINATE"), "gl_FragCoord");
-					position = _current_line.find("FRAGMENT_COORDINATE");
-				}
-
-				current_line = _current_line.c_str();
+				ReplaceAll(&current_line, "FRAGMENT_COORDINATE", "gl_FragCoord");
 			}
 
 			//Replace "FRAGMENT_FRONT_FACING" with "gl_FrontFacing".
 			if (current_line.Find("FRAGMENT_FRONT_FACING"))
 			{
-				std::string _current_line{ current_line.Data() };
-
-				size_t position{ _current_line.find("FRAGMENT_FRONT_FACING") };
-
-				while (position != std::string::npos)
-				{
-					_current_line.replace(position, strlen("FRAGMENT_FRONT_FACING"), "gl_FrontFacing");
-					position = _current_line.find("FRAGMENT_FRONT_FACING");
-				}
-
-				current_line = _current_line.c_str();
+				ReplaceAll(&current_line, "FRAGMENT_FRONT_FACING", "gl_FrontFacing");
 			}
 
 			//Replace "IgnoreHit()" with "ignoreIntersectionNV()".
 			if (current_line.Find("IgnoreHit()"))
 			{
-				std::string _current_line{ current_line.Data() };
-
-				size_t position{ _current_line.find("IgnoreHit()") };
-
-				while (position != std::string::npos)
-				{
-					_current_line.replace(position, strlen("IgnoreHit()"), "ignoreIntersectionNV()");
-					position = _current_line.find("IgnoreHit()");
-				}
-
-				current_line = _current_line.c_str();
+				ReplaceAll(&current_line, "IgnoreHit()", "ignoreIntersectionNV()");
 			}
 
 			//Replace "ImageLoad" with "imageLoad".
 			if (current_line.Find("ImageLoad"))
 			{
-				std::string _current_line{ current_line.Data() };
-
-				size_t position{ _current_line.find("ImageLoad") };
-
-				while (position != std::string::npos)
-				{
-					_current_line.replace(position, strlen("ImageLoad"), "imageLoad");
-					position = _current_line.find("ImageLoad");
-				}
-
-				current_line = _current_line.c_str();
+				ReplaceAll(&current_line, "ImageLoad", "imageLoad");
 			}
 
 			//Replace "ImageStore" with "imageStore".
 			if (current_line.Find("ImageStore"))
 			{
-				std::string _current_line{ current_line.Data() };
-
-				size_t position{ _current_line.find("ImageStore") };
-
-				while (position != std::string::npos)
-				{
-					_current_line.replace(position, strlen("ImageStore"), "imageStore");
-					position = _current_line.find("ImageStore");
-				}
-
-				current_line = _current_line.c_str();
+				ReplaceAll(&current_line, "ImageStore", "imageStore");
 			}
 
 			//Handle input render targets.
@@ -4007,17 +4033,7 @@ void RenderPipelineAssetCompiler::CompileGLSLShaders
 			//Replace "INSTANCE_INDEX" with "gl_InstanceIndex".
 			if (current_line.Find("INSTANCE_INDEX"))
 			{
-				std::string _current_line{ current_line.Data() };
-
-				size_t position{ _current_line.find("INSTANCE_INDEX") };
-
-				while (position != std::string::npos)
-				{
-					_current_line.replace(position, strlen("INSTANCE_INDEX"), "gl_InstanceIndex");
-					position = _current_line.find("INSTANCE_INDEX");
-				}
-
-				current_line = _current_line.c_str();
+				ReplaceAll(&current_line, "INSTANCE_INDEX", "gl_InstanceIndex");
 			}
 
 			//Handle fragment outputs.
@@ -4104,81 +4120,31 @@ void RenderPipelineAssetCompiler::CompileGLSLShaders
 			//Replace "RAY_HIT_DISTANCE" with "gl_HitTNV".
 			if (current_line.Find("RAY_HIT_DISTANCE"))
 			{
-				std::string _current_line{ current_line.Data() };
-
-				size_t position{ _current_line.find("RAY_HIT_DISTANCE") };
-
-				while (position != std::string::npos)
-				{
-					_current_line.replace(position, strlen("RAY_HIT_DISTANCE"), "gl_HitTNV");
-					position = _current_line.find("RAY_HIT_DISTANCE");
-				}
-
-				current_line = _current_line.c_str();
+				ReplaceAll(&current_line, "RAY_HIT_DISTANCE", "gl_HitTNV");
 			}
 
 			//Replace "RAY_TRACING_ID" with "gl_LaunchIDNV".
 			if (current_line.Find("RAY_TRACING_ID"))
 			{
-				std::string _current_line{ current_line.Data() };
-
-				size_t position{ _current_line.find("RAY_TRACING_ID") };
-
-				while (position != std::string::npos)
-				{
-					_current_line.replace(position, strlen("RAY_TRACING_ID"), "gl_LaunchIDNV");
-					position = _current_line.find("RAY_TRACING_ID");
-				}
-
-				current_line = _current_line.c_str();
+				ReplaceAll(&current_line, "RAY_TRACING_ID", "gl_LaunchIDNV");
 			}
 
 			//Replace "RAY_TRACING_SIZE" with "gl_LaunchSizeNV".
 			if (current_line.Find("RAY_TRACING_SIZE"))
 			{
-				std::string _current_line{ current_line.Data() };
-
-				size_t position{ _current_line.find("RAY_TRACING_SIZE") };
-
-				while (position != std::string::npos)
-				{
-					_current_line.replace(position, strlen("RAY_TRACING_SIZE"), "gl_LaunchSizeNV");
-					position = _current_line.find("RAY_TRACING_SIZE");
-				}
-
-				current_line = _current_line.c_str();
+				ReplaceAll(&current_line, "RAY_TRACING_SIZE", "gl_LaunchSizeNV");
 			}
 
 			//Replace "RAY_TRACING_FLAG_SKIP_CLOSEST_HIT" with "gl_RayFlagsSkipClosestHitShaderNV".
 			if (current_line.Find("RAY_TRACING_FLAG_SKIP_CLOSEST_HIT"))
 			{
-				std::string _current_line{ current_line.Data() };
-
-				size_t position{ _current_line.find("RAY_TRACING_FLAG_SKIP_CLOSEST_HIT") };
-
-				while (position != std::string::npos)
-				{
-					_current_line.replace(position, strlen("RAY_TRACING_FLAG_SKIP_CLOSEST_HIT"), "gl_RayFlagsSkipClosestHitShaderNV");
-					position = _current_line.find("RAY_TRACING_FLAG_SKIP_CLOSEST_HIT");
-				}
-
-				current_line = _current_line.c_str();
+				ReplaceAll(&current_line, "RAY_TRACING_FLAG_SKIP_CLOSEST_HIT", "gl_RayFlagsSkipClosestHitShaderNV");
 			}
 
 			//Replace "RAY_TRACING_FLAG_TERMINATE_ON_FIRST_HIT" with "gl_RayFlagsTerminateOnFirstHitNV".
 			if (current_line.Find("RAY_TRACING_FLAG_TERMINATE_ON_FIRST_HIT"))
 			{
-				std::string _current_line{ current_line.Data() };
-
-				size_t position{ _current_line.find("RAY_TRACING_FLAG_TERMINATE_ON_FIRST_HIT") };
-
-				while (position != std::string::npos)
-				{
-					_current_line.replace(position, strlen("RAY_TRACING_FLAG_TERMINATE_ON_FIRST_HIT"), "gl_RayFlagsTerminateOnFirstHitNV");
-					position = _current_line.find("RAY_TRACING_FLAG_TERMINATE_ON_FIRST_HIT");
-				}
-
-				current_line = _current_line.c_str();
+				ReplaceAll(&current_line, "RAY_TRACING_FLAG_TERMINATE_ON_FIRST_HIT", "gl_RayFlagsTerminateOnFirstHitNV");
 			}
 
 			//Handle samplers.
@@ -4208,49 +4174,19 @@ void RenderPipelineAssetCompiler::CompileGLSLShaders
 			//Replace "VERTEX_INDEX" with "gl_VertexIndex".
 			if (current_line.Find("VERTEX_INDEX"))
 			{
-				std::string _current_line{ current_line.Data() };
-
-				size_t position{ _current_line.find("VERTEX_INDEX") };
-
-				while (position != std::string::npos)
-				{
-					_current_line.replace(position, strlen("VERTEX_INDEX"), "gl_VertexIndex");
-					position = _current_line.find("VERTEX_INDEX");
-				}
-
-				current_line = _current_line.c_str();
+				ReplaceAll(&current_line, "VERTEX_INDEX", "gl_VertexIndex");
 			}
 
 			//Replace "WORLD_RAY_DIRECTION" with "gl_WorldRayDirectionNV".
 			if (current_line.Find("WORLD_RAY_DIRECTION"))
 			{
-				std::string _current_line{ current_line.Data() };
-
-				size_t position{ _current_line.find("WORLD_RAY_DIRECTION") };
-
-				while (position != std::string::npos)
-				{
-					_current_line.replace(position, strlen("WORLD_RAY_DIRECTION"), "gl_WorldRayDirectionNV");
-					position = _current_line.find("WORLD_RAY_DIRECTION");
-				}
-
-				current_line = _current_line.c_str();
+				ReplaceAll(&current_line, "WORLD_RAY_DIRECTION", "gl_WorldRayDirectionNV");
 			}
 
 			//Replace "WORLD_RAY_ORIGIN" with "gl_WorldRayOriginNV".
 			if (current_line.Find("WORLD_RAY_ORIGIN"))
 			{
-				std::string _current_line{ current_line.Data() };
-
-				size_t position{ _current_line.find("WORLD_RAY_ORIGIN") };
-
-				while (position != std::string::npos)
-				{
-					_current_line.replace(position, strlen("WORLD_RAY_ORIGIN"), "gl_WorldRayOriginNV");
-					position = _current_line.find("WORLD_RAY_ORIGIN");
-				}
-
-				current_line = _current_line.c_str();
+				ReplaceAll(&current_line, "WORLD_RAY_ORIGIN", "gl_WorldRayOriginNV");
 			}
 
 			//Add the line.
@@ -4290,6 +4226,94 @@ void RenderPipelineAssetCompiler::CompileGLSLShaders
 			file.close();
 		}
 
+		//Fill in the compilation.
+		compilation._ShaderStage = shader_stage._ShaderStage;
+		compilation._InputFilePath = file_path;
+		compilation._CacheDirectoryPath = cache_directory_path;
+		compilation._CacheHit = false;
+		compilation._Succeeded = false;
+	}
+
+	//Fire off the compilations.
+	const std::chrono::steady_clock::time_point compilation_start_time{ std::chrono::steady_clock::now() };
+
+	const TaskSystem::ParallelForFunction compile_function
+	{
+		[](void *const RESTRICT arguments, const uint32 index)
+		{
+			ShaderCompilation &compilation{ static_cast<ShaderCompilation *const RESTRICT>(arguments)[index] };
+
+			GLSLCompilation::CompileParameters parameters;
+
+			parameters._ShaderStage = compilation._ShaderStage;
+			parameters._InputLines = &compilation._Lines;
+			parameters._InputFilePath = compilation._InputFilePath.Data();
+			parameters._OutputData = &compilation._OutputData;
+			parameters._CacheDirectoryPath = compilation._CacheDirectoryPath.Data();
+			parameters._CacheHit = &compilation._CacheHit;
+
+			compilation._Succeeded = GLSLCompilation::Compile(parameters);
+		}
+	};
+
+#if COMPILE_SINGLE_THREADED
+	for (uint32 compilation_index{ 0 }; compilation_index < static_cast<uint32>(compilations.Size()); ++compilation_index)
+	{
+		compile_function(compilations.Data(), compilation_index);
+	}
+#else
+	TaskSystem::ParallelFor(Task::Priority::LOW, static_cast<uint32>(compilations.Size()), compile_function, compilations.Data());
+#endif
+
+	//Report any failed compilations. The errors themselves are logged by the GLSL compilation.
+	{
+		uint64 number_of_failed_compilations{ 0 };
+
+		for (const ShaderCompilation &compilation : compilations)
+		{
+			number_of_failed_compilations += compilation._Succeeded ? 0 : 1;
+		}
+
+		if (number_of_failed_compilations > 0)
+		{
+			LOG_ERROR
+			(
+				"%s: Failed to compile %llu of %llu shader stages.",
+				compile_context._Name.Data(),
+				static_cast<unsigned long long>(number_of_failed_compilations),
+				static_cast<unsigned long long>(compilations.Size())
+			);
+
+			return false;
+		}
+	}
+
+	//Log some statistics.
+	{
+		uint64 number_of_cache_hits{ 0 };
+
+		for (const ShaderCompilation &compilation : compilations)
+		{
+			number_of_cache_hits += compilation._CacheHit ? 1 : 0;
+		}
+
+		const float64 compilation_time{ std::chrono::duration<float64>(std::chrono::steady_clock::now() - compilation_start_time).count() };
+
+		LOG_INFORMATION
+		(
+			"%s: Compiled %llu shader stages in %.3f seconds, %llu from the SPIR-V cache.",
+			compile_context._Name.Data(),
+			static_cast<unsigned long long>(compilations.Size()),
+			compilation_time,
+			static_cast<unsigned long long>(number_of_cache_hits)
+		);
+	}
+
+	//Move the output data into place. Done after all compilations are finished, as adding hit groups or miss shaders might move the data.
+	for (uint64 shader_stage_index{ 0 }; shader_stage_index < shader_stages.Size(); ++shader_stage_index)
+	{
+		const ShaderStageLines &shader_stage{ shader_stages[shader_stage_index] };
+
 		//Retrieve the output data.
 		DynamicArray<byte> *RESTRICT output_data{ nullptr };
 
@@ -4394,16 +4418,9 @@ void RenderPipelineAssetCompiler::CompileGLSLShaders
 			}
 		}
 
-		//Compile the shader!
-		{
-			GLSLCompilation::CompileParameters parameters;
-
-			parameters._ShaderStage = shader_stage._ShaderStage;
-			parameters._InputLines = &glsl_lines;
-			parameters._InputFilePath = file_path;
-			parameters._OutputData = output_data;
-
-			GLSLCompilation::Compile(parameters);
-		}
+		//Move the output data.
+		*output_data = std::move(compilations[shader_stage_index]._OutputData);
 	}
+
+	return true;
 }
\ No newline at end of file
@@ -111,6 +111,9 @@ void SettingsAssetCompiler::Compile(const CompileContext &compile_context) NOEXC
 
 	//Close the output file.
 	output_file.Close();
+
+	//Report the output.
+	compile_context._Outputs.Emplace(output_file_path);
 }
 
 /*
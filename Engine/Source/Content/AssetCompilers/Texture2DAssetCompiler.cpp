@@ -3,6 +3,7 @@
 
 //Core.
 #include <Core/General/StaticString.h>
+#include <Core/General/Time.h>
 
 //Content.
 #include <Content/Core/AssetHeader.h>
@@ -18,7 +19,7 @@
 #include <Profiling/Profiling.h>
 
 //Rendering.
-#include <Rendering/Native/RenderingUtilities.h>
+#include <Rendering/Native/ImageProcessing.h>
 #include <Rendering/Native/Texture2D.h>
 #include <Rendering/Native/TextureCompression.h>
 
@@ -76,6 +77,19 @@ public:
 
 };
 
+/*
+*	Texture 2D usage enumeration definition.
+*	Used to pick the compression mode when it's set to AUTOMATIC.
+*/
+enum class Texture2DUsage : uint8
+{
+	DEFAULT, //Picks NORMAL_MAP if the mipmap generation mode is NORMAL_MAP, otherwise COLOR.
+	COLOR,
+	NORMAL_MAP,
+	MASK,
+	HDR
+};
+
 /*
 *	Texture 2D parameters class definition.
 */
@@ -126,11 +140,209 @@ public:
 	//The mipmap generation mode.
 	MipmapGenerationMode _MipmapGenerationMode{ MipmapGenerationMode::DEFAULT };
 
+	//The mipmap filter.
+	ImageProcessing::MipFilter _MipmapFilter{ ImageProcessing::MipFilter::KAISER };
+
+	//Whether or not to preserve the alpha coverage across mip levels.
+	bool _PreserveAlphaCoverage{ false };
+
+	//The reference value the alpha coverage is measured against.
+	float32 _AlphaCoverageReference{ 0.5f };
+
+	//The usage.
+	Texture2DUsage _Usage{ Texture2DUsage::DEFAULT };
+
 	//The compression.
 	TextureCompression _Compression;
 
+	//Denotes whether or not the compression mode should be picked automatically, based on the usage.
+	bool _AutomaticCompression{ false };
+
 };
 
+/*
+*	Picks the compression mode for a texture, based on it's usage and contents.
+*/
+FORCE_INLINE static NO_DISCARD TextureCompression::Mode AutomaticCompressionMode(const Texture2DParameters &parameters, const Texture2D<Vector4<uint8>> &texture) NOEXCEPT
+{
+	//Resolve the default usage.
+	Texture2DUsage usage{ parameters._Usage };
+
+	if (usage == Texture2DUsage::DEFAULT)
+	{
+		usage = parameters._MipmapGenerationMode == MipmapGenerationMode::NORMAL_MAP ? Texture2DUsage::NORMAL_MAP : Texture2DUsage::COLOR;
+	}
+
+	//Check if the alpha channel is fully opaque.
+	bool alpha_is_opaque{ true };
+
+	for (uint32 Y{ 0 }; Y < texture.GetHeight(); ++Y)
+	{
+		for (uint32 X{ 0 }; X < texture.GetWidth(); ++X)
+		{
+			alpha_is_opaque &= texture.At(X, Y)._W == UINT8_MAXIMUM;
+		}
+	}
+
+	switch (usage)
+	{
+		case Texture2DUsage::COLOR:
+		{
+			//Opaque textures don't need the extra alpha block, otherwise BC7 holds up a lot better than BC3 unless speed is preferred.
+			if (alpha_is_opaque)
+			{
+				return TextureCompression::Mode::BC1;
+			}
+
+			else
+			{
+				return parameters._Compression._Quality == TextureCompression::Quality::FAST ? TextureCompression::Mode::BC3 : TextureCompression::Mode::BC7;
+			}
+		}
+
+		case Texture2DUsage::NORMAL_MAP:
+		{
+			/*
+			*	BC5 only stores red and green, and none of the shaders reconstruct blue (Z) from them yet, so keep normal maps in BC7.
+			*	Normal maps can still opt into BC5 explicitly once the pipelines sampling them can decode it.
+			*/
+			return TextureCompression::Mode::BC7;
+		}
+
+		case Texture2DUsage::MASK:
+		{
+			return TextureCompression::Mode::BC4;
+		}
+
+		case Texture2DUsage::HDR:
+		{
+			return TextureCompression::Mode::BC6H;
+		}
+
+		default:
+		{
+			ASSERT(false, "Invalid case!");
+
+			return TextureCompression::Mode::BC7;
+		}
+	}
+}
+
+/*
+*	Composite context class definition.
+*/
+class CompositeContext final
+{
+
+public:
+
+	//The parameters.
+	const Texture2DParameters *RESTRICT _Parameters;
+
+	//The input textures.
+	const StaticArray<Texture2D<Vector4<float32>>, 4> *RESTRICT _InputTextures;
+
+	//The composite texture.
+	Texture2D<Vector4<float32>> *RESTRICT _CompositeTexture;
+
+	//The minimum of each channel, for channel normalization.
+	Vector4<float32> _Minimum;
+
+	//The maximum of each channel, for channel normalization.
+	Vector4<float32> _Maximum;
+
+};
+
+/*
+*	Composites, tints and gamma corrects one tile of the composite texture.
+*/
+static void CompositeTile(const void *const RESTRICT arguments, const uint32 first_row, const uint32 last_row) NOEXCEPT
+{
+	const CompositeContext &context{ *static_cast<const CompositeContext *const RESTRICT>(arguments) };
+	const Texture2DParameters &parameters{ *context._Parameters };
+
+	for (uint32 Y{ first_row }; Y < last_row; ++Y)
+	{
+		for (uint32 X{ 0 }; X < context._CompositeTexture->GetWidth(); ++X)
+		{
+			Vector4<float32> &texel{ context._CompositeTexture->At(X, Y) };
+
+			for (uint8 i{ 0 }; i < 4; ++i)
+			{
+				if (UNDERLYING(parameters._ChannelMappings[i]._File) <= UNDERLYING(Texture2DChannelMapping::File::FILE_4))
+				{
+					texel[i] = (*context._InputTextures)[UNDERLYING(parameters._ChannelMappings[i]._File)].At(X, Y)[UNDERLYING(parameters._ChannelMappings[i]._Channel)];
+				}
+
+				else
+				{
+					texel[i] = parameters._Default[UNDERLYING(parameters._ChannelMappings[i]._Channel)];
+				}
+
+				texel[i] *= parameters._Tint[i];
+			}
+
+			if (parameters._ApplyGammaCorrection)
+			{
+				for (uint8 i{ 0 }; i < 3; ++i)
+				{
+					texel[i] = powf(texel[i], 2.2f);
+				}
+			}
+		}
+	}
+}
+
+/*
+*	Applies channel normalizations and biases to one tile of the composite texture.
+*/
+static void AdjustTile(const void *const RESTRICT arguments, const uint32 first_row, const uint32 last_row) NOEXCEPT
+{
+	const CompositeContext &context{ *static_cast<const CompositeContext *const RESTRICT>(arguments) };
+	const Texture2DParameters &parameters{ *context._Parameters };
+
+	for (uint32 Y{ first_row }; Y < last_row; ++Y)
+	{
+		for (uint32 X{ 0 }; X < context._CompositeTexture->GetWidth(); ++X)
+		{
+			Vector4<float32> &texel{ context._CompositeTexture->At(X, Y) };
+
+			for (uint8 i{ 0 }; i < 4; ++i)
+			{
+				if (parameters._NormalizeChannels[i])
+				{
+					texel[i] = BaseMath::Scale(texel[i], context._Minimum[i], context._Maximum[i], 0.0f, 1.0f);
+				}
+			}
+
+			for (uint8 i{ 0 }; i < 3; ++i)
+			{
+				if (parameters._ChannelBiases[i] == 0.5f)
+				{
+					continue;
+				}
+
+				if (parameters._ChannelBiases[i] > 1.0f)
+				{
+					const uint32 iterations{ static_cast<uint32>(parameters._ChannelBiases[i]) };
+
+					for (uint32 iteration{ 0 }; iteration < iterations; ++iteration)
+					{
+						texel[i] = BaseMath::Bias(texel[i], 1.0f);
+					}
+
+					texel[i] = BaseMath::Bias(texel[i], BaseMath::Fractional(parameters._ChannelBiases[i]));
+				}
+
+				else
+				{
+					texel[i] = BaseMath::Bias(texel[i], parameters._ChannelBiases[i]);
+				}
+			}
+		}
+	}
+}
+
 /*
 *	Default constructor.
 */
@@ -157,6 +369,8 @@ NO_DISCARD uint64 Texture2DAssetCompiler::CurrentVersion() const NOEXCEPT
 	{
 		BASE,
 		ADDED_DEPENDENCIES,
+		ADDED_COMPRESSION_MODES,
+		ADDED_FILTERED_MIPMAPS,
 
 		CURRENT_VERSION,
 	};
@@ -610,6 +824,125 @@ void Texture2DAssetCompiler::Compile(const CompileContext &compile_context) NOEX
 				}
 			}
 
+			//Is this a mipmap filter declaration?
+			{
+				const size_t position{ current_line.find("MipmapFilter(") };
+
+				if (position != std::string::npos)
+				{
+					const uint64 number_of_arguments
+					{
+						TextParsingUtilities::ParseFunctionArguments
+						(
+							current_line.c_str(),
+							current_line.length(),
+							arguments.Data()
+						)
+					};
+
+					ASSERT(number_of_arguments == 1, "MipmapFilter() needs one argument!");
+
+					if (arguments[0] == "BOX")
+					{
+						parameters._MipmapFilter = ImageProcessing::MipFilter::BOX;
+					}
+
+					else if (arguments[0] == "KAISER")
+					{
+						parameters._MipmapFilter = ImageProcessing::MipFilter::KAISER;
+					}
+
+					else if (arguments[0] == "LANCZOS")
+					{
+						parameters._MipmapFilter = ImageProcessing::MipFilter::LANCZOS;
+					}
+
+					else
+					{
+						ASSERT(false, "Unknown argument %s", arguments[0].Data());
+					}
+
+					continue;
+				}
+			}
+
+			//Is this a preserve alpha coverage declaration?
+			{
+				const size_t position{ current_line.find("PreserveAlphaCoverage(") };
+
+				if (position != std::string::npos)
+				{
+					const uint64 number_of_arguments
+					{
+						TextParsingUtilities::ParseFunctionArguments
+						(
+							current_line.c_str(),
+							current_line.length(),
+							arguments.Data()
+						)
+					};
+
+					ASSERT(number_of_arguments == 1, "PreserveAlphaCoverage() needs one argument!");
+
+					parameters._PreserveAlphaCoverage = true;
+					parameters._AlphaCoverageReference = std::stof(arguments[0].Data());
+
+					continue;
+				}
+			}
+
+			//Is this a usage declaration?
+			{
+				const size_t position{ current_line.find("Usage(") };
+
+				if (position != std::string::npos)
+				{
+					const uint64 number_of_arguments
+					{
+						TextParsingUtilities::ParseFunctionArguments
+						(
+							current_line.c_str(),
+							current_line.length(),
+							arguments.Data()
+						)
+					};
+
+					ASSERT(number_of_arguments == 1, "Usage() needs one argument!");
+
+					if (arguments[0] == "DEFAULT")
+					{
+						parameters._Usage = Texture2DUsage::DEFAULT;
+					}
+
+					else if (arguments[0] == "COLOR")
+					{
+						parameters._Usage = Texture2DUsage::COLOR;
+					}
+
+					else if (arguments[0] == "NORMAL_MAP")
+					{
+						parameters._Usage = Texture2DUsage::NORMAL_MAP;
+					}
+
+					else if (arguments[0] == "MASK")
+					{
+						parameters._Usage = Texture2DUsage::MASK;
+					}
+
+					else if (arguments[0] == "HDR")
+					{
+						parameters._Usage = Texture2DUsage::HDR;
+					}
+
+					else
+					{
+						ASSERT(false, "Unknown argument %s", arguments[0].Data());
+					}
+
+					continue;
+				}
+			}
+
 			//Is this a compression declaration?
 			{
 				const size_t position{ current_line.find("Compression(") };
@@ -626,18 +959,50 @@ void Texture2DAssetCompiler::Compile(const CompileContext &compile_context) NOEX
 						)
 					};
 
-					ASSERT(number_of_arguments == 2, "Compression() needs two arguments!");
+					ASSERT(number_of_arguments == 2 || number_of_arguments == 3, "Compression() needs two or three arguments!");
+
+					parameters._AutomaticCompression = false;
 
 					if (arguments[0] == "NONE")
 					{
 						parameters._Compression._Mode = TextureCompression::Mode::NONE;
 					}
 
+					else if (arguments[0] == "BC1")
+					{
+						parameters._Compression._Mode = TextureCompression::Mode::BC1;
+					}
+
+					else if (arguments[0] == "BC3")
+					{
+						parameters._Compression._Mode = TextureCompression::Mode::BC3;
+					}
+
+					else if (arguments[0] == "BC4")
+					{
+						parameters._Compression._Mode = TextureCompression::Mode::BC4;
+					}
+
+					else if (arguments[0] == "BC5")
+					{
+						parameters._Compression._Mode = TextureCompression::Mode::BC5;
+					}
+
+					else if (arguments[0] == "BC6H")
+					{
+						parameters._Compression._Mode = TextureCompression::Mode::BC6H;
+					}
+
 					else if (arguments[0] == "BC7")
 					{
 						parameters._Compression._Mode = TextureCompression::Mode::BC7;
 					}
 
+					else if (arguments[0] == "AUTOMATIC")
+					{
+						parameters._AutomaticCompression = true;
+					}
+
 					else
 					{
 						ASSERT(false, "Unknown argument %s", arguments[0].Data());
@@ -658,6 +1023,29 @@ void Texture2DAssetCompiler::Compile(const CompileContext &compile_context) NOEX
 						ASSERT(false, "Unknown argument %s", arguments[1].Data());
 					}
 
+					if (number_of_arguments == 3)
+					{
+						if (arguments[2] == "FAST")
+						{
+							parameters._Compression._Quality = TextureCompression::Quality::FAST;
+						}
+
+						else if (arguments[2] == "NORMAL")
+						{
+							parameters._Compression._Quality = TextureCompression::Quality::NORMAL;
+						}
+
+						else if (arguments[2] == "HIGH")
+						{
+							parameters._Compression._Quality = TextureCompression::Quality::HIGH;
+						}
+
+						else
+						{
+							ASSERT(false, "Unknown argument %s", arguments[2].Data());
+						}
+					}
+
 					continue;
 				}
 			}
@@ -817,35 +1205,48 @@ void Texture2DAssetCompiler::Compile(const CompileContext &compile_context) NOEX
 
 	ASSERT(width > 0 && height > 0, "Couldn't determine width/height!");
 
-	//Create the composite texture.
+	//Create the composite texture, compositing, tinting and gamma correcting in the same pass.
 	Texture2D<Vector4<float32>> composite_texture{ width, height };
+	float64 composite_time;
 
 	{
 		PROFILING_SCOPE("Texture2DAssetCompiler::Compile - Create composite texture");
 
-		for (uint32 Y{ 0 }; Y < composite_texture.GetHeight(); ++Y)
-		{
-			for (uint32 X{ 0 }; X < composite_texture.GetWidth(); ++X)
-			{
-				//Calculate the texel.
-				Vector4<float32> &texel{ composite_texture.At(X, Y) };
+		const TimePoint start_time;
 
-				for (uint8 i{ 0 }; i < 4; ++i)
-				{
-					if (UNDERLYING(parameters._ChannelMappings[i]._File) <= UNDERLYING(Texture2DChannelMapping::File::FILE_4))
-					{
-						texel[i] = input_textures[UNDERLYING(parameters._ChannelMappings[i]._File)].At(X, Y)[UNDERLYING(parameters._ChannelMappings[i]._Channel)];
-					}
+		CompositeContext context;
 
-					else
-					{
-						texel[i] = parameters._Default[UNDERLYING(parameters._ChannelMappings[i]._Channel)];
-					}
+		context._Parameters = &parameters;
+		context._InputTextures = &input_textures;
+		context._CompositeTexture = &composite_texture;
 
-					texel[i] *= parameters._Tint[i];
-				}
+		ImageProcessing::ForEachTile(height, CompositeTile, &context);
+
+		//Apply channel normalizations and biases in a second pass, as normalization needs the range of the composite texture.
+		const bool normalize_channels{ parameters._NormalizeChannels[0] || parameters._NormalizeChannels[1] || parameters._NormalizeChannels[2] || parameters._NormalizeChannels[3] };
+		const bool apply_channel_biases
+		{
+			parameters._ChannelBiases[0] != 0.5f
+			|| parameters._ChannelBiases[1] != 0.5f
+			|| parameters._ChannelBiases[2] != 0.5f
+		};
+
+		if (normalize_channels || apply_channel_biases)
+		{
+			if (normalize_channels)
+			{
+				ImageProcessing::Statistics statistics;
+				ImageProcessing::CalculateStatistics(composite_texture, &statistics);
+
+				//Same as searching for the range starting from a minimum of 1.0f and a maximum of 0.0f.
+				context._Minimum = BaseMath::Minimum<Vector4<float32>>(statistics._Minimum, Vector4<float32>(1.0f, 1.0f, 1.0f, 1.0f));
+				context._Maximum = BaseMath::Maximum<Vector4<float32>>(statistics._Maximum, Vector4<float32>(0.0f, 0.0f, 0.0f, 0.0f));
 			}
+
+			ImageProcessing::ForEachTile(height, AdjustTile, &context);
 		}
+
+		composite_time = start_time.GetSecondsSince();
 	}
 
 	//Destroy the input textures.
@@ -854,162 +1255,96 @@ void Texture2DAssetCompiler::Compile(const CompileContext &compile_context) NOEX
 		input_textures[i].Destroy();
 	}
 
-	//Apply gamma correction, if desired.
-	if (parameters._ApplyGammaCorrection)
+	//Calculate the average value.
+	Vector4<float32> average_value;
+
 	{
-		PROFILING_SCOPE("Texture2DAssetCompiler::Compile - Apply gamma correction");
+		PROFILING_SCOPE("Texture2DAssetCompiler::Compile - Calculate average value");
 
-		for (uint32 Y{ 0 }; Y < composite_texture.GetHeight(); ++Y)
-		{
-			for (uint32 X{ 0 }; X < composite_texture.GetWidth(); ++X)
-			{
-				Vector4<float32> &texel{ composite_texture.At(X, Y) };
+		ImageProcessing::Statistics statistics;
+		ImageProcessing::CalculateStatistics(composite_texture, &statistics);
 
-				for (uint8 i{ 0 }; i < 3; ++i)
-				{
-					texel[i] = powf(texel[i], 2.2f);
-				}
-			}
-		}
+		average_value = statistics._Average;
 	}
 
-	//Apply channel normalizations.
-	for (uint8 channel_index{ 0 }; channel_index < 4; ++channel_index)
-	{
-		if (!parameters._NormalizeChannels[channel_index])
-		{
-			continue;
-		}
+	//Generate the mip chain. The composite texture is already in linear space if gamma correction was applied, so the mip levels are filtered in linear space.
+	DynamicArray<Texture2D<Vector4<float32>>> mip_chain;
+	float64 mip_chain_time;
 
-		float32 minimum{ 1.0f };
-		float32 maximum{ 0.0f };
+	mip_chain.Emplace(std::move(composite_texture));
 
-		for (uint32 Y{ 0 }; Y < composite_texture.GetHeight(); ++Y)
-		{
-			for (uint32 X{ 0 }; X < composite_texture.GetWidth(); ++X)
-			{
-				Vector4<float32> &texel{ composite_texture.At(X, Y) };
+	{
+		PROFILING_SCOPE("Texture2DAssetCompiler::Compile - Generate mip chain");
 
-				minimum = BaseMath::Minimum<float32>(minimum, texel[channel_index]);
-				maximum = BaseMath::Maximum<float32>(maximum, texel[channel_index]);
-			}
-		}
+		const TimePoint start_time;
 
-		for (uint32 Y{ 0 }; Y < composite_texture.GetHeight(); ++Y)
+		if (parameters._MipmapGenerationMode != MipmapGenerationMode::NONE)
 		{
-			for (uint32 X{ 0 }; X < composite_texture.GetWidth(); ++X)
-			{
-				Vector4<float32> &texel{ composite_texture.At(X, Y) };
+			ImageProcessing::MipChainParameters mip_chain_parameters;
 
-				texel[channel_index] = BaseMath::Scale(texel[channel_index], minimum, maximum, 0.0f, 1.0f);
-			}
-		}
-	}
+			mip_chain_parameters._Mode = parameters._MipmapGenerationMode;
+			mip_chain_parameters._Filter = parameters._MipmapFilter;
 
-	//Apply channel biases.
-	if (parameters._ChannelBiases[0] != 0.5f
-		|| parameters._ChannelBiases[1] != 0.5f
-		|| parameters._ChannelBiases[2] != 0.5f
-		|| parameters._ChannelBiases[3] != 0.5f)
-	{
-		for (uint32 Y{ 0 }; Y < composite_texture.GetHeight(); ++Y)
-		{
-			for (uint32 X{ 0 }; X < composite_texture.GetWidth(); ++X)
+			//Opacity textures keep their coverage in all channels, others only in alpha when asked for.
+			if (parameters._MipmapGenerationMode == MipmapGenerationMode::OPACITY)
 			{
-				Vector4<float32> &texel{ composite_texture.At(X, Y) };
-
-				for (uint8 i{ 0 }; i < 3; ++i)
-				{
-					if (parameters._ChannelBiases[i] > 1.0f)
-					{
-						const uint32 iterations{ static_cast<uint32>(parameters._ChannelBiases[i]) };
-
-						for (uint32 i{ 0 }; i < iterations; ++i)
-						{
-							texel[i] = BaseMath::Bias(texel[i], 1.0f);
-						}
-
-						texel[i] = BaseMath::Bias(texel[i], BaseMath::Fractional(parameters._ChannelBiases[i]));
-					}
-
-					else
-					{
-						texel[i] = BaseMath::Bias(texel[i], parameters._ChannelBiases[i]);
-					}
-				}
+				mip_chain_parameters._CoverageChannels = static_cast<uint8>(BIT(0) | BIT(1) | BIT(2) | BIT(3));
 			}
-		}
-	}
-
-	//Calculate the average value.
-	Vector4<float32> average_value;
-
-	{
-		PROFILING_SCOPE("Texture2DAssetCompiler::Compile - Calculate average value");
-
-		//Calculate the average value with higher precision.
-		Vector4<float64> _average_value{ 0.0, 0.0, 0.0, 0.0 };
 
-		for (uint32 Y{ 0 }; Y < composite_texture.GetHeight(); ++Y)
-		{
-			for (uint32 X{ 0 }; X < composite_texture.GetWidth(); ++X)
+			else if (parameters._PreserveAlphaCoverage)
 			{
-				const Vector4<float32> &texel{ composite_texture.At(X, Y) };
-
-				for (uint8 i{ 0 }; i < 4; ++i)
-				{
-					_average_value[i] += static_cast<float64>(texel[i]);
-				}
+				mip_chain_parameters._CoverageChannels = static_cast<uint8>(BIT(3));
+				mip_chain_parameters._CoverageReference = parameters._AlphaCoverageReference;
 			}
-		}
 
-		for (uint8 i{ 0 }; i < 4; ++i)
-		{
-			_average_value[i] /= static_cast<float64>(composite_texture.GetWidth() * composite_texture.GetHeight());
-			average_value[i] = static_cast<float32>(_average_value[i]);
+			ImageProcessing::GenerateMipChain(mip_chain_parameters, &mip_chain);
 		}
-	}
-
-	//Generate the mip chain.
-	DynamicArray<Texture2D<Vector4<float32>>> mip_chain;
-
-	if (parameters._MipmapGenerationMode != MipmapGenerationMode::NONE)
-	{
-		PROFILING_SCOPE("Texture2DAssetCompiler::Compile - Generate mip chain");
-
-		RenderingUtilities::GenerateMipChain(composite_texture, parameters._MipmapGenerationMode, &mip_chain);
-	}
 
-	else
-	{
-		mip_chain.Emplace(composite_texture);
+		mip_chain_time = start_time.GetSecondsSince();
 	}
 
 	//Create the output textures.
 	DynamicArray<Texture2D<Vector4<uint8>>> output_textures;
+	float64 conversion_time;
 
 	output_textures.Reserve(mip_chain.Size() - parameters._BaseMipLevel);
 
 	{
 		PROFILING_SCOPE("Texture2DAssetCompiler::Compile - Create output textures");
 
+		const TimePoint start_time;
+
 		for (uint64 mip_index{ parameters._BaseMipLevel }; mip_index < mip_chain.Size(); ++mip_index)
 		{
 			output_textures.Emplace();
 
-			output_textures.Back().Initialize(mip_chain[mip_index].GetWidth(), mip_chain[mip_index].GetHeight());
-
-			for (uint32 Y{ 0 }; Y < output_textures.Back().GetHeight(); ++Y)
-			{
-				for (uint32 X{ 0 }; X < output_textures.Back().GetWidth(); ++X)
-				{
-					for (uint8 texel_index{ 0 }; texel_index < 4; ++texel_index)
-					{
-						output_textures.Back().At(X, Y)[texel_index] = static_cast<uint8>(mip_chain[mip_index].At(X, Y)[texel_index] * static_cast<float32>(UINT8_MAXIMUM));
-					}
-				}
-			}
+			ImageProcessing::ConvertToUNorm8(mip_chain[mip_index], &output_textures.Back());
 		}
+
+		conversion_time = start_time.GetSecondsSince();
+	}
+
+	{
+		const float64 megapixels{ static_cast<float64>(static_cast<uint64>(width) * height) / 1'000'000.0 };
+
+		LOG_INFORMATION
+		(
+			"Processed %s (%ux%u): composite %.3f seconds (%.2f megapixels/second), mip chain %.3f seconds (%.2f megapixels/second), conversion %.3f seconds",
+			compile_context._Name.Data(),
+			width,
+			height,
+			composite_time,
+			megapixels / BaseMath::Maximum<float64>(composite_time, FLOAT64_EPSILON),
+			mip_chain_time,
+			megapixels / BaseMath::Maximum<float64>(mip_chain_time, FLOAT64_EPSILON),
+			conversion_time
+		);
+	}
+
+	//Pick the compression mode, if it should be picked automatically.
+	if (parameters._AutomaticCompression)
+	{
+		parameters._Compression._Mode = AutomaticCompressionMode(parameters, output_textures[0]);
 	}
 
 	//Create the output data.
@@ -1020,11 +1355,18 @@ void Texture2DAssetCompiler::Compile(const CompileContext &compile_context) NOEX
 	{
 		PROFILING_SCOPE("Texture2DAssetCompiler::Compile - Create output data");
 
+		const TimePoint start_time;
+		uint64 total_texels{ 0 };
+		uint64 total_raw_size{ 0 };
+		uint64 total_compressed_size{ 0 };
+
 		for (uint64 mip_index{ 0 }; mip_index < output_textures.Size(); ++mip_index)
 		{
 			output_data.Emplace();
 
-			const uint64 raw_texture_size{ output_textures[mip_index].GetWidth() * output_textures[mip_index].GetHeight() * sizeof(Vector4<byte>) };
+			const uint32 mip_width{ output_textures[mip_index].GetWidth() };
+			const uint32 mip_height{ output_textures[mip_index].GetHeight() };
+			const uint64 raw_texture_size{ static_cast<uint64>(mip_width) * mip_height * sizeof(Vector4<byte>) };
 
 			if (parameters._Compression._Mode == TextureCompression::Mode::NONE)
 			{
@@ -1034,17 +1376,39 @@ void Texture2DAssetCompiler::Compile(const CompileContext &compile_context) NOEX
 
 			else
 			{
-				const uint32 compression_ratio{ parameters._Compression.CompressionRatio() };
-				const uint64 compressed_texture_size{ raw_texture_size / compression_ratio };
-
-				DynamicArray<byte> input_data;
-				input_data.Upsize<false>(raw_texture_size);
-				Memory::Copy(input_data.Data(), output_textures[mip_index].Data(), raw_texture_size);
+				output_data.Back().Upsize<false>(parameters._Compression.Size2D(mip_width, mip_height));
 
-				output_data.Back().Upsize<false>(compressed_texture_size);
+				//BC6H compresses from the floating point mip chain, to keep the HDR range.
+				if (parameters._Compression._Mode == TextureCompression::Mode::BC6H)
+				{
+					parameters._Compression.Compress2D(reinterpret_cast<const float32 *const RESTRICT>(mip_chain[parameters._BaseMipLevel + mip_index].Data()), mip_width, mip_height, output_data.Back().Data());
+				}
 
-				parameters._Compression.Compress2D(input_data.Data(), output_textures[mip_index].GetWidth(), output_textures[mip_index].GetHeight(), output_data.Back().Data());
+				else
+				{
+					parameters._Compression.Compress2D(reinterpret_cast<const byte *const RESTRICT>(output_textures[mip_index].Data()), mip_width, mip_height, output_data.Back().Data());
+				}
 			}
+
+			total_texels += static_cast<uint64>(mip_width) * mip_height;
+			total_raw_size += raw_texture_size;
+			total_compressed_size += output_data.Back().Size();
+		}
+
+		if (parameters._Compression._Mode != TextureCompression::Mode::NONE)
+		{
+			const float64 seconds{ BaseMath::Maximum<float64>(start_time.GetSecondsSince(), FLOAT64_EPSILON) };
+
+			LOG_INFORMATION
+			(
+				"Compressed %s with mode %u: %.2f megapixels/second, %llu bytes -> %llu bytes (saved %.1f%%)",
+				compile_context._Name.Data(),
+				static_cast<uint32>(parameters._Compression._Mode),
+				static_cast<float64>(total_texels) / 1'000'000.0 / seconds,
+				total_raw_size,
+				total_compressed_size,
+				100.0 * (1.0 - static_cast<float64>(total_compressed_size) / static_cast<float64>(total_raw_size))
+			);
 		}
 	}
 
@@ -1107,6 +1471,9 @@ void Texture2DAssetCompiler::Compile(const CompileContext &compile_context) NOEX
 	//Close the output file.
 	output_file.Close();
 
+	//Report the output.
+	compile_context._Outputs.Emplace(output_file_path);
+
 	//Add the dependencies.
 	if (parameters._File1)
 	{
@@ -1159,8 +1526,8 @@ void Texture2DAssetCompiler::Load(const LoadContext &load_context) NOEXCEPT
 	//Read the compression.
 	load_context._StreamArchive->Read(&new_asset->_Compression, sizeof(TextureCompression), &stream_archive_position);
 
-	//Read the data.
-	DynamicArray<DynamicArray<byte>> data;
+	//Retrieve views of the data. The texture is created straight from the stream archive, which is usually a mapped file, so the mips are never copied on the CPU.
+	DynamicArray<const byte *RESTRICT> data;
 	data.Reserve(number_of_mip_levels);
 	uint32 final_width{ width };
 	uint32 final_height{ height };
@@ -1171,7 +1538,7 @@ void Texture2DAssetCompiler::Load(const LoadContext &load_context) NOEXCEPT
 	{
 		const uint32 mip_width{ width >> mip_index };
 		const uint32 mip_height{ height >> mip_index };
-		const uint64 mip_size{ (width >> mip_index) * (height >> mip_index) * sizeof(Vector4<byte>) / new_asset->_Compression.CompressionRatio() };
+		const uint64 mip_size{ new_asset->_Compression.Size2D(mip_width, mip_height) };
 
 		if (mip_index < number_of_mip_levels - 1)
 		{
@@ -1184,9 +1551,7 @@ void Texture2DAssetCompiler::Load(const LoadContext &load_context) NOEXCEPT
 
 		else
 		{
-			data.Emplace();
-			data.Back().Upsize<false>(mip_size);
-			load_context._StreamArchive->Read(data.Back().Data(), mip_size, &stream_archive_position);
+			data.Emplace(load_context._StreamArchive->View(mip_size, &stream_archive_position));
 		}
 	}
 #else
@@ -1194,11 +1559,9 @@ void Texture2DAssetCompiler::Load(const LoadContext &load_context) NOEXCEPT
 	{
 		const uint32 mip_width{ width >> mip_index };
 		const uint32 mip_height{ height >> mip_index };
-		const uint64 mip_size{ (width >> mip_index) * (height >> mip_index) * sizeof(Vector4<byte>) / new_asset->_Compression.CompressionRatio() };
+		const uint64 mip_size{ new_asset->_Compression.Size2D(mip_width, mip_height) };
 
-		data.Emplace();
-		data.Back().Upsize<false>(mip_size);
-		load_context._StreamArchive->Read(data.Back().Data(), mip_size, &stream_archive_position);
+		data.Emplace(load_context._StreamArchive->View(mip_size, &stream_archive_position));
 	}
 #endif
 
@@ -1221,6 +1584,41 @@ void Texture2DAssetCompiler::Load(const LoadContext &load_context) NOEXCEPT
 			break;
 		}
 
+		case TextureCompression::Mode::BC1:
+		{
+			texture_format = TextureFormat::RGB_BC1;
+
+			break;
+		}
+
+		case TextureCompression::Mode::BC3:
+		{
+			texture_format = TextureFormat::RGBA_BC3;
+
+			break;
+		}
+
+		case TextureCompression::Mode::BC4:
+		{
+			texture_format = TextureFormat::R_BC4;
+
+			break;
+		}
+
+		case TextureCompression::Mode::BC5:
+		{
+			texture_format = TextureFormat::RG_BC5;
+
+			break;
+		}
+
+		case TextureCompression::Mode::BC6H:
+		{
+			texture_format = TextureFormat::RGB_BC6H;
+
+			break;
+		}
+
 		default:
 		{
 			ASSERT(false, "Invalid case!");
@@ -1260,18 +1658,18 @@ void Texture2DAssetCompiler::Load(const LoadContext &load_context) NOEXCEPT
 
 	if (new_asset->_Compression._Mode == TextureCompression::Mode::NONE)
 	{
-		Memory::Copy(new_asset->_Texture2D.Data(), data[0].Data(), final_width * final_height * sizeof(Vector4<byte>));
+		Memory::Copy(new_asset->_Texture2D.Data(), data[0], final_width * final_height * sizeof(Vector4<byte>));
 	}
 
 	else
 	{
-		new_asset->_Compression.Decompress2D(data[0].Data(), final_width, final_height, reinterpret_cast<byte *const RESTRICT>(new_asset->_Texture2D.Data()));
+		new_asset->_Compression.Decompress2D(data[0], final_width, final_height, reinterpret_cast<byte *const RESTRICT>(new_asset->_Texture2D.Data()));
 	}
 
 #if !defined(CATALYST_CONFIGURATION_FINAL)
 	//Update the total CPU memory.
 	{
-		const uint64 cpu_memory{ data[0].Size() };
+		const uint64 cpu_memory{ new_asset->_Compression.Size2D(final_width, final_height) };
 
 		_TotalCPUMemory.FetchAdd(cpu_memory);
 	}
@@ -1280,9 +1678,9 @@ void Texture2DAssetCompiler::Load(const LoadContext &load_context) NOEXCEPT
 	{
 		uint64 gpu_memory{ 0 };
 
-		for (const DynamicArray<byte> &_data : data)
+		for (uint64 mip_index{ 0 }; mip_index < data.Size(); ++mip_index)
 		{
-			gpu_memory += _data.Size();
+			gpu_memory += new_asset->_Compression.Size2D(final_width >> mip_index, final_height >> mip_index);
 		}
 
 		_TotalGPUMemory.FetchAdd(gpu_memory);
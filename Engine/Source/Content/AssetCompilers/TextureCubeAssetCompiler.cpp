@@ -6,12 +6,12 @@
 #include <File/Core/BinaryOutputFile.h>
 #include <File/Utilities/TextParsingUtilities.h>
 
-//Math.
-#include <Math/Core/CatalystRandomMath.h>
-
 //Profiling.
 #include <Profiling/Profiling.h>
 
+//Rendering.
+#include <Rendering/Native/CubemapFiltering.h>
+
 //Systems.
 #include <Systems/ContentSystem.h>
 #include <Systems/LogSystem.h>
@@ -21,25 +21,10 @@
 #include <ThirdParty/stb_image.h>
 
 //STL.
+#include <chrono>
 #include <fstream>
 #include <string>
 
-/*
-*	Samples the given HDR texture in the given direction.
-*/
-FORCE_INLINE NO_DISCARD Vector4<float32> SampleHDRTexture(const Texture2D<Vector4<float32>> &texture, const Vector3<float32> &direction) NOEXCEPT
-{
-	//Define constants.
-	constexpr Vector2<float32> INVERSE_ATAN{ 0.1591f, 0.3183f };
-
-	//Calculate the texture coordinate.
-	Vector2<float32> texture_coordinate{ BaseMath::ArcTangent(direction._Z, direction._X), BaseMath::ArcSine(direction._Y) };
-	texture_coordinate *= INVERSE_ATAN;
-	texture_coordinate += 0.5f;
-
-	return texture.Sample(texture_coordinate, AddressMode::CLAMP_TO_EDGE);
-}
-
 /*
 *	Texture cube parameters class definition.
 */
@@ -78,7 +63,7 @@ NO_DISCARD HashString TextureCubeAssetCompiler::AssetTypeIdentifier() const NOEX
 */
 NO_DISCARD uint64 TextureCubeAssetCompiler::CurrentVersion() const NOEXCEPT
 {
-	return 1;
+	return 2;
 }
 
 /*
@@ -90,7 +75,11 @@ void TextureCubeAssetCompiler::Compile(const CompileContext &compile_context) NO
 
 	//Define constants.
 	constexpr uint8 MIP_LEVELS{ 9 };
-	constexpr uint32 NUMBER_OF_SAMPLES{ 1024 };
+	constexpr uint32 NUMBER_OF_SAMPLES{ 128 };
+	constexpr uint32 MAXIMUM_SPHERICAL_HARMONICS_RESOLUTION{ 64 };
+
+	//Remember the start time.
+	const std::chrono::steady_clock::time_point start_time{ std::chrono::steady_clock::now() };
 
 	//Set up the parameters.
 	TextureCubeParameters parameters;
@@ -187,242 +176,46 @@ void TextureCubeAssetCompiler::Compile(const CompileContext &compile_context) NO
 
 	for (uint8 mip_level{ 0 }; mip_level < MIP_LEVELS; ++mip_level)
 	{
-		//Calculate the mip resolution.
-		const uint32 mip_resolution{ parameters._Resolution >> mip_level };
-
-		//Initialize the mip texture.
-		mip_chain[mip_level].Initialize(mip_resolution);
-
-#if 0 //'GATHER_SAMPLES' old experiment
-		//Calculate the diffuse weight.
-		const float32 diffuse_weight{ static_cast<float32>(mip_level) / static_cast<float32>(MIP_LEVELS - 1) };
-
-		//Calculate the number of samples.
-		const uint32 number_of_samples{ BaseMath::Maximum<uint32>(static_cast<uint32>(static_cast<float32>(NUMBER_OF_SAMPLES) * diffuse_weight), 1) };
-
-		for (uint8 face_index{ 0 }; face_index < 6; ++face_index)
-		{
-			for (uint32 Y{ 0 }; Y < mip_resolution; ++Y)
-			{
-				for (uint32 X{ 0 }; X < mip_resolution; ++X)
-				{
-					//Calculate the normalized coordintace.
-					const Vector2<float32> normalized_coordinate
-					{
-						(static_cast<float32>(X) + 0.5f) / static_cast<float32>(mip_resolution),
-						(static_cast<float32>(Y) + 0.5f) / static_cast<float32>(mip_resolution)
-					};
-
-					//Calculate the base direction
-					Vector3<float32> base_direction;
-
-					switch (face_index)
-					{
-					case 0: base_direction = Vector3<float32>(-1.0f, BaseMath::LinearlyInterpolate(-1.0f, 1.0f, normalized_coordinate._Y), BaseMath::LinearlyInterpolate(-1.0f, 1.0f, normalized_coordinate._X)); break; //Front.
-					case 1: base_direction = Vector3<float32>(1.0f, BaseMath::LinearlyInterpolate(-1.0f, 1.0f, normalized_coordinate._Y), BaseMath::LinearlyInterpolate(1.0f, -1.0f, normalized_coordinate._X)); break; //Back.
-					case 2: base_direction = Vector3<float32>(BaseMath::LinearlyInterpolate(1.0f, -1.0f, normalized_coordinate._X), -1.0f, BaseMath::LinearlyInterpolate(1.0f, -1.0f, normalized_coordinate._Y)); break; //Up.
-					case 3: base_direction = Vector3<float32>(BaseMath::LinearlyInterpolate(1.0f, -1.0f, normalized_coordinate._X), 1.0f, BaseMath::LinearlyInterpolate(-1.0f, 1.0f, normalized_coordinate._Y)); break; //Down.
-					case 4: base_direction = Vector3<float32>(BaseMath::LinearlyInterpolate(1.0f, -1.0f, normalized_coordinate._X), BaseMath::LinearlyInterpolate(-1.0f, 1.0f, normalized_coordinate._Y), -1.0f); break; //Right.
-					case 5: base_direction = Vector3<float32>(BaseMath::LinearlyInterpolate(-1.0f, 1.0f, normalized_coordinate._X), BaseMath::LinearlyInterpolate(-1.0f, 1.0f, normalized_coordinate._Y), 1.0f); break; //Left.
-					default: CRASH(); break;
-					}
-
-					base_direction.Normalize();
-
-					//Accumulate samples.
-					Vector4<float32> accumulated{ 0.0f, 0.0f, 0.0f, 0.0f };
-					float32 accumulated_weight{ 0.0f };
-
-					for (uint32 sample_index{ 0 }; sample_index < number_of_samples; ++sample_index)
-					{
-						//Calculate the sample direction.
-						Vector3<float32> sample_direction;
-
-						{
-							const Vector2<float32> coordinate{ CatalystRandomMath::RandomFloat() , CatalystRandomMath::RandomFloat() };
-
-							const float32 phi{ coordinate._Y * 2.0f * BaseMathConstants::PI };
-							const float32 cos_theta{ 1.0f - coordinate._X };
-							const float32 sin_theta{ BaseMath::SquareRoot(1.0f - cos_theta * cos_theta) };
-
-							sample_direction = Vector3<float32>(BaseMath::Cosine(phi) * sin_theta, BaseMath::Sine(phi) * sin_theta, cos_theta);
-						}
-
-						//Flip the sample direction, if necessary.
-						if (Vector3<float32>::DotProduct(base_direction, sample_direction) < 0.0f)
-						{
-							sample_direction *= -1.0f;
-						}
-
-						//Modify the sample direction based on how diffuse it is.
-						sample_direction = Vector3<float32>::Normalize(BaseMath::LinearlyInterpolate(base_direction, sample_direction, diffuse_weight));
-
-						//Calculate the sample weight.
-						const float32 sample_weight{ BaseMath::Maximum<float32>(Vector3<float32>::DotProduct(base_direction, sample_direction), 0.0f) };
-
-						//Sample.
-						Vector4<float32> sample;
-
-						/*
-						if (mip_level > 0)
-						{
-							sample = mip_chain[mip_level - 1].Sample(sample_direction);
-						}
-
-						else
-						*/
-						{
-							sample = SampleHDRTexture(hdr_texture, sample_direction);
-						}
-
-						//Accumulate!
-						accumulated += sample * sample_weight;
-						accumulated_weight += sample_weight;
-					}
+		mip_chain[mip_level].Initialize(parameters._Resolution >> mip_level);
+	}
 
-					//Normalize.
-					accumulated /= accumulated_weight;
+	//The first mip level is the radiance itself.
+	CubemapFiltering::FromEquirectangular(hdr_texture, &mip_chain[0]);
 
-					mip_chain[mip_level].At(face_index, X, Y) = accumulated;
-				}
-			}
-		}
-#else
-		//Constants.
-		constexpr float32 GAUSSIAN_WEIGHTS[3][3]
-		{
-			{ 0.07f, 0.12f, 0.07f },
-			{ 0.12f, 0.19f, 0.12f },
-			{ 0.07f, 0.12f, 0.07f }
-		};
+	//Build the mip chain to filter from.
+	DynamicArray<TextureCube> source_mip_chain;
+	CubemapFiltering::BuildMipChain(mip_chain[0], &source_mip_chain);
 
-		//Calculate the sample delta.
-		const Vector2<float32> sample_delta{ 1.0f / static_cast<float32>(mip_resolution * 2), 1.0f / static_cast<float32>(mip_resolution * 2) };
+	//The mip levels in between are prefiltered for increasing roughness, matching how the shaders pick the mip level from the roughness.
+	for (uint8 mip_level{ 1 }; mip_level < MIP_LEVELS - 1; ++mip_level)
+	{
+		const float32 roughness{ static_cast<float32>(mip_level) / static_cast<float32>(MIP_LEVELS - 1) };
 
-		for (uint8 face_index{ 0 }; face_index < 6; ++face_index)
-		{
-			for (uint32 Y{ 0 }; Y < mip_resolution; ++Y)
-			{
-				for (uint32 X{ 0 }; X < mip_resolution; ++X)
-				{
-					if (mip_level > 0)
-					{
-						//Cache the previous texture.
-						const Texture2D<Vector4<float32>> &previous_texture{ mip_chain[mip_level - 1].Face(face_index) };
-
-						//Calculate the normalized coordintace.
-						const Vector2<float32> normalized_coordinate
-						{
-							(static_cast<float32>(X) + 0.5f) / static_cast<float32>(mip_resolution),
-							(static_cast<float32>(Y) + 0.5f) / static_cast<float32>(mip_resolution)
-						};
-
-						Vector4<float32> total{ 0.0f, 0.0f, 0.0f, 0.0f };
-
-						for (int32 _Y{ -1 }; _Y <= 1; ++_Y)
-						{
-							for (int32 _X{ -1 }; _X <= 1; ++_X)
-							{
-								total += previous_texture.Sample(normalized_coordinate + Vector2<float32>(static_cast<float32>(_X), -static_cast<float32>(_Y)) * sample_delta, AddressMode::CLAMP_TO_EDGE) * GAUSSIAN_WEIGHTS[_X + 1][_Y + 1];
-							}
-						}
-
-						mip_chain[mip_level].At(face_index, X, Y) = total;
-					}
-
-					else
-					{
-						//Calculate the normalized coordintace.
-						const Vector2<float32> normalized_coordinate
-						{
-							(static_cast<float32>(X) + 0.5f) / static_cast<float32>(mip_resolution),
-							(static_cast<float32>(Y) + 0.5f) / static_cast<float32>(mip_resolution)
-						};
-
-						//Calculate the base direction
-						Vector3<float32> base_direction;
-
-						switch (face_index)
-						{
-							case 0: base_direction = Vector3<float32>(-1.0f, BaseMath::LinearlyInterpolate(-1.0f, 1.0f, normalized_coordinate._Y), BaseMath::LinearlyInterpolate(-1.0f, 1.0f, normalized_coordinate._X)); break; //Front.
-							case 1: base_direction = Vector3<float32>(1.0f, BaseMath::LinearlyInterpolate(-1.0f, 1.0f, normalized_coordinate._Y), BaseMath::LinearlyInterpolate(1.0f, -1.0f, normalized_coordinate._X)); break; //Back.
-							case 2: base_direction = Vector3<float32>(BaseMath::LinearlyInterpolate(1.0f, -1.0f, normalized_coordinate._X), -1.0f, BaseMath::LinearlyInterpolate(1.0f, -1.0f, normalized_coordinate._Y)); break; //Up.
-							case 3: base_direction = Vector3<float32>(BaseMath::LinearlyInterpolate(1.0f, -1.0f, normalized_coordinate._X), 1.0f, BaseMath::LinearlyInterpolate(-1.0f, 1.0f, normalized_coordinate._Y)); break; //Down.
-							case 4: base_direction = Vector3<float32>(BaseMath::LinearlyInterpolate(1.0f, -1.0f, normalized_coordinate._X), BaseMath::LinearlyInterpolate(-1.0f, 1.0f, normalized_coordinate._Y), -1.0f); break; //Right.
-							case 5: base_direction = Vector3<float32>(BaseMath::LinearlyInterpolate(-1.0f, 1.0f, normalized_coordinate._X), BaseMath::LinearlyInterpolate(-1.0f, 1.0f, normalized_coordinate._Y), 1.0f); break; //Left.
-							default: ASSERT(false, "Invalid case!"); break;
-						}
-
-						base_direction.Normalize();
-
-						//Sample the HDR texture.
-						mip_chain[mip_level].At(face_index, X, Y) = SampleHDRTexture(hdr_texture, base_direction);
-					}
-				}
-			}
-		}
-#endif
+		CubemapFiltering::PrefilterSpecular(source_mip_chain, roughness, NUMBER_OF_SAMPLES, &mip_chain[mip_level]);
 	}
 
-	//Sewt up the base texture.
-	TextureCube base_texture;
-
+	//The last mip level is used for diffuse lighting, so store the irradiance there. Spherical harmonics don't need much resolution to project from.
 	{
-		//Load the HDR texture.
-		int32 width, height, number_of_channels;
-		float32 *const RESTRICT data{ stbi_loadf(parameters._File.Data(), &width, &height, &number_of_channels, STBI_rgb_alpha) };
-
-		//Wrap the data into a texture 2D for easier manipulation.
-		Texture2D<Vector4<float32>> hdr_texture{ static_cast<uint32>(width), static_cast<uint32>(height) };
+		uint64 source_mip_level{ 0 };
 
-		//Copy the data into the cpu texture.
-		Memory::Copy(hdr_texture.Data(), data, width * height * sizeof(Vector4<float32>));
-
-		//Free the data, not needed anymore.
-		stbi_image_free(data);
-
-		//Create the base texture.
-		base_texture.Initialize(parameters._Resolution);
-
-		for (uint8 face_index{ 0 }; face_index < 6; ++face_index)
+		while (source_mip_level < source_mip_chain.LastIndex() && source_mip_chain[source_mip_level].Face(0).GetWidth() > MAXIMUM_SPHERICAL_HARMONICS_RESOLUTION)
 		{
-			for (uint32 Y{ 0 }; Y < parameters._Resolution; ++Y)
-			{
-				for (uint32 X{ 0 }; X < parameters._Resolution; ++X)
-				{
-					//Define constants.
-					constexpr Vector2<float32> INVERSE_ATAN{ 0.1591f, 0.3183f };
-
-					//Calculate the direction
-					Vector3<float32> direction;
-
-					const float32 x_weight{ static_cast<float32>(X) / static_cast<float32>(parameters._Resolution) };
-					const float32 y_weight{ static_cast<float32>(Y) / static_cast<float32>(parameters._Resolution) };
-
-					switch (face_index)
-					{
-						case 0: direction = Vector3<float32>(-1.0f, BaseMath::LinearlyInterpolate(-1.0f, 1.0f, y_weight), BaseMath::LinearlyInterpolate(-1.0f, 1.0f, x_weight)); break; //Front.
-						case 1: direction = Vector3<float32>(1.0f, BaseMath::LinearlyInterpolate(-1.0f, 1.0f, y_weight), BaseMath::LinearlyInterpolate(1.0f, -1.0f, x_weight)); break; //Back.
-						case 2: direction = Vector3<float32>(BaseMath::LinearlyInterpolate(1.0f, -1.0f, x_weight), -1.0f, BaseMath::LinearlyInterpolate(1.0f, -1.0f, y_weight)); break; //Up.
-						case 3: direction = Vector3<float32>(BaseMath::LinearlyInterpolate(1.0f, -1.0f, x_weight), 1.0f, BaseMath::LinearlyInterpolate(-1.0f, 1.0f, y_weight)); break; //Down.
-						case 4: direction = Vector3<float32>(BaseMath::LinearlyInterpolate(1.0f, -1.0f, x_weight), BaseMath::LinearlyInterpolate(-1.0f, 1.0f, y_weight), -1.0f); break; //Right.
-						case 5: direction = Vector3<float32>(BaseMath::LinearlyInterpolate(-1.0f, 1.0f, x_weight), BaseMath::LinearlyInterpolate(-1.0f, 1.0f, y_weight), 1.0f); break; //Left.
-						default: ASSERT(false, "Invalid case!"); break;
-					}
-
-					direction.Normalize();
-
-					//Sample the HDR texture.
-					Vector2<float32> texture_coordinate{ BaseMath::ArcTangent(direction._Z, direction._X), BaseMath::ArcSine(direction._Y) };
-					texture_coordinate *= INVERSE_ATAN;
-					texture_coordinate += 0.5f;
-
-					base_texture.At(face_index, X, Y) = hdr_texture.Sample(texture_coordinate, AddressMode::CLAMP_TO_EDGE);
-				}
-			}
+			++source_mip_level;
 		}
+
+		StaticArray<Vector3<float32>, 9> coefficients;
+		CubemapFiltering::ProjectSphericalHarmonics(source_mip_chain[source_mip_level], &coefficients);
+		CubemapFiltering::ConvolveDiffuse(coefficients, &mip_chain[MIP_LEVELS - 1]);
 	}
 
+	LOG_INFORMATION
+	(
+		"%s: Filtered texture cube at resolution %u in %.3f seconds.",
+		compile_context._Name.Data(),
+		parameters._Resolution,
+		std::chrono::duration<float64>(std::chrono::steady_clock::now() - start_time).count()
+	);
+
 	//Determine the collection directory.
 	char collection_directory_path[MAXIMUM_FILE_PATH_LENGTH];
 
@@ -477,6 +270,9 @@ void TextureCubeAssetCompiler::Compile(const CompileContext &compile_context) NO
 
 	//Close the output file.
 	output_file.Close();
+
+	//Report the output.
+	compile_context._Outputs.Emplace(output_file_path);
 }
 
 /*
@@ -0,0 +1,242 @@
+//Header file.
+#include <Content/Core/ContentStore.h>
+
+//File.
+#include <File/Core/BinaryInputFile.h>
+#include <File/Core/BinaryOutputFile.h>
+
+//STL.
+#include <filesystem>
+#include <string>
+
+/*
+*	Returns the file path of the object with the given hash.
+*/
+FORCE_INLINE static void ObjectFilePath(const char *const RESTRICT directory_path, const uint64 hash, char *const RESTRICT file_path) NOEXCEPT
+{
+	sprintf_s(file_path, MAXIMUM_FILE_PATH_LENGTH, "%s\\Objects\\%016llx", directory_path, hash);
+}
+
+/*
+*	Returns the file path of the manifest with the given source key.
+*/
+FORCE_INLINE static void ManifestFilePath(const char *const RESTRICT directory_path, const uint64 source_key, char *const RESTRICT file_path) NOEXCEPT
+{
+	sprintf_s(file_path, MAXIMUM_FILE_PATH_LENGTH, "%s\\Manifests\\%016llx", directory_path, source_key);
+}
+
+/*
+*	Reads a string from the given file.
+*/
+FORCE_INLINE static void ReadString(BinaryInputFile *const RESTRICT file, StaticString<MAXIMUM_FILE_PATH_LENGTH> *const RESTRICT string) NOEXCEPT
+{
+	uint64 length;
+	file->Read(&length, sizeof(uint64));
+
+	char buffer[MAXIMUM_FILE_PATH_LENGTH];
+	length = BaseMath::Minimum<uint64>(length, MAXIMUM_FILE_PATH_LENGTH - 1);
+	file->Read(buffer, length);
+	buffer[length] = '\0';
+
+	*string = buffer;
+}
+
+/*
+*	Writes a string to the given file.
+*/
+FORCE_INLINE static void WriteString(BinaryOutputFile *const RESTRICT file, const StaticString<MAXIMUM_FILE_PATH_LENGTH> &string) NOEXCEPT
+{
+	const uint64 length{ StringUtilities::StringLength(string.Data()) };
+
+	file->Write(&length, sizeof(uint64));
+	file->Write(string.Data(), length);
+}
+
+/*
+*	Copies the given file, going through a temporary file so that readers never see a partially written file.
+*	Returns if it succeeded.
+*/
+static bool CopyFileAtomically(const char *const RESTRICT source_file_path, const char *const RESTRICT destination_file_path) NOEXCEPT
+{
+	std::error_code error_code;
+
+	const std::filesystem::path destination_path{ destination_file_path };
+	std::filesystem::path temporary_path{ destination_path };
+	temporary_path += ".tmp";
+
+	std::filesystem::create_directories(destination_path.parent_path(), error_code);
+
+	if (!std::filesystem::copy_file(source_file_path, temporary_path, std::filesystem::copy_options::overwrite_existing, error_code))
+	{
+		return false;
+	}
+
+	std::filesystem::rename(temporary_path, destination_path, error_code);
+
+	return !error_code;
+}
+
+/*
+*	Initializes this content store in the given directory.
+*/
+void ContentStore::Initialize(const char *const RESTRICT directory_path) NOEXCEPT
+{
+	_DirectoryPath = directory_path;
+
+	char sub_directory_path[MAXIMUM_FILE_PATH_LENGTH];
+
+	sprintf_s(sub_directory_path, "%s\\Objects", directory_path);
+	std::filesystem::create_directories(sub_directory_path);
+
+	sprintf_s(sub_directory_path, "%s\\Manifests", directory_path);
+	std::filesystem::create_directories(sub_directory_path);
+}
+
+/*
+*	Tries to restore the outputs for the given source key into the given entry.
+*	Returns if it succeeded, which only happens if the manifest was compiled with the same dependencies.
+*/
+NO_DISCARD bool ContentStore::Restore(const uint64 source_key, ContentCache *const RESTRICT content_cache, ContentCache::Entry *const RESTRICT entry) NOEXCEPT
+{
+	char manifest_file_path[MAXIMUM_FILE_PATH_LENGTH];
+	ManifestFilePath(_DirectoryPath.Data(), source_key, manifest_file_path);
+
+	if (!File::Exists(manifest_file_path))
+	{
+		return false;
+	}
+
+	//Read the manifest.
+	uint64 key;
+	DynamicArray<StaticString<MAXIMUM_FILE_PATH_LENGTH>> dependencies;
+	DynamicArray<ContentCache::Entry::Output> outputs;
+
+	{
+		BinaryInputFile manifest_file{ manifest_file_path };
+
+		manifest_file.Read(&key, sizeof(uint64));
+
+		uint64 number_of_dependencies;
+		manifest_file.Read(&number_of_dependencies, sizeof(uint64));
+		dependencies.Upsize<true>(number_of_dependencies);
+
+		for (StaticString<MAXIMUM_FILE_PATH_LENGTH> &dependency : dependencies)
+		{
+			ReadString(&manifest_file, &dependency);
+		}
+
+		uint64 number_of_outputs;
+		manifest_file.Read(&number_of_outputs, sizeof(uint64));
+		outputs.Upsize<true>(number_of_outputs);
+
+		for (ContentCache::Entry::Output &output : outputs)
+		{
+			ReadString(&manifest_file, &output._FilePath);
+			manifest_file.Read(&output._Hash, sizeof(uint64));
+		}
+
+		manifest_file.Close();
+	}
+
+	//Manifests without outputs can't be restored from.
+	if (outputs.Empty())
+	{
+		return false;
+	}
+
+	//The dependencies as they are now must match what the manifest was compiled with.
+	if (content_cache->Key(source_key, dependencies) != key)
+	{
+		return false;
+	}
+
+	//Make sure all objects are there before touching any outputs.
+	char object_file_path[MAXIMUM_FILE_PATH_LENGTH];
+
+	for (const ContentCache::Entry::Output &output : outputs)
+	{
+		ObjectFilePath(_DirectoryPath.Data(), output._Hash, object_file_path);
+
+		if (!File::Exists(object_file_path))
+		{
+			return false;
+		}
+	}
+
+	//Restore the outputs. Outputs that already have the right contents are left alone.
+	for (const ContentCache::Entry::Output &output : outputs)
+	{
+		if (content_cache->FileHash(output._FilePath.Data()) == output._Hash)
+		{
+			continue;
+		}
+
+		ObjectFilePath(_DirectoryPath.Data(), output._Hash, object_file_path);
+
+		if (!CopyFileAtomically(object_file_path, output._FilePath.Data()))
+		{
+			return false;
+		}
+	}
+
+	//Update the entry.
+	entry->_Key = key;
+	entry->_Dependencies = std::move(dependencies);
+	entry->_Outputs = std::move(outputs);
+
+	return true;
+}
+
+/*
+*	Stores the outputs of the given entry under the given source key.
+*/
+void ContentStore::Store(const uint64 source_key, const ContentCache::Entry &entry) NOEXCEPT
+{
+	//Store the objects. Objects are immutable, so ones that already exist are skipped.
+	char object_file_path[MAXIMUM_FILE_PATH_LENGTH];
+
+	for (const ContentCache::Entry::Output &output : entry._Outputs)
+	{
+		ObjectFilePath(_DirectoryPath.Data(), output._Hash, object_file_path);
+
+		if (!File::Exists(object_file_path) && !CopyFileAtomically(output._FilePath.Data(), object_file_path))
+		{
+			return;
+		}
+	}
+
+	//Write the manifest to a temporary file, and then move it into place.
+	char manifest_file_path[MAXIMUM_FILE_PATH_LENGTH];
+	ManifestFilePath(_DirectoryPath.Data(), source_key, manifest_file_path);
+
+	char temporary_file_path[MAXIMUM_FILE_PATH_LENGTH];
+	sprintf_s(temporary_file_path, "%s.tmp", manifest_file_path);
+
+	{
+		BinaryOutputFile manifest_file{ temporary_file_path };
+
+		manifest_file.Write(&entry._Key, sizeof(uint64));
+
+		const uint64 number_of_dependencies{ entry._Dependencies.Size() };
+		manifest_file.Write(&number_of_dependencies, sizeof(uint64));
+
+		for (const StaticString<MAXIMUM_FILE_PATH_LENGTH> &dependency : entry._Dependencies)
+		{
+			WriteString(&manifest_file, dependency);
+		}
+
+		const uint64 number_of_outputs{ entry._Outputs.Size() };
+		manifest_file.Write(&number_of_outputs, sizeof(uint64));
+
+		for (const ContentCache::Entry::Output &output : entry._Outputs)
+		{
+			WriteString(&manifest_file, output._FilePath);
+			manifest_file.Write(&output._Hash, sizeof(uint64));
+		}
+
+		manifest_file.Close();
+	}
+
+	std::error_code error_code;
+	std::filesystem::rename(temporary_file_path, manifest_file_path, error_code);
+}
\ No newline at end of file
@@ -0,0 +1,281 @@
+//Header file.
+#include <Core/Algorithms/SortingAlgorithms.h>
+
+//Core.
+#include <Core/Containers/DynamicArray.h>
+#include <Core/Containers/StaticArray.h>
+
+//Math.
+#include <Math/Core/BaseMath.h>
+
+//Systems.
+#include <Systems/TaskSystem.h>
+
+//Radix sort constants.
+namespace RadixSortConstants
+{
+	constexpr uint64 BITS_PER_DIGIT{ 8 };
+	constexpr uint64 NUMBER_OF_BUCKETS{ 1 << BITS_PER_DIGIT };
+	constexpr uint64 NUMBER_OF_DIGITS{ 64 / BITS_PER_DIGIT };
+	constexpr uint64 MINIMUM_KEYS_PER_RANGE{ 16'384 };
+	constexpr uint64 MAXIMUM_NUMBER_OF_RANGES{ 16 };
+}
+
+/*
+*	Radix sort range class definition.
+*	Each range is a contiguous part of the source with it's own histograms, so the scatter stays stable no matter where it runs.
+*/
+class RadixSortRange final
+{
+
+public:
+
+	//The source keys.
+	const uint64 *RESTRICT _SourceKeys;
+
+	//The source indices. Nullptr means the source is in it's original order.
+	const uint32 *RESTRICT _SourceIndices;
+
+	//The destination keys.
+	uint64 *RESTRICT _DestinationKeys;
+
+	//The destination indices.
+	uint32 *RESTRICT _DestinationIndices;
+
+	//The first key.
+	uint64 _First;
+
+	//The last key, exclusive.
+	uint64 _Last;
+
+	//The digit currently being sorted on.
+	uint8 _Digit;
+
+	//The histograms, one per digit.
+	StaticArray<StaticArray<uint32, RadixSortConstants::NUMBER_OF_BUCKETS>, RadixSortConstants::NUMBER_OF_DIGITS> _Histograms;
+
+	//The offsets to scatter to for the current digit.
+	StaticArray<uint32, RadixSortConstants::NUMBER_OF_BUCKETS> _Offsets;
+
+};
+
+/*
+*	Returns the given digit of the given key.
+*/
+FORCE_INLINE NO_DISCARD static uint64 RadixDigit(const uint64 key, const uint8 digit) NOEXCEPT
+{
+	return (key >> (digit * RadixSortConstants::BITS_PER_DIGIT)) & (RadixSortConstants::NUMBER_OF_BUCKETS - 1);
+}
+
+/*
+*	Counts all digits of the range at the given index in one go.
+*/
+static void RadixCountAllDigits(void *const RESTRICT arguments, const uint32 index) NOEXCEPT
+{
+	RadixSortRange *const RESTRICT range{ &static_cast<RadixSortRange *const RESTRICT>(arguments)[index] };
+
+	Memory::Set(range->_Histograms.Data(), 0, sizeof(range->_Histograms));
+
+	for (uint64 i{ range->_First }; i < range->_Last; ++i)
+	{
+		const uint64 key{ range->_SourceKeys[i] };
+
+		for (uint8 digit{ 0 }; digit < RadixSortConstants::NUMBER_OF_DIGITS; ++digit)
+		{
+			++range->_Histograms[digit][RadixDigit(key, digit)];
+		}
+	}
+}
+
+/*
+*	Counts the current digit of the range at the given index.
+*/
+static void RadixCountDigit(void *const RESTRICT arguments, const uint32 index) NOEXCEPT
+{
+	RadixSortRange *const RESTRICT range{ &static_cast<RadixSortRange *const RESTRICT>(arguments)[index] };
+
+	StaticArray<uint32, RadixSortConstants::NUMBER_OF_BUCKETS> &histogram{ range->_Histograms[range->_Digit] };
+
+	Memory::Set(histogram.Data(), 0, sizeof(histogram));
+
+	for (uint64 i{ range->_First }; i < range->_Last; ++i)
+	{
+		++histogram[RadixDigit(range->_SourceKeys[i], range->_Digit)];
+	}
+}
+
+/*
+*	Scatters the range at the given index to it's offsets for the current digit.
+*/
+static void RadixScatter(void *const RESTRICT arguments, const uint32 index) NOEXCEPT
+{
+	RadixSortRange *const RESTRICT range{ &static_cast<RadixSortRange *const RESTRICT>(arguments)[index] };
+
+	for (uint64 i{ range->_First }; i < range->_Last; ++i)
+	{
+		const uint64 key{ range->_SourceKeys[i] };
+		const uint32 destination{ range->_Offsets[RadixDigit(key, range->_Digit)]++ };
+
+		range->_DestinationKeys[destination] = key;
+		range->_DestinationIndices[destination] = range->_SourceIndices ? range->_SourceIndices[i] : static_cast<uint32>(i);
+	}
+}
+
+/*
+*	Runs the given function for all radix sort ranges, spread out over the task system, and waits for them to finish.
+*/
+FORCE_INLINE static void RadixExecute(DynamicArray<RadixSortRange> &ranges, const TaskSystem::ParallelForFunction function) NOEXCEPT
+{
+	TaskSystem::ParallelFor(Task::Priority::HIGH, static_cast<uint32>(ranges.Size()), function, ranges.Data());
+}
+
+/*
+*	Radix sort.
+*
+*	Time complexity: O(n * k), where k is the number of 8-bit digits that actually differ between the keys.
+*	Sorting in place: No. Writes the indices of the keys in sorted order to 'order', the keys themselves are left untouched.
+*	Stable: Yes.
+*	Uses: Sorting large amounts of 64-bit keys, for example draw keys. Large inputs are split across multiple tasks.
+*/
+void SortingAlgorithms::RadixSort(const uint64 *const RESTRICT keys, const uint64 number_of_keys, uint32 *const RESTRICT order) NOEXCEPT
+{
+	ASSERT(number_of_keys <= UINT32_MAXIMUM, "Radix sort only supports 32-bit indices!");
+
+	if (number_of_keys == 0)
+	{
+		return;
+	}
+
+	//Split the keys into ranges. Small inputs stay on this thread.
+	uint64 number_of_ranges{ number_of_keys / RadixSortConstants::MINIMUM_KEYS_PER_RANGE };
+
+	if (TaskSystem::Instance)
+	{
+		number_of_ranges = BaseMath::Minimum<uint64>(number_of_ranges, TaskSystem::Instance->GetNumberOfTaskExecutors());
+	}
+
+	else
+	{
+		number_of_ranges = 1;
+	}
+
+	number_of_ranges = BaseMath::Clamp<uint64>(number_of_ranges, 1, RadixSortConstants::MAXIMUM_NUMBER_OF_RANGES);
+
+	/*
+	*	The scratch memory is local rather than thread local,
+	*	since helping out with other work while waiting for the tasks might end up in another radix sort on this thread.
+	*/
+	DynamicArray<RadixSortRange> ranges;
+	ranges.Upsize<true>(number_of_ranges);
+
+	for (uint64 i{ 0 }; i < number_of_ranges; ++i)
+	{
+		ranges[i]._SourceKeys = keys;
+		ranges[i]._SourceIndices = nullptr;
+		ranges[i]._First = number_of_keys * i / number_of_ranges;
+		ranges[i]._Last = number_of_keys * (i + 1) / number_of_ranges;
+	}
+
+	//Count all digits in one pass, which tells which digits actually need sorting.
+	RadixExecute(ranges, RadixCountAllDigits);
+
+	StaticArray<uint8, RadixSortConstants::NUMBER_OF_DIGITS> active_digits;
+	uint8 number_of_active_digits{ 0 };
+
+	for (uint8 digit{ 0 }; digit < RadixSortConstants::NUMBER_OF_DIGITS; ++digit)
+	{
+		bool all_in_one_bucket{ false };
+
+		for (uint64 bucket{ 0 }; bucket < RadixSortConstants::NUMBER_OF_BUCKETS; ++bucket)
+		{
+			uint64 count{ 0 };
+
+			for (const RadixSortRange &range : ranges)
+			{
+				count += range._Histograms[digit][bucket];
+			}
+
+			if (count != 0)
+			{
+				all_in_one_bucket = count == number_of_keys;
+
+				break;
+			}
+		}
+
+		if (!all_in_one_bucket)
+		{
+			active_digits[number_of_active_digits++] = digit;
+		}
+	}
+
+	//If all keys are equal, the original order is already the sorted order.
+	if (number_of_active_digits == 0)
+	{
+		for (uint64 i{ 0 }; i < number_of_keys; ++i)
+		{
+			order[i] = static_cast<uint32>(i);
+		}
+
+		return;
+	}
+
+	//Set up the scratch memory. The index buffers are picked so that the last pass writes into 'order'.
+	DynamicArray<uint64> scratch_keys[2];
+	DynamicArray<uint32> scratch_indices;
+
+	scratch_keys[0].Upsize<false>(number_of_keys);
+
+	if (number_of_active_digits > 1)
+	{
+		scratch_keys[1].Upsize<false>(number_of_keys);
+		scratch_indices.Upsize<false>(number_of_keys);
+	}
+
+	const uint64 *RESTRICT source_keys{ keys };
+	const uint32 *RESTRICT source_indices{ nullptr };
+
+	for (uint8 pass{ 0 }; pass < number_of_active_digits; ++pass)
+	{
+		const uint8 digit{ active_digits[pass] };
+		const bool last_pass{ pass == number_of_active_digits - 1 };
+
+		uint64 *const RESTRICT destination_keys{ scratch_keys[pass & 1].Data() };
+		uint32 *const RESTRICT destination_indices{ ((number_of_active_digits - 1 - pass) & 1) == 0 ? order : scratch_indices.Data() };
+
+		//The first pass reuses the histograms from counting all digits, the other passes need to count again since the ranges have been shuffled.
+		for (RadixSortRange &range : ranges)
+		{
+			range._SourceKeys = source_keys;
+			range._SourceIndices = source_indices;
+			range._DestinationKeys = destination_keys;
+			range._DestinationIndices = destination_indices;
+			range._Digit = digit;
+		}
+
+		if (pass > 0)
+		{
+			RadixExecute(ranges, RadixCountDigit);
+		}
+
+		//Calculate the offsets. Lower buckets go first, and within a bucket, earlier ranges go first, which keeps the sort stable.
+		uint32 offset{ 0 };
+
+		for (uint64 bucket{ 0 }; bucket < RadixSortConstants::NUMBER_OF_BUCKETS; ++bucket)
+		{
+			for (RadixSortRange &range : ranges)
+			{
+				range._Offsets[bucket] = offset;
+				offset += range._Histograms[digit][bucket];
+			}
+		}
+
+		RadixExecute(ranges, RadixScatter);
+
+		if (!last_pass)
+		{
+			source_keys = destination_keys;
+			source_indices = destination_indices;
+		}
+	}
+}
\ No newline at end of file
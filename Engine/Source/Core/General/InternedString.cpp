@@ -0,0 +1,49 @@
+//Header file.
+#include <Core/General/InternedString.h>
+
+//Core.
+#include <Core/Containers/DynamicArray.h>
+
+//Concurrency.
+#include <Concurrency/ScopedLock.h>
+#include <Concurrency/Spinlock.h>
+
+//STL.
+#include <unordered_map>
+
+/*
+*	Interns the given string, returning the entry for it.
+*/
+RESTRICTED NO_DISCARD const InternedString::Entry *const RESTRICT InternedString::Intern(const char *const RESTRICT string) NOEXCEPT
+{
+	//The table is constructed on first use, so strings can be interned during static initialization as well.
+	static Spinlock lock;
+	static std::unordered_map<uint64, DynamicArray<const Entry *RESTRICT>> entries;
+
+	const HashString hash{ string };
+	const uint64 length{ StringUtilities::StringLength(string) };
+
+	SCOPED_LOCK(lock);
+
+	//Look through the entries with the same hash, in case of collisions.
+	DynamicArray<const Entry *RESTRICT> &bucket{ entries[hash] };
+
+	for (const Entry *const RESTRICT entry : bucket)
+	{
+		if (entry->_Length == length && StringUtilities::IsEqual(entry->GetCharacters(), string, length))
+		{
+			return entry;
+		}
+	}
+
+	//Create the new entry. Entries are never freed, so other interned strings can keep pointing to them.
+	Entry *const RESTRICT new_entry{ static_cast<Entry *const RESTRICT>(Memory::Allocate(sizeof(Entry) + length + 1)) };
+
+	new_entry->_Hash = hash;
+	new_entry->_Length = length;
+	Memory::Copy(const_cast<char *const RESTRICT>(new_entry->GetCharacters()), string, length + 1);
+
+	bucket.Emplace(new_entry);
+
+	return new_entry;
+}
\ No newline at end of file
@@ -450,20 +450,14 @@ void EditorContentSystem::CreateModelEstimateFiles() NOEXCEPT
 */
 void EditorContentSystem::CreateModelCompile() NOEXCEPT
 {
-	//Figure out the name.
-	std::string name;
-
-	{
-		const std::string input_folder{ _CreateModelState._InputFolder.Data() };
-		const size_t position{ input_folder.find_last_of("\\") };
-
-		name = input_folder.substr(position + 1);
-	}
+	//Figure out the name, which is the last part of the input folder.
+	const char *const RESTRICT last_separator{ _CreateModelState._InputFolder.FindLastOfCharacter('\\') };
+	const char *const RESTRICT name{ last_separator ? last_separator + 1 : _CreateModelState._InputFolder.Data() };
 
 	//Write the model asset file.
 	{
 		char buffer[MAXIMUM_FILE_PATH_LENGTH];
-		sprintf_s(buffer, "%s\\%s.Model", _CreateModelState._OutputFolder.Data(), name.c_str());
+		sprintf_s(buffer, "%s\\%s.Model", _CreateModelState._OutputFolder.Data(), name);
 
 		std::ofstream file{ buffer };
 
@@ -483,14 +477,14 @@ void EditorContentSystem::CreateModelCompile() NOEXCEPT
 	//Write the material asset file.
 	{
 		char buffer[MAXIMUM_FILE_PATH_LENGTH];
-		sprintf_s(buffer, "%s\\%s.Material", _CreateModelState._OutputFolder.Data(), name.c_str());
+		sprintf_s(buffer, "%s\\%s.Material", _CreateModelState._OutputFolder.Data(), name);
 
 		std::ofstream file{ buffer };
 
 		file << "Type(OPAQUE);" << std::endl;
-		file << "AlbedoThicknessTexture(" << name.c_str() << "_AlbedoThickness);" << std::endl;
-		file << "NormalMapDisplacementTexture(" << name.c_str() << "_NormalMapDisplacement);" << std::endl;
-		file << "MaterialPropertiesTexture(" << name.c_str() << "_MaterialProperties);" << std::endl;
+		file << "AlbedoThicknessTexture(" << name << "_AlbedoThickness);" << std::endl;
+		file << "NormalMapDisplacementTexture(" << name << "_NormalMapDisplacement);" << std::endl;
+		file << "MaterialPropertiesTexture(" << name << "_MaterialProperties);" << std::endl;
 
 		file.close();
 	}
@@ -498,7 +492,7 @@ void EditorContentSystem::CreateModelCompile() NOEXCEPT
 	//Write the albedo/thickness asset file.
 	{
 		char buffer[MAXIMUM_FILE_PATH_LENGTH];
-		sprintf_s(buffer, "%s\\%s_AlbedoThickness.Texture2D", _CreateModelState._OutputFolder.Data(), name.c_str());
+		sprintf_s(buffer, "%s\\%s_AlbedoThickness.Texture2D", _CreateModelState._OutputFolder.Data(), name);
 
 		std::ofstream file{ buffer };
 
@@ -530,7 +524,7 @@ void EditorContentSystem::CreateModelCompile() NOEXCEPT
 	//Write the normal map/displacement asset file.
 	{
 		char buffer[MAXIMUM_FILE_PATH_LENGTH];
-		sprintf_s(buffer, "%s\\%s_NormalMapDisplacement.Texture2D", _CreateModelState._OutputFolder.Data(), name.c_str());
+		sprintf_s(buffer, "%s\\%s_NormalMapDisplacement.Texture2D", _CreateModelState._OutputFolder.Data(), name);
 
 		std::ofstream file{ buffer };
 
@@ -570,7 +564,7 @@ void EditorContentSystem::CreateModelCompile() NOEXCEPT
 	//Write the material properties asset file.
 	{
 		char buffer[MAXIMUM_FILE_PATH_LENGTH];
-		sprintf_s(buffer, "%s\\%s_MaterialProperties.Texture2D", _CreateModelState._OutputFolder.Data(), name.c_str());
+		sprintf_s(buffer, "%s\\%s_MaterialProperties.Texture2D", _CreateModelState._OutputFolder.Data(), name);
 
 		std::ofstream file{ buffer };
 
@@ -836,18 +836,12 @@ namespace EntitySerialization
 					//Cache the world transform component configuration.
 					WorldTransformInitializationData *const RESTRICT world_transform_component_configuration{ static_cast<WorldTransformInitializationData *const RESTRICT>(component_configuration) };
 
-					//Create a transformation matrix.
-					const Matrix4x4 transformation_matrix{ world_transform->ToLocalMatrix4x4() };
-
-					//Apply the cell.
-					world_transform_component_configuration->_WorldTransform.SetCell(world_transform_component_configuration->_WorldTransform.GetCell() + world_transform->GetCell());
-					
-					//Apply the position.
-					{
-						Vector3<float32> local_position{ world_transform_component_configuration->_WorldTransform.GetLocalPosition() };
-						local_position.Rotate(world_transform->GetRotation().ToEulerAngles());
-						local_position += world_transform->GetLocalPosition();
-						world_transform_component_configuration->_WorldTransform.SetLocalPosition(local_position);
+					//Apply the position. The whole position is scaled, rotated and translated, so entities in every cell keep their place relative to the others.
+					{
+						Vector3<float32> position{ world_transform_component_configuration->_WorldTransform.GetAbsolutePosition() };
+						position *= world_transform->GetScale();
+						position.Rotate(world_transform->GetRotation().ToEulerAngles());
+						world_transform_component_configuration->_WorldTransform.SetWorldPosition(WorldPosition(world_transform->GetCell(), world_transform->GetLocalPosition() + position));
 					}
 
 					//Apply rotation.
@@ -0,0 +1,656 @@
+//Header file.
+#include <Math/Noise/BatchNoise.h>
+
+//Core.
+#include <Core/General/SIMD.h>
+
+//Math.
+#include <Math/Noise/DerivativeNoise.h>
+#include <Math/Noise/PerlinNoise.h>
+#include <Math/Noise/SimplexNoise.h>
+#include <Math/Noise/ValueNoise.h>
+
+//Profiling.
+#include <Profiling/Profiling.h>
+
+//Systems.
+#include <Systems/TaskSystem.h>
+
+//Batch noise constants.
+namespace BatchNoiseConstants
+{
+	//The number of points processed at a time when generating fractal noise. Keeps the scratch buffers on the stack.
+	constexpr uint64 CHUNK_SIZE{ 256 };
+
+	//The number of row chunks to split grids into per task executor, to even out the load.
+	constexpr uint32 CHUNKS_PER_EXECUTOR{ 4 };
+}
+
+/*
+*	Permutation table, widened to 32-bit integers so it can be used with gather instructions.
+*/
+class WidePermutations final
+{
+
+public:
+
+	//The permutations.
+	int32 _Permutations[512];
+
+	/*
+	*	Constructor taking the narrow permutations.
+	*/
+	FORCE_INLINE WidePermutations(const uint8 *const RESTRICT permutations) NOEXCEPT
+	{
+		for (uint32 i{ 0 }; i < 512; ++i)
+		{
+			_Permutations[i] = static_cast<int32>(permutations[i]);
+		}
+	}
+
+};
+
+//Batch noise data.
+namespace BatchNoiseData
+{
+	//The wide Perlin noise permutations.
+	const WidePermutations PERLIN_PERMUTATIONS{ PerlinNoiseConstants::PERMUTATIONS };
+
+	//The wide simplex noise permutations.
+	const WidePermutations SIMPLEX_PERMUTATIONS{ SimplexNoiseConstants::PERMUTATIONS };
+}
+
+/*
+*	Grid context class definition.
+*/
+class GridContext final
+{
+
+public:
+
+	//The grid parameters.
+	const BatchNoise::GridParameters *RESTRICT _GridParameters;
+
+	//The fractal parameters.
+	const BatchNoise::FractalParameters *RESTRICT _FractalParameters;
+
+	//The domain warp parameters.
+	const BatchNoise::DomainWarpParameters *RESTRICT _DomainWarpParameters;
+
+	//The number of rows in each chunk.
+	uint32 _RowsPerChunk;
+
+	//The output.
+	float32 *RESTRICT _Output;
+
+};
+
+/*
+*	Floors the given values, matching BaseMath::Floor<int32>().
+*/
+FORCE_INLINE NO_DISCARD __m256i FloorAVX2(const __m256 values) NOEXCEPT
+{
+	const __m256 non_negative{ _mm256_cmp_ps(values, _mm256_setzero_ps(), _CMP_GE_OQ) };
+
+	return _mm256_cvttps_epi32(_mm256_blendv_ps(_mm256_sub_ps(values, _mm256_set1_ps(1.0f)), values, non_negative));
+}
+
+/*
+*	Linearly interpolates, matching BaseMath::LinearlyInterpolate().
+*/
+FORCE_INLINE NO_DISCARD __m256 LinearlyInterpolateAVX2(const __m256 A, const __m256 B, const __m256 alpha) NOEXCEPT
+{
+	return _mm256_add_ps(A, _mm256_mul_ps(_mm256_sub_ps(B, A), alpha));
+}
+
+/*
+*	Negates the values where the given bit in the hash is set.
+*/
+template <uint8 BIT>
+FORCE_INLINE NO_DISCARD __m256 ConditionalNegateAVX2(const __m256 values, const __m256i hash) NOEXCEPT
+{
+	const __m256i sign{ _mm256_slli_epi32(_mm256_and_si256(hash, _mm256_set1_epi32(1 << BIT)), 31 - BIT) };
+
+	return _mm256_xor_ps(values, _mm256_castsi256_ps(sign));
+}
+
+/*
+*	The Perlin noise fade function, matching PerlinNoise::Fade().
+*/
+FORCE_INLINE NO_DISCARD __m256 PerlinFadeAVX2(const __m256 value) NOEXCEPT
+{
+	const __m256 cubed{ _mm256_mul_ps(_mm256_mul_ps(value, value), value) };
+	__m256 polynomial{ _mm256_sub_ps(_mm256_mul_ps(value, _mm256_set1_ps(6.0f)), _mm256_set1_ps(15.0f)) };
+	polynomial = _mm256_add_ps(_mm256_mul_ps(value, polynomial), _mm256_set1_ps(10.0f));
+
+	return _mm256_mul_ps(cubed, polynomial);
+}
+
+/*
+*	The Perlin noise gradient function, matching PerlinNoise::Gradient().
+*/
+FORCE_INLINE NO_DISCARD __m256 PerlinGradientAVX2(const __m256i hash, const __m256 X, const __m256 Y, const __m256 Z) NOEXCEPT
+{
+	const __m256i masked_hash{ _mm256_and_si256(hash, _mm256_set1_epi32(15)) };
+
+	const __m256 below_eight{ _mm256_castsi256_ps(_mm256_cmpgt_epi32(_mm256_set1_epi32(8), masked_hash)) };
+	const __m256 below_four{ _mm256_castsi256_ps(_mm256_cmpgt_epi32(_mm256_set1_epi32(4), masked_hash)) };
+	const __m256 twelve_or_fourteen
+	{
+		_mm256_castsi256_ps(_mm256_or_si256(_mm256_cmpeq_epi32(masked_hash, _mm256_set1_epi32(12)), _mm256_cmpeq_epi32(masked_hash, _mm256_set1_epi32(14))))
+	};
+
+	const __m256 U{ _mm256_blendv_ps(Y, X, below_eight) };
+	const __m256 V{ _mm256_blendv_ps(_mm256_blendv_ps(Z, X, twelve_or_fourteen), Y, below_four) };
+
+	return _mm256_add_ps(ConditionalNegateAVX2<0>(U, masked_hash), ConditionalNegateAVX2<1>(V, masked_hash));
+}
+
+/*
+*	Generates eight points of Perlin noise, matching PerlinNoise::Generate().
+*/
+FORCE_INLINE NO_DISCARD __m256 PerlinNoiseAVX2(const __m256 X, const __m256 Y, const __m256 Z) NOEXCEPT
+{
+	const int32 *const RESTRICT P{ BatchNoiseData::PERLIN_PERMUTATIONS._Permutations };
+	const __m256i BYTE_MASK{ _mm256_set1_epi32(255) };
+	const __m256i ONE{ _mm256_set1_epi32(1) };
+	const __m256 ONE_FLOAT{ _mm256_set1_ps(1.0f) };
+
+	//The scalar version goes through a float before truncating, so do the same here.
+	const __m256 x_floor{ _mm256_cvtepi32_ps(FloorAVX2(X)) };
+	const __m256 y_floor{ _mm256_cvtepi32_ps(FloorAVX2(Y)) };
+	const __m256 z_floor{ _mm256_cvtepi32_ps(FloorAVX2(Z)) };
+
+	const __m256i xi{ _mm256_and_si256(_mm256_cvttps_epi32(x_floor), BYTE_MASK) };
+	const __m256i yi{ _mm256_and_si256(_mm256_cvttps_epi32(y_floor), BYTE_MASK) };
+	const __m256i zi{ _mm256_and_si256(_mm256_cvttps_epi32(z_floor), BYTE_MASK) };
+	const __m256i xi1{ _mm256_and_si256(_mm256_add_epi32(xi, ONE), BYTE_MASK) };
+	const __m256i yi1{ _mm256_and_si256(_mm256_add_epi32(yi, ONE), BYTE_MASK) };
+	const __m256i zi1{ _mm256_and_si256(_mm256_add_epi32(zi, ONE), BYTE_MASK) };
+
+	const __m256 xf{ _mm256_sub_ps(X, x_floor) };
+	const __m256 yf{ _mm256_sub_ps(Y, y_floor) };
+	const __m256 zf{ _mm256_sub_ps(Z, z_floor) };
+	const __m256 xf1{ _mm256_sub_ps(xf, ONE_FLOAT) };
+	const __m256 yf1{ _mm256_sub_ps(yf, ONE_FLOAT) };
+	const __m256 zf1{ _mm256_sub_ps(zf, ONE_FLOAT) };
+
+	const __m256 u{ PerlinFadeAVX2(xf) };
+	const __m256 v{ PerlinFadeAVX2(yf) };
+	const __m256 w{ PerlinFadeAVX2(zf) };
+
+	const __m256i a{ _mm256_i32gather_epi32(P, xi, 4) };
+	const __m256i b{ _mm256_i32gather_epi32(P, xi1, 4) };
+	const __m256i aa{ _mm256_i32gather_epi32(P, _mm256_add_epi32(a, yi), 4) };
+	const __m256i ab{ _mm256_i32gather_epi32(P, _mm256_add_epi32(a, yi1), 4) };
+	const __m256i ba{ _mm256_i32gather_epi32(P, _mm256_add_epi32(b, yi), 4) };
+	const __m256i bb{ _mm256_i32gather_epi32(P, _mm256_add_epi32(b, yi1), 4) };
+
+	const __m256i aaa{ _mm256_i32gather_epi32(P, _mm256_add_epi32(aa, zi), 4) };
+	const __m256i aba{ _mm256_i32gather_epi32(P, _mm256_add_epi32(ab, zi), 4) };
+	const __m256i aab{ _mm256_i32gather_epi32(P, _mm256_add_epi32(aa, zi1), 4) };
+	const __m256i abb{ _mm256_i32gather_epi32(P, _mm256_add_epi32(ab, zi1), 4) };
+	const __m256i baa{ _mm256_i32gather_epi32(P, _mm256_add_epi32(ba, zi), 4) };
+	const __m256i bba{ _mm256_i32gather_epi32(P, _mm256_add_epi32(bb, zi), 4) };
+	const __m256i bab{ _mm256_i32gather_epi32(P, _mm256_add_epi32(ba, zi1), 4) };
+	const __m256i bbb{ _mm256_i32gather_epi32(P, _mm256_add_epi32(bb, zi1), 4) };
+
+	__m256 x1{ LinearlyInterpolateAVX2(PerlinGradientAVX2(aaa, xf, yf, zf), PerlinGradientAVX2(baa, xf1, yf, zf), u) };
+	__m256 x2{ LinearlyInterpolateAVX2(PerlinGradientAVX2(aba, xf, yf1, zf), PerlinGradientAVX2(bba, xf1, yf1, zf), u) };
+	const __m256 y1{ LinearlyInterpolateAVX2(x1, x2, v) };
+
+	x1 = LinearlyInterpolateAVX2(PerlinGradientAVX2(aab, xf, yf, zf1), PerlinGradientAVX2(bab, xf1, yf, zf1), u);
+	x2 = LinearlyInterpolateAVX2(PerlinGradientAVX2(abb, xf, yf1, zf1), PerlinGradientAVX2(bbb, xf1, yf1, zf1), u);
+	const __m256 y2{ LinearlyInterpolateAVX2(x1, x2, v) };
+
+	return LinearlyInterpolateAVX2(y1, y2, w);
+}
+
+/*
+*	The simplex noise gradient function, matching SimplexNoise::Gradient() for two dimensions.
+*/
+FORCE_INLINE NO_DISCARD __m256 SimplexGradientAVX2(const __m256i hash, const __m256 X, const __m256 Y) NOEXCEPT
+{
+	const __m256i masked_hash{ _mm256_and_si256(hash, _mm256_set1_epi32(7)) };
+	const __m256 below_four{ _mm256_castsi256_ps(_mm256_cmpgt_epi32(_mm256_set1_epi32(4), masked_hash)) };
+
+	const __m256 U{ _mm256_blendv_ps(Y, X, below_four) };
+	const __m256 V{ _mm256_blendv_ps(X, Y, below_four) };
+
+	return _mm256_add_ps(ConditionalNegateAVX2<0>(U, masked_hash), ConditionalNegateAVX2<1>(_mm256_mul_ps(_mm256_set1_ps(2.0f), V), masked_hash));
+}
+
+/*
+*	Calculates the contribution of one simplex corner.
+*/
+FORCE_INLINE NO_DISCARD __m256 SimplexCornerAVX2(const __m256i hash, const __m256 X, const __m256 Y) NOEXCEPT
+{
+	__m256 t{ _mm256_sub_ps(_mm256_sub_ps(_mm256_set1_ps(0.5f), _mm256_mul_ps(X, X)), _mm256_mul_ps(Y, Y)) };
+	const __m256 outside{ _mm256_cmp_ps(t, _mm256_setzero_ps(), _CMP_LT_OQ) };
+
+	t = _mm256_mul_ps(t, t);
+
+	const __m256 contribution{ _mm256_mul_ps(_mm256_mul_ps(t, t), SimplexGradientAVX2(hash, X, Y)) };
+
+	return _mm256_andnot_ps(outside, contribution);
+}
+
+/*
+*	Generates eight points of simplex noise, matching SimplexNoise::Generate2D().
+*/
+FORCE_INLINE NO_DISCARD __m256 SimplexNoiseAVX2(const __m256 X, const __m256 Y, const Vector2<float32> &offset) NOEXCEPT
+{
+	const int32 *const RESTRICT P{ BatchNoiseData::SIMPLEX_PERMUTATIONS._Permutations };
+	const __m256i BYTE_MASK{ _mm256_set1_epi32(255) };
+	const __m256i ONE{ _mm256_set1_epi32(1) };
+	const __m256 G2{ _mm256_set1_ps(SimplexNoiseConstants::G2) };
+
+	const __m256 offset_x{ _mm256_add_ps(X, _mm256_set1_ps(offset._X)) };
+	const __m256 offset_y{ _mm256_add_ps(Y, _mm256_set1_ps(offset._Y)) };
+
+	const __m256 s{ _mm256_mul_ps(_mm256_add_ps(offset_x, offset_y), _mm256_set1_ps(SimplexNoiseConstants::F2)) };
+	const __m256i i{ FloorAVX2(_mm256_add_ps(offset_x, s)) };
+	const __m256i j{ FloorAVX2(_mm256_add_ps(offset_y, s)) };
+
+	const __m256 t{ _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_add_epi32(i, j)), G2) };
+	const __m256 x0{ _mm256_sub_ps(offset_x, _mm256_sub_ps(_mm256_cvtepi32_ps(i), t)) };
+	const __m256 y0{ _mm256_sub_ps(offset_y, _mm256_sub_ps(_mm256_cvtepi32_ps(j), t)) };
+
+	//The comparison mask is all ones where x0 > y0, which as an integer is -1.
+	const __m256i x_greater{ _mm256_castps_si256(_mm256_cmp_ps(x0, y0, _CMP_GT_OQ)) };
+	const __m256i i1{ _mm256_sub_epi32(_mm256_setzero_si256(), x_greater) };
+	const __m256i j1{ _mm256_sub_epi32(ONE, i1) };
+
+	const __m256 x1{ _mm256_add_ps(_mm256_sub_ps(x0, _mm256_cvtepi32_ps(i1)), G2) };
+	const __m256 y1{ _mm256_add_ps(_mm256_sub_ps(y0, _mm256_cvtepi32_ps(j1)), G2) };
+	const __m256 x2{ _mm256_add_ps(_mm256_sub_ps(x0, _mm256_set1_ps(1.0f)), _mm256_set1_ps(2.0f * SimplexNoiseConstants::G2)) };
+	const __m256 y2{ _mm256_add_ps(_mm256_sub_ps(y0, _mm256_set1_ps(1.0f)), _mm256_set1_ps(2.0f * SimplexNoiseConstants::G2)) };
+
+	const __m256i ii{ _mm256_and_si256(i, BYTE_MASK) };
+	const __m256i jj{ _mm256_and_si256(j, BYTE_MASK) };
+
+	const __m256i hash_0{ _mm256_i32gather_epi32(P, _mm256_add_epi32(ii, _mm256_i32gather_epi32(P, jj, 4)), 4) };
+	const __m256i hash_1{ _mm256_i32gather_epi32(P, _mm256_add_epi32(_mm256_add_epi32(ii, i1), _mm256_i32gather_epi32(P, _mm256_add_epi32(jj, j1), 4)), 4) };
+	const __m256i hash_2{ _mm256_i32gather_epi32(P, _mm256_add_epi32(_mm256_add_epi32(ii, ONE), _mm256_i32gather_epi32(P, _mm256_add_epi32(jj, ONE), 4)), 4) };
+
+	const __m256 n0{ SimplexCornerAVX2(hash_0, x0, y0) };
+	const __m256 n1{ SimplexCornerAVX2(hash_1, x1, y1) };
+	const __m256 n2{ SimplexCornerAVX2(hash_2, x2, y2) };
+
+	return _mm256_mul_ps(_mm256_set1_ps(40.0f), _mm256_add_ps(_mm256_add_ps(n0, n1), n2));
+}
+
+/*
+*	Generates a single octave of noise for each point, with a per-call offset (only used by SIMPLEX) and seed (only used by VALUE).
+*/
+FORCE_INLINE void GenerateOctave
+(
+	const BatchNoise::Type type,
+	const float32 *const RESTRICT X,
+	const float32 *const RESTRICT Y,
+	const float32 *const RESTRICT Z,
+	const uint64 number_of_points,
+	const Vector2<float32> &offset,
+	const float32 seed,
+	float32 *const RESTRICT output
+) NOEXCEPT
+{
+	const bool use_avx2{ SIMD::GetBackend() == SIMD::Backend::AVX2 };
+	uint64 i{ 0 };
+
+	switch (type)
+	{
+		case BatchNoise::Type::PERLIN:
+		{
+			if (use_avx2)
+			{
+				for (; (i + 8) <= number_of_points; i += 8)
+				{
+					_mm256_storeu_ps(&output[i], PerlinNoiseAVX2(_mm256_loadu_ps(&X[i]), _mm256_loadu_ps(&Y[i]), _mm256_loadu_ps(&Z[i])));
+				}
+			}
+
+			for (; i < number_of_points; ++i)
+			{
+				output[i] = PerlinNoise::Generate(X[i], Y[i], Z[i]);
+			}
+
+			break;
+		}
+
+		case BatchNoise::Type::SIMPLEX:
+		{
+			if (use_avx2)
+			{
+				for (; (i + 8) <= number_of_points; i += 8)
+				{
+					_mm256_storeu_ps(&output[i], SimplexNoiseAVX2(_mm256_loadu_ps(&X[i]), _mm256_loadu_ps(&Y[i]), offset));
+				}
+			}
+
+			for (; i < number_of_points; ++i)
+			{
+				output[i] = SimplexNoise::Generate2D(Vector2<float32>(X[i], Y[i]), offset);
+			}
+
+			break;
+		}
+
+		case BatchNoise::Type::VALUE:
+		{
+			for (; i < number_of_points; ++i)
+			{
+				output[i] = ValueNoise::Generate(X[i], Y[i], seed);
+			}
+
+			break;
+		}
+
+		case BatchNoise::Type::DERIVATIVE:
+		{
+			for (; i < number_of_points; ++i)
+			{
+				output[i] = DerivativeNoise::Generate(Vector2<float32>(X[i], Y[i]));
+			}
+
+			break;
+		}
+
+		default:
+		{
+			ASSERT(false, "Invalid case!");
+
+			break;
+		}
+	}
+}
+
+/*
+*	Generates fractal noise for a chunk of at most CHUNK_SIZE points.
+*/
+FORCE_INLINE void GenerateFractalChunk
+(
+	const BatchNoise::FractalParameters &parameters,
+	const float32 *const RESTRICT X,
+	const float32 *const RESTRICT Y,
+	const float32 *const RESTRICT Z,
+	const uint64 number_of_points,
+	float32 *const RESTRICT output
+) NOEXCEPT
+{
+	float32 scaled_x[BatchNoiseConstants::CHUNK_SIZE];
+	float32 scaled_y[BatchNoiseConstants::CHUNK_SIZE];
+	float32 scaled_z[BatchNoiseConstants::CHUNK_SIZE];
+	float32 octave_values[BatchNoiseConstants::CHUNK_SIZE];
+
+	//PERLIN is a plain weighted sum, the others are normalized by the total amplitude, matching their scalar counterparts.
+	const bool normalize{ parameters._Type != BatchNoise::Type::PERLIN };
+	const float32 seed{ static_cast<float32>(parameters._Seed) };
+
+	Memory::Set(output, 0, sizeof(float32) * number_of_points);
+
+	float32 frequency{ 1.0f };
+	float32 amplitude{ 1.0f };
+	float32 total{ 0.0f };
+
+	for (uint8 octave_index{ 0 }; octave_index < parameters._NumberOfOctaves; ++octave_index)
+	{
+		for (uint64 i{ 0 }; i < number_of_points; ++i)
+		{
+			scaled_x[i] = X[i] * frequency;
+			scaled_y[i] = Y[i] * frequency;
+		}
+
+		if (parameters._Type == BatchNoise::Type::PERLIN)
+		{
+			for (uint64 i{ 0 }; i < number_of_points; ++i)
+			{
+				scaled_z[i] = Z[i] * frequency;
+			}
+		}
+
+		const Vector2<float32> offset{ parameters._Type == BatchNoise::Type::SIMPLEX ? parameters._Offsets[octave_index] : Vector2<float32>(0.0f, 0.0f) };
+
+		GenerateOctave(parameters._Type, scaled_x, scaled_y, scaled_z, number_of_points, offset, seed, octave_values);
+
+		switch (parameters._Fractal)
+		{
+			case BatchNoise::Fractal::STANDARD:
+			{
+				if (normalize)
+				{
+					for (uint64 i{ 0 }; i < number_of_points; ++i)
+					{
+						output[i] += (octave_values[i] * 0.5f + 0.5f) * amplitude;
+					}
+				}
+
+				else
+				{
+					for (uint64 i{ 0 }; i < number_of_points; ++i)
+					{
+						output[i] += octave_values[i] * amplitude;
+					}
+				}
+
+				break;
+			}
+
+			case BatchNoise::Fractal::RIDGED:
+			{
+				for (uint64 i{ 0 }; i < number_of_points; ++i)
+				{
+					output[i] += (1.0f - BaseMath::Absolute(octave_values[i])) * amplitude;
+				}
+
+				break;
+			}
+
+			case BatchNoise::Fractal::BILLOWED:
+			{
+				for (uint64 i{ 0 }; i < number_of_points; ++i)
+				{
+					output[i] += BaseMath::Absolute(octave_values[i]) * amplitude;
+				}
+
+				break;
+			}
+
+			default:
+			{
+				ASSERT(false, "Invalid case!");
+
+				break;
+			}
+		}
+
+		total += amplitude;
+		frequency *= parameters._Lacunarity;
+		amplitude *= parameters._Gain;
+	}
+
+	if (normalize)
+	{
+		for (uint64 i{ 0 }; i < number_of_points; ++i)
+		{
+			output[i] /= total;
+		}
+	}
+}
+
+/*
+*	Generates a single octave of noise for each point.
+*	'Z' is only read for PERLIN noise and can be nullptr otherwise.
+*/
+void BatchNoise::Generate
+(
+	const Type type,
+	const float32 *const RESTRICT X,
+	const float32 *const RESTRICT Y,
+	const float32 *const RESTRICT Z,
+	const uint64 number_of_points,
+	float32 *const RESTRICT output
+) NOEXCEPT
+{
+	GenerateOctave(type, X, Y, Z, number_of_points, Vector2<float32>(0.0f, 0.0f), 0.0f, output);
+}
+
+/*
+*	Generates fractal noise for each point.
+*	'Z' is only read for PERLIN noise and can be nullptr otherwise.
+*/
+void BatchNoise::GenerateFractal
+(
+	const FractalParameters &parameters,
+	const float32 *const RESTRICT X,
+	const float32 *const RESTRICT Y,
+	const float32 *const RESTRICT Z,
+	const uint64 number_of_points,
+	float32 *const RESTRICT output
+) NOEXCEPT
+{
+	ASSERT(parameters._NumberOfOctaves <= MAXIMUM_NUMBER_OF_OCTAVES, "Too many octaves!");
+
+	//Derivative noise carries state between octaves, so just run it per point.
+	if (parameters._Type == Type::DERIVATIVE)
+	{
+		for (uint64 i{ 0 }; i < number_of_points; ++i)
+		{
+			output[i] = DerivativeNoise::Generate
+			(
+				Vector2<float32>(X[i], Y[i]),
+				parameters._NumberOfOctaves,
+				parameters._Lacunarity,
+				parameters._Gain,
+				parameters._DerivativeWeight,
+				parameters._Seed
+			);
+		}
+
+		return;
+	}
+
+	for (uint64 chunk_start{ 0 }; chunk_start < number_of_points; chunk_start += BatchNoiseConstants::CHUNK_SIZE)
+	{
+		const uint64 chunk_size{ BaseMath::Minimum<uint64>(BatchNoiseConstants::CHUNK_SIZE, number_of_points - chunk_start) };
+
+		GenerateFractalChunk
+		(
+			parameters,
+			&X[chunk_start],
+			&Y[chunk_start],
+			Z ? &Z[chunk_start] : nullptr,
+			chunk_size,
+			&output[chunk_start]
+		);
+	}
+}
+
+/*
+*	Fills a grid with fractal noise, with optional domain warping.
+*	'output' needs to hold width * height values, laid out row by row.
+*	Rows are split across the task system, and this function returns when the whole grid is filled.
+*/
+void BatchNoise::GenerateGrid
+(
+	const GridParameters &grid_parameters,
+	const FractalParameters &fractal_parameters,
+	const DomainWarpParameters &domain_warp_parameters,
+	float32 *const RESTRICT output
+) NOEXCEPT
+{
+	PROFILING_SCOPE("BatchNoise::GenerateGrid");
+
+	if (grid_parameters._Width == 0 || grid_parameters._Height == 0)
+	{
+		return;
+	}
+
+	//Figure out how many chunks to split the grid into.
+	const uint32 maximum_number_of_chunks{ BaseMath::Maximum<uint32>(TaskSystem::Instance->GetNumberOfTaskExecutors() * BatchNoiseConstants::CHUNKS_PER_EXECUTOR, 1) };
+	const uint32 number_of_chunks{ BaseMath::Minimum<uint32>(grid_parameters._Height, maximum_number_of_chunks) };
+
+	GridContext context;
+
+	context._GridParameters = &grid_parameters;
+	context._FractalParameters = &fractal_parameters;
+	context._DomainWarpParameters = &domain_warp_parameters;
+	context._RowsPerChunk = (grid_parameters._Height + number_of_chunks - 1) / number_of_chunks;
+	context._Output = output;
+
+	TaskSystem::ParallelFor(Task::Priority::LOW, (grid_parameters._Height + context._RowsPerChunk - 1) / context._RowsPerChunk, [](void *const RESTRICT arguments, const uint32 index)
+	{
+		const GridContext &grid_context{ *static_cast<const GridContext *const RESTRICT>(arguments) };
+		const GridParameters &grid{ *grid_context._GridParameters };
+		const FractalParameters &fractal{ *grid_context._FractalParameters };
+		const DomainWarpParameters &domain_warp{ *grid_context._DomainWarpParameters };
+		const uint32 first_row{ index * grid_context._RowsPerChunk };
+		const uint32 last_row{ BaseMath::Minimum<uint32>(first_row + grid_context._RowsPerChunk, grid._Height) };
+
+		DynamicArray<float32> X;
+		DynamicArray<float32> Y;
+		DynamicArray<float32> Z;
+		DynamicArray<float32> warp_x;
+		DynamicArray<float32> warp_y;
+		DynamicArray<float32> warp_z;
+		DynamicArray<float32> warp;
+
+		X.Resize<false>(grid._Width);
+		Y.Resize<false>(grid._Width);
+		Z.Resize<false>(grid._Width);
+
+		if (domain_warp._Strength != 0.0f)
+		{
+			warp_x.Resize<false>(grid._Width);
+			warp_y.Resize<false>(grid._Width);
+			warp_z.Resize<false>(grid._Width);
+			warp.Resize<false>(grid._Width);
+		}
+
+		for (uint32 row{ first_row }; row < last_row; ++row)
+		{
+			const float32 row_y{ grid._Origin._Y + static_cast<float32>(row) * grid._Step._Y };
+
+			for (uint32 column{ 0 }; column < grid._Width; ++column)
+			{
+				X[column] = grid._Origin._X + static_cast<float32>(column) * grid._Step._X;
+				Y[column] = row_y;
+				Z[column] = grid._Origin._Z;
+			}
+
+			if (domain_warp._Strength != 0.0f)
+			{
+				for (uint32 column{ 0 }; column < grid._Width; ++column)
+				{
+					warp_z[column] = Z[column] * domain_warp._Frequency;
+				}
+
+				//Warp the X coordinates. Both warps are sampled at the unwarped coordinates.
+				for (uint32 column{ 0 }; column < grid._Width; ++column)
+				{
+					warp_x[column] = X[column] * domain_warp._Frequency + domain_warp._XOffset._X;
+					warp_y[column] = Y[column] * domain_warp._Frequency + domain_warp._XOffset._Y;
+				}
+
+				BatchNoise::Generate(fractal._Type, warp_x.Data(), warp_y.Data(), warp_z.Data(), grid._Width, warp.Data());
+
+				for (uint32 column{ 0 }; column < grid._Width; ++column)
+				{
+					warp_x[column] = X[column] * domain_warp._Frequency + domain_warp._YOffset._X;
+					warp_y[column] = Y[column] * domain_warp._Frequency + domain_warp._YOffset._Y;
+					X[column] += warp[column] * domain_warp._Strength;
+				}
+
+				//Warp the Y coordinates.
+				BatchNoise::Generate(fractal._Type, warp_x.Data(), warp_y.Data(), warp_z.Data(), grid._Width, warp.Data());
+
+				for (uint32 column{ 0 }; column < grid._Width; ++column)
+				{
+					Y[column] += warp[column] * domain_warp._Strength;
+				}
+			}
+
+			BatchNoise::GenerateFractal(fractal, X.Data(), Y.Data(), Z.Data(), grid._Width, &grid_context._Output[static_cast<uint64>(row) * grid._Width]);
+		}
+	}, &context);
+}
\ No newline at end of file
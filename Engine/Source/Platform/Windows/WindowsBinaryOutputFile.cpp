@@ -41,6 +41,17 @@ BinaryOutputFile::BinaryOutputFile(const char *const RESTRICT file_path) NOEXCEP
 	implementation->_FilePath = file_path;
 }
 
+/*
+*	Bool operator overload. Returns if this file was opened and every write to it so far has succeeded.
+*/
+NO_DISCARD BinaryOutputFile::operator bool() const NOEXCEPT
+{
+	//Cache the implementation.
+	const WindowsBinaryOutputFileImplementation *const RESTRICT implementation{ _Implementation.Get<WindowsBinaryOutputFileImplementation>() };
+
+	return !implementation->_FileStream.fail();
+}
+
 /*
 *	Returns the file path.
 */
@@ -37,9 +37,30 @@ void Vulkan2DTexture::Initialize(const uint32 textureMipmapLevels, const uint32
 	//Set the texture texel size.
 	_TextureTexelSize = textureTexelSize;
 
-	//Figure out the compression ratio.
+	//Figure out the compression ratio, compared to uncompressed 8-bit RGBA.
 	uint32 compression_ratio{ 1 };
 
+	switch (_VulkanFormat)
+	{
+		case VkFormat::VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+		case VkFormat::VK_FORMAT_BC4_UNORM_BLOCK:
+		{
+			compression_ratio = 8;
+
+			break;
+		}
+
+		case VkFormat::VK_FORMAT_BC3_UNORM_BLOCK:
+		case VkFormat::VK_FORMAT_BC5_UNORM_BLOCK:
+		case VkFormat::VK_FORMAT_BC6H_UFLOAT_BLOCK:
+		case VkFormat::VK_FORMAT_BC7_UNORM_BLOCK:
+		{
+			compression_ratio = 4;
+
+			break;
+		}
+	}
+
 	//Create the command pool.
 	static thread_local VulkanCommandPool *const RESTRICT command_pool{ VulkanInterface::Instance->CreateAsyncTransferCommandPool(VK_COMMAND_POOL_CREATE_TRANSIENT_BIT) };
 
@@ -81,7 +102,7 @@ void Vulkan2DTexture::Initialize(const uint32 textureMipmapLevels, const uint32
 
 		for (uint32 i{ 0 }; i < textureMipmapLevels; ++i)
 		{
-			image_size += (textureWidth >> i) * (textureHeight >> i) * textureChannels * textureTexelSize / compression_ratio;
+			image_size += VulkanUtilities::CalculateMipSize(textureWidth, textureHeight, 1, i, textureChannels, textureTexelSize, compression_ratio);
 		}
 
 		//Set up the staging buffer.
@@ -101,16 +122,6 @@ void Vulkan2DTexture::Initialize(const uint32 textureMipmapLevels, const uint32
 			VULKAN_ERROR_CHECK(vmaCreateBuffer(VULKAN_MEMORY_ALLOCATOR, &buffer_info, &allocation_info, &staging_buffer, &staging_allocation, nullptr));
 		}
 
-		switch (_VulkanFormat)
-		{
-			case VkFormat::VK_FORMAT_BC7_UNORM_BLOCK:
-			{
-				compression_ratio = 4;
-
-				break;
-			}
-		}
-
 		//Copy the data into the staging buffer.
 		void* mapped_memory;
 		VULKAN_ERROR_CHECK(vmaMapMemory(VULKAN_MEMORY_ALLOCATOR, staging_allocation, &mapped_memory));
@@ -119,7 +130,7 @@ void Vulkan2DTexture::Initialize(const uint32 textureMipmapLevels, const uint32
 
 		for (uint8 i{ 0 }; i < textureMipmapLevels; ++i)
 		{
-			const VkDeviceSize mip_size{ (textureWidth >> i) * (textureHeight >> i) * textureChannels * static_cast<uint64>(textureTexelSize) / compression_ratio };
+			const VkDeviceSize mip_size{ VulkanUtilities::CalculateMipSize(textureWidth, textureHeight, 1, i, textureChannels, textureTexelSize, compression_ratio) };
 			Memory::Copy(static_cast<byte*>(mapped_memory) + current_offset, textureData[i], mip_size);
 
 			current_offset += mip_size;
@@ -243,6 +254,30 @@ void Vulkan2DTexture::Update(const void *RESTRICT const *RESTRICT texture_data)
 	vmaUnmapMemory(VULKAN_MEMORY_ALLOCATOR, _Allocation);
 }
 
+/*
+*	Updates a region of the first mip level of this texture, copying the given rectangle from the given texture data, which covers the whole first mip level.
+*/
+void Vulkan2DTexture::UpdateRegion(const void *const RESTRICT texture_data, const uint32 X, const uint32 Y, const uint32 width, const uint32 height) NOEXCEPT
+{
+	ASSERT(X + width <= _TextureWidth && Y + height <= _TextureHeight, "Region is outside of the texture!");
+
+	//Copy the rows of the region into the staging buffer. The first mip level is laid out the same way as in the texture data, so each row lands at the same offset.
+	void *mapped_memory;
+	VULKAN_ERROR_CHECK(vmaMapMemory(VULKAN_MEMORY_ALLOCATOR, _Allocation, &mapped_memory));
+
+	const VkDeviceSize texel_size{ _TextureChannels * static_cast<uint64>(_TextureTexelSize) };
+	const VkDeviceSize row_size{ width * texel_size };
+
+	for (uint32 row{ Y }; row < Y + height; ++row)
+	{
+		const VkDeviceSize offset{ ((static_cast<uint64>(row) * _TextureWidth) + X) * texel_size };
+
+		Memory::Copy(static_cast<byte*>(mapped_memory) + offset, static_cast<const byte *const RESTRICT>(texture_data) + offset, row_size);
+	}
+
+	vmaUnmapMemory(VULKAN_MEMORY_ALLOCATOR, _Allocation);
+}
+
 /*
 *	Releases this Vulkan 2D texture.
 */
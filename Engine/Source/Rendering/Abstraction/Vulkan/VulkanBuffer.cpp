@@ -46,6 +46,14 @@ void VulkanBuffer::Initialize(const VkDeviceSize size, const VkBufferUsageFlags
 */
 void VulkanBuffer::Release() NOEXCEPT
 {
+	//Unmap the memory, if it was persistently mapped.
+	if (_MappedMemory)
+	{
+		vmaUnmapMemory(VULKAN_MEMORY_ALLOCATOR, _Allocation);
+
+		_MappedMemory = nullptr;
+	}
+
 	//Destroy this Vulkan buffer.
 	vmaDestroyBuffer(VULKAN_MEMORY_ALLOCATOR, _VulkanBuffer, _Allocation);
 }
@@ -73,17 +81,14 @@ void VulkanBuffer::UploadData(const void *const RESTRICT *const RESTRICT data, c
 		//Copy the data into the buffer.
 		VkDeviceSize current_offset{ 0 };
 
-		void *mapped_memory;
-		VULKAN_ERROR_CHECK(vmaMapMemory(VULKAN_MEMORY_ALLOCATOR, _Allocation, &mapped_memory));
+		void *const RESTRICT mapped_memory{ MapMemory() };
 
 		for (uint32 i = 0; i < data_chunks; ++i)
 		{
 			Memory::Copy(static_cast<void*>(static_cast<byte*>(mapped_memory) + current_offset), data[i], data_sizes[i]);
 
-			current_offset = data_sizes[i];
+			current_offset += data_sizes[i];
 		}
-
-		vmaUnmapMemory(VULKAN_MEMORY_ALLOCATOR, _Allocation);
 	}
 
 	else
@@ -123,7 +128,7 @@ void VulkanBuffer::UploadData(const void *const RESTRICT *const RESTRICT data, c
 		{
 			Memory::Copy(static_cast<void*>(static_cast<byte*>(mapped_memory) + current_offset), data[i], data_sizes[i]);
 
-			current_offset = data_sizes[i];
+			current_offset += data_sizes[i];
 		}
 
 		vmaUnmapMemory(VULKAN_MEMORY_ALLOCATOR, staging_allocation);
@@ -135,4 +140,23 @@ void VulkanBuffer::UploadData(const void *const RESTRICT *const RESTRICT data, c
 		vmaDestroyBuffer(VULKAN_MEMORY_ALLOCATOR, staging_buffer, staging_allocation);
 	}
 }
+
+/*
+*	Maps the memory of this Vulkan buffer persistently, and returns a pointer to it.
+*	Only valid for buffers created with VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT. The memory stays mapped until this buffer is released.
+*/
+RESTRICTED NO_DISCARD void *const RESTRICT VulkanBuffer::MapMemory() NOEXCEPT
+{
+	ASSERT(TEST_BIT(_MemoryProperties, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT), "Only host visible buffers can be mapped!");
+
+	if (!_MappedMemory)
+	{
+		void *mapped_memory;
+		VULKAN_ERROR_CHECK(vmaMapMemory(VULKAN_MEMORY_ALLOCATOR, _Allocation, &mapped_memory));
+
+		_MappedMemory = mapped_memory;
+	}
+
+	return _MappedMemory;
+}
 #endif
\ No newline at end of file
@@ -326,6 +326,14 @@ void VulkanInterface::Update2DTexture(const void *RESTRICT const *RESTRICT textu
 	texture->Update(texture_data);
 }
 
+/*
+*	Updates a region of a 2D texture.
+*/
+void VulkanInterface::Update2DTextureRegion(const void *const RESTRICT texture_data, const uint32 X, const uint32 Y, const uint32 width, const uint32 height, Vulkan2DTexture *const RESTRICT texture) NOEXCEPT
+{
+	texture->UpdateRegion(texture_data, X, Y, width, height);
+}
+
 /*
 *	Destroys a 2D texture.
 */
@@ -7,6 +7,59 @@
 //Systems.
 #include <Systems/RenderingSystem.h>
 
+/*
+*	Reserves the given number of bytes, and returns a span of memory to write into.
+*	Should be called at most once per update. Grows the storage buffer geometrically if needed, which re-creates it, so the span's buffer can change between updates.
+*/
+NO_DISCARD UploadSpan StorageBufferWriter::Reserve(const uint64 size) NOEXCEPT
+{
+	ASSERT(_ReservedSize == 0, "Storage buffers should only be reserved once per update!");
+
+	/*
+	*	Re-create the buffer if necessary.
+	*	The contents are rewritten every update, so nothing needs to be copied over, and growing geometrically keeps this rare.
+	*	TODO: Shrink if necessary.
+	*/
+	if (*_BufferCapacity < size)
+	{
+		const uint64 new_capacity{ BaseMath::Maximum<uint64>(size, *_BufferCapacity * 2) };
+
+		RenderingSystem::Instance->DestroyBuffer(_Buffer);
+
+		RenderingSystem::Instance->CreateBuffer
+		(
+			new_capacity,
+			BufferUsage::StorageBuffer,
+			MemoryProperty::HostCoherent | MemoryProperty::HostVisible,
+			_Buffer
+		);
+
+		*_BufferCapacity = new_capacity;
+		*_MappedMemory = static_cast<byte *RESTRICT>(RenderingSystem::Instance->MapBuffer(*_Buffer));
+	}
+
+	_ReservedSize = size;
+
+	UploadSpan span;
+
+	span._Buffer = *_Buffer;
+	span._Size = size;
+
+	//Write into the staging data if the buffer couldn't be mapped, it's uploaded once the storage buffer function returns.
+	if (*_MappedMemory)
+	{
+		span._Data = *_MappedMemory;
+	}
+
+	else
+	{
+		_StagingData->Resize<false>(size);
+		span._Data = _StagingData->Data();
+	}
+
+	return span;
+}
+
 /*
 *	Updates the  buffer manager during the render update phase.
 */
@@ -29,51 +82,35 @@ void BufferManager::RenderUpdate() NOEXCEPT
 		);
 	}
 
-	//Upload data to all storage buffers.
+	//Update all storage buffers.
 	for (RegisteredStorageBuffer &registered_storage_buffer : _RegisteredStorageBuffers)
 	{
-		//Cache the current data.
-		BufferHandle &current_buffer{ registered_storage_buffer._Buffers[current_framebuffer_index] };
-		uint64 &current_buffer_capacity{ registered_storage_buffer._BufferCapacities[current_framebuffer_index] };
+		//Set up the writer for the current buffer.
+		StorageBufferWriter writer;
 
-		//Retrieve the data.
-		registered_storage_buffer._StorageBufferFunction(&registered_storage_buffer._Data, registered_storage_buffer._Arguments);
+		writer._Buffer = &registered_storage_buffer._Buffers[current_framebuffer_index];
+		writer._BufferCapacity = &registered_storage_buffer._BufferCapacities[current_framebuffer_index];
+		writer._MappedMemory = &registered_storage_buffer._MappedMemory[current_framebuffer_index];
+		writer._StagingData = &registered_storage_buffer._StagingData;
+		writer._ReservedSize = 0;
 
-		//Skip if there's no data.
-		if (registered_storage_buffer._Data.Empty())
-		{
-			continue;
-		}
+		//Let the storage buffer function write straight into the buffer.
+		registered_storage_buffer._StorageBufferFunction(&writer, registered_storage_buffer._Arguments);
 
-		/*
-		*	Re-create the buffer if necessary.
-		*	TODO: Shrink if necessary.
-		*/
-		if (current_buffer_capacity < registered_storage_buffer._Data.Size())
+		//Upload the staging data if the buffer couldn't be mapped.
+		if (writer._ReservedSize > 0 && !registered_storage_buffer._MappedMemory[current_framebuffer_index])
 		{
-			RenderingSystem::Instance->DestroyBuffer(&current_buffer);
+			const void *const RESTRICT data{ registered_storage_buffer._StagingData.Data() };
+			const uint64 data_size{ writer._ReservedSize };
 
-			RenderingSystem::Instance->CreateBuffer
+			RenderingSystem::Instance->UploadDataToBuffer
 			(
-				registered_storage_buffer._Data.Size(),
-				BufferUsage::StorageBuffer,
-				MemoryProperty::HostCoherent | MemoryProperty::HostVisible,
-				&current_buffer
+				&data,
+				&data_size,
+				1,
+				&registered_storage_buffer._Buffers[current_framebuffer_index]
 			);
-
-			current_buffer_capacity = registered_storage_buffer._Data.Size();
 		}
-
-		const void *const RESTRICT data{ registered_storage_buffer._Data.Data() };
-		const uint64 data_size{ registered_storage_buffer._Data.Size() };
-
-		RenderingSystem::Instance->UploadDataToBuffer
-		(
-			&data,
-			&data_size,
-			1,
-			&current_buffer
-		);
 	}
 }
 
@@ -147,6 +184,13 @@ void BufferManager::RegisterStorageBuffer
 	{
 		buffer_capacity = initial_capacity;
 	}
+
+	new_registered_storage_buffer._MappedMemory.Upsize<false>(RenderingSystem::Instance->GetNumberOfFramebuffers());
+
+	for (uint64 i{ 0 }; i < new_registered_storage_buffer._Buffers.Size(); ++i)
+	{
+		new_registered_storage_buffer._MappedMemory[i] = static_cast<byte *RESTRICT>(RenderingSystem::Instance->MapBuffer(new_registered_storage_buffer._Buffers[i]));
+	}
 }
 
 /*
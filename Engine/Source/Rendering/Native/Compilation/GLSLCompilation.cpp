@@ -1,12 +1,127 @@
 //Header file.
 #include <Rendering/Native/Compilation/GLSLCompilation.h>
 
+//Core.
+#include <Core/Algorithms/HashAlgorithms.h>
+
+//File.
+#include <File/Core/BinaryInputFile.h>
+#include <File/Core/BinaryOutputFile.h>
+#include <File/Core/File.h>
+
 //Systems.
 #include <Systems/LogSystem.h>
 
 //Third party.
 #include <vulkan/shaderc/shaderc.h>
 
+//STL.
+#include <filesystem>
+
+/*
+*	Compile options class definition.
+*	Holds everything that shaders are compiled with. The cache key is calculated from this, so any change to the options invalidates the cache.
+*/
+class CompileOptions final
+{
+
+public:
+
+	//The source language.
+	shaderc_source_language _SourceLanguage;
+
+	//The optimization level.
+	shaderc_optimization_level _OptimizationLevel;
+
+	//Denotes whether or not to generate debug info.
+	bool _GenerateDebugInfo;
+
+	//The target environment.
+	shaderc_target_env _TargetEnvironment;
+
+	//The target environment version.
+	shaderc_env_version _TargetEnvironmentVersion;
+
+	//Denotes whether or not to treat warnings as errors.
+	bool _WarningsAsErrors;
+
+	/*
+	*	Applies these options to the given shaderc options.
+	*/
+	FORCE_INLINE void Apply(shaderc_compile_options_t options) const NOEXCEPT
+	{
+		shaderc_compile_options_set_source_language(options, _SourceLanguage);
+		shaderc_compile_options_set_optimization_level(options, _OptimizationLevel);
+
+		if (_GenerateDebugInfo)
+		{
+			shaderc_compile_options_set_generate_debug_info(options);
+		}
+
+		shaderc_compile_options_set_target_env(options, _TargetEnvironment, _TargetEnvironmentVersion);
+
+		if (_WarningsAsErrors)
+		{
+			shaderc_compile_options_set_warnings_as_errors(options);
+		}
+	}
+
+	/*
+	*	Returns the hash of these options, including the SPIR-V version of the compiler, so updating shaderc invalidates the cache as well.
+	*	Each member is hashed on it's own, so padding never ends up in the hash.
+	*/
+	FORCE_INLINE NO_DISCARD uint64 Hash() const NOEXCEPT
+	{
+		unsigned int spirv_version{ 0 };
+		unsigned int spirv_revision{ 0 };
+
+		shaderc_get_spv_version(&spirv_version, &spirv_revision);
+
+		uint64 hash{ HashAlgorithms::MurmurHash64(&spirv_version, sizeof(spirv_version)) };
+
+		hash = HashAlgorithms::MurmurHash64(&spirv_revision, sizeof(spirv_revision), hash);
+		hash = HashAlgorithms::MurmurHash64(&_SourceLanguage, sizeof(_SourceLanguage), hash);
+		hash = HashAlgorithms::MurmurHash64(&_OptimizationLevel, sizeof(_OptimizationLevel), hash);
+		hash = HashAlgorithms::MurmurHash64(&_GenerateDebugInfo, sizeof(_GenerateDebugInfo), hash);
+		hash = HashAlgorithms::MurmurHash64(&_TargetEnvironment, sizeof(_TargetEnvironment), hash);
+		hash = HashAlgorithms::MurmurHash64(&_TargetEnvironmentVersion, sizeof(_TargetEnvironmentVersion), hash);
+		hash = HashAlgorithms::MurmurHash64(&_WarningsAsErrors, sizeof(_WarningsAsErrors), hash);
+
+		return hash;
+	}
+
+};
+
+//GLSL compilation constants.
+namespace GLSLCompilationConstants
+{
+	//The options that shaders are compiled with.
+	constexpr CompileOptions COMPILE_OPTIONS
+	{
+		shaderc_source_language::shaderc_source_language_glsl,
+#if 0
+		shaderc_optimization_level::shaderc_optimization_level_zero,
+		true,
+#else
+		shaderc_optimization_level::shaderc_optimization_level_performance,
+		false,
+#endif
+		shaderc_target_env::shaderc_target_env_vulkan,
+		shaderc_env_version::shaderc_env_version_vulkan_1_4,
+		true
+	};
+}
+
+/*
+*	Returns the shared shaderc compiler. Compiling is thread safe, so all threads share one.
+*/
+FORCE_INLINE NO_DISCARD static shaderc_compiler_t SharedCompiler() NOEXCEPT
+{
+	static const shaderc_compiler_t COMPILER{ shaderc_compiler_initialize() };
+
+	return COMPILER;
+}
+
 /*
 *	Compiles a GLSL shader of the given shader stage with the given lines.
 */
@@ -111,37 +226,67 @@ NO_DISCARD bool GLSLCompilation::Compile(const CompileParameters &parameters) NO
 		}
 	}
 
-	//Initialize the compiler.
-	shaderc_compiler_t compiler{ shaderc_compiler_initialize() };
+	//Calculate the cache key, from the final source, the shader stage and the compile options.
+	char cache_file_path[MAXIMUM_FILE_PATH_LENGTH];
 
-	//Initialize the options.
-	shaderc_compile_options_t options{ shaderc_compile_options_initialize() };
+	if (parameters._CacheHit)
+	{
+		*parameters._CacheHit = false;
+	}
 
-	//Set the source language.
-	shaderc_compile_options_set_source_language(options, shaderc_source_language::shaderc_source_language_glsl);
+	if (parameters._CacheDirectoryPath)
+	{
+		uint64 cache_key{ GLSLCompilationConstants::COMPILE_OPTIONS.Hash() };
 
-	//Set the optimization level.
-#if 0
-	shaderc_compile_options_set_optimization_level(options, shaderc_optimization_level::shaderc_optimization_level_zero);
-	shaderc_compile_options_set_generate_debug_info(options);
-#else
-	shaderc_compile_options_set_optimization_level(options, shaderc_optimization_level::shaderc_optimization_level_performance);
-#endif
+		cache_key = HashAlgorithms::MurmurHash64(static_cast<const void *const RESTRICT>(&shader_kind), sizeof(shaderc_shader_kind), cache_key);
+		cache_key = HashAlgorithms::MurmurHash64(shader_source.Data(), shader_source.Size(), cache_key);
+
+		sprintf_s(cache_file_path, "%s\\%016llx.spv", parameters._CacheDirectoryPath, cache_key);
+
+		//Read the shader from the cache, if it's there.
+		if (File::Exists(cache_file_path))
+		{
+			BinaryInputFile cache_file{ cache_file_path };
 
-	//Set the target environment.
-	shaderc_compile_options_set_target_env(options, shaderc_target_env::shaderc_target_env_vulkan, shaderc_env_version::shaderc_env_version_vulkan_1_4);
+			const uint64 cache_file_size{ cache_file.Size() };
 
-	//Set warnings as errors.
-	shaderc_compile_options_set_warnings_as_errors(options);
+			parameters._OutputData->Upsize<false>(cache_file_size);
+			cache_file.Read(parameters._OutputData->Data(), cache_file_size);
+			cache_file.Close();
+
+			if (parameters._CacheHit)
+			{
+				*parameters._CacheHit = true;
+			}
+
+			return true;
+		}
+	}
+
+	//Retrieve the compiler.
+	shaderc_compiler_t compiler{ SharedCompiler() };
+
+	//Initialize the options.
+	shaderc_compile_options_t options{ shaderc_compile_options_initialize() };
+
+	//Apply the compile options.
+	GLSLCompilationConstants::COMPILE_OPTIONS.Apply(options);
 
 	//Compile!
 	shaderc_compilation_result_t result{ shaderc_compile_into_spv(compiler, shader_source.Data(), shader_source.Size(), shader_kind, parameters._InputFilePath, "main", options) };
 
-	//Check for errors.
-	if (shaderc_result_get_num_errors(result) > 0)
+	//Release the options.
+	shaderc_compile_options_release(options);
+
+	//Check for errors. Failed shaders are never written to the cache, so they are compiled again next time.
+	if (shaderc_result_get_compilation_status(result) != shaderc_compilation_status::shaderc_compilation_status_success
+		|| shaderc_result_get_length(result) == 0)
 	{
-		LOG_ERROR(shaderc_result_get_error_message(result));
-		ASSERT(false, "Error!");
+		LOG_ERROR("Failed to compile %s: %s", parameters._InputFilePath, shaderc_result_get_error_message(result));
+
+		shaderc_result_release(result);
+
+		parameters._OutputData->Clear();
 
 		return false;
 	}
@@ -153,5 +298,27 @@ NO_DISCARD bool GLSLCompilation::Compile(const CompileParameters &parameters) NO
 	parameters._OutputData->Upsize<false>(compiled_file_size);
 	Memory::Copy(parameters._OutputData->Data(), shaderc_result_get_bytes(result), compiled_file_size);
 
+	//Release the result.
+	shaderc_result_release(result);
+
+	//Write the shader to the cache. Goes through a temporary file, so other threads never read a partially written shader.
+	if (parameters._CacheDirectoryPath)
+	{
+		std::error_code error_code;
+		std::filesystem::create_directories(parameters._CacheDirectoryPath, error_code);
+
+		char temporary_file_path[MAXIMUM_FILE_PATH_LENGTH];
+		sprintf_s(temporary_file_path, "%s.%p.tmp", cache_file_path, static_cast<const void *const RESTRICT>(parameters._OutputData));
+
+		{
+			BinaryOutputFile cache_file{ temporary_file_path };
+
+			cache_file.Write(parameters._OutputData->Data(), compiled_file_size);
+			cache_file.Close();
+		}
+
+		std::filesystem::rename(temporary_file_path, cache_file_path, error_code);
+	}
+
 	return true;
 }
\ No newline at end of file
@@ -0,0 +1,681 @@
+//Header file.
+#include <Rendering/Native/CubemapFiltering.h>
+
+//Core.
+#include <Core/General/SIMD.h>
+
+//Math.
+#include <Math/Core/BaseMath.h>
+#include <Math/Noise/HammersleySequence.h>
+
+//Systems.
+#include <Systems/TaskSystem.h>
+
+//Cubemap filtering constants.
+namespace CubemapFilteringConstants
+{
+	//The inverse of atan, used to map directions to equirectangular coordinates.
+	constexpr Vector2<float32> INVERSE_ATAN{ 0.1591f, 0.3183f };
+
+	//The bias added to the mip level picked for each sample. Trades a bit of blur for less aliasing.
+	constexpr float32 MIP_LEVEL_BIAS{ 1.0f };
+
+	//The inverse of the natural logarithm of two.
+	constexpr float32 INVERSE_LOGARITHM_OF_TWO{ 1.442'695f };
+
+	//The spherical harmonics basis constants.
+	constexpr float32 SPHERICAL_HARMONICS_BAND_0{ 0.282'095f };
+	constexpr float32 SPHERICAL_HARMONICS_BAND_1{ 0.488'603f };
+	constexpr float32 SPHERICAL_HARMONICS_BAND_2_A{ 1.092'548f };
+	constexpr float32 SPHERICAL_HARMONICS_BAND_2_B{ 0.315'392f };
+	constexpr float32 SPHERICAL_HARMONICS_BAND_2_C{ 0.546'274f };
+
+	//The cosine lobe convolution factors of each band.
+	constexpr float32 COSINE_LOBE_BAND_0{ BaseMathConstants::PI };
+	constexpr float32 COSINE_LOBE_BAND_1{ BaseMathConstants::PI * 2.0f / 3.0f };
+	constexpr float32 COSINE_LOBE_BAND_2{ BaseMathConstants::PI * 0.25f };
+}
+
+/*
+*	Equirectangular context class definition.
+*/
+class EquirectangularContext final
+{
+
+public:
+
+	//The texture.
+	const Texture2D<Vector4<float32>> *RESTRICT _Texture;
+
+	//The output.
+	TextureCube *RESTRICT _Output;
+
+	//The resolution.
+	uint32 _Resolution;
+
+};
+
+/*
+*	Downsample context class definition.
+*/
+class DownsampleContext final
+{
+
+public:
+
+	//The source.
+	const TextureCube *RESTRICT _Source;
+
+	//The output.
+	TextureCube *RESTRICT _Output;
+
+	//The resolution of the output.
+	uint32 _Resolution;
+
+};
+
+/*
+*	Specular context class definition.
+*	Holds the importance samples in tangent space, as a structure of arrays.
+*/
+class SpecularContext final
+{
+
+public:
+
+	//The mip chain.
+	const DynamicArray<TextureCube> *RESTRICT _MipChain;
+
+	//The output.
+	TextureCube *RESTRICT _Output;
+
+	//The resolution of the output.
+	uint32 _Resolution;
+
+	//The X components of the sample directions.
+	DynamicArray<float32> _X;
+
+	//The Y components of the sample directions.
+	DynamicArray<float32> _Y;
+
+	//The Z components of the sample directions.
+	DynamicArray<float32> _Z;
+
+	//The mip level to sample each direction at.
+	DynamicArray<float32> _MipLevels;
+
+};
+
+/*
+*	Spherical harmonics context class definition.
+*/
+class SphericalHarmonicsContext final
+{
+
+public:
+
+	//The texture.
+	const TextureCube *RESTRICT _Texture;
+
+	//The resolution.
+	uint32 _Resolution;
+
+	//The coefficients of each face row, summed up afterwards in a fixed order to stay deterministic.
+	StaticArray<Vector3<float32>, 9> *RESTRICT _RowCoefficients;
+
+	//The solid angle of each face row.
+	float32 *RESTRICT _RowSolidAngles;
+
+};
+
+/*
+*	Diffuse context class definition.
+*/
+class DiffuseContext final
+{
+
+public:
+
+	//The coefficients, already convolved with the cosine lobe.
+	StaticArray<Vector3<float32>, 9> _Coefficients;
+
+	//The output.
+	TextureCube *RESTRICT _Output;
+
+	//The resolution.
+	uint32 _Resolution;
+
+};
+
+/*
+*	Calculates the face index and normalized coordinate of the given direction. The inverse of CubemapFiltering::FaceDirection().
+*/
+FORCE_INLINE static void FaceCoordinate(const Vector3<float32> &direction, uint8 *const RESTRICT face_index, Vector2<float32> *const RESTRICT normalized_coordinate) NOEXCEPT
+{
+	const float32 absolute_x{ BaseMath::Absolute(direction._X) };
+	const float32 absolute_y{ BaseMath::Absolute(direction._Y) };
+	const float32 absolute_z{ BaseMath::Absolute(direction._Z) };
+
+	float32 A;
+	float32 B;
+
+	if (absolute_x >= absolute_y && absolute_x >= absolute_z)
+	{
+		const float32 scale{ 1.0f / absolute_x };
+
+		*face_index = direction._X < 0.0f ? 0 : 1;
+		A = direction._X < 0.0f ? direction._Z * scale : -direction._Z * scale;
+		B = direction._Y * scale;
+	}
+
+	else if (absolute_y >= absolute_z)
+	{
+		const float32 scale{ 1.0f / absolute_y };
+
+		*face_index = direction._Y < 0.0f ? 2 : 3;
+		A = -direction._X * scale;
+		B = direction._Y < 0.0f ? -direction._Z * scale : direction._Z * scale;
+	}
+
+	else
+	{
+		const float32 scale{ 1.0f / absolute_z };
+
+		*face_index = direction._Z < 0.0f ? 4 : 5;
+		A = direction._Z < 0.0f ? -direction._X * scale : direction._X * scale;
+		B = direction._Y * scale;
+	}
+
+	normalized_coordinate->_X = A * 0.5f + 0.5f;
+	normalized_coordinate->_Y = B * 0.5f + 0.5f;
+}
+
+/*
+*	Returns the normalized coordinate of the center of the given texel.
+*/
+FORCE_INLINE NO_DISCARD static Vector2<float32> TexelCenter(const uint32 X, const uint32 Y, const uint32 resolution) NOEXCEPT
+{
+	return Vector2<float32>
+	(
+		(static_cast<float32>(X) + 0.5f) / static_cast<float32>(resolution),
+		(static_cast<float32>(Y) + 0.5f) / static_cast<float32>(resolution)
+	);
+}
+
+/*
+*	Returns the solid angle covered by the texel at the given normalized coordinate.
+*/
+FORCE_INLINE NO_DISCARD static float32 TexelSolidAngle(const Vector2<float32> &normalized_coordinate, const uint32 resolution) NOEXCEPT
+{
+	const float32 A{ normalized_coordinate._X * 2.0f - 1.0f };
+	const float32 B{ normalized_coordinate._Y * 2.0f - 1.0f };
+	const float32 texel_size{ 2.0f / static_cast<float32>(resolution) };
+	const float32 distance_squared{ 1.0f + A * A + B * B };
+
+	return (texel_size * texel_size) / (distance_squared * BaseMath::SquareRoot(distance_squared));
+}
+
+/*
+*	Calculates the spherical harmonics basis in the given direction.
+*/
+FORCE_INLINE static void SphericalHarmonicsBasis(const Vector3<float32> &direction, StaticArray<float32, 9> *const RESTRICT basis) NOEXCEPT
+{
+	(*basis)[0] = CubemapFilteringConstants::SPHERICAL_HARMONICS_BAND_0;
+	(*basis)[1] = CubemapFilteringConstants::SPHERICAL_HARMONICS_BAND_1 * direction._Y;
+	(*basis)[2] = CubemapFilteringConstants::SPHERICAL_HARMONICS_BAND_1 * direction._Z;
+	(*basis)[3] = CubemapFilteringConstants::SPHERICAL_HARMONICS_BAND_1 * direction._X;
+	(*basis)[4] = CubemapFilteringConstants::SPHERICAL_HARMONICS_BAND_2_A * direction._X * direction._Y;
+	(*basis)[5] = CubemapFilteringConstants::SPHERICAL_HARMONICS_BAND_2_A * direction._Y * direction._Z;
+	(*basis)[6] = CubemapFilteringConstants::SPHERICAL_HARMONICS_BAND_2_B * (3.0f * direction._Z * direction._Z - 1.0f);
+	(*basis)[7] = CubemapFilteringConstants::SPHERICAL_HARMONICS_BAND_2_A * direction._X * direction._Z;
+	(*basis)[8] = CubemapFilteringConstants::SPHERICAL_HARMONICS_BAND_2_C * (direction._X * direction._X - direction._Y * direction._Y);
+}
+
+/*
+*	Rotates the given tangent space directions into the space of the given basis, as a structure of arrays.
+*/
+FORCE_INLINE static void RotateDirections
+(
+	const float32 *const RESTRICT X,
+	const float32 *const RESTRICT Y,
+	const float32 *const RESTRICT Z,
+	const uint64 length,
+	const Vector3<float32> &tangent,
+	const Vector3<float32> &bitangent,
+	const Vector3<float32> &normal,
+	float32 *const RESTRICT output_x,
+	float32 *const RESTRICT output_y,
+	float32 *const RESTRICT output_z
+) NOEXCEPT
+{
+	uint64 i{ 0 };
+
+	switch (SIMD::GetBackend())
+	{
+		case SIMD::Backend::NONE:
+		{
+			break;
+		}
+
+		case SIMD::Backend::SSE2:
+		{
+			const __m128 tangent_x{ _mm_set1_ps(tangent._X) }, tangent_y{ _mm_set1_ps(tangent._Y) }, tangent_z{ _mm_set1_ps(tangent._Z) };
+			const __m128 bitangent_x{ _mm_set1_ps(bitangent._X) }, bitangent_y{ _mm_set1_ps(bitangent._Y) }, bitangent_z{ _mm_set1_ps(bitangent._Z) };
+			const __m128 normal_x{ _mm_set1_ps(normal._X) }, normal_y{ _mm_set1_ps(normal._Y) }, normal_z{ _mm_set1_ps(normal._Z) };
+
+			for (; (i + 4) <= length; i += 4)
+			{
+				const __m128 _X{ _mm_loadu_ps(&X[i]) };
+				const __m128 _Y{ _mm_loadu_ps(&Y[i]) };
+				const __m128 _Z{ _mm_loadu_ps(&Z[i]) };
+
+				_mm_storeu_ps(&output_x[i], _mm_add_ps(_mm_add_ps(_mm_mul_ps(tangent_x, _X), _mm_mul_ps(bitangent_x, _Y)), _mm_mul_ps(normal_x, _Z)));
+				_mm_storeu_ps(&output_y[i], _mm_add_ps(_mm_add_ps(_mm_mul_ps(tangent_y, _X), _mm_mul_ps(bitangent_y, _Y)), _mm_mul_ps(normal_y, _Z)));
+				_mm_storeu_ps(&output_z[i], _mm_add_ps(_mm_add_ps(_mm_mul_ps(tangent_z, _X), _mm_mul_ps(bitangent_z, _Y)), _mm_mul_ps(normal_z, _Z)));
+			}
+
+			break;
+		}
+
+		case SIMD::Backend::AVX2:
+		{
+			const __m256 tangent_x{ _mm256_set1_ps(tangent._X) }, tangent_y{ _mm256_set1_ps(tangent._Y) }, tangent_z{ _mm256_set1_ps(tangent._Z) };
+			const __m256 bitangent_x{ _mm256_set1_ps(bitangent._X) }, bitangent_y{ _mm256_set1_ps(bitangent._Y) }, bitangent_z{ _mm256_set1_ps(bitangent._Z) };
+			const __m256 normal_x{ _mm256_set1_ps(normal._X) }, normal_y{ _mm256_set1_ps(normal._Y) }, normal_z{ _mm256_set1_ps(normal._Z) };
+
+			for (; (i + 8) <= length; i += 8)
+			{
+				const __m256 _X{ _mm256_loadu_ps(&X[i]) };
+				const __m256 _Y{ _mm256_loadu_ps(&Y[i]) };
+				const __m256 _Z{ _mm256_loadu_ps(&Z[i]) };
+
+				_mm256_storeu_ps(&output_x[i], _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(tangent_x, _X), _mm256_mul_ps(bitangent_x, _Y)), _mm256_mul_ps(normal_x, _Z)));
+				_mm256_storeu_ps(&output_y[i], _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(tangent_y, _X), _mm256_mul_ps(bitangent_y, _Y)), _mm256_mul_ps(normal_y, _Z)));
+				_mm256_storeu_ps(&output_z[i], _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(tangent_z, _X), _mm256_mul_ps(bitangent_z, _Y)), _mm256_mul_ps(normal_z, _Z)));
+			}
+
+			break;
+		}
+
+		default:
+		{
+			ASSERT(false, "Invalid case!");
+
+			break;
+		}
+	}
+
+	//Do the remainder.
+	for (; i < length; ++i)
+	{
+		output_x[i] = tangent._X * X[i] + bitangent._X * Y[i] + normal._X * Z[i];
+		output_y[i] = tangent._Y * X[i] + bitangent._Y * Y[i] + normal._Y * Z[i];
+		output_z[i] = tangent._Z * X[i] + bitangent._Z * Y[i] + normal._Z * Z[i];
+	}
+}
+
+/*
+*	Returns the direction of the given normalized coordinate on the given face.
+*/
+NO_DISCARD Vector3<float32> CubemapFiltering::FaceDirection(const uint8 face_index, const Vector2<float32> &normalized_coordinate) NOEXCEPT
+{
+	const float32 A{ normalized_coordinate._X * 2.0f - 1.0f };
+	const float32 B{ normalized_coordinate._Y * 2.0f - 1.0f };
+
+	Vector3<float32> direction;
+
+	switch (face_index)
+	{
+		case 0: direction = Vector3<float32>(-1.0f, B, A); break; //Front.
+		case 1: direction = Vector3<float32>(1.0f, B, -A); break; //Back.
+		case 2: direction = Vector3<float32>(-A, -1.0f, -B); break; //Up.
+		case 3: direction = Vector3<float32>(-A, 1.0f, B); break; //Down.
+		case 4: direction = Vector3<float32>(-A, B, -1.0f); break; //Right.
+		case 5: direction = Vector3<float32>(A, B, 1.0f); break; //Left.
+		default: ASSERT(false, "Invalid case!"); break;
+	}
+
+	return Vector3<float32>::Normalize(direction);
+}
+
+/*
+*	Samples the given mip chain in the given direction at the given, possibly fractional, mip level.
+*	Filters linearly within each face and between mip levels.
+*/
+NO_DISCARD Vector4<float32> CubemapFiltering::Sample(const DynamicArray<TextureCube> &mip_chain, const Vector3<float32> &direction, const float32 mip_level) NOEXCEPT
+{
+	uint8 face_index;
+	Vector2<float32> normalized_coordinate;
+
+	FaceCoordinate(direction, &face_index, &normalized_coordinate);
+
+	//Figure out the two mip levels to blend between.
+	const float32 clamped_mip_level{ BaseMath::Clamp<float32>(mip_level, 0.0f, static_cast<float32>(mip_chain.LastIndex())) };
+	const uint64 lower_mip_level{ static_cast<uint64>(clamped_mip_level) };
+	const uint64 upper_mip_level{ BaseMath::Minimum<uint64>(lower_mip_level + 1, mip_chain.LastIndex()) };
+	const float32 mip_blend{ clamped_mip_level - static_cast<float32>(lower_mip_level) };
+
+	//Texture2D::Sample() puts texel centers on integer coordinates, so shift by half a texel.
+	const Texture2D<Vector4<float32>> &lower_face{ mip_chain[lower_mip_level].Face(face_index) };
+	const Vector4<float32> lower_sample{ lower_face.Sample(normalized_coordinate - 0.5f / static_cast<float32>(lower_face.GetWidth()), AddressMode::CLAMP_TO_EDGE) };
+
+	if (mip_blend <= 0.0f || upper_mip_level == lower_mip_level)
+	{
+		return lower_sample;
+	}
+
+	const Texture2D<Vector4<float32>> &upper_face{ mip_chain[upper_mip_level].Face(face_index) };
+	const Vector4<float32> upper_sample{ upper_face.Sample(normalized_coordinate - 0.5f / static_cast<float32>(upper_face.GetWidth()), AddressMode::CLAMP_TO_EDGE) };
+
+	return BaseMath::LinearlyInterpolate(lower_sample, upper_sample, mip_blend);
+}
+
+/*
+*	Projects the given equirectangular texture onto the given texture cube, which is expected to be initialized.
+*/
+void CubemapFiltering::FromEquirectangular(const Texture2D<Vector4<float32>> &texture, TextureCube *const RESTRICT output) NOEXCEPT
+{
+	EquirectangularContext context;
+
+	context._Texture = &texture;
+	context._Output = output;
+	context._Resolution = output->Face(0).GetWidth();
+
+	TaskSystem::ParallelFor(Task::Priority::LOW, context._Resolution * 6, [](void *const RESTRICT arguments, const uint32 index)
+	{
+		const EquirectangularContext &equirectangular_context{ *static_cast<const EquirectangularContext *const RESTRICT>(arguments) };
+		const uint8 face_index{ static_cast<uint8>(index / equirectangular_context._Resolution) };
+		const uint32 Y{ index % equirectangular_context._Resolution };
+
+		for (uint32 X{ 0 }; X < equirectangular_context._Resolution; ++X)
+		{
+			const Vector3<float32> direction{ FaceDirection(face_index, TexelCenter(X, Y, equirectangular_context._Resolution)) };
+
+			Vector2<float32> texture_coordinate{ BaseMath::ArcTangent(direction._Z, direction._X), BaseMath::ArcSine(direction._Y) };
+			texture_coordinate *= CubemapFilteringConstants::INVERSE_ATAN;
+			texture_coordinate += 0.5f;
+
+			equirectangular_context._Output->At(face_index, X, Y) = equirectangular_context._Texture->Sample(texture_coordinate, AddressMode::CLAMP_TO_EDGE);
+		}
+	}, &context);
+}
+
+/*
+*	Builds a box filtered mip chain from the given texture cube, down to a resolution of 1.
+*	This is what the prefiltering samples from, to keep the number of samples needed low.
+*/
+void CubemapFiltering::BuildMipChain(const TextureCube &texture, DynamicArray<TextureCube> *const RESTRICT mip_chain) NOEXCEPT
+{
+	const uint32 resolution{ texture.Face(0).GetWidth() };
+	uint32 number_of_mip_levels{ 1 };
+
+	while ((resolution >> number_of_mip_levels) > 0)
+	{
+		++number_of_mip_levels;
+	}
+
+	mip_chain->Clear();
+	mip_chain->Upsize<true>(number_of_mip_levels);
+
+	//The first mip level is just a copy.
+	(*mip_chain)[0].Initialize(resolution);
+
+	for (uint8 face_index{ 0 }; face_index < 6; ++face_index)
+	{
+		Memory::Copy((*mip_chain)[0].Face(face_index).Data(), texture.Face(face_index).Data(), sizeof(Vector4<float32>) * resolution * resolution);
+	}
+
+	//Average 2x2 texels for every following mip level.
+	for (uint32 mip_level{ 1 }; mip_level < number_of_mip_levels; ++mip_level)
+	{
+		DownsampleContext context;
+
+		context._Source = &(*mip_chain)[mip_level - 1];
+		context._Output = &(*mip_chain)[mip_level];
+		context._Resolution = resolution >> mip_level;
+
+		context._Output->Initialize(context._Resolution);
+
+		TaskSystem::ParallelFor(Task::Priority::LOW, context._Resolution * 6, [](void *const RESTRICT arguments, const uint32 index)
+		{
+			const DownsampleContext &downsample_context{ *static_cast<const DownsampleContext *const RESTRICT>(arguments) };
+			const uint8 face_index{ static_cast<uint8>(index / downsample_context._Resolution) };
+			const uint32 Y{ index % downsample_context._Resolution };
+			const Texture2D<Vector4<float32>> &source{ downsample_context._Source->Face(face_index) };
+
+			for (uint32 X{ 0 }; X < downsample_context._Resolution; ++X)
+			{
+				downsample_context._Output->At(face_index, X, Y) = (source.At(X * 2 + 0, Y * 2 + 0) + source.At(X * 2 + 1, Y * 2 + 0) + source.At(X * 2 + 0, Y * 2 + 1) + source.At(X * 2 + 1, Y * 2 + 1)) * 0.25f;
+			}
+		}, &context);
+	}
+}
+
+/*
+*	Prefilters the given mip chain with the GGX distribution of the given roughness into the given texture cube, which is expected to be initialized.
+*	Importance samples the distribution, picking the source mip level of each sample from it's probability density.
+*/
+void CubemapFiltering::PrefilterSpecular(const DynamicArray<TextureCube> &mip_chain, const float32 roughness, const uint32 number_of_samples, TextureCube *const RESTRICT output) NOEXCEPT
+{
+	SpecularContext context;
+
+	context._MipChain = &mip_chain;
+	context._Output = output;
+	context._Resolution = output->Face(0).GetWidth();
+
+	//Generate the samples in tangent space. Assumes the view direction is the normal, like the split sum approximation does.
+	{
+		const float32 alpha{ roughness * roughness };
+		const float32 alpha_squared{ alpha * alpha };
+		const float32 source_resolution{ static_cast<float32>(mip_chain[0].Face(0).GetWidth()) };
+		const float32 texel_solid_angle{ 4.0f * BaseMathConstants::PI / (6.0f * source_resolution * source_resolution) };
+
+		context._X.Reserve(number_of_samples);
+		context._Y.Reserve(number_of_samples);
+		context._Z.Reserve(number_of_samples);
+		context._MipLevels.Reserve(number_of_samples);
+
+		for (uint32 sample_index{ 0 }; sample_index < number_of_samples; ++sample_index)
+		{
+			//Importance sample the half vector.
+			const Vector2<float32> coordinate{ HammersleySequence::CalculateCoordinate2D(sample_index, number_of_samples) };
+
+			const float32 phi{ coordinate._X * BaseMathConstants::DOUBLE_PI };
+			const float32 cos_theta{ BaseMath::SquareRoot((1.0f - coordinate._Y) / (1.0f + (alpha_squared - 1.0f) * coordinate._Y)) };
+			const float32 sin_theta{ BaseMath::SquareRoot(1.0f - cos_theta * cos_theta) };
+
+			const Vector3<float32> half_vector{ BaseMath::Cosine(phi) * sin_theta, BaseMath::Sine(phi) * sin_theta, cos_theta };
+
+			//Reflect the view direction around it.
+			const Vector3<float32> light_direction{ 2.0f * cos_theta * half_vector._X, 2.0f * cos_theta * half_vector._Y, 2.0f * cos_theta * cos_theta - 1.0f };
+
+			if (light_direction._Z <= 0.0f)
+			{
+				continue;
+			}
+
+			//Pick the mip level where a texel covers about as much solid angle as this sample does.
+			const float32 denominator{ cos_theta * cos_theta * (alpha_squared - 1.0f) + 1.0f };
+			const float32 distribution{ alpha_squared / (BaseMathConstants::PI * denominator * denominator) };
+			const float32 probability_density{ distribution * 0.25f };
+			const float32 sample_solid_angle{ 1.0f / (static_cast<float32>(number_of_samples) * probability_density + FLOAT32_EPSILON) };
+			const float32 mip_level{ 0.5f * BaseMath::Logarithm(sample_solid_angle / texel_solid_angle) * CubemapFilteringConstants::INVERSE_LOGARITHM_OF_TWO + CubemapFilteringConstants::MIP_LEVEL_BIAS };
+
+			context._X.Emplace(light_direction._X);
+			context._Y.Emplace(light_direction._Y);
+			context._Z.Emplace(light_direction._Z);
+			context._MipLevels.Emplace(BaseMath::Maximum<float32>(mip_level, 0.0f));
+		}
+	}
+
+	TaskSystem::ParallelFor(Task::Priority::LOW, context._Resolution * 6, [](void *const RESTRICT arguments, const uint32 index)
+	{
+		const SpecularContext &specular_context{ *static_cast<const SpecularContext *const RESTRICT>(arguments) };
+		const uint8 face_index{ static_cast<uint8>(index / specular_context._Resolution) };
+		const uint32 Y{ index % specular_context._Resolution };
+		const uint64 number_of_samples{ specular_context._X.Size() };
+
+		//The sample directions in world space, reused for every texel in this row.
+		DynamicArray<float32> world_x;
+		DynamicArray<float32> world_y;
+		DynamicArray<float32> world_z;
+
+		world_x.Upsize<false>(number_of_samples);
+		world_y.Upsize<false>(number_of_samples);
+		world_z.Upsize<false>(number_of_samples);
+
+		for (uint32 X{ 0 }; X < specular_context._Resolution; ++X)
+		{
+			//Build the tangent space around the texel direction.
+			const Vector3<float32> normal{ FaceDirection(face_index, TexelCenter(X, Y, specular_context._Resolution)) };
+			const Vector3<float32> up{ BaseMath::Absolute(normal._Z) < 0.999f ? Vector3<float32>(0.0f, 0.0f, 1.0f) : Vector3<float32>(1.0f, 0.0f, 0.0f) };
+			const Vector3<float32> tangent{ Vector3<float32>::Normalize(Vector3<float32>::CrossProduct(up, normal)) };
+			const Vector3<float32> bitangent{ Vector3<float32>::CrossProduct(normal, tangent) };
+
+			RotateDirections(specular_context._X.Data(), specular_context._Y.Data(), specular_context._Z.Data(), number_of_samples, tangent, bitangent, normal, world_x.Data(), world_y.Data(), world_z.Data());
+
+			//Accumulate the samples, weighted by the cosine of the light direction.
+			Vector4<float32> total{ 0.0f, 0.0f, 0.0f, 0.0f };
+			float32 total_weight{ 0.0f };
+
+			for (uint64 sample_index{ 0 }; sample_index < number_of_samples; ++sample_index)
+			{
+				const float32 weight{ specular_context._Z[sample_index] };
+
+				total += Sample(*specular_context._MipChain, Vector3<float32>(world_x[sample_index], world_y[sample_index], world_z[sample_index]), specular_context._MipLevels[sample_index]) * weight;
+				total_weight += weight;
+			}
+
+			specular_context._Output->At(face_index, X, Y) = total_weight > 0.0f ? total / total_weight : Sample(*specular_context._MipChain, normal, 0.0f);
+		}
+	}, &context);
+}
+
+/*
+*	Projects the given texture cube onto the first nine spherical harmonics coefficients.
+*/
+void CubemapFiltering::ProjectSphericalHarmonics(const TextureCube &texture, StaticArray<Vector3<float32>, 9> *const RESTRICT coefficients) NOEXCEPT
+{
+	const uint32 resolution{ texture.Face(0).GetWidth() };
+
+	DynamicArray<StaticArray<Vector3<float32>, 9>> row_coefficients;
+	DynamicArray<float32> row_solid_angles;
+
+	row_coefficients.Upsize<false>(resolution * 6);
+	row_solid_angles.Upsize<false>(resolution * 6);
+
+	SphericalHarmonicsContext context;
+
+	context._Texture = &texture;
+	context._Resolution = resolution;
+	context._RowCoefficients = row_coefficients.Data();
+	context._RowSolidAngles = row_solid_angles.Data();
+
+	TaskSystem::ParallelFor(Task::Priority::LOW, context._Resolution * 6, [](void *const RESTRICT arguments, const uint32 index)
+	{
+		const SphericalHarmonicsContext &spherical_harmonics_context{ *static_cast<const SphericalHarmonicsContext *const RESTRICT>(arguments) };
+		const uint8 face_index{ static_cast<uint8>(index / spherical_harmonics_context._Resolution) };
+		const uint32 Y{ index % spherical_harmonics_context._Resolution };
+
+		StaticArray<Vector3<float32>, 9> &row_coefficients{ spherical_harmonics_context._RowCoefficients[index] };
+		float32 &row_solid_angle{ spherical_harmonics_context._RowSolidAngles[index] };
+
+		for (Vector3<float32> &coefficient : row_coefficients)
+		{
+			coefficient = Vector3<float32>(0.0f, 0.0f, 0.0f);
+		}
+
+		row_solid_angle = 0.0f;
+
+		for (uint32 X{ 0 }; X < spherical_harmonics_context._Resolution; ++X)
+		{
+			const Vector2<float32> normalized_coordinate{ TexelCenter(X, Y, spherical_harmonics_context._Resolution) };
+			const Vector3<float32> direction{ FaceDirection(face_index, normalized_coordinate) };
+			const float32 solid_angle{ TexelSolidAngle(normalized_coordinate, spherical_harmonics_context._Resolution) };
+			const Vector4<float32> &radiance{ spherical_harmonics_context._Texture->Face(face_index).At(X, Y) };
+
+			StaticArray<float32, 9> basis;
+			SphericalHarmonicsBasis(direction, &basis);
+
+			for (uint8 i{ 0 }; i < 9; ++i)
+			{
+				row_coefficients[i] += Vector3<float32>(radiance._X, radiance._Y, radiance._Z) * (basis[i] * solid_angle);
+			}
+
+			row_solid_angle += solid_angle;
+		}
+	}, &context);
+
+	//Sum up the rows, and normalize away the error in the texel solid angles.
+	float32 total_solid_angle{ 0.0f };
+
+	for (Vector3<float32> &coefficient : *coefficients)
+	{
+		coefficient = Vector3<float32>(0.0f, 0.0f, 0.0f);
+	}
+
+	for (uint64 row_index{ 0 }; row_index < row_coefficients.Size(); ++row_index)
+	{
+		for (uint8 i{ 0 }; i < 9; ++i)
+		{
+			(*coefficients)[i] += row_coefficients[row_index][i];
+		}
+
+		total_solid_angle += row_solid_angles[row_index];
+	}
+
+	const float32 normalization{ 4.0f * BaseMathConstants::PI / total_solid_angle };
+
+	for (Vector3<float32> &coefficient : *coefficients)
+	{
+		coefficient *= normalization;
+	}
+}
+
+/*
+*	Writes the cosine convolved irradiance of the given spherical harmonics coefficients, divided by pi, into the given texture cube, which is expected to be initialized.
+*/
+void CubemapFiltering::ConvolveDiffuse(const StaticArray<Vector3<float32>, 9> &coefficients, TextureCube *const RESTRICT output) NOEXCEPT
+{
+	DiffuseContext context;
+
+	context._Output = output;
+	context._Resolution = output->Face(0).GetWidth();
+
+	//Convolve the coefficients with the cosine lobe, and fold in the division by pi.
+	for (uint8 i{ 0 }; i < 9; ++i)
+	{
+		const float32 cosine_lobe{ i == 0 ? CubemapFilteringConstants::COSINE_LOBE_BAND_0 : (i < 4 ? CubemapFilteringConstants::COSINE_LOBE_BAND_1 : CubemapFilteringConstants::COSINE_LOBE_BAND_2) };
+
+		context._Coefficients[i] = coefficients[i] * (cosine_lobe * BaseMathConstants::INVERSE_PI);
+	}
+
+	TaskSystem::ParallelFor(Task::Priority::LOW, context._Resolution * 6, [](void *const RESTRICT arguments, const uint32 index)
+	{
+		const DiffuseContext &diffuse_context{ *static_cast<const DiffuseContext *const RESTRICT>(arguments) };
+		const uint8 face_index{ static_cast<uint8>(index / diffuse_context._Resolution) };
+		const uint32 Y{ index % diffuse_context._Resolution };
+
+		for (uint32 X{ 0 }; X < diffuse_context._Resolution; ++X)
+		{
+			StaticArray<float32, 9> basis;
+			SphericalHarmonicsBasis(FaceDirection(face_index, TexelCenter(X, Y, diffuse_context._Resolution)), &basis);
+
+			Vector3<float32> irradiance{ 0.0f, 0.0f, 0.0f };
+
+			for (uint8 i{ 0 }; i < 9; ++i)
+			{
+				irradiance += diffuse_context._Coefficients[i] * basis[i];
+			}
+
+			//Nine coefficients can ring slightly negative around very bright light sources.
+			diffuse_context._Output->At(face_index, X, Y) = Vector4<float32>
+			(
+				BaseMath::Maximum<float32>(irradiance._X, 0.0f),
+				BaseMath::Maximum<float32>(irradiance._Y, 0.0f),
+				BaseMath::Maximum<float32>(irradiance._Z, 0.0f),
+				1.0f
+			);
+		}
+	}, &context);
+}
\ No newline at end of file
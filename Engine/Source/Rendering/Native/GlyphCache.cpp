@@ -0,0 +1,249 @@
+//Header file.
+#include <Rendering/Native/GlyphCache.h>
+
+//Math.
+#include <Math/Core/BaseMath.h>
+
+//Profiling.
+#include <Profiling/Profiling.h>
+
+//Systems.
+#include <Systems/RenderingSystem.h>
+
+//Static variable definitions.
+Atomic<uint64> GlyphCache::NUMBER_OF_EVICTIONS{ 0 };
+
+/*
+*	Initializes this glyph cache for the given font, which is expected to have it's font data loaded.
+*/
+void GlyphCache::Initialize(FontAsset *const RESTRICT font, const uint32 number_of_pages) NOEXCEPT
+{
+	//Initialize the font info.
+	stbtt_InitFont(&_FontInfo, font->_FontData.Data(), stbtt_GetFontOffsetForIndex(font->_FontData.Data(), 0));
+
+	_Scale = stbtt_ScaleForPixelHeight(&_FontInfo, static_cast<float32>(font->_PixelHeight));
+	_PixelHeight = font->_PixelHeight;
+	_Padding = font->_Padding;
+
+	//Cells fit a character of the pixel height with padding on both sides. Taller characters are clamped.
+	_CellResolution = _PixelHeight + _Padding * 2;
+	_CellsPerRow = FontAsset::PAGE_RESOLUTION / _CellResolution;
+
+	//Create the pages.
+	_FirstPageIndex = static_cast<uint32>(font->_PageTextureIndices.Size());
+	_Pages.Upsize<true>(number_of_pages);
+
+	for (Page &page : _Pages)
+	{
+		page._Texture.Initialize(FontAsset::PAGE_RESOLUTION, FontAsset::PAGE_RESOLUTION);
+		Memory::Set(page._Texture.Data(), 0, FontAsset::PAGE_RESOLUTION * FontAsset::PAGE_RESOLUTION);
+
+		//The pages are updated as characters are rasterized into them, so they need to be updatable.
+		RenderingSystem::Instance->CreateTexture2D(TextureData(TextureDataContainer(page._Texture), TextureFormat::R_UINT8, TextureUsage::NONE, true), &page._Handle);
+		font->_PageTextureIndices.Emplace(RenderingSystem::Instance->AddTextureToGlobalRenderData(page._Handle));
+
+		page._DirtyMinimumX = page._DirtyMinimumY = FontAsset::PAGE_RESOLUTION;
+		page._DirtyMaximumX = page._DirtyMaximumY = 0;
+	}
+
+	//Set up the cells.
+	_Cells.Upsize<false>(number_of_pages * _CellsPerRow * _CellsPerRow);
+
+	for (Cell &cell : _Cells)
+	{
+		cell._Codepoint = FontAsset::INVALID_INDEX;
+		cell._LastUsed = 0;
+	}
+
+	_NumberOfUsedCells = 0;
+	_UseCounter = 0;
+}
+
+/*
+*	Returns the character description for the given codepoint, rasterizing it if it isn't cached.
+*	Returns nullptr if the font has no glyph for the given codepoint.
+*/
+RESTRICTED NO_DISCARD const FontAsset::CharacterDescription *const RESTRICT GlyphCache::Find(const uint32 codepoint) NOEXCEPT
+{
+	//Is this codepoint already known?
+	const std::unordered_map<uint32, uint32>::const_iterator iterator{ _CellIndices.find(codepoint) };
+
+	if (iterator != _CellIndices.end())
+	{
+		if (iterator->second == FontAsset::INVALID_INDEX)
+		{
+			return nullptr;
+		}
+
+		Cell &cell{ _Cells[iterator->second] };
+		cell._LastUsed = ++_UseCounter;
+
+		return &cell._CharacterDescription;
+	}
+
+	//Does the font have a glyph for this codepoint?
+	const int32 glyph_index{ stbtt_FindGlyphIndex(&_FontInfo, static_cast<int32>(codepoint)) };
+
+	if (glyph_index == 0 || _Cells.Empty())
+	{
+		_CellIndices[codepoint] = FontAsset::INVALID_INDEX;
+
+		return nullptr;
+	}
+
+	//Take a free cell if there is one, otherwise evict the least recently used one.
+	uint32 cell_index;
+
+	if (_NumberOfUsedCells < _Cells.Size())
+	{
+		cell_index = _NumberOfUsedCells++;
+	}
+
+	else
+	{
+		cell_index = 0;
+
+		for (uint32 i{ 1 }; i < static_cast<uint32>(_Cells.Size()); ++i)
+		{
+			if (_Cells[i]._LastUsed < _Cells[cell_index]._LastUsed)
+			{
+				cell_index = i;
+			}
+		}
+
+		_CellIndices.erase(_Cells[cell_index]._Codepoint);
+
+		NUMBER_OF_EVICTIONS.FetchAdd(1);
+	}
+
+	Rasterize(glyph_index, cell_index);
+
+	Cell &cell{ _Cells[cell_index] };
+
+	cell._Codepoint = codepoint;
+	cell._LastUsed = ++_UseCounter;
+
+	_CellIndices[codepoint] = cell_index;
+
+	return &cell._CharacterDescription;
+}
+
+/*
+*	Uploads the regions of the pages that characters were rasterized into since the last upload.
+*/
+void GlyphCache::Upload() NOEXCEPT
+{
+	PROFILING_SCOPE("GlyphCache::Upload");
+
+	for (Page &page : _Pages)
+	{
+		if (page._DirtyMinimumX < page._DirtyMaximumX && page._DirtyMinimumY < page._DirtyMaximumY)
+		{
+			RenderingSystem::Instance->UpdateTexture2DRegion
+			(
+				TextureDataContainer(page._Texture),
+				page._DirtyMinimumX,
+				page._DirtyMinimumY,
+				page._DirtyMaximumX - page._DirtyMinimumX,
+				page._DirtyMaximumY - page._DirtyMinimumY,
+				&page._Handle
+			);
+
+			page._DirtyMinimumX = page._DirtyMinimumY = FontAsset::PAGE_RESOLUTION;
+			page._DirtyMaximumX = page._DirtyMaximumY = 0;
+		}
+	}
+}
+
+/*
+*	Rasterizes the given glyph into the given cell.
+*/
+void GlyphCache::Rasterize(const int32 glyph_index, const uint32 cell_index) NOEXCEPT
+{
+	PROFILING_SCOPE("GlyphCache::Rasterize");
+
+	//Calculate where the cell is.
+	const uint32 cells_per_page{ _CellsPerRow * _CellsPerRow };
+	const uint32 page_index{ cell_index / cells_per_page };
+	const uint32 local_cell_index{ cell_index % cells_per_page };
+	const uint32 cell_X{ (local_cell_index % _CellsPerRow) * _CellResolution };
+	const uint32 cell_Y{ (local_cell_index / _CellsPerRow) * _CellResolution };
+
+	Page &page{ _Pages[page_index] };
+
+	//Clear out whatever was in the cell before.
+	for (uint32 Y{ 0 }; Y < _CellResolution; ++Y)
+	{
+		Memory::Set(&page._Texture.At(cell_X, cell_Y + Y), 0, _CellResolution);
+	}
+
+	//Retrieve the glyph SDF.
+	int32 width{ 0 };
+	int32 height{ 0 };
+	int32 x_offset{ 0 };
+	int32 y_offset{ 0 };
+
+	uint8 *const RESTRICT glyph_sdf
+	{
+		stbtt_GetGlyphSDF
+		(
+			&_FontInfo,
+			_Scale,
+			glyph_index,
+			static_cast<int32>(_Padding),
+			127,
+			FontAsset::SignedDistanceFieldPixelDistanceScale(_Padding),
+			&width,
+			&height,
+			&x_offset,
+			&y_offset
+		)
+	};
+
+	//Clamp characters that don't fit in a cell.
+	const uint32 clamped_width{ BaseMath::Minimum<uint32>(static_cast<uint32>(width), _CellResolution) };
+	const uint32 clamped_height{ BaseMath::Minimum<uint32>(static_cast<uint32>(height), _CellResolution) };
+
+	if (glyph_sdf)
+	{
+		for (uint32 Y{ 0 }; Y < clamped_height; ++Y)
+		{
+			for (uint32 X{ 0 }; X < clamped_width; ++X)
+			{
+				page._Texture.At(cell_X + X, cell_Y + Y) = glyph_sdf[X + ((height - 1 - Y) * width)];
+			}
+		}
+
+		stbtt_FreeSDF(glyph_sdf, nullptr);
+	}
+
+	//The whole cell was cleared, so all of it needs to be uploaded.
+	page._DirtyMinimumX = BaseMath::Minimum<uint32>(page._DirtyMinimumX, cell_X);
+	page._DirtyMinimumY = BaseMath::Minimum<uint32>(page._DirtyMinimumY, cell_Y);
+	page._DirtyMaximumX = BaseMath::Maximum<uint32>(page._DirtyMaximumX, cell_X + _CellResolution);
+	page._DirtyMaximumY = BaseMath::Maximum<uint32>(page._DirtyMaximumY, cell_Y + _CellResolution);
+
+	//Fill in the character description.
+	Vector2<int32> glyph_minimum;
+	Vector2<int32> glyph_maximum;
+	stbtt_GetGlyphBox(&_FontInfo, glyph_index, &glyph_minimum._X, &glyph_minimum._Y, &glyph_maximum._X, &glyph_maximum._Y);
+
+	int32 advance;
+	stbtt_GetGlyphHMetrics(&_FontInfo, glyph_index, &advance, nullptr);
+
+	const float32 pixel_height{ static_cast<float32>(_PixelHeight) };
+	const float32 page_resolution{ static_cast<float32>(FontAsset::PAGE_RESOLUTION) };
+
+	FontAsset::CharacterDescription &character_description{ _Cells[cell_index]._CharacterDescription };
+
+	character_description._Size._X = static_cast<float32>(clamped_width) / pixel_height;
+	character_description._Size._Y = static_cast<float32>(clamped_height) / pixel_height;
+	character_description._Offset._X = static_cast<float32>(glyph_minimum._X) * _Scale / pixel_height;
+	character_description._Offset._Y = static_cast<float32>(glyph_minimum._Y) * _Scale / pixel_height;
+	character_description._TextureBounds._Minimum._X = static_cast<float32>(cell_X) / page_resolution;
+	character_description._TextureBounds._Minimum._Y = static_cast<float32>(cell_Y) / page_resolution;
+	character_description._TextureBounds._Maximum._X = static_cast<float32>(cell_X + clamped_width) / page_resolution;
+	character_description._TextureBounds._Maximum._Y = static_cast<float32>(cell_Y + clamped_height) / page_resolution;
+	character_description._Advance = static_cast<float32>(advance) * _Scale / pixel_height;
+	character_description._PageIndex = _FirstPageIndex + page_index;
+}
\ No newline at end of file
@@ -0,0 +1,804 @@
+//Header file.
+#include <Rendering/Native/ImageProcessing.h>
+
+//Core.
+#include <Core/Containers/StaticArray.h>
+#include <Core/General/SIMD.h>
+
+//Math.
+#include <Math/Core/BaseMath.h>
+
+//Systems.
+#include <Systems/TaskSystem.h>
+
+//Image processing constants.
+namespace ImageProcessingConstants
+{
+	//The number of rows in each tile.
+	constexpr uint32 TILE_HEIGHT{ 32 };
+
+	//The maximum number of taps of a mip filter, in each direction.
+	constexpr uint32 MAXIMUM_NUMBER_OF_TAPS{ 12 };
+
+	//The support of the windowed sinc filters, in destination texels.
+	constexpr float32 WINDOWED_SINC_SUPPORT{ 3.0f };
+
+	//The alpha of the Kaiser window. Higher values trade sharpness for less ringing.
+	constexpr float32 KAISER_ALPHA{ 4.0f };
+
+	//The number of bins in the histograms used for coverage preservation.
+	constexpr uint32 COVERAGE_HISTOGRAM_BINS{ 1'024 };
+}
+
+/*
+*	Mip kernel class definition.
+*	Downsampling by exactly two means every destination texel sees the same weights, so the kernel is built once.
+*/
+class MipKernel final
+{
+
+public:
+
+	//The weights.
+	StaticArray<float32, ImageProcessingConstants::MAXIMUM_NUMBER_OF_TAPS> _Weights;
+
+	//The offset of the first tap, relative to twice the destination coordinate.
+	int32 _FirstOffset;
+
+	//The number of taps.
+	uint32 _NumberOfTaps;
+
+};
+
+/*
+*	Mip context class definition.
+*/
+class MipContext final
+{
+
+public:
+
+	//The source.
+	const Texture2D<Vector4<float32>> *RESTRICT _Source;
+
+	//The destination.
+	Texture2D<Vector4<float32>> *RESTRICT _Destination;
+
+	//The kernel.
+	const MipKernel *RESTRICT _Kernel;
+
+	//The mipmap generation mode.
+	MipmapGenerationMode _Mode;
+
+};
+
+/*
+*	Coverage context class definition.
+*/
+class CoverageContext final
+{
+
+public:
+
+	//The texture.
+	Texture2D<Vector4<float32>> *RESTRICT _Texture;
+
+	//The channel.
+	uint8 _Channel;
+
+	//The reference value.
+	float32 _Reference;
+
+	//The scale to apply.
+	float32 _Scale;
+
+	//The number of covered texels in each tile.
+	uint64 *RESTRICT _TileCounts;
+
+	//The histogram of each tile. Can be nullptr, if only the counts are needed.
+	uint32 *RESTRICT _TileHistograms;
+
+};
+
+/*
+*	Statistics context class definition.
+*/
+class StatisticsContext final
+{
+
+public:
+
+	//The texture.
+	const Texture2D<Vector4<float32>> *RESTRICT _Texture;
+
+	//The minimum of each tile.
+	Vector4<float32> *RESTRICT _TileMinimums;
+
+	//The maximum of each tile.
+	Vector4<float32> *RESTRICT _TileMaximums;
+
+	//The sum of each tile, with higher precision.
+	Vector4<float64> *RESTRICT _TileSums;
+
+};
+
+/*
+*	Conversion context class definition.
+*/
+class ConversionContext final
+{
+
+public:
+
+	//The input.
+	const Texture2D<Vector4<float32>> *RESTRICT _Input;
+
+	//The output.
+	Texture2D<Vector4<uint8>> *RESTRICT _Output;
+
+};
+
+/*
+*	Returns the number of tiles for the given height.
+*/
+FORCE_INLINE NO_DISCARD static uint32 NumberOfTiles(const uint32 height) NOEXCEPT
+{
+	return (height + ImageProcessingConstants::TILE_HEIGHT - 1) / ImageProcessingConstants::TILE_HEIGHT;
+}
+
+/*
+*	Mirrors the given index into the range [0, size).
+*/
+FORCE_INLINE NO_DISCARD static uint32 MirrorIndex(int32 index, const uint32 size) NOEXCEPT
+{
+	const int32 signed_size{ static_cast<int32>(size) };
+
+	if (index < 0)
+	{
+		index = -index - 1;
+	}
+
+	if (index >= signed_size)
+	{
+		index = signed_size * 2 - index - 1;
+	}
+
+	return static_cast<uint32>(BaseMath::Clamp<int32>(index, 0, signed_size - 1));
+}
+
+/*
+*	Returns the normalized sinc of the given value.
+*/
+FORCE_INLINE NO_DISCARD static float32 Sinc(const float32 value) NOEXCEPT
+{
+	if (BaseMath::Absolute(value) < FLOAT32_EPSILON)
+	{
+		return 1.0f;
+	}
+
+	const float32 angle{ value * BaseMathConstants::PI };
+
+	return BaseMath::Sine(angle) / angle;
+}
+
+/*
+*	Returns the zeroth order modified Bessel function of the first kind of the given value.
+*/
+FORCE_INLINE NO_DISCARD static float32 BesselI0(const float32 value) NOEXCEPT
+{
+	float32 sum{ 1.0f };
+	float32 term{ 1.0f };
+	const float32 half_value_squared{ value * value * 0.25f };
+
+	for (uint32 k{ 1 }; k < 32; ++k)
+	{
+		term *= half_value_squared / static_cast<float32>(k * k);
+		sum += term;
+
+		if (term < sum * FLOAT32_EPSILON)
+		{
+			break;
+		}
+	}
+
+	return sum;
+}
+
+/*
+*	Evaluates the given filter at the given distance, in destination texels.
+*/
+FORCE_INLINE NO_DISCARD static float32 EvaluateFilter(const ImageProcessing::MipFilter filter, const float32 distance) NOEXCEPT
+{
+	const float32 absolute_distance{ BaseMath::Absolute(distance) };
+
+	switch (filter)
+	{
+		case ImageProcessing::MipFilter::BOX:
+		{
+			return absolute_distance <= 0.5f ? 1.0f : 0.0f;
+		}
+
+		case ImageProcessing::MipFilter::KAISER:
+		{
+			if (absolute_distance >= ImageProcessingConstants::WINDOWED_SINC_SUPPORT)
+			{
+				return 0.0f;
+			}
+
+			const float32 normalized_distance{ absolute_distance / ImageProcessingConstants::WINDOWED_SINC_SUPPORT };
+			const float32 window{ BesselI0(ImageProcessingConstants::KAISER_ALPHA * BaseMath::SquareRoot(1.0f - normalized_distance * normalized_distance)) / BesselI0(ImageProcessingConstants::KAISER_ALPHA) };
+
+			return Sinc(distance) * window;
+		}
+
+		case ImageProcessing::MipFilter::LANCZOS:
+		{
+			if (absolute_distance >= ImageProcessingConstants::WINDOWED_SINC_SUPPORT)
+			{
+				return 0.0f;
+			}
+
+			return Sinc(distance) * Sinc(distance / ImageProcessingConstants::WINDOWED_SINC_SUPPORT);
+		}
+
+		default:
+		{
+			ASSERT(false, "Invalid case!");
+
+			return 0.0f;
+		}
+	}
+}
+
+/*
+*	Builds the mip kernel for the given filter.
+*/
+static void BuildMipKernel(const ImageProcessing::MipFilter filter, MipKernel *const RESTRICT kernel) NOEXCEPT
+{
+	kernel->_NumberOfTaps = filter == ImageProcessing::MipFilter::BOX ? 2 : ImageProcessingConstants::MAXIMUM_NUMBER_OF_TAPS;
+	kernel->_FirstOffset = 1 - static_cast<int32>(kernel->_NumberOfTaps / 2);
+
+	//The destination texel center lies between the two source texels at twice it's coordinate, and source texels are half as big.
+	float32 total_weight{ 0.0f };
+
+	for (uint32 tap_index{ 0 }; tap_index < kernel->_NumberOfTaps; ++tap_index)
+	{
+		const float32 distance{ (static_cast<float32>(kernel->_FirstOffset + static_cast<int32>(tap_index)) - 0.5f) * 0.5f };
+
+		kernel->_Weights[tap_index] = EvaluateFilter(filter, distance);
+		total_weight += kernel->_Weights[tap_index];
+	}
+
+	for (uint32 tap_index{ 0 }; tap_index < kernel->_NumberOfTaps; ++tap_index)
+	{
+		kernel->_Weights[tap_index] /= total_weight;
+	}
+}
+
+/*
+*	Filters the given texels, laid out with the given stride, with the given kernel.
+*/
+FORCE_INLINE NO_DISCARD static Vector4<float32> FilterTexels(const Vector4<float32> *const RESTRICT texels, const uint64 stride, const MipKernel &kernel, const bool use_simd) NOEXCEPT
+{
+	if (use_simd)
+	{
+		__m128 sum{ _mm_setzero_ps() };
+
+		for (uint32 tap_index{ 0 }; tap_index < kernel._NumberOfTaps; ++tap_index)
+		{
+			sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(&texels[tap_index * stride]._X), _mm_set1_ps(kernel._Weights[tap_index])));
+		}
+
+		Vector4<float32> result;
+		_mm_storeu_ps(&result._X, sum);
+
+		return result;
+	}
+
+	else
+	{
+		Vector4<float32> result{ 0.0f, 0.0f, 0.0f, 0.0f };
+
+		for (uint32 tap_index{ 0 }; tap_index < kernel._NumberOfTaps; ++tap_index)
+		{
+			result += texels[tap_index * stride] * kernel._Weights[tap_index];
+		}
+
+		return result;
+	}
+}
+
+/*
+*	Generates one tile of a mip level.
+*/
+static void GenerateMipTile(const void *const RESTRICT arguments, const uint32 first_row, const uint32 last_row) NOEXCEPT
+{
+	const MipContext &context{ *static_cast<const MipContext *const RESTRICT>(arguments) };
+	const Texture2D<Vector4<float32>> &source{ *context._Source };
+	Texture2D<Vector4<float32>> &destination{ *context._Destination };
+	const uint32 source_width{ source.GetWidth() };
+	const uint32 source_height{ source.GetHeight() };
+	const uint32 width{ destination.GetWidth() };
+
+	//The maximum mode doesn't filter, so just take the maximum of the 2x2 source texels.
+	if (context._Mode == MipmapGenerationMode::MAXIMUM)
+	{
+		for (uint32 Y{ first_row }; Y < last_row; ++Y)
+		{
+			const uint32 source_y_0{ Y * 2 };
+			const uint32 source_y_1{ BaseMath::Minimum<uint32>(Y * 2 + 1, source_height - 1) };
+
+			for (uint32 X{ 0 }; X < width; ++X)
+			{
+				const uint32 source_x_0{ X * 2 };
+				const uint32 source_x_1{ BaseMath::Minimum<uint32>(X * 2 + 1, source_width - 1) };
+
+				destination.At(X, Y) = BaseMath::Maximum<Vector4<float32>>
+				(
+					BaseMath::Maximum<Vector4<float32>>(source.At(source_x_0, source_y_0), source.At(source_x_1, source_y_0)),
+					BaseMath::Maximum<Vector4<float32>>(source.At(source_x_0, source_y_1), source.At(source_x_1, source_y_1))
+				);
+			}
+		}
+
+		return;
+	}
+
+	const MipKernel &kernel{ *context._Kernel };
+	const bool use_simd{ SIMD::GetBackend() != SIMD::Backend::NONE };
+
+	//Filter horizontally the source rows this tile needs into a buffer.
+	const uint32 number_of_buffer_rows{ (last_row - first_row - 1) * 2 + kernel._NumberOfTaps };
+	DynamicArray<Vector4<float32>> buffer;
+	buffer.Upsize<false>(static_cast<uint64>(number_of_buffer_rows) * width);
+
+	StaticArray<Vector4<float32>, ImageProcessingConstants::MAXIMUM_NUMBER_OF_TAPS> edge_texels;
+
+	for (uint32 buffer_row{ 0 }; buffer_row < number_of_buffer_rows; ++buffer_row)
+	{
+		const uint32 source_y{ MirrorIndex(static_cast<int32>(first_row * 2 + buffer_row) + kernel._FirstOffset, source_height) };
+		const Vector4<float32> *const RESTRICT source_row{ &source.At(0, source_y) };
+		Vector4<float32> *const RESTRICT buffer_row_data{ &buffer[static_cast<uint64>(buffer_row) * width] };
+
+		for (uint32 X{ 0 }; X < width; ++X)
+		{
+			const int32 first_x{ static_cast<int32>(X * 2) + kernel._FirstOffset };
+
+			if (first_x >= 0 && (first_x + static_cast<int32>(kernel._NumberOfTaps)) <= static_cast<int32>(source_width))
+			{
+				buffer_row_data[X] = FilterTexels(&source_row[first_x], 1, kernel, use_simd);
+			}
+
+			else
+			{
+				for (uint32 tap_index{ 0 }; tap_index < kernel._NumberOfTaps; ++tap_index)
+				{
+					edge_texels[tap_index] = source_row[MirrorIndex(first_x + static_cast<int32>(tap_index), source_width)];
+				}
+
+				buffer_row_data[X] = FilterTexels(edge_texels.Data(), 1, kernel, use_simd);
+			}
+		}
+	}
+
+	//Filter the buffer vertically into the destination.
+	for (uint32 Y{ first_row }; Y < last_row; ++Y)
+	{
+		const Vector4<float32> *const RESTRICT first_buffer_row{ &buffer[static_cast<uint64>((Y - first_row) * 2) * width] };
+
+		for (uint32 X{ 0 }; X < width; ++X)
+		{
+			Vector4<float32> texel{ FilterTexels(&first_buffer_row[X], width, kernel, use_simd) };
+
+			if (context._Mode == MipmapGenerationMode::NORMAL_MAP)
+			{
+				//Averaged normals get shorter, so renormalize them.
+				Vector3<float32> normal{ texel._X * 2.0f - 1.0f, texel._Y * 2.0f - 1.0f, texel._Z * 2.0f - 1.0f };
+				const float32 length_squared{ Vector3<float32>::LengthSquared(normal) };
+
+				if (length_squared > FLOAT32_EPSILON)
+				{
+					normal *= BaseMath::InverseSquareRoot(length_squared);
+				}
+
+				texel._X = normal._X * 0.5f + 0.5f;
+				texel._Y = normal._Y * 0.5f + 0.5f;
+				texel._Z = normal._Z * 0.5f + 0.5f;
+			}
+
+			else
+			{
+				//The negative lobes of the windowed sinc filters can ring below zero, which is never valid.
+				texel = BaseMath::Maximum<Vector4<float32>>(texel, Vector4<float32>(0.0f, 0.0f, 0.0f, 0.0f));
+			}
+
+			destination.At(X, Y) = texel;
+		}
+	}
+}
+
+/*
+*	Counts the covered texels of one tile, and optionally builds it's histogram.
+*/
+static void CountCoverageTile(const void *const RESTRICT arguments, const uint32 first_row, const uint32 last_row) NOEXCEPT
+{
+	const CoverageContext &context{ *static_cast<const CoverageContext *const RESTRICT>(arguments) };
+	const Texture2D<Vector4<float32>> &texture{ *context._Texture };
+	const uint32 tile_index{ first_row / ImageProcessingConstants::TILE_HEIGHT };
+
+	uint64 count{ 0 };
+	uint32 *const RESTRICT histogram{ context._TileHistograms ? &context._TileHistograms[static_cast<uint64>(tile_index) * ImageProcessingConstants::COVERAGE_HISTOGRAM_BINS] : nullptr };
+
+	if (histogram)
+	{
+		Memory::Set(histogram, 0, sizeof(uint32) * ImageProcessingConstants::COVERAGE_HISTOGRAM_BINS);
+	}
+
+	for (uint32 Y{ first_row }; Y < last_row; ++Y)
+	{
+		for (uint32 X{ 0 }; X < texture.GetWidth(); ++X)
+		{
+			const float32 value{ texture.At(X, Y)[context._Channel] };
+
+			count += value >= context._Reference;
+
+			if (histogram)
+			{
+				const float32 clamped_value{ BaseMath::Clamp<float32>(value, 0.0f, 1.0f) };
+				++histogram[BaseMath::Minimum<uint32>(static_cast<uint32>(clamped_value * static_cast<float32>(ImageProcessingConstants::COVERAGE_HISTOGRAM_BINS)), ImageProcessingConstants::COVERAGE_HISTOGRAM_BINS - 1)];
+			}
+		}
+	}
+
+	context._TileCounts[tile_index] = count;
+}
+
+/*
+*	Scales the coverage channel of one tile.
+*/
+static void ScaleCoverageTile(const void *const RESTRICT arguments, const uint32 first_row, const uint32 last_row) NOEXCEPT
+{
+	const CoverageContext &context{ *static_cast<const CoverageContext *const RESTRICT>(arguments) };
+	Texture2D<Vector4<float32>> &texture{ *context._Texture };
+
+	for (uint32 Y{ first_row }; Y < last_row; ++Y)
+	{
+		for (uint32 X{ 0 }; X < texture.GetWidth(); ++X)
+		{
+			float32 &value{ texture.At(X, Y)[context._Channel] };
+
+			value = BaseMath::Minimum<float32>(value * context._Scale, 1.0f);
+		}
+	}
+}
+
+/*
+*	Calculates the fraction of texels in the given channel that are at or above the given reference value.
+*/
+NO_DISCARD static float32 CalculateCoverage(Texture2D<Vector4<float32>> *const RESTRICT texture, const uint8 channel, const float32 reference) NOEXCEPT
+{
+	DynamicArray<uint64> tile_counts;
+	tile_counts.Upsize<false>(NumberOfTiles(texture->GetHeight()));
+
+	CoverageContext context;
+
+	context._Texture = texture;
+	context._Channel = channel;
+	context._Reference = reference;
+	context._TileCounts = tile_counts.Data();
+	context._TileHistograms = nullptr;
+
+	ImageProcessing::ForEachTile(texture->GetHeight(), CountCoverageTile, &context);
+
+	uint64 total_count{ 0 };
+
+	for (const uint64 tile_count : tile_counts)
+	{
+		total_count += tile_count;
+	}
+
+	return static_cast<float32>(total_count) / static_cast<float32>(static_cast<uint64>(texture->GetWidth()) * texture->GetHeight());
+}
+
+/*
+*	Scales the given channel of the given texture so that it's coverage of the given reference value matches the given coverage.
+*/
+static void PreserveCoverage(Texture2D<Vector4<float32>> *const RESTRICT texture, const uint8 channel, const float32 reference, const float32 target_coverage) NOEXCEPT
+{
+	const uint32 number_of_tiles{ NumberOfTiles(texture->GetHeight()) };
+	const uint64 number_of_texels{ static_cast<uint64>(texture->GetWidth()) * texture->GetHeight() };
+
+	DynamicArray<uint64> tile_counts;
+	DynamicArray<uint32> tile_histograms;
+
+	tile_counts.Upsize<false>(number_of_tiles);
+	tile_histograms.Upsize<false>(static_cast<uint64>(number_of_tiles) * ImageProcessingConstants::COVERAGE_HISTOGRAM_BINS);
+
+	CoverageContext context;
+
+	context._Texture = texture;
+	context._Channel = channel;
+	context._Reference = reference;
+	context._TileCounts = tile_counts.Data();
+	context._TileHistograms = tile_histograms.Data();
+
+	ImageProcessing::ForEachTile(texture->GetHeight(), CountCoverageTile, &context);
+
+	//Nothing to do if the coverage already matches.
+	uint64 current_count{ 0 };
+
+	for (const uint64 tile_count : tile_counts)
+	{
+		current_count += tile_count;
+	}
+
+	const float32 target_count{ target_coverage * static_cast<float32>(number_of_texels) };
+
+	if (target_count < 1.0f || BaseMath::Absolute(static_cast<float32>(current_count) - target_count) < 1.0f)
+	{
+		return;
+	}
+
+	//Find the value above which the target fraction of texels lies, from the merged histograms.
+	uint64 cumulative_count{ 0 };
+	uint32 threshold_bin{ 0 };
+
+	for (int32 bin{ ImageProcessingConstants::COVERAGE_HISTOGRAM_BINS - 1 }; bin >= 0; --bin)
+	{
+		for (uint32 tile_index{ 0 }; tile_index < number_of_tiles; ++tile_index)
+		{
+			cumulative_count += tile_histograms[static_cast<uint64>(tile_index) * ImageProcessingConstants::COVERAGE_HISTOGRAM_BINS + bin];
+		}
+
+		if (static_cast<float32>(cumulative_count) >= target_count)
+		{
+			threshold_bin = static_cast<uint32>(bin);
+
+			break;
+		}
+	}
+
+	//Scale the channel so that the threshold lands on the reference value.
+	const float32 threshold{ BaseMath::Maximum<float32>(static_cast<float32>(threshold_bin), 1.0f) / static_cast<float32>(ImageProcessingConstants::COVERAGE_HISTOGRAM_BINS) };
+
+	context._Scale = reference / threshold;
+
+	ImageProcessing::ForEachTile(texture->GetHeight(), ScaleCoverageTile, &context);
+}
+
+/*
+*	Runs the given function over all tiles of an image with the given height, spread out over tasks.
+*	Runs at low priority, as this is only done when compiling assets.
+*/
+void ImageProcessing::ForEachTile(const uint32 height, const TileFunction function, const void *const RESTRICT context) NOEXCEPT
+{
+	/*
+	*	Tile context class definition.
+	*/
+	class TileContext final
+	{
+
+	public:
+
+		//The function.
+		TileFunction _Function;
+
+		//The context.
+		const void *RESTRICT _Context;
+
+		//The height of the image.
+		uint32 _Height;
+
+	};
+
+	TileContext tile_context{ function, context, height };
+
+	TaskSystem::ParallelFor(Task::Priority::LOW, NumberOfTiles(height), [](void *const RESTRICT arguments, const uint32 index)
+	{
+		const TileContext &current_tile_context{ *static_cast<const TileContext *const RESTRICT>(arguments) };
+		const uint32 first_row{ index * ImageProcessingConstants::TILE_HEIGHT };
+
+		current_tile_context._Function(current_tile_context._Context, first_row, BaseMath::Minimum<uint32>(first_row + ImageProcessingConstants::TILE_HEIGHT, current_tile_context._Height));
+	}, &tile_context);
+}
+
+/*
+*	Calculates the statistics of the given texture.
+*/
+void ImageProcessing::CalculateStatistics(const Texture2D<Vector4<float32>> &texture, Statistics *const RESTRICT statistics) NOEXCEPT
+{
+	const uint32 number_of_tiles{ NumberOfTiles(texture.GetHeight()) };
+
+	DynamicArray<Vector4<float32>> tile_minimums;
+	DynamicArray<Vector4<float32>> tile_maximums;
+	DynamicArray<Vector4<float64>> tile_sums;
+
+	tile_minimums.Upsize<false>(number_of_tiles);
+	tile_maximums.Upsize<false>(number_of_tiles);
+	tile_sums.Upsize<false>(number_of_tiles);
+
+	StatisticsContext context;
+
+	context._Texture = &texture;
+	context._TileMinimums = tile_minimums.Data();
+	context._TileMaximums = tile_maximums.Data();
+	context._TileSums = tile_sums.Data();
+
+	ForEachTile(texture.GetHeight(), [](const void *const RESTRICT arguments, const uint32 first_row, const uint32 last_row)
+	{
+		const StatisticsContext &context{ *static_cast<const StatisticsContext *const RESTRICT>(arguments) };
+		const Texture2D<Vector4<float32>> &texture{ *context._Texture };
+		const uint32 tile_index{ first_row / ImageProcessingConstants::TILE_HEIGHT };
+
+		Vector4<float32> minimum{ FLOAT32_MAXIMUM, FLOAT32_MAXIMUM, FLOAT32_MAXIMUM, FLOAT32_MAXIMUM };
+		Vector4<float32> maximum{ -FLOAT32_MAXIMUM, -FLOAT32_MAXIMUM, -FLOAT32_MAXIMUM, -FLOAT32_MAXIMUM };
+		Vector4<float64> sum{ 0.0, 0.0, 0.0, 0.0 };
+
+		for (uint32 Y{ first_row }; Y < last_row; ++Y)
+		{
+			//Sum up each row in single precision first, it's short enough to not lose anything meaningful.
+			Vector4<float32> row_sum{ 0.0f, 0.0f, 0.0f, 0.0f };
+
+			for (uint32 X{ 0 }; X < texture.GetWidth(); ++X)
+			{
+				const Vector4<float32> &texel{ texture.At(X, Y) };
+
+				minimum = BaseMath::Minimum<Vector4<float32>>(minimum, texel);
+				maximum = BaseMath::Maximum<Vector4<float32>>(maximum, texel);
+				row_sum += texel;
+			}
+
+			for (uint8 i{ 0 }; i < 4; ++i)
+			{
+				sum[i] += static_cast<float64>(row_sum[i]);
+			}
+		}
+
+		context._TileMinimums[tile_index] = minimum;
+		context._TileMaximums[tile_index] = maximum;
+		context._TileSums[tile_index] = sum;
+	}, &context);
+
+	//Reduce the tiles in order, to stay deterministic.
+	Vector4<float64> sum{ 0.0, 0.0, 0.0, 0.0 };
+
+	statistics->_Minimum = tile_minimums[0];
+	statistics->_Maximum = tile_maximums[0];
+
+	for (uint32 tile_index{ 0 }; tile_index < number_of_tiles; ++tile_index)
+	{
+		statistics->_Minimum = BaseMath::Minimum<Vector4<float32>>(statistics->_Minimum, tile_minimums[tile_index]);
+		statistics->_Maximum = BaseMath::Maximum<Vector4<float32>>(statistics->_Maximum, tile_maximums[tile_index]);
+
+		for (uint8 i{ 0 }; i < 4; ++i)
+		{
+			sum[i] += tile_sums[tile_index][i];
+		}
+	}
+
+	const float64 number_of_texels{ static_cast<float64>(static_cast<uint64>(texture.GetWidth()) * texture.GetHeight()) };
+
+	for (uint8 i{ 0 }; i < 4; ++i)
+	{
+		statistics->_Average[i] = static_cast<float32>(sum[i] / number_of_texels);
+	}
+}
+
+/*
+*	Generates the mip chain from the first texture in the given array, appending the new mip levels to it.
+*/
+void ImageProcessing::GenerateMipChain(const MipChainParameters &parameters, DynamicArray<Texture2D<Vector4<float32>>> *const RESTRICT mip_chain) NOEXCEPT
+{
+	ASSERT(mip_chain->Size() == 1, "Expected only the first mip level!");
+	ASSERT(parameters._Mode != MipmapGenerationMode::NONE, "Shouldn't have called this function. (:");
+
+	//Reserve up front, so the mip levels don't move around while being filtered.
+	{
+		uint32 number_of_mip_levels{ 1 };
+		uint32 width{ (*mip_chain)[0].GetWidth() };
+		uint32 height{ (*mip_chain)[0].GetHeight() };
+
+		while (width > parameters._LowestResolution && height > parameters._LowestResolution)
+		{
+			width /= 2;
+			height /= 2;
+			++number_of_mip_levels;
+		}
+
+		mip_chain->Reserve(number_of_mip_levels);
+	}
+
+	MipKernel kernel;
+	BuildMipKernel(parameters._Filter, &kernel);
+
+	//Remember the coverage of the first mip level.
+	StaticArray<float32, 4> target_coverages;
+
+	for (uint8 channel{ 0 }; channel < 4; ++channel)
+	{
+		if (TEST_BIT(parameters._CoverageChannels, BIT(channel)))
+		{
+			target_coverages[channel] = CalculateCoverage(&(*mip_chain)[0], channel, parameters._CoverageReference);
+		}
+	}
+
+	//Generate all mip levels.
+	while (mip_chain->Back().GetWidth() > parameters._LowestResolution && mip_chain->Back().GetHeight() > parameters._LowestResolution)
+	{
+		const uint32 new_width{ mip_chain->Back().GetWidth() / 2 };
+		const uint32 new_height{ mip_chain->Back().GetHeight() / 2 };
+
+		mip_chain->Emplace();
+		mip_chain->Back().Initialize(new_width, new_height);
+
+		MipContext context;
+
+		context._Source = &mip_chain->At(mip_chain->LastIndex() - 1);
+		context._Destination = &mip_chain->Back();
+		context._Kernel = &kernel;
+		context._Mode = parameters._Mode;
+
+		ForEachTile(new_height, GenerateMipTile, &context);
+
+		for (uint8 channel{ 0 }; channel < 4; ++channel)
+		{
+			if (TEST_BIT(parameters._CoverageChannels, BIT(channel)))
+			{
+				PreserveCoverage(&mip_chain->Back(), channel, parameters._CoverageReference, target_coverages[channel]);
+			}
+		}
+	}
+}
+
+/*
+*	Converts the given texture to 8 bit unsigned normalized values, clamping and rounding to nearest.
+*/
+void ImageProcessing::ConvertToUNorm8(const Texture2D<Vector4<float32>> &input, Texture2D<Vector4<uint8>> *const RESTRICT output) NOEXCEPT
+{
+	output->Initialize(input.GetWidth(), input.GetHeight());
+
+	ConversionContext context;
+
+	context._Input = &input;
+	context._Output = output;
+
+	ForEachTile(input.GetHeight(), [](const void *const RESTRICT arguments, const uint32 first_row, const uint32 last_row)
+	{
+		const ConversionContext &context{ *static_cast<const ConversionContext *const RESTRICT>(arguments) };
+		const uint32 width{ context._Input->GetWidth() };
+		const bool use_simd{ SIMD::GetBackend() != SIMD::Backend::NONE };
+
+		for (uint32 Y{ first_row }; Y < last_row; ++Y)
+		{
+			const Vector4<float32> *const RESTRICT input_row{ &context._Input->At(0, Y) };
+			Vector4<uint8> *const RESTRICT output_row{ &context._Output->At(0, Y) };
+			uint32 X{ 0 };
+
+			//Convert four texels at a time. Rounds to nearest, and clamps NaN to zero.
+			if (use_simd)
+			{
+				const __m128 zero{ _mm_setzero_ps() };
+				const __m128 one{ _mm_set1_ps(1.0f) };
+				const __m128 scale{ _mm_set1_ps(static_cast<float32>(UINT8_MAXIMUM)) };
+
+				for (; (X + 4) <= width; X += 4)
+				{
+					const __m128i A{ _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(&input_row[X + 0]._X), zero), one), scale)) };
+					const __m128i B{ _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(&input_row[X + 1]._X), zero), one), scale)) };
+					const __m128i C{ _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(&input_row[X + 2]._X), zero), one), scale)) };
+					const __m128i D{ _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(&input_row[X + 3]._X), zero), one), scale)) };
+
+					_mm_storeu_si128(reinterpret_cast<__m128i *const RESTRICT>(&output_row[X]), _mm_packus_epi16(_mm_packs_epi32(A, B), _mm_packs_epi32(C, D)));
+				}
+			}
+
+			for (; X < width; ++X)
+			{
+				for (uint8 i{ 0 }; i < 4; ++i)
+				{
+					output_row[X][i] = static_cast<uint8>(BaseMath::Clamp<float32>(input_row[X][i], 0.0f, 1.0f) * static_cast<float32>(UINT8_MAXIMUM) + 0.5f);
+				}
+			}
+		}
+	}, &context);
+}
\ No newline at end of file
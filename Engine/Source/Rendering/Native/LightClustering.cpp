@@ -0,0 +1,348 @@
+//Header file.
+#include <Rendering/Native/LightClustering.h>
+
+//Core.
+#include <Core/Containers/StaticArray.h>
+#include <Core/General/SIMD.h>
+
+//Lighting.
+#include <Lighting/LightingCore.h>
+
+//Math.
+#include <Math/Core/BaseMath.h>
+
+//Systems.
+#include <Systems/TaskSystem.h>
+
+/*
+*	Unprojects the given normalized device coordinate into camera space.
+*/
+FORCE_INLINE NO_DISCARD static Vector3<float32> Unproject(const Matrix4x4 &inverse_camera_to_clip_matrix, const float32 X, const float32 Y) NOEXCEPT
+{
+	//Any depth works, the result is only used as a direction.
+	const Vector4<float32> position{ inverse_camera_to_clip_matrix * Vector4<float32>(X, Y, 0.5f, 1.0f) };
+	const float32 inverse_w{ 1.0f / position._W };
+
+	return Vector3<float32>(position._X * inverse_w, position._Y * inverse_w, position._Z * inverse_w);
+}
+
+/*
+*	Builds the cluster bounds from the given camera properties.
+*	The bounds are in camera space, and only need to be rebuilt when the projection changes.
+*/
+void LightClustering::BuildGrid(const Matrix4x4 &inverse_camera_to_clip_matrix, const float32 near_plane, const float32 far_plane) NOEXCEPT
+{
+	using namespace LightClusteringConstants;
+
+	//Set up the header.
+	_Header._GridWidth = GRID_WIDTH;
+	_Header._GridHeight = GRID_HEIGHT;
+	_Header._GridDepth = GRID_DEPTH;
+	_Header._DepthScale = static_cast<float32>(GRID_DEPTH) / BaseMath::Logarithm(far_plane / near_plane);
+	_Header._DepthBias = -BaseMath::Logarithm(near_plane) * _Header._DepthScale;
+
+	_NearPlane = near_plane;
+
+	//The forward vector is the direction through the center of the screen.
+	_ForwardVector = Vector3<float32>::Normalize(Unproject(inverse_camera_to_clip_matrix, 0.0f, 0.0f));
+
+	//Calculate the corners of the screen tiles, scaled to a depth of one.
+	StaticArray<Vector3<float32>, (GRID_WIDTH + 1) * (GRID_HEIGHT + 1)> corners;
+
+	for (uint32 Y{ 0 }; Y <= GRID_HEIGHT; ++Y)
+	{
+		for (uint32 X{ 0 }; X <= GRID_WIDTH; ++X)
+		{
+			const Vector3<float32> corner
+			{
+				Unproject
+				(
+					inverse_camera_to_clip_matrix,
+					static_cast<float32>(X) / static_cast<float32>(GRID_WIDTH) * 2.0f - 1.0f,
+					static_cast<float32>(Y) / static_cast<float32>(GRID_HEIGHT) * 2.0f - 1.0f
+				)
+			};
+
+			corners[Y * (GRID_WIDTH + 1) + X] = corner / Vector3<float32>::DotProduct(corner, _ForwardVector);
+		}
+	}
+
+	//Calculate the bounds of all clusters.
+	_MinimumX.Resize<false>(NUMBER_OF_CLUSTERS);
+	_MinimumY.Resize<false>(NUMBER_OF_CLUSTERS);
+	_MinimumZ.Resize<false>(NUMBER_OF_CLUSTERS);
+	_MaximumX.Resize<false>(NUMBER_OF_CLUSTERS);
+	_MaximumY.Resize<false>(NUMBER_OF_CLUSTERS);
+	_MaximumZ.Resize<false>(NUMBER_OF_CLUSTERS);
+
+	for (uint32 Z{ 0 }; Z < GRID_DEPTH; ++Z)
+	{
+		const float32 slice_depths[2]
+		{
+			BaseMath::Exponential((static_cast<float32>(Z) - _Header._DepthBias) / _Header._DepthScale),
+			BaseMath::Exponential((static_cast<float32>(Z + 1) - _Header._DepthBias) / _Header._DepthScale)
+		};
+
+		for (uint32 Y{ 0 }; Y < GRID_HEIGHT; ++Y)
+		{
+			for (uint32 X{ 0 }; X < GRID_WIDTH; ++X)
+			{
+				Vector3<float32> minimum{ FLOAT32_MAXIMUM };
+				Vector3<float32> maximum{ -FLOAT32_MAXIMUM };
+
+				for (const float32 slice_depth : slice_depths)
+				{
+					for (uint32 corner_index{ 0 }; corner_index < 4; ++corner_index)
+					{
+						const Vector3<float32> corner{ corners[(Y + (corner_index >> 1)) * (GRID_WIDTH + 1) + (X + (corner_index & 1))] * slice_depth };
+
+						minimum = BaseMath::Minimum<Vector3<float32>>(minimum, corner);
+						maximum = BaseMath::Maximum<Vector3<float32>>(maximum, corner);
+					}
+				}
+
+				const uint32 cluster_index{ ClusterIndex(X, Y, Z) };
+
+				_MinimumX[cluster_index] = minimum._X;
+				_MinimumY[cluster_index] = minimum._Y;
+				_MinimumZ[cluster_index] = minimum._Z;
+				_MaximumX[cluster_index] = maximum._X;
+				_MaximumY[cluster_index] = maximum._Y;
+				_MaximumZ[cluster_index] = maximum._Z;
+			}
+		}
+	}
+}
+
+/*
+*	Assigns the given lights to the clusters. Tests lights in parallel on the task system when there are enough of them.
+*/
+void LightClustering::AssignLights(const Matrix4x4 &world_to_camera_matrix, const ShaderLightComponent *const RESTRICT lights, const uint32 number_of_lights) NOEXCEPT
+{
+	using namespace LightClusteringConstants;
+
+	//Sort the lights into bounded and global lights. Point lights are bounded by their radius, all other lights affect every cluster.
+	_Spheres.Clear();
+	_BoundedLightIndices.Clear();
+	_GlobalLightIndices.Clear();
+
+	for (uint32 light_index{ 0 }; light_index < number_of_lights; ++light_index)
+	{
+		const ShaderLightComponent &light{ lights[light_index] };
+
+		if (light._LightType == static_cast<uint32>(LightType::POINT))
+		{
+			const Vector4<float32> center{ world_to_camera_matrix * Vector4<float32>(light._WorldPosition, 1.0f) };
+
+			_Spheres.Emplace(center._X, center._Y, center._Z, light._Radius);
+			_BoundedLightIndices.Emplace(light_index);
+		}
+
+		else
+		{
+			_GlobalLightIndices.Emplace(light_index);
+		}
+	}
+
+	//Test the bounded lights against the clusters, 64 lights per task.
+	const uint32 number_of_words{ (static_cast<uint32>(_BoundedLightIndices.Size()) + 63) / 64 };
+
+	_Masks.Resize<false>(static_cast<uint64>(number_of_words) * NUMBER_OF_CLUSTERS);
+
+	TaskSystem::ParallelFor(Task::Priority::HIGH, number_of_words, [](void *const RESTRICT arguments, const uint32 index)
+	{
+		static_cast<LightClustering *const RESTRICT>(arguments)->TestLights(index);
+	}, this);
+
+	//Count the lights in each cluster.
+	_ClusterCounts.Resize<false>(NUMBER_OF_CLUSTERS);
+
+	if (number_of_words > 0)
+	{
+		TaskSystem::ParallelFor(Task::Priority::HIGH, GRID_DEPTH, [](void *const RESTRICT arguments, const uint32 index)
+		{
+			static_cast<LightClustering *const RESTRICT>(arguments)->CountLights(index);
+		}, this);
+	}
+
+	else
+	{
+		Memory::Set(_ClusterCounts.Data(), 0, sizeof(uint32) * NUMBER_OF_CLUSTERS);
+	}
+
+	//Lay out the data.
+	_Header._NumberOfGlobalLights = static_cast<uint32>(_GlobalLightIndices.Size());
+
+	uint32 current_offset{ _Header._NumberOfGlobalLights + NUMBER_OF_CLUSTERS * 2 };
+
+	for (const uint32 cluster_count : _ClusterCounts)
+	{
+		current_offset += cluster_count;
+	}
+
+	_Data.Resize<false>(current_offset);
+
+	if (!_GlobalLightIndices.Empty())
+	{
+		Memory::Copy(_Data.Data(), _GlobalLightIndices.Data(), sizeof(uint32) * _GlobalLightIndices.Size());
+	}
+
+	current_offset = _Header._NumberOfGlobalLights + NUMBER_OF_CLUSTERS * 2;
+
+	for (uint32 cluster_index{ 0 }; cluster_index < NUMBER_OF_CLUSTERS; ++cluster_index)
+	{
+		_Data[_Header._NumberOfGlobalLights + cluster_index * 2 + 0] = current_offset;
+		_Data[_Header._NumberOfGlobalLights + cluster_index * 2 + 1] = _ClusterCounts[cluster_index];
+
+		current_offset += _ClusterCounts[cluster_index];
+	}
+
+	//Write the light indices of each cluster.
+	if (number_of_words > 0)
+	{
+		TaskSystem::ParallelFor(Task::Priority::HIGH, GRID_DEPTH, [](void *const RESTRICT arguments, const uint32 index)
+		{
+			static_cast<LightClustering *const RESTRICT>(arguments)->WriteLights(index);
+		}, this);
+	}
+}
+
+/*
+*	Returns the depth slice of the given linearized depth.
+*/
+NO_DISCARD uint32 LightClustering::DepthSlice(const float32 depth) const NOEXCEPT
+{
+	if (depth <= _NearPlane)
+	{
+		return 0;
+	}
+
+	const int32 slice{ BaseMath::Floor<int32>(BaseMath::Logarithm(depth) * _Header._DepthScale + _Header._DepthBias) };
+
+	return static_cast<uint32>(BaseMath::Clamp<int32>(slice, 0, static_cast<int32>(LightClusteringConstants::GRID_DEPTH) - 1));
+}
+
+/*
+*	Tests the bounded lights of the given mask word against the clusters.
+*/
+void LightClustering::TestLights(const uint32 word_index) NOEXCEPT
+{
+	using namespace LightClusteringConstants;
+
+	uint64 *const RESTRICT masks{ &_Masks[static_cast<uint64>(word_index) * NUMBER_OF_CLUSTERS] };
+
+	Memory::Set(masks, 0, sizeof(uint64) * NUMBER_OF_CLUSTERS);
+
+	const uint32 first_light_index{ word_index * 64 };
+	const uint32 last_light_index{ BaseMath::Minimum<uint32>(first_light_index + 64, static_cast<uint32>(_Spheres.Size())) };
+
+	for (uint32 light_index{ first_light_index }; light_index < last_light_index; ++light_index)
+	{
+		const Vector4<float32> &sphere{ _Spheres[light_index] };
+		const uint64 light_bit{ static_cast<uint64>(1) << (light_index - first_light_index) };
+
+		//Only the depth slices the sphere overlaps need to be tested.
+		const float32 depth{ Vector3<float32>::DotProduct(Vector3<float32>(sphere._X, sphere._Y, sphere._Z), _ForwardVector) };
+
+		if ((depth + sphere._W) <= _NearPlane)
+		{
+			continue;
+		}
+
+		const uint32 first_slice{ DepthSlice(depth - sphere._W) };
+		const uint32 last_slice{ DepthSlice(depth + sphere._W) };
+		const float32 radius_squared{ sphere._W * sphere._W };
+
+		if (SIMD::GetBackend() == SIMD::Backend::AVX2)
+		{
+			const __m256 center_x{ _mm256_set1_ps(sphere._X) };
+			const __m256 center_y{ _mm256_set1_ps(sphere._Y) };
+			const __m256 center_z{ _mm256_set1_ps(sphere._Z) };
+			const __m256 radius_squared_wide{ _mm256_set1_ps(radius_squared) };
+			const __m256 zero{ _mm256_setzero_ps() };
+
+			for (uint32 cluster_index{ first_slice * CLUSTERS_PER_SLICE }; cluster_index < (last_slice + 1) * CLUSTERS_PER_SLICE; cluster_index += 8)
+			{
+				//Distance from the sphere center to the cluster bounds, per axis.
+				const __m256 distance_x{ _mm256_max_ps(_mm256_max_ps(_mm256_sub_ps(_mm256_loadu_ps(&_MinimumX[cluster_index]), center_x), _mm256_sub_ps(center_x, _mm256_loadu_ps(&_MaximumX[cluster_index]))), zero) };
+				const __m256 distance_y{ _mm256_max_ps(_mm256_max_ps(_mm256_sub_ps(_mm256_loadu_ps(&_MinimumY[cluster_index]), center_y), _mm256_sub_ps(center_y, _mm256_loadu_ps(&_MaximumY[cluster_index]))), zero) };
+				const __m256 distance_z{ _mm256_max_ps(_mm256_max_ps(_mm256_sub_ps(_mm256_loadu_ps(&_MinimumZ[cluster_index]), center_z), _mm256_sub_ps(center_z, _mm256_loadu_ps(&_MaximumZ[cluster_index]))), zero) };
+
+				const __m256 distance_squared{ _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(distance_x, distance_x), _mm256_mul_ps(distance_y, distance_y)), _mm256_mul_ps(distance_z, distance_z)) };
+
+				uint32 overlap_mask{ static_cast<uint32>(_mm256_movemask_ps(_mm256_cmp_ps(distance_squared, radius_squared_wide, _CMP_LE_OQ))) };
+
+				while (overlap_mask != 0)
+				{
+					const uint32 lane_index{ SIMD::LowestSetBitIndex(overlap_mask) };
+
+					masks[cluster_index + lane_index] |= light_bit;
+					overlap_mask &= overlap_mask - 1;
+				}
+			}
+		}
+
+		else
+		{
+			for (uint32 cluster_index{ first_slice * CLUSTERS_PER_SLICE }; cluster_index < (last_slice + 1) * CLUSTERS_PER_SLICE; ++cluster_index)
+			{
+				const float32 distance_x{ BaseMath::Maximum<float32>(BaseMath::Maximum<float32>(_MinimumX[cluster_index] - sphere._X, sphere._X - _MaximumX[cluster_index]), 0.0f) };
+				const float32 distance_y{ BaseMath::Maximum<float32>(BaseMath::Maximum<float32>(_MinimumY[cluster_index] - sphere._Y, sphere._Y - _MaximumY[cluster_index]), 0.0f) };
+				const float32 distance_z{ BaseMath::Maximum<float32>(BaseMath::Maximum<float32>(_MinimumZ[cluster_index] - sphere._Z, sphere._Z - _MaximumZ[cluster_index]), 0.0f) };
+
+				if ((distance_x * distance_x + distance_y * distance_y + distance_z * distance_z) <= radius_squared)
+				{
+					masks[cluster_index] |= light_bit;
+				}
+			}
+		}
+	}
+}
+
+/*
+*	Counts the lights of the clusters in the given depth slice.
+*/
+void LightClustering::CountLights(const uint32 slice_index) NOEXCEPT
+{
+	using namespace LightClusteringConstants;
+
+	const uint64 number_of_words{ _Masks.Size() / NUMBER_OF_CLUSTERS };
+
+	for (uint32 cluster_index{ slice_index * CLUSTERS_PER_SLICE }; cluster_index < (slice_index + 1) * CLUSTERS_PER_SLICE; ++cluster_index)
+	{
+		uint32 count{ 0 };
+
+		for (uint64 word_index{ 0 }; word_index < number_of_words; ++word_index)
+		{
+			count += SIMD::CountSetBits(_Masks[word_index * NUMBER_OF_CLUSTERS + cluster_index]);
+		}
+
+		_ClusterCounts[cluster_index] = count;
+	}
+}
+
+/*
+*	Writes the light indices of the clusters in the given depth slice.
+*/
+void LightClustering::WriteLights(const uint32 slice_index) NOEXCEPT
+{
+	using namespace LightClusteringConstants;
+
+	const uint64 number_of_words{ _Masks.Size() / NUMBER_OF_CLUSTERS };
+
+	for (uint32 cluster_index{ slice_index * CLUSTERS_PER_SLICE }; cluster_index < (slice_index + 1) * CLUSTERS_PER_SLICE; ++cluster_index)
+	{
+		uint32 *RESTRICT light_indices{ &_Data[_Data[_Header._NumberOfGlobalLights + cluster_index * 2 + 0]] };
+
+		for (uint64 word_index{ 0 }; word_index < number_of_words; ++word_index)
+		{
+			uint64 mask{ _Masks[word_index * NUMBER_OF_CLUSTERS + cluster_index] };
+
+			while (mask != 0)
+			{
+				*light_indices++ = _BoundedLightIndices[word_index * 64 + SIMD::LowestSetBitIndex(mask)];
+				mask &= mask - 1;
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -48,27 +48,45 @@ void LightingSystem::PostInitialize() NOEXCEPT
 	(
 		HashString("Lighting"),
 		sizeof(LightHeaderData) + sizeof(ShaderLightComponent) * 64,
-		[](DynamicArray<byte> *const RESTRICT data, void *const RESTRICT arguments)
+		[](StorageBufferWriter *const RESTRICT writer, void *const RESTRICT arguments)
 		{
-			data->Clear();
 			LightingSystem *const RESTRICT lighting_system{ static_cast<LightingSystem *const RESTRICT>(arguments) };
 
+			const UploadSpan span{ writer->Reserve(sizeof(LightHeaderData) + sizeof(ShaderLightComponent) * lighting_system->_ShaderLightComponents.Size()) };
+
 			LightHeaderData header_data;
 
 			header_data._NumberOfLights = static_cast<uint32>(LightComponent::Instance->NumberOfInstances());
 			header_data._MaximumNumberOfShadowCastingLights = LightingConstants::MAXIMUM_NUMBER_OF_SHADOW_CASTING_LIGHTS;
 
-			for (uint64 i{ 0 }; i < sizeof(LightHeaderData); ++i)
+			Memory::Copy(span._Data, &header_data, sizeof(LightHeaderData));
+
+			if (!lighting_system->_ShaderLightComponents.Empty())
 			{
-				data->Emplace(((const byte *const RESTRICT)&header_data)[i]);
+				Memory::Copy(span._Data + sizeof(LightHeaderData), lighting_system->_ShaderLightComponents.Data(), sizeof(ShaderLightComponent) * lighting_system->_ShaderLightComponents.Size());
 			}
+		},
+		this
+	);
 
-			for (const ShaderLightComponent &shader_light_component : lighting_system->_ShaderLightComponents)
+	//Register the light clusters storage buffer.
+	RenderingSystem::Instance->GetBufferManager()->RegisterStorageBuffer
+	(
+		HashString("LightClusters"),
+		sizeof(LightClustersHeader) + sizeof(uint32) * (LightClusteringConstants::NUMBER_OF_CLUSTERS * 2 + 1'024),
+		[](StorageBufferWriter *const RESTRICT writer, void *const RESTRICT arguments)
+		{
+			LightingSystem *const RESTRICT lighting_system{ static_cast<LightingSystem *const RESTRICT>(arguments) };
+
+			const DynamicArray<uint32> &data{ lighting_system->_LightClustering.GetData() };
+
+			const UploadSpan span{ writer->Reserve(sizeof(LightClustersHeader) + sizeof(uint32) * data.Size()) };
+
+			Memory::Copy(span._Data, &lighting_system->_LightClustering.GetHeader(), sizeof(LightClustersHeader));
+
+			if (!data.Empty())
 			{
-				for (uint64 i{ 0 }; i < sizeof(ShaderLightComponent); ++i)
-				{
-					data->Emplace(((const byte *const RESTRICT)&shader_light_component)[i]);
-				}
+				Memory::Copy(span._Data + sizeof(LightClustersHeader), data.Data(), sizeof(uint32) * data.Size());
 			}
 		},
 		this
@@ -112,6 +130,14 @@ void LightingSystem::RenderUpdate() NOEXCEPT
 			_ShaderLightComponents.Emplace(LightComponent::Instance->InstanceToEntity(i));
 		}
 
+		//Assign the lights to the clusters. The grid is rebuilt every frame, since the projection is jittered.
+		{
+			Camera *const RESTRICT camera{ RenderingSystem::Instance->GetCameraSystem()->GetCurrentCamera() };
+
+			_LightClustering.BuildGrid(*camera->GetInverseProjectionMatrix(), camera->GetNearPlane(), camera->GetFarPlane());
+			_LightClustering.AssignLights(*camera->GetCameraMatrix(), _ShaderLightComponents.Data(), number_of_lights);
+		}
+
 		//Fill in the header data.
 		LightHeaderData header_data;
 
@@ -0,0 +1,1254 @@
+//Header file.
+#include <Rendering/Native/MeshOptimization.h>
+
+//Core.
+#include <Core/Algorithms/HashAlgorithms.h>
+#include <Core/Algorithms/SortingAlgorithms.h>
+
+//Math.
+#include <Math/Core/BaseMath.h>
+
+//Mesh optimization constants.
+namespace MeshOptimizationConstants
+{
+	//The size of the data in a vertex, excluding the padding.
+	constexpr uint64 VERTEX_DATA_SIZE{ sizeof(Vector3<float32>) * 3 + sizeof(Vector2<float32>) };
+
+	//The invalid index.
+	constexpr uint32 INVALID_INDEX{ UINT32_MAXIMUM };
+
+	//The size of the modelled LRU cache in the vertex cache optimization.
+	constexpr uint32 VERTEX_CACHE_SIZE{ 32 };
+
+	//The score for vertices used by the last triangle.
+	constexpr float32 LAST_TRIANGLE_SCORE{ 0.75f };
+
+	//The scale of the valence boost.
+	constexpr float32 VALENCE_BOOST_SCALE{ 2.0f };
+
+	//The cache size used when finding clusters for overdraw optimization.
+	constexpr uint32 OVERDRAW_CACHE_SIZE{ 16 };
+}
+
+/*
+*	Quadric class definition.
+*	Symmetric 4x4 matrix of the summed, area weighted squared distances to a set of planes.
+*/
+class Quadric final
+{
+
+public:
+
+	//The upper triangle of the 3x3 part.
+	float64 _A00{ 0.0 };
+	float64 _A11{ 0.0 };
+	float64 _A22{ 0.0 };
+	float64 _A01{ 0.0 };
+	float64 _A02{ 0.0 };
+	float64 _A12{ 0.0 };
+
+	//The linear part.
+	float64 _B0{ 0.0 };
+	float64 _B1{ 0.0 };
+	float64 _B2{ 0.0 };
+
+	//The constant part.
+	float64 _C{ 0.0 };
+
+	//The total weight.
+	float64 _Weight{ 0.0 };
+
+	/*
+	*	Adds the plane with the given normal and distance, with the given weight.
+	*/
+	FORCE_INLINE void AddPlane(const Vector3<float32> &normal, const float32 distance, const float32 weight) NOEXCEPT
+	{
+		_A00 += weight * normal._X * normal._X;
+		_A11 += weight * normal._Y * normal._Y;
+		_A22 += weight * normal._Z * normal._Z;
+		_A01 += weight * normal._X * normal._Y;
+		_A02 += weight * normal._X * normal._Z;
+		_A12 += weight * normal._Y * normal._Z;
+		_B0 += weight * normal._X * distance;
+		_B1 += weight * normal._Y * distance;
+		_B2 += weight * normal._Z * distance;
+		_C += weight * distance * distance;
+		_Weight += weight;
+	}
+
+	/*
+	*	Adds another quadric to this quadric.
+	*/
+	FORCE_INLINE void operator+=(const Quadric &other) NOEXCEPT
+	{
+		_A00 += other._A00;
+		_A11 += other._A11;
+		_A22 += other._A22;
+		_A01 += other._A01;
+		_A02 += other._A02;
+		_A12 += other._A12;
+		_B0 += other._B0;
+		_B1 += other._B1;
+		_B2 += other._B2;
+		_C += other._C;
+		_Weight += other._Weight;
+	}
+
+	/*
+	*	Returns the summed, weighted squared distance of the given position to the planes.
+	*/
+	FORCE_INLINE NO_DISCARD float64 Evaluate(const Vector3<float32> &position) const NOEXCEPT
+	{
+		const float64 x{ position._X };
+		const float64 y{ position._Y };
+		const float64 z{ position._Z };
+
+		const float64 result
+		{
+			_A00 * x * x + _A11 * y * y + _A22 * z * z
+			+ 2.0 * (_A01 * x * y + _A02 * x * z + _A12 * y * z)
+			+ 2.0 * (_B0 * x + _B1 * y + _B2 * z)
+			+ _C
+		};
+
+		return result > 0.0 ? result : 0.0;
+	}
+
+};
+
+/*
+*	Collapse class definition.
+*/
+class Collapse final
+{
+
+public:
+
+	//The cost.
+	float32 _Cost;
+
+	//The canonical vertex to collapse from.
+	uint32 _From;
+
+	//The canonical vertex to collapse to.
+	uint32 _To;
+
+};
+
+/*
+*	Returns the sign of the given value, treating zero as positive.
+*/
+FORCE_INLINE NO_DISCARD static float32 NonZeroSign(const float32 value) NOEXCEPT
+{
+	return value >= 0.0f ? 1.0f : -1.0f;
+}
+
+/*
+*	Encodes the given unit vector with octahedral encoding.
+*/
+FORCE_INLINE static void EncodeOctahedral(const Vector3<float32> &vector, StaticArray<int16, 2> *const RESTRICT encoded) NOEXCEPT
+{
+	const float32 length{ BaseMath::Absolute(vector._X) + BaseMath::Absolute(vector._Y) + BaseMath::Absolute(vector._Z) };
+
+	if (length <= FLOAT32_EPSILON)
+	{
+		(*encoded)[0] = (*encoded)[1] = 0;
+
+		return;
+	}
+
+	float32 X{ vector._X / length };
+	float32 Y{ vector._Y / length };
+
+	//Fold the lower hemisphere over the diagonals.
+	if (vector._Z < 0.0f)
+	{
+		const float32 folded_X{ (1.0f - BaseMath::Absolute(Y)) * NonZeroSign(X) };
+		const float32 folded_Y{ (1.0f - BaseMath::Absolute(X)) * NonZeroSign(Y) };
+
+		X = folded_X;
+		Y = folded_Y;
+	}
+
+	(*encoded)[0] = BaseMath::Round<int16>(BaseMath::Clamp<float32>(X, -1.0f, 1.0f) * 32'767.0f);
+	(*encoded)[1] = BaseMath::Round<int16>(BaseMath::Clamp<float32>(Y, -1.0f, 1.0f) * 32'767.0f);
+}
+
+/*
+*	Decodes the given octahedral encoded unit vector.
+*/
+FORCE_INLINE NO_DISCARD static Vector3<float32> DecodeOctahedral(const StaticArray<int16, 2> &encoded) NOEXCEPT
+{
+	float32 X{ static_cast<float32>(encoded[0]) / 32'767.0f };
+	float32 Y{ static_cast<float32>(encoded[1]) / 32'767.0f };
+	const float32 Z{ 1.0f - BaseMath::Absolute(X) - BaseMath::Absolute(Y) };
+
+	//Unfold the lower hemisphere.
+	if (Z < 0.0f)
+	{
+		const float32 unfolded_X{ (1.0f - BaseMath::Absolute(Y)) * NonZeroSign(X) };
+		const float32 unfolded_Y{ (1.0f - BaseMath::Absolute(X)) * NonZeroSign(Y) };
+
+		X = unfolded_X;
+		Y = unfolded_Y;
+	}
+
+	Vector3<float32> vector{ X, Y, Z };
+
+	vector.NormalizeSafe();
+
+	return vector;
+}
+
+/*
+*	Quantizes the given value within the given range to 16 bits.
+*/
+FORCE_INLINE NO_DISCARD static uint16 QuantizeUnsignedNormalized(const float32 value, const float32 minimum, const float32 maximum) NOEXCEPT
+{
+	const float32 range{ maximum - minimum };
+
+	if (range <= 0.0f)
+	{
+		return 0;
+	}
+
+	return BaseMath::Round<uint16>(BaseMath::Clamp<float32>((value - minimum) / range, 0.0f, 1.0f) * 65'535.0f);
+}
+
+/*
+*	Dequantizes the given 16 bit value within the given range.
+*/
+FORCE_INLINE NO_DISCARD static float32 DequantizeUnsignedNormalized(const uint16 value, const float32 minimum, const float32 maximum) NOEXCEPT
+{
+	return minimum + (maximum - minimum) * (static_cast<float32>(value) / 65'535.0f);
+}
+
+/*
+*	Simulates a FIFO cache access of the given vertex. Returns if it was a miss.
+*/
+FORCE_INLINE NO_DISCARD static bool SimulateCacheAccess(const uint32 vertex, const uint32 cache_size, uint32 *const RESTRICT timestamps, uint32 *const RESTRICT timestamp) NOEXCEPT
+{
+	//A vertex is in the cache if less than 'cache_size' misses happened since it was last inserted.
+	if (*timestamp - timestamps[vertex] > cache_size)
+	{
+		timestamps[vertex] = (*timestamp)++;
+
+		return true;
+	}
+
+	return false;
+}
+
+/*
+*	Builds the list of triangles that use each vertex.
+*	The triangles of vertex N are in 'adjacency' from 'offsets[N]' to 'offsets[N + 1]'.
+*/
+static void BuildAdjacency(const uint32 *const RESTRICT indices, const uint64 number_of_indices, const uint64 number_of_vertices, DynamicArray<uint32> *const RESTRICT offsets, DynamicArray<uint32> *const RESTRICT adjacency) NOEXCEPT
+{
+	offsets->Resize<false>(number_of_vertices + 1);
+	Memory::Set(offsets->Data(), 0, sizeof(uint32) * (number_of_vertices + 1));
+
+	for (uint64 i{ 0 }; i < number_of_indices; ++i)
+	{
+		++(*offsets)[indices[i] + 1];
+	}
+
+	for (uint64 i{ 0 }; i < number_of_vertices; ++i)
+	{
+		(*offsets)[i + 1] += (*offsets)[i];
+	}
+
+	adjacency->Resize<false>(number_of_indices);
+
+	DynamicArray<uint32> cursors{ *offsets };
+
+	for (uint64 i{ 0 }; i < number_of_indices; ++i)
+	{
+		(*adjacency)[cursors[indices[i]]++] = static_cast<uint32>(i / 3);
+	}
+}
+
+/*
+*	Finds the given key in the given open addressing hash table, or inserts it if it doesn't exist.
+*	Returns the value that the key is mapped to.
+*/
+template <typename EQUAL_FUNCTION>
+FORCE_INLINE NO_DISCARD static uint32 FindOrInsert(DynamicArray<uint32> &table, const uint64 hash, const uint32 value, const EQUAL_FUNCTION &equal_function) NOEXCEPT
+{
+	const uint64 mask{ table.Size() - 1 };
+	uint64 slot{ hash & mask };
+
+	for (;;)
+	{
+		if (table[slot] == MeshOptimizationConstants::INVALID_INDEX)
+		{
+			table[slot] = value;
+
+			return value;
+		}
+
+		if (equal_function(table[slot]))
+		{
+			return table[slot];
+		}
+
+		slot = (slot + 1) & mask;
+	}
+}
+
+/*
+*	Sets up an empty hash table with room for the given number of elements.
+*/
+FORCE_INLINE static void SetupHashTable(const uint64 number_of_elements, DynamicArray<uint32> *const RESTRICT table) NOEXCEPT
+{
+	uint64 size{ 16 };
+
+	while (size < number_of_elements * 2)
+	{
+		size <<= 1;
+	}
+
+	table->Resize<false>(size);
+	Memory::Set(table->Data(), 0xff, sizeof(uint32) * size);
+}
+
+/*
+*	Merges vertices that are exactly equal, and remaps the indices accordingly.
+*/
+void MeshOptimization::DeduplicateVertices(DynamicArray<Vertex> *const RESTRICT vertices, DynamicArray<uint32> *const RESTRICT indices) NOEXCEPT
+{
+	DynamicArray<uint32> table;
+	SetupHashTable(vertices->Size(), &table);
+
+	DynamicArray<Vertex> unique_vertices;
+	unique_vertices.Reserve(vertices->Size());
+
+	DynamicArray<uint32> remap;
+	remap.Resize<false>(vertices->Size());
+
+	for (uint64 i{ 0 }; i < vertices->Size(); ++i)
+	{
+		const Vertex &vertex{ (*vertices)[i] };
+		const uint64 hash{ HashAlgorithms::CatalystHash(reinterpret_cast<const char *const RESTRICT>(&vertex), MeshOptimizationConstants::VERTEX_DATA_SIZE) };
+
+		remap[i] = FindOrInsert
+		(
+			table,
+			hash,
+			static_cast<uint32>(unique_vertices.Size()),
+			[&](const uint32 other)
+			{
+				return Memory::Compare(&unique_vertices[other], &vertex, MeshOptimizationConstants::VERTEX_DATA_SIZE);
+			}
+		);
+
+		if (remap[i] == unique_vertices.Size())
+		{
+			unique_vertices.Emplace(vertex);
+		}
+	}
+
+	for (uint32 &index : *indices)
+	{
+		index = remap[index];
+	}
+
+	*vertices = std::move(unique_vertices);
+}
+
+/*
+*	Reorders the triangles for the post-transform vertex cache, using Tom Forsyth's linear-speed vertex cache optimization.
+*/
+void MeshOptimization::OptimizeVertexCache(DynamicArray<uint32> *const RESTRICT indices, const uint64 number_of_vertices) NOEXCEPT
+{
+	const uint64 number_of_triangles{ indices->Size() / 3 };
+
+	if (number_of_triangles < 2)
+	{
+		return;
+	}
+
+	//Precalculate the cache position scores.
+	StaticArray<float32, MeshOptimizationConstants::VERTEX_CACHE_SIZE> cache_position_scores;
+
+	for (uint32 i{ 0 }; i < MeshOptimizationConstants::VERTEX_CACHE_SIZE; ++i)
+	{
+		if (i < 3)
+		{
+			cache_position_scores[i] = MeshOptimizationConstants::LAST_TRIANGLE_SCORE;
+		}
+
+		else
+		{
+			const float32 score{ 1.0f - static_cast<float32>(i - 3) / static_cast<float32>(MeshOptimizationConstants::VERTEX_CACHE_SIZE - 3) };
+
+			//Decay power of 1.5.
+			cache_position_scores[i] = score * BaseMath::SquareRoot(score);
+		}
+	}
+
+	const DynamicArray<uint32> source_indices{ *indices };
+
+	//Set up the adjacency. The triangles still left to emit for vertex N are the first 'remaining_triangles[N]' entries of it's adjacency.
+	DynamicArray<uint32> offsets;
+	DynamicArray<uint32> adjacency;
+
+	BuildAdjacency(source_indices.Data(), source_indices.Size(), number_of_vertices, &offsets, &adjacency);
+
+	DynamicArray<uint32> remaining_triangles;
+	DynamicArray<int32> cache_positions;
+	DynamicArray<float32> vertex_scores;
+
+	remaining_triangles.Resize<false>(number_of_vertices);
+	cache_positions.Resize<false>(number_of_vertices);
+	vertex_scores.Resize<false>(number_of_vertices);
+
+	const auto calculate_vertex_score{ [&](const uint32 vertex)
+	{
+		if (remaining_triangles[vertex] == 0)
+		{
+			return -1.0f;
+		}
+
+		const float32 cache_score{ cache_positions[vertex] >= 0 ? cache_position_scores[cache_positions[vertex]] : 0.0f };
+
+		//Boost vertices with few triangles left, so lone triangles don't get left behind.
+		return cache_score + MeshOptimizationConstants::VALENCE_BOOST_SCALE / BaseMath::SquareRoot(static_cast<float32>(remaining_triangles[vertex]));
+	} };
+
+	for (uint64 i{ 0 }; i < number_of_vertices; ++i)
+	{
+		remaining_triangles[i] = offsets[i + 1] - offsets[i];
+		cache_positions[i] = -1;
+		vertex_scores[i] = calculate_vertex_score(static_cast<uint32>(i));
+	}
+
+	DynamicArray<float32> triangle_scores;
+	DynamicArray<bool> emitted;
+
+	triangle_scores.Resize<false>(number_of_triangles);
+	emitted.Resize<false>(number_of_triangles);
+
+	uint32 best_triangle{ MeshOptimizationConstants::INVALID_INDEX };
+	float32 best_score{ -1.0f };
+
+	for (uint64 i{ 0 }; i < number_of_triangles; ++i)
+	{
+		triangle_scores[i] = vertex_scores[source_indices[i * 3 + 0]] + vertex_scores[source_indices[i * 3 + 1]] + vertex_scores[source_indices[i * 3 + 2]];
+		emitted[i] = false;
+
+		if (triangle_scores[i] > best_score)
+		{
+			best_triangle = static_cast<uint32>(i);
+			best_score = triangle_scores[i];
+		}
+	}
+
+	StaticArray<uint32, MeshOptimizationConstants::VERTEX_CACHE_SIZE + 3> cache;
+	StaticArray<uint32, MeshOptimizationConstants::VERTEX_CACHE_SIZE + 3> new_cache;
+	uint32 cache_size{ 0 };
+	uint64 input_cursor{ 0 };
+
+	for (uint64 output_triangle{ 0 }; output_triangle < number_of_triangles; ++output_triangle)
+	{
+		//If no triangle in the cache is a candidate, pick the next triangle in input order.
+		if (best_triangle == MeshOptimizationConstants::INVALID_INDEX)
+		{
+			while (emitted[input_cursor])
+			{
+				++input_cursor;
+			}
+
+			best_triangle = static_cast<uint32>(input_cursor);
+		}
+
+		//Emit the triangle.
+		const uint32 *const RESTRICT triangle{ &source_indices[best_triangle * 3] };
+
+		for (uint8 i{ 0 }; i < 3; ++i)
+		{
+			(*indices)[output_triangle * 3 + i] = triangle[i];
+		}
+
+		emitted[best_triangle] = true;
+
+		//Remove the triangle from the remaining triangles of it's vertices.
+		for (uint8 i{ 0 }; i < 3; ++i)
+		{
+			const uint32 vertex{ triangle[i] };
+			uint32 *const RESTRICT vertex_triangles{ &adjacency[offsets[vertex]] };
+
+			for (uint32 j{ 0 }; j < remaining_triangles[vertex]; ++j)
+			{
+				if (vertex_triangles[j] == best_triangle)
+				{
+					vertex_triangles[j] = vertex_triangles[remaining_triangles[vertex] - 1];
+					--remaining_triangles[vertex];
+
+					break;
+				}
+			}
+		}
+
+		//Push the triangle's vertices to the front of the cache.
+		uint32 new_cache_size{ 0 };
+
+		for (uint8 i{ 0 }; i < 3; ++i)
+		{
+			new_cache[new_cache_size++] = triangle[i];
+		}
+
+		for (uint32 i{ 0 }; i < cache_size; ++i)
+		{
+			const uint32 vertex{ cache[i] };
+
+			if (vertex != triangle[0] && vertex != triangle[1] && vertex != triangle[2])
+			{
+				new_cache[new_cache_size++] = vertex;
+			}
+		}
+
+		//Update the vertex scores. Vertices pushed out of the cache need their scores updated as well.
+		for (uint32 i{ 0 }; i < new_cache_size; ++i)
+		{
+			const uint32 vertex{ new_cache[i] };
+
+			cache_positions[vertex] = i < MeshOptimizationConstants::VERTEX_CACHE_SIZE ? static_cast<int32>(i) : -1;
+			vertex_scores[vertex] = calculate_vertex_score(vertex);
+		}
+
+		//Update the triangle scores, and find the next best triangle among them.
+		best_triangle = MeshOptimizationConstants::INVALID_INDEX;
+		best_score = -1.0f;
+
+		for (uint32 i{ 0 }; i < new_cache_size; ++i)
+		{
+			const uint32 vertex{ new_cache[i] };
+
+			for (uint32 j{ 0 }; j < remaining_triangles[vertex]; ++j)
+			{
+				const uint32 triangle_index{ adjacency[offsets[vertex] + j] };
+				const float32 score{ vertex_scores[source_indices[triangle_index * 3 + 0]] + vertex_scores[source_indices[triangle_index * 3 + 1]] + vertex_scores[source_indices[triangle_index * 3 + 2]] };
+
+				triangle_scores[triangle_index] = score;
+
+				if (score > best_score)
+				{
+					best_triangle = triangle_index;
+					best_score = score;
+				}
+			}
+		}
+
+		cache_size = BaseMath::Minimum<uint32>(new_cache_size, MeshOptimizationConstants::VERTEX_CACHE_SIZE);
+		Memory::Copy(cache.Data(), new_cache.Data(), sizeof(uint32) * cache_size);
+	}
+}
+
+/*
+*	Reorders clusters of triangles to reduce overdraw, drawing outward facing clusters first.
+*	Should be run after OptimizeVertexCache(). The threshold is how much the average cache miss ratio is allowed to get worse, 1.05f allows 5%.
+*/
+void MeshOptimization::OptimizeOverdraw(const DynamicArray<Vertex> &vertices, DynamicArray<uint32> *const RESTRICT indices, const float32 threshold) NOEXCEPT
+{
+	const uint64 number_of_triangles{ indices->Size() / 3 };
+
+	if (number_of_triangles < 2)
+	{
+		return;
+	}
+
+	constexpr uint32 CACHE_SIZE{ MeshOptimizationConstants::OVERDRAW_CACHE_SIZE };
+
+	DynamicArray<uint32> timestamps;
+	timestamps.Resize<false>(vertices.Size());
+	Memory::Set(timestamps.Data(), 0, sizeof(uint32) * vertices.Size());
+
+	uint32 timestamp{ CACHE_SIZE + 1 };
+
+	const auto triangle_misses{ [&](const uint64 triangle_index)
+	{
+		uint32 misses{ 0 };
+
+		for (uint8 i{ 0 }; i < 3; ++i)
+		{
+			misses += SimulateCacheAccess((*indices)[triangle_index * 3 + i], CACHE_SIZE, timestamps.Data(), &timestamp);
+		}
+
+		return misses;
+	} };
+
+	//Find the hard boundaries, where the vertex cache optimization had to start over and all vertices of a triangle miss the cache.
+	DynamicArray<uint32> hard_clusters;
+
+	for (uint64 i{ 0 }; i < number_of_triangles; ++i)
+	{
+		if (triangle_misses(i) == 3 || i == 0)
+		{
+			hard_clusters.Emplace(static_cast<uint32>(i));
+		}
+	}
+
+	hard_clusters.Emplace(static_cast<uint32>(number_of_triangles));
+
+	//Split the hard clusters further, as long as the cache efficiency within each piece stays within the threshold of the whole cluster.
+	DynamicArray<uint32> clusters;
+
+	for (uint64 hard_cluster_index{ 0 }; hard_cluster_index < hard_clusters.Size() - 1; ++hard_cluster_index)
+	{
+		const uint32 start{ hard_clusters[hard_cluster_index] };
+		const uint32 end{ hard_clusters[hard_cluster_index + 1] };
+
+		//Calculate the average cache miss ratio of the whole cluster, starting from a cold cache.
+		timestamp += CACHE_SIZE + 1;
+
+		uint32 cluster_misses{ 0 };
+
+		for (uint32 i{ start }; i < end; ++i)
+		{
+			cluster_misses += triangle_misses(i);
+		}
+
+		const float32 cluster_threshold{ static_cast<float32>(cluster_misses) / static_cast<float32>(end - start) * threshold };
+
+		//Split whenever the current piece is efficient enough.
+		clusters.Emplace(start);
+
+		timestamp += CACHE_SIZE + 1;
+
+		uint32 piece_start{ start };
+		uint32 piece_misses{ 0 };
+
+		for (uint32 i{ start }; i < end; ++i)
+		{
+			piece_misses += triangle_misses(i);
+
+			if (i + 1 < end && static_cast<float32>(piece_misses) / static_cast<float32>(i + 1 - piece_start) <= cluster_threshold)
+			{
+				clusters.Emplace(i + 1);
+
+				piece_start = i + 1;
+				piece_misses = 0;
+				timestamp += CACHE_SIZE + 1;
+			}
+		}
+	}
+
+	clusters.Emplace(static_cast<uint32>(number_of_triangles));
+
+	//Calculate the centroid of the mesh.
+	Vector3<float32> mesh_centroid{ 0.0f, 0.0f, 0.0f };
+
+	for (const Vertex &vertex : vertices)
+	{
+		mesh_centroid += vertex._Position;
+	}
+
+	mesh_centroid /= static_cast<float32>(vertices.Size());
+
+	//Calculate the sort key of each cluster; how much the cluster faces away from the center of the mesh.
+	class ClusterSortData final
+	{
+
+	public:
+
+		//The sort key.
+		float32 _SortKey;
+
+		//The cluster index.
+		uint32 _ClusterIndex;
+
+	};
+
+	DynamicArray<ClusterSortData> sort_data;
+	sort_data.Resize<false>(clusters.Size() - 1);
+
+	for (uint64 cluster_index{ 0 }; cluster_index < clusters.Size() - 1; ++cluster_index)
+	{
+		Vector3<float32> centroid{ 0.0f, 0.0f, 0.0f };
+		Vector3<float32> normal{ 0.0f, 0.0f, 0.0f };
+		float32 total_area{ 0.0f };
+
+		for (uint32 i{ clusters[cluster_index] }; i < clusters[cluster_index + 1]; ++i)
+		{
+			const Vector3<float32> &A{ vertices[(*indices)[i * 3 + 0]]._Position };
+			const Vector3<float32> &B{ vertices[(*indices)[i * 3 + 1]]._Position };
+			const Vector3<float32> &C{ vertices[(*indices)[i * 3 + 2]]._Position };
+
+			const Vector3<float32> cross_product{ Vector3<float32>::CrossProduct(B - A, C - A) };
+			const float32 area{ Vector3<float32>::Length(cross_product) };
+
+			centroid += (A + B + C) * (area / 3.0f);
+			normal += cross_product;
+			total_area += area;
+		}
+
+		if (total_area > 0.0f)
+		{
+			centroid /= total_area;
+		}
+
+		normal.NormalizeSafe();
+
+		sort_data[cluster_index]._SortKey = Vector3<float32>::DotProduct(centroid - mesh_centroid, normal);
+		sort_data[cluster_index]._ClusterIndex = static_cast<uint32>(cluster_index);
+	}
+
+	//Sort the clusters so that the most outward facing ones are drawn first, keeping the original order for ties.
+	SortingAlgorithms::StandardSort<ClusterSortData>
+	(
+		sort_data.Begin(),
+		sort_data.End(),
+		nullptr,
+		[](const void *const RESTRICT user_data, const ClusterSortData *const RESTRICT first, const ClusterSortData *const RESTRICT second)
+		{
+			if (first->_SortKey != second->_SortKey)
+			{
+				return first->_SortKey > second->_SortKey;
+			}
+
+			return first->_ClusterIndex < second->_ClusterIndex;
+		}
+	);
+
+	//Write out the triangles in the new cluster order.
+	const DynamicArray<uint32> source_indices{ *indices };
+	uint64 output_index{ 0 };
+
+	for (const ClusterSortData &cluster : sort_data)
+	{
+		const uint64 first_index{ static_cast<uint64>(clusters[cluster._ClusterIndex]) * 3 };
+		const uint64 last_index{ static_cast<uint64>(clusters[cluster._ClusterIndex + 1]) * 3 };
+
+		Memory::Copy(&(*indices)[output_index], &source_indices[first_index], sizeof(uint32) * (last_index - first_index));
+
+		output_index += last_index - first_index;
+	}
+}
+
+/*
+*	Reorders the vertices in the order they are first referenced by the indices, and removes vertices that aren't referenced at all.
+*	Should be run last.
+*/
+void MeshOptimization::OptimizeVertexFetch(DynamicArray<Vertex> *const RESTRICT vertices, DynamicArray<uint32> *const RESTRICT indices) NOEXCEPT
+{
+	DynamicArray<uint32> remap;
+	remap.Resize<false>(vertices->Size());
+	Memory::Set(remap.Data(), 0xff, sizeof(uint32) * vertices->Size());
+
+	DynamicArray<Vertex> new_vertices;
+	new_vertices.Reserve(vertices->Size());
+
+	for (uint32 &index : *indices)
+	{
+		if (remap[index] == MeshOptimizationConstants::INVALID_INDEX)
+		{
+			remap[index] = static_cast<uint32>(new_vertices.Size());
+			new_vertices.Emplace((*vertices)[index]);
+		}
+
+		index = remap[index];
+	}
+
+	*vertices = std::move(new_vertices);
+}
+
+/*
+*	Returns the average cache miss ratio (the number of vertex shader invocations per triangle) for a FIFO cache of the given size.
+*/
+NO_DISCARD float32 MeshOptimization::AverageCacheMissRatio(const DynamicArray<uint32> &indices, const uint64 number_of_vertices, const uint32 cache_size) NOEXCEPT
+{
+	if (indices.Size() < 3)
+	{
+		return 0.0f;
+	}
+
+	DynamicArray<uint32> timestamps;
+	timestamps.Resize<false>(number_of_vertices);
+	Memory::Set(timestamps.Data(), 0, sizeof(uint32) * number_of_vertices);
+
+	uint32 timestamp{ cache_size + 1 };
+	uint64 misses{ 0 };
+
+	for (const uint32 index : indices)
+	{
+		misses += SimulateCacheAccess(index, cache_size, timestamps.Data(), &timestamp);
+	}
+
+	return static_cast<float32>(misses) / static_cast<float32>(indices.Size() / 3);
+}
+
+/*
+*	Simplifies the given mesh with quadric error metrics, until either the target number of indices or the target error is reached.
+*	The error is relative to the extent of the mesh, so 0.01f means one percent of the mesh size.
+*	Attribute seams and borders are kept intact. The resulting indices reference the original vertices.
+*	Returns the error that was actually reached.
+*/
+float32 MeshOptimization::Simplify
+(
+	const DynamicArray<Vertex> &vertices,
+	const DynamicArray<uint32> &indices,
+	const uint64 target_number_of_indices,
+	const float32 target_error,
+	DynamicArray<uint32> *const RESTRICT output_indices
+) NOEXCEPT
+{
+	*output_indices = indices;
+
+	if (indices.Size() <= target_number_of_indices || vertices.Empty())
+	{
+		return 0.0f;
+	}
+
+	const uint64 number_of_vertices{ vertices.Size() };
+
+	/*
+	*	Weld vertices with the same position into one canonical vertex.
+	*	Vertices with the same position but different attributes (wedges) are kept apart in the output, but move as one.
+	*/
+	DynamicArray<uint32> canonical;
+	canonical.Resize<false>(number_of_vertices);
+
+	{
+		DynamicArray<uint32> table;
+		SetupHashTable(number_of_vertices, &table);
+
+		for (uint64 i{ 0 }; i < number_of_vertices; ++i)
+		{
+			const Vector3<float32> &position{ vertices[i]._Position };
+
+			canonical[i] = FindOrInsert
+			(
+				table,
+				HashAlgorithms::CatalystHash(reinterpret_cast<const char *const RESTRICT>(&position), sizeof(Vector3<float32>)),
+				static_cast<uint32>(i),
+				[&](const uint32 other)
+				{
+					return Memory::Compare(&vertices[other]._Position, &position, sizeof(Vector3<float32>));
+				}
+			);
+		}
+	}
+
+	//Gather the wedges of each canonical vertex.
+	DynamicArray<uint32> wedge_offsets;
+	DynamicArray<uint32> wedges;
+
+	{
+		wedge_offsets.Resize<false>(number_of_vertices + 1);
+		Memory::Set(wedge_offsets.Data(), 0, sizeof(uint32) * (number_of_vertices + 1));
+
+		for (uint64 i{ 0 }; i < number_of_vertices; ++i)
+		{
+			++wedge_offsets[canonical[i] + 1];
+		}
+
+		for (uint64 i{ 0 }; i < number_of_vertices; ++i)
+		{
+			wedge_offsets[i + 1] += wedge_offsets[i];
+		}
+
+		wedges.Resize<false>(number_of_vertices);
+
+		DynamicArray<uint32> cursors{ wedge_offsets };
+
+		for (uint64 i{ 0 }; i < number_of_vertices; ++i)
+		{
+			wedges[cursors[canonical[i]]++] = static_cast<uint32>(i);
+		}
+	}
+
+	//Normalize the positions, so that errors are relative to the size of the mesh.
+	DynamicArray<Vector3<float32>> positions;
+	positions.Resize<false>(number_of_vertices);
+
+	{
+		AxisAlignedBoundingBox3D bounds;
+
+		for (const Vertex &vertex : vertices)
+		{
+			bounds.Expand(vertex._Position);
+		}
+
+		const Vector3<float32> extent{ bounds._Maximum - bounds._Minimum };
+		const float32 maximum_extent{ BaseMath::Maximum<float32>(BaseMath::Maximum<float32>(extent._X, extent._Y), extent._Z) };
+		const float32 scale{ maximum_extent > 0.0f ? 1.0f / maximum_extent : 1.0f };
+
+		for (uint64 i{ 0 }; i < number_of_vertices; ++i)
+		{
+			positions[i] = (vertices[i]._Position - bounds._Minimum) * scale;
+		}
+	}
+
+	//Lock vertices on attribute seams, so the seams stay intact.
+	DynamicArray<bool> locked;
+	locked.Resize<false>(number_of_vertices);
+
+	for (uint64 i{ 0 }; i < number_of_vertices; ++i)
+	{
+		locked[i] = (wedge_offsets[i + 1] - wedge_offsets[i]) > 1;
+	}
+
+	//Lock vertices on borders and non-manifold edges, so the silhouette of open meshes stays intact.
+	DynamicArray<uint64> edge_keys;
+	DynamicArray<uint32> edge_order;
+
+	const auto gather_edges{ [&](const DynamicArray<uint32> &triangles)
+	{
+		edge_keys.Resize<false>(triangles.Size());
+		edge_order.Resize<false>(triangles.Size());
+
+		for (uint64 i{ 0 }; i < triangles.Size(); i += 3)
+		{
+			for (uint8 j{ 0 }; j < 3; ++j)
+			{
+				const uint64 A{ canonical[triangles[i + j]] };
+				const uint64 B{ canonical[triangles[i + (j + 1) % 3]] };
+
+				edge_keys[i + j] = A < B ? (A << 32) | B : (B << 32) | A;
+			}
+		}
+
+		SortingAlgorithms::RadixSort(edge_keys.Data(), edge_keys.Size(), edge_order.Data());
+	} };
+
+	gather_edges(indices);
+
+	for (uint64 i{ 0 }; i < edge_order.Size();)
+	{
+		const uint64 key{ edge_keys[edge_order[i]] };
+		uint64 run_length{ 1 };
+
+		while (i + run_length < edge_order.Size() && edge_keys[edge_order[i + run_length]] == key)
+		{
+			++run_length;
+		}
+
+		if (run_length != 2)
+		{
+			locked[key >> 32] = true;
+			locked[key & UINT32_MAXIMUM] = true;
+		}
+
+		i += run_length;
+	}
+
+	//Calculate the quadrics.
+	DynamicArray<Quadric> quadrics;
+	quadrics.Upsize<true>(number_of_vertices);
+
+	for (uint64 i{ 0 }; i < indices.Size(); i += 3)
+	{
+		const uint32 A{ canonical[indices[i + 0]] };
+		const uint32 B{ canonical[indices[i + 1]] };
+		const uint32 C{ canonical[indices[i + 2]] };
+
+		Vector3<float32> normal{ Vector3<float32>::CrossProduct(positions[B] - positions[A], positions[C] - positions[A]) };
+		const float32 double_area{ Vector3<float32>::Length(normal) };
+
+		if (double_area <= FLOAT32_EPSILON)
+		{
+			continue;
+		}
+
+		normal /= double_area;
+
+		const float32 distance{ -Vector3<float32>::DotProduct(normal, positions[A]) };
+
+		quadrics[A].AddPlane(normal, distance, double_area * 0.5f);
+		quadrics[B].AddPlane(normal, distance, double_area * 0.5f);
+		quadrics[C].AddPlane(normal, distance, double_area * 0.5f);
+	}
+
+	//Returns the average squared distance for moving the given vertex to the given position.
+	const auto collapse_cost{ [&](const uint32 from, const uint32 to)
+	{
+		Quadric quadric{ quadrics[from] };
+		quadric += quadrics[to];
+
+		return static_cast<float32>(quadric.Evaluate(positions[to]) / BaseMath::Maximum<float64>(quadric._Weight, FLOAT64_EPSILON));
+	} };
+
+	//Collapse edges in passes, cheapest first, until the target is reached or nothing can be collapsed within the target error.
+	const float32 maximum_cost{ target_error * target_error };
+	float32 reached_cost{ 0.0f };
+
+	DynamicArray<Collapse> collapses;
+	DynamicArray<uint32> adjacency_offsets;
+	DynamicArray<uint32> adjacency;
+	DynamicArray<uint32> canonical_triangles;
+	DynamicArray<bool> touched;
+	DynamicArray<uint32> collapse_targets;
+
+	touched.Resize<false>(number_of_vertices);
+	collapse_targets.Resize<false>(number_of_vertices);
+
+	while (output_indices->Size() > target_number_of_indices)
+	{
+		//Gather the collapse candidates, one per unique edge, in the cheapest valid direction.
+		gather_edges(*output_indices);
+		collapses.Clear();
+
+		for (uint64 i{ 0 }; i < edge_order.Size(); ++i)
+		{
+			const uint64 key{ edge_keys[edge_order[i]] };
+
+			if (i > 0 && edge_keys[edge_order[i - 1]] == key)
+			{
+				continue;
+			}
+
+			const uint32 A{ static_cast<uint32>(key >> 32) };
+			const uint32 B{ static_cast<uint32>(key & UINT32_MAXIMUM) };
+
+			const float32 cost_A_to_B{ locked[A] ? FLOAT32_MAXIMUM : collapse_cost(A, B) };
+			const float32 cost_B_to_A{ locked[B] ? FLOAT32_MAXIMUM : collapse_cost(B, A) };
+
+			Collapse collapse;
+
+			collapse._Cost = cost_A_to_B <= cost_B_to_A ? cost_A_to_B : cost_B_to_A;
+			collapse._From = cost_A_to_B <= cost_B_to_A ? A : B;
+			collapse._To = cost_A_to_B <= cost_B_to_A ? B : A;
+
+			if (collapse._Cost <= maximum_cost)
+			{
+				collapses.Emplace(collapse);
+			}
+		}
+
+		if (collapses.Empty())
+		{
+			break;
+		}
+
+		SortingAlgorithms::StandardSort<Collapse>
+		(
+			collapses.Begin(),
+			collapses.End(),
+			nullptr,
+			[](const void *const RESTRICT user_data, const Collapse *const RESTRICT first, const Collapse *const RESTRICT second)
+			{
+				return first->_Cost < second->_Cost;
+			}
+		);
+
+		//Build the triangle adjacency of the canonical vertices, used for the flip test.
+		canonical_triangles.Resize<false>(output_indices->Size());
+
+		for (uint64 i{ 0 }; i < output_indices->Size(); ++i)
+		{
+			canonical_triangles[i] = canonical[(*output_indices)[i]];
+		}
+
+		BuildAdjacency(canonical_triangles.Data(), canonical_triangles.Size(), number_of_vertices, &adjacency_offsets, &adjacency);
+
+		//Perform the collapses. Each one removes roughly two triangles, and vertices can only be part of one collapse per pass.
+		const uint64 maximum_number_of_collapses{ BaseMath::Maximum<uint64>((output_indices->Size() - target_number_of_indices) / 6, 1) };
+		uint64 number_of_collapses{ 0 };
+
+		Memory::Set(touched.Data(), 0, sizeof(bool) * number_of_vertices);
+
+		for (uint64 i{ 0 }; i < number_of_vertices; ++i)
+		{
+			collapse_targets[i] = static_cast<uint32>(i);
+		}
+
+		for (const Collapse &collapse : collapses)
+		{
+			if (number_of_collapses >= maximum_number_of_collapses)
+			{
+				break;
+			}
+
+			if (touched[collapse._From] || touched[collapse._To])
+			{
+				continue;
+			}
+
+			//Make sure that none of the remaining triangles around the vertex flip.
+			bool flips{ false };
+
+			for (uint32 j{ adjacency_offsets[collapse._From] }; j < adjacency_offsets[collapse._From + 1] && !flips; ++j)
+			{
+				const uint32 *const RESTRICT triangle{ &canonical_triangles[adjacency[j] * 3] };
+
+				if (triangle[0] == collapse._To || triangle[1] == collapse._To || triangle[2] == collapse._To)
+				{
+					continue;
+				}
+
+				StaticArray<Vector3<float32>, 3> corners;
+
+				for (uint8 k{ 0 }; k < 3; ++k)
+				{
+					corners[k] = positions[triangle[k]];
+				}
+
+				const Vector3<float32> old_normal{ Vector3<float32>::CrossProduct(corners[1] - corners[0], corners[2] - corners[0]) };
+
+				for (uint8 k{ 0 }; k < 3; ++k)
+				{
+					if (triangle[k] == collapse._From)
+					{
+						corners[k] = positions[collapse._To];
+					}
+				}
+
+				const Vector3<float32> new_normal{ Vector3<float32>::CrossProduct(corners[1] - corners[0], corners[2] - corners[0]) };
+
+				flips = Vector3<float32>::DotProduct(old_normal, new_normal) <= 0.0f;
+			}
+
+			if (flips)
+			{
+				continue;
+			}
+
+			collapse_targets[collapse._From] = collapse._To;
+			touched[collapse._From] = true;
+			touched[collapse._To] = true;
+
+			quadrics[collapse._To] += quadrics[collapse._From];
+			reached_cost = BaseMath::Maximum<float32>(reached_cost, collapse._Cost);
+
+			++number_of_collapses;
+		}
+
+		if (number_of_collapses == 0)
+		{
+			break;
+		}
+
+		//Rewrite the triangles. Collapsed vertices are never locked, so they only have one wedge, which is replaced by the closest wedge of the target.
+		uint64 output_size{ 0 };
+
+		for (uint64 i{ 0 }; i < output_indices->Size(); i += 3)
+		{
+			StaticArray<uint32, 3> triangle;
+
+			for (uint8 j{ 0 }; j < 3; ++j)
+			{
+				const uint32 vertex{ (*output_indices)[i + j] };
+				const uint32 target{ collapse_targets[canonical[vertex]] };
+
+				if (target == canonical[vertex])
+				{
+					triangle[j] = vertex;
+
+					continue;
+				}
+
+				float32 best_distance{ FLOAT32_MAXIMUM };
+
+				for (uint32 k{ wedge_offsets[target] }; k < wedge_offsets[target + 1]; ++k)
+				{
+					const Vertex &wedge{ vertices[wedges[k]] };
+					const float32 distance
+					{
+						Vector2<float32>::LengthSquared(wedge._TextureCoordinate - vertices[vertex]._TextureCoordinate)
+						+ Vector3<float32>::LengthSquared(wedge._Normal - vertices[vertex]._Normal)
+					};
+
+					if (distance < best_distance)
+					{
+						best_distance = distance;
+						triangle[j] = wedges[k];
+					}
+				}
+			}
+
+			//Drop triangles that became degenerate.
+			if (canonical[triangle[0]] == canonical[triangle[1]] || canonical[triangle[1]] == canonical[triangle[2]] || canonical[triangle[2]] == canonical[triangle[0]])
+			{
+				continue;
+			}
+
+			for (uint8 j{ 0 }; j < 3; ++j)
+			{
+				(*output_indices)[output_size++] = triangle[j];
+			}
+		}
+
+		output_indices->Resize<false>(output_size);
+	}
+
+	return BaseMath::SquareRoot(reached_cost);
+}
+
+/*
+*	Expands the given quantization bounds to cover the given vertices.
+*/
+void MeshOptimization::ExpandQuantizationBounds(const DynamicArray<Vertex> &vertices, QuantizationBounds *const RESTRICT bounds) NOEXCEPT
+{
+	for (const Vertex &vertex : vertices)
+	{
+		for (uint8 i{ 0 }; i < 3; ++i)
+		{
+			bounds->_MinimumPosition[i] = BaseMath::Minimum<float32>(bounds->_MinimumPosition[i], vertex._Position[i]);
+			bounds->_MaximumPosition[i] = BaseMath::Maximum<float32>(bounds->_MaximumPosition[i], vertex._Position[i]);
+		}
+
+		for (uint8 i{ 0 }; i < 2; ++i)
+		{
+			bounds->_MinimumTextureCoordinate[i] = BaseMath::Minimum<float32>(bounds->_MinimumTextureCoordinate[i], vertex._TextureCoordinate[i]);
+			bounds->_MaximumTextureCoordinate[i] = BaseMath::Maximum<float32>(bounds->_MaximumTextureCoordinate[i], vertex._TextureCoordinate[i]);
+		}
+	}
+}
+
+/*
+*	Quantizes the given vertices within the given bounds.
+*/
+void MeshOptimization::Quantize(const DynamicArray<Vertex> &vertices, const QuantizationBounds &bounds, DynamicArray<QuantizedVertex> *const RESTRICT quantized_vertices) NOEXCEPT
+{
+	//Quantize the vertices.
+	quantized_vertices->Resize<false>(vertices.Size());
+
+	for (uint64 i{ 0 }; i < vertices.Size(); ++i)
+	{
+		const Vertex &vertex{ vertices[i] };
+		QuantizedVertex &quantized_vertex{ (*quantized_vertices)[i] };
+
+		for (uint8 j{ 0 }; j < 3; ++j)
+		{
+			quantized_vertex._Position[j] = QuantizeUnsignedNormalized(vertex._Position[j], bounds._MinimumPosition[j], bounds._MaximumPosition[j]);
+		}
+
+		quantized_vertex._Position[3] = 0;
+
+		EncodeOctahedral(vertex._Normal, &quantized_vertex._Normal);
+		EncodeOctahedral(vertex._Tangent, &quantized_vertex._Tangent);
+
+		for (uint8 j{ 0 }; j < 2; ++j)
+		{
+			quantized_vertex._TextureCoordinate[j] = QuantizeUnsignedNormalized(vertex._TextureCoordinate[j], bounds._MinimumTextureCoordinate[j], bounds._MaximumTextureCoordinate[j]);
+		}
+	}
+}
+
+/*
+*	Dequantizes the given vertices.
+*/
+void MeshOptimization::Dequantize(const QuantizedVertex *const RESTRICT quantized_vertices, const uint64 number_of_vertices, const QuantizationBounds &bounds, Vertex *const RESTRICT vertices) NOEXCEPT
+{
+	for (uint64 i{ 0 }; i < number_of_vertices; ++i)
+	{
+		const QuantizedVertex &quantized_vertex{ quantized_vertices[i] };
+		Vertex &vertex{ vertices[i] };
+
+		for (uint8 j{ 0 }; j < 3; ++j)
+		{
+			vertex._Position[j] = DequantizeUnsignedNormalized(quantized_vertex._Position[j], bounds._MinimumPosition[j], bounds._MaximumPosition[j]);
+		}
+
+		vertex._Normal = DecodeOctahedral(quantized_vertex._Normal);
+		vertex._Tangent = DecodeOctahedral(quantized_vertex._Tangent);
+
+		for (uint8 j{ 0 }; j < 2; ++j)
+		{
+			vertex._TextureCoordinate[j] = DequantizeUnsignedNormalized(quantized_vertex._TextureCoordinate[j], bounds._MinimumTextureCoordinate[j], bounds._MaximumTextureCoordinate[j]);
+		}
+
+		Memory::Set(&vertex._Padding, 0, sizeof(vertex._Padding));
+	}
+}
\ No newline at end of file
@@ -31,8 +31,10 @@ void Pipeline::ProcessInputStream(const RenderInputStream &input_stream, Command
 	{
 		case RenderInputStream::Mode::DISPATCH:
 		{
-			for (const RenderInputStreamEntry &entry : input_stream._Entries)
+			for (uint64 entry_index{ 0 }; entry_index < input_stream._Entries.Size(); ++entry_index)
 			{
+				const RenderInputStreamEntry &entry{ input_stream.GetEntry(entry_index) };
+
 				//Push constants.
 				if (input_stream._RequiredPushConstantDataSize != 0)
 				{
@@ -55,8 +57,10 @@ void Pipeline::ProcessInputStream(const RenderInputStream &input_stream, Command
 
 		case RenderInputStream::Mode::DRAW:
 		{
-			for (const RenderInputStreamEntry& entry : input_stream._Entries)
+			for (uint64 entry_index{ 0 }; entry_index < input_stream._Entries.Size(); ++entry_index)
 			{
+				const RenderInputStreamEntry &entry{ input_stream.GetEntry(entry_index) };
+
 				//Push constants.
 				if (input_stream._RequiredPushConstantDataSize != 0)
 				{
@@ -79,8 +83,10 @@ void Pipeline::ProcessInputStream(const RenderInputStream &input_stream, Command
 
 		case RenderInputStream::Mode::DRAW_INSTANCED:
 		{
-			for (const RenderInputStreamEntry &entry : input_stream._Entries)
+			for (uint64 entry_index{ 0 }; entry_index < input_stream._Entries.Size(); ++entry_index)
 			{
+				const RenderInputStreamEntry &entry{ input_stream.GetEntry(entry_index) };
+
 				if (input_stream._RequiredPushConstantDataSize != 0)
 				{
 					command_buffer->PushConstants
@@ -107,8 +113,15 @@ void Pipeline::ProcessInputStream(const RenderInputStream &input_stream, Command
 
 		case RenderInputStream::Mode::DRAW_INDEXED:
 		{
-			for (const RenderInputStreamEntry &entry : input_stream._Entries)
+			//Sorted input streams keep draws of the same mesh together, so only rebind buffers when they change.
+			BufferHandle bound_vertex_buffer{ EMPTY_HANDLE };
+			BufferHandle bound_index_buffer{ EMPTY_HANDLE };
+			uint64 bound_index_buffer_offset{ 0 };
+
+			for (uint64 entry_index{ 0 }; entry_index < input_stream._Entries.Size(); ++entry_index)
 			{
+				const RenderInputStreamEntry &entry{ input_stream.GetEntry(entry_index) };
+
 				command_buffer->PushConstants
 				(
 					this,
@@ -118,8 +131,18 @@ void Pipeline::ProcessInputStream(const RenderInputStream &input_stream, Command
 					push_constant_data ? push_constant_data : &input_stream._PushConstantDataMemory[entry._PushConstantDataOffset]
 				);
 
-				command_buffer->BindVertexBuffer(this, 0, entry._VertexBuffer, &OFFSET);
-				command_buffer->BindIndexBuffer(this, entry._IndexBuffer, entry._IndexBufferOffset);
+				if (entry._VertexBuffer != bound_vertex_buffer)
+				{
+					command_buffer->BindVertexBuffer(this, 0, entry._VertexBuffer, &OFFSET);
+					bound_vertex_buffer = entry._VertexBuffer;
+				}
+
+				if (entry._IndexBuffer != bound_index_buffer || entry._IndexBufferOffset != bound_index_buffer_offset)
+				{
+					command_buffer->BindIndexBuffer(this, entry._IndexBuffer, entry._IndexBufferOffset);
+					bound_index_buffer = entry._IndexBuffer;
+					bound_index_buffer_offset = entry._IndexBufferOffset;
+				}
 
 				command_buffer->DrawIndexed(this, entry._IndexCount, 1);
 			}
@@ -129,8 +152,16 @@ void Pipeline::ProcessInputStream(const RenderInputStream &input_stream, Command
 
 		case RenderInputStream::Mode::DRAW_INDEXED_INSTANCED:
 		{
-			for (const RenderInputStreamEntry& entry : input_stream._Entries)
+			//Sorted input streams keep draws of the same mesh together, so only rebind buffers when they change.
+			BufferHandle bound_vertex_buffer{ EMPTY_HANDLE };
+			BufferHandle bound_instance_buffer{ EMPTY_HANDLE };
+			BufferHandle bound_index_buffer{ EMPTY_HANDLE };
+			uint64 bound_index_buffer_offset{ 0 };
+
+			for (uint64 entry_index{ 0 }; entry_index < input_stream._Entries.Size(); ++entry_index)
 			{
+				const RenderInputStreamEntry &entry{ input_stream.GetEntry(entry_index) };
+
 				command_buffer->PushConstants
 				(
 					this,
@@ -140,9 +171,24 @@ void Pipeline::ProcessInputStream(const RenderInputStream &input_stream, Command
 					push_constant_data ? push_constant_data : &input_stream._PushConstantDataMemory[entry._PushConstantDataOffset]
 				);
 
-				command_buffer->BindVertexBuffer(this, 0, entry._VertexBuffer, &OFFSET);
-				command_buffer->BindVertexBuffer(this, 1, entry._InstanceBuffer, &OFFSET);
-				command_buffer->BindIndexBuffer(this, entry._IndexBuffer, entry._IndexBufferOffset);
+				if (entry._VertexBuffer != bound_vertex_buffer)
+				{
+					command_buffer->BindVertexBuffer(this, 0, entry._VertexBuffer, &OFFSET);
+					bound_vertex_buffer = entry._VertexBuffer;
+				}
+
+				if (entry._InstanceBuffer != bound_instance_buffer)
+				{
+					command_buffer->BindVertexBuffer(this, 1, entry._InstanceBuffer, &OFFSET);
+					bound_instance_buffer = entry._InstanceBuffer;
+				}
+
+				if (entry._IndexBuffer != bound_index_buffer || entry._IndexBufferOffset != bound_index_buffer_offset)
+				{
+					command_buffer->BindIndexBuffer(this, entry._IndexBuffer, entry._IndexBufferOffset);
+					bound_index_buffer = entry._IndexBuffer;
+					bound_index_buffer_offset = entry._IndexBufferOffset;
+				}
 
 				command_buffer->DrawIndexed(this, entry._IndexCount, entry._InstanceCount);
 			}
@@ -152,8 +198,10 @@ void Pipeline::ProcessInputStream(const RenderInputStream &input_stream, Command
 
 		case RenderInputStream::Mode::TRACE_RAYS:
 		{
-			for (const RenderInputStreamEntry &entry : input_stream._Entries)
+			for (uint64 entry_index{ 0 }; entry_index < input_stream._Entries.Size(); ++entry_index)
 			{
+				const RenderInputStreamEntry &entry{ input_stream.GetEntry(entry_index) };
+
 				//Push constants.
 				if (input_stream._RequiredPushConstantDataSize != 0)
 				{
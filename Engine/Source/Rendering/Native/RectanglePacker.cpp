@@ -0,0 +1,147 @@
+//Header file.
+#include <Rendering/Native/RectanglePacker.h>
+
+//Math.
+#include <Math/Core/BaseMath.h>
+
+/*
+*	Initializes this rectangle packer.
+*/
+void RectanglePacker::Initialize(const uint32 width, const uint32 height) NOEXCEPT
+{
+	_Width = width;
+	_Height = height;
+	_OccupiedArea = 0;
+
+	//Start out with a single node spanning the bottom.
+	_Skyline.Clear();
+	_Skyline.Emplace();
+
+	_Skyline.Back()._X = 0;
+	_Skyline.Back()._Y = 0;
+	_Skyline.Back()._Width = width;
+}
+
+/*
+*	Packs a rectangle with the given dimensions. Returns if it fit, and if so, writes where it was put.
+*/
+NO_DISCARD bool RectanglePacker::Pack(const uint32 width, const uint32 height, Vector2<uint32> *const RESTRICT position) NOEXCEPT
+{
+	//Find the node where the rectangle ends up lowest, preferring narrower nodes to leave less wasted space.
+	uint64 best_node_index{ UINT64_MAXIMUM };
+	uint32 best_top{ UINT32_MAXIMUM };
+	uint32 best_width{ UINT32_MAXIMUM };
+	uint32 best_Y{ 0 };
+
+	for (uint64 i{ 0 }; i < _Skyline.Size(); ++i)
+	{
+		uint32 Y;
+
+		if (!Fits(i, width, height, &Y))
+		{
+			continue;
+		}
+
+		if (Y + height < best_top || (Y + height == best_top && _Skyline[i]._Width < best_width))
+		{
+			best_node_index = i;
+			best_top = Y + height;
+			best_width = _Skyline[i]._Width;
+			best_Y = Y;
+		}
+	}
+
+	if (best_node_index == UINT64_MAXIMUM)
+	{
+		return false;
+	}
+
+	position->_X = _Skyline[best_node_index]._X;
+	position->_Y = best_Y;
+
+	//Insert the new node for the top of the rectangle.
+	SkylineNode new_node;
+
+	new_node._X = position->_X;
+	new_node._Y = best_top;
+	new_node._Width = width;
+
+	_Skyline.Insert(new_node, best_node_index);
+
+	//Shrink or remove the nodes that are now covered by the new node.
+	const uint32 new_node_right{ new_node._X + new_node._Width };
+
+	for (uint64 i{ best_node_index + 1 }; i < _Skyline.Size();)
+	{
+		SkylineNode &node{ _Skyline[i] };
+
+		if (node._X >= new_node_right)
+		{
+			break;
+		}
+
+		const uint32 node_right{ node._X + node._Width };
+
+		if (node_right <= new_node_right)
+		{
+			_Skyline.EraseAt<true>(i);
+
+			continue;
+		}
+
+		node._Width = node_right - new_node_right;
+		node._X = new_node_right;
+
+		break;
+	}
+
+	//Merge neighbouring nodes at the same height.
+	for (uint64 i{ 0 }; i + 1 < _Skyline.Size();)
+	{
+		if (_Skyline[i]._Y == _Skyline[i + 1]._Y)
+		{
+			_Skyline[i]._Width += _Skyline[i + 1]._Width;
+			_Skyline.EraseAt<true>(i + 1);
+		}
+
+		else
+		{
+			++i;
+		}
+	}
+
+	_OccupiedArea += static_cast<uint64>(width) * height;
+
+	return true;
+}
+
+/*
+*	Returns if a rectangle with the given dimensions fits with it's left edge at the given skyline node, and if so, writes at which Y.
+*/
+NO_DISCARD bool RectanglePacker::Fits(const uint64 node_index, const uint32 width, const uint32 height, uint32 *const RESTRICT Y) const NOEXCEPT
+{
+	if (_Skyline[node_index]._X + width > _Width)
+	{
+		return false;
+	}
+
+	//The rectangle rests on the highest node it spans.
+	uint32 highest_Y{ 0 };
+	uint32 spanned_width{ 0 };
+
+	for (uint64 i{ node_index }; spanned_width < width; ++i)
+	{
+		highest_Y = BaseMath::Maximum<uint32>(highest_Y, _Skyline[i]._Y);
+
+		if (highest_Y + height > _Height)
+		{
+			return false;
+		}
+
+		spanned_width += _Skyline[i]._Width;
+	}
+
+	*Y = highest_Y;
+
+	return true;
+}
\ No newline at end of file
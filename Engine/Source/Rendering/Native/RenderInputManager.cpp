@@ -1,9 +1,6 @@
 //Header file.
 #include <Rendering/Native/RenderInputManager.h>
 
-//Core.
-#include <Core/Algorithms/SortingAlgorithms.h>
-
 //Components.
 #include <Components/Components/GrassComponent.h>
 #include <Components/Components/InstancedImpostorComponent.h>
@@ -20,6 +17,7 @@
 
 //Rendering.
 #include <Rendering/Native/RenderPasses/DebugRenderPass.h>
+#include <Rendering/Native/DrawKey.h>
 #include <Rendering/Native/GrassCore.h>
 
 //Systems.
@@ -790,6 +788,9 @@ void RenderInputManager::RegisterInputStream
 
 		RenderInputStream *const RESTRICT render_input_stream{ static_cast<RenderInputStream *const RESTRICT>(arguments) };
 
+		//Gather functions that want a specific draw order sort their entries themselves.
+		render_input_stream->_DrawOrder.Clear();
+
 		render_input_stream->_GatherFunction(render_input_stream->_UserData, render_input_stream);
 	};
 	new_input_stream._Task._Arguments = nullptr; //Filled in later.
@@ -835,6 +836,9 @@ void RenderInputManager::GatherDepthModelInputStream
 	//Clear the push constant data memory.
 	input_stream->_PushConstantDataMemory.Clear();
 
+	//Cache camera properties.
+	const Vector3<float32> camera_local_position{ RenderingSystem::Instance->GetCameraSystem()->GetCurrentCamera()->GetWorldTransform().GetLocalPosition() };
+
 	//Gather static models.
 	{
 		//Go through all instances.
@@ -881,6 +885,13 @@ void RenderInputManager::GatherDepthModelInputStream
 				new_entry._IndexCount = mesh._MeshLevelOfDetails[static_model_instance_data._LevelOfDetailIndices[i]]._IndexCount;
 				new_entry._InstanceCount = 0;
 
+				//Calculate the draw key. Group by material and mesh, then front to back.
+				{
+					const float32 distance_squared{ Vector3<float32>::LengthSquared(world_transform_instance_data._CurrentWorldTransform.GetRelativePosition(WorldSystem::Instance->GetCurrentWorldGridCell()) - camera_local_position) };
+
+					new_entry._DrawKey = DrawKey::Opaque(0, static_model_instance_data._Materials[i]->_Index, DrawKey::MeshIdentifier(new_entry._VertexBuffer), distance_squared);
+				}
+
 				//Set up the push constant data.
 				ModelDepthPushConstantData push_constant_data;
 
@@ -894,6 +905,9 @@ void RenderInputManager::GatherDepthModelInputStream
 			}
 		}
 	}
+
+	//Sort the entries.
+	input_stream->SortEntries();
 }
 
 /*
@@ -912,6 +926,9 @@ void RenderInputManager::GatherFullModelInputStream
 	//Clear the push constant data memory.
 	input_stream->_PushConstantDataMemory.Clear();
 
+	//Cache camera properties.
+	const Vector3<float32> camera_local_position{ RenderingSystem::Instance->GetCameraSystem()->GetCurrentCamera()->GetWorldTransform().GetLocalPosition() };
+
 	//Gather static models.
 	{
 		//Go through all instances.
@@ -958,6 +975,13 @@ void RenderInputManager::GatherFullModelInputStream
 				new_entry._IndexCount = mesh._MeshLevelOfDetails[static_model_instance_data._LevelOfDetailIndices[i]]._IndexCount;
 				new_entry._InstanceCount = 0;
 
+				//Calculate the draw key. Group by material and mesh, then front to back.
+				{
+					const float32 distance_squared{ Vector3<float32>::LengthSquared(world_transform_instance_data._CurrentWorldTransform.GetRelativePosition(WorldSystem::Instance->GetCurrentWorldGridCell()) - camera_local_position) };
+
+					new_entry._DrawKey = DrawKey::Opaque(0, static_model_instance_data._Materials[i]->_Index, DrawKey::MeshIdentifier(new_entry._VertexBuffer), distance_squared);
+				}
+
 				//Set up the push constant data.
 				ModelFullPushConstantData push_constant_data;
 
@@ -972,6 +996,9 @@ void RenderInputManager::GatherFullModelInputStream
 			}
 		}
 	}
+
+	//Sort the entries.
+	input_stream->SortEntries();
 }
 
 /*
@@ -1023,6 +1050,7 @@ void RenderInputManager::GatherInstancedModelInputStream
 				new_entry._VertexCount = 0;
 				new_entry._IndexCount = mesh._MeshLevelOfDetails[0]._IndexCount;
 				new_entry._InstanceCount = instance_data._NumberOfTransformations;
+				new_entry._DrawKey = DrawKey::Opaque(0, instance_data._Materials[i]->_Index, DrawKey::MeshIdentifier(new_entry._VertexBuffer), 0.0f);
 
 				//Set up the push constant data.
 				InstancedModelPushConstantData push_constant_data;
@@ -1056,6 +1084,9 @@ void RenderInputManager::GatherInstancedModelInputStream
 			}
 		}
 	}
+
+	//Sort the entries.
+	input_stream->SortEntries();
 }
 
 /*
@@ -1132,56 +1163,45 @@ FORCE_INLINE void GatherTerrainQuadTreeNode
 	RenderInputStream *const RESTRICT input_stream
 ) NOEXCEPT
 {
-	if (node.IsSubdivided())
+	//Ignore this node if it not visible.
+	if (!node._Visible)
 	{
-		for (const TerrainQuadTreeNode &child_node : node._ChildNodes)
-		{
-			GatherTerrainQuadTreeNode(instance_data, child_node, input_stream);
-		}
+		return;
 	}
 
-	else
+	//Add a new entry.
+	input_stream->_Entries.Emplace();
+	RenderInputStreamEntry &new_entry{ input_stream->_Entries.Back() };
+
+	new_entry._PushConstantDataOffset = input_stream->_PushConstantDataMemory.Size();
+	new_entry._VertexBuffer = instance_data._Buffer;
+	new_entry._IndexBuffer = instance_data._Buffer;
+	new_entry._IndexBufferOffset = instance_data._IndexOffset;
+	new_entry._InstanceBuffer = EMPTY_HANDLE;
+	new_entry._VertexCount = 0;
+	new_entry._IndexCount = instance_data._IndexCount;
+	new_entry._InstanceCount = 0;
+
+	//Set up the push constant data.
+	TerrainPushConstantData push_constant_data;
+
+	const Vector3<float32> component_world_position{ instance_data._WorldPosition.GetRelativePosition(WorldSystem::Instance->GetCurrentWorldGridCell()) };
+	push_constant_data._WorldPosition = component_world_position + Vector3<float32>(node._Position._X, 0.0f, node._Position._Y);
+	push_constant_data._MinimumHeightMapCoordinate = node._MinimumHeightMapCoordinate;
+	push_constant_data._MaximumHeightMapCoordinate = node._MaximumHeightMapCoordinate;
+	push_constant_data._Borders = node._Borders;
+	push_constant_data._PatchResolutionReciprocal = 1.0f / static_cast<float32>(instance_data._BaseResolution);
+	push_constant_data._PatchSize = node._PatchSize;
+	push_constant_data._HeightMapTextureIndex = instance_data._HeightMapTextureIndex;
+	push_constant_data._NormalMapTextureIndex = instance_data._NormalMapTextureIndex;
+	push_constant_data._IndexMapTextureIndex = instance_data._IndexMapTextureIndex;
+	push_constant_data._BlendMapTextureIndex = instance_data._BlendMapTextureIndex;
+	push_constant_data._MapResolution = static_cast<float32>(instance_data._HeightMap.GetResolution());
+	push_constant_data._MapResolutionReciprocal = 1.0f / push_constant_data._MapResolution;
+
+	for (uint64 i{ 0 }; i < sizeof(TerrainPushConstantData); ++i)
 	{
-		//Ignore this node if it not visible.
-		if (!node._Visible)
-		{
-			return;
-		}
-
-		//Add a new entry.
-		input_stream->_Entries.Emplace();
-		RenderInputStreamEntry &new_entry{ input_stream->_Entries.Back() };
-
-		new_entry._PushConstantDataOffset = input_stream->_PushConstantDataMemory.Size();
-		new_entry._VertexBuffer = instance_data._Buffer;
-		new_entry._IndexBuffer = instance_data._Buffer;
-		new_entry._IndexBufferOffset = instance_data._IndexOffset;
-		new_entry._InstanceBuffer = EMPTY_HANDLE;
-		new_entry._VertexCount = 0;
-		new_entry._IndexCount = instance_data._IndexCount;
-		new_entry._InstanceCount = 0;
-
-		//Set up the push constant data.
-		TerrainPushConstantData push_constant_data;
-
-		const Vector3<float32> component_world_position{ instance_data._WorldPosition.GetRelativePosition(WorldSystem::Instance->GetCurrentWorldGridCell()) };
-		push_constant_data._WorldPosition = component_world_position + Vector3<float32>(node._Position._X, 0.0f, node._Position._Y);
-		push_constant_data._MinimumHeightMapCoordinate = node._MinimumHeightMapCoordinate;
-		push_constant_data._MaximumHeightMapCoordinate = node._MaximumHeightMapCoordinate;
-		push_constant_data._Borders = node._Borders;
-		push_constant_data._PatchResolutionReciprocal = 1.0f / static_cast<float32>(instance_data._BaseResolution);
-		push_constant_data._PatchSize = node._PatchSize;
-		push_constant_data._HeightMapTextureIndex = instance_data._HeightMapTextureIndex;
-		push_constant_data._NormalMapTextureIndex = instance_data._NormalMapTextureIndex;
-		push_constant_data._IndexMapTextureIndex = instance_data._IndexMapTextureIndex;
-		push_constant_data._BlendMapTextureIndex = instance_data._BlendMapTextureIndex;
-		push_constant_data._MapResolution = static_cast<float32>(instance_data._HeightMap.GetResolution());
-		push_constant_data._MapResolutionReciprocal = 1.0f / push_constant_data._MapResolution;
-
-		for (uint64 i{ 0 }; i < sizeof(TerrainPushConstantData); ++i)
-		{
-			input_stream->_PushConstantDataMemory.Emplace(((const byte* const RESTRICT) & push_constant_data)[i]);
-		}
+		input_stream->_PushConstantDataMemory.Emplace(((const byte* const RESTRICT) & push_constant_data)[i]);
 	}
 }
 
@@ -1209,8 +1229,11 @@ void RenderInputManager::GatherTerrainInputStream
 				continue;
 			}
 
-			//Walk the quad tree.
-			GatherTerrainQuadTreeNode(instance_data, instance_data._QuadTree._RootNode, input_stream);
+			//Walk the leaf nodes of the quad tree.
+			for (const uint32 node_index : instance_data._QuadTree._LeafNodes)
+			{
+				GatherTerrainQuadTreeNode(instance_data, instance_data._QuadTree._Nodes[node_index], input_stream);
+			}
 		}
 	}
 }
@@ -1225,49 +1248,38 @@ FORCE_INLINE void GatherWaterQuadTreeNode
 	RenderInputStream *const RESTRICT input_stream
 ) NOEXCEPT
 {
-	if (node.IsSubdivided())
+	//Ignore this node if it not visible.
+	if (!node._Visible)
 	{
-		for (const TerrainQuadTreeNode &child_node : node._ChildNodes)
-		{
-			GatherWaterQuadTreeNode(instance_data, child_node, input_stream);
-		}
+		return;
 	}
 
-	else
+	//Add a new entry.
+	input_stream->_Entries.Emplace();
+	RenderInputStreamEntry &new_entry{ input_stream->_Entries.Back() };
+
+	new_entry._PushConstantDataOffset = input_stream->_PushConstantDataMemory.Size();
+	new_entry._VertexBuffer = instance_data._Buffer;
+	new_entry._IndexBuffer = instance_data._Buffer;
+	new_entry._IndexBufferOffset = instance_data._IndexOffset;
+	new_entry._InstanceBuffer = EMPTY_HANDLE;
+	new_entry._VertexCount = 0;
+	new_entry._IndexCount = instance_data._IndexCount;
+	new_entry._InstanceCount = 0;
+
+	//Set up the push constant data.
+	WaterPushConstantData push_constant_data;
+
+	const Vector3<float32> component_world_position{ instance_data._WorldPosition.GetRelativePosition(WorldSystem::Instance->GetCurrentWorldGridCell()) };
+	push_constant_data._WorldPosition = component_world_position + Vector3<float32>(node._Position._X, 0.0f, node._Position._Y);
+	push_constant_data._Borders = node._Borders;
+	push_constant_data._PatchResolutionReciprocal = 1.0f / static_cast<float32>(instance_data._BaseResolution);
+	push_constant_data._PatchSize = node._PatchSize;
+	push_constant_data._TextureIndex = instance_data._Texture->_Index;
+
+	for (uint64 i{ 0 }; i < sizeof(WaterPushConstantData); ++i)
 	{
-		//Ignore this node if it not visible.
-		if (!node._Visible)
-		{
-			return;
-		}
-
-		//Add a new entry.
-		input_stream->_Entries.Emplace();
-		RenderInputStreamEntry &new_entry{ input_stream->_Entries.Back() };
-
-		new_entry._PushConstantDataOffset = input_stream->_PushConstantDataMemory.Size();
-		new_entry._VertexBuffer = instance_data._Buffer;
-		new_entry._IndexBuffer = instance_data._Buffer;
-		new_entry._IndexBufferOffset = instance_data._IndexOffset;
-		new_entry._InstanceBuffer = EMPTY_HANDLE;
-		new_entry._VertexCount = 0;
-		new_entry._IndexCount = instance_data._IndexCount;
-		new_entry._InstanceCount = 0;
-
-		//Set up the push constant data.
-		WaterPushConstantData push_constant_data;
-
-		const Vector3<float32> component_world_position{ instance_data._WorldPosition.GetRelativePosition(WorldSystem::Instance->GetCurrentWorldGridCell()) };
-		push_constant_data._WorldPosition = component_world_position + Vector3<float32>(node._Position._X, 0.0f, node._Position._Y);
-		push_constant_data._Borders = node._Borders;
-		push_constant_data._PatchResolutionReciprocal = 1.0f / static_cast<float32>(instance_data._BaseResolution);
-		push_constant_data._PatchSize = node._PatchSize;
-		push_constant_data._TextureIndex = instance_data._Texture->_Index;
-
-		for (uint64 i{ 0 }; i < sizeof(WaterPushConstantData); ++i)
-		{
-			input_stream->_PushConstantDataMemory.Emplace(((const byte *const RESTRICT)&push_constant_data)[i]);
-		}
+		input_stream->_PushConstantDataMemory.Emplace(((const byte *const RESTRICT)&push_constant_data)[i]);
 	}
 }
 
@@ -1295,8 +1307,11 @@ void RenderInputManager::GatherWaterInputStream
 				continue;
 			}
 
-			//Walk the quad tree.
-			GatherWaterQuadTreeNode(instance_data, instance_data._QuadTree._RootNode, input_stream);
+			//Walk the leaf nodes of the quad tree.
+			for (const uint32 node_index : instance_data._QuadTree._LeafNodes)
+			{
+				GatherWaterQuadTreeNode(instance_data, instance_data._QuadTree._Nodes[node_index], input_stream);
+			}
 		}
 	}
 }
@@ -1340,12 +1355,12 @@ void RenderInputManager::GatherGrassInputStream
 		new_entry._IndexCount = 0;
 		new_entry._InstanceCount = instance_data._NumberOfInstances;
 
-		//Calculate the sort value.
+		//Calculate the draw key.
 		{
 			const AxisAlignedBoundingBox3D camera_relative_axis_aligned_bounding_box{ instance_data._WorldSpaceAxisAlignedBoundingBox.GetRelativeAxisAlignedBoundingBox(WorldSystem::Instance->GetCurrentWorldGridCell()) };
 			const Vector3<float32> closest_point{ AxisAlignedBoundingBox3D::GetClosestPointInside(camera_relative_axis_aligned_bounding_box, camera_local_position) };
 
-			new_entry._SortValue = Vector3<float32>::LengthSquared(closest_point - camera_local_position);
+			new_entry._DrawKey = DrawKey::Depth(Vector3<float32>::LengthSquared(closest_point - camera_local_position));
 		}
 
 		//Set up the push constant data.
@@ -1374,20 +1389,8 @@ void RenderInputManager::GatherGrassInputStream
 		}
 	}
 
-	//Sort.
-	if (!input_stream->_Entries.Empty())
-	{
-		SortingAlgorithms::StandardSort<RenderInputStreamEntry>
-		(
-			input_stream->_Entries.Begin(),
-			input_stream->_Entries.End(),
-			nullptr,
-			[](const void *const RESTRICT user_data, const RenderInputStreamEntry *const RESTRICT first, const RenderInputStreamEntry *const RESTRICT second)
-			{
-				return first->_SortValue < second->_SortValue;
-			}
-		);
-	}
+	//Sort the entries.
+	input_stream->SortEntries();
 }
 
 #if defined(CATALYST_EDITOR)
@@ -11,6 +11,28 @@
 //Systems.
 #include <Systems/RenderingSystem.h>
 
+//Shader light component constants.
+namespace ShaderLightComponentConstants
+{
+	//The radiance below which a point light no longer contributes visibly, which it's range of influence is derived from.
+	constexpr float32 MINIMUM_POINT_LIGHT_RADIANCE{ 0.05f };
+}
+
+/*
+*	Returns the range of influence of the given point light.
+*	Point lights fall off with the inverse square of the distance, so they reach as far as their radiance stays above the minimum, or as far as their radius if that's further.
+*	The shaders window the light against this range, so clustering and shading agree on where it ends.
+*/
+FORCE_INLINE NO_DISCARD static float32 PointLightRange(const LightInstanceData &light_instance_data) NOEXCEPT
+{
+	const float32 maximum_color_component{ BaseMath::Maximum<float32>(light_instance_data._Color._X, BaseMath::Maximum<float32>(light_instance_data._Color._Y, light_instance_data._Color._Z)) };
+	const float32 maximum_radiance{ light_instance_data._Intensity * maximum_color_component };
+
+	const float32 range{ BaseMath::SquareRoot(BaseMath::Maximum<float32>(maximum_radiance / ShaderLightComponentConstants::MINIMUM_POINT_LIGHT_RADIANCE - 1.0f, 0.0f)) };
+
+	return BaseMath::Maximum<float32>(light_instance_data._PointLightData._Radius, range);
+}
+
 /*
 *	Copy by LightComponent constructor.
 */
@@ -50,6 +72,6 @@ ShaderLightComponent::ShaderLightComponent(Entity *const RESTRICT entity) NOEXCE
 	_LightType = static_cast<uint32>(light_instance_data._LightType);
 	_LightProperties = light_instance_data._LightProperties;
 	_Intensity = light_instance_data._Intensity;
-	_Radius = light_instance_data._PointLightData._Radius;
+	_Radius = light_instance_data._LightType == LightType::POINT ? PointLightRange(light_instance_data) : light_instance_data._PointLightData._Radius;
 	_Size = light_instance_data._PointLightData._Size;
 }
\ No newline at end of file
@@ -1,18 +1,20 @@
 //Header file.
 #include <Rendering/Native/ShadowsSystem.h>
 
-//Core.
-#include <Core/Algorithms/SortingAlgorithms.h>
-
 //Components.
 #include <Components/Components/LightComponent.h>
 #include <Components/Components/StaticModelComponent.h>
 #include <Components/Components/WorldTransformComponent.h>
 
+//Concurrency.
+#include <Concurrency/ScopedLock.h>
+
 //Math.
 #include <Math/Core/CatalystGeometryMath.h>
 
 //Rendering.
+#include <Rendering/Native/Culling.h>
+#include <Rendering/Native/DrawKey.h>
 #include <Rendering/Native/RenderingUtilities.h>
 
 //Systems.
@@ -32,6 +34,15 @@ namespace ShadowsSystemConstants
 		1.0f * DIRECTIONAL_LIGHT_SHADOW_MAP_CASCADE_DISTANCE_FACTOR,
 		1.0f
 	};
+
+	/*
+	*	How much larger than the shadow map the region the static shadow casters are cached for is, relative to the size of the shadow map.
+	*	A larger margin means the caches survive more camera movement, at the cost of drawing casters that fall outside the shadow map.
+	*/
+	constexpr float32 SHADOW_CASTER_CACHE_MARGIN{ 0.25f };
+
+	//The number of frames a moved static model needs to stay still before it's considered static again.
+	constexpr uint32 DYNAMIC_SHADOW_CASTER_SETTLE_FRAMES{ 60 };
 }
 
 /*
@@ -65,6 +76,10 @@ struct CascadeInformation final
 {
 	Matrix4x4 _WorldToLightMatrix;
 	float32 _DepthRange;
+	Matrix4x4 _LightMatrix;
+	Vector3<float32> _Minimum;
+	Vector3<float32> _Maximum;
+	StaticArray<Vector4<float32>, 8> _FrustumCorners;
 };
 
 /*
@@ -130,10 +145,122 @@ FORCE_INLINE NO_DISCARD CascadeInformation CalculateCascadeInformation(const Vec
 
 	information._WorldToLightMatrix = projection_matrix * light_matrix;
 	information._DepthRange = maxZ - minZ;
+	information._LightMatrix = light_matrix;
+	information._Minimum = Vector3<float32>(minX, minY, minZ);
+	information._Maximum = Vector3<float32>(maxX, maxY, maxZ);
+	information._FrustumCorners = frustum_corners;
 
 	return information;
 }
 
+/*
+*	Calculates the frustum of the given world to light matrix.
+*/
+FORCE_INLINE static void CalculateFrustum(const Matrix4x4 &world_to_light_matrix, const float32 view_distance, Frustum *const RESTRICT frustum) NOEXCEPT
+{
+	//Construct the frustum planes.
+	for (uint8 j{ 4 }; j--;) frustum->_Planes[0][j] = world_to_light_matrix._Matrix[j][3] + world_to_light_matrix._Matrix[j][0]; //Left.
+	for (uint8 j{ 4 }; j--;) frustum->_Planes[1][j] = world_to_light_matrix._Matrix[j][3] - world_to_light_matrix._Matrix[j][0]; //Right.
+	for (uint8 j{ 4 }; j--;) frustum->_Planes[2][j] = world_to_light_matrix._Matrix[j][3] + world_to_light_matrix._Matrix[j][1]; //Bottom.
+	for (uint8 j{ 4 }; j--;) frustum->_Planes[3][j] = world_to_light_matrix._Matrix[j][3] - world_to_light_matrix._Matrix[j][1]; //Top.
+	for (uint8 j{ 4 }; j--;) frustum->_Planes[4][j] = world_to_light_matrix._Matrix[j][3] + world_to_light_matrix._Matrix[j][2]; //Near.
+	for (uint8 j{ 4 }; j--;) frustum->_Planes[5][j] = world_to_light_matrix._Matrix[j][3] - world_to_light_matrix._Matrix[j][2]; //Far.
+
+	//Normalize the frustum planes.
+	for (uint8 j{ 0 }; j < 6; ++j)
+	{
+		const float32 length_reciprocal{ BaseMath::InverseSquareRoot(frustum->_Planes[j]._X * frustum->_Planes[j]._X + frustum->_Planes[j]._Y * frustum->_Planes[j]._Y + frustum->_Planes[j]._Z * frustum->_Planes[j]._Z) };
+
+		frustum->_Planes[j]._X *= length_reciprocal;
+		frustum->_Planes[j]._Y *= length_reciprocal;
+		frustum->_Planes[j]._Z *= length_reciprocal;
+		frustum->_Planes[j]._W *= length_reciprocal;
+	}
+
+	//Pull the near frustum plane back so that it includes everything that could potentially cast a shadow.
+	frustum->_Planes[4]._W = view_distance;
+}
+
+/*
+*	Adds the shadow caster entries for the meshes of the given static model with the given material type.
+*/
+static void AddStaticModelShadowCasters
+(
+	const uint8 shadow_map_index,
+	const Matrix4x4 &world_to_light_matrix,
+	const MaterialAsset::Type material_type,
+	const StaticModelInstanceData &static_model_instance_data,
+	const WorldTransformInstanceData &world_transform_instance_data,
+	DynamicArray<RenderInputStreamEntry> *const RESTRICT entries,
+	DynamicArray<byte> *const RESTRICT push_constant_data_memory
+) NOEXCEPT
+{
+	//Go through all meshes.
+	for (uint64 i{ 0 }, size{ static_model_instance_data._Model->_Meshes.Size() }; i < size; ++i)
+	{
+		//Skip this mesh depending on the material type.
+		if (static_model_instance_data._Materials[i]->_Type != material_type)
+		{
+			continue;
+		}
+
+		//Cache the mesh.
+		const Mesh &mesh{ static_model_instance_data._Model->_Meshes[i] };
+
+		//Add a new entry.
+		entries->Emplace();
+		RenderInputStreamEntry &new_entry{ entries->Back() };
+
+		new_entry._PushConstantDataOffset = push_constant_data_memory->Size();
+		new_entry._VertexBuffer = mesh._MeshLevelOfDetails[static_model_instance_data._LevelOfDetailIndices[i]]._VertexBuffer;
+		new_entry._IndexBuffer = mesh._MeshLevelOfDetails[static_model_instance_data._LevelOfDetailIndices[i]]._IndexBuffer;
+		new_entry._IndexBufferOffset = 0;
+		new_entry._InstanceBuffer = EMPTY_HANDLE;
+		new_entry._VertexCount = 0;
+		new_entry._IndexCount = mesh._MeshLevelOfDetails[static_model_instance_data._LevelOfDetailIndices[i]]._IndexCount;
+		new_entry._InstanceCount = 0;
+
+		const Matrix4x4 model_matrix{ world_transform_instance_data._CurrentWorldTransform.ToRelativeMatrix4x4(WorldSystem::Instance->GetCurrentWorldGridCell()) };
+
+		if (material_type == MaterialAsset::Type::OPAQUE)
+		{
+			//Set up the push constant data.
+			OpaqueModelPushConstantData push_constant_data;
+
+			push_constant_data._ModelMatrix = model_matrix;
+			push_constant_data._LightMatrixIndex = shadow_map_index;
+
+			for (uint64 i{ 0 }; i < sizeof(OpaqueModelPushConstantData); ++i)
+			{
+				push_constant_data_memory->Emplace(((const byte *const RESTRICT)&push_constant_data)[i]);
+			}
+
+			//Opaque shadow casters don't need any material, so just group them by mesh.
+			new_entry._DrawKey = DrawKey::Opaque(0, 0, DrawKey::MeshIdentifier(new_entry._VertexBuffer), 0.0f);
+		}
+
+		else
+		{
+			//Set up the push constant data.
+			MaskedModelPushConstantData push_constant_data;
+
+			push_constant_data._ModelMatrix = model_matrix;
+			push_constant_data._LightMatrixIndex = shadow_map_index;
+			push_constant_data._MaterialIndex = static_model_instance_data._Materials[i]->_Index;
+
+			for (uint64 i{ 0 }; i < sizeof(MaskedModelPushConstantData); ++i)
+			{
+				push_constant_data_memory->Emplace(((const byte *const RESTRICT)&push_constant_data)[i]);
+			}
+
+			//Calculate the draw key. Group by material and mesh, then front to back.
+			const Vector4<float32> clip_position{ world_to_light_matrix * push_constant_data._ModelMatrix * Vector4<float32>(0.0f, 0.0f, 0.0f, 1.0f) };
+
+			new_entry._DrawKey = DrawKey::Opaque(0, push_constant_data._MaterialIndex, DrawKey::MeshIdentifier(new_entry._VertexBuffer), clip_position._Z);
+		}
+	}
+}
+
 /*
 *	Post-initializes the shadows system.
 */
@@ -144,37 +271,34 @@ void ShadowsSystem::PostInitialize() NOEXCEPT
 	(
 		HashString("ShadowMapping"),
 		sizeof(ShadowMappingHeaderData) + sizeof(ShadowMapData) * MAXIMUM_NUMBER_OF_SHADOW_MAP_DATA,
-		[](DynamicArray<byte> *const RESTRICT data, void *const RESTRICT arguments)
+		[](StorageBufferWriter *const RESTRICT writer, void *const RESTRICT arguments)
 		{
-			data->Clear();
 			ShadowsSystem *const RESTRICT shadows_system{ static_cast<ShadowsSystem *const RESTRICT>(arguments) };
 
+			//Each shadow map data entry is the world to light matrix, the direction, the render target index, the maximum depth bias and 12 bytes of padding.
+			constexpr uint64 SHADER_SHADOW_MAP_DATA_SIZE{ sizeof(Matrix4x4) + sizeof(Vector3<float32>) + sizeof(uint32) + sizeof(float32) + 12 };
+
+			const UploadSpan span{ writer->Reserve(sizeof(ShadowMappingHeaderData) + SHADER_SHADOW_MAP_DATA_SIZE * shadows_system->_ShadowMapData.Size()) };
+			byte *RESTRICT cursor{ span._Data };
+
 			ShadowMappingHeaderData header_data;
 
 			header_data._NumberOfShadowMapData = shadows_system->GetNumberOfShadowMapData();
 
-			for (uint64 i{ 0 }; i < sizeof(ShadowMappingHeaderData); ++i)
-			{
-				data->Emplace(((const byte *const RESTRICT)&header_data)[i]);
-			}
+			Memory::Copy(cursor, &header_data, sizeof(ShadowMappingHeaderData));
+			cursor += sizeof(ShadowMappingHeaderData);
 
 			for (const ShadowMapData &shadow_map_data : shadows_system->_ShadowMapData)
 			{
 				//Copy the world to light matrix.
-				for (uint64 i{ 0 }; i < sizeof(Matrix4x4); ++i)
-				{
-					data->Emplace(((const byte *const RESTRICT)&shadow_map_data._WorldToLightMatrix)[i]);
-				}
+				Memory::Copy(cursor, &shadow_map_data._WorldToLightMatrix, sizeof(Matrix4x4));
+				cursor += sizeof(Matrix4x4);
 
-				for (uint64 i{ 0 }; i < sizeof(Vector3<float32>); ++i)
-				{
-					data->Emplace(((const byte *const RESTRICT)&shadow_map_data._Direction)[i]);
-				}
+				Memory::Copy(cursor, &shadow_map_data._Direction, sizeof(Vector3<float32>));
+				cursor += sizeof(Vector3<float32>);
 
-				for (uint64 i{ 0 }; i < sizeof(uint32); ++i)
-				{
-					data->Emplace(((const byte *const RESTRICT)&shadow_map_data._RenderTargetIndex)[i]);
-				}
+				Memory::Copy(cursor, &shadow_map_data._RenderTargetIndex, sizeof(uint32));
+				cursor += sizeof(uint32);
 
 				{
 					/*
@@ -183,16 +307,12 @@ void ShadowsSystem::PostInitialize() NOEXCEPT
 					*/
 					const float32 maximum_depth_bias{ shadow_map_data._DepthRange / static_cast<float32>(UINT16_MAXIMUM) * 4.0f };
 
-					for (uint64 i{ 0 }; i < sizeof(float32); ++i)
-					{
-						data->Emplace(((const byte *const RESTRICT)&maximum_depth_bias)[i]);
-					}
+					Memory::Copy(cursor, &maximum_depth_bias, sizeof(float32));
+					cursor += sizeof(float32);
 				}
 
-				for (uint64 i{ 0 }; i < 12; ++i)
-				{
-					data->Emplace(0);
-				}
+				Memory::Set(cursor, 0, 12);
+				cursor += 12;
 			}
 		},
 		this
@@ -217,7 +337,7 @@ void ShadowsSystem::PostInitialize() NOEXCEPT
 			sizeof(OpaqueModelPushConstantData),																			\
 			[](void *const RESTRICT user_data, RenderInputStream *const RESTRICT input_stream)								\
 			{																												\
-				static_cast<ShadowsSystem *const RESTRICT>(user_data)->GatherOpaqueModelInputStream(INDEX, input_stream);	\
+				static_cast<ShadowsSystem *const RESTRICT>(user_data)->GatherModelInputStream(INDEX, MaterialAsset::Type::OPAQUE, input_stream);	\
 			},																												\
 			RenderInputStream::Mode::DRAW_INDEXED,																			\
 			this																											\
@@ -268,7 +388,7 @@ void ShadowsSystem::PostInitialize() NOEXCEPT
 			sizeof(MaskedModelPushConstantData),																			\
 			[](void *const RESTRICT user_data, RenderInputStream *const RESTRICT input_stream)								\
 			{																												\
-				static_cast<ShadowsSystem *const RESTRICT>(user_data)->GatherMaskedModelInputStream(INDEX, input_stream);	\
+				static_cast<ShadowsSystem *const RESTRICT>(user_data)->GatherModelInputStream(INDEX, MaterialAsset::Type::MASKED, input_stream);	\
 			},																												\
 			RenderInputStream::Mode::DRAW_INDEXED,																			\
 			this																											\
@@ -309,6 +429,10 @@ void ShadowsSystem::PreRenderUpdate() NOEXCEPT
 	//Cache the view distance.
 	const float32 view_distance{ CatalystEngineSystem::Instance->GetProjectConfiguration()->_RenderingConfiguration._ViewDistance };
 
+	//Cache the cells.
+	const Vector3<int32> camera_cell{ RenderingSystem::Instance->GetCameraSystem()->GetCurrentCamera()->GetWorldTransform().GetCell() };
+	const Vector3<int32> world_grid_cell{ WorldSystem::Instance->GetCurrentWorldGridCell() };
+
 	//Update the shadow map data.
 	uint32 current_shadow_map_data_index{ 0 };
 
@@ -348,33 +472,64 @@ void ShadowsSystem::PreRenderUpdate() NOEXCEPT
 				shadow_map_data->_WorldToLightMatrix = cascade_information._WorldToLightMatrix;
 				shadow_map_data->_DepthRange = cascade_information._DepthRange;
 
-				{
-					//Construct the frustum planes.
-					for (uint8 j{ 4 }; j--;) shadow_map_data->_Frustum._Planes[0][j] = shadow_map_data->_WorldToLightMatrix._Matrix[j][3] + shadow_map_data->_WorldToLightMatrix._Matrix[j][0]; //Left.
-					for (uint8 j{ 4 }; j--;) shadow_map_data->_Frustum._Planes[1][j] = shadow_map_data->_WorldToLightMatrix._Matrix[j][3] - shadow_map_data->_WorldToLightMatrix._Matrix[j][0]; //Right.
-					for (uint8 j{ 4 }; j--;) shadow_map_data->_Frustum._Planes[2][j] = shadow_map_data->_WorldToLightMatrix._Matrix[j][3] + shadow_map_data->_WorldToLightMatrix._Matrix[j][1]; //Bottom.
-					for (uint8 j{ 4 }; j--;) shadow_map_data->_Frustum._Planes[3][j] = shadow_map_data->_WorldToLightMatrix._Matrix[j][3] - shadow_map_data->_WorldToLightMatrix._Matrix[j][1]; //Top.
-					for (uint8 j{ 4 }; j--;) shadow_map_data->_Frustum._Planes[4][j] = shadow_map_data->_WorldToLightMatrix._Matrix[j][3] + shadow_map_data->_WorldToLightMatrix._Matrix[j][2]; //Near.
-					for (uint8 j{ 4 }; j--;) shadow_map_data->_Frustum._Planes[5][j] = shadow_map_data->_WorldToLightMatrix._Matrix[j][3] - shadow_map_data->_WorldToLightMatrix._Matrix[j][2]; //Far.
-
-					//Normalize the frustum planes.
-					for (uint8 j{ 0 }; j < 6; ++j)
-					{
-						const float32 length_reciprocal{ BaseMath::InverseSquareRoot(shadow_map_data->_Frustum._Planes[j]._X * shadow_map_data->_Frustum._Planes[j]._X + shadow_map_data->_Frustum._Planes[j]._Y * shadow_map_data->_Frustum._Planes[j]._Y + shadow_map_data->_Frustum._Planes[j]._Z * shadow_map_data->_Frustum._Planes[j]._Z) };
-
-						shadow_map_data->_Frustum._Planes[j]._X *= length_reciprocal;
-						shadow_map_data->_Frustum._Planes[j]._Y *= length_reciprocal;
-						shadow_map_data->_Frustum._Planes[j]._Z *= length_reciprocal;
-						shadow_map_data->_Frustum._Planes[j]._W *= length_reciprocal;
-					}
-
-					//Pull the near frustum plane back so that it includes everything that could potentially cast a shadow.
-					shadow_map_data->_Frustum._Planes[4]._W = view_distance;
-				}
+				CalculateFrustum(shadow_map_data->_WorldToLightMatrix, view_distance, &shadow_map_data->_Frustum);
 
 				shadow_map_data->_Distance = cascade_distances[i];
 				shadow_map_data->_Direction = CatalystCoordinateSpacesUtilities::RotatedWorldDownVector(instance_data._DirectionalLightData._Rotation);
 
+				//Check if the shadow caster cache still covers this shadow map.
+				if (current_shadow_map_data_index >= _ShadowCasterCaches.Size())
+				{
+					_ShadowCasterCaches.Emplace();
+				}
+
+				ShadowCasterCache &shadow_caster_cache{ _ShadowCasterCaches[current_shadow_map_data_index] };
+
+				bool region_valid
+				{
+					shadow_caster_cache._RegionValid
+					&& shadow_caster_cache._Direction == shadow_map_data->_Direction
+					&& shadow_caster_cache._CameraCell == camera_cell
+					&& shadow_caster_cache._WorldGridCell == world_grid_cell
+				};
+
+				for (uint8 j{ 0 }; j < 8 && region_valid; ++j)
+				{
+					const Vector4<float32> light_space_corner{ shadow_caster_cache._LightMatrix * cascade_information._FrustumCorners[j] };
+
+					region_valid =	light_space_corner._X >= shadow_caster_cache._Minimum._X && light_space_corner._X <= shadow_caster_cache._Maximum._X
+									&& light_space_corner._Y >= shadow_caster_cache._Minimum._Y && light_space_corner._Y <= shadow_caster_cache._Maximum._Y
+									&& light_space_corner._Z >= shadow_caster_cache._Minimum._Z && light_space_corner._Z <= shadow_caster_cache._Maximum._Z;
+				}
+
+				//Otherwise, set up a new region around the shadow map, and invalidate the cache.
+				if (!region_valid)
+				{
+					const Vector3<float32> margin{ (cascade_information._Maximum - cascade_information._Minimum) * ShadowsSystemConstants::SHADOW_CASTER_CACHE_MARGIN };
+
+					shadow_caster_cache._LightMatrix = cascade_information._LightMatrix;
+					shadow_caster_cache._Minimum = cascade_information._Minimum - margin;
+					shadow_caster_cache._Maximum = cascade_information._Maximum + margin;
+					shadow_caster_cache._WorldToLightMatrix = Matrix4x4::Orthographic
+					(
+						shadow_caster_cache._Minimum._X,
+						shadow_caster_cache._Maximum._X,
+						shadow_caster_cache._Minimum._Y,
+						shadow_caster_cache._Maximum._Y,
+						shadow_caster_cache._Minimum._Z,
+						shadow_caster_cache._Maximum._Z
+					) * shadow_caster_cache._LightMatrix;
+
+					CalculateFrustum(shadow_caster_cache._WorldToLightMatrix, view_distance, &shadow_caster_cache._Frustum);
+
+					shadow_caster_cache._Direction = shadow_map_data->_Direction;
+					shadow_caster_cache._CameraCell = camera_cell;
+					shadow_caster_cache._WorldGridCell = world_grid_cell;
+					shadow_caster_cache._RegionValid = true;
+
+					++shadow_caster_cache._Generation;
+				}
+
 				++current_shadow_map_data_index;
 			}
 		}
@@ -388,200 +543,284 @@ void ShadowsSystem::PreRenderUpdate() NOEXCEPT
 		RenderingSystem::Instance->ReturnTextureToGlobalRenderData(_ShadowMapData.Back()._RenderTargetIndex);
 
 		_ShadowMapData.Pop();
+		_ShadowCasterCaches.Pop();
 	}
+
+	//Update the shadow caster caches.
+	UpdateShadowCasterCaches();
 }
 
 /*
-*	Gathers an opaque model input stream.
+*	Callback for when a static model instance is created.
 */
-void ShadowsSystem::GatherOpaqueModelInputStream
-(
-	const uint8 shadow_map_index,
-	RenderInputStream *const RESTRICT input_stream
-) NOEXCEPT
+void ShadowsSystem::OnStaticModelInstanceCreated(Entity *const RESTRICT entity, const WorldSpaceAxisAlignedBoundingBox3D &box) NOEXCEPT
+{
+	SCOPED_LOCK(_PendingChangesLock);
+
+	_PendingInvalidationRegions.Emplace(box);
+}
+
+/*
+*	Callback for when a static model instance is destroyed.
+*/
+void ShadowsSystem::OnStaticModelInstanceDestroyed(Entity *const RESTRICT entity, const WorldSpaceAxisAlignedBoundingBox3D &box) NOEXCEPT
 {
-	//Clear the entries.
-	input_stream->_Entries.Clear();
+	SCOPED_LOCK(_PendingChangesLock);
 
-	//Clear the push constant data memory.
-	input_stream->_PushConstantDataMemory.Clear();
+	_PendingInvalidationRegions.Emplace(box);
 
-	//Skip if doesn't exist.
-	if (shadow_map_index >= _ShadowMapData.Size())
+	//Forget about the entity, it might be reused for something else.
+	for (uint64 i{ 0 }; i < _PendingMovedEntities.Size();)
 	{
-		return;
+		if (_PendingMovedEntities[i]._First == entity)
+		{
+			_PendingMovedEntities.EraseAt<false>(i);
+		}
+
+		else
+		{
+			++i;
+		}
 	}
 
-	//Cache the required visibility flag.
-	const VisibilityFlags required_visibility_flag{ VisibilityFlags::SHADOW_MAP_START << shadow_map_index };
+	for (uint64 i{ 0 }; i < _DynamicShadowCasters.Size(); ++i)
+	{
+		if (_DynamicShadowCasters[i]._Entity == entity)
+		{
+			SetDynamicShadowCaster(entity, false);
+			_DynamicShadowCasters.EraseAt<false>(i);
+
+			break;
+		}
+	}
+}
 
-	//Gather static models.
+/*
+*	Callback for when a static model instance has moved, or otherwise changed how it casts shadows.
+*	Can be called from multiple threads at once.
+*/
+void ShadowsSystem::OnStaticModelInstanceMoved(Entity *const RESTRICT entity, const WorldSpaceAxisAlignedBoundingBox3D &previous_box, const WorldSpaceAxisAlignedBoundingBox3D &current_box) NOEXCEPT
+{
+	SCOPED_LOCK(_PendingChangesLock);
+
+	/*
+	*	The current box doesn't need to invalidate anything, the model is treated as a dynamic shadow caster until it settles down,
+	*	but the previous box does, if the model was part of a cache.
+	*/
+	_PendingMovedEntities.Emplace(entity, previous_box);
+}
+
+/*
+*	Updates the shadow caster caches.
+*/
+void ShadowsSystem::UpdateShadowCasterCaches() NOEXCEPT
+{
+	SCOPED_LOCK(_PendingChangesLock);
+
+	//Dynamic shadow casters that have stayed still for long enough become static again, and need to be added to the caches they touch.
+	for (uint64 i{ 0 }; i < _DynamicShadowCasters.Size();)
 	{
-		//Go through all instances.
-		for (uint64 instance_index{ 0 }; instance_index < StaticModelComponent::Instance->NumberOfInstances(); ++instance_index)
+		DynamicShadowCaster &dynamic_shadow_caster{ _DynamicShadowCasters[i] };
+
+		if (++dynamic_shadow_caster._FramesSinceMoved >= ShadowsSystemConstants::DYNAMIC_SHADOW_CASTER_SETTLE_FRAMES)
 		{
-			Entity *const RESTRICT entity{ StaticModelComponent::Instance->InstanceToEntity(instance_index) };
-			const StaticModelInstanceData &static_model_instance_data{ StaticModelComponent::Instance->InstanceData(entity) };
-			const WorldTransformInstanceData &world_transform_instance_data{ WorldTransformComponent::Instance->InstanceData(entity) };
+			_PendingInvalidationRegions.Emplace(StaticModelComponent::Instance->InstanceData(dynamic_shadow_caster._Entity)._WorldSpaceAxisAlignedBoundingBox);
+			SetDynamicShadowCaster(dynamic_shadow_caster._Entity, false);
+			_DynamicShadowCasters.EraseAt<false>(i);
+		}
+
+		else
+		{
+			++i;
+		}
+	}
 
-			//Skip this model if it's not visible.
-			if (!TEST_BIT(static_model_instance_data._VisibilityFlags, required_visibility_flag))
+	//Static models that moved become dynamic shadow casters. The ones that were static need to be removed from the caches they were in.
+	for (const Pair<Entity *RESTRICT, WorldSpaceAxisAlignedBoundingBox3D> &moved_entity : _PendingMovedEntities)
+	{
+		bool was_dynamic{ false };
+
+		for (DynamicShadowCaster &dynamic_shadow_caster : _DynamicShadowCasters)
+		{
+			if (dynamic_shadow_caster._Entity == moved_entity._First)
 			{
-				continue;
+				dynamic_shadow_caster._FramesSinceMoved = 0;
+				was_dynamic = true;
+
+				break;
 			}
+		}
 
-			//Go through all meshes.
-			for (uint64 i{ 0 }, size{ static_model_instance_data._Model->_Meshes.Size() }; i < size; ++i)
-			{
-				//Skip this mesh depending on the material type.
-				if (static_model_instance_data._Materials[i]->_Type != MaterialAsset::Type::OPAQUE)
-				{
-					continue;
-				}
+		if (!was_dynamic)
+		{
+			_DynamicShadowCasters.Emplace();
+			DynamicShadowCaster &new_dynamic_shadow_caster{ _DynamicShadowCasters.Back() };
 
-				//Cache the mesh.
-				const Mesh &mesh{ static_model_instance_data._Model->_Meshes[i] };
+			new_dynamic_shadow_caster._Entity = moved_entity._First;
+			new_dynamic_shadow_caster._FramesSinceMoved = 0;
 
-				//Add a new entry.
-				input_stream->_Entries.Emplace();
-				RenderInputStreamEntry &new_entry{ input_stream->_Entries.Back() };
+			SetDynamicShadowCaster(moved_entity._First, true);
 
-				new_entry._PushConstantDataOffset = input_stream->_PushConstantDataMemory.Size();
-				new_entry._VertexBuffer = mesh._MeshLevelOfDetails[static_model_instance_data._LevelOfDetailIndices[i]]._VertexBuffer;
-				new_entry._IndexBuffer = mesh._MeshLevelOfDetails[static_model_instance_data._LevelOfDetailIndices[i]]._IndexBuffer;
-				new_entry._IndexBufferOffset = 0;
-				new_entry._InstanceBuffer = EMPTY_HANDLE;
-				new_entry._VertexCount = 0;
-				new_entry._IndexCount = mesh._MeshLevelOfDetails[static_model_instance_data._LevelOfDetailIndices[i]]._IndexCount;
-				new_entry._InstanceCount = 0;
+			_PendingInvalidationRegions.Emplace(moved_entity._Second);
+		}
+	}
 
-				//Set up the push constant data.
-				OpaqueModelPushConstantData push_constant_data;
+	_PendingMovedEntities.Clear();
 
-				push_constant_data._ModelMatrix = world_transform_instance_data._CurrentWorldTransform.ToRelativeMatrix4x4(WorldSystem::Instance->GetCurrentWorldGridCell());
-				push_constant_data._LightMatrixIndex = shadow_map_index;
+	//Invalidate all caches touched by the changed regions.
+	if (!_PendingInvalidationRegions.Empty())
+	{
+		const Vector3<int32> camera_cell{ RenderingSystem::Instance->GetCameraSystem()->GetCurrentCamera()->GetWorldTransform().GetCell() };
 
-				for (uint64 i{ 0 }; i < sizeof(OpaqueModelPushConstantData); ++i)
+		for (ShadowCasterCache &shadow_caster_cache : _ShadowCasterCaches)
+		{
+			for (const WorldSpaceAxisAlignedBoundingBox3D &invalidation_region : _PendingInvalidationRegions)
+			{
+				if (Culling::IsWithinFrustum(invalidation_region.GetRelativeAxisAlignedBoundingBox(camera_cell), shadow_caster_cache._Frustum))
 				{
-					input_stream->_PushConstantDataMemory.Emplace(((const byte *const RESTRICT)&push_constant_data)[i]);
+					++shadow_caster_cache._Generation;
+
+					break;
 				}
 			}
 		}
+
+		_PendingInvalidationRegions.Clear();
 	}
 }
 
 /*
-*	Gathers a masked model input stream.
+*	Returns if the given entity is a dynamic shadow caster.
+*/
+NO_DISCARD bool ShadowsSystem::IsDynamicShadowCaster(const Entity *const RESTRICT entity) const NOEXCEPT
+{
+	return entity->_EntityIdentifier < _DynamicShadowCasterFlags.Size() && _DynamicShadowCasterFlags[entity->_EntityIdentifier];
+}
+
+/*
+*	Sets whether or not the given entity is a dynamic shadow caster.
 */
-void ShadowsSystem::GatherMaskedModelInputStream
+void ShadowsSystem::SetDynamicShadowCaster(const Entity *const RESTRICT entity, const bool value) NOEXCEPT
+{
+	while (entity->_EntityIdentifier >= _DynamicShadowCasterFlags.Size())
+	{
+		_DynamicShadowCasterFlags.Emplace(false);
+	}
+
+	_DynamicShadowCasterFlags[entity->_EntityIdentifier] = value;
+}
+
+/*
+*	Gathers a model input stream with the given material type.
+*/
+void ShadowsSystem::GatherModelInputStream
 (
 	const uint8 shadow_map_index,
+	const MaterialAsset::Type material_type,
 	RenderInputStream *const RESTRICT input_stream
 ) NOEXCEPT
 {
-	//Set up the entry proxies.
-	struct EntryProxy final
-	{
-		RenderInputStreamEntry _Entry;
-		MaskedModelPushConstantData _PushConstantData;
-		float32 _Distance;
-	};
-
-	static thread_local DynamicArray<EntryProxy> entry_proxies;
-
-	entry_proxies.Clear();
-
-	//Clear the entries.
-	input_stream->_Entries.Clear();
-
-	//Clear the push constant data memory.
-	input_stream->_PushConstantDataMemory.Clear();
-
 	//Skip if doesn't exist.
 	if (shadow_map_index >= _ShadowMapData.Size())
 	{
+		input_stream->_Entries.Clear();
+		input_stream->_PushConstantDataMemory.Clear();
+		input_stream->_DrawOrder.Clear();
+
 		return;
 	}
 
-	//Cache the required visibility flag.
-	const VisibilityFlags required_visibility_flag{ VisibilityFlags::SHADOW_MAP_START << shadow_map_index };
+	//Cache the shadow caster cache.
+	ShadowCasterCache &shadow_caster_cache{ _ShadowCasterCaches[shadow_map_index] };
+	ShadowCasterCache::CachedCasters &cached_casters{ material_type == MaterialAsset::Type::OPAQUE ? shadow_caster_cache._OpaqueCasters : shadow_caster_cache._MaskedCasters };
 
-	//Gather static models.
+	//Gather the static models into the cache, if it was invalidated.
+	const bool cache_updated{ cached_casters._Generation != shadow_caster_cache._Generation };
+
+	if (cache_updated)
 	{
+		cached_casters._Entries.Clear();
+		cached_casters._PushConstantDataMemory.Clear();
+
 		//Go through all instances.
 		for (uint64 instance_index{ 0 }; instance_index < StaticModelComponent::Instance->NumberOfInstances(); ++instance_index)
 		{
 			Entity *const RESTRICT entity{ StaticModelComponent::Instance->InstanceToEntity(instance_index) };
 			const StaticModelInstanceData &static_model_instance_data{ StaticModelComponent::Instance->InstanceData(entity) };
-			const WorldTransformInstanceData &world_transform_instance_data{ WorldTransformComponent::Instance->InstanceData(entity) };
 
-			//Skip this model if it's not visible.
-			if (!TEST_BIT(static_model_instance_data._VisibilityFlags, required_visibility_flag))
+			/*
+			*	Skip this model if it's a dynamic shadow caster.
+			*	Distance culling is not respected here, since it changes with every camera movement, the cached region keeps the caster count bounded instead.
+			*/
+			if (IsDynamicShadowCaster(entity))
 			{
 				continue;
 			}
 
-			//Go through all meshes.
-			for (uint64 i{ 0 }, size{ static_model_instance_data._Model->_Meshes.Size() }; i < size; ++i)
+			//Skip this model if it's not within the cached region.
+			if (!Culling::IsWithinFrustum(static_model_instance_data._WorldSpaceAxisAlignedBoundingBox.GetRelativeAxisAlignedBoundingBox(shadow_caster_cache._CameraCell), shadow_caster_cache._Frustum))
 			{
-				//Skip this mesh depending on the material type.
-				if (static_model_instance_data._Materials[i]->_Type != MaterialAsset::Type::MASKED)
-				{
-					continue;
-				}
-
-				//Cache the mesh.
-				const Mesh &mesh{ static_model_instance_data._Model->_Meshes[i] };
-
-				//Add a new entry.
-				entry_proxies.Emplace();
-				EntryProxy &new_entry{ entry_proxies.Back() };
-
-				new_entry._Entry._PushConstantDataOffset = 0;
-				new_entry._Entry._VertexBuffer = mesh._MeshLevelOfDetails[static_model_instance_data._LevelOfDetailIndices[i]]._VertexBuffer;
-				new_entry._Entry._IndexBuffer = mesh._MeshLevelOfDetails[static_model_instance_data._LevelOfDetailIndices[i]]._IndexBuffer;
-				new_entry._Entry._IndexBufferOffset = 0;
-				new_entry._Entry._InstanceBuffer = EMPTY_HANDLE;
-				new_entry._Entry._VertexCount = 0;
-				new_entry._Entry._IndexCount = mesh._MeshLevelOfDetails[static_model_instance_data._LevelOfDetailIndices[i]]._IndexCount;
-				new_entry._Entry._InstanceCount = 0;
-
-				//Set up the push constant data.
-				new_entry._PushConstantData._ModelMatrix = world_transform_instance_data._CurrentWorldTransform.ToRelativeMatrix4x4(WorldSystem::Instance->GetCurrentWorldGridCell());
-				new_entry._PushConstantData._LightMatrixIndex = shadow_map_index;
-				new_entry._PushConstantData._MaterialIndex = static_model_instance_data._Materials[i]->_Index;
-
-				//Calculate the distance.
-				const Vector4<float32> clip_position{ _ShadowMapData[shadow_map_index]._WorldToLightMatrix * new_entry._PushConstantData._ModelMatrix * Vector4<float32>(0.0f, 0.0f, 0.0f, 1.0f) };
-				new_entry._Distance = clip_position._Z;
+				continue;
 			}
+
+			AddStaticModelShadowCasters
+			(
+				shadow_map_index,
+				shadow_caster_cache._WorldToLightMatrix,
+				material_type,
+				static_model_instance_data,
+				WorldTransformComponent::Instance->InstanceData(entity),
+				&cached_casters._Entries,
+				&cached_casters._PushConstantDataMemory
+			);
 		}
+
+		cached_casters._Generation = shadow_caster_cache._Generation;
 	}
 
-	//Perform a lazy sort on the entries.
-	if (entry_proxies.Size() > 1)
+	/*
+	*	If nothing changed, the input stream still holds the right casters from the last time it was gathered.
+	*	The draw order was cleared before gathering though, so put back the one it was sorted into.
+	*/
+	if (!cache_updated && !cached_casters._HadDynamicCasters && _DynamicShadowCasters.Empty())
 	{
-		SortingAlgorithms::StandardSort<EntryProxy>
-		(
-			entry_proxies.Begin(),
-			entry_proxies.End(),
-			nullptr,
-			[](const void *const RESTRICT user_data, const EntryProxy *const RESTRICT first, const EntryProxy *const RESTRICT second)
-			{
-				return first->_Distance < second->_Distance;
-			}
-		);
+		input_stream->_DrawOrder = cached_casters._DrawOrder;
+
+		return;
 	}
 
-	//Actually add the entries.
-	for (const EntryProxy &entry_proxy : entry_proxies)
+	//Start off with the cached static casters.
+	input_stream->_Entries = cached_casters._Entries;
+	input_stream->_PushConstantDataMemory = cached_casters._PushConstantDataMemory;
+
+	//Add the dynamic shadow casters on top.
+	const VisibilityFlags required_visibility_flag{ VisibilityFlags::SHADOW_MAP_START << shadow_map_index };
+
+	for (const DynamicShadowCaster &dynamic_shadow_caster : _DynamicShadowCasters)
 	{
-		input_stream->_Entries.Emplace(entry_proxy._Entry);
-		input_stream->_Entries.Back()._PushConstantDataOffset = input_stream->_PushConstantDataMemory.Size();
+		const StaticModelInstanceData &static_model_instance_data{ StaticModelComponent::Instance->InstanceData(dynamic_shadow_caster._Entity) };
 
-		for (uint64 i{ 0 }; i < sizeof(MaskedModelPushConstantData); ++i)
+		//Skip this model if it's not visible.
+		if (!TEST_BIT(static_model_instance_data._VisibilityFlags, required_visibility_flag))
 		{
-			input_stream->_PushConstantDataMemory.Emplace(((const byte *const RESTRICT)&entry_proxy._PushConstantData)[i]);
+			continue;
 		}
+
+		AddStaticModelShadowCasters
+		(
+			shadow_map_index,
+			_ShadowMapData[shadow_map_index]._WorldToLightMatrix,
+			material_type,
+			static_model_instance_data,
+			WorldTransformComponent::Instance->InstanceData(dynamic_shadow_caster._Entity),
+			&input_stream->_Entries,
+			&input_stream->_PushConstantDataMemory
+		);
 	}
+
+	cached_casters._HadDynamicCasters = !_DynamicShadowCasters.Empty();
+
+	//Sort the entries, and remember the draw order for the frames where the input stream is left as is.
+	input_stream->SortEntries();
+	cached_casters._DrawOrder = input_stream->_DrawOrder;
 }
\ No newline at end of file
@@ -7,10 +7,44 @@
 //Math.
 #include <Math/General/Vector.h>
 
+//Profiling.
+#include <Profiling/Profiling.h>
+
+//Systems.
+#include <Systems/TaskSystem.h>
+
 //Third party.
 #include <bc7enc/bc7enc.h>
 #include <bc7enc/bc7decomp.h>
 
+//Texture compression constants.
+namespace TextureCompressionConstants
+{
+	//The number of texels in a block.
+	constexpr uint8 TEXELS_PER_BLOCK{ 16 };
+
+	//The number of block row chunks to split a texture into per task executor, to even out the load.
+	constexpr uint32 CHUNKS_PER_EXECUTOR{ 4 };
+
+	//The number of power iterations used when finding the principal axis of a block.
+	constexpr uint8 POWER_ITERATIONS{ 8 };
+
+	//The number of least squares refinement iterations used for the HIGH quality.
+	constexpr uint8 REFINEMENT_ITERATIONS{ 2 };
+
+	//The search radius around the initial endpoints for single channel blocks at the HIGH quality.
+	constexpr int32 ALPHA_SEARCH_RADIUS{ 2 };
+
+	//The BC6H interpolation weights for 4-bit indices.
+	constexpr int32 BC6H_WEIGHTS[16]{ 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+	//The BC6H mode used by the encoder. Mode 11, one region with 10-bit endpoints and no transform.
+	constexpr uint64 BC6H_MODE{ 0x03 };
+
+	//The largest unsigned half precision value.
+	constexpr uint16 MAXIMUM_HALF{ 0x7BFF };
+}
+
 class TextureCompressionInitializer final
 {
 
@@ -30,177 +64,1338 @@ public:
 TextureCompressionInitializer INITIALIZER;
 
 /*
-*	Returns the compression ratio for a 2D texture.
+*	Compression context class definition.
 */
-NO_DISCARD uint32 TextureCompression::CompressionRatio() const NOEXCEPT
+class CompressionContext final
 {
-	switch (_Mode)
+
+public:
+
+	//The compression.
+	const TextureCompression *RESTRICT _Compression;
+
+	//The input data. Either 8-bit or 32-bit floating point RGBA, depending on the mode.
+	const void *RESTRICT _InputData;
+
+	//The width.
+	uint32 _Width;
+
+	//The height.
+	uint32 _Height;
+
+	//The number of block rows.
+	uint32 _NumberOfBlockRows;
+
+	//The number of block rows in each chunk.
+	uint32 _BlockRowsPerChunk;
+
+	//The output data.
+	byte *RESTRICT _OutputData;
+
+};
+
+/*
+*	Simple writer for packing bit fields into a 128-bit block.
+*/
+class BlockBitWriter final
+{
+
+public:
+
+	//The bits.
+	uint64 _Bits[2]{ 0, 0 };
+
+	//The current position.
+	uint32 _Position{ 0 };
+
+	/*
+	*	Writes the lowest 'number_of_bits' bits of the given value.
+	*/
+	FORCE_INLINE void Write(const uint64 value, const uint32 number_of_bits) NOEXCEPT
 	{
-		case Mode::NONE:
+		for (uint32 i{ 0 }; i < number_of_bits; ++i, ++_Position)
 		{
-			return 1;
+			_Bits[_Position >> 6] |= ((value >> i) & 1ull) << (_Position & 63);
 		}
+	}
 
-		case Mode::BC7:
+};
+
+/*
+*	Simple reader for unpacking bit fields from a 128-bit block.
+*/
+class BlockBitReader final
+{
+
+public:
+
+	//The bits.
+	uint64 _Bits[2];
+
+	//The current position.
+	uint32 _Position{ 0 };
+
+	/*
+	*	Constructor taking the block.
+	*/
+	FORCE_INLINE BlockBitReader(const byte *const RESTRICT block) NOEXCEPT
+	{
+		Memory::Copy(_Bits, block, sizeof(uint64) * 2);
+	}
+
+	/*
+	*	Reads 'number_of_bits' bits.
+	*/
+	FORCE_INLINE NO_DISCARD uint64 Read(const uint32 number_of_bits) NOEXCEPT
+	{
+		uint64 value{ 0 };
+
+		for (uint32 i{ 0 }; i < number_of_bits; ++i, ++_Position)
 		{
-			return 4;
+			value |= ((_Bits[_Position >> 6] >> (_Position & 63)) & 1ull) << i;
 		}
 
-		default:
+		return value;
+	}
+
+};
+
+/*
+*	Gathers a 4x4 block of texels, clamping at the edges of the texture.
+*/
+template <typename TYPE>
+FORCE_INLINE static void GatherBlock(const TYPE *const RESTRICT input_data, const uint32 width, const uint32 height, const uint32 block_x, const uint32 block_y, StaticArray<TYPE, 16> *const RESTRICT block) NOEXCEPT
+{
+	for (uint32 Y{ 0 }; Y < 4; ++Y)
+	{
+		const uint32 sample_y{ BaseMath::Minimum<uint32>(block_y * 4 + Y, height - 1) };
+
+		for (uint32 X{ 0 }; X < 4; ++X)
 		{
-			ASSERT(false, "Invalid case!");
+			const uint32 sample_x{ BaseMath::Minimum<uint32>(block_x * 4 + X, width - 1) };
 
-			return 1;
+			(*block)[X + Y * 4] = input_data[sample_x + static_cast<uint64>(sample_y) * width];
 		}
 	}
 }
 
 /*
-*	Returns the size required for compression for a 2D texture.
+*	Scatters a decoded 4x4 block of texels, skipping texels outside of the texture.
 */
-NO_DISCARD uint64 TextureCompression::Size2D(const uint32 width, const uint32 height) const NOEXCEPT
+FORCE_INLINE static void ScatterBlock(const StaticArray<Vector4<byte>, 16> &block, const uint32 width, const uint32 height, const uint32 block_x, const uint32 block_y, Vector4<byte> *const RESTRICT output_data) NOEXCEPT
 {
-	return width * height * (sizeof(byte) * 4) / CompressionRatio();
+	for (uint32 Y{ 0 }; Y < 4 && (block_y * 4 + Y) < height; ++Y)
+	{
+		for (uint32 X{ 0 }; X < 4 && (block_x * 4 + X) < width; ++X)
+		{
+			output_data[(block_x * 4 + X) + static_cast<uint64>(block_y * 4 + Y) * width] = block[X + Y * 4];
+		}
+	}
 }
 
 /*
-*	Compresses a 2D texture.
+*	Finds the endpoints of a line through the given points.
+*	The FAST quality uses the bounding box diagonal that best follows the points, the others use the principal axis.
 */
-void TextureCompression::Compress2D(const byte *const RESTRICT input_data, const uint32 width, const uint32 height, byte *const RESTRICT output_data) const NOEXCEPT
+FORCE_INLINE static void FitEndpoints(const StaticArray<Vector3<float32>, 16> &points, const TextureCompression::Quality quality, Vector3<float32> *const RESTRICT start, Vector3<float32> *const RESTRICT end) NOEXCEPT
 {
-	switch (_Mode)
+	Vector3<float32> minimum{ points[0] };
+	Vector3<float32> maximum{ points[0] };
+	Vector3<float32> mean{ 0.0f, 0.0f, 0.0f };
+
+	for (const Vector3<float32> &point : points)
 	{
-		case Mode::NONE:
+		for (uint8 i{ 0 }; i < 3; ++i)
 		{
-			ASSERT(false, "Don't call this function without a mode set!");
-
-			break;
+			minimum[i] = BaseMath::Minimum<float32>(minimum[i], point[i]);
+			maximum[i] = BaseMath::Maximum<float32>(maximum[i], point[i]);
 		}
 
-		case Mode::BC7:
+		mean += point;
+	}
+
+	mean /= static_cast<float32>(TextureCompressionConstants::TEXELS_PER_BLOCK);
+
+	//Calculate the covariance matrix. Stored as XX, XY, XZ, YY, YZ, ZZ.
+	StaticArray<float32, 6> covariance{ 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+
+	for (const Vector3<float32> &point : points)
+	{
+		const Vector3<float32> delta{ point - mean };
+
+		covariance[0] += delta._X * delta._X;
+		covariance[1] += delta._X * delta._Y;
+		covariance[2] += delta._X * delta._Z;
+		covariance[3] += delta._Y * delta._Y;
+		covariance[4] += delta._Y * delta._Z;
+		covariance[5] += delta._Z * delta._Z;
+	}
+
+	if (quality == TextureCompression::Quality::FAST)
+	{
+		//Flip the diagonal of the bounding box for channels that go against the one with the largest spread.
+		const uint8 main_channel{ static_cast<uint8>(covariance[0] >= covariance[3] && covariance[0] >= covariance[5] ? 0 : (covariance[3] >= covariance[5] ? 1 : 2)) };
+		const StaticArray<float32, 3> main_channel_covariance
 		{
-			Compress2DBC7(input_data, width, height, output_data);
+			main_channel == 0 ? covariance[0] : (main_channel == 1 ? covariance[1] : covariance[2]),
+			main_channel == 0 ? covariance[1] : (main_channel == 1 ? covariance[3] : covariance[4]),
+			main_channel == 0 ? covariance[2] : (main_channel == 1 ? covariance[4] : covariance[5])
+		};
 
-			break;
+		for (uint8 i{ 0 }; i < 3; ++i)
+		{
+			if (main_channel_covariance[i] < 0.0f)
+			{
+				Swap(&minimum[i], &maximum[i]);
+			}
 		}
 
-		default:
+		//Inset the endpoints a bit, since the extremes are rarely hit exactly.
+		const Vector3<float32> inset{ (maximum - minimum) / 16.0f };
+
+		*start = minimum + inset;
+		*end = maximum - inset;
+
+		return;
+	}
+
+	//Find the principal axis with power iterations, starting from the bounding box diagonal.
+	Vector3<float32> axis{ maximum - minimum };
+
+	for (uint8 iteration{ 0 }; iteration < TextureCompressionConstants::POWER_ITERATIONS; ++iteration)
+	{
+		const Vector3<float32> next
 		{
-			ASSERT(false, "Invalid case!");
+			covariance[0] * axis._X + covariance[1] * axis._Y + covariance[2] * axis._Z,
+			covariance[1] * axis._X + covariance[3] * axis._Y + covariance[4] * axis._Z,
+			covariance[2] * axis._X + covariance[4] * axis._Y + covariance[5] * axis._Z
+		};
+
+		const float32 largest{ BaseMath::Maximum<float32>(BaseMath::Absolute(next._X), BaseMath::Maximum<float32>(BaseMath::Absolute(next._Y), BaseMath::Absolute(next._Z))) };
 
+		if (largest <= 0.0f)
+		{
 			break;
 		}
+
+		axis = next / largest;
+	}
+
+	const float32 axis_length_squared{ Vector3<float32>::LengthSquared(axis) };
+
+	if (axis_length_squared <= 0.0f)
+	{
+		*start = mean;
+		*end = mean;
+
+		return;
+	}
+
+	axis /= BaseMath::SquareRoot(axis_length_squared);
+
+	float32 minimum_projection{ FLOAT32_MAXIMUM };
+	float32 maximum_projection{ -FLOAT32_MAXIMUM };
+
+	for (const Vector3<float32> &point : points)
+	{
+		const float32 projection{ Vector3<float32>::DotProduct(point - mean, axis) };
+
+		minimum_projection = BaseMath::Minimum<float32>(minimum_projection, projection);
+		maximum_projection = BaseMath::Maximum<float32>(maximum_projection, projection);
 	}
+
+	*start = mean + axis * minimum_projection;
+	*end = mean + axis * maximum_projection;
 }
 
 /*
-*	Decompresses a 2D texture.
+*	Solves for the two endpoints that best fit the given points, given their interpolation weights towards the first endpoint.
+*	Returns false if the system is degenerate.
 */
-void TextureCompression::Decompress2D(const byte *const RESTRICT input_data, const uint32 width, const uint32 height, byte *const RESTRICT output_data) NOEXCEPT
+FORCE_INLINE static NO_DISCARD bool SolveEndpointsLeastSquares(const StaticArray<Vector3<float32>, 16> &points, const StaticArray<float32, 16> &alphas, Vector3<float32> *const RESTRICT first, Vector3<float32> *const RESTRICT second) NOEXCEPT
 {
-	switch (_Mode)
+	float32 alpha_alpha{ 0.0f };
+	float32 beta_beta{ 0.0f };
+	float32 alpha_beta{ 0.0f };
+	Vector3<float32> alpha_point{ 0.0f, 0.0f, 0.0f };
+	Vector3<float32> beta_point{ 0.0f, 0.0f, 0.0f };
+
+	for (uint8 i{ 0 }; i < TextureCompressionConstants::TEXELS_PER_BLOCK; ++i)
 	{
-		case Mode::NONE:
-		{
-			ASSERT(false, "Don't call this function without a mode set!");
+		const float32 alpha{ alphas[i] };
+		const float32 beta{ 1.0f - alpha };
 
-			break;
-		}
+		alpha_alpha += alpha * alpha;
+		beta_beta += beta * beta;
+		alpha_beta += alpha * beta;
+		alpha_point += points[i] * alpha;
+		beta_point += points[i] * beta;
+	}
 
-		case Mode::BC7:
-		{
-			Decompress2DBC7(input_data, width, height, output_data);
+	const float32 determinant{ alpha_alpha * beta_beta - alpha_beta * alpha_beta };
 
-			break;
-		}
+	if (BaseMath::Absolute(determinant) < FLOAT32_EPSILON)
+	{
+		return false;
+	}
 
-		default:
+	const float32 inverse_determinant{ 1.0f / determinant };
+
+	*first = (alpha_point * beta_beta - beta_point * alpha_beta) * inverse_determinant;
+	*second = (beta_point * alpha_alpha - alpha_point * alpha_beta) * inverse_determinant;
+
+	return true;
+}
+
+/*
+*	Packs a color in the [0.0f, 255.0f] range into RGB565.
+*/
+FORCE_INLINE static NO_DISCARD uint16 PackRGB565(const Vector3<float32> &color) NOEXCEPT
+{
+	const uint32 red{ static_cast<uint32>(BaseMath::Clamp<float32>(color._X * (31.0f / 255.0f) + 0.5f, 0.0f, 31.0f)) };
+	const uint32 green{ static_cast<uint32>(BaseMath::Clamp<float32>(color._Y * (63.0f / 255.0f) + 0.5f, 0.0f, 63.0f)) };
+	const uint32 blue{ static_cast<uint32>(BaseMath::Clamp<float32>(color._Z * (31.0f / 255.0f) + 0.5f, 0.0f, 31.0f)) };
+
+	return static_cast<uint16>((red << 11) | (green << 5) | blue);
+}
+
+/*
+*	Unpacks an RGB565 color into the [0, 255] range.
+*/
+FORCE_INLINE static NO_DISCARD Vector3<int32> UnpackRGB565(const uint16 value) NOEXCEPT
+{
+	const int32 red{ (value >> 11) & 31 };
+	const int32 green{ (value >> 5) & 63 };
+	const int32 blue{ value & 31 };
+
+	return Vector3<int32>((red << 3) | (red >> 2), (green << 2) | (green >> 4), (blue << 3) | (blue >> 2));
+}
+
+/*
+*	Builds the palette for a BC1 color block.
+*	If 'four_colors' is false and the first endpoint isn't larger than the second, the three color palette (with black as the fourth) is built.
+*/
+FORCE_INLINE static void BuildColorPalette(const uint16 endpoint_0, const uint16 endpoint_1, const bool four_colors, StaticArray<Vector3<int32>, 4> *const RESTRICT palette) NOEXCEPT
+{
+	(*palette)[0] = UnpackRGB565(endpoint_0);
+	(*palette)[1] = UnpackRGB565(endpoint_1);
+
+	if (four_colors || endpoint_0 > endpoint_1)
+	{
+		for (uint8 i{ 0 }; i < 3; ++i)
 		{
-			ASSERT(false, "Invalid case!");
+			(*palette)[2][i] = ((*palette)[0][i] * 2 + (*palette)[1][i]) / 3;
+			(*palette)[3][i] = ((*palette)[0][i] + (*palette)[1][i] * 2) / 3;
+		}
+	}
 
-			break;
+	else
+	{
+		for (uint8 i{ 0 }; i < 3; ++i)
+		{
+			(*palette)[2][i] = ((*palette)[0][i] + (*palette)[1][i]) / 2;
+			(*palette)[3][i] = 0;
 		}
 	}
 }
 
 /*
-*	Compresses a 2D texture with the BC7 mode.
+*	Assigns each texel to the closest entry in the four color palette of the given endpoints. Returns the total weighted error.
 */
-void TextureCompression::Compress2DBC7(const byte *const RESTRICT input_data, const uint32 width, const uint32 height, byte *const RESTRICT output_data) const NOEXCEPT
+FORCE_INLINE static NO_DISCARD float32 EvaluateColorEndpoints(const StaticArray<Vector3<float32>, 16> &texels, const Vector3<float32> &weights, const uint16 endpoint_0, const uint16 endpoint_1, StaticArray<uint8, 16> *const RESTRICT indices) NOEXCEPT
 {
-	bc7enc_compress_block_params parameters;
+	StaticArray<Vector3<int32>, 4> palette;
+	BuildColorPalette(endpoint_0, endpoint_1, true, &palette);
 
-	bc7enc_compress_block_params_init(&parameters);
+	float32 total_error{ 0.0f };
 
-	if (_Perceptual)
+	for (uint8 texel_index{ 0 }; texel_index < TextureCompressionConstants::TEXELS_PER_BLOCK; ++texel_index)
 	{
-		bc7enc_compress_block_params_init_perceptual_weights(&parameters);
+		float32 best_error{ FLOAT32_MAXIMUM };
+
+		for (uint8 palette_index{ 0 }; palette_index < 4; ++palette_index)
+		{
+			const Vector3<float32> delta
+			{
+				texels[texel_index]._X - static_cast<float32>(palette[palette_index]._X),
+				texels[texel_index]._Y - static_cast<float32>(palette[palette_index]._Y),
+				texels[texel_index]._Z - static_cast<float32>(palette[palette_index]._Z)
+			};
+
+			const float32 error{ Vector3<float32>::DotProduct(delta * delta, weights) };
+
+			if (error < best_error)
+			{
+				best_error = error;
+				(*indices)[texel_index] = palette_index;
+			}
+		}
+
+		total_error += best_error;
 	}
 
-	else
+	return total_error;
+}
+
+/*
+*	Encodes a BC1 color block (8 bytes). Always uses the four color mode, so it can be used for BC3 as well.
+*/
+FORCE_INLINE static void EncodeColorBlock(const StaticArray<Vector4<byte>, 16> &block, const bool perceptual, const TextureCompression::Quality quality, byte *const RESTRICT output) NOEXCEPT
+{
+	//Weigh the error in green higher for perceptual compression, since that's where the eye is most sensitive.
+	const Vector3<float32> weights{ perceptual ? Vector3<float32>(0.299f, 0.587f, 0.114f) : Vector3<float32>(1.0f, 1.0f, 1.0f) };
+
+	StaticArray<Vector3<float32>, 16> texels;
+
+	for (uint8 i{ 0 }; i < TextureCompressionConstants::TEXELS_PER_BLOCK; ++i)
 	{
-		bc7enc_compress_block_params_init_linear_weights(&parameters);
+		texels[i] = Vector3<float32>(static_cast<float32>(block[i]._X), static_cast<float32>(block[i]._Y), static_cast<float32>(block[i]._Z));
 	}
 
-	uint64 output_cursor{ 0 };
+	//Fit the endpoints. The end of the line is put first, since it's usually the larger value in RGB565.
+	Vector3<float32> start;
+	Vector3<float32> end;
+	FitEndpoints(texels, quality, &start, &end);
 
-	StaticArray<Vector4<byte>, 16> block;
-	StaticArray<uint64, 2> output;
+	uint16 endpoint_0{ PackRGB565(end) };
+	uint16 endpoint_1{ PackRGB565(start) };
+	StaticArray<uint8, 16> indices;
+	float32 error{ EvaluateColorEndpoints(texels, weights, endpoint_0, endpoint_1, &indices) };
 
-	for (uint32 Y{ 0 }; Y < height; Y += 4)
+	//Refine the endpoints with least squares, for as long as it helps.
+	if (quality == TextureCompression::Quality::HIGH)
 	{
-		for (uint32 X{ 0 }; X < width; X += 4)
+		constexpr StaticArray<float32, 4> INDEX_ALPHAS{ 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f };
+
+		for (uint8 iteration{ 0 }; iteration < TextureCompressionConstants::REFINEMENT_ITERATIONS; ++iteration)
 		{
+			StaticArray<float32, 16> alphas;
+
+			for (uint8 i{ 0 }; i < TextureCompressionConstants::TEXELS_PER_BLOCK; ++i)
 			{
-				uint64 block_index{ 0 };
+				alphas[i] = INDEX_ALPHAS[indices[i]];
+			}
 
-				for (uint32 _Y{ 0 }; _Y < 4; ++_Y)
-				{
-					for (uint32 _X{ 0 }; _X < 4; ++_X)
-					{
-						const uint32 __X{ X + _X };
-						const uint32 __Y{ Y + _Y };
+			Vector3<float32> refined_first;
+			Vector3<float32> refined_second;
 
-						block[block_index++] = ((const Vector4<byte> *const RESTRICT)input_data)[__X + (__Y * width)];
-					}
-				}
+			if (!SolveEndpointsLeastSquares(texels, alphas, &refined_first, &refined_second))
+			{
+				break;
 			}
 
-			bc7enc_compress_block(output.Data(), block.Data(), &parameters);
+			const uint16 refined_endpoint_0{ PackRGB565(refined_first) };
+			const uint16 refined_endpoint_1{ PackRGB565(refined_second) };
+			StaticArray<uint8, 16> refined_indices;
+			const float32 refined_error{ EvaluateColorEndpoints(texels, weights, refined_endpoint_0, refined_endpoint_1, &refined_indices) };
 
-			((uint64 *const RESTRICT)output_data)[output_cursor++] = output[0];
-			((uint64 *const RESTRICT)output_data)[output_cursor++] = output[1];
+			if (refined_error >= error)
+			{
+				break;
+			}
+
+			endpoint_0 = refined_endpoint_0;
+			endpoint_1 = refined_endpoint_1;
+			indices = refined_indices;
+			error = refined_error;
+		}
+	}
+
+	//The four color mode requires the first endpoint to be larger, so swap if needed.
+	if (endpoint_0 < endpoint_1)
+	{
+		Swap(&endpoint_0, &endpoint_1);
+
+		for (uint8 &index : indices)
+		{
+			index ^= 1;
+		}
+	}
+
+	//If both endpoints are equal, every palette entry is the same color anyway.
+	else if (endpoint_0 == endpoint_1)
+	{
+		for (uint8 &index : indices)
+		{
+			index = 0;
 		}
 	}
+
+	uint32 packed_indices{ 0 };
+
+	for (uint8 i{ 0 }; i < TextureCompressionConstants::TEXELS_PER_BLOCK; ++i)
+	{
+		packed_indices |= static_cast<uint32>(indices[i]) << (i * 2);
+	}
+
+	Memory::Copy(&output[0], &endpoint_0, sizeof(uint16));
+	Memory::Copy(&output[2], &endpoint_1, sizeof(uint16));
+	Memory::Copy(&output[4], &packed_indices, sizeof(uint32));
 }
 
 /*
-*	Decompresses a 2D texture with the BC7 mode.
+*	Decodes a BC1 color block (8 bytes).
+*	'four_colors' should be true for BC3, where the color block always uses the four color mode.
 */
-void TextureCompression::Decompress2DBC7(const byte *const RESTRICT input_data, const uint32 width, const uint32 height, byte *const RESTRICT output_data) NOEXCEPT
+FORCE_INLINE static void DecodeColorBlock(const byte *const RESTRICT input, const bool four_colors, StaticArray<Vector4<byte>, 16> *const RESTRICT block) NOEXCEPT
 {
-	uint32 cursor{ 0 };
+	uint16 endpoint_0;
+	uint16 endpoint_1;
+	uint32 packed_indices;
 
-	StaticArray<Vector4<byte>, 16> block;
+	Memory::Copy(&endpoint_0, &input[0], sizeof(uint16));
+	Memory::Copy(&endpoint_1, &input[2], sizeof(uint16));
+	Memory::Copy(&packed_indices, &input[4], sizeof(uint32));
+
+	StaticArray<Vector3<int32>, 4> palette;
+	BuildColorPalette(endpoint_0, endpoint_1, four_colors, &palette);
+
+	for (uint8 i{ 0 }; i < TextureCompressionConstants::TEXELS_PER_BLOCK; ++i)
+	{
+		const Vector3<int32> &color{ palette[(packed_indices >> (i * 2)) & 3] };
+
+		(*block)[i] = Vector4<byte>(static_cast<byte>(color._X), static_cast<byte>(color._Y), static_cast<byte>(color._Z), UINT8_MAXIMUM);
+	}
+}
+
+/*
+*	Builds the palette for a single channel (BC4 style) block.
+*/
+FORCE_INLINE static void BuildSingleChannelPalette(const uint8 endpoint_0, const uint8 endpoint_1, StaticArray<uint8, 8> *const RESTRICT palette) NOEXCEPT
+{
+	(*palette)[0] = endpoint_0;
+	(*palette)[1] = endpoint_1;
+
+	if (endpoint_0 > endpoint_1)
+	{
+		for (uint32 i{ 1 }; i < 7; ++i)
+		{
+			(*palette)[1 + i] = static_cast<uint8>(((7 - i) * endpoint_0 + i * endpoint_1 + 3) / 7);
+		}
+	}
+
+	else
+	{
+		for (uint32 i{ 1 }; i < 5; ++i)
+		{
+			(*palette)[1 + i] = static_cast<uint8>(((5 - i) * endpoint_0 + i * endpoint_1 + 2) / 5);
+		}
+
+		(*palette)[6] = 0;
+		(*palette)[7] = UINT8_MAXIMUM;
+	}
+}
+
+/*
+*	Assigns each value to the closest entry in the palette of the given endpoints. Returns the total squared error.
+*/
+FORCE_INLINE static NO_DISCARD uint32 EvaluateSingleChannelEndpoints(const StaticArray<uint8, 16> &values, const uint8 endpoint_0, const uint8 endpoint_1, StaticArray<uint8, 16> *const RESTRICT indices) NOEXCEPT
+{
+	StaticArray<uint8, 8> palette;
+	BuildSingleChannelPalette(endpoint_0, endpoint_1, &palette);
+
+	uint32 total_error{ 0 };
 
-	for (uint32 Y{ 0 }; Y < height; Y += 4)
+	for (uint8 value_index{ 0 }; value_index < TextureCompressionConstants::TEXELS_PER_BLOCK; ++value_index)
 	{
-		for (uint32 X{ 0 }; X < width; X += 4)
+		uint32 best_error{ UINT32_MAXIMUM };
+
+		for (uint8 palette_index{ 0 }; palette_index < 8; ++palette_index)
 		{
-			bc7decomp::unpack_bc7(&input_data[cursor * 16], reinterpret_cast<bc7decomp::color_rgba *const RESTRICT>(block.Data()));
+			const int32 delta{ static_cast<int32>(values[value_index]) - static_cast<int32>(palette[palette_index]) };
+			const uint32 error{ static_cast<uint32>(delta * delta) };
 
-			for (uint32 _Y{ 0 }; _Y < 4; ++_Y)
+			if (error < best_error)
 			{
-				for (uint32 _X{ 0 }; _X < 4; ++_X)
+				best_error = error;
+				(*indices)[value_index] = palette_index;
+			}
+		}
+
+		total_error += best_error;
+	}
+
+	return total_error;
+}
+
+/*
+*	Encodes a single channel block (8 bytes). Used for BC4, BC5 and the alpha of BC3.
+*/
+FORCE_INLINE static void EncodeSingleChannelBlock(const StaticArray<uint8, 16> &values, const TextureCompression::Quality quality, byte *const RESTRICT output) NOEXCEPT
+{
+	uint8 minimum{ UINT8_MAXIMUM };
+	uint8 maximum{ 0 };
+	uint8 inner_minimum{ UINT8_MAXIMUM };
+	uint8 inner_maximum{ 0 };
+
+	for (const uint8 value : values)
+	{
+		minimum = BaseMath::Minimum<uint8>(minimum, value);
+		maximum = BaseMath::Maximum<uint8>(maximum, value);
+
+		if (value != 0 && value != UINT8_MAXIMUM)
+		{
+			inner_minimum = BaseMath::Minimum<uint8>(inner_minimum, value);
+			inner_maximum = BaseMath::Maximum<uint8>(inner_maximum, value);
+		}
+	}
+
+	//Start with the eight value mode spanning the whole range.
+	uint8 endpoint_0{ maximum };
+	uint8 endpoint_1{ minimum };
+	StaticArray<uint8, 16> indices;
+	uint32 error{ EvaluateSingleChannelEndpoints(values, endpoint_0, endpoint_1, &indices) };
+
+	if (quality != TextureCompression::Quality::FAST && error > 0)
+	{
+		//Try the six value mode, which has explicit 0 and 255 and can therefore fit the rest more tightly.
+		if (inner_minimum <= inner_maximum)
+		{
+			StaticArray<uint8, 16> candidate_indices;
+			const uint32 candidate_error{ EvaluateSingleChannelEndpoints(values, inner_minimum, inner_maximum, &candidate_indices) };
+
+			if (candidate_error < error)
+			{
+				endpoint_0 = inner_minimum;
+				endpoint_1 = inner_maximum;
+				indices = candidate_indices;
+				error = candidate_error;
+			}
+		}
+
+		//Search around the current endpoints, keeping the mode the same.
+		if (quality == TextureCompression::Quality::HIGH)
+		{
+			const bool eight_values{ endpoint_0 > endpoint_1 };
+			const int32 center_0{ endpoint_0 };
+			const int32 center_1{ endpoint_1 };
+
+			for (int32 delta_0{ -TextureCompressionConstants::ALPHA_SEARCH_RADIUS }; delta_0 <= TextureCompressionConstants::ALPHA_SEARCH_RADIUS; ++delta_0)
+			{
+				for (int32 delta_1{ -TextureCompressionConstants::ALPHA_SEARCH_RADIUS }; delta_1 <= TextureCompressionConstants::ALPHA_SEARCH_RADIUS; ++delta_1)
+				{
+					const int32 candidate_0{ center_0 + delta_0 };
+					const int32 candidate_1{ center_1 + delta_1 };
+
+					if (candidate_0 < 0 || candidate_0 > UINT8_MAXIMUM || candidate_1 < 0 || candidate_1 > UINT8_MAXIMUM || (candidate_0 > candidate_1) != eight_values)
+					{
+						continue;
+					}
+
+					StaticArray<uint8, 16> candidate_indices;
+					const uint32 candidate_error{ EvaluateSingleChannelEndpoints(values, static_cast<uint8>(candidate_0), static_cast<uint8>(candidate_1), &candidate_indices) };
+
+					if (candidate_error < error)
+					{
+						endpoint_0 = static_cast<uint8>(candidate_0);
+						endpoint_1 = static_cast<uint8>(candidate_1);
+						indices = candidate_indices;
+						error = candidate_error;
+					}
+				}
+			}
+		}
+	}
+
+	uint64 packed_indices{ 0 };
+
+	for (uint8 i{ 0 }; i < TextureCompressionConstants::TEXELS_PER_BLOCK; ++i)
+	{
+		packed_indices |= static_cast<uint64>(indices[i]) << (i * 3);
+	}
+
+	output[0] = endpoint_0;
+	output[1] = endpoint_1;
+
+	for (uint8 i{ 0 }; i < 6; ++i)
+	{
+		output[2 + i] = static_cast<byte>(packed_indices >> (i * 8));
+	}
+}
+
+/*
+*	Decodes a single channel block (8 bytes).
+*/
+FORCE_INLINE static void DecodeSingleChannelBlock(const byte *const RESTRICT input, StaticArray<uint8, 16> *const RESTRICT values) NOEXCEPT
+{
+	StaticArray<uint8, 8> palette;
+	BuildSingleChannelPalette(input[0], input[1], &palette);
+
+	uint64 packed_indices{ 0 };
+
+	for (uint8 i{ 0 }; i < 6; ++i)
+	{
+		packed_indices |= static_cast<uint64>(input[2 + i]) << (i * 8);
+	}
+
+	for (uint8 i{ 0 }; i < TextureCompressionConstants::TEXELS_PER_BLOCK; ++i)
+	{
+		(*values)[i] = palette[(packed_indices >> (i * 3)) & 7];
+	}
+}
+
+/*
+*	Converts a float to an unsigned IEEE half precision float, clamping negative values to zero.
+*/
+FORCE_INLINE static NO_DISCARD uint16 FloatToUnsignedHalf(const float32 value) NOEXCEPT
+{
+	if (!(value > 0.0f))
+	{
+		return 0;
+	}
+
+	uint32 bits;
+	Memory::Copy(&bits, &value, sizeof(uint32));
+
+	const int32 exponent{ static_cast<int32>((bits >> 23) & 0xFF) - 127 + 15 };
+
+	//Overflow, clamp to the largest finite half.
+	if (exponent >= 31)
+	{
+		return TextureCompressionConstants::MAXIMUM_HALF;
+	}
+
+	//Underflow into denormals.
+	if (exponent <= 0)
+	{
+		if (exponent < -10)
+		{
+			return 0;
+		}
+
+		const uint32 mantissa{ (bits & 0x7FFFFF) | 0x800000 };
+		const uint32 shift{ static_cast<uint32>(14 - exponent) };
+
+		return static_cast<uint16>((mantissa + (1u << (shift - 1))) >> shift);
+	}
+
+	//Round to nearest. A carry out of the mantissa correctly bumps the exponent.
+	const uint32 half{ (static_cast<uint32>(exponent) << 10) | ((bits & 0x7FFFFF) >> 13) };
+	const uint32 rounded{ half + ((bits >> 12) & 1) };
+
+	return static_cast<uint16>(BaseMath::Minimum<uint32>(rounded, TextureCompressionConstants::MAXIMUM_HALF));
+}
+
+/*
+*	Converts an unsigned IEEE half precision float to a float.
+*/
+FORCE_INLINE static NO_DISCARD float32 UnsignedHalfToFloat(const uint16 value) NOEXCEPT
+{
+	const uint32 exponent{ static_cast<uint32>(value >> 10) & 0x1F };
+	const uint32 mantissa{ static_cast<uint32>(value) & 0x3FF };
+
+	if (exponent == 0)
+	{
+		return static_cast<float32>(mantissa) * (1.0f / 16'777'216.0f);
+	}
+
+	const uint32 bits{ ((exponent - 15 + 127) << 23) | (mantissa << 13) };
+	float32 result;
+	Memory::Copy(&result, &bits, sizeof(float32));
+
+	return result;
+}
+
+/*
+*	Unquantizes a 10-bit unsigned BC6H endpoint.
+*/
+FORCE_INLINE static NO_DISCARD int32 UnquantizeBC6H(const int32 value) NOEXCEPT
+{
+	if (value == 0)
+	{
+		return 0;
+	}
+
+	if (value == 1'023)
+	{
+		return 0xFFFF;
+	}
+
+	return ((value << 16) + 0x8000) >> 10;
+}
+
+/*
+*	Quantizes a value in the unquantized BC6H range to a 10-bit endpoint.
+*/
+FORCE_INLINE static NO_DISCARD int32 QuantizeBC6H(const float32 value) NOEXCEPT
+{
+	return BaseMath::Clamp<int32>(static_cast<int32>((value - 32.0f) / 64.0f + 0.5f), 0, 1'023);
+}
+
+/*
+*	Assigns each texel to the closest entry in the palette of the given quantized endpoints. Returns the total squared error in half space.
+*/
+FORCE_INLINE static NO_DISCARD float32 EvaluateBC6HEndpoints(const StaticArray<Vector3<float32>, 16> &halves, const Vector3<int32> &endpoint_0, const Vector3<int32> &endpoint_1, StaticArray<uint8, 16> *const RESTRICT indices) NOEXCEPT
+{
+	StaticArray<Vector3<float32>, 16> palette;
+
+	for (uint8 palette_index{ 0 }; palette_index < 16; ++palette_index)
+	{
+		const int32 weight{ TextureCompressionConstants::BC6H_WEIGHTS[palette_index] };
+
+		for (uint8 i{ 0 }; i < 3; ++i)
+		{
+			const int32 interpolated{ (UnquantizeBC6H(endpoint_0[i]) * (64 - weight) + UnquantizeBC6H(endpoint_1[i]) * weight + 32) >> 6 };
+
+			palette[palette_index][i] = static_cast<float32>((interpolated * 31) >> 6);
+		}
+	}
+
+	float32 total_error{ 0.0f };
+
+	for (uint8 texel_index{ 0 }; texel_index < TextureCompressionConstants::TEXELS_PER_BLOCK; ++texel_index)
+	{
+		float32 best_error{ FLOAT32_MAXIMUM };
+
+		for (uint8 palette_index{ 0 }; palette_index < 16; ++palette_index)
+		{
+			const Vector3<float32> delta{ halves[texel_index] - palette[palette_index] };
+			const float32 error{ Vector3<float32>::LengthSquared(delta) };
+
+			if (error < best_error)
+			{
+				best_error = error;
+				(*indices)[texel_index] = palette_index;
+			}
+		}
+
+		total_error += best_error;
+	}
+
+	return total_error;
+}
+
+/*
+*	Encodes a BC6H block (16 bytes) in mode 11, from floating point RGBA texels. Alpha is ignored.
+*/
+FORCE_INLINE static void EncodeBC6HBlock(const StaticArray<Vector4<float32>, 16> &block, const TextureCompression::Quality quality, byte *const RESTRICT output) NOEXCEPT
+{
+	//Convert to halves, and to the unquantized endpoint range the interpolation happens in.
+	StaticArray<Vector3<float32>, 16> halves;
+	StaticArray<Vector3<float32>, 16> unquantized;
+
+	for (uint8 i{ 0 }; i < TextureCompressionConstants::TEXELS_PER_BLOCK; ++i)
+	{
+		for (uint8 j{ 0 }; j < 3; ++j)
+		{
+			halves[i][j] = static_cast<float32>(FloatToUnsignedHalf(block[i][j]));
+			unquantized[i][j] = halves[i][j] * (64.0f / 31.0f);
+		}
+	}
+
+	Vector3<float32> start;
+	Vector3<float32> end;
+	FitEndpoints(unquantized, quality, &start, &end);
+
+	Vector3<int32> endpoint_0{ QuantizeBC6H(start._X), QuantizeBC6H(start._Y), QuantizeBC6H(start._Z) };
+	Vector3<int32> endpoint_1{ QuantizeBC6H(end._X), QuantizeBC6H(end._Y), QuantizeBC6H(end._Z) };
+	StaticArray<uint8, 16> indices;
+	float32 error{ EvaluateBC6HEndpoints(halves, endpoint_0, endpoint_1, &indices) };
+
+	//Refine the endpoints with least squares, for as long as it helps.
+	if (quality == TextureCompression::Quality::HIGH)
+	{
+		for (uint8 iteration{ 0 }; iteration < TextureCompressionConstants::REFINEMENT_ITERATIONS; ++iteration)
+		{
+			StaticArray<float32, 16> alphas;
+
+			for (uint8 i{ 0 }; i < TextureCompressionConstants::TEXELS_PER_BLOCK; ++i)
+			{
+				alphas[i] = static_cast<float32>(64 - TextureCompressionConstants::BC6H_WEIGHTS[indices[i]]) / 64.0f;
+			}
+
+			Vector3<float32> refined_first;
+			Vector3<float32> refined_second;
+
+			if (!SolveEndpointsLeastSquares(unquantized, alphas, &refined_first, &refined_second))
+			{
+				break;
+			}
+
+			const Vector3<int32> refined_endpoint_0{ QuantizeBC6H(refined_first._X), QuantizeBC6H(refined_first._Y), QuantizeBC6H(refined_first._Z) };
+			const Vector3<int32> refined_endpoint_1{ QuantizeBC6H(refined_second._X), QuantizeBC6H(refined_second._Y), QuantizeBC6H(refined_second._Z) };
+			StaticArray<uint8, 16> refined_indices;
+			const float32 refined_error{ EvaluateBC6HEndpoints(halves, refined_endpoint_0, refined_endpoint_1, &refined_indices) };
+
+			if (refined_error >= error)
+			{
+				break;
+			}
+
+			endpoint_0 = refined_endpoint_0;
+			endpoint_1 = refined_endpoint_1;
+			indices = refined_indices;
+			error = refined_error;
+		}
+	}
+
+	//The first index is stored with one bit less, so its highest bit needs to be zero. Swap the endpoints if it isn't.
+	if (indices[0] >= 8)
+	{
+		Swap(&endpoint_0, &endpoint_1);
+
+		for (uint8 &index : indices)
+		{
+			index = 15 - index;
+		}
+	}
+
+	BlockBitWriter writer;
+
+	writer.Write(TextureCompressionConstants::BC6H_MODE, 5);
+
+	for (uint8 i{ 0 }; i < 3; ++i)
+	{
+		writer.Write(static_cast<uint64>(endpoint_0[i]), 10);
+	}
+
+	for (uint8 i{ 0 }; i < 3; ++i)
+	{
+		writer.Write(static_cast<uint64>(endpoint_1[i]), 10);
+	}
+
+	writer.Write(indices[0], 3);
+
+	for (uint8 i{ 1 }; i < TextureCompressionConstants::TEXELS_PER_BLOCK; ++i)
+	{
+		writer.Write(indices[i], 4);
+	}
+
+	Memory::Copy(output, writer._Bits, sizeof(uint64) * 2);
+}
+
+/*
+*	Decodes a BC6H block (16 bytes) written by the encoder above into 8-bit RGBA, clamping to [0.0f, 1.0f].
+*/
+FORCE_INLINE static void DecodeBC6HBlock(const byte *const RESTRICT input, StaticArray<Vector4<byte>, 16> *const RESTRICT block) NOEXCEPT
+{
+	BlockBitReader reader{ input };
+
+	if (reader.Read(5) != TextureCompressionConstants::BC6H_MODE)
+	{
+		ASSERT(false, "Only BC6H mode 11 is supported for decoding!");
+
+		for (Vector4<byte> &texel : *block)
+		{
+			texel = Vector4<byte>(0, 0, 0, UINT8_MAXIMUM);
+		}
+
+		return;
+	}
+
+	Vector3<int32> endpoint_0;
+	Vector3<int32> endpoint_1;
+
+	for (uint8 i{ 0 }; i < 3; ++i)
+	{
+		endpoint_0[i] = UnquantizeBC6H(static_cast<int32>(reader.Read(10)));
+	}
+
+	for (uint8 i{ 0 }; i < 3; ++i)
+	{
+		endpoint_1[i] = UnquantizeBC6H(static_cast<int32>(reader.Read(10)));
+	}
+
+	for (uint8 texel_index{ 0 }; texel_index < TextureCompressionConstants::TEXELS_PER_BLOCK; ++texel_index)
+	{
+		const int32 weight{ TextureCompressionConstants::BC6H_WEIGHTS[reader.Read(texel_index == 0 ? 3 : 4)] };
+
+		for (uint8 i{ 0 }; i < 3; ++i)
+		{
+			const int32 interpolated{ (endpoint_0[i] * (64 - weight) + endpoint_1[i] * weight + 32) >> 6 };
+			const float32 value{ UnsignedHalfToFloat(static_cast<uint16>((interpolated * 31) >> 6)) };
+
+			(*block)[texel_index][i] = static_cast<byte>(BaseMath::Clamp<float32>(value, 0.0f, 1.0f) * static_cast<float32>(UINT8_MAXIMUM) + 0.5f);
+		}
+
+		(*block)[texel_index][3] = UINT8_MAXIMUM;
+	}
+}
+
+/*
+*	Compresses the given range of block rows.
+*/
+FORCE_INLINE static void CompressBlockRows(const CompressionContext &context, const uint32 first_block_row, const uint32 last_block_row) NOEXCEPT
+{
+	const TextureCompression &compression{ *context._Compression };
+	const uint32 number_of_block_columns{ (context._Width + 3) / 4 };
+	const uint32 block_size{ compression.BlockSize() };
+
+	switch (compression._Mode)
+	{
+		case TextureCompression::Mode::BC7:
+		{
+			bc7enc_compress_block_params parameters;
+
+			bc7enc_compress_block_params_init(&parameters);
+
+			if (compression._Perceptual)
+			{
+				bc7enc_compress_block_params_init_perceptual_weights(&parameters);
+			}
+
+			else
+			{
+				bc7enc_compress_block_params_init_linear_weights(&parameters);
+			}
+
+			switch (compression._Quality)
+			{
+				case TextureCompression::Quality::FAST:
+				{
+					parameters.m_max_partitions_mode = BC7ENC_MAX_PARTITIONS1 / 4;
+					parameters.m_try_least_squares = BC7ENC_FALSE;
+
+					break;
+				}
+
+				case TextureCompression::Quality::NORMAL:
+				{
+					break;
+				}
+
+				case TextureCompression::Quality::HIGH:
+				{
+					parameters.m_uber_level = BC7ENC_MAX_UBER_LEVEL / 2;
+
+					break;
+				}
+
+				default:
+				{
+					ASSERT(false, "Invalid case!");
+
+					break;
+				}
+			}
+
+			StaticArray<Vector4<byte>, 16> block;
+
+			for (uint32 block_y{ first_block_row }; block_y < last_block_row; ++block_y)
+			{
+				for (uint32 block_x{ 0 }; block_x < number_of_block_columns; ++block_x)
+				{
+					GatherBlock(static_cast<const Vector4<byte> *const RESTRICT>(context._InputData), context._Width, context._Height, block_x, block_y, &block);
+					bc7enc_compress_block(&context._OutputData[(block_x + static_cast<uint64>(block_y) * number_of_block_columns) * block_size], block.Data(), &parameters);
+				}
+			}
+
+			break;
+		}
+
+		case TextureCompression::Mode::BC1:
+		case TextureCompression::Mode::BC3:
+		case TextureCompression::Mode::BC4:
+		case TextureCompression::Mode::BC5:
+		{
+			StaticArray<Vector4<byte>, 16> block;
+			StaticArray<uint8, 16> values;
+
+			for (uint32 block_y{ first_block_row }; block_y < last_block_row; ++block_y)
+			{
+				for (uint32 block_x{ 0 }; block_x < number_of_block_columns; ++block_x)
+				{
+					GatherBlock(static_cast<const Vector4<byte> *const RESTRICT>(context._InputData), context._Width, context._Height, block_x, block_y, &block);
+
+					byte *const RESTRICT output{ &context._OutputData[(block_x + static_cast<uint64>(block_y) * number_of_block_columns) * block_size] };
+
+					if (compression._Mode == TextureCompression::Mode::BC1)
+					{
+						EncodeColorBlock(block, compression._Perceptual, compression._Quality, output);
+					}
+
+					else if (compression._Mode == TextureCompression::Mode::BC3)
+					{
+						for (uint8 i{ 0 }; i < TextureCompressionConstants::TEXELS_PER_BLOCK; ++i)
+						{
+							values[i] = block[i]._W;
+						}
+
+						EncodeSingleChannelBlock(values, compression._Quality, &output[0]);
+						EncodeColorBlock(block, compression._Perceptual, compression._Quality, &output[8]);
+					}
+
+					else
+					{
+						const uint8 number_of_channels{ static_cast<uint8>(compression._Mode == TextureCompression::Mode::BC4 ? 1 : 2) };
+
+						for (uint8 channel_index{ 0 }; channel_index < number_of_channels; ++channel_index)
+						{
+							for (uint8 i{ 0 }; i < TextureCompressionConstants::TEXELS_PER_BLOCK; ++i)
+							{
+								values[i] = block[i][channel_index];
+							}
+
+							EncodeSingleChannelBlock(values, compression._Quality, &output[channel_index * 8]);
+						}
+					}
+				}
+			}
+
+			break;
+		}
+
+		case TextureCompression::Mode::BC6H:
+		{
+			StaticArray<Vector4<float32>, 16> block;
+
+			for (uint32 block_y{ first_block_row }; block_y < last_block_row; ++block_y)
+			{
+				for (uint32 block_x{ 0 }; block_x < number_of_block_columns; ++block_x)
+				{
+					GatherBlock(static_cast<const Vector4<float32> *const RESTRICT>(context._InputData), context._Width, context._Height, block_x, block_y, &block);
+					EncodeBC6HBlock(block, compression._Quality, &context._OutputData[(block_x + static_cast<uint64>(block_y) * number_of_block_columns) * block_size]);
+				}
+			}
+
+			break;
+		}
+
+		default:
+		{
+			ASSERT(false, "Invalid case!");
+
+			break;
+		}
+	}
+}
+
+/*
+*	Splits the block rows of a texture across the task system and waits for them to finish.
+*/
+FORCE_INLINE static void CompressParallel(const TextureCompression &compression, const void *const RESTRICT input_data, const uint32 width, const uint32 height, byte *const RESTRICT output_data) NOEXCEPT
+{
+	PROFILING_SCOPE("TextureCompression::CompressParallel");
+
+	const uint32 number_of_block_rows{ (height + 3) / 4 };
+	const uint32 maximum_number_of_chunks{ BaseMath::Maximum<uint32>(TaskSystem::Instance->GetNumberOfTaskExecutors() * TextureCompressionConstants::CHUNKS_PER_EXECUTOR, 1) };
+	const uint32 number_of_chunks{ BaseMath::Minimum<uint32>(number_of_block_rows, maximum_number_of_chunks) };
+
+	CompressionContext context;
+
+	context._Compression = &compression;
+	context._InputData = input_data;
+	context._Width = width;
+	context._Height = height;
+	context._NumberOfBlockRows = number_of_block_rows;
+	context._BlockRowsPerChunk = (number_of_block_rows + number_of_chunks - 1) / number_of_chunks;
+	context._OutputData = output_data;
+
+	TaskSystem::ParallelFor(Task::Priority::LOW, (number_of_block_rows + context._BlockRowsPerChunk - 1) / context._BlockRowsPerChunk, [](void *const RESTRICT arguments, const uint32 index)
+	{
+		const CompressionContext &compression_context{ *static_cast<const CompressionContext *const RESTRICT>(arguments) };
+		const uint32 first_block_row{ index * compression_context._BlockRowsPerChunk };
+
+		CompressBlockRows(compression_context, first_block_row, BaseMath::Minimum<uint32>(first_block_row + compression_context._BlockRowsPerChunk, compression_context._NumberOfBlockRows));
+	}, &context);
+}
+
+/*
+*	Returns the compression ratio for a 2D texture, compared to uncompressed 8-bit RGBA.
+*/
+NO_DISCARD uint32 TextureCompression::CompressionRatio() const NOEXCEPT
+{
+	switch (_Mode)
+	{
+		case Mode::NONE:
+		{
+			return 1;
+		}
+
+		case Mode::BC1:
+		case Mode::BC4:
+		{
+			return 8;
+		}
+
+		case Mode::BC3:
+		case Mode::BC5:
+		case Mode::BC6H:
+		case Mode::BC7:
+		{
+			return 4;
+		}
+
+		default:
+		{
+			ASSERT(false, "Invalid case!");
+
+			return 1;
+		}
+	}
+}
+
+/*
+*	Returns the size, in bytes, of each compressed 4x4 block.
+*/
+NO_DISCARD uint32 TextureCompression::BlockSize() const NOEXCEPT
+{
+	return TextureCompressionConstants::TEXELS_PER_BLOCK * static_cast<uint32>(sizeof(byte) * 4) / CompressionRatio();
+}
+
+/*
+*	Returns the size required for compression for a 2D texture.
+*	Textures that aren't a multiple of four in either dimension are padded to whole blocks.
+*/
+NO_DISCARD uint64 TextureCompression::Size2D(const uint32 width, const uint32 height) const NOEXCEPT
+{
+	if (_Mode == Mode::NONE)
+	{
+		return static_cast<uint64>(width) * height * (sizeof(byte) * 4);
+	}
+
+	return static_cast<uint64>((width + 3) / 4) * ((height + 3) / 4) * BlockSize();
+}
+
+/*
+*	Compresses a 2D texture from 8-bit RGBA data.
+*	The blocks are split across the task system, and this function returns when all are done.
+*/
+void TextureCompression::Compress2D(const byte *const RESTRICT input_data, const uint32 width, const uint32 height, byte *const RESTRICT output_data) const NOEXCEPT
+{
+	switch (_Mode)
+	{
+		case Mode::NONE:
+		{
+			ASSERT(false, "Don't call this function without a mode set!");
+
+			break;
+		}
+
+		case Mode::BC6H:
+		{
+			ASSERT(false, "BC6H compresses from floating point data!");
+
+			break;
+		}
+
+		case Mode::BC1:
+		case Mode::BC3:
+		case Mode::BC4:
+		case Mode::BC5:
+		case Mode::BC7:
+		{
+			CompressParallel(*this, input_data, width, height, output_data);
+
+			break;
+		}
+
+		default:
+		{
+			ASSERT(false, "Invalid case!");
+
+			break;
+		}
+	}
+}
+
+/*
+*	Compresses a 2D texture from 32-bit floating point RGBA data. Only valid for BC6H.
+*	The blocks are split across the task system, and this function returns when all are done.
+*/
+void TextureCompression::Compress2D(const float32 *const RESTRICT input_data, const uint32 width, const uint32 height, byte *const RESTRICT output_data) const NOEXCEPT
+{
+	ASSERT(_Mode == Mode::BC6H, "Only BC6H compresses from floating point data!");
+
+	CompressParallel(*this, input_data, width, height, output_data);
+}
+
+/*
+*	Decompresses a 2D texture into 8-bit RGBA data.
+*	Channels that aren't stored by the mode are decoded the way the GPU does it (zero for color channels, one for alpha).
+*/
+void TextureCompression::Decompress2D(const byte *const RESTRICT input_data, const uint32 width, const uint32 height, byte *const RESTRICT output_data) NOEXCEPT
+{
+	if (_Mode == Mode::NONE)
+	{
+		ASSERT(false, "Don't call this function without a mode set!");
+
+		return;
+	}
+
+	const uint32 number_of_block_columns{ (width + 3) / 4 };
+	const uint32 number_of_block_rows{ (height + 3) / 4 };
+	const uint32 block_size{ BlockSize() };
+
+	Vector4<byte> *const RESTRICT output_texels{ reinterpret_cast<Vector4<byte> *const RESTRICT>(output_data) };
+
+	StaticArray<Vector4<byte>, 16> block;
+	StaticArray<uint8, 16> values;
+
+	for (uint32 block_y{ 0 }; block_y < number_of_block_rows; ++block_y)
+	{
+		for (uint32 block_x{ 0 }; block_x < number_of_block_columns; ++block_x)
+		{
+			const byte *const RESTRICT input{ &input_data[(block_x + static_cast<uint64>(block_y) * number_of_block_columns) * block_size] };
+
+			switch (_Mode)
+			{
+				case Mode::BC1:
+				{
+					DecodeColorBlock(input, false, &block);
+
+					break;
+				}
+
+				case Mode::BC3:
+				{
+					DecodeColorBlock(&input[8], true, &block);
+					DecodeSingleChannelBlock(&input[0], &values);
+
+					for (uint8 i{ 0 }; i < TextureCompressionConstants::TEXELS_PER_BLOCK; ++i)
+					{
+						block[i]._W = values[i];
+					}
+
+					break;
+				}
+
+				case Mode::BC4:
+				case Mode::BC5:
+				{
+					for (Vector4<byte> &texel : block)
+					{
+						texel = Vector4<byte>(0, 0, 0, UINT8_MAXIMUM);
+					}
+
+					const uint8 number_of_channels{ static_cast<uint8>(_Mode == Mode::BC4 ? 1 : 2) };
+
+					for (uint8 channel_index{ 0 }; channel_index < number_of_channels; ++channel_index)
+					{
+						DecodeSingleChannelBlock(&input[channel_index * 8], &values);
+
+						for (uint8 i{ 0 }; i < TextureCompressionConstants::TEXELS_PER_BLOCK; ++i)
+						{
+							block[i][channel_index] = values[i];
+						}
+					}
+
+					break;
+				}
+
+				case Mode::BC6H:
+				{
+					DecodeBC6HBlock(input, &block);
+
+					break;
+				}
+
+				case Mode::BC7:
+				{
+					bc7decomp::unpack_bc7(input, reinterpret_cast<bc7decomp::color_rgba *const RESTRICT>(block.Data()));
+
+					break;
+				}
+
+				default:
 				{
-					const uint32 __X{ X + _X };
-					const uint32 __Y{ Y + _Y };
+					ASSERT(false, "Invalid case!");
 
-					reinterpret_cast<Vector4<byte> *const RESTRICT>(output_data)[__X + (__Y * width)] = block[_X + (_Y * 4)];
+					break;
 				}
 			}
 
-			++cursor;
+			ScatterBlock(block, width, height, block_x, block_y, output_texels);
 		}
 	}
 }
\ No newline at end of file
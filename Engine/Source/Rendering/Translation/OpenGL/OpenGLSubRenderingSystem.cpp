@@ -141,6 +141,14 @@ void OpenGLSubRenderingSystem::UploadDataToBuffer(const void *const RESTRICT *co
 
 }
 
+/*
+*	Maps a host visible buffer and returns a pointer to it's memory.
+*/
+RESTRICTED NO_DISCARD void *const RESTRICT OpenGLSubRenderingSystem::MapBuffer(const BufferHandle handle) const NOEXCEPT
+{
+	return nullptr;
+}
+
 /*
 *	Destroys a buffer.
 */
@@ -384,6 +392,22 @@ void OpenGLSubRenderingSystem::UpdateTexture2D(const TextureDataContainer &textu
 
 }
 
+/*
+*	Updates a region of a texture 2D, copying the given rectangle of the first mip level from the given texture data, which covers the whole texture.
+*/
+void OpenGLSubRenderingSystem::UpdateTexture2DRegion
+(
+	const TextureDataContainer &texture_data_container,
+	const uint32 X,
+	const uint32 Y,
+	const uint32 width,
+	const uint32 height,
+	Texture2DHandle *const RESTRICT handle
+) const NOEXCEPT
+{
+
+}
+
 /*
 *	Destroys a texture 2D.
 */
@@ -1203,6 +1203,14 @@ void VulkanSubRenderingSystem::UploadDataToBuffer(const void *const RESTRICT *co
 	static_cast<VulkanBuffer *const RESTRICT>(*handle)->UploadData(data, data_sizes, data_chunks);
 }
 
+/*
+*	Maps a host visible buffer and returns a pointer to it's memory.
+*/
+RESTRICTED NO_DISCARD void *const RESTRICT VulkanSubRenderingSystem::MapBuffer(const BufferHandle handle) const NOEXCEPT
+{
+	return static_cast<VulkanBuffer *const RESTRICT>(handle)->MapMemory();
+}
+
 /*
 *	Destroys a buffer.
 */
@@ -1882,6 +1890,22 @@ void VulkanSubRenderingSystem::UpdateTexture2D(const TextureDataContainer &textu
 	VulkanInterface::Instance->Update2DTexture(texture_data_container._TextureData.Data(), static_cast<Vulkan2DTexture* const RESTRICT>(*handle));
 }
 
+/*
+*	Updates a region of a texture 2D, copying the given rectangle of the first mip level from the given texture data, which covers the whole texture.
+*/
+void VulkanSubRenderingSystem::UpdateTexture2DRegion
+(
+	const TextureDataContainer &texture_data_container,
+	const uint32 X,
+	const uint32 Y,
+	const uint32 width,
+	const uint32 height,
+	Texture2DHandle *const RESTRICT handle
+) const NOEXCEPT
+{
+	VulkanInterface::Instance->Update2DTextureRegion(texture_data_container._TextureData[0], X, Y, width, height, static_cast<Vulkan2DTexture* const RESTRICT>(*handle));
+}
+
 /*
 *	Destroys a texture 2D.
 */
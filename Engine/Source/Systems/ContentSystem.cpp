@@ -8,6 +8,7 @@
 
 //Content.
 #include <Content/Core/ContentCache.h>
+#include <Content/Core/ContentStore.h>
 #include <Content/AssetCompilers/AnimatedModelAssetCompiler.h>
 #include <Content/AssetCompilers/AnimationAssetCompiler.h>
 #include <Content/AssetCompilers/AudioAssetCompiler.h>
@@ -45,6 +46,7 @@
 
 //STL.
 #include <filesystem>
+#include <fstream>
 
 //Constants.
 #define ENGINE_ASSETS "..\\..\\..\\..\\Catalyst-Engine\\Engine\\Content\\Assets"
@@ -54,6 +56,63 @@
 #define GAME_RENDERING "..\\..\\..\\Rendering"
 #define GAME_COMPILED "..\\..\\..\\Content\\Compiled"
 
+//Content system constants.
+namespace ContentSystemConstants
+{
+	constexpr uint64 ASSET_COLLECTION_IDENTIFIER{ 0x434F4C4C45435449 };
+	constexpr uint64 ASSET_COLLECTION_VERSION{ 1 };
+	constexpr uint64 ASSET_COLLECTION_ALIGNMENT{ 64 };
+}
+
+/*
+*	Returns the position of the next asset in an asset collection, given the position right after the previous one.
+*	Assets are padded so that their data, which follows the file size, starts on a cache line, so it can be used straight from a mapped file.
+*/
+FORCE_INLINE NO_DISCARD static uint64 AssetCollectionEntryPosition(const uint64 position) NOEXCEPT
+{
+	const uint64 data_position{ position + sizeof(uint64) };
+	const uint64 aligned_data_position{ (data_position + ContentSystemConstants::ASSET_COLLECTION_ALIGNMENT - 1) & ~(ContentSystemConstants::ASSET_COLLECTION_ALIGNMENT - 1) };
+
+	return aligned_data_position - sizeof(uint64);
+}
+
+/*
+*	Returns if all asset collections created from the given compiled directory have the current layout.
+*/
+FORCE_INLINE NO_DISCARD static bool AssetCollectionsUpToDate(const char *const RESTRICT compiled_directory) NOEXCEPT
+{
+	char collections_directory_path[MAXIMUM_FILE_PATH_LENGTH];
+	sprintf_s(collections_directory_path, "%s\\..\\Collections", compiled_directory);
+
+	if (!std::filesystem::exists(collections_directory_path))
+	{
+		return true;
+	}
+
+	for (const auto &entry : std::filesystem::directory_iterator(collections_directory_path))
+	{
+		if (entry.is_directory() || entry.path().extension() != ".cac")
+		{
+			continue;
+		}
+
+		std::ifstream file{ entry.path(), std::ios::binary };
+
+		uint64 identifier{ 0 };
+		uint64 version{ 0 };
+
+		file.read(reinterpret_cast<char *const RESTRICT>(&identifier), sizeof(uint64));
+		file.read(reinterpret_cast<char *const RESTRICT>(&version), sizeof(uint64));
+
+		if (identifier != ContentSystemConstants::ASSET_COLLECTION_IDENTIFIER || version != ContentSystemConstants::ASSET_COLLECTION_VERSION)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
 #if !defined(CATALYST_CONFIGURATION_FINAL)
 //Denotes whether or not the statistics window is open.
 bool STATISTICS_WINDOW_OPEN{ false };
@@ -207,34 +266,59 @@ void ContentSystem::LoadAssetCollection(const char *const RESTRICT file_path) NO
 	{
 		PROFILING_SCOPE("ContentSystem::LoadAssetCollection::CreateStreamArchive");
 
+		stream_archive.SetMode(StreamArchive::Mode::READ);
 
+		//Mapped files are viewed directly, so asset compilers can create resources straight from the mapping. The mapping is released when the file is closed, after all loads have finished.
+		if (input_file.IsMapped())
 		{
-			PROFILING_SCOPE("ContentSystem::LoadAssetCollection::AllocateStreamArchive");
-			stream_archive.Resize(input_file.Size());
+			stream_archive.SetData(static_cast<byte* const RESTRICT>(const_cast<void* const RESTRICT>(input_file.GetMappedData())), input_file.Size());
 		}
 
+		else
 		{
 			PROFILING_SCOPE("ContentSystem::LoadAssetCollection::ReadStreamArchive");
 
-			stream_archive.SetMode(StreamArchive::Mode::READ);
-			
-			if (input_file.IsMapped())
-			{
-				stream_archive.SetData(static_cast<byte* const RESTRICT>(const_cast<void* const RESTRICT>(input_file.GetMappedData())), input_file.Size());
-			}
-
-			else
-			{
-				input_file.Read(stream_archive.Data(), input_file.Size());
-			}
+			stream_archive.Resize(input_file.Size());
+			input_file.Read(stream_archive.Data(), input_file.Size());
 		}
 	}
 
 	//Read the whole file.
 	uint64 stream_archive_position{ 0 };
 
-	while (stream_archive_position < stream_archive.Size())
+	//Check that this asset collection has the current layout.
+	{
+		uint64 identifier{ 0 };
+		uint64 version{ 0 };
+
+		if (stream_archive.Size() >= sizeof(uint64) * 2)
+		{
+			stream_archive.Read(&identifier, sizeof(uint64), &stream_archive_position);
+			stream_archive.Read(&version, sizeof(uint64), &stream_archive_position);
+		}
+
+		if (identifier != ContentSystemConstants::ASSET_COLLECTION_IDENTIFIER || version != ContentSystemConstants::ASSET_COLLECTION_VERSION)
+		{
+			ASSERT(false, "Asset collection is out of date, recompile content!");
+
+			LOG_ERROR("%s is out of date, recompile content!", file_path);
+
+			input_file.Close();
+
+			return;
+		}
+	}
+
+	for (;;)
 	{
+		//Skip the padding before this asset.
+		stream_archive_position = AssetCollectionEntryPosition(stream_archive_position);
+
+		if (stream_archive_position >= stream_archive.Size())
+		{
+			break;
+		}
+
 		//Remember the original stream archive position.
 		const uint64 original_stream_archive_position{ stream_archive_position };
 
@@ -346,6 +430,36 @@ void ContentSystem::LoadAssetCollection(const char *const RESTRICT file_path) NO
 	LOG_INFORMATION("%s took %f seconds to load", file_path, start_time.GetSecondsSince());
 }
 
+/*
+*	Returns the hash of everything besides the source file itself that decides what an asset compiles to.
+*/
+FORCE_INLINE NO_DISCARD static uint64 CompileSettingsHash
+(
+	const AssetCompiler *const RESTRICT asset_compiler,
+	const CompilationDomain compilation_domain,
+	const char *const RESTRICT collection,
+	const char *const RESTRICT file_path
+) NOEXCEPT
+{
+	const uint64 asset_type_identifier{ asset_compiler->AssetTypeIdentifier() };
+	const uint64 version{ asset_compiler->CurrentVersion() };
+
+	uint64 hash{ HashAlgorithms::MurmurHash64(static_cast<const void *const RESTRICT>(&asset_type_identifier), sizeof(uint64)) };
+
+	hash = HashAlgorithms::MurmurHash64(static_cast<const void *const RESTRICT>(&version), sizeof(uint64), hash);
+	hash = HashAlgorithms::MurmurHash64(static_cast<const void *const RESTRICT>(&compilation_domain), sizeof(CompilationDomain), hash);
+
+	if (collection)
+	{
+		hash = HashAlgorithms::MurmurHash64(collection, StringUtilities::StringLength(collection), hash);
+	}
+
+	//The file path decides the name and the location of the outputs.
+	hash = HashAlgorithms::MurmurHash64(file_path, StringUtilities::StringLength(file_path), hash);
+
+	return hash;
+}
+
 /*
 *	Compiles internally.
 *	Returns if new content was compiled.
@@ -397,6 +511,16 @@ NO_DISCARD bool ContentSystem::CompileInternal(const CompilationDomain compilati
 		asset_compiler->PreCompile(compilation_domain);
 	}
 
+	//Set up the content store.
+	ContentStore content_store;
+
+	{
+		char content_store_directory_path[MAXIMUM_FILE_PATH_LENGTH];
+		sprintf_s(content_store_directory_path, "%s\\..\\ContentStore", compiled_directory);
+
+		content_store.Initialize(content_store_directory_path);
+	}
+
 	//Compile!
 	CompileResult compile_result;
 
@@ -412,8 +536,8 @@ RECOMPILE:
 	compile_result._TriggerRecompile = false;
 
 	//Compile assets.
-	CompileAssetsInDirectory(compilation_domain, &content_cache, assets_directory, nullptr, &compile_result);
-	CompileAssetsInDirectory(compilation_domain, &content_cache, rendering_directory, nullptr, &compile_result);
+	CompileAssetsInDirectory(compilation_domain, &content_cache, &content_store, assets_directory, nullptr, &compile_result);
+	CompileAssetsInDirectory(compilation_domain, &content_cache, &content_store, rendering_directory, nullptr, &compile_result);
 
 	//Wait for all the compile data to finish.
 	while (!_CompileData.Empty())
@@ -426,9 +550,33 @@ RECOMPILE:
 			//Is the compile finished?
 			if (compile_data->_Task.IsExecuted())
 			{
-				//Update the content cache entry.
-				ContentCache::Entry *const RESTRICT content_cache_entry{ content_cache.GetEntry(compile_data->_Context._FilePath.Data()) };
-				content_cache_entry->Update(compile_data->_AssetCompiler->CurrentVersion(), compile_data->_Context._Dependencies);
+				//Leave the content cache entry as it is if the compile failed, so the asset is compiled again next time.
+				if (compile_data->_Context._Failed)
+				{
+					LOG_ERROR("Failed to compile %s!", compile_data->_Context._FilePath.Data());
+				}
+
+				else
+				{
+					//Update the content cache entry. The dependencies are only known after the compile, so the key is calculated now.
+					ContentCache::Entry *const RESTRICT content_cache_entry{ content_cache.GetEntry(compile_data->_Context._FilePath.Data()) };
+
+					content_cache_entry->_Dependencies = compile_data->_Context._Dependencies;
+					content_cache_entry->_Key = content_cache.Key(compile_data->_SourceKey, content_cache_entry->_Dependencies);
+					content_cache_entry->_Outputs.Clear();
+
+					for (const StaticString<MAXIMUM_FILE_PATH_LENGTH> &output : compile_data->_Context._Outputs)
+					{
+						content_cache_entry->_Outputs.Emplace();
+						ContentCache::Entry::Output &new_output{ content_cache_entry->_Outputs.Back() };
+
+						new_output._FilePath = output;
+						new_output._Hash = content_cache.FileHash(output.Data());
+					}
+
+					//Share the outputs through the content store.
+					content_store.Store(compile_data->_SourceKey, *content_cache_entry);
+				}
 
 				//Destroy the compile data.
 				compile_data->~CompileData();
@@ -469,15 +617,23 @@ RECOMPILE:
 		goto RECOMPILE;
 	}
 
-	//Create asset collections if new assets were compiled.
-	if (compile_result._NewAssetsCompiled)
+	//Create asset collections if new assets were compiled, or if the existing ones have an old layout.
+	if (compile_result._NewAssetsCompiled || !AssetCollectionsUpToDate(compiled_directory))
 	{
 		PROFILING_SCOPE("ContentSystem::CreateAssetCollections");
 
-		CreateAssetCollections(compiled_directory, nullptr);
+		CreateAssetCollections(compiled_directory, nullptr, nullptr);
 	}
 
-	LOG_INFORMATION("Compiling content for %s took %f seconds.", domain_name, start_time.GetSecondsSince());
+	LOG_INFORMATION
+	(
+		"Compiling content for %s took %f seconds. %llu assets up to date, %llu restored from the content store, %llu compiled.",
+		domain_name,
+		start_time.GetSecondsSince(),
+		compile_result._NumberOfUpToDateAssets,
+		compile_result._NumberOfRestoredAssets,
+		compile_result._NumberOfCompiledAssets
+	);
 
 	return compile_result._NewAssetsCompiled;
 }
@@ -489,6 +645,7 @@ void ContentSystem::CompileAssetsInDirectory
 (
 	const CompilationDomain compilation_domain,
 	ContentCache *const RESTRICT content_cache,
+	ContentStore *const RESTRICT content_store,
 	const char *const RESTRICT directory_path,
 	const char *const RESTRICT collection,
 	CompileResult *const RESTRICT compile_result
@@ -523,7 +680,7 @@ void ContentSystem::CompileAssetsInDirectory
 				}
 			}
 
-			CompileAssetsInDirectory(compilation_domain, content_cache, entry.path().string().data(), _collection, compile_result);
+			CompileAssetsInDirectory(compilation_domain, content_cache, content_store, entry.path().string().data(), _collection, compile_result);
 
 			continue;
 		}
@@ -556,49 +713,78 @@ void ContentSystem::CompileAssetsInDirectory
 		//Retrieve the content cache entry.
 		ContentCache::Entry *const RESTRICT content_cache_entry{ content_cache->GetEntry(file_path.c_str()) };
 
-		//Check if it needs aecompile.
-		if (!TEST_BIT(asset_compiler->_Flags, AssetCompiler::Flags::ALWAYS_COMPILE) && !content_cache_entry->NeedsCompile(asset_compiler->CurrentVersion()))
+		//Calculate the source key, from the contents of the file and everything about how it's compiled.
+		const uint64 source_key{ content_cache->SourceKey(file_path.c_str(), CompileSettingsHash(asset_compiler, compilation_domain, collection, file_path.c_str())) };
+
+		//Check if it needs a compile.
+		bool restored{ false };
+
+		if (!TEST_BIT(asset_compiler->_Flags, AssetCompiler::Flags::ALWAYS_COMPILE))
 		{
-			continue;
-		}
+			//Skip it if neither the asset nor any of it's dependencies have changed since the last compile.
+			if (!content_cache_entry->NeedsCompile(content_cache->Key(source_key, content_cache_entry->_Dependencies)))
+			{
+				++compile_result->_NumberOfUpToDateAssets;
 
-		LOG_INFORMATION("Compiling %s", file_path.data());
+				continue;
+			}
 
-		//Figure out the name.
-		std::string name;
+			//Otherwise, the exact same asset might have been compiled before, in this or another checkout.
+			restored = content_store->Restore(source_key, content_cache, content_cache_entry);
+		}
 
+		if (restored)
 		{
-			const size_t last_slash_position{ file_path.find_last_of("\\") };
-			name = file_path.substr(last_slash_position + 1, file_path.length() - last_slash_position - strlen(extension.c_str()) - 2);
+			LOG_INFORMATION("Restored %s from the content store", file_path.data());
+
+			++compile_result->_NumberOfRestoredAssets;
 		}
 
-		//Allocate the compile data.
-		CompileData *const RESTRICT compile_data{ new (_CompileDataAllocator.Allocate()) CompileData() };
+		else
+		{
+			LOG_INFORMATION("Compiling %s", file_path.data());
 
-		//Set the asset compiler.
-		compile_data->_AssetCompiler = asset_compiler;
+			++compile_result->_NumberOfCompiledAssets;
 
-		//Set up the compile context.
-		compile_data->_Context._CompilationDomain = compilation_domain;
-		compile_data->_Context._Collection = collection;
-		compile_data->_Context._FilePath = file_path.c_str();
-		compile_data->_Context._Name = name.c_str();
+			//Figure out the name.
+			std::string name;
 
-		//Set up the task.
-		compile_data->_Task._Function = [](void *const RESTRICT arguments)
-		{
-			CompileData *const RESTRICT compile_data{ static_cast<CompileData *const RESTRICT>(arguments) };
+			{
+				const size_t last_slash_position{ file_path.find_last_of("\\") };
+				name = file_path.substr(last_slash_position + 1, file_path.length() - last_slash_position - strlen(extension.c_str()) - 2);
+			}
 
-			compile_data->_AssetCompiler->Compile(compile_data->_Context);
-		};
-		compile_data->_Task._Arguments = compile_data;
-		compile_data->_Task._ExecutableOnSameThread = false;
+			//Allocate the compile data.
+			CompileData *const RESTRICT compile_data{ new (_CompileDataAllocator.Allocate()) CompileData() };
 
-		//Execute the task!
-		TaskSystem::Instance->ExecuteTask(Task::Priority::LOW, &compile_data->_Task);
+			//Set the asset compiler.
+			compile_data->_AssetCompiler = asset_compiler;
+
+			//Set up the compile context.
+			compile_data->_Context._CompilationDomain = compilation_domain;
+			compile_data->_Context._Collection = collection;
+			compile_data->_Context._FilePath = file_path.c_str();
+			compile_data->_Context._Name = name.c_str();
+
+			//Set the source key.
+			compile_data->_SourceKey = source_key;
+
+			//Set up the task.
+			compile_data->_Task._Function = [](void *const RESTRICT arguments)
+			{
+				CompileData *const RESTRICT compile_data{ static_cast<CompileData *const RESTRICT>(arguments) };
+
+				compile_data->_AssetCompiler->Compile(compile_data->_Context);
+			};
+			compile_data->_Task._Arguments = compile_data;
+			compile_data->_Task._ExecutableOnSameThread = false;
 
-		//Add the compile data.
-		_CompileData.Emplace(compile_data);
+			//Execute the task!
+			TaskSystem::Instance->ExecuteTask(Task::Priority::LOW, &compile_data->_Task);
+
+			//Add the compile data.
+			_CompileData.Emplace(compile_data);
+		}
 
 		//New asset was compiled!
 		compile_result->_NewAssetsCompiled = true;
@@ -620,7 +806,7 @@ void ContentSystem::CompileAssetsInDirectory
 /*
 *	Creates asset collections from the given directory path.
 */
-void ContentSystem::CreateAssetCollections(const char *const RESTRICT directory_path, BinaryOutputFile *const RESTRICT file) NOEXCEPT
+void ContentSystem::CreateAssetCollections(const char *const RESTRICT directory_path, BinaryOutputFile *const RESTRICT file, uint64 *const RESTRICT file_position) NOEXCEPT
 {
 	for (const auto &entry : std::filesystem::directory_iterator(std::string(directory_path)))
 	{
@@ -656,9 +842,15 @@ void ContentSystem::CreateAssetCollections(const char *const RESTRICT directory_
 
 				//Set up the file.
 				BinaryOutputFile _file{ collection_path };
+
+				//Write the identifier and the version.
+				_file.Write(&ContentSystemConstants::ASSET_COLLECTION_IDENTIFIER, sizeof(uint64));
+				_file.Write(&ContentSystemConstants::ASSET_COLLECTION_VERSION, sizeof(uint64));
+
+				uint64 _file_position{ sizeof(uint64) * 2 };
 				
 				//Call recursively!
-				CreateAssetCollections(_directory_path.c_str(), &_file);
+				CreateAssetCollections(_directory_path.c_str(), &_file, &_file_position);
 
 				//Close the file.
 				_file.Close();
@@ -667,7 +859,7 @@ void ContentSystem::CreateAssetCollections(const char *const RESTRICT directory_
 			else
 			{
 				//Call recursively!
-				CreateAssetCollections(_directory_path.c_str(), file);
+				CreateAssetCollections(_directory_path.c_str(), file, file_position);
 			}
 
 			continue;
@@ -691,15 +883,39 @@ void ContentSystem::CreateAssetCollections(const char *const RESTRICT directory_
 		//Open the input file.
 		BinaryInputFile input_file{ file_path.c_str() };
 
+		//Write the padding.
+		{
+			constexpr byte PADDING[ContentSystemConstants::ASSET_COLLECTION_ALIGNMENT]{ };
+
+			const uint64 entry_position{ AssetCollectionEntryPosition(*file_position) };
+
+			if (entry_position > *file_position)
+			{
+				file->Write(PADDING, entry_position - *file_position);
+			}
+
+			*file_position = entry_position;
+		}
+
 		//Write the file size.
 		const uint64 file_size{ input_file.Size() };
 		file->Write(&file_size, sizeof(uint64));
 
-		//Write the data
-		DynamicArray<byte> input_buffer;
-		input_buffer.Upsize<false>(file_size);
-		input_file.Read(input_buffer.Data(), file_size);
-		file->Write(input_buffer.Data(), file_size);
+		//Write the data. The input file is mapped, so it can be written out directly.
+		if (input_file.IsMapped())
+		{
+			file->Write(input_file.GetMappedData(), file_size);
+		}
+
+		else
+		{
+			DynamicArray<byte> input_buffer;
+			input_buffer.Upsize<false>(file_size);
+			input_file.Read(input_buffer.Data(), file_size);
+			file->Write(input_buffer.Data(), file_size);
+		}
+
+		*file_position += sizeof(uint64) + file_size;
 
 		//Close the input file.
 		input_file.Close();
@@ -17,7 +17,9 @@
 #include <Profiling/Profiling.h>
 
 //Systems.
+#include <Systems/SpatialIndexSystem.h>
 #include <Systems/TaskSystem.h>
+#include <Systems/TransformHierarchySystem.h>
 
 //Entity system constants.
 namespace EntitySystemConstants
@@ -445,6 +447,15 @@ void EntitySystem::ProcessDestructionQueue() NOEXCEPT
 				}
 			}
 
+			/*
+			*	Remove this entity from the transform hierarchy as well.
+			*	This needs to happen while the entity is still alive, as it's memory and identifier can be reused right after they are freed.
+			*/
+			TransformHierarchySystem::Instance->OnEntityDestroyed(queue_item.Get()._Entity);
+
+			//And from the spatial index.
+			SpatialIndexSystem::Instance->RemoveEntity(queue_item.Get()._Entity);
+
 			//Add this entity's identifier to the free list.
 			{
 				SCOPED_LOCK(_EntityIdentifierLock);
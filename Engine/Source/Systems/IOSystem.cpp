@@ -0,0 +1,411 @@
+//Header file.
+#include <Systems/IOSystem.h>
+
+//Concurrency.
+#include <Concurrency/ScopedLock.h>
+
+//File.
+#include <File/Core/BinaryInputFile.h>
+#include <File/Core/BinaryOutputFile.h>
+
+//Profiling.
+#include <Profiling/Profiling.h>
+
+//Systems.
+#include <Systems/LogSystem.h>
+#include <Systems/TaskSystem.h>
+
+//I/O system constants.
+namespace IOSystemConstants
+{
+	constexpr uint64 IDLE_SLEEP_TIME{ 1'000'000 };
+	constexpr uint64 MAXIMUM_COALESCED_READ_SIZE{ 16 * 1'024 * 1'024 };
+}
+
+/*
+*	Returns the time left until the given request's deadline, in seconds. Requests without a deadline never run out of time.
+*/
+FORCE_INLINE static NO_DISCARD float32 TimeLeft(const IORequest *const RESTRICT request) NOEXCEPT
+{
+	if (request->_Deadline <= 0.0f)
+	{
+		return FLOAT32_MAXIMUM;
+	}
+
+	return request->_Deadline - static_cast<float32>(request->_SubmissionTime.GetSecondsSince());
+}
+
+/*
+*	Returns if request A, with the given time left, is more urgent than request B, with the given time left.
+*	Ties aren't more urgent, so whichever request was submitted first wins those.
+*/
+FORCE_INLINE static NO_DISCARD bool IsMoreUrgent(const IORequest *const RESTRICT A, const float32 A_time_left, const IORequest *const RESTRICT B, const float32 B_time_left) NOEXCEPT
+{
+	//Requests that have missed their deadline come first, there's no catching up with those.
+	const bool A_missed_deadline{ A_time_left <= 0.0f };
+	const bool B_missed_deadline{ B_time_left <= 0.0f };
+
+	if (A_missed_deadline != B_missed_deadline)
+	{
+		return A_missed_deadline;
+	}
+
+	if (A->_Priority != B->_Priority)
+	{
+		return A->_Priority > B->_Priority;
+	}
+
+	return A_time_left < B_time_left;
+}
+
+/*
+*	Returns if the given request is a read that can be coalesced with other reads.
+*/
+FORCE_INLINE static NO_DISCARD bool IsCoalescable(const IORequest *const RESTRICT request) NOEXCEPT
+{
+	return request->_Type == IORequest::Type::READ && request->_Size != IORequest::WHOLE_FILE;
+}
+
+/*
+*	Initializes the I/O system.
+*/
+void IOSystem::Initialize() NOEXCEPT
+{
+	//The I/O threads should start running right away.
+	_IsRunning.Set();
+
+	//Launch the I/O threads.
+	for (Thread &thread : _Threads)
+	{
+		thread.SetFunction([]() { IOSystem::Instance->Execute(); });
+		thread.SetPriority(Thread::Priority::ABOVE_NORMAL);
+#if !defined(CATALYST_CONFIGURATION_FINAL)
+		thread.SetName("I/O System - I/O Thread");
+#endif
+
+		thread.Launch();
+	}
+}
+
+/*
+*	Terminates the I/O system.
+*/
+void IOSystem::Terminate() NOEXCEPT
+{
+	//Tell the I/O threads to stop running. Once this is cleared, new requests are carried out on the submitting thread instead.
+	{
+		SCOPED_LOCK(_PendingRequestsLock);
+
+		_IsRunning.Clear();
+	}
+
+	//Join the I/O threads.
+	for (Thread &thread : _Threads)
+	{
+		thread.Join();
+	}
+
+	//Carry out whatever requests are left, so that nothing submitted before termination is lost.
+	DynamicArray<IORequest *RESTRICT> requests;
+
+	while (ProcessNextRequests(&requests));
+}
+
+/*
+*	Submits a request.
+*/
+void IOSystem::Submit(IORequest *const RESTRICT request) NOEXCEPT
+{
+	ASSERT(request->IsCompleted(), "Submitting a request that is still in flight!");
+	ASSERT(request->_Type == IORequest::Type::READ || request->_Size != IORequest::WHOLE_FILE, "Writes need an explicit size!");
+
+	request->_IsCompleted.Clear();
+	request->_BytesTransferred = 0;
+	request->_Succeeded = false;
+	request->_SubmissionTime.Reset();
+
+	//Hand the request over to the I/O threads, if they're running.
+	{
+		SCOPED_LOCK(_PendingRequestsLock);
+
+		if (_IsRunning.IsSet())
+		{
+			_PendingRequests.Emplace(request);
+
+			return;
+		}
+	}
+
+	//Otherwise, carry it out right away.
+	DynamicArray<IORequest *RESTRICT> requests;
+	requests.Emplace(request);
+
+	Process(requests);
+}
+
+/*
+*	Executes on an I/O thread.
+*/
+void IOSystem::Execute() NOEXCEPT
+{
+	//Initialize the thread index.
+	Concurrency::CurrentThread::InitializeIndex();
+
+	DynamicArray<IORequest *RESTRICT> requests;
+
+	while (_IsRunning.IsSet())
+	{
+		//If there were no requests, sleep for some time. (:
+		if (!ProcessNextRequests(&requests))
+		{
+			Concurrency::CurrentThread::SleepFor(IOSystemConstants::IDLE_SLEEP_TIME);
+		}
+	}
+}
+
+/*
+*	Takes the next requests out of the pending requests and carries them out. Returns if there were any.
+*/
+NO_DISCARD bool IOSystem::ProcessNextRequests(DynamicArray<IORequest *RESTRICT> *const RESTRICT requests) NOEXCEPT
+{
+	requests->Clear();
+
+	if (!TakeRequests(requests))
+	{
+		return false;
+	}
+
+	//Remember which file this was, as the requests are free to be destroyed once they're completed.
+	const StaticString<MAXIMUM_FILE_PATH_LENGTH> file_path{ requests->At(0)->_FilePath };
+	const bool is_being_written{ requests->At(0)->_Type == IORequest::Type::WRITE };
+
+	Process(*requests);
+
+	//The file is no longer busy.
+	{
+		SCOPED_LOCK(_PendingRequestsLock);
+
+		for (uint64 i{ 0 }; i < _BusyFiles.Size(); ++i)
+		{
+			if (_BusyFiles[i]._IsBeingWritten == is_being_written && _BusyFiles[i]._FilePath == file_path.Data())
+			{
+				_BusyFiles.EraseAt<false>(i);
+
+				break;
+			}
+		}
+	}
+
+	return true;
+}
+
+/*
+*	Returns if the given request conflicts with any of the busy files.
+*/
+NO_DISCARD bool IOSystem::IsBlocked(const IORequest *const RESTRICT request) const NOEXCEPT
+{
+	for (const BusyFile &busy_file : _BusyFiles)
+	{
+		if ((busy_file._IsBeingWritten || request->_Type == IORequest::Type::WRITE) && busy_file._FilePath == request->_FilePath.Data())
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/*
+*	Takes the next requests to carry out out of the pending requests. Returns if there were any.
+*	The first request is the most urgent one, followed by any reads it could be coalesced with, in file order.
+*/
+NO_DISCARD bool IOSystem::TakeRequests(DynamicArray<IORequest *RESTRICT> *const RESTRICT requests) NOEXCEPT
+{
+	SCOPED_LOCK(_PendingRequestsLock);
+
+	//Find the most urgent request that isn't blocked. The pending requests are kept in submission order, so a linear scan keeps ties first come, first served.
+	uint64 most_urgent_index{ UINT64_MAXIMUM };
+	float32 most_urgent_time_left{ 0.0f };
+
+	for (uint64 i{ 0 }; i < _PendingRequests.Size(); ++i)
+	{
+		if (IsBlocked(_PendingRequests[i]))
+		{
+			continue;
+		}
+
+		const float32 time_left{ TimeLeft(_PendingRequests[i]) };
+
+		if (most_urgent_index == UINT64_MAXIMUM || IsMoreUrgent(_PendingRequests[i], time_left, _PendingRequests[most_urgent_index], most_urgent_time_left))
+		{
+			most_urgent_index = i;
+			most_urgent_time_left = time_left;
+		}
+	}
+
+	if (most_urgent_index == UINT64_MAXIMUM)
+	{
+		return false;
+	}
+
+	IORequest *const RESTRICT most_urgent_request{ _PendingRequests[most_urgent_index] };
+
+	requests->Emplace(most_urgent_request);
+	_PendingRequests.EraseAt<true>(most_urgent_index);
+
+	//Mark the file as busy.
+	_BusyFiles.Emplace();
+	_BusyFiles.Back()._FilePath = most_urgent_request->_FilePath;
+	_BusyFiles.Back()._IsBeingWritten = most_urgent_request->_Type == IORequest::Type::WRITE;
+
+	if (!IsCoalescable(most_urgent_request))
+	{
+		return true;
+	}
+
+	//Coalesce reads of the same file that pick up where the previous one leaves off.
+	uint64 current_end{ most_urgent_request->End() };
+	uint64 coalesced_size{ most_urgent_request->_Size };
+
+	for (uint64 i{ 0 }; i < _PendingRequests.Size();)
+	{
+		IORequest *const RESTRICT request{ _PendingRequests[i] };
+
+		if (IsCoalescable(request)
+			&& request->_Offset == current_end
+			&& coalesced_size + request->_Size <= IOSystemConstants::MAXIMUM_COALESCED_READ_SIZE
+			&& request->_FilePath == most_urgent_request->_FilePath.Data())
+		{
+			requests->Emplace(request);
+			_PendingRequests.EraseAt<true>(i);
+
+			current_end = request->End();
+			coalesced_size += request->_Size;
+
+			//A request that was passed over before might continue from the new end, so start over.
+			i = 0;
+		}
+
+		else
+		{
+			++i;
+		}
+	}
+
+	return true;
+}
+
+/*
+*	Carries out the given requests.
+*/
+void IOSystem::Process(const DynamicArray<IORequest *RESTRICT> &requests) NOEXCEPT
+{
+	PROFILING_SCOPE("IOSystem::Process");
+
+	IORequest *const RESTRICT first_request{ requests[0] };
+
+	//Writes are never coalesced, and replace the file.
+	if (first_request->_Type == IORequest::Type::WRITE)
+	{
+		BinaryOutputFile file{ first_request->_FilePath.Data() };
+
+		if (!file)
+		{
+			LOG_ERROR("Couldn't open %s for writing!", first_request->_FilePath.Data());
+
+			Complete(first_request);
+
+			return;
+		}
+
+		file.Write(first_request->_Buffer, first_request->_Size);
+
+		//Closing flushes whatever is still buffered, so the write has only gone through if the file is still fine after that.
+		file.Close();
+
+		if (!file)
+		{
+			LOG_ERROR("Couldn't write %llu bytes to %s!", static_cast<unsigned long long>(first_request->_Size), first_request->_FilePath.Data());
+
+			Complete(first_request);
+
+			return;
+		}
+
+		first_request->_BytesTransferred = first_request->_Size;
+		first_request->_Succeeded = true;
+
+		Complete(first_request);
+
+		return;
+	}
+
+	//Coalesced reads are contiguous and in file order, so the file only needs to be opened and seeked once.
+	BinaryInputFile file{ first_request->_FilePath.Data() };
+
+	if (!file)
+	{
+		LOG_ERROR("Couldn't open %s for reading!", first_request->_FilePath.Data());
+
+		for (IORequest *const RESTRICT request : requests)
+		{
+			Complete(request);
+		}
+
+		return;
+	}
+
+	const uint64 file_size{ file.Size() };
+
+	if (first_request->_Offset < file_size)
+	{
+		file.SetCurrentPosition(first_request->_Offset);
+	}
+
+	for (IORequest *const RESTRICT request : requests)
+	{
+		const uint64 available_size{ request->_Offset < file_size ? file_size - request->_Offset : 0 };
+		const uint64 size{ request->_Size == IORequest::WHOLE_FILE ? available_size : request->_Size };
+
+		//Reads past the end of the file fail, and so will every read after them.
+		if (size > available_size)
+		{
+			Complete(request);
+
+			continue;
+		}
+
+		if (!request->_Buffer)
+		{
+			request->_Buffer = Memory::Allocate(size);
+		}
+
+		file.Read(request->_Buffer, size);
+
+		request->_BytesTransferred = size;
+		request->_Succeeded = true;
+
+		Complete(request);
+	}
+
+	file.Close();
+}
+
+/*
+*	Completes the given request.
+*/
+void IOSystem::Complete(IORequest *const RESTRICT request) NOEXCEPT
+{
+	if (request->_Callback)
+	{
+		request->_Callback(request);
+	}
+
+	if (request->_Continuation)
+	{
+		TaskSystem::Instance->ExecuteTask(Task::Priority::LOW, request->_Continuation);
+	}
+
+	//Completing the request has to come last, as the owner is free to reuse or destroy it from here on.
+	request->_IsCompleted.Set();
+}
\ No newline at end of file
@@ -1,11 +1,171 @@
 //Header file.
 #include <Systems/LevelSystem.h>
 
+//Core.
+#include <Core/Algorithms/SortingAlgorithms.h>
+
 //Entities.
 #include <Entities/Core/EntitySerialization.h>
 
+//Math.
+#include <Math/Core/BaseMath.h>
+
+//Profiling.
+#include <Profiling/Profiling.h>
+
 //Systems.
 #include <Systems/EntitySystem.h>
+#include <Systems/TaskSystem.h>
+#include <Systems/WorldSystem.h>
+
+//World.
+#include <World/Core/WorldPosition.h>
+
+/*
+*	Returns the distance between the two given cells, in cells.
+*/
+FORCE_INLINE static NO_DISCARD uint32 CellDistance(const Vector3<int32> &A, const Vector3<int32> &B) NOEXCEPT
+{
+	return static_cast<uint32>
+	(
+		BaseMath::Maximum<int32>
+		(
+			BaseMath::Maximum<int32>(BaseMath::Absolute<int32>(A._X - B._X), BaseMath::Absolute<int32>(A._Y - B._Y)),
+			BaseMath::Absolute<int32>(A._Z - B._Z)
+		)
+	);
+}
+
+/*
+*	Initializes the level system.
+*/
+void LevelSystem::Initialize() NOEXCEPT
+{
+	//Initialize the streaming task.
+	_StreamingTask._Function = [](void *const RESTRICT)
+	{
+		LevelSystem::Instance->ProcessStreamingWork();
+	};
+	_StreamingTask._Arguments = nullptr;
+	_StreamingTask._ExecutableOnSameThread = false;
+}
+
+/*
+*	Updates the level system during the given update phase.
+*/
+void LevelSystem::Update(const UpdatePhase phase) NOEXCEPT
+{
+	//Nothing to do if no levels are streaming. The cells are only touched by the streaming task while it's executing, so wait for the last batch to finish as well.
+	if (_StreamedLevels.Empty() || !_StreamingTask.IsExecuted())
+	{
+		return;
+	}
+
+	PROFILING_SCOPE("LevelSystem::Update");
+
+	const Vector3<int32> camera_cell{ WorldSystem::Instance->GetCurrentWorldGridCell() };
+
+	//Go over all cells, moving them in and out of the load and unload rings.
+	_StreamingWork.Clear();
+
+	_StreamingStatistics._NumberOfResidentCells = 0;
+	_StreamingStatistics._NumberOfResidentEntities = 0;
+	_StreamingStatistics._ResidentMemory = 0;
+
+	for (StreamedLevel *const RESTRICT level : _StreamedLevels)
+	{
+		for (uint64 cell_index{ 0 }; cell_index < level->_Cells.Size(); ++cell_index)
+		{
+			StreamedLevel::Cell &cell{ level->_Cells[cell_index] };
+			const LevelAsset::Cell &asset_cell{ level->_LevelAsset->_Cells[cell_index] };
+
+			const uint32 distance{ asset_cell._AlwaysResident ? 0 : CellDistance(cell._WorldCell, camera_cell) };
+
+			switch (cell._State)
+			{
+				case StreamedLevel::CellState::UNLOADED:
+				{
+					if (distance <= _LoadRadius)
+					{
+						cell._State = StreamedLevel::CellState::SPAWNING;
+					}
+
+					break;
+				}
+
+				case StreamedLevel::CellState::SPAWNING:
+				case StreamedLevel::CellState::RESIDENT:
+				{
+					if (distance > _UnloadRadius)
+					{
+						cell._State = StreamedLevel::CellState::DESPAWNING;
+					}
+
+					break;
+				}
+
+				case StreamedLevel::CellState::DESPAWNING:
+				{
+					//Let despawning finish, the cell will be picked up again afterwards if the camera comes back.
+					break;
+				}
+
+				default:
+				{
+					ASSERT(false, "Invalid case!");
+
+					break;
+				}
+			}
+
+			if (cell._State == StreamedLevel::CellState::SPAWNING || cell._State == StreamedLevel::CellState::DESPAWNING)
+			{
+				_StreamingWork.Emplace();
+				StreamingWork &work{ _StreamingWork.Back() };
+
+				work._Level = level;
+				work._CellIndex = cell_index;
+				work._Distance = distance;
+			}
+
+			else if (cell._State == StreamedLevel::CellState::RESIDENT)
+			{
+				++_StreamingStatistics._NumberOfResidentCells;
+				_StreamingStatistics._NumberOfResidentEntities += cell._Entities.Size();
+				_StreamingStatistics._ResidentMemory += asset_cell._StreamArchiveSize;
+			}
+		}
+	}
+
+	_StreamingStatistics._NumberOfPendingCells = _StreamingWork.Size();
+
+	if (_StreamingWork.Empty())
+	{
+		return;
+	}
+
+	//Despawn first to free up memory, then spawn the cells closest to the camera first.
+	SortingAlgorithms::StandardSort<StreamingWork>
+	(
+		_StreamingWork.Begin(),
+		_StreamingWork.End(),
+		nullptr,
+		[](const void *const RESTRICT, const StreamingWork *const RESTRICT first, const StreamingWork *const RESTRICT second)
+		{
+			const bool first_is_despawning{ first->_Level->_Cells[first->_CellIndex]._State == StreamedLevel::CellState::DESPAWNING };
+			const bool second_is_despawning{ second->_Level->_Cells[second->_CellIndex]._State == StreamedLevel::CellState::DESPAWNING };
+
+			if (first_is_despawning != second_is_despawning)
+			{
+				return first_is_despawning;
+			}
+
+			return first->_Distance < second->_Distance;
+		}
+	);
+
+	TaskSystem::Instance->ExecuteTask(Task::Priority::LOW, &_StreamingTask);
+}
 
 /*
 *	Spawns a level.
@@ -36,47 +196,8 @@ void LevelSystem::SpawnLevel
 	//Add all the entities.
 	for (uint64 entity_index{ 0 }; entity_index < number_of_entities; ++entity_index)
 	{
-		//Add a new entity.
-		level->_Entities.Emplace();
-		Entity *RESTRICT &new_entity{ level->_Entities.Back() };
-
-		//Read the entity identifier.
 		entity_identifiers.Emplace();
-		level_asset->_StreamArchive.Read(&entity_identifiers.Back(), sizeof(uint64), &stream_archive_position);
-
-		//Deserialize the entitiy.
-		struct DeserializeFunctionUserData
-		{
-			SpawnFunction _SpawnFunction;
-			uint64 _EntityIdentifier;
-			void *const RESTRICT _UserData;
-		} deserialize_function_user_data
-		{
-			spawn_function,
-			entity_identifiers.Back(),
-			spawn_function_user_data
-		};
-
-		new_entity = EntitySerialization::DeserializeFromStreamArchive
-		(
-			level_asset->_StreamArchive,
-			&stream_archive_position,
-			&world_transform,
-			[]
-			(
-				ComponentInitializationData *const RESTRICT initialization_data,
-				void *const RESTRICT user_data
-			)
-			{
-				DeserializeFunctionUserData *const RESTRICT _user_data{ static_cast<DeserializeFunctionUserData *const RESTRICT>(user_data) };
-
-				if (_user_data->_SpawnFunction)
-				{
-					_user_data->_SpawnFunction(initialization_data, _user_data->_EntityIdentifier, _user_data->_UserData);
-				}
-			},
-			&deserialize_function_user_data
-		);
+		level->_Entities.Emplace(SpawnEntity(world_transform, *level_asset.Get(), &stream_archive_position, &entity_identifiers.Back(), spawn_function, spawn_function_user_data));
 	}
 
 	//Read the number of entity linkts.
@@ -124,4 +245,236 @@ void LevelSystem::DespawnLevel(Level *const RESTRICT level) NOEXCEPT
 	}
 
 	level->_Entities.Clear();
+}
+
+/*
+*	Starts streaming a level.
+*	Instead of spawning everything at once, the level's cells are spawned when the camera comes within the load radius of them,
+*	and despawned when it moves beyond the unload radius, in time budgeted batches on a background task.
+*/
+void LevelSystem::StartStreamingLevel
+(
+	const WorldTransform &world_transform,
+	const AssetPointer<LevelAsset> level_asset,
+	StreamedLevel *const RESTRICT level,
+	SpawnFunction spawn_function,
+	void *const RESTRICT spawn_function_user_data
+) NOEXCEPT
+{
+	level->_WorldTransform = world_transform;
+	level->_LevelAsset = level_asset;
+	level->_SpawnFunction = spawn_function;
+	level->_SpawnFunctionUserData = spawn_function_user_data;
+
+	//Figure out which world grid cell each cell ends up in, once the world transform is applied.
+	const float32 world_grid_size{ WorldSystem::Instance->GetWorldGridSize() };
+
+	level->_Cells.Clear();
+	level->_Cells.Reserve(level_asset->_Cells.Size());
+
+	for (const LevelAsset::Cell &asset_cell : level_asset->_Cells)
+	{
+		level->_Cells.Emplace();
+		StreamedLevel::Cell &cell{ level->_Cells.Back() };
+
+		//World grid cells are centered on their coordinates times the world grid size. The center is transformed the same way the entities' positions are when they are spawned.
+		Vector3<float32> cell_center{ static_cast<float32>(asset_cell._Cell._X), static_cast<float32>(asset_cell._Cell._Y), static_cast<float32>(asset_cell._Cell._Z) };
+		cell_center *= world_grid_size;
+		cell_center *= world_transform.GetScale();
+		cell_center.Rotate(world_transform.GetRotation().ToEulerAngles());
+
+		const WorldPosition world_position{ world_transform.GetCell(), world_transform.GetLocalPosition() + cell_center };
+
+		cell._WorldCell = world_position.GetCell();
+		cell._State = StreamedLevel::CellState::UNLOADED;
+		cell._StreamArchivePosition = asset_cell._StreamArchivePosition;
+	}
+
+	//The cells are only touched by the streaming task while it's executing, so wait for it before adding the level.
+	_StreamingTask.Wait<WaitMode::YIELD>();
+
+	_StreamedLevels.Emplace(level);
+}
+
+/*
+*	Stops streaming the given level, despawning all of it.
+*/
+void LevelSystem::StopStreamingLevel(StreamedLevel *const RESTRICT level) NOEXCEPT
+{
+	//The cells are only touched by the streaming task while it's executing, so wait for it before removing the level.
+	_StreamingTask.Wait<WaitMode::YIELD>();
+
+	for (uint64 i{ 0 }; i < _StreamedLevels.Size(); ++i)
+	{
+		if (_StreamedLevels[i] == level)
+		{
+			_StreamedLevels.EraseAt<false>(i);
+
+			break;
+		}
+	}
+
+	for (StreamedLevel::Cell &cell : level->_Cells)
+	{
+		for (Entity *const RESTRICT entity : cell._Entities)
+		{
+			EntitySystem::Instance->DestroyEntity(entity);
+		}
+	}
+
+	level->_Cells.Clear();
+}
+
+/*
+*	Spawns the next entity from the given level asset, advancing the stream archive position past it.
+*/
+NO_DISCARD Entity *const RESTRICT LevelSystem::SpawnEntity
+(
+	const WorldTransform &world_transform,
+	const LevelAsset &level_asset,
+	uint64 *const RESTRICT stream_archive_position,
+	uint64 *const RESTRICT entity_identifier,
+	SpawnFunction spawn_function,
+	void *const RESTRICT spawn_function_user_data
+) NOEXCEPT
+{
+	//Read the entity identifier.
+	level_asset._StreamArchive.Read(entity_identifier, sizeof(uint64), stream_archive_position);
+
+	//Deserialize the entitiy.
+	struct DeserializeFunctionUserData
+	{
+		SpawnFunction _SpawnFunction;
+		uint64 _EntityIdentifier;
+		void *const RESTRICT _UserData;
+	} deserialize_function_user_data
+	{
+		spawn_function,
+		*entity_identifier,
+		spawn_function_user_data
+	};
+
+	return EntitySerialization::DeserializeFromStreamArchive
+	(
+		level_asset._StreamArchive,
+		stream_archive_position,
+		&world_transform,
+		[]
+		(
+			ComponentInitializationData *const RESTRICT initialization_data,
+			void *const RESTRICT user_data
+		)
+		{
+			DeserializeFunctionUserData *const RESTRICT _user_data{ static_cast<DeserializeFunctionUserData *const RESTRICT>(user_data) };
+
+			if (_user_data->_SpawnFunction)
+			{
+				_user_data->_SpawnFunction(initialization_data, _user_data->_EntityIdentifier, _user_data->_UserData);
+			}
+		},
+		&deserialize_function_user_data
+	);
+}
+
+/*
+*	Carries out the streaming work, until it's done or the time budget runs out.
+*/
+void LevelSystem::ProcessStreamingWork() NOEXCEPT
+{
+	PROFILING_SCOPE("LevelSystem::ProcessStreamingWork");
+
+	const TimePoint start_time;
+
+	for (const StreamingWork &work : _StreamingWork)
+	{
+		StreamedLevel::Cell &cell{ work._Level->_Cells[work._CellIndex] };
+
+		if (cell._State == StreamedLevel::CellState::SPAWNING)
+		{
+			if (ContinueSpawningCell(work._Level, work._CellIndex, start_time))
+			{
+				cell._State = StreamedLevel::CellState::RESIDENT;
+			}
+		}
+
+		else
+		{
+			if (ContinueDespawningCell(work._Level, work._CellIndex, start_time))
+			{
+				cell._State = StreamedLevel::CellState::UNLOADED;
+			}
+		}
+
+		//Whatever is left is picked up in the next batch.
+		if (start_time.GetSecondsSince() >= _StreamingTimeBudget)
+		{
+			break;
+		}
+	}
+
+	//Update the statistics.
+	_StreamingStatistics._LastBatchDuration = static_cast<float32>(start_time.GetSecondsSince());
+	_StreamingStatistics._LongestBatchDuration = BaseMath::Maximum<float32>(_StreamingStatistics._LongestBatchDuration, _StreamingStatistics._LastBatchDuration);
+}
+
+/*
+*	Continues spawning the given cell. Returns if it is done.
+*/
+NO_DISCARD bool LevelSystem::ContinueSpawningCell(StreamedLevel *const RESTRICT level, const uint64 cell_index, const TimePoint &start_time) NOEXCEPT
+{
+	StreamedLevel::Cell &cell{ level->_Cells[cell_index] };
+	const LevelAsset::Cell &asset_cell{ level->_LevelAsset->_Cells[cell_index] };
+
+	//Spawn at least one entity per batch, so that streaming always makes progress.
+	while (cell._Entities.Size() < asset_cell._NumberOfEntities)
+	{
+		uint64 entity_identifier;
+		cell._Entities.Emplace(SpawnEntity(level->_WorldTransform, *level->_LevelAsset.Get(), &cell._StreamArchivePosition, &entity_identifier, level->_SpawnFunction, level->_SpawnFunctionUserData));
+
+		if (cell._Entities.Size() < asset_cell._NumberOfEntities && start_time.GetSecondsSince() >= _StreamingTimeBudget)
+		{
+			return false;
+		}
+	}
+
+	//Set up the entity links within this cell. The level asset groups them by cell, so only this cell's links are read.
+	uint64 stream_archive_position{ asset_cell._EntityLinksPosition };
+
+	for (uint64 i{ 0 }; i < asset_cell._NumberOfEntityLinks; ++i)
+	{
+		uint64 from_index;
+		level->_LevelAsset->_StreamArchive.Read(&from_index, sizeof(uint64), &stream_archive_position);
+
+		uint64 to_index;
+		level->_LevelAsset->_StreamArchive.Read(&to_index, sizeof(uint64), &stream_archive_position);
+
+		EntitySystem::Instance->GetEntityLinks()->AddLink(cell._Entities[from_index], cell._Entities[to_index]);
+	}
+
+	return true;
+}
+
+/*
+*	Continues despawning the given cell. Returns if it is done.
+*/
+NO_DISCARD bool LevelSystem::ContinueDespawningCell(StreamedLevel *const RESTRICT level, const uint64 cell_index, const TimePoint &start_time) NOEXCEPT
+{
+	StreamedLevel::Cell &cell{ level->_Cells[cell_index] };
+
+	while (!cell._Entities.Empty())
+	{
+		EntitySystem::Instance->DestroyEntity(cell._Entities.Back());
+
+		cell._Entities.Pop();
+
+		if (!cell._Entities.Empty() && start_time.GetSecondsSince() >= _StreamingTimeBudget)
+		{
+			return false;
+		}
+	}
+
+	//Rewind, so the cell can be spawned again later.
+	cell._StreamArchivePosition = level->_LevelAsset->_Cells[cell_index]._StreamArchivePosition;
+
+	return true;
 }
\ No newline at end of file
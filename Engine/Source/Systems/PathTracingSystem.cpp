@@ -656,7 +656,7 @@ NO_DISCARD Vector3<float32> PathTracingSystem::CastRadianceRay(const Ray &ray, c
 					light_distance = distance_to_light;
 
 					//Set the attenuation.
-					attenuation = 1.0f / distance_to_light;
+					attenuation = 1.0f / (distance_to_light * distance_to_light + 1.0f);
 
 					break;
 				}
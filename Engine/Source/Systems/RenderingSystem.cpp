@@ -1014,6 +1014,16 @@ void RenderingSystem::UploadDataToBuffer(const void *const RESTRICT *const RESTR
 	_SubRenderingSystem->UploadDataToBuffer(data, data_sizes, data_chunks, handle);
 }
 
+/*
+*	Maps a host visible buffer and returns a pointer to it's memory.
+*	The mapping is persistent, and stays valid until the buffer is destroyed.
+*	Returns nullptr if the backend can't map buffers, in which case data needs to go through UploadDataToBuffer() instead.
+*/
+RESTRICTED NO_DISCARD void *const RESTRICT RenderingSystem::MapBuffer(const BufferHandle handle) const NOEXCEPT
+{
+	return _SubRenderingSystem->MapBuffer(handle);
+}
+
 /*
 *	Destroys a buffer.
 */
@@ -1299,6 +1309,22 @@ void RenderingSystem::UpdateTexture2D(const TextureDataContainer &texture_data_c
 	_SubRenderingSystem->UpdateTexture2D(texture_data_container, handle);
 }
 
+/*
+*	Updates a region of a texture 2D, copying the given rectangle of the first mip level from the given texture data, which covers the whole texture.
+*/
+void RenderingSystem::UpdateTexture2DRegion
+(
+	const TextureDataContainer &texture_data_container,
+	const uint32 X,
+	const uint32 Y,
+	const uint32 width,
+	const uint32 height,
+	Texture2DHandle *const RESTRICT handle
+) NOEXCEPT
+{
+	_SubRenderingSystem->UpdateTexture2DRegion(texture_data_container, X, Y, width, height, handle);
+}
+
 /*
 *	Destroys a texture 2D.
 */
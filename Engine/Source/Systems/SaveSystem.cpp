@@ -11,6 +11,8 @@
 
 //Systems.
 #include <Systems/CatalystEngineSystem.h>
+#include <Systems/IOSystem.h>
+#include <Systems/LogSystem.h>
 #include <Systems/TaskSystem.h>
 
 /*
@@ -42,8 +44,17 @@ void SaveSystem::Initialize() NOEXCEPT
 */
 void SaveSystem::SequentialUpdate() NOEXCEPT
 {
-	//Check if any saves have been requested, and if the task is not executing. If so, fire it off!
-	if ((_RequestedLoadsMask != 0 || _RequestedSavesMask != 0) && _ProcessSavesTask.IsExecuted())
+	//The write requests are only touched by the process saves task while it's executing.
+	if (!_ProcessSavesTask.IsExecuted())
+	{
+		return;
+	}
+
+	//Free the write requests that are completed.
+	FreeWriteRequests(false);
+
+	//Check if any saves have been requested. If so, fire off the task!
+	if (_RequestedLoadsMask != 0 || _RequestedSavesMask != 0)
 	{
 		_ProcessLoadsMask = _RequestedLoadsMask;
 		_RequestedLoadsMask = 0;
@@ -65,6 +76,9 @@ void SaveSystem::Terminate() NOEXCEPT
 	_ProcessSavesMask = UINT64_MAXIMUM;
 
 	ProcessSaves();
+
+	//Wait for all writes to finish.
+	FreeWriteRequests(true);
 }
 
 /*
@@ -102,6 +116,12 @@ void SaveSystem::RequestSave(const uint64 save_mask) NOEXCEPT
 */
 void SaveSystem::ProcessSaves() NOEXCEPT
 {
+	//Loads need to see the results of previous saves, so wait for those to be written first.
+	if (_ProcessLoadsMask != 0)
+	{
+		FreeWriteRequests(true);
+	}
+
 	//Go over all save entries, checking if they need to be saved or loaded.
 	for (const SaveEntry &entry : _SaveEntries)
 	{
@@ -119,7 +139,34 @@ void SaveSystem::ProcessSaves() NOEXCEPT
 	}
 }
 
+/*
+*	Frees the write requests that are completed. Optionally waits for all of them to be completed first.
+*/
+void SaveSystem::FreeWriteRequests(const bool wait) NOEXCEPT
+{
+	for (uint64 i{ 0 }; i < _WriteRequests.Size();)
+	{
+		IORequest *const RESTRICT request{ _WriteRequests[i] };
+
+		if (wait)
+		{
+			request->Wait<WaitMode::YIELD>();
+		}
+
+		if (request->IsCompleted())
+		{
+			request->~IORequest();
+			Memory::Free(request);
+
+			_WriteRequests.EraseAt<false>(i);
+		}
 
+		else
+		{
+			++i;
+		}
+	}
+}
 
 /*
 *	Loads a single entry.
@@ -193,26 +240,39 @@ void SaveSystem::LoadSingleEntry(const SaveEntry &entry) NOEXCEPT
 */
 void SaveSystem::SaveSingleEntry(const SaveEntry &entry) NOEXCEPT
 {
-	//Construct the save header.
-	SaveHeader save_header;
-
-	save_header._Version = entry._CurrentVersionCallback();
-
 	//Determine the size required for the save.
 	const uint64 size{ entry._SaveSizeCallback() };
 
-	//Allocate the memory required for the save.
-	void *const RESTRICT save_data{ Memory::Allocate(size) };
+	//Allocate the memory required for the save, with the save header in front, so it can be written in one go.
+	void *const RESTRICT save_data{ Memory::Allocate(sizeof(SaveHeader) + size) };
+
+	//Construct the save header.
+	SaveHeader *const RESTRICT save_header{ static_cast<SaveHeader *const RESTRICT>(save_data) };
+
+	save_header->_Version = entry._CurrentVersionCallback();
 
 	//Call the save callback.
-	entry._SaveCallback(save_data);
+	entry._SaveCallback(AdvancePointer(save_data, sizeof(SaveHeader)));
+
+	//Write it to file in the background. The memory is freed once it's written.
+	IORequest *const RESTRICT request{ new (Memory::Allocate(sizeof(IORequest))) IORequest() };
+
+	request->_Type = IORequest::Type::WRITE;
+	request->_Priority = IORequest::Priority::LOW;
+	request->_FilePath = entry._FilePath.Data();
+	request->_Size = sizeof(SaveHeader) + size;
+	request->_Buffer = save_data;
+	request->_Callback = [](IORequest *const RESTRICT completed_request)
+	{
+		if (!completed_request->_Succeeded)
+		{
+			LOG_ERROR("Failed to save %s!", completed_request->_FilePath.Data());
+		}
+
+		Memory::Free(completed_request->_Buffer);
+	};
 
-	//Write it to file.
-	BinaryOutputFile file{ entry._FilePath.Data() };
-	file.Write(&save_header, sizeof(SaveHeader));
-	file.Write(save_data, size);
-	file.Close();
+	_WriteRequests.Emplace(request);
 
-	//Free the memory.
-	Memory::Free(save_data);
+	IOSystem::Instance->Submit(request);
 }
\ No newline at end of file
@@ -0,0 +1,849 @@
+//Header file.
+#include <Systems/SpatialIndexSystem.h>
+
+//Components.
+#include <Components/Components/StaticModelComponent.h>
+#include <Components/Components/WorldTransformComponent.h>
+
+//Core.
+#include <Core/Algorithms/SortingAlgorithms.h>
+
+//Concurrency.
+#include <Concurrency/ScopedReadLock.h>
+#include <Concurrency/ScopedWriteLock.h>
+
+//Math.
+#include <Math/Core/CatalystGeometryMath.h>
+#include <Math/Geometry/Ray.h>
+
+//Profiling.
+#include <Profiling/Profiling.h>
+
+//Rendering.
+#include <Rendering/Native/Culling.h>
+
+//Systems.
+#include <Systems/TaskSystem.h>
+#include <Systems/WorldSystem.h>
+
+//Spatial index system constants.
+namespace SpatialIndexSystemConstants
+{
+	//The bucket size of the lowest level. Each level above it has buckets four times as large.
+	constexpr float64 BASE_BUCKET_SIZE{ 8.0 };
+
+	//The number of world transform instances each gather range goes through.
+	constexpr uint64 INSTANCES_PER_GATHER_RANGE{ 4'096 };
+
+	//The number of queries each parallel index answers.
+	constexpr uint64 QUERIES_PER_INDEX{ 64 };
+
+	//The number of empty buckets to allow before compacting them away, as long as they make up less than half of all buckets.
+	constexpr uint64 MAXIMUM_NUMBER_OF_EMPTY_BUCKETS{ 1'024 };
+
+	//The radius nearest queries start searching within, before widening the search.
+	constexpr float32 INITIAL_NEAREST_RADIUS{ 16.0f };
+}
+
+/*
+*	Returns the bucket size of the given level.
+*/
+FORCE_INLINE static NO_DISCARD float64 BucketSize(const uint8 level) NOEXCEPT
+{
+	return SpatialIndexSystemConstants::BASE_BUCKET_SIZE * static_cast<float64>(1ull << (level * 2));
+}
+
+/*
+*	Returns the given number rounded down to the closest integer.
+*/
+FORCE_INLINE static NO_DISCARD int64 FloorToInt64(const float64 number) NOEXCEPT
+{
+	const int64 truncated{ static_cast<int64>(number) };
+
+	return number < static_cast<float64>(truncated) ? truncated - 1 : truncated;
+}
+
+/*
+*	Returns the given position, relative to the given cell, as an absolute position in double precision.
+*/
+FORCE_INLINE static NO_DISCARD Vector3<float64> ToAbsolute(const Vector3<int32> &cell, const Vector3<float32> &position, const float64 world_grid_size) NOEXCEPT
+{
+	return Vector3<float64>
+	(
+		static_cast<float64>(cell._X) * world_grid_size + static_cast<float64>(position._X),
+		static_cast<float64>(cell._Y) * world_grid_size + static_cast<float64>(position._Y),
+		static_cast<float64>(cell._Z) * world_grid_size + static_cast<float64>(position._Z)
+	);
+}
+
+/*
+*	Returns the loose box of the bucket with the given level and coordinates, relative to the given cell.
+*/
+FORCE_INLINE static NO_DISCARD AxisAlignedBoundingBox3D LooseBucketBox(const uint8 level, const Vector3<int64> &coordinates, const Vector3<int32> &cell, const float64 world_grid_size) NOEXCEPT
+{
+	const float64 bucket_size{ BucketSize(level) };
+	const Vector3<float64> cell_origin{ ToAbsolute(cell, Vector3<float32>(0.0f, 0.0f, 0.0f), world_grid_size) };
+
+	AxisAlignedBoundingBox3D box;
+
+	box._Minimum._X = static_cast<float32>(static_cast<float64>(coordinates._X) * bucket_size - bucket_size * 0.5 - cell_origin._X);
+	box._Minimum._Y = static_cast<float32>(static_cast<float64>(coordinates._Y) * bucket_size - bucket_size * 0.5 - cell_origin._Y);
+	box._Minimum._Z = static_cast<float32>(static_cast<float64>(coordinates._Z) * bucket_size - bucket_size * 0.5 - cell_origin._Z);
+	box._Maximum._X = static_cast<float32>(static_cast<float64>(coordinates._X + 1) * bucket_size + bucket_size * 0.5 - cell_origin._X);
+	box._Maximum._Y = static_cast<float32>(static_cast<float64>(coordinates._Y + 1) * bucket_size + bucket_size * 0.5 - cell_origin._Y);
+	box._Maximum._Z = static_cast<float32>(static_cast<float64>(coordinates._Z + 1) * bucket_size + bucket_size * 0.5 - cell_origin._Z);
+
+	return box;
+}
+
+/*
+*	Updates the spatial index system.
+*/
+void SpatialIndexSystem::Update(const UpdatePhase phase) NOEXCEPT
+{
+	PROFILING_SCOPE("SpatialIndexSystem::Update");
+
+	//Gather what needs updating. This only reads the index, so queries can carry on in the meantime.
+	const uint64 number_of_instances{ WorldTransformComponent::Instance->NumberOfInstances() };
+	const uint64 number_of_gather_ranges{ (number_of_instances + SpatialIndexSystemConstants::INSTANCES_PER_GATHER_RANGE - 1) / SpatialIndexSystemConstants::INSTANCES_PER_GATHER_RANGE };
+
+	if (_GatherRanges.Size() < number_of_gather_ranges)
+	{
+		_GatherRanges.Resize<true>(number_of_gather_ranges);
+	}
+
+	for (uint64 range_index{ 0 }; range_index < number_of_gather_ranges; ++range_index)
+	{
+		GatherRange &gather_range{ _GatherRanges[range_index] };
+
+		gather_range._FirstInstanceIndex = range_index * SpatialIndexSystemConstants::INSTANCES_PER_GATHER_RANGE;
+		gather_range._LastInstanceIndex = BaseMath::Minimum<uint64>(gather_range._FirstInstanceIndex + SpatialIndexSystemConstants::INSTANCES_PER_GATHER_RANGE, number_of_instances);
+		gather_range._PendingUpdates.Clear();
+	}
+
+	TaskSystem::ParallelFor
+	(
+		Task::Priority::HIGH,
+		static_cast<uint32>(number_of_gather_ranges),
+		[](void *const RESTRICT arguments, const uint32 index)
+		{
+			SpatialIndexSystem::Instance->GatherPendingUpdates(&static_cast<GatherRange *const RESTRICT>(arguments)[index]);
+		},
+		_GatherRanges.Data()
+	);
+
+	//Now apply everything in one go.
+	SCOPED_WRITE_LOCK(_Lock);
+
+	//Apply the pending updates.
+	for (uint64 range_index{ 0 }; range_index < number_of_gather_ranges; ++range_index)
+	{
+		for (const PendingUpdate &pending_update : _GatherRanges[range_index]._PendingUpdates)
+		{
+			ApplyPendingUpdate(pending_update);
+		}
+	}
+
+	//Compact the buckets if the empty ones are starting to pile up.
+	if (_NumberOfEmptyBuckets > SpatialIndexSystemConstants::MAXIMUM_NUMBER_OF_EMPTY_BUCKETS && _NumberOfEmptyBuckets * 2 > _Buckets.Size())
+	{
+		CompactBuckets();
+	}
+}
+
+/*
+*	Removes the given entity from the index right away, so that queries stop returning it.
+*	The entity system calls this when an entity is destroyed, before it's memory and identifier are freed.
+*	Entities are destroyed outside of the update range of this system, so this never runs alongside an update.
+*/
+void SpatialIndexSystem::RemoveEntity(Entity *const RESTRICT entity) NOEXCEPT
+{
+	const EntityIdentifier entity_identifier{ entity->_EntityIdentifier };
+
+	SCOPED_WRITE_LOCK(_Lock);
+
+	if (entity_identifier >= _EntityToEntryMappings.Size())
+	{
+		return;
+	}
+
+	const uint32 entry_index{ _EntityToEntryMappings[entity_identifier] };
+
+	//Entity identifiers are reused, so make sure the entry still belongs to this entity.
+	if (entry_index != INVALID_ENTRY_INDEX && _EntryEntities[entry_index] == entity)
+	{
+		RemoveEntry(entry_index);
+	}
+}
+
+/*
+*	Returns if the given entity is in the index.
+*/
+NO_DISCARD bool SpatialIndexSystem::IsInIndex(Entity *const RESTRICT entity) const NOEXCEPT
+{
+	SCOPED_READ_LOCK(_Lock);
+
+	return GetEntryIndex(entity) != INVALID_ENTRY_INDEX;
+}
+
+/*
+*	Executes the given query.
+*/
+void SpatialIndexSystem::ExecuteQuery(SpatialIndexQuery *const RESTRICT query) NOEXCEPT
+{
+	SCOPED_READ_LOCK(_Lock);
+
+	ExecuteQueryInternal(query);
+}
+
+/*
+*	Executes the given queries. Large batches are split across the task system, and this function returns when all queries are answered.
+*/
+void SpatialIndexSystem::ExecuteQueries(SpatialIndexQuery *const RESTRICT queries, const uint64 number_of_queries) NOEXCEPT
+{
+	PROFILING_SCOPE("SpatialIndexSystem::ExecuteQueries");
+
+	if (number_of_queries <= SpatialIndexSystemConstants::QUERIES_PER_INDEX)
+	{
+		SCOPED_READ_LOCK(_Lock);
+
+		for (uint64 i{ 0 }; i < number_of_queries; ++i)
+		{
+			ExecuteQueryInternal(&queries[i]);
+		}
+
+		return;
+	}
+
+	QueryBatch query_batch;
+
+	query_batch._Queries = queries;
+	query_batch._NumberOfQueries = number_of_queries;
+
+	//Each index takes the lock on it's own, as holding it here while waiting could deadlock with a waiting writer.
+	TaskSystem::ParallelFor
+	(
+		Task::Priority::HIGH,
+		static_cast<uint32>((number_of_queries + SpatialIndexSystemConstants::QUERIES_PER_INDEX - 1) / SpatialIndexSystemConstants::QUERIES_PER_INDEX),
+		[](void *const RESTRICT arguments, const uint32 index)
+		{
+			const QueryBatch &batch{ *static_cast<const QueryBatch *const RESTRICT>(arguments) };
+			const uint64 first_query_index{ index * SpatialIndexSystemConstants::QUERIES_PER_INDEX };
+			const uint64 last_query_index{ BaseMath::Minimum<uint64>(first_query_index + SpatialIndexSystemConstants::QUERIES_PER_INDEX, batch._NumberOfQueries) };
+
+			SCOPED_READ_LOCK(SpatialIndexSystem::Instance->_Lock);
+
+			for (uint64 query_index{ first_query_index }; query_index < last_query_index; ++query_index)
+			{
+				SpatialIndexSystem::Instance->ExecuteQueryInternal(&batch._Queries[query_index]);
+			}
+		},
+		&query_batch
+	);
+}
+
+/*
+*	Returns the entry index for the given entity, or an invalid entry index if it isn't in the index.
+*/
+NO_DISCARD uint32 SpatialIndexSystem::GetEntryIndex(Entity *const RESTRICT entity) const NOEXCEPT
+{
+	if (entity->_EntityIdentifier >= _EntityToEntryMappings.Size())
+	{
+		return INVALID_ENTRY_INDEX;
+	}
+
+	const uint32 entry_index{ _EntityToEntryMappings[entity->_EntityIdentifier] };
+
+	//Entity identifiers are reused, so make sure the entry still belongs to this entity.
+	if (entry_index == INVALID_ENTRY_INDEX || _EntryEntities[entry_index] != entity)
+	{
+		return INVALID_ENTRY_INDEX;
+	}
+
+	return entry_index;
+}
+
+/*
+*	Gathers the pending updates for the given range of world transform instances.
+*/
+void SpatialIndexSystem::GatherPendingUpdates(GatherRange *const RESTRICT gather_range) const NOEXCEPT
+{
+	for (uint64 instance_index{ gather_range->_FirstInstanceIndex }; instance_index < gather_range->_LastInstanceIndex; ++instance_index)
+	{
+		Entity *const RESTRICT entity{ WorldTransformComponent::Instance->InstanceToEntity(instance_index) };
+		const WorldTransformInstanceData &world_transform_instance_data{ WorldTransformComponent::Instance->InstanceData()[instance_index] };
+
+		//Entities that are already in the index only need updating if they moved.
+		if (GetEntryIndex(entity) != INVALID_ENTRY_INDEX && world_transform_instance_data._PreviousWorldTransform == world_transform_instance_data._CurrentWorldTransform)
+		{
+			continue;
+		}
+
+		gather_range->_PendingUpdates.Emplace();
+		PendingUpdate &pending_update{ gather_range->_PendingUpdates.Back() };
+
+		pending_update._Entity = entity;
+		pending_update._Cell = world_transform_instance_data._CurrentWorldTransform.GetCell();
+
+		//Use the model bounds for static models, everything else is just a point.
+		if (StaticModelComponent::Instance->Has(entity))
+		{
+			pending_update._Box = StaticModelComponent::Instance->InstanceData(entity)._WorldSpaceAxisAlignedBoundingBox.GetRelativeAxisAlignedBoundingBox(pending_update._Cell);
+		}
+
+		else
+		{
+			const Vector3<float32> &local_position{ world_transform_instance_data._CurrentWorldTransform.GetLocalPosition() };
+
+			pending_update._Box = AxisAlignedBoundingBox3D(local_position, local_position);
+		}
+	}
+}
+
+/*
+*	Applies the given pending update.
+*/
+void SpatialIndexSystem::ApplyPendingUpdate(const PendingUpdate &pending_update) NOEXCEPT
+{
+	const float64 world_grid_size{ static_cast<float64>(WorldSystem::Instance->GetWorldGridSize()) };
+
+	//Find the smallest level that the bounds fit in.
+	const Vector3<float32> dimensions{ pending_update._Box.Dimensions() };
+	const float64 largest_dimension{ static_cast<float64>(BaseMath::Maximum<float32>(dimensions._X, BaseMath::Maximum<float32>(dimensions._Y, dimensions._Z))) };
+
+	uint8 level{ OVERSIZED_LEVEL };
+
+	for (uint8 level_index{ 0 }; level_index < NUMBER_OF_LEVELS; ++level_index)
+	{
+		if (largest_dimension <= BucketSize(level_index))
+		{
+			level = level_index;
+
+			break;
+		}
+	}
+
+	//The bucket is the one containing the center of the bounds.
+	Vector3<int64> coordinates{ 0, 0, 0 };
+
+	if (level != OVERSIZED_LEVEL)
+	{
+		const Vector3<float64> center{ ToAbsolute(pending_update._Cell, AxisAlignedBoundingBox3D::CalculateCenter(pending_update._Box), world_grid_size) };
+		const float64 bucket_size{ BucketSize(level) };
+
+		coordinates._X = FloorToInt64(center._X / bucket_size);
+		coordinates._Y = FloorToInt64(center._Y / bucket_size);
+		coordinates._Z = FloorToInt64(center._Z / bucket_size);
+	}
+
+	uint32 entry_index{ GetEntryIndex(pending_update._Entity) };
+
+	//Add a new entry if this entity isn't in the index yet.
+	if (entry_index == INVALID_ENTRY_INDEX)
+	{
+		for (uint64 i{ _EntityToEntryMappings.Size() }; i <= pending_update._Entity->_EntityIdentifier; ++i)
+		{
+			_EntityToEntryMappings.Emplace(INVALID_ENTRY_INDEX);
+		}
+
+		entry_index = static_cast<uint32>(_EntryEntities.Size());
+
+		_EntryEntities.Emplace(pending_update._Entity);
+		_EntryCells.Emplace(pending_update._Cell);
+		_EntryBoxes.Emplace(pending_update._Box);
+		_EntryBucketIndices.Emplace(INVALID_ENTRY_INDEX);
+		_EntryBucketSlots.Emplace(INVALID_ENTRY_INDEX);
+
+		_EntityToEntryMappings[pending_update._Entity->_EntityIdentifier] = entry_index;
+	}
+
+	else
+	{
+		_EntryCells[entry_index] = pending_update._Cell;
+		_EntryBoxes[entry_index] = pending_update._Box;
+
+		//Most moves stay within the same bucket, in which case there's nothing more to do.
+		const Bucket &current_bucket{ _Buckets[_EntryBucketIndices[entry_index]] };
+
+		if (current_bucket._Level == level && current_bucket._Coordinates == coordinates)
+		{
+			return;
+		}
+
+		RemoveFromBucket(entry_index);
+	}
+
+	//Add the entry to it's new bucket.
+	const uint32 bucket_index{ FindOrCreateBucket(level, coordinates) };
+	Bucket &bucket{ _Buckets[bucket_index] };
+
+	if (bucket._EntryIndices.Empty())
+	{
+		--_NumberOfEmptyBuckets;
+		++_NumberOfBucketsPerLevel[level];
+	}
+
+	_EntryBucketIndices[entry_index] = bucket_index;
+	_EntryBucketSlots[entry_index] = static_cast<uint32>(bucket._EntryIndices.Size());
+	bucket._EntryIndices.Emplace(entry_index);
+}
+
+/*
+*	Finds or creates the bucket with the given level and coordinates, returning it's index.
+*/
+NO_DISCARD uint32 SpatialIndexSystem::FindOrCreateBucket(const uint8 level, const Vector3<int64> &coordinates) NOEXCEPT
+{
+	BucketKey key;
+
+	key._Level = level;
+	key._Coordinates = coordinates;
+
+	const std::unordered_map<BucketKey, uint32, BucketKeyHash>::const_iterator iterator{ _KeyToBucketMappings.find(key) };
+
+	if (iterator != _KeyToBucketMappings.end())
+	{
+		return iterator->second;
+	}
+
+	const uint32 bucket_index{ static_cast<uint32>(_Buckets.Size()) };
+
+	_Buckets.Emplace();
+	Bucket &bucket{ _Buckets.Back() };
+
+	bucket._Level = level;
+	bucket._Coordinates = coordinates;
+
+	_KeyToBucketMappings[key] = bucket_index;
+
+	//New buckets start out empty.
+	++_NumberOfEmptyBuckets;
+
+	return bucket_index;
+}
+
+/*
+*	Removes the given entry from it's bucket.
+*/
+void SpatialIndexSystem::RemoveFromBucket(const uint32 entry_index) NOEXCEPT
+{
+	Bucket &bucket{ _Buckets[_EntryBucketIndices[entry_index]] };
+	const uint32 slot{ _EntryBucketSlots[entry_index] };
+
+	//Move the last entry of the bucket into the slot.
+	const uint32 last_entry_index{ bucket._EntryIndices.Back() };
+
+	bucket._EntryIndices[slot] = last_entry_index;
+	_EntryBucketSlots[last_entry_index] = slot;
+	bucket._EntryIndices.Pop();
+
+	if (bucket._EntryIndices.Empty())
+	{
+		++_NumberOfEmptyBuckets;
+		--_NumberOfBucketsPerLevel[bucket._Level];
+	}
+
+	_EntryBucketIndices[entry_index] = INVALID_ENTRY_INDEX;
+	_EntryBucketSlots[entry_index] = INVALID_ENTRY_INDEX;
+}
+
+/*
+*	Removes the given entry.
+*/
+void SpatialIndexSystem::RemoveEntry(const uint32 entry_index) NOEXCEPT
+{
+	RemoveFromBucket(entry_index);
+
+	_EntityToEntryMappings[_EntryEntities[entry_index]->_EntityIdentifier] = INVALID_ENTRY_INDEX;
+
+	//Move the last entry into the removed one's place.
+	const uint32 last_entry_index{ static_cast<uint32>(_EntryEntities.LastIndex()) };
+
+	if (entry_index != last_entry_index)
+	{
+		_EntryEntities[entry_index] = _EntryEntities[last_entry_index];
+		_EntryCells[entry_index] = _EntryCells[last_entry_index];
+		_EntryBoxes[entry_index] = _EntryBoxes[last_entry_index];
+		_EntryBucketIndices[entry_index] = _EntryBucketIndices[last_entry_index];
+		_EntryBucketSlots[entry_index] = _EntryBucketSlots[last_entry_index];
+
+		_Buckets[_EntryBucketIndices[entry_index]]._EntryIndices[_EntryBucketSlots[entry_index]] = entry_index;
+		_EntityToEntryMappings[_EntryEntities[entry_index]->_EntityIdentifier] = entry_index;
+	}
+
+	_EntryEntities.Pop();
+	_EntryCells.Pop();
+	_EntryBoxes.Pop();
+	_EntryBucketIndices.Pop();
+	_EntryBucketSlots.Pop();
+}
+
+/*
+*	Rebuilds the buckets, dropping the empty ones.
+*/
+void SpatialIndexSystem::CompactBuckets() NOEXCEPT
+{
+	PROFILING_SCOPE("SpatialIndexSystem::CompactBuckets");
+
+	DynamicArray<Bucket> new_buckets;
+	new_buckets.Reserve(_Buckets.Size() - _NumberOfEmptyBuckets);
+
+	_KeyToBucketMappings.clear();
+
+	for (Bucket &bucket : _Buckets)
+	{
+		if (bucket._EntryIndices.Empty())
+		{
+			continue;
+		}
+
+		const uint32 bucket_index{ static_cast<uint32>(new_buckets.Size()) };
+
+		for (const uint32 entry_index : bucket._EntryIndices)
+		{
+			_EntryBucketIndices[entry_index] = bucket_index;
+		}
+
+		BucketKey key;
+
+		key._Level = bucket._Level;
+		key._Coordinates = bucket._Coordinates;
+
+		_KeyToBucketMappings[key] = bucket_index;
+		new_buckets.Emplace(std::move(bucket));
+	}
+
+	_Buckets = std::move(new_buckets);
+	_NumberOfEmptyBuckets = 0;
+}
+
+/*
+*	Executes the given query, assuming the lock is held for reading.
+*/
+void SpatialIndexSystem::ExecuteQueryInternal(SpatialIndexQuery *const RESTRICT query) const NOEXCEPT
+{
+	query->_Results.Clear();
+
+	switch (query->_Type)
+	{
+		case SpatialIndexQuery::Type::SPHERE:
+		{
+			const Vector3<float32> center{ query->_Position.GetLocalPosition() };
+			const float32 radius{ query->_Distance };
+			const AxisAlignedBoundingBox3D box{ center - radius, center + radius };
+
+			GatherEntries
+			(
+				query->_Position.GetCell(),
+				&box,
+				[center, radius](const AxisAlignedBoundingBox3D &entry_box, SpatialIndexQuery::Result *const RESTRICT result)
+				{
+					const float32 distance_squared{ Vector3<float32>::LengthSquared(AxisAlignedBoundingBox3D::GetClosestPointInside(entry_box, center) - center) };
+
+					if (distance_squared > radius * radius)
+					{
+						return false;
+					}
+
+					result->_Distance = BaseMath::SquareRoot(distance_squared);
+
+					return true;
+				},
+				&query->_Results
+			);
+
+			break;
+		}
+
+		case SpatialIndexQuery::Type::BOX:
+		{
+			const Vector3<int32> cell{ query->_Box._Minimum.GetCell() };
+			const AxisAlignedBoundingBox3D box{ query->_Box.GetRelativeAxisAlignedBoundingBox(cell) };
+
+			GatherEntries
+			(
+				cell,
+				&box,
+				[&box](const AxisAlignedBoundingBox3D &entry_box, SpatialIndexQuery::Result *const RESTRICT result)
+				{
+					return CatalystGeometryMath::BoxBoxIntersection(entry_box, box);
+				},
+				&query->_Results
+			);
+
+			break;
+		}
+
+		case SpatialIndexQuery::Type::FRUSTUM:
+		{
+			//Frustums don't have a box to narrow down the buckets with, so every bucket is tested against the frustum instead.
+			const Frustum &frustum{ query->_Frustum };
+
+			GatherEntries
+			(
+				query->_Cell,
+				nullptr,
+				[&frustum](const AxisAlignedBoundingBox3D &entry_box, SpatialIndexQuery::Result *const RESTRICT result)
+				{
+					return Culling::IsWithinFrustum(entry_box, frustum);
+				},
+				&query->_Results
+			);
+
+			break;
+		}
+
+		case SpatialIndexQuery::Type::NEAREST:
+		{
+			const Vector3<float32> center{ query->_Position.GetLocalPosition() };
+			const uint64 number_of_entities{ _EntryEntities.Size() };
+
+			//Widen the search until enough entities are found. Anything outside the search radius is further away than everything inside it, so the closest ones are always found.
+			float32 radius{ BaseMath::Minimum<float32>(SpatialIndexSystemConstants::INITIAL_NEAREST_RADIUS, query->_Distance) };
+
+			for (;;)
+			{
+				query->_Results.Clear();
+
+				const AxisAlignedBoundingBox3D box{ center - radius, center + radius };
+
+				GatherEntries
+				(
+					query->_Position.GetCell(),
+					&box,
+					[center, radius](const AxisAlignedBoundingBox3D &entry_box, SpatialIndexQuery::Result *const RESTRICT result)
+					{
+						const float32 distance_squared{ Vector3<float32>::LengthSquared(AxisAlignedBoundingBox3D::GetClosestPointInside(entry_box, center) - center) };
+
+						if (distance_squared > radius * radius)
+						{
+							return false;
+						}
+
+						result->_Distance = BaseMath::SquareRoot(distance_squared);
+
+						return true;
+					},
+					&query->_Results
+				);
+
+				if (query->_Results.Size() >= query->_MaximumNumberOfResults || query->_Results.Size() == number_of_entities || radius >= query->_Distance)
+				{
+					break;
+				}
+
+				radius = BaseMath::Minimum<float32>(radius * 4.0f, query->_Distance);
+			}
+
+			SortingAlgorithms::StandardSort<SpatialIndexQuery::Result>
+			(
+				query->_Results.Begin(),
+				query->_Results.End(),
+				nullptr,
+				[](const void *const RESTRICT user_data, const SpatialIndexQuery::Result *const RESTRICT first, const SpatialIndexQuery::Result *const RESTRICT second)
+				{
+					return first->_Distance < second->_Distance;
+				}
+			);
+
+			if (query->_Results.Size() > query->_MaximumNumberOfResults)
+			{
+				query->_Results.Resize<false>(query->_MaximumNumberOfResults);
+			}
+
+			break;
+		}
+
+		case SpatialIndexQuery::Type::RAY:
+		{
+			const Ray ray{ query->_Position.GetLocalPosition(), query->_Direction };
+			const float32 maximum_distance{ query->_Distance };
+			const Vector3<float32> end{ ray._Origin + ray._Direction * maximum_distance };
+			const AxisAlignedBoundingBox3D box{ BaseMath::Minimum<Vector3<float32>>(ray._Origin, end), BaseMath::Maximum<Vector3<float32>>(ray._Origin, end) };
+
+			GatherEntries
+			(
+				query->_Position.GetCell(),
+				&box,
+				[&ray, maximum_distance](const AxisAlignedBoundingBox3D &entry_box, SpatialIndexQuery::Result *const RESTRICT result)
+				{
+					float32 intersection_distance{ 0.0f };
+
+					if (!CatalystGeometryMath::RayBoxIntersection(ray, entry_box, &intersection_distance) || intersection_distance > maximum_distance)
+					{
+						return false;
+					}
+
+					//The ray might start inside the box.
+					result->_Distance = BaseMath::Maximum<float32>(intersection_distance, 0.0f);
+
+					return true;
+				},
+				&query->_Results
+			);
+
+			SortingAlgorithms::StandardSort<SpatialIndexQuery::Result>
+			(
+				query->_Results.Begin(),
+				query->_Results.End(),
+				nullptr,
+				[](const void *const RESTRICT user_data, const SpatialIndexQuery::Result *const RESTRICT first, const SpatialIndexQuery::Result *const RESTRICT second)
+				{
+					return first->_Distance < second->_Distance;
+				}
+			);
+
+			break;
+		}
+
+		default:
+		{
+			ASSERT(false, "Invalid case!");
+
+			break;
+		}
+	}
+}
+
+/*
+*	Gathers the entries that pass the given test into the given results.
+*	The test is given an entry box relative to the given cell, and the result to fill in, and returns if the entry should be added.
+*	Buckets are tested with their loose box first, so the test needs to be conservative.
+*	If a box is given, relative to the given cell as well, only buckets that overlap it are visited. Otherwise, every bucket is.
+*/
+template <typename TEST>
+void SpatialIndexSystem::GatherEntries
+(
+	const Vector3<int32> &cell,
+	const AxisAlignedBoundingBox3D *const RESTRICT box,
+	const TEST &test,
+	DynamicArray<SpatialIndexQuery::Result> *const RESTRICT results
+) const NOEXCEPT
+{
+	const float32 world_grid_size{ WorldSystem::Instance->GetWorldGridSize() };
+
+	//Gathers the entries of the given bucket.
+	const auto gather_bucket{ [this, &cell, &test, results, world_grid_size](const Bucket &bucket)
+	{
+		if (bucket._Level != OVERSIZED_LEVEL)
+		{
+			SpatialIndexQuery::Result bucket_result;
+
+			if (!test(LooseBucketBox(bucket._Level, bucket._Coordinates, cell, static_cast<float64>(world_grid_size)), &bucket_result))
+			{
+				return;
+			}
+		}
+
+		for (const uint32 entry_index : bucket._EntryIndices)
+		{
+			//Move the entry box so it's relative to the query cell.
+			const Vector3<int32> delta{ _EntryCells[entry_index] - cell };
+			const Vector3<float32> offset{ Vector3<float32>(static_cast<float32>(delta._X), static_cast<float32>(delta._Y), static_cast<float32>(delta._Z)) * world_grid_size };
+			const AxisAlignedBoundingBox3D entry_box{ _EntryBoxes[entry_index]._Minimum + offset, _EntryBoxes[entry_index]._Maximum + offset };
+
+			SpatialIndexQuery::Result result;
+
+			result._Entity = _EntryEntities[entry_index];
+			result._Distance = 0.0f;
+
+			if (test(entry_box, &result))
+			{
+				results->Emplace(result);
+			}
+		}
+	} };
+
+	/*
+	*	For each level, either look up the buckets that overlap the box directly, or go through all buckets of the level,
+	*	whichever visits fewer buckets. The oversized level only has one bucket, so it's always gone through.
+	*/
+	bool scan_levels[NUMBER_OF_LEVELS + 1];
+	bool any_scanned_levels{ false };
+
+	Vector3<float64> absolute_minimum{ 0.0, 0.0, 0.0 };
+	Vector3<float64> absolute_maximum{ 0.0, 0.0, 0.0 };
+
+	if (box)
+	{
+		absolute_minimum = ToAbsolute(cell, box->_Minimum, static_cast<float64>(world_grid_size));
+		absolute_maximum = ToAbsolute(cell, box->_Maximum, static_cast<float64>(world_grid_size));
+	}
+
+	for (uint8 level{ 0 }; level <= NUMBER_OF_LEVELS; ++level)
+	{
+		scan_levels[level] = false;
+
+		if (_NumberOfBucketsPerLevel[level] == 0)
+		{
+			continue;
+		}
+
+		if (!box || level == OVERSIZED_LEVEL)
+		{
+			scan_levels[level] = any_scanned_levels = true;
+
+			continue;
+		}
+
+		//Buckets are loose by half their size, so widen the box by that much, plus one bucket to be conservative about rounding.
+		const float64 bucket_size{ BucketSize(level) };
+		const float64 number_of_buckets{	((absolute_maximum._X - absolute_minimum._X) / bucket_size + 3.0)
+											* ((absolute_maximum._Y - absolute_minimum._Y) / bucket_size + 3.0)
+											* ((absolute_maximum._Z - absolute_minimum._Z) / bucket_size + 3.0) };
+
+		//This also catches infinite boxes.
+		if (!(number_of_buckets <= static_cast<float64>(_NumberOfBucketsPerLevel[level])))
+		{
+			scan_levels[level] = any_scanned_levels = true;
+
+			continue;
+		}
+
+		const Vector3<int64> minimum_coordinates
+		{
+			FloorToInt64((absolute_minimum._X - bucket_size * 0.5) / bucket_size) - 1,
+			FloorToInt64((absolute_minimum._Y - bucket_size * 0.5) / bucket_size) - 1,
+			FloorToInt64((absolute_minimum._Z - bucket_size * 0.5) / bucket_size) - 1
+		};
+
+		const Vector3<int64> maximum_coordinates
+		{
+			FloorToInt64((absolute_maximum._X + bucket_size * 0.5) / bucket_size),
+			FloorToInt64((absolute_maximum._Y + bucket_size * 0.5) / bucket_size),
+			FloorToInt64((absolute_maximum._Z + bucket_size * 0.5) / bucket_size)
+		};
+
+		BucketKey key;
+
+		key._Level = level;
+
+		Vector3<int64> &coordinates{ key._Coordinates };
+
+		for (coordinates._X = minimum_coordinates._X; coordinates._X <= maximum_coordinates._X; ++coordinates._X)
+		{
+			for (coordinates._Y = minimum_coordinates._Y; coordinates._Y <= maximum_coordinates._Y; ++coordinates._Y)
+			{
+				for (coordinates._Z = minimum_coordinates._Z; coordinates._Z <= maximum_coordinates._Z; ++coordinates._Z)
+				{
+					const std::unordered_map<BucketKey, uint32, BucketKeyHash>::const_iterator iterator{ _KeyToBucketMappings.find(key) };
+
+					if (iterator != _KeyToBucketMappings.end())
+					{
+						gather_bucket(_Buckets[iterator->second]);
+					}
+				}
+			}
+		}
+	}
+
+	if (any_scanned_levels)
+	{
+		for (const Bucket &bucket : _Buckets)
+		{
+			if (scan_levels[bucket._Level] && !bucket._EntryIndices.Empty())
+			{
+				gather_bucket(bucket);
+			}
+		}
+	}
+}
\ No newline at end of file
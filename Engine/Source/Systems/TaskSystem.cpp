@@ -4,6 +4,9 @@
 //Concurrency.
 #include <Concurrency/Concurrency.h>
 
+//Math.
+#include <Math/Core/BaseMath.h>
+
 //Profiling.
 #include <Profiling/Profiling.h>
 
@@ -226,6 +229,78 @@ void TaskSystem::WaitForAllTasksToFinish() NOEXCEPT
 	}
 }
 
+/*
+*	Runs the given function for all indices up to the given count on tasks with the given priority, and returns when all of them are done.
+*	Tasks pick up indices one at a time, so splitting work into a few more indices than there are task executors evens out uneven work.
+*	The calling thread does work of the given priority or higher while waiting, and runs everything itself if there is no task system or only a single index.
+*/
+void TaskSystem::ParallelFor(const Task::Priority priority, const uint32 count, const ParallelForFunction function, void *const RESTRICT context) NOEXCEPT
+{
+	const uint32 number_of_tasks
+	{
+		Instance
+		? BaseMath::Minimum<uint32>(BaseMath::Minimum<uint32>(count, Instance->GetNumberOfTaskExecutors()), MAXIMUM_NUMBER_OF_PARALLEL_FOR_TASKS)
+		: 1
+	};
+
+	//Not worth going wide for a single task.
+	if (number_of_tasks <= 1)
+	{
+		for (uint32 index{ 0 }; index < count; ++index)
+		{
+			function(context, index);
+		}
+
+		return;
+	}
+
+	//The tasks live on the stack, as this is called every frame from some places.
+	StaticArray<ParallelForTask, MAXIMUM_NUMBER_OF_PARALLEL_FOR_TASKS> tasks;
+	Atomic<uint32> next_index{ 0 };
+
+	//Fire off the tasks.
+	for (uint32 task_index{ 0 }; task_index < number_of_tasks; ++task_index)
+	{
+		ParallelForTask &task{ tasks[task_index] };
+
+		task._Task._Function = [](void *const RESTRICT arguments)
+		{
+			const ParallelForTask *const RESTRICT task{ static_cast<const ParallelForTask *const RESTRICT>(arguments) };
+
+			for (uint32 index{ task->_NextIndex->FetchAdd(1) }; index < task->_Count; index = task->_NextIndex->FetchAdd(1))
+			{
+				task->_Function(task->_Context, index);
+			}
+		};
+		task._Task._Arguments = &task;
+		task._Task._ExecutableOnSameThread = true;
+		task._Function = function;
+		task._Context = context;
+		task._NextIndex = &next_index;
+		task._Count = count;
+
+		Instance->ExecuteTask(priority, &task._Task);
+	}
+
+	//Help out while waiting for the tasks to finish.
+	bool all_executed{ false };
+
+	while (!all_executed)
+	{
+		all_executed = true;
+
+		for (uint32 task_index{ 0 }; task_index < number_of_tasks; ++task_index)
+		{
+			all_executed &= tasks[task_index]._Task.IsExecuted();
+		}
+
+		if (!all_executed)
+		{
+			Instance->DoWork(priority);
+		}
+	}
+}
+
 /*
 *	Executes tasks.
 */
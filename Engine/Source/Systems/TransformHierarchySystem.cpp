@@ -0,0 +1,718 @@
+//Header file.
+#include <Systems/TransformHierarchySystem.h>
+
+//Components.
+#include <Components/Components/WorldTransformComponent.h>
+
+//Core.
+#include <Core/General/SIMD.h>
+
+//Profiling.
+#include <Profiling/Profiling.h>
+
+//Systems.
+#include <Systems/TaskSystem.h>
+
+//World.
+#include <World/Core/WorldPosition.h>
+
+//Transform hierarchy system constants.
+namespace TransformHierarchySystemConstants
+{
+	//The number of nodes in each propagation chunk. Depths with fewer nodes than this are propagated on the updating thread.
+	constexpr uint32 NODES_PER_CHUNK{ 1'024 };
+}
+
+/*
+*	Updates the transform hierarchy system.
+*/
+void TransformHierarchySystem::Update(const UpdatePhase phase) NOEXCEPT
+{
+	PROFILING_SCOPE("TransformHierarchySystem::Update");
+
+	//Process the remove node queue first, as the entity identifiers of removed entities might be reused by the other requests.
+	{
+		Optional<RemoveNodeRequest> request{ _RemoveNodeQueue.Pop() };
+
+		while (request.Valid())
+		{
+			RemoveNodeInternal(request.Get()._EntityIdentifier, request.Get()._Entity);
+
+			request = _RemoveNodeQueue.Pop();
+		}
+	}
+
+	//Take everything off the request queues, after the requests that are already waiting.
+	DrainRequestQueues();
+
+	//Process the set parent requests, keeping the ones whose entities aren't ready yet, in order.
+	{
+		uint64 number_of_waiting_requests{ 0 };
+
+		for (uint64 i{ 0 }; i < _SetParentRequests.Size(); ++i)
+		{
+			if (!SetParentInternal(_SetParentRequests[i]._Child, _SetParentRequests[i]._Parent))
+			{
+				_SetParentRequests[number_of_waiting_requests++] = _SetParentRequests[i];
+			}
+		}
+
+		_SetParentRequests.Resize<false>(number_of_waiting_requests);
+	}
+
+	//Process the set local transform requests.
+	for (const SetLocalTransformRequest &request : _SetLocalTransformRequests)
+	{
+		SetLocalTransformInternal(request);
+	}
+
+	_SetLocalTransformRequests.Clear();
+
+	//Rebuild the nodes if the topology changed.
+	if (_TopologyDirty)
+	{
+		RebuildNodes();
+	}
+
+	_ChangedEntities.Clear();
+
+	if (_Entities.Empty())
+	{
+		return;
+	}
+
+	//Pick up any changes to the roots, then propagate down the hierarchy.
+	UpdateRoots();
+	Propagate();
+
+	//Gather the changed entities and reset the dirty flags for the next update.
+	for (uint32 node_index{ 0 }; node_index < _Entities.Size(); ++node_index)
+	{
+		if (_DirtyFlags[node_index])
+		{
+			_ChangedEntities.Emplace(_Entities[node_index]);
+			_DirtyFlags[node_index] = 0;
+		}
+	}
+
+	//Notify the change callbacks.
+	if (!_ChangedEntities.Empty())
+	{
+		for (const ChangeCallbackData &change_callback : _ChangeCallbacks)
+		{
+			change_callback._Callback(_ChangedEntities, change_callback._UserData);
+		}
+	}
+}
+
+/*
+*	Sets the parent of the given child. Passing nullptr as the parent detaches the child from it's parent.
+*	The child keeps it's current world transform, and it's local transform is derived from that.
+*	Both entities need a world transform component.
+*/
+void TransformHierarchySystem::SetParent(Entity *const RESTRICT child, Entity *const RESTRICT parent) NOEXCEPT
+{
+	ASSERT(child != parent, "Can't parent an entity to itself!");
+
+	//Create the request.
+	SetParentRequest request;
+
+	request._Child = child;
+	request._Parent = parent;
+
+	_SetParentQueue.Push(request);
+}
+
+/*
+*	Sets the local transform of the given entity, relative to it's parent.
+*	For entities without a parent, this is relative to the cell the entity is in.
+*/
+void TransformHierarchySystem::SetLocalTransform(Entity *const RESTRICT entity, const Vector3<float32> &position, const Quaternion &rotation, const Vector3<float32> &scale) NOEXCEPT
+{
+	//Create the request.
+	SetLocalTransformRequest request;
+
+	request._Entity = entity;
+	request._Position = position;
+	request._Rotation = rotation;
+	request._Scale = scale;
+
+	_SetLocalTransformQueue.Push(request);
+}
+
+/*
+*	Removes the given entity from the hierarchy. It's children are detached and keep their current world transform.
+*/
+void TransformHierarchySystem::RemoveNode(Entity *const RESTRICT entity) NOEXCEPT
+{
+	//Create the request.
+	RemoveNodeRequest request;
+
+	request._EntityIdentifier = entity->_EntityIdentifier;
+	request._Entity = entity;
+
+	_RemoveNodeQueue.Push(request);
+}
+
+/*
+*	Called by the entity system when the given entity is destroyed, before it's memory and identifier are freed.
+*	Drops all requests referencing the entity and removes it from the hierarchy right away, so nothing refers to it once it's gone.
+*	Entities are destroyed outside of the update range of this system, so this never runs alongside an update.
+*/
+void TransformHierarchySystem::OnEntityDestroyed(Entity *const RESTRICT entity) NOEXCEPT
+{
+	//Pull the queued requests in, so the ones referencing this entity can be dropped.
+	DrainRequestQueues();
+
+	{
+		uint64 number_of_kept_requests{ 0 };
+
+		for (uint64 i{ 0 }; i < _SetParentRequests.Size(); ++i)
+		{
+			if (_SetParentRequests[i]._Child != entity && _SetParentRequests[i]._Parent != entity)
+			{
+				_SetParentRequests[number_of_kept_requests++] = _SetParentRequests[i];
+			}
+		}
+
+		_SetParentRequests.Resize<false>(number_of_kept_requests);
+	}
+
+	{
+		uint64 number_of_kept_requests{ 0 };
+
+		for (uint64 i{ 0 }; i < _SetLocalTransformRequests.Size(); ++i)
+		{
+			if (_SetLocalTransformRequests[i]._Entity != entity)
+			{
+				_SetLocalTransformRequests[number_of_kept_requests++] = _SetLocalTransformRequests[i];
+			}
+		}
+
+		_SetLocalTransformRequests.Resize<false>(number_of_kept_requests);
+	}
+
+	RemoveNodeInternal(entity->_EntityIdentifier, entity);
+}
+
+/*
+*	Returns if the given entity is in the hierarchy.
+*/
+NO_DISCARD bool TransformHierarchySystem::IsInHierarchy(Entity *const RESTRICT entity) const NOEXCEPT
+{
+	return GetNodeIndex(entity) != INVALID_NODE_INDEX;
+}
+
+/*
+*	Returns the parent of the given entity, or nullptr if it doesn't have one.
+*/
+RESTRICTED NO_DISCARD Entity *const RESTRICT TransformHierarchySystem::GetParent(Entity *const RESTRICT entity) const NOEXCEPT
+{
+	const uint32 node_index{ GetNodeIndex(entity) };
+
+	if (node_index == INVALID_NODE_INDEX || _ParentIndices[node_index] == INVALID_NODE_INDEX)
+	{
+		return nullptr;
+	}
+
+	return _Entities[_ParentIndices[node_index]];
+}
+
+/*
+*	Registers a change callback, called at the end of every update where world transforms in the hierarchy changed.
+*/
+void TransformHierarchySystem::RegisterChangeCallback(const ChangeCallback callback, void *const RESTRICT user_data) NOEXCEPT
+{
+	_ChangeCallbacks.Emplace();
+	ChangeCallbackData &change_callback{ _ChangeCallbacks.Back() };
+
+	change_callback._Callback = callback;
+	change_callback._UserData = user_data;
+}
+
+/*
+*	Deregisters a change callback.
+*/
+void TransformHierarchySystem::DeregisterChangeCallback(const ChangeCallback callback, void *const RESTRICT user_data) NOEXCEPT
+{
+	for (uint64 i{ 0 }; i < _ChangeCallbacks.Size(); ++i)
+	{
+		if (_ChangeCallbacks[i]._Callback == callback && _ChangeCallbacks[i]._UserData == user_data)
+		{
+			_ChangeCallbacks.EraseAt<true>(i);
+
+			return;
+		}
+	}
+}
+
+/*
+*	Returns the node index for the given entity, or an invalid node index if it isn't in the hierarchy.
+*/
+NO_DISCARD uint32 TransformHierarchySystem::GetNodeIndex(Entity *const RESTRICT entity) const NOEXCEPT
+{
+	if (entity->_EntityIdentifier >= _EntityToNodeMappings.Size())
+	{
+		return INVALID_NODE_INDEX;
+	}
+
+	const uint32 node_index{ _EntityToNodeMappings[entity->_EntityIdentifier] };
+
+	//Entity identifiers are reused, so make sure the node still belongs to this entity.
+	if (node_index == INVALID_NODE_INDEX || _Entities[node_index] != entity)
+	{
+		return INVALID_NODE_INDEX;
+	}
+
+	return node_index;
+}
+
+/*
+*	Adds a node for the given entity, returning the node index.
+*/
+NO_DISCARD uint32 TransformHierarchySystem::AddNode(Entity *const RESTRICT entity) NOEXCEPT
+{
+	//Add entity to node mappings up to this entity.
+	for (uint64 i{ _EntityToNodeMappings.Size() }; i <= entity->_EntityIdentifier; ++i)
+	{
+		_EntityToNodeMappings.Emplace(INVALID_NODE_INDEX);
+	}
+
+	const WorldTransform &world_transform{ WorldTransformComponent::Instance->InstanceData(entity)._CurrentWorldTransform };
+	const uint32 node_index{ static_cast<uint32>(_Entities.Size()) };
+
+	_Entities.Emplace(entity);
+	_ParentIndices.Emplace(INVALID_NODE_INDEX);
+	_LocalMatrices.Emplace(Matrix4x4());
+	_WorldMatrices.Emplace(world_transform.ToLocalMatrix4x4());
+	_WorldCells.Emplace(world_transform.GetCell());
+	_DirtyFlags.Emplace(static_cast<uint8>(1));
+
+	_EntityToNodeMappings[entity->_EntityIdentifier] = node_index;
+
+	_TopologyDirty = true;
+
+	return node_index;
+}
+
+/*
+*	Sets the parent of the given child internally. Returns false if the entities aren't ready yet and the request should be tried again later.
+*/
+NO_DISCARD bool TransformHierarchySystem::SetParentInternal(Entity *const RESTRICT child, Entity *const RESTRICT parent) NOEXCEPT
+{
+	//The world transforms are needed to keep the child where it is, so wait for the entities to be initialized.
+	if (!TEST_BIT(child->_Flags, Entity::Flags::INITIALIZED) || (parent && !TEST_BIT(parent->_Flags, Entity::Flags::INITIALIZED)))
+	{
+		return false;
+	}
+
+	ASSERT(WorldTransformComponent::Instance->Has(child), "Child in the transform hierarchy needs a world transform component!");
+	ASSERT(!parent || WorldTransformComponent::Instance->Has(parent), "Parent in the transform hierarchy needs a world transform component!");
+
+	uint32 child_node_index{ GetNodeIndex(child) };
+
+	//Detaching.
+	if (!parent)
+	{
+		if (child_node_index != INVALID_NODE_INDEX && _ParentIndices[child_node_index] != INVALID_NODE_INDEX)
+		{
+			//The world transform component already holds the last world transform, which the child keeps as a root.
+			_ParentIndices[child_node_index] = INVALID_NODE_INDEX;
+			_DirtyFlags[child_node_index] = 1;
+			_TopologyDirty = true;
+		}
+
+		return true;
+	}
+
+	uint32 parent_node_index{ GetNodeIndex(parent) };
+
+	//Reject parenting that would create a cycle, by walking up from the parent and looking for the child.
+	if (child_node_index != INVALID_NODE_INDEX)
+	{
+		for (uint32 node_index{ parent_node_index }; node_index != INVALID_NODE_INDEX; node_index = _ParentIndices[node_index])
+		{
+			if (node_index == child_node_index)
+			{
+				ASSERT(false, "Parenting would create a cycle in the transform hierarchy!");
+
+				return true;
+			}
+		}
+	}
+
+	if (child_node_index == INVALID_NODE_INDEX)
+	{
+		child_node_index = AddNode(child);
+	}
+
+	if (parent_node_index == INVALID_NODE_INDEX)
+	{
+		parent_node_index = AddNode(parent);
+	}
+
+	/*
+	*	Derive the local transform that keeps the child where it is.
+	*	Both matrices are relative to the child's cell, so the offset between the two is small even if they are far away from the origin.
+	*/
+	const WorldTransform &child_world_transform{ WorldTransformComponent::Instance->InstanceData(child)._CurrentWorldTransform };
+	const WorldTransform &parent_world_transform{ WorldTransformComponent::Instance->InstanceData(parent)._CurrentWorldTransform };
+
+	Matrix4x4 inverse_parent_matrix{ parent_world_transform.ToRelativeMatrix4x4(child_world_transform.GetCell()) };
+	inverse_parent_matrix.Inverse();
+
+	_LocalMatrices[child_node_index] = inverse_parent_matrix * child_world_transform.ToLocalMatrix4x4();
+	_ParentIndices[child_node_index] = parent_node_index;
+	_DirtyFlags[child_node_index] = 1;
+
+	_TopologyDirty = true;
+
+	return true;
+}
+
+/*
+*	Sets the local transform of the given entity internally.
+*/
+void TransformHierarchySystem::SetLocalTransformInternal(const SetLocalTransformRequest &request) NOEXCEPT
+{
+	const uint32 node_index{ GetNodeIndex(request._Entity) };
+
+	//Children have their local transform kept by the hierarchy.
+	if (node_index != INVALID_NODE_INDEX && _ParentIndices[node_index] != INVALID_NODE_INDEX)
+	{
+		_LocalMatrices[node_index] = Matrix4x4(request._Position, request._Rotation, request._Scale);
+		_DirtyFlags[node_index] = 1;
+
+		return;
+	}
+
+	//Roots own their world transform, so just write it straight through, keeping it in it's current cell.
+	if (!TEST_BIT(request._Entity->_Flags, Entity::Flags::INITIALIZED) || !WorldTransformComponent::Instance->Has(request._Entity))
+	{
+		return;
+	}
+
+	WorldTransform &world_transform{ WorldTransformComponent::Instance->InstanceData(request._Entity)._CurrentWorldTransform };
+
+	world_transform.SetWorldPosition(WorldPosition(world_transform.GetCell(), request._Position));
+	world_transform.SetRotation(request._Rotation);
+	world_transform.SetScale(request._Scale);
+}
+
+/*
+*	Takes all requests off the set parent and set local transform queues, appending them to the requests that haven't been carried out yet.
+*/
+void TransformHierarchySystem::DrainRequestQueues() NOEXCEPT
+{
+	{
+		Optional<SetParentRequest> request{ _SetParentQueue.Pop() };
+
+		while (request.Valid())
+		{
+			_SetParentRequests.Emplace(request.Get());
+
+			request = _SetParentQueue.Pop();
+		}
+	}
+
+	{
+		Optional<SetLocalTransformRequest> request{ _SetLocalTransformQueue.Pop() };
+
+		while (request.Valid())
+		{
+			_SetLocalTransformRequests.Emplace(request.Get());
+
+			request = _SetLocalTransformQueue.Pop();
+		}
+	}
+}
+
+/*
+*	Removes the given entity from the hierarchy internally. The entity is only compared against, never dereferenced.
+*/
+void TransformHierarchySystem::RemoveNodeInternal(const EntityIdentifier entity_identifier, const Entity *const RESTRICT entity) NOEXCEPT
+{
+	if (entity_identifier >= _EntityToNodeMappings.Size())
+	{
+		return;
+	}
+
+	const uint32 node_index{ _EntityToNodeMappings[entity_identifier] };
+
+	//Entity identifiers are reused, so make sure the node still belongs to this entity.
+	if (node_index == INVALID_NODE_INDEX || _Entities[node_index] != entity)
+	{
+		return;
+	}
+
+	//Just clear the node, rebuilding the nodes takes care of compacting them and detaching the children.
+	_EntityToNodeMappings[entity_identifier] = INVALID_NODE_INDEX;
+	_Entities[node_index] = nullptr;
+
+	_TopologyDirty = true;
+}
+
+/*
+*	Rebuilds the nodes, removing unused ones and sorting the rest by depth.
+*/
+void TransformHierarchySystem::RebuildNodes() NOEXCEPT
+{
+	PROFILING_SCOPE("TransformHierarchySystem::RebuildNodes");
+
+	const uint32 number_of_nodes{ static_cast<uint32>(_Entities.Size()) };
+
+	//Detach children of removed nodes, and count the children of the rest.
+	DynamicArray<uint32> number_of_children;
+	number_of_children.Resize<false>(number_of_nodes);
+	Memory::Set(number_of_children.Data(), 0, sizeof(uint32) * number_of_nodes);
+
+	for (uint32 node_index{ 0 }; node_index < number_of_nodes; ++node_index)
+	{
+		uint32 &parent_index{ _ParentIndices[node_index] };
+
+		if (parent_index != INVALID_NODE_INDEX && !_Entities[parent_index])
+		{
+			parent_index = INVALID_NODE_INDEX;
+		}
+
+		if (_Entities[node_index] && parent_index != INVALID_NODE_INDEX)
+		{
+			++number_of_children[parent_index];
+		}
+	}
+
+	//Calculate the depth of all nodes, walking up to the closest node with a known depth and filling in the depths on the way back down.
+	DynamicArray<uint32> depths;
+	depths.Resize<false>(number_of_nodes);
+	Memory::Set(depths.Data(), 0xff, sizeof(uint32) * number_of_nodes);
+
+	DynamicArray<uint32> chain;
+	uint32 number_of_depths{ 0 };
+
+	for (uint32 node_index{ 0 }; node_index < number_of_nodes; ++node_index)
+	{
+		chain.Clear();
+
+		uint32 current_index{ node_index };
+
+		while (depths[current_index] == INVALID_NODE_INDEX && _ParentIndices[current_index] != INVALID_NODE_INDEX)
+		{
+			chain.Emplace(current_index);
+			current_index = _ParentIndices[current_index];
+		}
+
+		if (depths[current_index] == INVALID_NODE_INDEX)
+		{
+			depths[current_index] = 0;
+		}
+
+		uint32 depth{ depths[current_index] };
+
+		while (!chain.Empty())
+		{
+			depths[chain.Back()] = ++depth;
+			chain.Pop();
+		}
+
+		number_of_depths = BaseMath::Maximum<uint32>(number_of_depths, depths[node_index] + 1);
+	}
+
+	//Removed nodes, and roots without any children, don't need to be in the hierarchy anymore.
+	DynamicArray<uint32> number_of_nodes_per_depth;
+	number_of_nodes_per_depth.Resize<false>(number_of_depths);
+	Memory::Set(number_of_nodes_per_depth.Data(), 0, sizeof(uint32) * number_of_depths);
+
+	for (uint32 node_index{ 0 }; node_index < number_of_nodes; ++node_index)
+	{
+		Entity *const RESTRICT entity{ _Entities[node_index] };
+
+		if (!entity)
+		{
+			continue;
+		}
+
+		if (_ParentIndices[node_index] == INVALID_NODE_INDEX && number_of_children[node_index] == 0)
+		{
+			_EntityToNodeMappings[entity->_EntityIdentifier] = INVALID_NODE_INDEX;
+			_Entities[node_index] = nullptr;
+
+			continue;
+		}
+
+		++number_of_nodes_per_depth[depths[node_index]];
+	}
+
+	//Lay the depths out one after the other.
+	_DepthStarts.Clear();
+
+	uint32 depth_start{ 0 };
+
+	for (uint32 depth{ 0 }; depth < number_of_depths; ++depth)
+	{
+		if (number_of_nodes_per_depth[depth] == 0)
+		{
+			break;
+		}
+
+		_DepthStarts.Emplace(depth_start);
+		depth_start += number_of_nodes_per_depth[depth];
+	}
+
+	_DepthStarts.Emplace(depth_start);
+
+	//Assign the new node indices, keeping the existing order within each depth.
+	DynamicArray<uint32> new_node_indices;
+	new_node_indices.Resize<false>(number_of_nodes);
+
+	{
+		DynamicArray<uint32> next_node_indices{ _DepthStarts };
+
+		for (uint32 node_index{ 0 }; node_index < number_of_nodes; ++node_index)
+		{
+			new_node_indices[node_index] = _Entities[node_index] ? next_node_indices[depths[node_index]]++ : INVALID_NODE_INDEX;
+		}
+	}
+
+	//Move the nodes over to their new indices.
+	const uint32 new_number_of_nodes{ depth_start };
+
+	DynamicArray<Entity *RESTRICT> new_entities;
+	DynamicArray<uint32> new_parent_indices;
+	DynamicArray<Matrix4x4> new_local_matrices;
+	DynamicArray<Matrix4x4> new_world_matrices;
+	DynamicArray<Vector3<int32>> new_world_cells;
+
+	new_entities.Resize<false>(new_number_of_nodes);
+	new_parent_indices.Resize<false>(new_number_of_nodes);
+	new_local_matrices.Resize<false>(new_number_of_nodes);
+	new_world_matrices.Resize<false>(new_number_of_nodes);
+	new_world_cells.Resize<false>(new_number_of_nodes);
+
+	for (uint32 node_index{ 0 }; node_index < number_of_nodes; ++node_index)
+	{
+		const uint32 new_node_index{ new_node_indices[node_index] };
+
+		if (new_node_index == INVALID_NODE_INDEX)
+		{
+			continue;
+		}
+
+		const uint32 parent_index{ _ParentIndices[node_index] };
+
+		new_entities[new_node_index] = _Entities[node_index];
+		new_parent_indices[new_node_index] = parent_index != INVALID_NODE_INDEX ? new_node_indices[parent_index] : INVALID_NODE_INDEX;
+		new_local_matrices[new_node_index] = _LocalMatrices[node_index];
+		new_world_matrices[new_node_index] = _WorldMatrices[node_index];
+		new_world_cells[new_node_index] = _WorldCells[node_index];
+
+		_EntityToNodeMappings[_Entities[node_index]->_EntityIdentifier] = new_node_index;
+	}
+
+	_Entities = std::move(new_entities);
+	_ParentIndices = std::move(new_parent_indices);
+	_LocalMatrices = std::move(new_local_matrices);
+	_WorldMatrices = std::move(new_world_matrices);
+	_WorldCells = std::move(new_world_cells);
+
+	//Everything moved around, so recalculate everything.
+	_DirtyFlags.Resize<false>(new_number_of_nodes);
+	Memory::Set(_DirtyFlags.Data(), 1, sizeof(uint8) * new_number_of_nodes);
+
+	_TopologyDirty = false;
+}
+
+/*
+*	Updates the roots from their world transform components.
+*/
+void TransformHierarchySystem::UpdateRoots() NOEXCEPT
+{
+	for (uint32 node_index{ _DepthStarts[0] }; node_index < _DepthStarts[1]; ++node_index)
+	{
+		const WorldTransform &world_transform{ WorldTransformComponent::Instance->InstanceData(_Entities[node_index])._CurrentWorldTransform };
+		const Matrix4x4 world_matrix{ world_transform.ToLocalMatrix4x4() };
+
+		if (world_matrix != _WorldMatrices[node_index] || world_transform.GetCell() != _WorldCells[node_index])
+		{
+			_WorldMatrices[node_index] = world_matrix;
+			_WorldCells[node_index] = world_transform.GetCell();
+			_DirtyFlags[node_index] = 1;
+		}
+	}
+}
+
+/*
+*	Propagates world transforms from the roots down to the leaves.
+*/
+void TransformHierarchySystem::Propagate() NOEXCEPT
+{
+	PROFILING_SCOPE("TransformHierarchySystem::Propagate");
+
+	//Every node in a depth only depends on the depth above it, so each depth can be split up freely.
+	for (uint64 depth{ 1 }; depth + 1 < _DepthStarts.Size(); ++depth)
+	{
+		const uint32 first_node_index{ _DepthStarts[depth] };
+		const uint32 last_node_index{ _DepthStarts[depth + 1] };
+
+		if (last_node_index - first_node_index <= TransformHierarchySystemConstants::NODES_PER_CHUNK)
+		{
+			PropagateRange(first_node_index, last_node_index);
+
+			continue;
+		}
+
+		PropagationRange propagation_range;
+
+		propagation_range._FirstNodeIndex = first_node_index;
+		propagation_range._LastNodeIndex = last_node_index;
+
+		//The next depth depends on this one, which ParallelFor waits for before returning.
+		TaskSystem::ParallelFor
+		(
+			Task::Priority::HIGH,
+			(last_node_index - first_node_index + TransformHierarchySystemConstants::NODES_PER_CHUNK - 1) / TransformHierarchySystemConstants::NODES_PER_CHUNK,
+			[](void *const RESTRICT arguments, const uint32 index)
+			{
+				const PropagationRange &range{ *static_cast<const PropagationRange *const RESTRICT>(arguments) };
+				const uint32 first_chunk_node_index{ range._FirstNodeIndex + index * TransformHierarchySystemConstants::NODES_PER_CHUNK };
+
+				TransformHierarchySystem::Instance->PropagateRange(first_chunk_node_index, BaseMath::Minimum<uint32>(first_chunk_node_index + TransformHierarchySystemConstants::NODES_PER_CHUNK, range._LastNodeIndex));
+			},
+			&propagation_range
+		);
+	}
+}
+
+/*
+*	Propagates world transforms for the given range of nodes, which all need to be of the same depth.
+*/
+void TransformHierarchySystem::PropagateRange(const uint32 first_node_index, const uint32 last_node_index) NOEXCEPT
+{
+	for (uint32 node_index{ first_node_index }; node_index < last_node_index; ++node_index)
+	{
+		const uint32 parent_index{ _ParentIndices[node_index] };
+
+		if (!_DirtyFlags[node_index] && !_DirtyFlags[parent_index])
+		{
+			continue;
+		}
+
+		//The world matrix comes out relative to the parent's cell.
+		Matrix4x4 world_matrix;
+		SIMD::MultiplyMatrix4x4(_WorldMatrices[parent_index].Data(), _LocalMatrices[node_index].Data(), world_matrix.Data());
+
+		//Move it into whichever cell the node actually ended up in.
+		const WorldPosition world_position{ _WorldCells[parent_index], world_matrix.GetTranslation() };
+
+		world_matrix.SetTranslation(world_position.GetLocalPosition());
+
+		_WorldMatrices[node_index] = world_matrix;
+		_WorldCells[node_index] = world_position.GetCell();
+		_DirtyFlags[node_index] = 1;
+
+		//Write it back to the world transform component, for everything else to see.
+		WorldTransform world_transform{ world_matrix };
+		world_transform.SetCell(world_position.GetCell());
+
+		WorldTransformComponent::Instance->InstanceData(_Entities[node_index])._CurrentWorldTransform = world_transform;
+	}
+}
\ No newline at end of file
@@ -6,27 +6,94 @@
 #include <Systems/InputSystem.h>
 #include <Systems/RenderingSystem.h>
 
+//UI system constants.
+namespace UISystemConstants
+{
+	constexpr uint32 HIT_TEST_GRID_WIDTH{ 32 };
+	constexpr uint32 HIT_TEST_GRID_HEIGHT{ 18 };
+}
+
+/*
+*	Calculates the hit test grid cell coordinates of the given position, clamped to the grid.
+*/
+FORCE_INLINE NO_DISCARD static Vector2<uint32> HitTestGridCell(const Vector2<float32> position) NOEXCEPT
+{
+	const float32 X{ position._X / UI::Constants::REFERENCE_RESOLUTION._X * static_cast<float32>(UISystemConstants::HIT_TEST_GRID_WIDTH) };
+	const float32 Y{ position._Y / UI::Constants::REFERENCE_RESOLUTION._Y * static_cast<float32>(UISystemConstants::HIT_TEST_GRID_HEIGHT) };
+
+	return Vector2<uint32>
+	(
+		static_cast<uint32>(BaseMath::Clamp<float32>(X, 0.0f, static_cast<float32>(UISystemConstants::HIT_TEST_GRID_WIDTH - 1))),
+		static_cast<uint32>(BaseMath::Clamp<float32>(Y, 0.0f, static_cast<float32>(UISystemConstants::HIT_TEST_GRID_HEIGHT - 1)))
+	);
+}
+
+/*
+*	Sets the state of the given clickable interface, and makes sure the widget is rendered again if it changed.
+*/
+FORCE_INLINE static void SetClickableInterfaceState(UI::Widget *const RESTRICT widget, UI::ClickableInterface *const RESTRICT clickable_interface, const UI::ClickableInterface::State state) NOEXCEPT
+{
+	if (clickable_interface->GetState() != state)
+	{
+		clickable_interface->SetState(widget, state);
+		widget->GetParent()->_RenderDirty = true;
+	}
+}
+
 /*
 *	Initializes the UI system.
 */
 void UISystem::Initialize() NOEXCEPT
 {
+	//Set up the upload state for each framebuffer.
+	_PendingUploadRanges.Upsize<false>(RenderingSystem::Instance->GetNumberOfFramebuffers());
+	_UploadedBuffers.Upsize<false>(RenderingSystem::Instance->GetNumberOfFramebuffers());
+
+	for (uint64 i{ 0 }; i < _PendingUploadRanges.Size(); ++i)
+	{
+		_PendingUploadRanges[i]._First = UINT64_MAXIMUM;
+		_PendingUploadRanges[i]._Second = 0;
+		_UploadedBuffers[i] = EMPTY_HANDLE;
+	}
+
 	//Register the storage buffer.
 	RenderingSystem::Instance->GetBufferManager()->RegisterStorageBuffer
 	(
 		HashString("UI"),
 		sizeof(UI::RenderCommand) * 1'024,
-		[](DynamicArray<byte> *const RESTRICT data, void *const RESTRICT)
+		[](StorageBufferWriter *const RESTRICT writer, void *const RESTRICT)
 		{
 			if (!UISystem::Instance->_RenderCommands.Empty())
 			{
-				data->Resize<false>(UISystem::Instance->_RenderCommands.Size() * sizeof(UI::RenderCommand));
-				Memory::Copy(data->Data(), UISystem::Instance->_RenderCommands.Data(), UISystem::Instance->_RenderCommands.Size() * sizeof(UI::RenderCommand));
-			}
-			
-			else
-			{
-				data->Clear();
+				const uint8 current_framebuffer_index{ RenderingSystem::Instance->GetCurrentFramebufferIndex() };
+				Pair<uint64, uint64> &pending_upload_range{ UISystem::Instance->_PendingUploadRanges[current_framebuffer_index] };
+				const uint64 number_of_render_commands{ UISystem::Instance->_RenderCommands.Size() };
+
+				const UploadSpan span{ writer->Reserve(number_of_render_commands * sizeof(UI::RenderCommand)) };
+
+				//The storage buffer is persistently mapped, so only render commands that has changed since this buffer was last written needs to be uploaded, unless it was re-created.
+				if (UISystem::Instance->_UploadedBuffers[current_framebuffer_index] != span._Buffer)
+				{
+					pending_upload_range._First = 0;
+					pending_upload_range._Second = number_of_render_commands;
+
+					UISystem::Instance->_UploadedBuffers[current_framebuffer_index] = span._Buffer;
+				}
+
+				const uint64 upload_end{ BaseMath::Minimum<uint64>(pending_upload_range._Second, number_of_render_commands) };
+
+				if (pending_upload_range._First < upload_end)
+				{
+					Memory::Copy
+					(
+						span._Data + pending_upload_range._First * sizeof(UI::RenderCommand),
+						&UISystem::Instance->_RenderCommands[pending_upload_range._First],
+						(upload_end - pending_upload_range._First) * sizeof(UI::RenderCommand)
+					);
+				}
+
+				pending_upload_range._First = UINT64_MAXIMUM;
+				pending_upload_range._Second = 0;
 			}
 		},
 		nullptr
@@ -92,8 +159,104 @@ void UISystem::Update(const UpdatePhase phase) NOEXCEPT
 	}
 }
 
+/*
+*	Rebuilds the hit test grid.
+*/
+void UISystem::RebuildHitTestGrid() NOEXCEPT
+{
+	//Gather the enabled widgets of all scenes, in the order they are rendered.
+	_HitTestWidgets.Clear();
+
+	for (const UI::Scene *const RESTRICT scene : _Scenes)
+	{
+		for (UI::Widget *const RESTRICT widget : scene->GetWidgets())
+		{
+			if (widget->IsEnabled())
+			{
+				_HitTestWidgets.Emplace(widget);
+			}
+		}
+	}
+
+	//Count the number of widgets overlapping each cell.
+	constexpr uint32 NUMBER_OF_CELLS{ UISystemConstants::HIT_TEST_GRID_WIDTH * UISystemConstants::HIT_TEST_GRID_HEIGHT };
+
+	_HitTestGridOffsets.Resize<false>(NUMBER_OF_CELLS + 1);
+	Memory::Set(_HitTestGridOffsets.Data(), 0, sizeof(uint32) * _HitTestGridOffsets.Size());
+
+	for (const UI::Widget *const RESTRICT widget : _HitTestWidgets)
+	{
+		const Vector2<uint32> minimum_cell{ HitTestGridCell(widget->GetAxisAlignedBoundingBox()._Minimum) };
+		const Vector2<uint32> maximum_cell{ HitTestGridCell(widget->GetAxisAlignedBoundingBox()._Maximum) };
+
+		for (uint32 Y{ minimum_cell._Y }; Y <= maximum_cell._Y; ++Y)
+		{
+			for (uint32 X{ minimum_cell._X }; X <= maximum_cell._X; ++X)
+			{
+				++_HitTestGridOffsets[Y * UISystemConstants::HIT_TEST_GRID_WIDTH + X + 1];
+			}
+		}
+	}
+
+	for (uint32 i{ 1 }; i <= NUMBER_OF_CELLS; ++i)
+	{
+		_HitTestGridOffsets[i] += _HitTestGridOffsets[i - 1];
+	}
+
+	//Fill in the entries, keeping the render order within each cell.
+	_HitTestGridEntries.Resize<false>(_HitTestGridOffsets.Back());
+
+	DynamicArray<uint32> cursors;
+	cursors.Resize<false>(NUMBER_OF_CELLS);
+	Memory::Copy(cursors.Data(), _HitTestGridOffsets.Data(), sizeof(uint32) * NUMBER_OF_CELLS);
+
+	for (uint32 widget_index{ 0 }, number_of_widgets{ static_cast<uint32>(_HitTestWidgets.Size()) }; widget_index < number_of_widgets; ++widget_index)
+	{
+		const UI::Widget *const RESTRICT widget{ _HitTestWidgets[widget_index] };
+
+		const Vector2<uint32> minimum_cell{ HitTestGridCell(widget->GetAxisAlignedBoundingBox()._Minimum) };
+		const Vector2<uint32> maximum_cell{ HitTestGridCell(widget->GetAxisAlignedBoundingBox()._Maximum) };
+
+		for (uint32 Y{ minimum_cell._Y }; Y <= maximum_cell._Y; ++Y)
+		{
+			for (uint32 X{ minimum_cell._X }; X <= maximum_cell._X; ++X)
+			{
+				_HitTestGridEntries[cursors[Y * UISystemConstants::HIT_TEST_GRID_WIDTH + X]++] = widget_index;
+			}
+		}
+	}
+
+	//Forget about active clickable interfaces whose widgets are gone, or have been disabled (which already made them idle).
+	for (uint64 i{ 0 }; i < _ActiveClickableInterfaces.Size();)
+	{
+		bool exists{ false };
+
+		for (const UI::Widget *const RESTRICT widget : _HitTestWidgets)
+		{
+			if (widget == _ActiveClickableInterfaces[i]._First)
+			{
+				exists = true;
+
+				break;
+			}
+		}
+
+		if (exists)
+		{
+			++i;
+		}
+
+		else
+		{
+			_ActiveClickableInterfaces.EraseAt<false>(i);
+		}
+	}
+}
+
 /*
 *	Updates widgets.
+*	Only the widgets in the hit test grid cell under the mouse can be hovered, so only those, and the ones that were hovered or pressed before, are updated.
+*	Clickable/scrollable interfaces are assumed to not extend outside of their widget's axis aligned bounding box.
 */
 void UISystem::UpdateWidgets() NOEXCEPT
 {
@@ -103,111 +266,147 @@ void UISystem::UpdateWidgets() NOEXCEPT
 	const ButtonState mouse_button_state{ mouse_state->_Left };
 	const int8 mouse_scroll_wheel_step{ mouse_state->_ScrollWheelStep };
 
+	//Retrieve the widgets that could be under the mouse.
+	const Vector2<uint32> mouse_cell{ HitTestGridCell(mouse_position) };
+	const uint32 cell_index{ mouse_cell._Y * UISystemConstants::HIT_TEST_GRID_WIDTH + mouse_cell._X };
+	const uint32 cell_start{ _HitTestGridOffsets.Empty() ? 0 : _HitTestGridOffsets[cell_index] };
+	const uint32 cell_end{ _HitTestGridOffsets.Empty() ? 0 : _HitTestGridOffsets[cell_index + 1] };
+
 	//Remember if we have already consumed input.
 	bool have_consumed_click_input{ false };
 	bool have_consumed_scroll_input{ false };
 
-	//Iterate through all scenes.
-	if (!_Scenes.Empty())
+	//Remember if a widget that is rendered on top has already covered the mouse position.
+	bool is_mouse_position_blocked{ false };
+
+	//Iterate through the widgets, top to bottom.
+	for (int64 entry_index{ static_cast<int64>(cell_end) - 1 }; entry_index >= static_cast<int64>(cell_start); --entry_index)
 	{
-		for (int64 scene_index{static_cast<int64>(_Scenes.Size() - 1)}; scene_index >= 0; --scene_index)
+		UI::Widget *const RESTRICT widget{ _HitTestWidgets[_HitTestGridEntries[entry_index]] };
+
+		for (UI::ClickableInterface *clickable_interface : widget->GetClickableInterfaces())
 		{
-			const UI::Scene *const RESTRICT scene{ _Scenes[scene_index] };
+			clickable_interface->SetMousePosition(mouse_position);
+		}
 
-			//Iterate through all of this scene's widgets.
-			const DynamicArray<UI::Widget *RESTRICT> &widgets{ scene->GetWidgets() };
+		if (!widget->IsEnabled())
+		{
+			continue;
+		}
 
-			if (!widgets.Empty())
+		//Update clickable interfaces.
+		for (UI::ClickableInterface *const RESTRICT clickable_interface : widget->GetClickableInterfaces())
+		{
+			if (have_consumed_click_input)
 			{
-				for (int64 widget_index{ static_cast<int64>(widgets.Size() - 1) }; widget_index >= 0; --widget_index)
-				{
-					UI::Widget *const RESTRICT widget{ widgets[widget_index] };
-
-					for (UI::ClickableInterface *clickable_interface : widget->GetClickableInterfaces())
-					{
-						clickable_interface->SetMousePosition(mouse_position);
-					}
-
-					if (!widget->IsEnabled())
-					{
-						continue;
-					}
+				SetClickableInterfaceState(widget, clickable_interface, UI::ClickableInterface::State::IDLE);
+			}
 
-					//Update clickable interfaces.
-					for (UI::ClickableInterface *const RESTRICT clickable_interface : widget->GetClickableInterfaces())
+			else
+			{
+				if (clickable_interface->_IsInside(widget, clickable_interface, mouse_position) && !is_mouse_position_blocked)
+				{
+					if (mouse_button_state == ButtonState::PRESSED)
 					{
-						if (have_consumed_click_input)
+						if (clickable_interface->GetState() == UI::ClickableInterface::State::HOVERED)
 						{
-							clickable_interface->SetState(widget, UI::ClickableInterface::State::IDLE);
+							SetClickableInterfaceState(widget, clickable_interface, UI::ClickableInterface::State::PRESSED);
 						}
 
 						else
 						{
-							if (clickable_interface->_IsInside(widget, clickable_interface, mouse_position) && !AnyWidgetBlockingPosition(mouse_position, widget))
-							{
-								if (mouse_button_state == ButtonState::PRESSED)
-								{
-									if (clickable_interface->GetState() == UI::ClickableInterface::State::HOVERED)
-									{
-										clickable_interface->SetState(widget, UI::ClickableInterface::State::PRESSED);
-									}
-
-									else
-									{
-										clickable_interface->SetState(widget, UI::ClickableInterface::State::HOVERED);
-									}
-								}
-
-								else if (mouse_button_state == ButtonState::PRESSED_HELD)
-								{
-									//The clickable can only go from hovered to pressed if it was first hovered, and then actually pressed.
-									if (clickable_interface->GetState() != UI::ClickableInterface::State::PRESSED)
-									{
-										clickable_interface->SetState(widget, UI::ClickableInterface::State::HOVERED);
-									}
-								}
-
-								else
-								{
-									clickable_interface->SetState(widget, UI::ClickableInterface::State::HOVERED);
-								}
-
-								have_consumed_click_input = true;
-							}
-
-							else
-							{
-								clickable_interface->SetState(widget, UI::ClickableInterface::State::IDLE);
-							}
+							SetClickableInterfaceState(widget, clickable_interface, UI::ClickableInterface::State::HOVERED);
 						}
 					}
 
-					//Update scrollable interfaces.
-					if (!have_consumed_scroll_input && mouse_scroll_wheel_step != 0)
+					else if (mouse_button_state == ButtonState::PRESSED_HELD)
 					{
-						if (UI::ScrollableInterface *const RESTRICT scrollable_interface{ widget->GetScrollableInterface() })
+						//The clickable can only go from hovered to pressed if it was first hovered, and then actually pressed.
+						if (clickable_interface->GetState() != UI::ClickableInterface::State::PRESSED)
 						{
-							if (scrollable_interface->_IsInside(widget, mouse_position))
-							{ 
-								if (mouse_scroll_wheel_step < 0)
-								{
-									scrollable_interface->OnScrollDown();
-								}
-
-								else if (mouse_scroll_wheel_step > 0)
-								{
-									scrollable_interface->OnScrollUp();
-								}
-
-								have_consumed_scroll_input = true;
-							}
+							SetClickableInterfaceState(widget, clickable_interface, UI::ClickableInterface::State::HOVERED);
 						}
 					}
+
+					else
+					{
+						SetClickableInterfaceState(widget, clickable_interface, UI::ClickableInterface::State::HOVERED);
+					}
+
+					have_consumed_click_input = true;
+				}
+
+				else
+				{
+					SetClickableInterfaceState(widget, clickable_interface, UI::ClickableInterface::State::IDLE);
+				}
+			}
+		}
+
+		//Update scrollable interfaces.
+		if (!have_consumed_scroll_input && mouse_scroll_wheel_step != 0)
+		{
+			if (UI::ScrollableInterface *const RESTRICT scrollable_interface{ widget->GetScrollableInterface() })
+			{
+				if (scrollable_interface->_IsInside(widget, mouse_position))
+				{ 
+					if (mouse_scroll_wheel_step < 0)
+					{
+						scrollable_interface->OnScrollDown();
+					}
+
+					else if (mouse_scroll_wheel_step > 0)
+					{
+						scrollable_interface->OnScrollUp();
+					}
+
+					have_consumed_scroll_input = true;
 				}
 			}
 		}
+
+		//Widgets further down can't be interacted with where this widget is.
+		is_mouse_position_blocked |= widget->GetAxisAlignedBoundingBox().IsInside(mouse_position);
+	}
+
+	//Clickable interfaces that were active, but are no longer under the mouse, goes back to idle.
+	for (const Pair<UI::Widget *RESTRICT, UI::ClickableInterface *RESTRICT> &active_clickable_interface : _ActiveClickableInterfaces)
+	{
+		active_clickable_interface._Second->SetMousePosition(mouse_position);
+
+		bool is_under_mouse{ false };
+
+		for (uint32 entry_index{ cell_start }; entry_index < cell_end; ++entry_index)
+		{
+			if (_HitTestWidgets[_HitTestGridEntries[entry_index]] == active_clickable_interface._First)
+			{
+				is_under_mouse = true;
+
+				break;
+			}
+		}
+
+		if (!is_under_mouse)
+		{
+			SetClickableInterfaceState(active_clickable_interface._First, active_clickable_interface._Second, UI::ClickableInterface::State::IDLE);
+		}
+	}
+
+	//Remember the clickable interfaces that are now active.
+	_ActiveClickableInterfaces.Clear();
+
+	for (uint32 entry_index{ cell_start }; entry_index < cell_end; ++entry_index)
+	{
+		UI::Widget *const RESTRICT widget{ _HitTestWidgets[_HitTestGridEntries[entry_index]] };
+
+		for (UI::ClickableInterface *const RESTRICT clickable_interface : widget->GetClickableInterfaces())
+		{
+			if (clickable_interface->GetState() != UI::ClickableInterface::State::IDLE)
+			{
+				_ActiveClickableInterfaces.Emplace(widget, clickable_interface);
+			}
+		}
 	}
-	
 }
 
 /*
@@ -215,6 +414,9 @@ void UISystem::UpdateWidgets() NOEXCEPT
 */
 void UISystem::UpdateUserInterface() NOEXCEPT
 {
+	//Remember if the hit test grid needs to be rebuilt.
+	bool hit_test_grid_dirty{ false };
+
 	//Process the add scene requests.
 	{
 		Optional<UI::Scene *RESTRICT> add_scene_request{ _AddSceneRequests.Pop() };
@@ -238,33 +440,40 @@ void UISystem::UpdateUserInterface() NOEXCEPT
 			_Scenes.Erase<true>(scene);
 			delete scene;
 
+			//The widgets of the scene are gone, so the hit test grid must be rebuilt before anything else touches them.
+			hit_test_grid_dirty = true;
+
 			remove_scene_request = _RemoveSceneRequests.Pop();
 		}
 	}
 
-	//Prepare all scenes for building.
-	for (UI::Scene *const RESTRICT scene : _Scenes)
-	{
-		scene->PrepareBuild();
-	}
-
-	//Prepare the widget allocator.
-	_WidgetAllocator.Prepare();
-
 	//Set up the build context.
 	UI::BuildContext context;
 
 	context._DeltaTime = CatalystEngineSystem::Instance->GetDeltaTime();
-	context._WidgetAllocator = &_WidgetAllocator;
 
-	//Build all scenes.
+	//Build all scenes that needs to be built.
 	for (UI::Scene *const RESTRICT scene : _Scenes)
 	{
+		if (!scene->NeedsBuild())
+		{
+			continue;
+		}
+
+		context._WidgetAllocator = scene->GetWidgetAllocator();
+
+		scene->PrepareBuild();
 		scene->Build(context);
+		scene->FinishBuild();
+
+		hit_test_grid_dirty = true;
 	}
 
-	//Clean the widget allocator.
-	_WidgetAllocator.Clean();
+	//Rebuild the hit test grid, if necessary.
+	if (hit_test_grid_dirty)
+	{
+		RebuildHitTestGrid();
+	}
 
 	//Update the widgets.
 	UpdateWidgets();
@@ -279,10 +488,15 @@ void UISystem::UpdatePreRender() NOEXCEPT
 	_RenderCommands.Clear();
 
 	//Set up the context.
+	uint64 changed_render_commands_start{ UINT64_MAXIMUM };
+	uint64 changed_render_commands_end{ 0 };
+
 	UI::RenderContext context;
 
 	context._DeltaTime = CatalystEngineSystem::Instance->GetDeltaTime();
 	context._RenderCommands = &_RenderCommands;
+	context._ChangedRenderCommandsStart = &changed_render_commands_start;
+	context._ChangedRenderCommandsEnd = &changed_render_commands_end;
 
 	//Render all scenes!
 	for (UI::Scene *const RESTRICT scene : _Scenes)
@@ -290,53 +504,13 @@ void UISystem::UpdatePreRender() NOEXCEPT
 		scene->Render(context);
 	}
 
-	//Go through all render commands and make them ready for rendering.
-	for (UI::RenderCommand &render_command : _RenderCommands)
+	//Every framebuffer needs to receive the changed render commands.
+	if (changed_render_commands_start < changed_render_commands_end)
 	{
-		//Flip position and transform into clip space.
-		for (Vector4<float32> &position : render_command._Positions)
+		for (Pair<uint64, uint64> &pending_upload_range : _PendingUploadRanges)
 		{
-			position._X /= UI::Constants::REFERENCE_RESOLUTION._X;
-			position._Y /= UI::Constants::REFERENCE_RESOLUTION._Y;
-
-			position._Y = 1.0f - position._Y;
-
-			position._X = position._X * 2.0f - 1.0f;
-			position._Y = position._Y * 2.0f - 1.0f;
+			pending_upload_range._First = BaseMath::Minimum<uint64>(pending_upload_range._First, changed_render_commands_start);
+			pending_upload_range._Second = BaseMath::Maximum<uint64>(pending_upload_range._Second, changed_render_commands_end);
 		}
 	}
-}
-
-/*
-*	Returns if any widget is blocking the given position for the given widget.
-*/
-NO_DISCARD bool UISystem::AnyWidgetBlockingPosition(const Vector2<float32> position, const UI::Widget *const RESTRICT widget) NOEXCEPT
-{
-	for (int64 scene_index{ static_cast<int64>(_Scenes.Size() - 1) }; scene_index >= 0; --scene_index)
-	{
-		const UI::Scene *const RESTRICT scene{ _Scenes[scene_index] };
-
-		//Iterate through all of this scene's widgets.
-		const DynamicArray<UI::Widget *RESTRICT> &widgets{ scene->GetWidgets() };
-
-		if (!widgets.Empty())
-		{
-			for (int64 widget_index{ static_cast<int64>(widgets.Size() - 1) }; widget_index >= 0; --widget_index)
-			{
-				UI::Widget *const RESTRICT _widget{ widgets[widget_index] };
-
-				if (_widget == widget)
-				{
-					return false;
-				}
-
-				if (_widget->IsEnabled() && _widget->GetAxisAlignedBoundingBox().IsInside(position))
-				{
-					return true;
-				}
-			}
-		}
-	}
-
-	return false;
 }
\ No newline at end of file
@@ -0,0 +1,626 @@
+//Header file.
+#include <Terrain/TerrainErosion.h>
+
+//Core.
+#include <Core/Algorithms/HashAlgorithms.h>
+#include <Core/Containers/StaticArray.h>
+
+//Math.
+#include <Math/Core/CatalystRandomMath.h>
+
+//Profiling.
+#include <Profiling/Profiling.h>
+
+//Systems.
+#include <Systems/TaskSystem.h>
+
+//Terrain erosion constants.
+namespace TerrainErosionConstants
+{
+	//The radius, in texels, that erosion is spread over.
+	constexpr int32 EROSION_RADIUS{ 2 };
+
+	/*
+	*	How far outside of a particle's path it can read or write.
+	*	Covers the erosion radius plus the extra texel read by gradients and written by deposits.
+	*/
+	constexpr uint32 PARTICLE_REACH{ EROSION_RADIUS + 1 };
+
+	//The number of tile phases. Tiles are split into a 2x2 checkerboard so that no two neighbouring tiles run at the same time.
+	constexpr uint8 NUMBER_OF_PHASES{ 4 };
+
+	//The number of row chunks to split the thermal erosion into per task executor, to even out the load.
+	constexpr uint32 THERMAL_CHUNKS_PER_EXECUTOR{ 4 };
+
+	//The normalizer for turning 24 bits of a hash into a float in the range [0.0f, 1.0f).
+	constexpr float32 HASH_NORMALIZER{ 1.0f / static_cast<float32>(1 << 24) };
+}
+
+/*
+*	Particle class definition.
+*/
+class Particle final
+{
+
+public:
+
+	//The position.
+	Vector2<float32> _Position;
+
+	//The direction.
+	Vector2<float32> _Direction;
+
+	//The velocity.
+	float32 _Velocity;
+
+	//The water.
+	float32 _Water;
+
+	//The sediment.
+	float32 _Sediment;
+
+};
+
+/*
+*	Erosion tile class definition.
+*/
+class ErosionTile final
+{
+
+public:
+
+	//The spawn points for this tile.
+	const Vector2<float32> *RESTRICT _Points;
+
+	//The number of spawn points for this tile.
+	uint64 _NumberOfPoints;
+
+};
+
+/*
+*	Hydraulic erosion context class definition.
+*/
+class HydraulicErosionContext final
+{
+
+public:
+
+	//The parameters.
+	const TerrainErosion::Parameters *RESTRICT _Parameters;
+
+	//The height map.
+	Texture2D<float32> *RESTRICT _HeightMap;
+
+	//The tiles of the current phase.
+	const ErosionTile *RESTRICT _Tiles;
+
+};
+
+/*
+*	Thermal erosion context class definition.
+*/
+class ThermalErosionContext final
+{
+
+public:
+
+	//The parameters.
+	const TerrainErosion::Parameters *RESTRICT _Parameters;
+
+	//The width of the height map.
+	uint32 _Width;
+
+	//The source heights.
+	const float32 *RESTRICT _Source;
+
+	//The destination heights.
+	float32 *RESTRICT _Destination;
+
+	//The number of rows in each chunk.
+	uint32 _RowsPerChunk;
+
+};
+
+/*
+*	Returns the gradient.
+*/
+FORCE_INLINE static void CalculateGradient(const Texture2D<float32> *const RESTRICT height_map, const Vector2<float32> position, Vector2<float32> *const RESTRICT gradient_direction, float32 *const RESTRICT gradient_height) NOEXCEPT
+{
+	const int32 maximum_x{ static_cast<int32>(height_map->GetWidth()) - 1 };
+	const int32 maximum_y{ static_cast<int32>(height_map->GetHeight()) - 1 };
+
+	const Vector2<int32> lower_left_coordinate{ BaseMath::Clamp<int32>(static_cast<int32>(position._X), 0, maximum_x), BaseMath::Clamp<int32>(static_cast<int32>(position._Y), 0, maximum_y) };
+	const Vector2<int32> upper_left_coordinate{ BaseMath::Clamp<int32>(static_cast<int32>(position._X), 0, maximum_x), BaseMath::Clamp<int32>(static_cast<int32>(position._Y) + 1, 0, maximum_y) };
+	const Vector2<int32> lower_right_coordinate{ BaseMath::Clamp<int32>(static_cast<int32>(position._X) + 1, 0, maximum_x), BaseMath::Clamp<int32>(static_cast<int32>(position._Y), 0, maximum_y) };
+	const Vector2<int32> upper_right_coordinate{ BaseMath::Clamp<int32>(static_cast<int32>(position._X) + 1, 0, maximum_x), BaseMath::Clamp<int32>(static_cast<int32>(position._Y) + 1, 0, maximum_y) };
+
+	const float32 lower_left_height{ height_map->At(lower_left_coordinate._X, lower_left_coordinate._Y) };
+	const float32 upper_left_height{ height_map->At(upper_left_coordinate._X, upper_left_coordinate._Y) };
+	const float32 lower_right_height{ height_map->At(lower_right_coordinate._X, lower_right_coordinate._Y) };
+	const float32 upper_right_height{ height_map->At(upper_right_coordinate._X, upper_right_coordinate._Y) };
+
+	const float32 horizontal_alpha{ BaseMath::Fractional(position._X) };
+	const float32 vertical_alpha{ BaseMath::Fractional(position._Y) };
+
+	gradient_direction->_X = (lower_right_height - lower_left_height) * (1.0f - vertical_alpha) + (upper_right_height - upper_left_height) * vertical_alpha;
+	gradient_direction->_Y = (upper_left_height - lower_left_height) * (1.0f - horizontal_alpha) + (upper_right_height - lower_right_height) * horizontal_alpha;
+
+	gradient_direction->_X = -gradient_direction->_X;
+	gradient_direction->_Y = -gradient_direction->_Y;
+
+	(*gradient_height) =	lower_left_height * (1.0f - horizontal_alpha) * (1.0f - vertical_alpha)
+							+ lower_right_height * horizontal_alpha * (1.0f - vertical_alpha)
+							+ upper_left_height * (1.0f - horizontal_alpha) * vertical_alpha
+							+ upper_right_height * horizontal_alpha * vertical_alpha;
+}
+
+/*
+*	Erodes at the given position.
+*/
+FORCE_INLINE static void Erode(Texture2D<float32> *const RESTRICT height_map, const Vector2<float32> position, const float32 amount) NOEXCEPT
+{
+	constexpr int32 RADIUS{ TerrainErosionConstants::EROSION_RADIUS };
+
+	struct ErosionPosition
+	{
+		Vector2<uint32> _Coordinate;
+		float32 _Weight;
+	};
+
+	const Vector2<float32> center{ static_cast<float32>(static_cast<uint32>(position._X)) + 0.5f, static_cast<float32>(static_cast<uint32>(position._Y)) + 0.5f };
+
+	StaticArray<ErosionPosition, (1 + (RADIUS * 2)) * (1 + (RADIUS * 2))> erosion_positions;
+	uint32 number_of_erosion_positions{ 0 };
+
+	float32 weight_sum{ 0.0f };
+
+	for (int32 Y{ -RADIUS }; Y <= RADIUS; ++Y)
+	{
+		for (int32 X{ -RADIUS }; X <= RADIUS; ++X)
+		{
+			const Vector2<float32> sample_position{ position._X + static_cast<float32>(X), position._Y + static_cast<float32>(Y) };
+
+			if (sample_position._X < 0.0f || sample_position._X >= static_cast<float32>(height_map->GetWidth()) || sample_position._Y < 0 || sample_position._Y >= static_cast<float32>(height_map->GetHeight()))
+			{
+				continue;
+			}
+
+			const float32 distance{ Vector2<float32>::Length(sample_position - center) };
+			const float32 weight{ 1.0f - BaseMath::Minimum<float32>(distance / static_cast<float32>(RADIUS), 1.0f) };
+
+			if (weight > 0.0f)
+			{
+				erosion_positions[number_of_erosion_positions]._Coordinate = Vector2<uint32>(static_cast<uint32>(sample_position._X), static_cast<uint32>(sample_position._Y));
+				erosion_positions[number_of_erosion_positions]._Weight = weight;
+
+				++number_of_erosion_positions;
+
+				weight_sum += weight;
+			}
+		}
+	}
+
+	const float32 weight_multiplier{ 1.0f / weight_sum };
+
+	for (uint32 erosion_position_index{ 0 }; erosion_position_index < number_of_erosion_positions; ++erosion_position_index)
+	{
+		ErosionPosition &erosion_position{ erosion_positions[erosion_position_index] };
+
+		erosion_position._Weight *= weight_multiplier;
+
+		height_map->At(erosion_position._Coordinate._X, erosion_position._Coordinate._Y) -= amount * erosion_position._Weight;
+	}
+}
+
+/*
+*	Deposits at the given position.
+*/
+FORCE_INLINE static void Deposit(Texture2D<float32> *const RESTRICT height_map, const Vector2<float32> position, const float32 amount) NOEXCEPT
+{
+	const Vector2<uint32> lower_left_coordinate{ BaseMath::Minimum<uint32>(static_cast<uint32>(position._X), height_map->GetWidth() - 1), BaseMath::Minimum<uint32>(static_cast<uint32>(position._Y), height_map->GetHeight() - 1) };
+	const Vector2<uint32> upper_left_coordinate{ BaseMath::Minimum<uint32>(static_cast<uint32>(position._X), height_map->GetWidth() - 1), BaseMath::Minimum<uint32>(static_cast<uint32>(position._Y) + 1, height_map->GetHeight() - 1) };
+	const Vector2<uint32> lower_right_coordinate{ BaseMath::Minimum<uint32>(static_cast<uint32>(position._X) + 1, height_map->GetWidth() - 1), BaseMath::Minimum<uint32>(static_cast<uint32>(position._Y), height_map->GetHeight() - 1) };
+	const Vector2<uint32> upper_right_coordinate{ BaseMath::Minimum<uint32>(static_cast<uint32>(position._X) + 1, height_map->GetWidth() - 1), BaseMath::Minimum<uint32>(static_cast<uint32>(position._Y) + 1, height_map->GetHeight() - 1) };
+
+	const float32 horizontal_alpha{ BaseMath::Fractional(position._X) };
+	const float32 vertical_alpha{ BaseMath::Fractional(position._Y) };
+
+	height_map->At(lower_left_coordinate._X, lower_left_coordinate._Y) += (amount * (1.0f - horizontal_alpha) * (1.0f - vertical_alpha));
+	height_map->At(upper_left_coordinate._X, upper_left_coordinate._Y) += (amount * (1.0f - horizontal_alpha) * vertical_alpha);
+	height_map->At(lower_right_coordinate._X, lower_right_coordinate._Y) += (amount * horizontal_alpha * (1.0f - vertical_alpha));
+	height_map->At(upper_right_coordinate._X, upper_right_coordinate._Y) += (amount * horizontal_alpha * vertical_alpha);
+}
+
+/*
+*	Simulates a single particle from the given spawn position until it dies or leaves the bounds.
+*/
+FORCE_INLINE static void SimulateParticle(const TerrainErosion::Parameters &parameters, const Vector2<float32> spawn_position, Texture2D<float32> *const RESTRICT height_map) NOEXCEPT
+{
+	Particle particle;
+
+	particle._Position = spawn_position;
+	particle._Direction._X = 0.0f;
+	particle._Direction._Y = 0.0f;
+	particle._Velocity = 0.0f;
+	particle._Water = 1.0f;
+	particle._Sediment = 0.0f;
+
+	for (uint64 particle_lifetime_index{ 0 }; particle_lifetime_index < parameters._MaximumParticleLifetime; ++particle_lifetime_index)
+	{
+		//Remember the original position.
+		const Vector2<float32> original_position{ particle._Position };
+
+		//Calculate the old gradient direction/height.
+		Vector2<float32> old_gradient_direction;
+		float32 old_gradient_height;
+		CalculateGradient(height_map, particle._Position, &old_gradient_direction, &old_gradient_height);
+
+		//Update the direction of the particle.
+		particle._Direction = particle._Direction * parameters._Inertia + old_gradient_direction * (1.0f - parameters._Inertia);
+		particle._Direction.Normalize();
+
+		//Update the position of the particle.
+		particle._Position += particle._Direction;
+
+		//Break if the particle has wandered outside the bounds.
+		if (particle._Position._X < static_cast<float32>(parameters._MinimumBounds._X) || particle._Position._X > static_cast<float32>(parameters._MaximumBounds._X)
+			|| particle._Position._Y < static_cast<float32>(parameters._MinimumBounds._Y) || particle._Position._Y > static_cast<float32>(parameters._MaximumBounds._Y))
+		{
+			break;
+		}
+
+		//Break if the paticle has no direction.
+		if (particle._Direction._X == 0.0f && particle._Direction._Y == 0.0f)
+		{
+			break;
+		}
+
+		//Calculate the new gradient direction/height.
+		Vector2<float32> new_gradient_direction;
+		float32 new_gradient_height;
+		CalculateGradient(height_map, particle._Position, &new_gradient_direction, &new_gradient_height);
+
+		//Calculate the delta height.
+		const float32 delta_height{ new_gradient_height - old_gradient_height };
+
+		//Calculate the sediment capacity.
+		const float32 sediment_capacity{ -delta_height * particle._Velocity * particle._Water * parameters._Capacity };
+
+		//Should this particle deposit?
+		if (particle._Sediment > sediment_capacity || delta_height > 0.0f)
+		{
+			const float32 deposit_amount{ delta_height > 0.0f ? BaseMath::Minimum<float32>(delta_height, particle._Sediment) : BaseMath::Minimum<float32>((particle._Sediment - sediment_capacity) * parameters._Deposition, -delta_height) };
+			ASSERT(deposit_amount >= 0.0f, "Deposit amount is negative!");
+			Deposit(height_map, original_position, deposit_amount);
+			particle._Sediment -= deposit_amount;
+		}
+
+		//Otherwise, erade a fraction of the particle's current carry capacity.
+		else
+		{
+			const float32 erode_amount{ BaseMath::Minimum<float32>((sediment_capacity - particle._Sediment) * parameters._Erosion, -delta_height) };
+			ASSERT(erode_amount >= 0.0f, "Erode amount is negative!");
+			Erode(height_map, original_position, erode_amount);
+			particle._Sediment += erode_amount;
+		}
+
+		//Update the particle's velocity.
+		particle._Velocity = std::sqrt(BaseMath::Maximum<float32>(particle._Velocity * particle._Velocity - delta_height * parameters._Gravity, 0.0f));
+		ASSERT(!BaseMath::IsNaN(particle._Velocity), "NaN detected!");
+
+		//Evaporate.
+		particle._Water *= (1.0f - parameters._Evaporation);
+	}
+}
+
+/*
+*	Calculates how much material flows from the given texel to each of it's four neighbours during thermal erosion.
+*	The flows are ordered left, right, down, up, so the opposite direction of flow N is N ^ 1.
+*/
+FORCE_INLINE static void CalculateThermalFlows(const TerrainErosion::Parameters &parameters, const uint32 width, const float32 *const RESTRICT heights, const uint32 X, const uint32 Y, StaticArray<float32, 4> *const RESTRICT flows) NOEXCEPT
+{
+	const float32 height{ heights[X + Y * width] };
+
+	StaticArray<bool, 4> valid
+	{
+		X > parameters._MinimumBounds._X,
+		X < parameters._MaximumBounds._X,
+		Y > parameters._MinimumBounds._Y,
+		Y < parameters._MaximumBounds._Y
+	};
+
+	StaticArray<uint64, 4> neighbour_indices
+	{
+		valid[0] ? (X - 1) + Y * width : 0,
+		valid[1] ? (X + 1) + Y * width : 0,
+		valid[2] ? X + (Y - 1) * width : 0,
+		valid[3] ? X + (Y + 1) * width : 0
+	};
+
+	float32 maximum_difference{ 0.0f };
+	float32 total_excess{ 0.0f };
+
+	for (uint8 i{ 0 }; i < 4; ++i)
+	{
+		(*flows)[i] = 0.0f;
+
+		if (!valid[i])
+		{
+			continue;
+		}
+
+		const float32 difference{ height - heights[neighbour_indices[i]] };
+		const float32 excess{ difference - parameters._TalusSlope };
+
+		if (excess > 0.0f)
+		{
+			(*flows)[i] = excess;
+			total_excess += excess;
+			maximum_difference = BaseMath::Maximum<float32>(maximum_difference, difference);
+		}
+	}
+
+	if (total_excess == 0.0f)
+	{
+		return;
+	}
+
+	//Move at most half of the excess along the steepest slope, so the texels don't overshoot each other.
+	const float32 amount{ parameters._ThermalRate * (maximum_difference - parameters._TalusSlope) * 0.5f };
+	const float32 multiplier{ amount / total_excess };
+
+	for (uint8 i{ 0 }; i < 4; ++i)
+	{
+		(*flows)[i] *= multiplier;
+	}
+}
+
+/*
+*	Runs hydraulic erosion over the tiles, one phase at a time.
+*/
+FORCE_INLINE static void SimulateHydraulicErosion(const TerrainErosion::Parameters &parameters, const uint64 seed, Texture2D<float32> *const RESTRICT height_map) NOEXCEPT
+{
+	PROFILING_SCOPE("TerrainErosion::SimulateHydraulicErosion");
+
+	//Calculate the tiles. Tiles in the same phase are one tile apart, so a tile needs to be twice the particle reach.
+	const uint32 reach{ static_cast<uint32>(parameters._MaximumParticleLifetime) + TerrainErosionConstants::PARTICLE_REACH };
+	const uint32 tile_size{ BaseMath::Maximum<uint32>(parameters._TileSize, reach * 2) };
+	const Vector2<uint32> area{ parameters._MaximumBounds._X - parameters._MinimumBounds._X + 1, parameters._MaximumBounds._Y - parameters._MinimumBounds._Y + 1 };
+	const Vector2<uint32> number_of_tiles{ (area._X + tile_size - 1) / tile_size, (area._Y + tile_size - 1) / tile_size };
+	const uint32 total_number_of_tiles{ number_of_tiles._X * number_of_tiles._Y };
+
+	/*
+	*	Generate the spawn points, one per cell in a jittered grid.
+	*	Each point is derived from a hash of the seed and the cell index, so it doesn't depend on the order anything is processed in.
+	*/
+	const uint32 grid_resolution{ BaseMath::Maximum<uint32>(static_cast<uint32>(std::ceil(1.0f / parameters._MinimumDistanceBetweenPoints)), 1) };
+	const uint64 number_of_points{ static_cast<uint64>(grid_resolution) * grid_resolution };
+
+	DynamicArray<Vector2<float32>> points;
+	DynamicArray<uint32> point_tile_indices;
+
+	points.Resize<false>(number_of_points);
+	point_tile_indices.Resize<false>(number_of_points);
+
+	DynamicArray<uint64> tile_point_offsets;
+	tile_point_offsets.Resize<false>(total_number_of_tiles + 1);
+	Memory::Set(tile_point_offsets.Data(), 0, sizeof(uint64) * tile_point_offsets.Size());
+
+	for (uint64 point_index{ 0 }; point_index < number_of_points; ++point_index)
+	{
+		const uint64 hash{ HashAlgorithms::MurmurHash64(&point_index, sizeof(uint64), seed) };
+		const float32 jitter_x{ static_cast<float32>(hash & 0xFFFFFF) * TerrainErosionConstants::HASH_NORMALIZER };
+		const float32 jitter_y{ static_cast<float32>((hash >> 24) & 0xFFFFFF) * TerrainErosionConstants::HASH_NORMALIZER };
+
+		const float32 normalized_x{ (static_cast<float32>(point_index % grid_resolution) + jitter_x) / static_cast<float32>(grid_resolution) };
+		const float32 normalized_y{ (static_cast<float32>(point_index / grid_resolution) + jitter_y) / static_cast<float32>(grid_resolution) };
+
+		Vector2<float32> &point{ points[point_index] };
+
+		point._X = BaseMath::LinearlyInterpolate<float32>(static_cast<float32>(parameters._MinimumBounds._X), static_cast<float32>(parameters._MaximumBounds._X), normalized_x);
+		point._Y = BaseMath::LinearlyInterpolate<float32>(static_cast<float32>(parameters._MinimumBounds._Y), static_cast<float32>(parameters._MaximumBounds._Y), normalized_y);
+
+		const uint32 tile_x{ BaseMath::Minimum<uint32>(static_cast<uint32>(point._X - static_cast<float32>(parameters._MinimumBounds._X)) / tile_size, number_of_tiles._X - 1) };
+		const uint32 tile_y{ BaseMath::Minimum<uint32>(static_cast<uint32>(point._Y - static_cast<float32>(parameters._MinimumBounds._Y)) / tile_size, number_of_tiles._Y - 1) };
+
+		point_tile_indices[point_index] = tile_x + tile_y * number_of_tiles._X;
+		++tile_point_offsets[point_tile_indices[point_index] + 1];
+	}
+
+	//Sort the points by tile, keeping them in cell order within each tile.
+	for (uint32 tile_index{ 0 }; tile_index < total_number_of_tiles; ++tile_index)
+	{
+		tile_point_offsets[tile_index + 1] += tile_point_offsets[tile_index];
+	}
+
+	DynamicArray<Vector2<float32>> sorted_points;
+	sorted_points.Resize<false>(number_of_points);
+
+	{
+		DynamicArray<uint64> write_offsets;
+		write_offsets.Resize<false>(total_number_of_tiles);
+		Memory::Copy(write_offsets.Data(), tile_point_offsets.Data(), sizeof(uint64) * total_number_of_tiles);
+
+		for (uint64 point_index{ 0 }; point_index < number_of_points; ++point_index)
+		{
+			sorted_points[write_offsets[point_tile_indices[point_index]]++] = points[point_index];
+		}
+	}
+
+	//Run each phase. Tiles within a phase can't touch each other, so the result doesn't depend on how they are scheduled.
+	DynamicArray<ErosionTile> tiles;
+	tiles.Reserve(((number_of_tiles._X + 1) / 2) * ((number_of_tiles._Y + 1) / 2));
+
+	HydraulicErosionContext context;
+
+	context._Parameters = &parameters;
+	context._HeightMap = height_map;
+
+	for (uint8 phase{ 0 }; phase < TerrainErosionConstants::NUMBER_OF_PHASES; ++phase)
+	{
+		tiles.Clear();
+
+		for (uint32 tile_y{ static_cast<uint32>(phase >> 1) }; tile_y < number_of_tiles._Y; tile_y += 2)
+		{
+			for (uint32 tile_x{ static_cast<uint32>(phase & 1) }; tile_x < number_of_tiles._X; tile_x += 2)
+			{
+				const uint32 tile_index{ tile_x + tile_y * number_of_tiles._X };
+				const uint64 tile_number_of_points{ tile_point_offsets[tile_index + 1] - tile_point_offsets[tile_index] };
+
+				if (tile_number_of_points == 0)
+				{
+					continue;
+				}
+
+				tiles.Emplace();
+				ErosionTile &tile{ tiles.Back() };
+
+				tile._Points = &sorted_points[tile_point_offsets[tile_index]];
+				tile._NumberOfPoints = tile_number_of_points;
+			}
+		}
+
+		context._Tiles = tiles.Data();
+
+		TaskSystem::ParallelFor(Task::Priority::LOW, static_cast<uint32>(tiles.Size()), [](void *const RESTRICT arguments, const uint32 index)
+		{
+			const HydraulicErosionContext &hydraulic_context{ *static_cast<const HydraulicErosionContext *const RESTRICT>(arguments) };
+			const ErosionTile &tile{ hydraulic_context._Tiles[index] };
+
+			for (uint64 point_index{ 0 }; point_index < tile._NumberOfPoints; ++point_index)
+			{
+				SimulateParticle(*hydraulic_context._Parameters, tile._Points[point_index], hydraulic_context._HeightMap);
+			}
+		}, &context);
+	}
+}
+
+/*
+*	Runs thermal erosion, double buffered so that every texel sees the heights from the previous iteration.
+*/
+FORCE_INLINE static void SimulateThermalErosion(const TerrainErosion::Parameters &parameters, Texture2D<float32> *const RESTRICT height_map) NOEXCEPT
+{
+	PROFILING_SCOPE("TerrainErosion::SimulateThermalErosion");
+
+	const uint32 width{ height_map->GetWidth() };
+	const uint64 number_of_texels{ static_cast<uint64>(width) * height_map->GetHeight() };
+
+	DynamicArray<float32> scratch;
+	scratch.Resize<false>(number_of_texels);
+	Memory::Copy(scratch.Data(), height_map->Data(), sizeof(float32) * number_of_texels);
+
+	float32 *RESTRICT source{ height_map->Data() };
+	float32 *RESTRICT destination{ scratch.Data() };
+
+	//Split the rows into chunks.
+	const uint32 number_of_rows{ parameters._MaximumBounds._Y - parameters._MinimumBounds._Y + 1 };
+	const uint32 maximum_number_of_chunks{ BaseMath::Maximum<uint32>(TaskSystem::Instance->GetNumberOfTaskExecutors() * TerrainErosionConstants::THERMAL_CHUNKS_PER_EXECUTOR, 1) };
+	const uint32 number_of_chunks{ BaseMath::Minimum<uint32>(number_of_rows, maximum_number_of_chunks) };
+
+	ThermalErosionContext context;
+
+	context._Parameters = &parameters;
+	context._Width = width;
+	context._RowsPerChunk = (number_of_rows + number_of_chunks - 1) / number_of_chunks;
+
+	for (uint32 iteration{ 0 }; iteration < parameters._ThermalIterations; ++iteration)
+	{
+		context._Source = source;
+		context._Destination = destination;
+
+		TaskSystem::ParallelFor(Task::Priority::LOW, (number_of_rows + context._RowsPerChunk - 1) / context._RowsPerChunk, [](void *const RESTRICT arguments, const uint32 index)
+		{
+			const ThermalErosionContext &thermal_context{ *static_cast<const ThermalErosionContext *const RESTRICT>(arguments) };
+			const TerrainErosion::Parameters &task_parameters{ *thermal_context._Parameters };
+			const uint32 first_row{ task_parameters._MinimumBounds._Y + index * thermal_context._RowsPerChunk };
+			const uint32 last_row{ BaseMath::Minimum<uint32>(first_row + thermal_context._RowsPerChunk - 1, task_parameters._MaximumBounds._Y) };
+
+			StaticArray<float32, 4> flows;
+			StaticArray<float32, 4> neighbour_flows;
+
+			for (uint32 Y{ first_row }; Y <= last_row; ++Y)
+			{
+				for (uint32 X{ task_parameters._MinimumBounds._X }; X <= task_parameters._MaximumBounds._X; ++X)
+				{
+					const uint64 texel_index{ X + static_cast<uint64>(Y) * thermal_context._Width };
+					float32 height{ thermal_context._Source[texel_index] };
+
+					//Remove the outflow.
+					CalculateThermalFlows(task_parameters, thermal_context._Width, thermal_context._Source, X, Y, &flows);
+
+					height -= flows[0] + flows[1] + flows[2] + flows[3];
+
+					//Gather the inflow from each neighbour, which is their flow in the opposite direction.
+					if (X > task_parameters._MinimumBounds._X)
+					{
+						CalculateThermalFlows(task_parameters, thermal_context._Width, thermal_context._Source, X - 1, Y, &neighbour_flows);
+						height += neighbour_flows[1];
+					}
+
+					if (X < task_parameters._MaximumBounds._X)
+					{
+						CalculateThermalFlows(task_parameters, thermal_context._Width, thermal_context._Source, X + 1, Y, &neighbour_flows);
+						height += neighbour_flows[0];
+					}
+
+					if (Y > task_parameters._MinimumBounds._Y)
+					{
+						CalculateThermalFlows(task_parameters, thermal_context._Width, thermal_context._Source, X, Y - 1, &neighbour_flows);
+						height += neighbour_flows[3];
+					}
+
+					if (Y < task_parameters._MaximumBounds._Y)
+					{
+						CalculateThermalFlows(task_parameters, thermal_context._Width, thermal_context._Source, X, Y + 1, &neighbour_flows);
+						height += neighbour_flows[2];
+					}
+
+					thermal_context._Destination[texel_index] = height;
+				}
+			}
+		}, &context);
+
+		Swap(&source, &destination);
+	}
+
+	//If the final result ended up in the scratch buffer, copy it back.
+	if (source != height_map->Data())
+	{
+		Memory::Copy(height_map->Data(), source, sizeof(float32) * number_of_texels);
+	}
+}
+
+/*
+*	Performs an erosion simulation on the given height map.
+*/
+void TerrainErosion::Simulate(const Parameters &input_parameters, Texture2D<float32> *const RESTRICT height_map) NOEXCEPT
+{
+	PROFILING_SCOPE("TerrainErosion::Simulate");
+
+	//Copy the parameters.
+	Parameters parameters{ input_parameters };
+
+	//If the maximum bounds are set to the default UINT32 value, set it to a proper value.
+	if (parameters._MaximumBounds._X == UINT32_MAXIMUM)
+	{
+		parameters._MaximumBounds._X = height_map->GetWidth() - 1;
+	}
+
+	if (parameters._MaximumBounds._Y == UINT32_MAXIMUM)
+	{
+		parameters._MaximumBounds._Y = height_map->GetHeight() - 1;
+	}
+
+	ASSERT(parameters._MinimumBounds._X <= parameters._MaximumBounds._X && parameters._MinimumBounds._Y <= parameters._MaximumBounds._Y, "Invalid bounds!");
+	ASSERT(parameters._MaximumBounds._X < height_map->GetWidth() && parameters._MaximumBounds._Y < height_map->GetHeight(), "Bounds are outside of the height map!");
+
+	//Pick the seed.
+	const uint64 seed{ parameters._Deterministic ? parameters._Seed : CatalystRandomMath::RandomIntegerInRange<uint64>(0, UINT64_MAXIMUM) };
+
+	SimulateHydraulicErosion(parameters, seed, height_map);
+
+	if (parameters._ThermalIterations > 0)
+	{
+		SimulateThermalErosion(parameters, height_map);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,391 @@
+//Header file.
+#include <Terrain/TerrainQuadTree.h>
+
+//Profiling.
+#include <Profiling/Profiling.h>
+
+//Rendering.
+#include <Rendering/Native/Culling.h>
+
+//Terrain.
+#include <Terrain/TerrainQuadTreeUtilities.h>
+
+/*
+*	Initializes this quad tree with just the root node.
+*/
+void TerrainQuadTree::Initialize
+(
+	const Vector2<float32> &position,
+	const uint32 patch_size,
+	const uint8 maximum_subdivision_steps,
+	const AxisAlignedBoundingBox3D &axis_aligned_bounding_box,
+	const float32 height_map_coordinate_padding
+) NOEXCEPT
+{
+	//Morton codes at the maximum depth need to fit in 64 bits.
+	ASSERT(maximum_subdivision_steps < 32, "Too many subdivision steps!");
+
+	_PatchSize = patch_size;
+	_MaximumSubdivisionSteps = maximum_subdivision_steps;
+	_HeightMapCoordinatePadding = height_map_coordinate_padding;
+
+	_Nodes.Clear();
+	_FreeChildNodeBlocks.Clear();
+	_LeafNodes.Clear();
+
+	//Set up the root node.
+	_Nodes.Emplace();
+	TerrainQuadTreeNode &root_node{ _Nodes.Back() };
+
+	root_node._Depth = 0;
+	root_node._Borders = 0;
+	root_node._Minimum = position - Vector2<float32>(static_cast<float32>(_PatchSize) * 0.5f);
+	root_node._Maximum = position + Vector2<float32>(static_cast<float32>(_PatchSize) * 0.5f);
+	root_node._AxisAlignedBoundingBox = axis_aligned_bounding_box;
+	root_node._Position = position;
+	root_node._MinimumHeightMapCoordinate = Vector2<float32>(0.0f);
+	root_node._MaximumHeightMapCoordinate = Vector2<float32>(1.0f);
+	root_node._PatchSize = static_cast<float32>(_PatchSize);
+
+	_LeafNodes.Emplace(0);
+
+	//Make sure the first update always runs.
+	_LastCameraPosition = Vector3<float32>(FLOAT32_MAXIMUM);
+}
+
+/*
+*	Updates this quad tree for the given camera position, combining and subdividing leaf nodes incrementally and recalculating borders if anything changed.
+*	Returns if the leaf nodes changed.
+*/
+bool TerrainQuadTree::Update(const Vector3<float32> &camera_position) NOEXCEPT
+{
+	PROFILING_SCOPE("TerrainQuadTree::Update");
+
+	//If the camera hasn't moved, the leaf nodes can't have changed either.
+	if (camera_position == _LastCameraPosition)
+	{
+		return false;
+	}
+
+	_LastCameraPosition = camera_position;
+
+	bool changed{ false };
+
+	//Each combination pass can only combine one level, so keep going until nothing changes, in case the camera moved far.
+	for (uint8 i{ 0 }; i < _MaximumSubdivisionSteps; ++i)
+	{
+		if (!CombinationPass(camera_position))
+		{
+			break;
+		}
+
+		changed = true;
+	}
+
+	//Subdivision passes subdivide newly created nodes right away, so one is enough.
+	changed |= SubdivisionPass(camera_position);
+
+	//The borders only depend on the leaf nodes, so only recalculate them if those changed.
+	if (changed)
+	{
+		CalculateBorders();
+	}
+
+	return changed;
+}
+
+/*
+*	Culls all leaf nodes against the given frustum.
+*/
+void TerrainQuadTree::Cull(const Vector3<float32> &world_grid_delta, const Frustum &frustum) NOEXCEPT
+{
+	PROFILING_SCOPE("TerrainQuadTree::Cull");
+
+	for (const uint32 node_index : _LeafNodes)
+	{
+		TerrainQuadTreeNode &node{ _Nodes[node_index] };
+
+		//Transform the axis aligned bounding box into the camera's cell.
+		const AxisAlignedBoundingBox3D transformed_axis_aligned_bounding_box
+		{
+			node._AxisAlignedBoundingBox._Minimum + world_grid_delta,
+			node._AxisAlignedBoundingBox._Maximum + world_grid_delta
+		};
+
+		//Cull!
+		node._Visible = Culling::IsWithinFrustum(transformed_axis_aligned_bounding_box, frustum);
+	}
+}
+
+/*
+*	Returns the memory usage of this quad tree.
+*/
+NO_DISCARD uint64 TerrainQuadTree::MemoryUsage() const NOEXCEPT
+{
+	uint64 memory_usage{ sizeof(TerrainQuadTree) };
+
+	memory_usage += sizeof(TerrainQuadTreeNode) * _Nodes.Capacity();
+	memory_usage += sizeof(uint32) * _LeafNodes.Capacity();
+	memory_usage += sizeof(uint32) * _FreeChildNodeBlocks.Capacity();
+	memory_usage += sizeof(uint32) * _ScratchLeafNodes.Capacity();
+	memory_usage += sizeof(uint64) * _LeafMortonCodes.Capacity();
+
+	return memory_usage;
+}
+
+/*
+*	Allocates a block of four child nodes for the given node and initializes them.
+*/
+void TerrainQuadTree::Subdivide(const uint32 node_index) NOEXCEPT
+{
+	//Allocate the child nodes, reusing a free block if there is one.
+	uint32 child_nodes_index;
+
+	if (!_FreeChildNodeBlocks.Empty())
+	{
+		child_nodes_index = _FreeChildNodeBlocks.Back();
+		_FreeChildNodeBlocks.Pop();
+	}
+
+	else
+	{
+		child_nodes_index = static_cast<uint32>(_Nodes.Size());
+
+		for (uint8 i{ 0 }; i < 4; ++i)
+		{
+			_Nodes.Emplace();
+		}
+	}
+
+	//Only retrieve the node now, since allocating might have moved it.
+	TerrainQuadTreeNode &node{ _Nodes[node_index] };
+
+	node._ChildNodesIndex = child_nodes_index;
+
+	//Calculate the patch size multiplier.
+	const float32 patch_size_multiplier{ TerrainQuadTreeUtilities::PatchSizeMultiplier(node) * 0.5f };
+	const float32 child_patch_size{ static_cast<float32>(_PatchSize) * patch_size_multiplier };
+
+	for (uint32 i{ 0 }; i < 4; ++i)
+	{
+		TerrainQuadTreeNode &child_node{ _Nodes[child_nodes_index + i] };
+
+		//Child nodes are laid out in Morton order, so the lowest bit of the index is X and the highest is Y.
+		const uint32 offset_x{ i & 1 };
+		const uint32 offset_y{ i >> 1 };
+
+		child_node._Depth = node._Depth + 1;
+		child_node._Borders = 0;
+		child_node._ParentNodeIndex = node_index;
+		child_node._ChildNodesIndex = TerrainQuadTreeNode::INVALID_INDEX;
+		child_node._GridCoordinate = Vector2<uint32>(node._GridCoordinate._X * 2 + offset_x, node._GridCoordinate._Y * 2 + offset_y);
+		child_node._Minimum = node._Minimum + Vector2<float32>(static_cast<float32>(offset_x) * child_patch_size, static_cast<float32>(offset_y) * child_patch_size);
+		child_node._Maximum = child_node._Minimum + Vector2<float32>(child_patch_size);
+
+		/*
+		*	Use the parent node's min/max height, as it would be too time-consuming to compute for each individual node.
+		*	Should be a good enough approximation.
+		*/
+		child_node._AxisAlignedBoundingBox._Minimum = Vector3<float32>(child_node._Minimum._X, node._AxisAlignedBoundingBox._Minimum._Y, child_node._Minimum._Y);
+		child_node._AxisAlignedBoundingBox._Maximum = Vector3<float32>(child_node._Maximum._X, node._AxisAlignedBoundingBox._Maximum._Y, child_node._Maximum._Y);
+
+		child_node._Visible = node._Visible;
+		child_node._Position = TerrainQuadTreeUtilities::MiddlePoint(child_node);
+
+		const Vector2<float32> heightmap_coordinate_offset{ static_cast<float32>(_PatchSize) * 0.5f };
+		child_node._MinimumHeightMapCoordinate = (child_node._Minimum + heightmap_coordinate_offset) / static_cast<float32>(_PatchSize);
+		child_node._MaximumHeightMapCoordinate = (child_node._Maximum + heightmap_coordinate_offset) / static_cast<float32>(_PatchSize);
+
+		child_node._MinimumHeightMapCoordinate *= 1.0f - _HeightMapCoordinatePadding;
+		child_node._MaximumHeightMapCoordinate *= 1.0f - _HeightMapCoordinatePadding;
+
+		child_node._PatchSize = child_patch_size;
+	}
+}
+
+/*
+*	Subdivides the given leaf node as many times as needed, adding the resulting leaf nodes to the scratch leaf nodes.
+*	Returns if anything was subdivided.
+*/
+bool TerrainQuadTree::SubdivideLeafNode(const uint32 node_index, const Vector3<float32> &camera_position) NOEXCEPT
+{
+	if (!TerrainQuadTreeUtilities::ShouldBeSubdivided(_PatchSize, _MaximumSubdivisionSteps, _Nodes[node_index], camera_position))
+	{
+		_ScratchLeafNodes.Emplace(node_index);
+
+		return false;
+	}
+
+	Subdivide(node_index);
+
+	//Visiting the child nodes in order keeps the leaf nodes in Morton order.
+	const uint32 child_nodes_index{ _Nodes[node_index]._ChildNodesIndex };
+
+	for (uint32 i{ 0 }; i < 4; ++i)
+	{
+		SubdivideLeafNode(child_nodes_index + i, camera_position);
+	}
+
+	return true;
+}
+
+/*
+*	Runs one combination pass over the leaf nodes. Returns if anything was combined.
+*/
+bool TerrainQuadTree::CombinationPass(const Vector3<float32> &camera_position) NOEXCEPT
+{
+	bool combined{ false };
+
+	_ScratchLeafNodes.Clear();
+
+	for (uint64 leaf_index{ 0 }; leaf_index < _LeafNodes.Size();)
+	{
+		const uint32 node_index{ _LeafNodes[leaf_index] };
+		const uint32 parent_node_index{ _Nodes[node_index]._ParentNodeIndex };
+
+		/*
+		*	A parent node can be combined if all four of it's child nodes are leaf nodes.
+		*	Since the leaf nodes are in Morton order, those are always next to each other in the list, starting with the first child node.
+		*/
+		if (parent_node_index != TerrainQuadTreeNode::INVALID_INDEX
+			&& _Nodes[parent_node_index]._ChildNodesIndex == node_index
+			&& !_Nodes[node_index + 1].IsSubdivided()
+			&& !_Nodes[node_index + 2].IsSubdivided()
+			&& !_Nodes[node_index + 3].IsSubdivided()
+			&& TerrainQuadTreeUtilities::ShouldBeCombined(_PatchSize, _MaximumSubdivisionSteps, _Nodes[parent_node_index], camera_position))
+		{
+			ASSERT(leaf_index + 3 < _LeafNodes.Size() && _LeafNodes[leaf_index + 3] == node_index + 3, "Leaf nodes are out of order!");
+
+			_FreeChildNodeBlocks.Emplace(node_index);
+			_Nodes[parent_node_index]._ChildNodesIndex = TerrainQuadTreeNode::INVALID_INDEX;
+			_ScratchLeafNodes.Emplace(parent_node_index);
+
+			leaf_index += 4;
+			combined = true;
+		}
+
+		else
+		{
+			_ScratchLeafNodes.Emplace(node_index);
+
+			++leaf_index;
+		}
+	}
+
+	Swap(&_LeafNodes, &_ScratchLeafNodes);
+
+	return combined;
+}
+
+/*
+*	Runs one subdivision pass over the leaf nodes. Returns if anything was subdivided.
+*/
+bool TerrainQuadTree::SubdivisionPass(const Vector3<float32> &camera_position) NOEXCEPT
+{
+	bool subdivided{ false };
+
+	_ScratchLeafNodes.Clear();
+
+	for (const uint32 node_index : _LeafNodes)
+	{
+		subdivided |= SubdivideLeafNode(node_index, camera_position);
+	}
+
+	Swap(&_LeafNodes, &_ScratchLeafNodes);
+
+	return subdivided;
+}
+
+/*
+*	Calculates the borders of all leaf nodes.
+*/
+void TerrainQuadTree::CalculateBorders() NOEXCEPT
+{
+	PROFILING_SCOPE("TerrainQuadTree::CalculateBorders");
+
+	//Calculate the Morton code of the minimum corner of each leaf node, at the maximum depth.
+	_LeafMortonCodes.Resize<false>(_LeafNodes.Size());
+
+	for (uint64 leaf_index{ 0 }; leaf_index < _LeafNodes.Size(); ++leaf_index)
+	{
+		const TerrainQuadTreeNode &node{ _Nodes[_LeafNodes[leaf_index]] };
+		const uint32 shift{ static_cast<uint32>(_MaximumSubdivisionSteps - node._Depth) };
+
+		_LeafMortonCodes[leaf_index] = TerrainQuadTreeUtilities::MortonCode(node._GridCoordinate._X << shift, node._GridCoordinate._Y << shift);
+	}
+
+	//The offsets to the neighboring nodes, in the order left, down, right, up.
+	constexpr int32 NEIGHBOR_OFFSETS[4][2]{ { -1, 0 }, { 0, -1 }, { 1, 0 }, { 0, 1 } };
+
+	//The border bits for each neighbor, for a depth difference of one and two respectively.
+	constexpr uint32 NEIGHBOR_BORDERS[4][2]{ { BIT(0), BIT(1) }, { BIT(4), BIT(5) }, { BIT(2), BIT(3) }, { BIT(6), BIT(7) } };
+
+	for (const uint32 node_index : _LeafNodes)
+	{
+		TerrainQuadTreeNode &node{ _Nodes[node_index] };
+		const int64 grid_size{ static_cast<int64>(1) << node._Depth };
+		const uint32 shift{ static_cast<uint32>(_MaximumSubdivisionSteps - node._Depth) };
+
+		uint32 borders{ 0 };
+
+		for (uint8 i{ 0 }; i < 4; ++i)
+		{
+			const int64 neighbor_x{ static_cast<int64>(node._GridCoordinate._X) + NEIGHBOR_OFFSETS[i][0] };
+			const int64 neighbor_y{ static_cast<int64>(node._GridCoordinate._Y) + NEIGHBOR_OFFSETS[i][1] };
+
+			/*
+			*	TODO: When we can't find a neighboring node, put up a request to find one on other terrain components,
+			*	and process them real quick in the post update.
+			*	For now, assume that there's a depth difference of 1, should be right most of the time.
+			*/
+			int32 delta{ 1 };
+
+			if (neighbor_x >= 0 && neighbor_x < grid_size && neighbor_y >= 0 && neighbor_y < grid_size)
+			{
+				const uint64 neighbor_morton_code{ TerrainQuadTreeUtilities::MortonCode(static_cast<uint32>(neighbor_x) << shift, static_cast<uint32>(neighbor_y) << shift) };
+				const TerrainQuadTreeNode &neighbor_node{ _Nodes[_LeafNodes[FindLeafNode(neighbor_morton_code)]] };
+
+				delta = static_cast<int32>(node._Depth) - static_cast<int32>(neighbor_node._Depth);
+			}
+
+			if (delta >= 1)
+			{
+				borders |= NEIGHBOR_BORDERS[i][0];
+			}
+
+			if (delta >= 2)
+			{
+				borders |= NEIGHBOR_BORDERS[i][1];
+			}
+		}
+
+		node._Borders = borders;
+	}
+}
+
+/*
+*	Finds the leaf node containing the given Morton code at the maximum depth. Returns the index into the leaf nodes.
+*/
+NO_DISCARD uint64 TerrainQuadTree::FindLeafNode(const uint64 morton_code) const NOEXCEPT
+{
+	//The leaf nodes partition the root node in Morton order, so the containing leaf node is the last one starting at or before the Morton code.
+	uint64 low{ 0 };
+	uint64 high{ _LeafMortonCodes.Size() };
+
+	while (high - low > 1)
+	{
+		const uint64 middle{ low + (high - low) / 2 };
+
+		if (_LeafMortonCodes[middle] <= morton_code)
+		{
+			low = middle;
+		}
+
+		else
+		{
+			high = middle;
+		}
+	}
+
+	return low;
+}
\ No newline at end of file
@@ -1,6 +1,9 @@
 //Header file.
 #include <UI/Core/Scene.h>
 
+//Rendering.
+#include <Rendering/Native/GlyphCache.h>
+
 //Systems.
 #include <Systems/ContentSystem.h>
 
@@ -63,6 +66,111 @@ namespace UI
 
 		//Clear the widgets.
 		_Widgets.Clear();
+
+		//Prepare the widget allocator.
+		_WidgetAllocator.Prepare();
+	}
+
+	/*
+	*	Finishes building this scene.
+	*/
+	void Scene::FinishBuild() NOEXCEPT
+	{
+		//Clean the widget allocator.
+		_WidgetAllocator.Clean();
+
+		//This scene is no longer dirty.
+		_Dirty = false;
+	}
+
+	/*
+	*	Renders this scene.
+	*/
+	void Scene::Render(const UI::RenderContext &context) NOEXCEPT
+	{
+		//Widgets are laid out container by container, so walk the containers in widget order.
+		for (uint64 widget_index{ 0 }; widget_index < _Widgets.Size();)
+		{
+			UI::Container *const RESTRICT container{ _Widgets[widget_index]->GetParent() };
+
+			//Recreate the render commands for this container if something has changed in it, or if characters it uses might have been evicted from a glyph cache.
+			if (container->_RenderDirty
+				|| (container->_UsesGlyphCache && container->_NumberOfGlyphEvictions != GlyphCache::GetNumberOfEvictions()))
+			{
+				container->_RenderCommands.Clear();
+				container->_UsesGlyphCache = false;
+
+				UI::RenderContext container_context{ context };
+				container_context._RenderCommands = &container->_RenderCommands;
+				container_context._UsesGlyphCache = &container->_UsesGlyphCache;
+
+				bool is_animating{ false };
+
+				for (uint64 container_widget_index{ container->_StartWidgetIndex }; container_widget_index < container->_EndWidgetIndex; ++container_widget_index)
+				{
+					UI::Widget *const RESTRICT widget{ _Widgets[container_widget_index] };
+
+					if (!widget->IsEnabled())
+					{
+						continue;
+					}
+
+					widget->Render(container_context);
+
+					is_animating |= widget->IsAnimating();
+				}
+
+				//Flip position and transform into clip space.
+				for (UI::RenderCommand &render_command : container->_RenderCommands)
+				{
+					for (Vector4<float32> &position : render_command._Positions)
+					{
+						position._X /= UI::Constants::REFERENCE_RESOLUTION._X;
+						position._Y /= UI::Constants::REFERENCE_RESOLUTION._Y;
+
+						position._Y = 1.0f - position._Y;
+
+						position._X = position._X * 2.0f - 1.0f;
+						position._Y = position._Y * 2.0f - 1.0f;
+					}
+				}
+
+				//Animating widgets needs to be rendered again next frame.
+				container->_RenderDirty = is_animating;
+
+				//Remember the number of evictions after rendering, as rendering itself might have rasterized characters.
+				container->_NumberOfGlyphEvictions = GlyphCache::GetNumberOfEvictions();
+
+				//Make sure the new render commands are uploaded.
+				container->_RenderCommandsOffset = UINT64_MAXIMUM;
+			}
+
+			//Add the render commands of this container.
+			const uint64 offset{ context._RenderCommands->Size() };
+			const uint64 number_of_render_commands{ container->_RenderCommands.Size() };
+
+			if (number_of_render_commands > 0)
+			{
+				if (offset + number_of_render_commands > context._RenderCommands->Capacity())
+				{
+					context._RenderCommands->Reserve(BaseMath::Maximum<uint64>(offset + number_of_render_commands, context._RenderCommands->Capacity() * 2));
+				}
+
+				context._RenderCommands->Resize<false>(offset + number_of_render_commands);
+				Memory::Copy(&context._RenderCommands->At(offset), container->_RenderCommands.Data(), sizeof(UI::RenderCommand) * number_of_render_commands);
+
+				//Only render commands that are new or have moved needs to be uploaded again.
+				if (container->_RenderCommandsOffset != offset)
+				{
+					*context._ChangedRenderCommandsStart = BaseMath::Minimum<uint64>(*context._ChangedRenderCommandsStart, offset);
+					*context._ChangedRenderCommandsEnd = BaseMath::Maximum<uint64>(*context._ChangedRenderCommandsEnd, offset + number_of_render_commands);
+				}
+			}
+
+			container->_RenderCommandsOffset = offset;
+
+			widget_index = container->_EndWidgetIndex;
+		}
 	}
 
 	/*
@@ -109,6 +217,9 @@ namespace UI
 		//This container is now alive.
 		_ActiveContainer->_Alive = true;
 
+		//The widgets of this container are being rebuilt, so it's render commands needs to be recreated.
+		_ActiveContainer->_RenderDirty = true;
+
 		//Patch up pointers for old containers, if necessary.
 		if (need_to_patch_up_pointers)
 		{
@@ -316,6 +427,9 @@ namespace UI
 				}
 
 				container->_ScrollOffset = BaseMath::Round<float32>(container->_ScrollOffset / container->_WidgetSize) * container->_WidgetSize;
+
+				//Scrolling moves the widgets, so the scene needs to be rebuilt.
+				container->_Parent->MarkDirty();
 			}
 		)
 		->SetOnScrollUpCallback
@@ -357,6 +471,9 @@ namespace UI
 				}
 
 				container->_ScrollOffset = BaseMath::Round<float32>(container->_ScrollOffset / container->_WidgetSize) * container->_WidgetSize;
+
+				//Scrolling moves the widgets, so the scene needs to be rebuilt.
+				container->_Parent->MarkDirty();
 			}
 		);
 	}
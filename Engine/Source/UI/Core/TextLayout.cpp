@@ -0,0 +1,160 @@
+//Header file.
+#include <UI/Core/TextLayout.h>
+
+//Core.
+#include <Core/Algorithms/HashAlgorithms.h>
+
+//Profiling.
+#include <Profiling/Profiling.h>
+
+//Rendering.
+#include <Rendering/Native/GlyphCache.h>
+
+//Text layout cache constants.
+namespace TextLayoutCacheConstants
+{
+	constexpr uint64 MAXIMUM_NUMBER_OF_ENTRIES{ 4'096 };
+	constexpr uint32 INVALID_CODEPOINT{ UINT32_MAXIMUM };
+}
+
+/*
+*	Decodes the UTF-8 codepoint at the given position, advancing the position past it.
+*	Returns INVALID_CODEPOINT for malformed sequences, after skipping the offending byte.
+*/
+FORCE_INLINE static NO_DISCARD uint32 DecodeUTF8(const char *const RESTRICT text, const uint64 text_length, uint64 *const RESTRICT position) NOEXCEPT
+{
+	const uint8 first_byte{ static_cast<uint8>(text[(*position)++]) };
+
+	//The number of continuation bytes follows from the leading bits of the first byte.
+	uint32 codepoint;
+	uint32 number_of_continuation_bytes;
+
+	if (first_byte < 0x80)
+	{
+		return first_byte;
+	}
+
+	else if ((first_byte & 0xE0) == 0xC0)
+	{
+		codepoint = first_byte & 0x1F;
+		number_of_continuation_bytes = 1;
+	}
+
+	else if ((first_byte & 0xF0) == 0xE0)
+	{
+		codepoint = first_byte & 0x0F;
+		number_of_continuation_bytes = 2;
+	}
+
+	else if ((first_byte & 0xF8) == 0xF0)
+	{
+		codepoint = first_byte & 0x07;
+		number_of_continuation_bytes = 3;
+	}
+
+	else
+	{
+		return TextLayoutCacheConstants::INVALID_CODEPOINT;
+	}
+
+	for (uint32 i{ 0 }; i < number_of_continuation_bytes; ++i)
+	{
+		if (*position >= text_length || (static_cast<uint8>(text[*position]) & 0xC0) != 0x80)
+		{
+			return TextLayoutCacheConstants::INVALID_CODEPOINT;
+		}
+
+		codepoint = (codepoint << 6) | (static_cast<uint8>(text[(*position)++]) & 0x3F);
+	}
+
+	return codepoint;
+}
+
+namespace UI
+{
+
+	/*
+	*	Returns the layout of the given UTF-8 text in the given font. The returned layout is valid until the next call.
+	*/
+	NO_DISCARD const UI::TextLayout &TextLayoutCache::GetLayout(FontAsset *const RESTRICT font, const char *const RESTRICT text, const uint64 text_length) NOEXCEPT
+	{
+		const uint64 key{ HashAlgorithms::MurmurHash64(static_cast<const void *const RESTRICT>(text), text_length, reinterpret_cast<uint64>(font)) };
+
+		//Is this layout cached?
+		{
+			const std::unordered_map<uint64, Entry>::const_iterator iterator{ _Entries.find(key) };
+
+			if (iterator != _Entries.end()
+				&& iterator->second._Font == font
+				&& iterator->second._Text.Size() == text_length
+				&& Memory::Compare(iterator->second._Text.Data(), text, text_length))
+			{
+				return iterator->second._Layout;
+			}
+		}
+
+		PROFILING_SCOPE("UI::TextLayoutCache::GetLayout");
+
+		if (_Entries.size() >= TextLayoutCacheConstants::MAXIMUM_NUMBER_OF_ENTRIES)
+		{
+			_Entries.clear();
+		}
+
+		//Lay out the text. Hash collisions simply replace the old entry.
+		Entry &entry{ _Entries[key] };
+
+		entry._Font = font;
+		entry._Text.Upsize<false>(text_length);
+		Memory::Copy(entry._Text.Data(), text, text_length);
+
+		LayOut(font, text, text_length, &entry._Layout);
+
+		return entry._Layout;
+	}
+
+	/*
+	*	Lays out the given UTF-8 text in the given font.
+	*/
+	void TextLayoutCache::LayOut(FontAsset *const RESTRICT font, const char *const RESTRICT text, const uint64 text_length, UI::TextLayout *const RESTRICT layout) NOEXCEPT
+	{
+		layout->_Characters.Clear();
+
+		float32 current_offset{ 0.0f };
+		uint32 previous_codepoint{ TextLayoutCacheConstants::INVALID_CODEPOINT };
+
+		for (uint64 position{ 0 }; position < text_length;)
+		{
+			const uint32 codepoint{ DecodeUTF8(text, text_length, &position) };
+
+			if (codepoint == TextLayoutCacheConstants::INVALID_CODEPOINT || codepoint == '\n')
+			{
+				continue;
+			}
+
+			//Skip characters the font can't render.
+			const FontAsset::CharacterDescription *const RESTRICT character_description{ GlyphCache::FindCharacterDescription(font, codepoint) };
+
+			if (!character_description)
+			{
+				continue;
+			}
+
+			if (previous_codepoint != TextLayoutCacheConstants::INVALID_CODEPOINT)
+			{
+				current_offset += font->GetKerningAdjustment(previous_codepoint, codepoint);
+			}
+
+			layout->_Characters.Emplace();
+			UI::TextLayout::Character &character{ layout->_Characters.Back() };
+
+			character._Codepoint = codepoint;
+			character._Offset = current_offset;
+
+			current_offset += character_description->_Advance;
+			previous_codepoint = codepoint;
+		}
+
+		layout->_Width = current_offset;
+	}
+
+}
\ No newline at end of file
@@ -1,11 +1,15 @@
 //Header file.
 #include <UI/Core/Widget.h>
 
+//Rendering.
+#include <Rendering/Native/GlyphCache.h>
+
 //UI.
 #include <UI/Core/Utilities.h>
 
 //Systems.
 #include <Systems/RenderingSystem.h>
+#include <Systems/UISystem.h>
 
 namespace UI
 {
@@ -178,6 +182,9 @@ namespace UI
 		const Vector4<float32> &color
 	) NOEXCEPT
 	{
+		//Retrieve the layout of the text.
+		const UI::TextLayout &layout{ UISystem::Instance->GetTextLayoutCache()->GetLayout(font.Get(), text, text_length) };
+
 		//Calculate the aligned minimum/maximum.
 		Vector2<float32> aligned_minimum;
 		Vector2<float32> aligned_maximum;
@@ -187,8 +194,7 @@ namespace UI
 			axis_aligned_bounding_box._Minimum,
 			axis_aligned_bounding_box._Maximum,
 			font,
-			text,
-			text_length,
+			layout,
 			scale,
 			horizontal_alignment,
 			vertical_alignment,
@@ -212,8 +218,7 @@ namespace UI
 					axis_aligned_bounding_box._Minimum,
 					axis_aligned_bounding_box._Maximum,
 					font,
-					text,
-					text_length,
+					layout,
 					_scale,
 					horizontal_alignment,
 					vertical_alignment,
@@ -224,20 +229,22 @@ namespace UI
 		}
 
 		//Gather all characters.
-		float32 current_offset{ 0.0f };
-
-		for (uint64 i{ 0 }, length{ text_length }; i < length; ++i)
+		for (const UI::TextLayout::Character &character : layout._Characters)
 		{
-			//Cache the chartacter.
-			const char character{ text[i] };
+			//Characters in the glyph cache might have been evicted since the layout was made, this brings them back.
+			const FontAsset::CharacterDescription *RESTRICT character_description{ font->FindCharacterDescription(character._Codepoint) };
 
-			//Only draw if it's a valid character.
-			if (character < 0)
+			if (!character_description && font->_GlyphCache)
 			{
-				continue;
+				character_description = font->_GlyphCache->Find(character._Codepoint);
+
+				if (character_description && context._UsesGlyphCache)
+				{
+					*context._UsesGlyphCache = true;
+				}
 			}
 
-			if (character == '\n')
+			if (!character_description)
 			{
 				continue;
 			}
@@ -247,19 +254,21 @@ namespace UI
 			UI::RenderCommand &command{ context._RenderCommands->Back() };
 
 			//Calculate the bounds.
+			const float32 current_offset{ character._Offset * _scale };
+
 			Vector2<float32> bounds_minimum;
 			Vector2<float32> bounds_maximum;
 
 			bounds_minimum._X = aligned_minimum._X + current_offset;
 			bounds_minimum._Y = aligned_minimum._Y;
-			bounds_maximum._X = aligned_minimum._X + current_offset + font->_CharacterDescriptions[character]._Size._X * _scale;
-			bounds_maximum._Y = aligned_minimum._Y + font->_CharacterDescriptions[character]._Size._Y * _scale;
+			bounds_maximum._X = aligned_minimum._X + current_offset + character_description->_Size._X * _scale;
+			bounds_maximum._Y = aligned_minimum._Y + character_description->_Size._Y * _scale;
 
-			bounds_minimum._X += font->_CharacterDescriptions[character]._Offset._X * _scale;
-			bounds_maximum._X += font->_CharacterDescriptions[character]._Offset._X * _scale;
+			bounds_minimum._X += character_description->_Offset._X * _scale;
+			bounds_maximum._X += character_description->_Offset._X * _scale;
 
-			bounds_minimum._Y += font->_CharacterDescriptions[character]._Offset._Y * _scale;
-			bounds_maximum._Y += font->_CharacterDescriptions[character]._Offset._Y * _scale;
+			bounds_minimum._Y += character_description->_Offset._Y * _scale;
+			bounds_maximum._Y += character_description->_Offset._Y * _scale;
 
 			//Set the positions.
 			command._Positions[0] = Vector4<float32>(bounds_minimum._X, bounds_minimum._Y, 0.0f, 1.0f);
@@ -271,8 +280,8 @@ namespace UI
 			Vector2<float32> texture_bounds_minimum;
 			Vector2<float32> texture_bounds_maximum;
 
-			texture_bounds_minimum = font->_CharacterDescriptions[character]._TextureBounds._Minimum;
-			texture_bounds_maximum = font->_CharacterDescriptions[character]._TextureBounds._Maximum;
+			texture_bounds_minimum = character_description->_TextureBounds._Minimum;
+			texture_bounds_maximum = character_description->_TextureBounds._Maximum;
 
 			//Set the texture coordinates.
 			command._TextureCoordinates[0] = Vector2<float32>(texture_bounds_minimum._X, texture_bounds_minimum._Y);
@@ -284,16 +293,19 @@ namespace UI
 			command._Mode = UI::RenderCommand::Mode::TEXT;
 
 			//Set the color/texture.
-			command._ColorOrTexture = font->_MasterTextureIndex;
+			command._ColorOrTexture = font->_PageTextureIndices[character_description->_PageIndex];
 
 			//Set the color/opacity.
 			command._ColorOpacity = *Color(color).Data();
 
 			//Set the smoothing factor.
 			command._Parameter1_float32 = TEXT_SMOOTHING_FACTOR_CURVE.Sample(_scale / UI::Constants::REFERENCE_RESOLUTION._Y);
+		}
 
-			//Update the current offset.
-			current_offset += font->_CharacterDescriptions[character]._Advance * _scale;
+		//Upload any characters that were rasterized for this text in one go.
+		if (font->_GlyphCache)
+		{
+			font->_GlyphCache->Upload();
 		}
 	}
 
@@ -14,6 +14,7 @@
 #define SCRIPT_DATA_FLAG_HAS_INITIALIZE (BIT(0))
 #define SCRIPT_DATA_FLAG_HAS_UPDATE (BIT(1))
 #define SCRIPT_DATA_FLAG_HAS_TERMINATE (BIT(2))
+#define SCRIPT_DATA_FLAG_PARALLEL (BIT(3))
 
 //Macros.
 #define CHECK_ERROR_CODE() if (error_code) { std::cout << "Error at " << __LINE__ << ": " << error_code.message() << std::endl; }
@@ -163,6 +164,7 @@ void ScriptGenerator::GatherScripts(const char *const directory_path, nlohmann::
 		new_script_data._Name = name.c_str();
 		new_script_data._Flags = SCRIPT_DATA_FLAG_NONE;
 		new_script_data._RequiredDataSize = 0;
+		new_script_data._UpdateWave = 0;
 
 		//Check if we should parse this entry.
 		bool parse_entry{ true };
@@ -193,6 +195,72 @@ void ScriptGenerator::GatherScripts(const char *const directory_path, nlohmann::
 	}
 }
 
+/*
+*	Calculates the update wave of each script.
+*	Scripts are scheduled in identifier order, so the result is deterministic.
+*	Serial scripts get a wave of their own, while consecutive parallel scripts share a wave as long as none of them writes to something another one reads or writes.
+*/
+void ScriptGenerator::CalculateUpdateWaves()
+{
+	/*
+	*	Returns if the two given scripts have conflicting access.
+	*/
+	const auto conflicts{ [](const ScriptData &A, const ScriptData &B)
+	{
+		for (const std::string &write : A._Writes)
+		{
+			if (std::find(B._Reads.begin(), B._Reads.end(), write) != B._Reads.end()
+				|| std::find(B._Writes.begin(), B._Writes.end(), write) != B._Writes.end())
+			{
+				return true;
+			}
+		}
+
+		for (const std::string &write : B._Writes)
+		{
+			if (std::find(A._Reads.begin(), A._Reads.end(), write) != A._Reads.end())
+			{
+				return true;
+			}
+		}
+
+		return false;
+	} };
+
+	//The scripts in the current wave.
+	std::vector<const ScriptData *> current_wave;
+	bool current_wave_is_parallel{ false };
+
+	_NumberOfUpdateWaves = 0;
+
+	for (ScriptData &script_data : _ScriptData)
+	{
+		//Scripts that don't update are never scheduled.
+		if (!TEST_BIT(script_data._Flags, SCRIPT_DATA_FLAG_HAS_UPDATE))
+		{
+			continue;
+		}
+
+		const bool is_parallel{ TEST_BIT(script_data._Flags, SCRIPT_DATA_FLAG_PARALLEL) };
+		bool join_current_wave{ is_parallel && current_wave_is_parallel };
+
+		for (uint64 i{ 0 }; i < current_wave.size() && join_current_wave; ++i)
+		{
+			join_current_wave = !conflicts(*current_wave[i], script_data);
+		}
+
+		if (!join_current_wave)
+		{
+			current_wave.clear();
+			current_wave_is_parallel = is_parallel;
+			++_NumberOfUpdateWaves;
+		}
+
+		current_wave.emplace_back(&script_data);
+		script_data._UpdateWave = _NumberOfUpdateWaves - 1;
+	}
+}
+
 /*
 *	Generates the source file.
 */
@@ -212,6 +280,9 @@ void ScriptGenerator::GenerateSourceFile(int32 command_line_argument_count, char
 		//The function names.
 		std::vector<std::string> _FunctionNames;
 
+		//The script node calls, as namespace/function name pairs.
+		std::vector<std::pair<std::string, std::string>> _NodeCalls;
+
 		/*
 		*	Clears the intermediate data.
 		*/
@@ -219,6 +290,7 @@ void ScriptGenerator::GenerateSourceFile(int32 command_line_argument_count, char
 		{
 			_Variables.clear();
 			_FunctionNames.clear();
+			_NodeCalls.clear();
 		}
 
 	};
@@ -309,6 +381,72 @@ void ScriptGenerator::GenerateSourceFile(int32 command_line_argument_count, char
 				continue;
 			}
 
+			//Is this a parallel declaration?
+			{
+				const size_t position{ current_line.find("Parallel()") };
+
+				//It is only valid for declarations to be at the first indentation.
+				if (position == 0 && position != std::string::npos)
+				{
+					//Update the script flags.
+					script_data._Flags |= SCRIPT_DATA_FLAG_PARALLEL;
+
+					continue;
+				}
+			}
+
+			//Is this a reads declaration?
+			{
+				const size_t position{ current_line.find("Reads(") };
+
+				//It is only valid for declarations to be at the first indentation.
+				if (position == 0 && position != std::string::npos)
+				{
+					const uint64 number_of_arguments
+					{
+						TextParsing::ParseFunctionArguments
+						(
+							current_line.c_str(),
+							current_line.length(),
+							arguments.data()
+						)
+					};
+
+					for (uint64 i{ 0 }; i < number_of_arguments; ++i)
+					{
+						script_data._Reads.emplace_back(arguments[i]);
+					}
+
+					continue;
+				}
+			}
+
+			//Is this a writes declaration?
+			{
+				const size_t position{ current_line.find("Writes(") };
+
+				//It is only valid for declarations to be at the first indentation.
+				if (position == 0 && position != std::string::npos)
+				{
+					const uint64 number_of_arguments
+					{
+						TextParsing::ParseFunctionArguments
+						(
+							current_line.c_str(),
+							current_line.length(),
+							arguments.data()
+						)
+					};
+
+					for (uint64 i{ 0 }; i < number_of_arguments; ++i)
+					{
+						script_data._Writes.emplace_back(arguments[i]);
+					}
+
+					continue;
+				}
+			}
+
 			//Is this a variable declaration?
 			{
 				const size_t position{ current_line.find("Variable(") };
@@ -579,6 +717,20 @@ void ScriptGenerator::GenerateSourceFile(int32 command_line_argument_count, char
 
 						//Cut out the substring!
 						function_name = current_line.substr(start_position, end_position - start_position);
+
+						//Remember the call, so that parallel scripts can be validated against their declared access.
+						uint64 namespace_start_position{ position };
+
+						while (namespace_start_position > 0 && (isalnum(current_line[namespace_start_position - 1]) || current_line[namespace_start_position - 1] == '_'))
+						{
+							--namespace_start_position;
+						}
+
+						intermediate_data._NodeCalls.emplace_back
+						(
+							current_line.substr(namespace_start_position, position - namespace_start_position),
+							current_line.substr(position + 2, end_position - position - 2)
+						);
 					}
 
 					//Parse the function arguments.
@@ -703,6 +855,37 @@ void ScriptGenerator::GenerateSourceFile(int32 command_line_argument_count, char
 		//Close the script file.
 		script_file.close();
 
+		/*
+		*	Parallel scripts are updated on many threads at once, so they may only touch their own entity through the components they have declared.
+		*	Script nodes that reach other entities, like sending events, can't be used.
+		*/
+		if (TEST_BIT(script_data._Flags, SCRIPT_DATA_FLAG_PARALLEL))
+		{
+			for (const std::pair<std::string, std::string> &node_call : intermediate_data._NodeCalls)
+			{
+				//Math nodes are pure.
+				if (node_call.first == "Math")
+				{
+					continue;
+				}
+
+				ASSERT(node_call.first != "Script", "Parallel script " << script_data._Name << " can't call Script::" << node_call.second << "!");
+
+				const bool declared_read{ std::find(script_data._Reads.begin(), script_data._Reads.end(), node_call.first) != script_data._Reads.end() };
+				const bool declared_write{ std::find(script_data._Writes.begin(), script_data._Writes.end(), node_call.first) != script_data._Writes.end() };
+
+				if (node_call.second.find("Set") == 0)
+				{
+					ASSERT(declared_write, "Parallel script " << script_data._Name << " calls " << node_call.first << "::" << node_call.second << " without declaring Writes(" << node_call.first << ")!");
+				}
+
+				else
+				{
+					ASSERT(declared_read || declared_write, "Parallel script " << script_data._Name << " calls " << node_call.first << "::" << node_call.second << " without declaring Reads(" << node_call.first << ")!");
+				}
+			}
+		}
+
 		//Undefine all variables.
 		for (const std::string &variable : intermediate_data._Variables)
 		{
@@ -715,6 +898,23 @@ void ScriptGenerator::GenerateSourceFile(int32 command_line_argument_count, char
 		//Add the required data size.
 		file << "\tconstexpr uint64 REQUIRED_DATA_SIZE{ " << script_data._RequiredDataSize << " };" << std::endl;
 
+		//Add the batch update, which updates a range of instances laid out contiguously.
+		if (TEST_BIT(script_data._Flags, SCRIPT_DATA_FLAG_HAS_UPDATE))
+		{
+			file << "\tvoid UpdateBatch(Entity *const RESTRICT *const RESTRICT entities, void *const RESTRICT data, const uint64 start_index, const uint64 end_index, const float32 delta_time) NOEXCEPT" << std::endl;
+			file << "\t{" << std::endl;
+			file << "\t\tScriptContext script_context;" << std::endl;
+			file << std::endl;
+			file << "\t\tfor (uint64 i{ start_index }; i < end_index; ++i)" << std::endl;
+			file << "\t\t{" << std::endl;
+			file << "\t\t\tscript_context._Entity = entities[i];" << std::endl;
+			file << "\t\t\tscript_context._Data = REQUIRED_DATA_SIZE > 0 ? AdvancePointer(data, i * REQUIRED_DATA_SIZE) : nullptr;" << std::endl;
+			file << std::endl;
+			file << "\t\t\tUpdate(script_context, delta_time);" << std::endl;
+			file << "\t\t}" << std::endl;
+			file << "\t}" << std::endl;
+		}
+
 		//Add the closing bracket for the namespace.
 		file << "}" << std::endl;
 
@@ -722,6 +922,9 @@ void ScriptGenerator::GenerateSourceFile(int32 command_line_argument_count, char
 
 	file << std::endl;
 
+	//Now that all scripts are parsed, figure out how they can be scheduled.
+	CalculateUpdateWaves();
+
 	//Add the implementation for the functions in the header file.
 	file << "namespace Script" << std::endl;
 	file << "{" << std::endl;
@@ -793,6 +996,77 @@ void ScriptGenerator::GenerateSourceFile(int32 command_line_argument_count, char
 
 	file << "\t}" << std::endl;
 
+	//Add function for returning if scripts are parallel.
+	file << "\tNO_DISCARD bool IsParallel(const ScriptIdentifier script_identifier) NOEXCEPT" << std::endl;
+	file << "\t{" << std::endl;
+
+	file << "\t\tswitch (script_identifier)" << std::endl;
+	file << "\t\t{" << std::endl;
+
+	for (const ScriptData &script_data : _ScriptData)
+	{
+		if (TEST_BIT(script_data._Flags, SCRIPT_DATA_FLAG_PARALLEL))
+		{
+			file << "\t\t\tcase ScriptIdentifier::" << script_data._Name.c_str() << ":" << std::endl;
+			file << "\t\t\t{" << std::endl;
+			file << "\t\t\t\treturn true;" << std::endl;
+			file << "\t\t\t}" << std::endl;
+		}
+	}
+
+	file << "\t\t}" << std::endl;
+
+	file << "\t\treturn false;" << std::endl;
+
+	file << "\t}" << std::endl;
+
+	//Add function for getting the update wave.
+	file << "\tNO_DISCARD uint32 UpdateWave(const ScriptIdentifier script_identifier) NOEXCEPT" << std::endl;
+	file << "\t{" << std::endl;
+
+	file << "\t\tswitch (script_identifier)" << std::endl;
+	file << "\t\t{" << std::endl;
+
+	for (const ScriptData &script_data : _ScriptData)
+	{
+		if (TEST_BIT(script_data._Flags, SCRIPT_DATA_FLAG_HAS_UPDATE))
+		{
+			file << "\t\t\tcase ScriptIdentifier::" << script_data._Name.c_str() << ":" << std::endl;
+			file << "\t\t\t{" << std::endl;
+			file << "\t\t\t\treturn " << script_data._UpdateWave << ";" << std::endl;
+			file << "\t\t\t}" << std::endl;
+		}
+	}
+
+	file << "\t\t}" << std::endl;
+
+	file << "\t\treturn UINT32_MAXIMUM;" << std::endl;
+
+	file << "\t}" << std::endl;
+
+	//Add function for updating batches of scripts.
+	file << "\tvoid UpdateBatch(const ScriptIdentifier script_identifier, Entity *const RESTRICT *const RESTRICT entities, void *const RESTRICT data, const uint64 start_index, const uint64 end_index) NOEXCEPT" << std::endl;
+	file << "\t{" << std::endl;
+
+	file << "\t\tswitch (script_identifier)" << std::endl;
+	file << "\t\t{" << std::endl;
+
+	for (const ScriptData &script_data : _ScriptData)
+	{
+		if (TEST_BIT(script_data._Flags, SCRIPT_DATA_FLAG_HAS_UPDATE))
+		{
+			file << "\t\t\tcase ScriptIdentifier::" << script_data._Name.c_str() << ":" << std::endl;
+			file << "\t\t\t{" << std::endl;
+			file << "\t\t\t\t" << script_data._Name.c_str() << "::UpdateBatch(entities, data, start_index, end_index, CatalystEngineSystem::Instance->GetDeltaTime());" << std::endl;
+			file << "\t\t\t\t" << "break;" << std::endl;
+			file << "\t\t\t}" << std::endl;
+		}
+	}
+
+	file << "\t\t}" << std::endl;
+
+	file << "\t}" << std::endl;
+
 	//Add function for terminating scripts.
 	file << "\tvoid Terminate(const ScriptIdentifier script_identifier, ScriptContext &script_context) NOEXCEPT" << std::endl;
 	file << "\t{" << std::endl;
@@ -925,6 +1199,9 @@ void ScriptGenerator::GenerateHeaderFile()
 	file << "namespace Script" << std::endl;
 	file << "{" << std::endl;
 	file << std::endl;
+	file << "\t//The number of update waves." << std::endl;
+	file << "\tconstexpr uint32 NUMBER_OF_UPDATE_WAVES{ " << _NumberOfUpdateWaves << " };" << std::endl;
+	file << std::endl;
 	file << "\t/*" << std::endl;
 	file << "\t*\tReturns the required data size for the script with the given identifier." << std::endl;
 	file << "\t*/" << std::endl;
@@ -946,6 +1223,23 @@ void ScriptGenerator::GenerateHeaderFile()
 	file << "\tvoid Terminate(const ScriptIdentifier script_identifier, ScriptContext &script_context) NOEXCEPT;" << std::endl;
 	file << std::endl;
 	file << "\t/*" << std::endl;
+	file << "\t*\tReturns if the script with the given identifier is parallel, meaning instances can be updated on many threads at once." << std::endl;
+	file << "\t*/" << std::endl;
+	file << "\tNO_DISCARD bool IsParallel(const ScriptIdentifier script_identifier) NOEXCEPT;" << std::endl;
+	file << std::endl;
+	file << "\t/*" << std::endl;
+	file << "\t*\tReturns the update wave of the script with the given identifier, or UINT32_MAXIMUM if it doesn't need updating." << std::endl;
+	file << "\t*\tWaves are updated in order. Scripts in the same wave never conflict, so their instances can be updated at the same time if they are parallel." << std::endl;
+	file << "\t*/" << std::endl;
+	file << "\tNO_DISCARD uint32 UpdateWave(const ScriptIdentifier script_identifier) NOEXCEPT;" << std::endl;
+	file << std::endl;
+	file << "\t/*" << std::endl;
+	file << "\t*\tUpdates the given range of instances of the script with the given identifier." << std::endl;
+	file << "\t*\tThe data of the instances is expected to be laid out contiguously, with a stride of the required data size." << std::endl;
+	file << "\t*/" << std::endl;
+	file << "\tvoid UpdateBatch(const ScriptIdentifier script_identifier, Entity *const RESTRICT *const RESTRICT entities, void *const RESTRICT data, const uint64 start_index, const uint64 end_index) NOEXCEPT;" << std::endl;
+	file << std::endl;
+	file << "\t/*" << std::endl;
 	file << "\t*\tSend the given event the script with the given identifier." << std::endl;
 	file << "\t*/" << std::endl;
 	file << "\tvoid Event(const ScriptIdentifier script_identifier, const HashString event, ScriptContext &script_context) NOEXCEPT;" << std::endl;
@@ -39,6 +39,15 @@ private:
 		//The events.
 		std::vector<std::string> _Events;
 
+		//The components this script reads from, if it is parallel.
+		std::vector<std::string> _Reads;
+
+		//The components this script writes to, if it is parallel.
+		std::vector<std::string> _Writes;
+
+		//The update wave.
+		uint32 _UpdateWave;
+
 	};
 
 	//Denotes if scripts need to be compile.
@@ -47,11 +56,19 @@ private:
 	//The script data.
 	std::vector<ScriptData> _ScriptData;
 
+	//The number of update waves.
+	uint32 _NumberOfUpdateWaves{ 0 };
+
 	/*
 	*	Gathers scripts in the given directory.
 	*/
 	void GatherScripts(const char *const directory_path, nlohmann::json &script_cache);
 
+	/*
+	*	Calculates the update wave of each script.
+	*/
+	void CalculateUpdateWaves();
+
 	/*
 	*	Generates the source file.
 	*/